@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_LV2_BLOCKDISPATCHER_H_
+#define LSP_PLUG_IN_3RD_PARTY_LV2_BLOCKDISPATCHER_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/3rdparty/lv2/block_size.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        /**
+         * Dispatcher of the run() call to the processing routine specialised for the block length.
+         * The plugin class P should implement the method template:
+         *
+         *   template <uint32_t N>
+         *   void process(uint32_t offset, uint32_t samples);
+         *
+         * which processes samples frames starting at offset. N is zero for the generic routine,
+         * otherwise samples is always equal to N, so the routine can be compiled with the
+         * constant loop count. Routines for 32, 64, 128 and 256 frames are selected when the
+         * host guarantees that all block lengths are multiple of them. Blocks which break
+         * the guarantee are processed by the generic routine.
+         */
+        template <class P>
+        class BlockDispatcher
+        {
+            public:
+                typedef void (*run_t)(P *plugin, uint32_t samples);
+
+            private:
+                run_t                   pRun;           // Selected routine
+                uint32_t                nBlockLength;   // Block length of the routine, zero for generic one
+
+            private:
+                static void run_generic(P *plugin, uint32_t samples)
+                {
+                    plugin->template process<0>(0, samples);
+                }
+
+                template <uint32_t N>
+                static void run_blocks(P *plugin, uint32_t samples)
+                {
+                    if (samples % N)
+                    {
+                        plugin->template process<0>(0, samples);
+                        return;
+                    }
+
+                    for (uint32_t offset = 0; offset < samples; offset += N)
+                        plugin->template process<N>(offset, N);
+                }
+
+            public:
+                explicit BlockDispatcher()
+                {
+                    pRun            = run_generic;
+                    nBlockLength    = 0;
+                }
+
+                BlockDispatcher(const BlockDispatcher &) = delete;
+                BlockDispatcher(BlockDispatcher &&) = delete;
+
+                BlockDispatcher & operator = (const BlockDispatcher &) = delete;
+                BlockDispatcher & operator = (BlockDispatcher &&) = delete;
+
+            public:
+                /**
+                 * Select the routine by the block length all run() calls are multiple of
+                 * @param quantum the block length, zero if unknown
+                 * @return block length of the selected routine, zero for the generic routine
+                 */
+                uint32_t select(uint32_t quantum)
+                {
+                    if (quantum == 0)
+                        nBlockLength    = 0;
+                    else if ((quantum % 256) == 0)
+                        nBlockLength    = 256;
+                    else if ((quantum % 128) == 0)
+                        nBlockLength    = 128;
+                    else if ((quantum % 64) == 0)
+                        nBlockLength    = 64;
+                    else if ((quantum % 32) == 0)
+                        nBlockLength    = 32;
+                    else
+                        nBlockLength    = 0;
+
+                    switch (nBlockLength)
+                    {
+                        case 256:   pRun = run_blocks<256>;  break;
+                        case 128:   pRun = run_blocks<128>;  break;
+                        case 64:    pRun = run_blocks<64>;   break;
+                        case 32:    pRun = run_blocks<32>;   break;
+                        default:    pRun = run_generic;      break;
+                    }
+
+                    return nBlockLength;
+                }
+
+                /**
+                 * Select the routine by the block size contract
+                 * @param bs block size contract
+                 * @return block length of the selected routine, zero for the generic routine
+                 */
+                inline uint32_t select(const block_size_t *bs)      { return select(block_size_quantum(bs)); }
+
+                /**
+                 * Get block length of the selected routine
+                 * @return block length of the selected routine, zero for the generic routine
+                 */
+                inline uint32_t block_length() const                { return nBlockLength; }
+
+                /**
+                 * Process the block with the selected routine
+                 * @param plugin plugin
+                 * @param samples number of samples to process
+                 */
+                inline void run(P *plugin, uint32_t samples) const  { pRun(plugin, samples); }
+        };
+
+    } /* namespace lv2 */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_LV2_BLOCKDISPATCHER_H_ */
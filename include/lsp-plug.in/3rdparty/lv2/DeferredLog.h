@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_LV2_DEFERREDLOG_H_
+#define LSP_PLUG_IN_3RD_PARTY_LV2_DEFERREDLOG_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/common/status.h>
+
+#include <lv2/core/lv2.h>
+#include <lv2/log/log.h>
+#include <lv2/urid/urid.h>
+
+#include <stdarg.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        /**
+         * Host implementation of the LV2_LOG__log feature safe for realtime threads. The logging
+         * call does not format the message: it stores the format pointer and the raw values of
+         * arguments into the ring buffer owned by the calling thread, strings passed with %s are
+         * copied. The messages are formatted and written later by the drain() method called
+         * from the background thread. Logging does not allocate memory, does not perform I/O and
+         * does not lock, messages which do not fit the ring buffer are dropped and counted.
+         *
+         * The format strings should remain valid until the messages are drained, that is true for
+         * string literals. Each thread should release the ring buffer with release_thread() when it
+         * does not need logging anymore.
+         */
+        class LSP_3RD_PARTY_EXPORT DeferredLog
+        {
+            public:
+                typedef void (*writer_t)(void *arg, LV2_URID type, const char *message);
+
+                static constexpr size_t     DEFAULT_THREADS     = 16;       // Default maximum number of logging threads
+                static constexpr size_t     DEFAULT_RING_SIZE   = 0x4000;   // Default size of the ring buffer of each thread
+                static constexpr size_t     MAX_ARGS            = 16;       // Maximum number of captured arguments
+                static constexpr size_t     MAX_STRING          = 0x100;    // Maximum length of captured string argument
+                static constexpr size_t     MAX_RECORD          = 0x800;    // Maximum size of the captured message
+                static constexpr size_t     MAX_MESSAGE         = 0x1000;   // Maximum length of the formatted message
+
+            private:
+                typedef struct ring_t
+                {
+                    uintptr_t               owner;      // Thread owning the ring, 0 if free
+                    uint32_t                head;       // Write position
+                    uint32_t                tail;       // Read position
+                    size_t                  dropped;    // Number of messages dropped by the owner
+                    uint8_t                *data;       // Ring buffer
+                    uint8_t                 pad[64 - 2*sizeof(uint32_t) - sizeof(uintptr_t) - sizeof(size_t) - sizeof(uint8_t *)];
+                } ring_t;
+
+            private:
+                ring_t                 *vRings;         // Ring buffers of threads
+                size_t                  nRings;         // Number of ring buffers
+                uint32_t                nRingSize;      // Size of each ring buffer
+                uint8_t                *pData;          // Allocated memory
+                size_t                  nGeneration;    // Generation to validate the cached ring of the thread
+                size_t                  nUnowned;       // Number of messages dropped due to lack of ring buffers
+                size_t                  nWritten;       // Number of written messages
+                writer_t                pWriter;        // Message writer
+                void                   *pWriterArg;     // Argument of the message writer
+                LV2_URID                vTypes[4];      // Error, Warning, Note, Trace
+                char                    sMessage[MAX_MESSAGE];  // Buffer for the formatted message
+                LV2_Log_Log             sLog;           // Log feature data
+                LV2_Feature             sFeature;       // Log feature
+
+            protected:
+                static int              do_printf(LV2_Log_Handle handle, LV2_URID type, const char *fmt, ...);
+                static int              do_vprintf(LV2_Log_Handle handle, LV2_URID type, const char *fmt, va_list ap);
+                static void             default_writer(void *arg, LV2_URID type, const char *message);
+
+                ring_t                 *thread_ring();
+                size_t                  drain(ring_t *ring);
+                void                    format(const uint8_t *record);
+
+            public:
+                explicit DeferredLog();
+                DeferredLog(const DeferredLog &) = delete;
+                DeferredLog(DeferredLog &&) = delete;
+                ~DeferredLog();
+
+                DeferredLog & operator = (const DeferredLog &) = delete;
+                DeferredLog & operator = (DeferredLog &&) = delete;
+
+            public:
+                /**
+                 * Initialize the log
+                 * @param map URID map feature
+                 * @param threads maximum number of logging threads
+                 * @param ring_size size of the ring buffer of each thread
+                 * @return status of operation
+                 */
+                status_t                init(const LV2_URID_Map *map, size_t threads = DEFAULT_THREADS, size_t ring_size = DEFAULT_RING_SIZE);
+
+                /**
+                 * Destroy the log, pending messages are discarded
+                 */
+                void                    destroy();
+
+                /**
+                 * Set the writer of formatted messages, messages are written to stderr by default
+                 * @param writer writer, NULL to restore the default writer
+                 * @param arg argument passed to the writer
+                 */
+                void                    set_writer(writer_t writer, void *arg);
+
+                /**
+                 * Get the LV2_LOG__log feature to pass to the plugin instantiate() call
+                 * @return pointer to the feature
+                 */
+                inline const LV2_Feature   *feature() const                 { return &sFeature; }
+
+                /**
+                 * Capture the message, realtime-safe
+                 * @param type URID of the message type
+                 * @param fmt format string
+                 * @param ap arguments
+                 * @return 0 if message has been captured, negative value if it has been dropped
+                 */
+                int                     vprintf(LV2_URID type, const char *fmt, va_list ap);
+
+                /**
+                 * Capture the message, realtime-safe
+                 * @param type URID of the message type
+                 * @param fmt format string
+                 * @return 0 if message has been captured, negative value if it has been dropped
+                 */
+                int                     printf(LV2_URID type, const char *fmt, ...);
+
+                /**
+                 * Release the ring buffer owned by the calling thread, pending messages are kept
+                 */
+                void                    release_thread();
+
+                /**
+                 * Format and write pending messages, should be called periodically from the single
+                 * background thread. Messages of each thread are written in the order of capture.
+                 * @return number of written messages
+                 */
+                size_t                  drain();
+
+                /**
+                 * Get number of dropped messages
+                 * @return number of dropped messages
+                 */
+                size_t                  dropped() const;
+
+                /**
+                 * Get number of written messages
+                 * @return number of written messages
+                 */
+                inline size_t           written() const                     { return atomic_load(&nWritten); }
+
+                #ifdef LSP_TESTING
+                /**
+                 * Get number of calls of the methods which are not realtime-safe (init(), destroy()
+                 * and drain()) made by the calling thread, available in test builds only
+                 * @return number of calls made by the calling thread
+                 */
+                static size_t           thread_unsafe_calls();
+                #endif /* LSP_TESTING */
+        };
+
+    } /* namespace lv2 */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_LV2_DEFERREDLOG_H_ */
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_LV2_EVENTCONVERTER_H_
+#define LSP_PLUG_IN_3RD_PARTY_LV2_EVENTCONVERTER_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+
+#include <lv2/atom/atom.h>
+#include <lv2/event/event.h>
+#include <lv2/uri-map/uri-map.h>
+#include <lv2/urid/urid.h>
+
+LV2_DISABLE_DEPRECATION_WARNINGS
+
+namespace lsp
+{
+    namespace lv2
+    {
+        /**
+         * Bulk converter between LV2_Atom_Sequence and legacy LV2_Event_Buffer. Event types
+         * are registered once at instantiation: each type is mapped with both URI map and URID
+         * map features into the translation tables, so the conversion performs no mapping.
+         * The conversion writes into preallocated buffers and never allocates memory.
+         *
+         * Event buffers are expected to have audio frame time stamps. Atom sequences may
+         * use either frame time or beat time, beat time stamps are converted with the fixed
+         * number of frames per beat.
+         */
+        class LSP_3RD_PARTY_EXPORT EventConverter
+        {
+            private:
+                typedef struct type_t
+                {
+                    LV2_URID                urid;       // URID of the type, 0 for empty slot
+                    uint32_t                type;       // Event type
+                } type_t;
+
+            private:
+                LV2_URID               *vUrids;         // URIDs indexed by event type
+                size_t                  nEventTypes;    // Size of the vUrids array
+                type_t                 *vTypes;         // Hash table of event types indexed by URID
+                size_t                  nMask;          // Mask of the hash table index
+                size_t                  nTypes;         // Number of registered types
+                const LV2_URID_Map     *pMap;           // URID map
+                const LV2_URI_Map_Feature *pUriMap;     // URI map
+                LV2_URID                nBeatTime;      // URID of atom:beatTime
+                double                  fFramesPerBeat; // Number of frames per beat
+
+            protected:
+                uint32_t                event_type(LV2_URID urid) const;
+                status_t                rehash(size_t size);
+
+            public:
+                explicit EventConverter();
+                EventConverter(const EventConverter &) = delete;
+                EventConverter(EventConverter &&) = delete;
+                ~EventConverter();
+
+                EventConverter & operator = (const EventConverter &) = delete;
+                EventConverter & operator = (EventConverter &&) = delete;
+
+            public:
+                /**
+                 * Initialize converter
+                 * @param map URID map feature
+                 * @param uri_map URI map feature
+                 * @return status of operation
+                 */
+                status_t                init(const LV2_URID_Map *map, const LV2_URI_Map_Feature *uri_map);
+
+                /**
+                 * Destroy converter
+                 */
+                void                    destroy();
+
+                /**
+                 * Register type of events which should be converted, events of other types are dropped
+                 * @param uri URI of the event type, for example LV2_MIDI__MidiEvent
+                 * @return status of operation, STATUS_NOT_FOUND if URI could not be mapped, STATUS_OVERFLOW
+                 *   if URI map returned identifier which does not fit into the event type
+                 */
+                status_t                add_type(const char *uri);
+
+                /**
+                 * Set number of frames per beat used for conversion of beat time stamps
+                 * @param frames number of frames per beat, for example 24000 for 120 BPM at 48 kHz
+                 */
+                inline void             set_frames_per_beat(double frames)  { fFramesPerBeat = frames; }
+
+                /**
+                 * Get number of frames per beat used for conversion of beat time stamps
+                 * @return number of frames per beat
+                 */
+                inline double           frames_per_beat() const             { return fFramesPerBeat; }
+
+                /**
+                 * Get number of registered event types
+                 * @return number of registered event types
+                 */
+                inline size_t           types() const                       { return nTypes; }
+
+                /**
+                 * Convert atom sequence to the event buffer. The data and capacity fields
+                 * of the event buffer should be set by caller, other fields are overwritten.
+                 * Negative time stamps are clamped to zero.
+                 *
+                 * @param dst destination event buffer
+                 * @param src source atom sequence
+                 * @param dropped pointer to store number of events of unregistered types or too large
+                 *   to fit into the event, may be NULL
+                 * @return status of operation, STATUS_OVERFLOW if not all events fit into the buffer
+                 */
+                status_t                to_events(LV2_Event_Buffer *dst, const LV2_Atom_Sequence *src, size_t *dropped = NULL) const;
+
+                /**
+                 * Convert event buffer to the atom sequence. The type of the destination atom is left unchanged.
+                 * Sub-frame part of time stamps is kept only for beat time units. Non-POD events are dropped.
+                 *
+                 * @param dst destination atom sequence
+                 * @param capacity capacity of the destination sequence, the same as the capacity
+                 *   argument of lv2_atom_sequence_append_event()
+                 * @param src source event buffer with audio frame time stamps
+                 * @param unit time unit of the destination sequence: 0, URID of atom:frameTime or atom:beatTime
+                 * @param dropped pointer to store number of events of unregistered types, may be NULL
+                 * @return status of operation, STATUS_OVERFLOW if not all events fit into the sequence,
+                 *   STATUS_UNSUPPORTED_FORMAT if time stamps are not in audio frames,
+                 *   STATUS_CORRUPTED if event buffer contains truncated events
+                 */
+                status_t                to_sequence(
+                    LV2_Atom_Sequence *dst, uint32_t capacity,
+                    const LV2_Event_Buffer *src, LV2_URID unit, size_t *dropped = NULL) const;
+        };
+
+    } /* namespace lv2 */
+} /* namespace lsp */
+
+LV2_RESTORE_WARNINGS
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_LV2_EVENTCONVERTER_H_ */
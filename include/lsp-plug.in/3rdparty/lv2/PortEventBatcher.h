@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_LV2_PORTEVENTBATCHER_H_
+#define LSP_PLUG_IN_3RD_PARTY_LV2_PORTEVENTBATCHER_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/common/status.h>
+
+#include <lv2/atom/atom.h>
+#include <lv2/ui/ui.h>
+#include <lv2/urid/urid.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        /**
+         * Host-side delivery of plugin port updates to the UI. Updates are written by a single
+         * producer thread and delivered by the UI thread once per UI frame with flush():
+         *   - control port updates are coalesced to the latest value of each port;
+         *   - atoms are queued in the ring buffer and delivered grouped by port, keeping
+         *     the order of atoms of each port;
+         *   - updates of ports the UI is not subscribed to are dropped without queueing.
+         * Writing and flushing are lock-free and do not allocate memory.
+         */
+        class LSP_3RD_PARTY_EXPORT PortEventBatcher
+        {
+            private:
+                typedef struct record_t
+                {
+                    uint32_t                port;       // Port index
+                    uint32_t                next;       // Offset of the next record of the same port plus 1
+                    LV2_Atom                atom;       // Atom header followed by the body
+                } record_t;
+
+            public:
+                static constexpr uint32_t   WRAP_MARKER     = 0xffffffff;   // Record port that marks the end of ring data
+
+            private:
+                size_t                  nPorts;         // Number of ports
+                size_t                  nWords;         // Number of words in bitmaps
+                uint32_t               *vValues;        // Latest values of control ports as raw bits
+                uint64_t               *vDirty;         // Bitmap of control ports with undelivered values
+                uint64_t               *vSubscribed;    // Bitmap of ports the UI is subscribed to
+                uint32_t               *vFirst;         // First record of each port during flush, offset plus 1
+                uint32_t               *vLast;          // Last record of each port during flush, offset plus 1
+                uint32_t               *vTouched;       // Ports having atoms during flush in order of appearance
+                uint8_t                *pRing;          // Ring buffer for atoms
+                uint32_t                nRingSize;      // Size of the ring buffer
+                uint32_t                nHead;          // Write position of the ring buffer
+                uint32_t                nTail;          // Read position of the ring buffer
+                LV2_URID                nEventTransfer; // URID of atom:eventTransfer
+                LV2_URID                nFloatProtocol; // URID of ui:floatProtocol
+                size_t                  nDelivered;     // Number of delivered events, updated by the UI thread
+                size_t                  nDropped;       // Number of events dropped by the producer thread
+                size_t                  nDiscarded;     // Number of events dropped by the UI thread
+                size_t                  nCoalesced;     // Number of control updates replaced by newer values
+                LV2UI_Port_Subscribe    sSubscribe;     // Subscribe feature data
+                LV2_Feature             sFeature;       // Subscribe feature
+
+            protected:
+                static uint32_t         do_subscribe(LV2UI_Feature_Handle handle, uint32_t port, uint32_t protocol, const LV2_Feature * const *features);
+                static uint32_t         do_unsubscribe(LV2UI_Feature_Handle handle, uint32_t port, uint32_t protocol, const LV2_Feature * const *features);
+
+                size_t                  flush_controls(const LV2UI_Descriptor *ui, LV2UI_Handle handle);
+                size_t                  flush_atoms(const LV2UI_Descriptor *ui, LV2UI_Handle handle);
+
+            public:
+                explicit PortEventBatcher();
+                PortEventBatcher(const PortEventBatcher &) = delete;
+                PortEventBatcher(PortEventBatcher &&) = delete;
+                ~PortEventBatcher();
+
+                PortEventBatcher & operator = (const PortEventBatcher &) = delete;
+                PortEventBatcher & operator = (PortEventBatcher &&) = delete;
+
+            public:
+                /**
+                 * Initialize the batcher, no ports are subscribed after initialization
+                 * @param ports number of plugin ports
+                 * @param atom_capacity size of the ring buffer for atoms in bytes
+                 * @param map URID map feature
+                 * @return status of operation
+                 */
+                status_t                init(size_t ports, size_t atom_capacity, const LV2_URID_Map *map);
+
+                /**
+                 * Destroy the batcher
+                 */
+                void                    destroy();
+
+                /**
+                 * Get the LV2_UI__portSubscribe feature to pass to the UI instantiate() call
+                 * @return pointer to the feature
+                 */
+                inline const LV2_Feature   *feature() const             { return &sFeature; }
+
+                /**
+                 * Subscribe the UI to the port updates or cancel the subscription. Ports listed
+                 * with ui:portNotification should be subscribed by the host. The UI may subscribe
+                 * with ui:floatProtocol and atom:eventTransfer protocols through the feature.
+                 * @param port port index
+                 * @param subscribe subscription flag
+                 * @return status of operation
+                 */
+                status_t                subscribe(uint32_t port, bool subscribe);
+
+                /**
+                 * Check that the UI is subscribed to the port updates
+                 * @param port port index
+                 * @return true if the UI is subscribed to the port updates
+                 */
+                bool                    subscribed(uint32_t port) const;
+
+                /**
+                 * Write the value of the control port, should be called from the producer thread
+                 * @param port port index
+                 * @param value value of the port
+                 * @return true if the value will be delivered, false if it has been dropped
+                 */
+                bool                    write_control(uint32_t port, float value);
+
+                /**
+                 * Write the atom to the port, should be called from the producer thread
+                 * @param port port index
+                 * @param atom atom to write
+                 * @return true if the atom will be delivered, false if it has been dropped
+                 */
+                bool                    write_atom(uint32_t port, const LV2_Atom *atom);
+
+                /**
+                 * Deliver pending updates to the UI, should be called from the UI thread once per frame.
+                 * Control values are delivered with format 0, atoms with atom:eventTransfer format.
+                 * @param ui UI descriptor
+                 * @param handle UI instance
+                 * @return number of delivered events
+                 */
+                size_t                  flush(const LV2UI_Descriptor *ui, LV2UI_Handle handle);
+
+                /**
+                 * Get number of delivered events
+                 * @return number of delivered events
+                 */
+                inline size_t           delivered() const           { return atomic_load(&nDelivered); }
+
+                /**
+                 * Get number of events dropped for unsubscribed ports or atom buffer overflow
+                 * @return number of dropped events
+                 */
+                inline size_t           dropped() const             { return atomic_load(&nDropped) + atomic_load(&nDiscarded); }
+
+                /**
+                 * Get number of control updates replaced by newer values before the delivery
+                 * @return number of coalesced updates
+                 */
+                inline size_t           coalesced() const           { return atomic_load(&nCoalesced); }
+        };
+
+    } /* namespace lv2 */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_LV2_PORTEVENTBATCHER_H_ */
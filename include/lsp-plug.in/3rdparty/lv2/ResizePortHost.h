@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_LV2_RESIZEPORTHOST_H_
+#define LSP_PLUG_IN_3RD_PARTY_LV2_RESIZEPORTHOST_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/3rdparty/lv2/ResizePortPool.h>
+
+#include <lv2/core/lv2.h>
+#include <lv2/resize-port/resize-port.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        /**
+         * Host side of the LV2_RESIZE_PORT__resize feature for a single plugin instance.
+         * Port buffers are taken from the shared ResizePortPool. The resize request is served
+         * on the audio thread without locks: the new buffer is acquired from the pool, the
+         * contents are copied and the port is reconnected. Buffers the host has seen are kept
+         * until the end of the cycle and returned to the pool by end_cycle(), buffers the host
+         * has never seen are returned to the pool immediately.
+         */
+        class LSP_3RD_PARTY_EXPORT ResizePortHost
+        {
+            private:
+                typedef struct port_t
+                {
+                    uint8_t                *buffer;     // Buffer connected to the plugin
+                    uint8_t                *host;       // Buffer published to the host
+                    size_t                  capacity;   // Capacity of the connected buffer
+                    bool                    atom;       // Port contains atom
+                } port_t;
+
+            private:
+                ResizePortPool         *pPool;          // Buffer pool
+                port_t                 *vPorts;         // Ports indexed by port index
+                size_t                  nPorts;         // Size of the vPorts array
+                const LV2_Descriptor   *pDescriptor;    // Plugin descriptor
+                LV2_Handle              hInstance;      // Plugin instance
+                size_t                  nResizes;       // Number of served resize requests
+                size_t                  nFailures;      // Number of failed resize requests
+                LV2_Resize_Port_Resize  sResize;        // Resize feature data
+                LV2_Feature             sFeature;       // Resize feature
+
+            protected:
+                static LV2_Resize_Port_Status   do_resize(LV2_Resize_Port_Feature_Data data, uint32_t index, size_t size);
+
+            public:
+                explicit ResizePortHost();
+                ResizePortHost(const ResizePortHost &) = delete;
+                ResizePortHost(ResizePortHost &&) = delete;
+                ~ResizePortHost();
+
+                ResizePortHost & operator = (const ResizePortHost &) = delete;
+                ResizePortHost & operator = (ResizePortHost &&) = delete;
+
+            public:
+                /**
+                 * Initialize the broker
+                 * @param pool buffer pool
+                 * @return status of operation
+                 */
+                status_t                init(ResizePortPool *pool);
+
+                /**
+                 * Return all buffers to the pool and destroy the broker
+                 */
+                void                    destroy();
+
+                /**
+                 * Get the LV2_RESIZE_PORT__resize feature to pass to the plugin instantiate() call
+                 * @return pointer to the feature
+                 */
+                inline const LV2_Feature   *feature() const                 { return &sFeature; }
+
+                /**
+                 * Add port managed by the broker, should be called from non-realtime thread.
+                 * The initial size of atom port buffers is at least the sequence size of the pool.
+                 * @param index port index
+                 * @param min_size minimum size of the buffer, the value of LV2_RESIZE_PORT__minimumSize property
+                 * @param atom port contains atom
+                 * @return status of operation
+                 */
+                status_t                add_port(uint32_t index, size_t min_size, bool atom);
+
+                /**
+                 * Bind the plugin instance and connect all managed ports
+                 * @param descriptor plugin descriptor
+                 * @param instance plugin instance
+                 * @return status of operation
+                 */
+                status_t                bind(const LV2_Descriptor *descriptor, LV2_Handle instance);
+
+                /**
+                 * Resize the port buffer, realtime-safe. The contents of the buffer are preserved,
+                 * only the atom header and the atom body are copied for atom ports.
+                 * @param index port index
+                 * @param size minimum size of the buffer
+                 * @return status of operation
+                 */
+                LV2_Resize_Port_Status  resize(uint32_t index, size_t size);
+
+                /**
+                 * Finish the processing cycle: return the buffers replaced during the cycle to the pool
+                 * and publish the new buffers to the host, realtime-safe
+                 */
+                void                    end_cycle();
+
+                /**
+                 * Get the buffer of the port published to the host
+                 * @param index port index
+                 * @return buffer or NULL if port is not managed
+                 */
+                inline void            *buffer(uint32_t index) const        { return (index < nPorts) ? vPorts[index].host : NULL; }
+
+                /**
+                 * Get the capacity of the port buffer connected to the plugin
+                 * @param index port index
+                 * @return capacity of the buffer or 0 if port is not managed
+                 */
+                inline size_t           capacity(uint32_t index) const      { return (index < nPorts) ? vPorts[index].capacity : 0; }
+
+                /**
+                 * Get number of served resize requests
+                 * @return number of served resize requests
+                 */
+                inline size_t           resizes() const                     { return nResizes; }
+
+                /**
+                 * Get number of resize requests failed due to lack of free buffers
+                 * @return number of failed resize requests
+                 */
+                inline size_t           failures() const                    { return nFailures; }
+        };
+
+    } /* namespace lv2 */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_LV2_RESIZEPORTHOST_H_ */
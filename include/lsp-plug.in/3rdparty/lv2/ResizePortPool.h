@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_LV2_RESIZEPORTPOOL_H_
+#define LSP_PLUG_IN_3RD_PARTY_LV2_RESIZEPORTPOOL_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/common/status.h>
+
+#include <lv2/options/options.h>
+#include <lv2/urid/urid.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        /**
+         * Pool of port buffers shared by many plugin instances. Buffers are grouped into
+         * size classes of powers of two. Acquiring and releasing of buffers is lock-free
+         * and does not allocate memory, so it can be performed on audio threads. The pool
+         * is refilled by the single non-realtime thread with reserve() and maintain() methods.
+         */
+        class LSP_3RD_PARTY_EXPORT ResizePortPool
+        {
+            private:
+                typedef struct block_t
+                {
+                    uint8_t                *data;       // Allocated memory
+                    uint8_t                *buffer;     // Buffer
+                    uint32_t                next;       // Index of the next free block plus 1
+                    uint32_t                cls;        // Size class
+                } block_t;
+
+                typedef struct header_t
+                {
+                    uint32_t                index;      // Index of the block
+                    uint32_t                magic;      // Magic number
+                } header_t;
+
+            public:
+                static constexpr size_t     MIN_SHIFT           = 10;       // Size of the minimum size class: 1 KiB
+                static constexpr size_t     MAX_SHIFT           = 24;       // Size of the maximum size class: 16 MiB
+                static constexpr size_t     CLASSES             = MAX_SHIFT - MIN_SHIFT + 1;
+                static constexpr size_t     HEADER_SIZE         = 64;       // Size of the block header, alignment of buffers
+                static constexpr size_t     DEFAULT_SEQUENCE    = 0x2000;   // Default size of sequence buffers
+                static constexpr size_t     DEFAULT_BLOCKS      = 0x4000;   // Default maximum number of blocks
+
+            private:
+                block_t                *vBlocks;        // Blocks
+                size_t                  nMaxBlocks;     // Maximum number of blocks
+                uint32_t                nBlocks;        // Number of allocated blocks
+                uint64_t                vHeads[CLASSES];    // Heads of free block stacks: tag and index of the block plus 1
+                uint32_t                vFree[CLASSES];     // Number of free blocks in each class
+                uint32_t                vReserve[CLASSES];  // Number of free blocks to keep by maintain()
+                uint32_t                nMisses;        // Number of failed or substituted requests
+                size_t                  nAllocated;     // Number of bytes allocated for buffers
+                int32_t                 nSequenceSize;  // Size of sequence buffers
+
+            protected:
+                void                    push(size_t cls, uint32_t index);
+                ssize_t                 pop(size_t cls);
+                status_t                allocate(size_t cls, size_t count);
+
+            public:
+                explicit ResizePortPool();
+                ResizePortPool(const ResizePortPool &) = delete;
+                ResizePortPool(ResizePortPool &&) = delete;
+                ~ResizePortPool();
+
+                ResizePortPool & operator = (const ResizePortPool &) = delete;
+                ResizePortPool & operator = (ResizePortPool &&) = delete;
+
+            public:
+                /**
+                 * Initialize the pool
+                 * @param sequence_size size of sequence buffers announced to plugins with
+                 *   LV2_BUF_SIZE__sequenceSize option, the default size of atom port buffers
+                 * @param max_blocks maximum number of buffers the pool can allocate
+                 * @return status of operation
+                 */
+                status_t                init(size_t sequence_size = DEFAULT_SEQUENCE, size_t max_blocks = DEFAULT_BLOCKS);
+
+                /**
+                 * Destroy the pool, all buffers should be released
+                 */
+                void                    destroy();
+
+                /**
+                 * Get size class of the buffer
+                 * @param size requested size of the buffer
+                 * @return size class or negative value if size is too large
+                 */
+                static ssize_t          size_class(size_t size);
+
+                /**
+                 * Get size of the buffers of the class
+                 * @param cls size class
+                 * @return size of buffers
+                 */
+                static inline size_t    class_size(size_t cls)      { return size_t(1) << (cls + MIN_SHIFT); }
+
+                /**
+                 * Get size of sequence buffers
+                 * @return size of sequence buffers
+                 */
+                inline size_t           sequence_size() const       { return nSequenceSize; }
+
+                /**
+                 * Allocate free buffers, should be called from non-realtime thread
+                 * @param size size of buffers
+                 * @param count number of free buffers to allocate
+                 * @return status of operation
+                 */
+                status_t                reserve(size_t size, size_t count);
+
+                /**
+                 * Set number of free buffers of the size class kept by maintain()
+                 * @param size size of buffers
+                 * @param count number of free buffers to keep
+                 * @return status of operation
+                 */
+                status_t                set_reserve(size_t size, size_t count);
+
+                /**
+                 * Refill size classes to the reserved number of free buffers,
+                 * should be called periodically from non-realtime thread
+                 * @return status of operation
+                 */
+                status_t                maintain();
+
+                /**
+                 * Acquire buffer of at least the specified size, lock-free and does not allocate memory.
+                 * If the size class has no free buffers, the buffer of greater size class is returned.
+                 * @param size requested size
+                 * @param capacity pointer to store actual size of the buffer, may be NULL
+                 * @return pointer to the buffer aligned to HEADER_SIZE or NULL if there are no free buffers
+                 */
+                void                   *acquire(size_t size, size_t *capacity = NULL);
+
+                /**
+                 * Release buffer acquired from the pool, lock-free
+                 * @param buf buffer to release
+                 */
+                void                    release(void *buf);
+
+                /**
+                 * Get size of the buffer acquired from the pool
+                 * @param buf buffer
+                 * @return size of the buffer
+                 */
+                size_t                  capacity(const void *buf) const;
+
+                /**
+                 * Get number of free buffers of the size class
+                 * @param cls size class
+                 * @return number of free buffers
+                 */
+                inline size_t           free_blocks(size_t cls) const   { return atomic_load(&vFree[cls]); }
+
+                /**
+                 * Get number of requests which could not be served by the size class
+                 * @return number of requests
+                 */
+                inline size_t           misses() const              { return atomic_load(&nMisses); }
+
+                /**
+                 * Get number of bytes allocated for the buffers
+                 * @return number of bytes
+                 */
+                inline size_t           allocated() const           { return atomic_load(&nAllocated); }
+
+                /**
+                 * Fill the LV2_BUF_SIZE__sequenceSize option, the option refers to the pool
+                 * @param opt option to fill
+                 * @param map URID map feature
+                 * @return status of operation
+                 */
+                status_t                sequence_size_option(LV2_Options_Option *opt, const LV2_URID_Map *map) const;
+        };
+
+    } /* namespace lv2 */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_LV2_RESIZEPORTPOOL_H_ */
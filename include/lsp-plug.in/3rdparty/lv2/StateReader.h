@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_LV2_STATEREADER_H_
+#define LSP_PLUG_IN_3RD_PARTY_LV2_STATEREADER_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/3rdparty/lv2/state_file.h>
+
+#include <lv2/state/state.h>
+#include <lv2/urid/urid.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        /**
+         * Host backend of LV2_State_Retrieve_Function which reads the binary container written by
+         * StateWriter. The file is mapped into memory and the values are returned as pointers into
+         * the mapping without copying, so they remain valid until the reader is closed. The container
+         * is validated once when it is opened. The values are searched with the hash index of the
+         * container, the result is cached by URID, so each subsequent retrieve of the same key takes
+         * O(1) time without unmapping and hashing of the key URI. Type URIs are mapped at the first use.
+         *
+         * The reader is not thread-safe: retrieve() updates the cache.
+         */
+        class LSP_3RD_PARTY_EXPORT StateReader
+        {
+            private:
+                typedef struct cache_t
+                {
+                    LV2_URID                urid;       // Key, 0 for empty slot
+                    uint32_t                entry;      // Entry index + 1, 0 if there is no such key
+                } cache_t;
+
+                enum storage_t
+                {
+                    STORAGE_NONE,                       // No container
+                    STORAGE_WRAP,                       // Container is owned by the caller
+                    STORAGE_HEAP,                       // Container is allocated with malloc()
+                    STORAGE_MMAP                        // Container is mapped into memory
+                };
+
+            private:
+                uint8_t                *pImage;         // Container
+                size_t                  nImageSize;     // Size of container
+                storage_t               enStorage;      // Storage of container
+                const state_header_t   *pHeader;        // Header of container
+                const state_entry_t    *vEntries;       // Entries
+                const state_uri_t      *vUris;          // URIs
+                const uint32_t         *vIndex;         // Hash index of the container
+                const char             *pStrings;       // Strings
+                const uint8_t          *pValues;        // Values
+                cache_t                *vCache;         // Cache of retrieved keys
+                size_t                  nCacheMask;     // Mask of the cache index
+                size_t                  nCached;        // Number of cached keys
+                LV2_URID               *vTypes;         // URIDs of URIs used as types, 0 if not mapped yet
+                const LV2_URID_Map     *pMap;           // URID map feature
+                const LV2_URID_Unmap   *pUnmap;         // URID unmap feature
+
+            protected:
+                static const void      *do_retrieve(LV2_State_Handle handle, uint32_t key, size_t *size, uint32_t *type, uint32_t *flags);
+
+            protected:
+                status_t                attach(const LV2_URID_Map *map, const LV2_URID_Unmap *unmap);
+                status_t                validate_sections() const;
+                status_t                validate() const;
+                ssize_t                 lookup(const char *uri, size_t len) const;
+                const void             *value(size_t index, size_t *size, uint32_t *flags) const;
+
+            public:
+                explicit StateReader();
+                StateReader(const StateReader &) = delete;
+                StateReader(StateReader &&) = delete;
+                ~StateReader();
+
+                StateReader & operator = (const StateReader &) = delete;
+                StateReader & operator = (StateReader &&) = delete;
+
+            public:
+                /**
+                 * Open the container file
+                 * @param path path to the file
+                 * @param map URID map feature used to map type URIs
+                 * @param unmap URID unmap feature used to unmap keys
+                 * @return status of operation, STATUS_CORRUPTED if the file is not a valid container
+                 */
+                status_t                open(const char *path, const LV2_URID_Map *map, const LV2_URID_Unmap *unmap);
+
+                /**
+                 * Use the container located in memory, the memory should remain valid until the reader
+                 * is closed
+                 * @param data pointer to the container, should be aligned to 8 bytes
+                 * @param size size of the container
+                 * @param map URID map feature used to map type URIs
+                 * @param unmap URID unmap feature used to unmap keys
+                 * @return status of operation, STATUS_CORRUPTED if the data is not a valid container
+                 */
+                status_t                wrap(const void *data, size_t size, const LV2_URID_Map *map, const LV2_URID_Unmap *unmap);
+
+                /**
+                 * Close the container, all pointers returned by the reader become invalid
+                 */
+                void                    close();
+
+                /**
+                 * Retrieve the value, has the semantics of LV2_State_Retrieve_Function
+                 * @param key key of the value
+                 * @param size pointer to store the size of the value
+                 * @param type pointer to store the type of the value
+                 * @param flags pointer to store the flags of the value
+                 * @return pointer to the value or NULL if there is no such key
+                 */
+                const void             *retrieve(LV2_URID key, size_t *size, uint32_t *type, uint32_t *flags);
+
+                /**
+                 * Find the value by the URI of the key, does not use URID map features
+                 * @param uri URI of the key
+                 * @param size pointer to store the size of the value
+                 * @param type pointer to store the URI of the type
+                 * @param flags pointer to store the flags of the value
+                 * @return pointer to the value or NULL if there is no such key
+                 */
+                const void             *find(const char *uri, size_t *size, const char **type, uint32_t *flags) const;
+
+                /**
+                 * Get the retrieve function to pass to LV2_State_Interface::restore() along with handle()
+                 * @return retrieve function
+                 */
+                inline LV2_State_Retrieve_Function retrieve_function() const    { return do_retrieve; }
+
+                /**
+                 * Get the handle to pass to LV2_State_Interface::restore() along with retrieve_function()
+                 * @return handle of the reader
+                 */
+                inline LV2_State_Handle handle()                                { return this; }
+
+                /**
+                 * Get number of values in the container
+                 * @return number of values in the container
+                 */
+                inline size_t           size() const                            { return (pHeader != NULL) ? pHeader->entries : 0; }
+        };
+
+    } /* namespace lv2 */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_LV2_STATEREADER_H_ */
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_LV2_STATEWRITER_H_
+#define LSP_PLUG_IN_3RD_PARTY_LV2_STATEWRITER_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+
+#include <lv2/state/state.h>
+#include <lv2/urid/urid.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        /**
+         * Host backend of LV2_State_Store_Function which collects the values stored by the plugin
+         * and writes them into the binary container described in state_file.h. Only values with
+         * LV2_STATE_IS_POD flag are accepted. Storing the value with the key that has already been
+         * stored replaces the previous value. The values are copied, so the plugin may release them
+         * right after the store call.
+         *
+         * URIs of keys and types are unmapped and hashed once and cached until the writer is destroyed,
+         * so repeated saves of the same plugin and the container buffer are cheap.
+         */
+        class LSP_3RD_PARTY_EXPORT StateWriter
+        {
+            private:
+                typedef struct item_t
+                {
+                    LV2_URID                key;        // Key
+                    LV2_URID                type;       // Type
+                    uint32_t                flags;      // Flags
+                    size_t                  size;       // Size of the value
+                    size_t                  capacity;   // Space reserved for the value
+                    size_t                  offset;     // Offset of the value in the data buffer
+                    uint32_t                key_uri;    // Index of the key in the URI cache, valid while serializing
+                    uint32_t                type_uri;   // Index of the type in the URI cache, valid while serializing
+                } item_t;
+
+                typedef struct uri_t
+                {
+                    const char             *uri;        // URI string
+                    uint64_t                hash;       // Hash of the URI
+                    LV2_URID                urid;       // URID of the URI
+                    uint32_t                length;     // Length of the URI
+                    uint32_t                stamp;      // Stamp of the last serialization which used the URI
+                    uint32_t                index;      // Index of the URI in the container
+                    uint64_t                offset;     // Offset of the URI in the strings section of the container
+                } uri_t;
+
+            private:
+                item_t                 *vItems;         // Stored items in order of storing
+                size_t                  nItems;         // Number of items
+                size_t                  nCapacity;      // Capacity of items array
+                uint32_t               *vBins;          // Hash index by key: item index + 1, 0 for empty bin
+                size_t                  nBins;          // Number of hash bins, power of 2
+                uint8_t                *pData;          // Buffer of values
+                size_t                  nDataSize;      // Number of used bytes in the buffer
+                size_t                  nDataCap;       // Capacity of the buffer
+                uri_t                  *vUris;          // Cache of unmapped URIs
+                size_t                  nUris;          // Number of cached URIs
+                size_t                  nUriCap;        // Capacity of the URI cache
+                uint32_t               *vUriBins;       // Hash index of the URI cache by URID: URI index + 1, 0 for empty bin
+                size_t                  nUriBins;       // Number of hash bins of the URI cache, power of 2
+                uint32_t                nStamp;         // Stamp of the current serialization
+                uint8_t                *pImage;         // Serialized container
+                size_t                  nImageCap;      // Capacity of the container buffer
+                const LV2_URID_Unmap   *pUnmap;         // URID unmap feature
+
+            protected:
+                static LV2_State_Status do_store(LV2_State_Handle handle, uint32_t key, const void *value, size_t size, uint32_t type, uint32_t flags);
+
+            protected:
+                status_t                rehash(size_t bins);
+                status_t                reserve_data(size_t size);
+                status_t                rehash_uris(size_t bins);
+                ssize_t                 cache_uri(LV2_URID urid);
+
+            public:
+                explicit StateWriter();
+                StateWriter(const StateWriter &) = delete;
+                StateWriter(StateWriter &&) = delete;
+                ~StateWriter();
+
+                StateWriter & operator = (const StateWriter &) = delete;
+                StateWriter & operator = (StateWriter &&) = delete;
+
+            public:
+                /**
+                 * Initialize the writer
+                 * @param unmap URID unmap feature used to convert keys and types to URIs
+                 * @return status of operation
+                 */
+                status_t                init(const LV2_URID_Unmap *unmap);
+
+                /**
+                 * Destroy the writer and free all allocated memory
+                 */
+                void                    destroy();
+
+                /**
+                 * Remove all stored values but keep the allocated memory
+                 */
+                void                    clear();
+
+                /**
+                 * Store the value, has the semantics of LV2_State_Store_Function
+                 * @param key key of the value
+                 * @param value pointer to the value
+                 * @param size size of the value
+                 * @param type type of the value
+                 * @param flags flags of the value, set of LV2_State_Flags
+                 * @return status of operation
+                 */
+                LV2_State_Status        store(LV2_URID key, const void *value, size_t size, LV2_URID type, uint32_t flags);
+
+                /**
+                 * Get the store function to pass to LV2_State_Interface::save() along with handle()
+                 * @return store function
+                 */
+                inline LV2_State_Store_Function store_function() const      { return do_store; }
+
+                /**
+                 * Get the handle to pass to LV2_State_Interface::save() along with store_function()
+                 * @return handle of the writer
+                 */
+                inline LV2_State_Handle handle()                            { return this; }
+
+                /**
+                 * Get number of stored values
+                 * @return number of stored values
+                 */
+                inline size_t           size() const                        { return nItems; }
+
+                /**
+                 * Serialize stored values into the container
+                 * @param data pointer to store the pointer to the container owned by the writer, the container
+                 *   remains valid until the next call of serialize() or destroy()
+                 * @param size pointer to store the size of the container
+                 * @return status of operation, STATUS_NOT_FOUND if some key or type can not be unmapped
+                 */
+                status_t                serialize(const void **data, size_t *size);
+
+                /**
+                 * Save stored values to the file
+                 * @param path path to the file
+                 * @return status of operation, STATUS_NOT_FOUND if some key or type can not be unmapped
+                 */
+                status_t                save(const char *path);
+        };
+
+    } /* namespace lv2 */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_LV2_STATEWRITER_H_ */
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_LV2_URIDMAP_H_
+#define LSP_PLUG_IN_3RD_PARTY_LV2_URIDMAP_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/common/status.h>
+
+#include <lv2/urid/urid.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        /**
+         * Host implementation of LV2_URID_Map and LV2_URID_Unmap features which can be
+         * used from many threads at once. Lookup of already mapped URI and unmap never
+         * block and never retry: the hash table uses open addressing and each slot is
+         * published with single atomic operation. Mapping of new URI is lock-free.
+         * The strings are stored in append-only chunks and remain valid until the map
+         * is destroyed.
+         *
+         * The map is pre-seeded with all URIs of the registry defined in uris.h, so
+         * these URIs get the same small URIDs in every instance of the map: the URID
+         * is the uri_t identifier plus 1. Pointers returned by uri_string() are mapped
+         * without hashing and comparing the strings.
+         */
+        class LSP_3RD_PARTY_EXPORT UridMap
+        {
+            private:
+                typedef struct chunk_t
+                {
+                    chunk_t                *next;       // Next chunk
+                    size_t                  size;       // Capacity of the chunk
+                    size_t                  used;       // Number of bytes used
+                } chunk_t;
+
+            public:
+                static constexpr size_t     DEFAULT_CAPACITY    = 0x10000;  // Default maximum number of URIDs
+                static constexpr size_t     CHUNK_SIZE          = 0x10000;  // Size of the string chunk
+
+            private:
+                uint64_t               *vSlots;         // Hash table: tag of hash and URID, 0 for empty slot
+                size_t                  nMask;          // Mask of the slot index
+                const char            **vStrings;       // Strings indexed by URID
+                size_t                  nCapacity;      // Maximum number of URIDs
+                uint32_t                nNext;          // Next URID to allocate
+                uint32_t                nSize;          // Number of mapped URIs
+                size_t                  nSeeded;        // Number of pre-seeded URIDs
+                chunk_t                *pChunks;        // Storage for strings
+                uint8_t                *pData;          // Allocated data
+                LV2_URID_Map            sMap;           // Map feature
+                LV2_URID_Unmap          sUnmap;         // Unmap feature
+
+            protected:
+                static LV2_URID         map_uri(LV2_URID_Map_Handle handle, const char *uri);
+                static const char      *unmap_uri(LV2_URID_Unmap_Handle handle, LV2_URID urid);
+
+            protected:
+                LV2_URID                insert(const char *uri, bool copy);
+                char                   *store(const char *uri, size_t len);
+                void                    release_chunks();
+
+            public:
+                explicit UridMap();
+                UridMap(const UridMap &) = delete;
+                UridMap(UridMap &&) = delete;
+                ~UridMap();
+
+                UridMap & operator = (const UridMap &) = delete;
+                UridMap & operator = (UridMap &&) = delete;
+
+            public:
+                /**
+                 * Initialize the map and map all URIs of the registry
+                 * @param capacity maximum number of URIDs including the pre-seeded ones
+                 * @return status of operation
+                 */
+                status_t                init(size_t capacity = DEFAULT_CAPACITY);
+
+                /**
+                 * Destroy the map, should not be called concurrently with other methods
+                 */
+                void                    destroy();
+
+                /**
+                 * Map URI to URID
+                 * @param uri URI to map
+                 * @return URID or 0 if URI is NULL or the capacity of the map is exceeded
+                 */
+                LV2_URID                map(const char *uri);
+
+                /**
+                 * Get URID of already mapped URI, never modifies the map
+                 * @param uri URI to search
+                 * @return URID or 0 if URI is not mapped
+                 */
+                LV2_URID                find(const char *uri) const;
+
+                /**
+                 * Get URI of URID
+                 * @param urid URID
+                 * @return URI or NULL if URID is not mapped
+                 */
+                const char             *unmap(LV2_URID urid) const;
+
+                /**
+                 * Get number of mapped URIs
+                 * @return number of mapped URIs
+                 */
+                inline size_t           size() const        { return atomic_load(&nSize); }
+
+                /**
+                 * Get number of URIs mapped by init(), these URIs have URIDs from 1 to seeded()
+                 * @return number of pre-seeded URIs
+                 */
+                inline size_t           seeded() const      { return nSeeded; }
+
+                /**
+                 * Get data of LV2_URID__map feature
+                 * @return data of LV2_URID__map feature
+                 */
+                inline LV2_URID_Map    *map_feature()       { return &sMap; }
+
+                /**
+                 * Get data of LV2_URID__unmap feature
+                 * @return data of LV2_URID__unmap feature
+                 */
+                inline LV2_URID_Unmap  *unmap_feature()     { return &sUnmap; }
+        };
+
+    } /* namespace lv2 */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_LV2_URIDMAP_H_ */
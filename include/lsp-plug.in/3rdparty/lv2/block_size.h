@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_LV2_BLOCK_SIZE_H_
+#define LSP_PLUG_IN_3RD_PARTY_LV2_BLOCK_SIZE_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+
+#include <lv2/core/lv2.h>
+#include <lv2/options/options.h>
+#include <lv2/urid/urid.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        /**
+         * Guarantees on the block length provided by the host with buf-size features
+         */
+        enum block_flags_t
+        {
+            BLOCK_BOUNDED           = 1 << 0,   // buf-size:boundedBlockLength
+            BLOCK_FIXED             = 1 << 1,   // buf-size:fixedBlockLength
+            BLOCK_POWER_OF_2        = 1 << 2,   // buf-size:powerOf2BlockLength
+            BLOCK_COARSE            = 1 << 3    // buf-size:coarseBlockLength
+        };
+
+        /**
+         * Block size contract negotiated with the host. Unknown lengths are zero.
+         */
+        typedef struct block_size_t
+        {
+            uint32_t            min_length;     // buf-size:minBlockLength
+            uint32_t            max_length;     // buf-size:maxBlockLength
+            uint32_t            nominal_length; // buf-size:nominalBlockLength
+            uint32_t            sequence_size;  // buf-size:sequenceSize
+            float               sample_rate;    // param:sampleRate, zero if unknown
+            uint32_t            flags;          // Guarantees, set of block_flags_t
+        } block_size_t;
+
+        /**
+         * Reset the contract to the state with no guarantees
+         * @param bs contract to reset
+         */
+        LSP_3RD_PARTY_EXPORT
+        void block_size_reset(block_size_t *bs);
+
+        /**
+         * Read buf-size and param:sampleRate options into the contract. Values of atom:Int,
+         * atom:Long, atom:Float and atom:Double types are accepted, other options are ignored.
+         * Fields not present in the options keep their previous values.
+         *
+         * @param bs contract to update
+         * @param options array of options terminated by the option with zero key, may be NULL
+         * @param map URID map feature
+         * @return status of operation
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t block_size_parse_options(block_size_t *bs, const LV2_Options_Option *options, const LV2_URID_Map *map);
+
+        /**
+         * Build the contract from the features passed to the instantiate() call: the guarantees
+         * are taken from the buf-size features, the lengths from the options:options feature.
+         * The lengths are completed from each other if the guarantees allow it. If the host
+         * provides contradicting values, the BLOCK_FIXED and BLOCK_POWER_OF_2 guarantees are
+         * dropped, so the contract remains safe to use.
+         *
+         * @param bs contract to initialize
+         * @param features NULL-terminated array of features
+         * @return status of operation, STATUS_BAD_FORMAT if the guarantees have been dropped
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t block_size_parse(block_size_t *bs, const LV2_Feature * const *features);
+
+        /**
+         * Get the block length all run() calls are multiple of
+         * @param bs contract
+         * @return the block length or zero if there is no such guarantee
+         */
+        LSP_3RD_PARTY_EXPORT
+        uint32_t block_size_quantum(const block_size_t *bs);
+
+    } /* namespace lv2 */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_LV2_BLOCK_SIZE_H_ */
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_LV2_SEQUENCE_H_
+#define LSP_PLUG_IN_3RD_PARTY_LV2_SEQUENCE_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+
+#include <lv2/atom/atom.h>
+#include <lv2/urid/urid.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        static constexpr size_t SEQUENCE_MERGE_INPUTS   = 64;       // Maximum number of inputs merged without memory allocation
+
+        /**
+         * Merge sorted sequences into one sorted sequence in a single pass. The merge is stable:
+         * events with equal time stamps keep the order of input sequences and the order within
+         * each input sequence. All non-empty input sequences should have the same time unit:
+         * either atom:beatTime or audio frames. The type of the destination atom is left unchanged,
+         * the destination should not overlap any of source sequences.
+         *
+         * Does not allocate memory if number of inputs does not exceed SEQUENCE_MERGE_INPUTS.
+         *
+         * @param dst destination sequence
+         * @param capacity capacity of the destination sequence, the same as the capacity
+         *   argument of lv2_atom_sequence_append_event()
+         * @param src array of source sequences, NULL elements are allowed
+         * @param count number of source sequences
+         * @param beat_time mapped URID of atom:beatTime
+         * @return status of operation, STATUS_BAD_FORMAT if time units of inputs differ,
+         *   STATUS_OVERFLOW if not all events fit into the destination sequence: the destination
+         *   then contains the ordered prefix of the merged sequence
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t sequence_merge(
+            LV2_Atom_Sequence *dst, uint32_t capacity,
+            const LV2_Atom_Sequence * const *src, size_t count,
+            LV2_URID beat_time);
+
+        /**
+         * Check that events of the sequence are ordered by time
+         * @param seq sequence to check
+         * @param beat_time mapped URID of atom:beatTime
+         * @return true if events of the sequence are ordered by time
+         */
+        LSP_3RD_PARTY_EXPORT
+        bool sequence_is_sorted(const LV2_Atom_Sequence *seq, LV2_URID beat_time);
+
+        /**
+         * Sort events of the sequence by time keeping the order of events with equal time stamps.
+         * Events should be padded as lv2_atom_sequence_append_event() and LV2_Atom_Forge do.
+         * With scratch buffer the sequence is sorted with natural merge sort in O(n log r) time
+         * where r is the number of ordered runs in the sequence. Without scratch buffer the events
+         * are moved in place with insertion sort which is linear for nearly ordered sequences
+         * and quadratic in the worst case.
+         *
+         * @param seq sequence to sort
+         * @param beat_time mapped URID of atom:beatTime
+         * @param scratch scratch buffer of at least seq->atom.size bytes aligned to 8 bytes, may be NULL
+         * @return status of operation, STATUS_CORRUPTED if the sequence contains truncated or not padded
+         *   events
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t sequence_sort(LV2_Atom_Sequence *seq, LV2_URID beat_time, void *scratch = NULL);
+
+    } /* namespace lv2 */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_LV2_SEQUENCE_H_ */
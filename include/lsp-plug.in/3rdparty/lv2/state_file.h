@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_LV2_STATE_FILE_H_
+#define LSP_PLUG_IN_3RD_PARTY_LV2_STATE_FILE_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        /*
+         * Binary container of the LV2 plugin state written by StateWriter and read by StateReader.
+         * Keys and types are stored as URI strings, so the container does not depend on URIDs of
+         * the session. All sections and values are aligned to 8 bytes, the offsets of sections
+         * are counted from the start of the file, the offsets of values are counted from the start
+         * of the data section. The numbers are stored in the native byte order of the writer, the
+         * reader refuses files with foreign byte order.
+         *
+         *   state_header_t
+         *   state_entry_t  entries[header.entries]
+         *   state_uri_t    uris[header.uris]
+         *   uint32_t       bins[header.bins]           - hash index of keys: entry index + 1, 0 for empty bin
+         *   char           strings[header.strings]     - NULL-terminated URIs
+         *   uint8_t        data[header.data]           - values
+         */
+
+        static constexpr uint32_t   STATE_FILE_MAGIC        = 0x5332564c;   // 'LV2S' in the little-endian byte order
+        static constexpr uint16_t   STATE_FILE_VERSION      = 1;            // Version of the container format
+        static constexpr uint16_t   STATE_FILE_BYTE_ORDER   = 0x0102;       // Byte order mark
+        static constexpr size_t     STATE_FILE_ALIGN        = 8;            // Alignment of sections and values
+
+        typedef struct state_header_t
+        {
+            uint32_t            magic;          // STATE_FILE_MAGIC
+            uint16_t            version;        // STATE_FILE_VERSION
+            uint16_t            byte_order;     // STATE_FILE_BYTE_ORDER
+            uint32_t            entries;        // Number of entries
+            uint32_t            uris;           // Number of URIs
+            uint32_t            bins;           // Number of hash bins, power of 2 greater than number of entries
+            uint32_t            reserved;       // Reserved, should be zero
+            uint64_t            entries_offset; // Offset of entries
+            uint64_t            uris_offset;    // Offset of URIs
+            uint64_t            bins_offset;    // Offset of hash bins
+            uint64_t            strings_offset; // Offset of strings
+            uint64_t            strings;        // Size of strings
+            uint64_t            data_offset;    // Offset of data
+            uint64_t            data;           // Size of data
+        } state_header_t;
+
+        typedef struct state_entry_t
+        {
+            uint32_t            key;            // Index of key URI
+            uint32_t            type;           // Index of type URI
+            uint32_t            flags;          // LV2_State_Flags
+            uint32_t            hash;           // Lower 32 bits of the key URI hash
+            uint64_t            offset;         // Offset of the value in the data section
+            uint64_t            size;           // Size of the value
+        } state_entry_t;
+
+        typedef struct state_uri_t
+        {
+            uint32_t            offset;         // Offset of the URI in the strings section
+            uint32_t            length;         // Length of the URI without terminating zero
+        } state_uri_t;
+
+        /**
+         * Compute hash of the URI used by the hash index of the container
+         * @param uri URI
+         * @param len length of the URI
+         * @return hash of the URI
+         */
+        inline uint64_t state_hash_uri(const char *uri, size_t len)
+        {
+            // FNV-1a
+            uint64_t hash       = 0xcbf29ce484222325ULL;
+            for (size_t i=0; i<len; ++i)
+            {
+                hash               ^= uint8_t(uri[i]);
+                hash               *= 0x100000001b3ULL;
+            }
+            return hash;
+        }
+
+        /**
+         * Round the size up to the alignment of the container
+         * @param size size to align
+         * @return aligned size
+         */
+        inline uint64_t state_align(uint64_t size)
+        {
+            return (size + STATE_FILE_ALIGN - 1) & ~uint64_t(STATE_FILE_ALIGN - 1);
+        }
+
+    } /* namespace lv2 */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_LV2_STATE_FILE_H_ */
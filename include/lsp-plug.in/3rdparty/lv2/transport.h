@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_LV2_TRANSPORT_H_
+#define LSP_PLUG_IN_3RD_PARTY_LV2_TRANSPORT_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+
+#include <lv2/atom/atom.h>
+#include <lv2/atom/forge.h>
+#include <lv2/time/time.h>
+#include <lv2/urid/urid.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        /**
+         * Fields of the transport, the index of the field defines the bit in the mask
+         * of fields
+         */
+        enum transport_field_t
+        {
+            TRANSPORT_FRAME,                    // time:frame
+            TRANSPORT_SPEED,                    // time:speed
+            TRANSPORT_BAR,                      // time:bar
+            TRANSPORT_BAR_BEAT,                 // time:barBeat
+            TRANSPORT_BEAT,                     // time:beat
+            TRANSPORT_BEAT_UNIT,                // time:beatUnit
+            TRANSPORT_BEATS_PER_BAR,            // time:beatsPerBar
+            TRANSPORT_BEATS_PER_MINUTE,         // time:beatsPerMinute
+            TRANSPORT_FRAMES_PER_SECOND,        // time:framesPerSecond
+
+            TRANSPORT_FIELDS,
+
+            TRANSPORT_KEY_RANGE     = 32        // Maximum span of key URIDs for the direct lookup
+        };
+
+        /**
+         * Masks of the transport fields
+         */
+        enum transport_mask_t
+        {
+            TRANSPORT_M_FRAME               = 1 << TRANSPORT_FRAME,
+            TRANSPORT_M_SPEED               = 1 << TRANSPORT_SPEED,
+            TRANSPORT_M_BAR                 = 1 << TRANSPORT_BAR,
+            TRANSPORT_M_BAR_BEAT            = 1 << TRANSPORT_BAR_BEAT,
+            TRANSPORT_M_BEAT                = 1 << TRANSPORT_BEAT,
+            TRANSPORT_M_BEAT_UNIT           = 1 << TRANSPORT_BEAT_UNIT,
+            TRANSPORT_M_BEATS_PER_BAR       = 1 << TRANSPORT_BEATS_PER_BAR,
+            TRANSPORT_M_BEATS_PER_MINUTE    = 1 << TRANSPORT_BEATS_PER_MINUTE,
+            TRANSPORT_M_FRAMES_PER_SECOND   = 1 << TRANSPORT_FRAMES_PER_SECOND,
+
+            TRANSPORT_M_ALL                 = (1 << TRANSPORT_FIELDS) - 1
+        };
+
+        /**
+         * URIDs required to decode and encode time:Position objects
+         */
+        typedef struct transport_urids_t
+        {
+            LV2_URID            atom_Blank;     // atom:Blank
+            LV2_URID            atom_Bool;      // atom:Bool
+            LV2_URID            atom_Double;    // atom:Double
+            LV2_URID            atom_Float;     // atom:Float
+            LV2_URID            atom_Int;       // atom:Int
+            LV2_URID            atom_Long;      // atom:Long
+            LV2_URID            atom_Object;    // atom:Object
+            LV2_URID            time_Position;  // time:Position
+            LV2_URID            key[TRANSPORT_FIELDS];  // Property keys indexed by transport_field_t
+            LV2_URID            key_first;      // Minimum URID of property keys
+            uint32_t            key_range;      // Span of property keys, zero if the direct lookup is not possible
+            uint8_t             key_index[TRANSPORT_KEY_RANGE]; // Field for key_first + i, TRANSPORT_FIELDS for foreign keys
+        } transport_urids_t;
+
+        /**
+         * Flat state of the transport. The value types match the ranges recommended
+         * by the LV2 time extension, so the encoded values are decoded back exactly.
+         */
+        typedef struct transport_t
+        {
+            int64_t             frame;              // time:frame
+            int64_t             bar;                // time:bar
+            double              beat;               // time:beat
+            float               speed;              // time:speed
+            float               bar_beat;           // time:barBeat
+            float               beats_per_bar;      // time:beatsPerBar
+            float               beats_per_minute;   // time:beatsPerMinute
+            float               frames_per_second;  // time:framesPerSecond
+            int32_t             beat_unit;          // time:beatUnit
+            uint32_t            fields;             // Mask of fields that have been ever received
+        } transport_t;
+
+        /**
+         * Map URIDs required by the transport decoder and encoder
+         * @param urids URIDs to initialize
+         * @param map URID map feature
+         * @return status of operation, STATUS_NOT_FOUND if some URIs were not mapped
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t transport_urids_init(transport_urids_t *urids, const LV2_URID_Map *map);
+
+        /**
+         * Reset transport to the stopped state with no fields received
+         * @param t transport to reset
+         */
+        LSP_3RD_PARTY_EXPORT
+        void transport_reset(transport_t *t);
+
+        /**
+         * Decode time:Position object in a single pass over its properties. Numeric properties
+         * of any numeric atom type are accepted, unknown properties are ignored. Fields not
+         * present in the object keep their previous values.
+         *
+         * @param t transport to update
+         * @param atom atom:Object or atom:Blank atom with the time:Position type
+         * @param urids mapped URIDs
+         * @return mask of fields which have been received for the first time or changed their values,
+         *   zero if atom is not a time:Position object
+         */
+        LSP_3RD_PARTY_EXPORT
+        uint32_t transport_decode(transport_t *t, const LV2_Atom *atom, const transport_urids_t *urids);
+
+        /**
+         * Encode time:Position object. The forge should be initialized with the same URID map
+         * as the URIDs.
+         *
+         * @param forge forge to write the object
+         * @param t transport to encode
+         * @param fields mask of fields to encode, only fields ever received by the transport are encoded
+         * @param urids mapped URIDs
+         * @return reference to the object or zero on forge buffer overflow
+         */
+        LSP_3RD_PARTY_EXPORT
+        LV2_Atom_Forge_Ref transport_encode(
+            LV2_Atom_Forge *forge, const transport_t *t, uint32_t fields,
+            const transport_urids_t *urids);
+
+    } /* namespace lv2 */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_LV2_TRANSPORT_H_ */
@@ -0,0 +1,496 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * List of URIs defined by the vendored LV2 headers in include/lv2. The list is
+ * maintained manually: when the LV2 headers are updated, the new URI macros should
+ * be added here by hand. Each entry is LSP_LV2_URI(identifier, URI) where identifier
+ * is the name of the URI macro without LV2_ prefix. Legacy aliases of other URIs are
+ * omitted. The index of the entry defines the URID of the URI in UridMap, so new
+ * entries should be added to the end of the list and existing ones never removed.
+ *
+ * The file has no include guard, LSP_LV2_URI should be defined before inclusion.
+ */
+
+#ifndef LSP_LV2_URI
+    #error "LSP_LV2_URI(id, uri) should be defined before including this file"
+#endif /* LSP_LV2_URI */
+
+// lv2/atom/atom.h
+LSP_LV2_URI(ATOM_URI,                            LV2_ATOM_URI)
+LSP_LV2_URI(ATOM__Atom,                          LV2_ATOM__Atom)
+LSP_LV2_URI(ATOM__AtomPort,                      LV2_ATOM__AtomPort)
+LSP_LV2_URI(ATOM__Blank,                         LV2_ATOM__Blank)
+LSP_LV2_URI(ATOM__Bool,                          LV2_ATOM__Bool)
+LSP_LV2_URI(ATOM__Chunk,                         LV2_ATOM__Chunk)
+LSP_LV2_URI(ATOM__Double,                        LV2_ATOM__Double)
+LSP_LV2_URI(ATOM__Event,                         LV2_ATOM__Event)
+LSP_LV2_URI(ATOM__Float,                         LV2_ATOM__Float)
+LSP_LV2_URI(ATOM__Int,                           LV2_ATOM__Int)
+LSP_LV2_URI(ATOM__Literal,                       LV2_ATOM__Literal)
+LSP_LV2_URI(ATOM__Long,                          LV2_ATOM__Long)
+LSP_LV2_URI(ATOM__Number,                        LV2_ATOM__Number)
+LSP_LV2_URI(ATOM__Object,                        LV2_ATOM__Object)
+LSP_LV2_URI(ATOM__Path,                          LV2_ATOM__Path)
+LSP_LV2_URI(ATOM__Property,                      LV2_ATOM__Property)
+LSP_LV2_URI(ATOM__Resource,                      LV2_ATOM__Resource)
+LSP_LV2_URI(ATOM__Sequence,                      LV2_ATOM__Sequence)
+LSP_LV2_URI(ATOM__Sound,                         LV2_ATOM__Sound)
+LSP_LV2_URI(ATOM__String,                        LV2_ATOM__String)
+LSP_LV2_URI(ATOM__Tuple,                         LV2_ATOM__Tuple)
+LSP_LV2_URI(ATOM__URI,                           LV2_ATOM__URI)
+LSP_LV2_URI(ATOM__URID,                          LV2_ATOM__URID)
+LSP_LV2_URI(ATOM__Vector,                        LV2_ATOM__Vector)
+LSP_LV2_URI(ATOM__atomTransfer,                  LV2_ATOM__atomTransfer)
+LSP_LV2_URI(ATOM__beatTime,                      LV2_ATOM__beatTime)
+LSP_LV2_URI(ATOM__bufferType,                    LV2_ATOM__bufferType)
+LSP_LV2_URI(ATOM__childType,                     LV2_ATOM__childType)
+LSP_LV2_URI(ATOM__eventTransfer,                 LV2_ATOM__eventTransfer)
+LSP_LV2_URI(ATOM__frameTime,                     LV2_ATOM__frameTime)
+LSP_LV2_URI(ATOM__supports,                      LV2_ATOM__supports)
+LSP_LV2_URI(ATOM__timeUnit,                      LV2_ATOM__timeUnit)
+
+// lv2/buf-size/buf-size.h
+LSP_LV2_URI(BUF_SIZE_URI,                        LV2_BUF_SIZE_URI)
+LSP_LV2_URI(BUF_SIZE__boundedBlockLength,        LV2_BUF_SIZE__boundedBlockLength)
+LSP_LV2_URI(BUF_SIZE__coarseBlockLength,         LV2_BUF_SIZE__coarseBlockLength)
+LSP_LV2_URI(BUF_SIZE__fixedBlockLength,          LV2_BUF_SIZE__fixedBlockLength)
+LSP_LV2_URI(BUF_SIZE__maxBlockLength,            LV2_BUF_SIZE__maxBlockLength)
+LSP_LV2_URI(BUF_SIZE__minBlockLength,            LV2_BUF_SIZE__minBlockLength)
+LSP_LV2_URI(BUF_SIZE__nominalBlockLength,        LV2_BUF_SIZE__nominalBlockLength)
+LSP_LV2_URI(BUF_SIZE__powerOf2BlockLength,       LV2_BUF_SIZE__powerOf2BlockLength)
+LSP_LV2_URI(BUF_SIZE__sequenceSize,              LV2_BUF_SIZE__sequenceSize)
+
+// lv2/core/lv2.h
+LSP_LV2_URI(CORE_URI,                            LV2_CORE_URI)
+LSP_LV2_URI(CORE__AllpassPlugin,                 LV2_CORE__AllpassPlugin)
+LSP_LV2_URI(CORE__AmplifierPlugin,               LV2_CORE__AmplifierPlugin)
+LSP_LV2_URI(CORE__AnalyserPlugin,                LV2_CORE__AnalyserPlugin)
+LSP_LV2_URI(CORE__AudioPort,                     LV2_CORE__AudioPort)
+LSP_LV2_URI(CORE__BandpassPlugin,                LV2_CORE__BandpassPlugin)
+LSP_LV2_URI(CORE__CVPort,                        LV2_CORE__CVPort)
+LSP_LV2_URI(CORE__ChorusPlugin,                  LV2_CORE__ChorusPlugin)
+LSP_LV2_URI(CORE__CombPlugin,                    LV2_CORE__CombPlugin)
+LSP_LV2_URI(CORE__CompressorPlugin,              LV2_CORE__CompressorPlugin)
+LSP_LV2_URI(CORE__ConstantPlugin,                LV2_CORE__ConstantPlugin)
+LSP_LV2_URI(CORE__ControlPort,                   LV2_CORE__ControlPort)
+LSP_LV2_URI(CORE__ConverterPlugin,               LV2_CORE__ConverterPlugin)
+LSP_LV2_URI(CORE__DelayPlugin,                   LV2_CORE__DelayPlugin)
+LSP_LV2_URI(CORE__DistortionPlugin,              LV2_CORE__DistortionPlugin)
+LSP_LV2_URI(CORE__DynamicsPlugin,                LV2_CORE__DynamicsPlugin)
+LSP_LV2_URI(CORE__EQPlugin,                      LV2_CORE__EQPlugin)
+LSP_LV2_URI(CORE__EnvelopePlugin,                LV2_CORE__EnvelopePlugin)
+LSP_LV2_URI(CORE__ExpanderPlugin,                LV2_CORE__ExpanderPlugin)
+LSP_LV2_URI(CORE__ExtensionData,                 LV2_CORE__ExtensionData)
+LSP_LV2_URI(CORE__Feature,                       LV2_CORE__Feature)
+LSP_LV2_URI(CORE__FilterPlugin,                  LV2_CORE__FilterPlugin)
+LSP_LV2_URI(CORE__FlangerPlugin,                 LV2_CORE__FlangerPlugin)
+LSP_LV2_URI(CORE__FunctionPlugin,                LV2_CORE__FunctionPlugin)
+LSP_LV2_URI(CORE__GatePlugin,                    LV2_CORE__GatePlugin)
+LSP_LV2_URI(CORE__GeneratorPlugin,               LV2_CORE__GeneratorPlugin)
+LSP_LV2_URI(CORE__HighpassPlugin,                LV2_CORE__HighpassPlugin)
+LSP_LV2_URI(CORE__InputPort,                     LV2_CORE__InputPort)
+LSP_LV2_URI(CORE__InstrumentPlugin,              LV2_CORE__InstrumentPlugin)
+LSP_LV2_URI(CORE__LimiterPlugin,                 LV2_CORE__LimiterPlugin)
+LSP_LV2_URI(CORE__LowpassPlugin,                 LV2_CORE__LowpassPlugin)
+LSP_LV2_URI(CORE__MixerPlugin,                   LV2_CORE__MixerPlugin)
+LSP_LV2_URI(CORE__ModulatorPlugin,               LV2_CORE__ModulatorPlugin)
+LSP_LV2_URI(CORE__MultiEQPlugin,                 LV2_CORE__MultiEQPlugin)
+LSP_LV2_URI(CORE__OscillatorPlugin,              LV2_CORE__OscillatorPlugin)
+LSP_LV2_URI(CORE__OutputPort,                    LV2_CORE__OutputPort)
+LSP_LV2_URI(CORE__ParaEQPlugin,                  LV2_CORE__ParaEQPlugin)
+LSP_LV2_URI(CORE__PhaserPlugin,                  LV2_CORE__PhaserPlugin)
+LSP_LV2_URI(CORE__PitchPlugin,                   LV2_CORE__PitchPlugin)
+LSP_LV2_URI(CORE__Plugin,                        LV2_CORE__Plugin)
+LSP_LV2_URI(CORE__PluginBase,                    LV2_CORE__PluginBase)
+LSP_LV2_URI(CORE__Point,                         LV2_CORE__Point)
+LSP_LV2_URI(CORE__Port,                          LV2_CORE__Port)
+LSP_LV2_URI(CORE__PortProperty,                  LV2_CORE__PortProperty)
+LSP_LV2_URI(CORE__Resource,                      LV2_CORE__Resource)
+LSP_LV2_URI(CORE__ReverbPlugin,                  LV2_CORE__ReverbPlugin)
+LSP_LV2_URI(CORE__ScalePoint,                    LV2_CORE__ScalePoint)
+LSP_LV2_URI(CORE__SimulatorPlugin,               LV2_CORE__SimulatorPlugin)
+LSP_LV2_URI(CORE__SpatialPlugin,                 LV2_CORE__SpatialPlugin)
+LSP_LV2_URI(CORE__Specification,                 LV2_CORE__Specification)
+LSP_LV2_URI(CORE__SpectralPlugin,                LV2_CORE__SpectralPlugin)
+LSP_LV2_URI(CORE__UtilityPlugin,                 LV2_CORE__UtilityPlugin)
+LSP_LV2_URI(CORE__WaveshaperPlugin,              LV2_CORE__WaveshaperPlugin)
+LSP_LV2_URI(CORE__appliesTo,                     LV2_CORE__appliesTo)
+LSP_LV2_URI(CORE__binary,                        LV2_CORE__binary)
+LSP_LV2_URI(CORE__connectionOptional,            LV2_CORE__connectionOptional)
+LSP_LV2_URI(CORE__control,                       LV2_CORE__control)
+LSP_LV2_URI(CORE__default,                       LV2_CORE__default)
+LSP_LV2_URI(CORE__designation,                   LV2_CORE__designation)
+LSP_LV2_URI(CORE__documentation,                 LV2_CORE__documentation)
+LSP_LV2_URI(CORE__enabled,                       LV2_CORE__enabled)
+LSP_LV2_URI(CORE__enumeration,                   LV2_CORE__enumeration)
+LSP_LV2_URI(CORE__extensionData,                 LV2_CORE__extensionData)
+LSP_LV2_URI(CORE__freeWheeling,                  LV2_CORE__freeWheeling)
+LSP_LV2_URI(CORE__hardRTCapable,                 LV2_CORE__hardRTCapable)
+LSP_LV2_URI(CORE__inPlaceBroken,                 LV2_CORE__inPlaceBroken)
+LSP_LV2_URI(CORE__index,                         LV2_CORE__index)
+LSP_LV2_URI(CORE__integer,                       LV2_CORE__integer)
+LSP_LV2_URI(CORE__isLive,                        LV2_CORE__isLive)
+LSP_LV2_URI(CORE__latency,                       LV2_CORE__latency)
+LSP_LV2_URI(CORE__maximum,                       LV2_CORE__maximum)
+LSP_LV2_URI(CORE__microVersion,                  LV2_CORE__microVersion)
+LSP_LV2_URI(CORE__minimum,                       LV2_CORE__minimum)
+LSP_LV2_URI(CORE__minorVersion,                  LV2_CORE__minorVersion)
+LSP_LV2_URI(CORE__name,                          LV2_CORE__name)
+LSP_LV2_URI(CORE__optionalFeature,               LV2_CORE__optionalFeature)
+LSP_LV2_URI(CORE__port,                          LV2_CORE__port)
+LSP_LV2_URI(CORE__portProperty,                  LV2_CORE__portProperty)
+LSP_LV2_URI(CORE__project,                       LV2_CORE__project)
+LSP_LV2_URI(CORE__prototype,                     LV2_CORE__prototype)
+LSP_LV2_URI(CORE__reportsLatency,                LV2_CORE__reportsLatency)
+LSP_LV2_URI(CORE__requiredFeature,               LV2_CORE__requiredFeature)
+LSP_LV2_URI(CORE__sampleRate,                    LV2_CORE__sampleRate)
+LSP_LV2_URI(CORE__scalePoint,                    LV2_CORE__scalePoint)
+LSP_LV2_URI(CORE__symbol,                        LV2_CORE__symbol)
+LSP_LV2_URI(CORE__toggled,                       LV2_CORE__toggled)
+
+// lv2/data-access/data-access.h
+LSP_LV2_URI(DATA_ACCESS_URI,                     LV2_DATA_ACCESS_URI)
+
+// lv2/dynmanifest/dynmanifest.h
+LSP_LV2_URI(DYN_MANIFEST_URI,                    LV2_DYN_MANIFEST_URI)
+
+// lv2/event/event.h
+LSP_LV2_URI(EVENT_URI,                           LV2_EVENT_URI)
+LSP_LV2_URI(EVENT__Event,                        LV2_EVENT__Event)
+LSP_LV2_URI(EVENT__EventPort,                    LV2_EVENT__EventPort)
+LSP_LV2_URI(EVENT__FrameStamp,                   LV2_EVENT__FrameStamp)
+LSP_LV2_URI(EVENT__TimeStamp,                    LV2_EVENT__TimeStamp)
+LSP_LV2_URI(EVENT__generatesTimeStamp,           LV2_EVENT__generatesTimeStamp)
+LSP_LV2_URI(EVENT__generic,                      LV2_EVENT__generic)
+LSP_LV2_URI(EVENT__inheritsEvent,                LV2_EVENT__inheritsEvent)
+LSP_LV2_URI(EVENT__inheritsTimeStamp,            LV2_EVENT__inheritsTimeStamp)
+LSP_LV2_URI(EVENT__supportsEvent,                LV2_EVENT__supportsEvent)
+LSP_LV2_URI(EVENT__supportsTimeStamp,            LV2_EVENT__supportsTimeStamp)
+
+// lv2/instance-access/instance-access.h
+LSP_LV2_URI(INSTANCE_ACCESS_URI,                 LV2_INSTANCE_ACCESS_URI)
+
+// lv2/log/log.h
+LSP_LV2_URI(LOG_URI,                             LV2_LOG_URI)
+LSP_LV2_URI(LOG__Entry,                          LV2_LOG__Entry)
+LSP_LV2_URI(LOG__Error,                          LV2_LOG__Error)
+LSP_LV2_URI(LOG__Note,                           LV2_LOG__Note)
+LSP_LV2_URI(LOG__Trace,                          LV2_LOG__Trace)
+LSP_LV2_URI(LOG__Warning,                        LV2_LOG__Warning)
+LSP_LV2_URI(LOG__log,                            LV2_LOG__log)
+
+// lv2/midi/midi.h
+LSP_LV2_URI(MIDI_URI,                            LV2_MIDI_URI)
+LSP_LV2_URI(MIDI__ActiveSense,                   LV2_MIDI__ActiveSense)
+LSP_LV2_URI(MIDI__Aftertouch,                    LV2_MIDI__Aftertouch)
+LSP_LV2_URI(MIDI__Bender,                        LV2_MIDI__Bender)
+LSP_LV2_URI(MIDI__ChannelPressure,               LV2_MIDI__ChannelPressure)
+LSP_LV2_URI(MIDI__Chunk,                         LV2_MIDI__Chunk)
+LSP_LV2_URI(MIDI__Clock,                         LV2_MIDI__Clock)
+LSP_LV2_URI(MIDI__Continue,                      LV2_MIDI__Continue)
+LSP_LV2_URI(MIDI__Controller,                    LV2_MIDI__Controller)
+LSP_LV2_URI(MIDI__MidiEvent,                     LV2_MIDI__MidiEvent)
+LSP_LV2_URI(MIDI__NoteOff,                       LV2_MIDI__NoteOff)
+LSP_LV2_URI(MIDI__NoteOn,                        LV2_MIDI__NoteOn)
+LSP_LV2_URI(MIDI__ProgramChange,                 LV2_MIDI__ProgramChange)
+LSP_LV2_URI(MIDI__QuarterFrame,                  LV2_MIDI__QuarterFrame)
+LSP_LV2_URI(MIDI__Reset,                         LV2_MIDI__Reset)
+LSP_LV2_URI(MIDI__SongPosition,                  LV2_MIDI__SongPosition)
+LSP_LV2_URI(MIDI__SongSelect,                    LV2_MIDI__SongSelect)
+LSP_LV2_URI(MIDI__Start,                         LV2_MIDI__Start)
+LSP_LV2_URI(MIDI__Stop,                          LV2_MIDI__Stop)
+LSP_LV2_URI(MIDI__SystemCommon,                  LV2_MIDI__SystemCommon)
+LSP_LV2_URI(MIDI__SystemExclusive,               LV2_MIDI__SystemExclusive)
+LSP_LV2_URI(MIDI__SystemMessage,                 LV2_MIDI__SystemMessage)
+LSP_LV2_URI(MIDI__SystemRealtime,                LV2_MIDI__SystemRealtime)
+LSP_LV2_URI(MIDI__Tick,                          LV2_MIDI__Tick)
+LSP_LV2_URI(MIDI__TuneRequest,                   LV2_MIDI__TuneRequest)
+LSP_LV2_URI(MIDI__VoiceMessage,                  LV2_MIDI__VoiceMessage)
+LSP_LV2_URI(MIDI__benderValue,                   LV2_MIDI__benderValue)
+LSP_LV2_URI(MIDI__binding,                       LV2_MIDI__binding)
+LSP_LV2_URI(MIDI__byteNumber,                    LV2_MIDI__byteNumber)
+LSP_LV2_URI(MIDI__channel,                       LV2_MIDI__channel)
+LSP_LV2_URI(MIDI__chunk,                         LV2_MIDI__chunk)
+LSP_LV2_URI(MIDI__controllerNumber,              LV2_MIDI__controllerNumber)
+LSP_LV2_URI(MIDI__controllerValue,               LV2_MIDI__controllerValue)
+LSP_LV2_URI(MIDI__noteNumber,                    LV2_MIDI__noteNumber)
+LSP_LV2_URI(MIDI__pressure,                      LV2_MIDI__pressure)
+LSP_LV2_URI(MIDI__programNumber,                 LV2_MIDI__programNumber)
+LSP_LV2_URI(MIDI__property,                      LV2_MIDI__property)
+LSP_LV2_URI(MIDI__songNumber,                    LV2_MIDI__songNumber)
+LSP_LV2_URI(MIDI__songPosition,                  LV2_MIDI__songPosition)
+LSP_LV2_URI(MIDI__status,                        LV2_MIDI__status)
+LSP_LV2_URI(MIDI__statusMask,                    LV2_MIDI__statusMask)
+LSP_LV2_URI(MIDI__velocity,                      LV2_MIDI__velocity)
+
+// lv2/morph/morph.h
+LSP_LV2_URI(MORPH_URI,                           LV2_MORPH_URI)
+LSP_LV2_URI(MORPH__AutoMorphPort,                LV2_MORPH__AutoMorphPort)
+LSP_LV2_URI(MORPH__MorphPort,                    LV2_MORPH__MorphPort)
+LSP_LV2_URI(MORPH__interface,                    LV2_MORPH__interface)
+LSP_LV2_URI(MORPH__supportsType,                 LV2_MORPH__supportsType)
+LSP_LV2_URI(MORPH__currentType,                  LV2_MORPH__currentType)
+
+// lv2/options/options.h
+LSP_LV2_URI(OPTIONS_URI,                         LV2_OPTIONS_URI)
+LSP_LV2_URI(OPTIONS__Option,                     LV2_OPTIONS__Option)
+LSP_LV2_URI(OPTIONS__interface,                  LV2_OPTIONS__interface)
+LSP_LV2_URI(OPTIONS__options,                    LV2_OPTIONS__options)
+LSP_LV2_URI(OPTIONS__requiredOption,             LV2_OPTIONS__requiredOption)
+LSP_LV2_URI(OPTIONS__supportedOption,            LV2_OPTIONS__supportedOption)
+
+// lv2/parameters/parameters.h
+LSP_LV2_URI(PARAMETERS_URI,                      LV2_PARAMETERS_URI)
+LSP_LV2_URI(PARAMETERS__CompressorControls,      LV2_PARAMETERS__CompressorControls)
+LSP_LV2_URI(PARAMETERS__ControlGroup,            LV2_PARAMETERS__ControlGroup)
+LSP_LV2_URI(PARAMETERS__EnvelopeControls,        LV2_PARAMETERS__EnvelopeControls)
+LSP_LV2_URI(PARAMETERS__FilterControls,          LV2_PARAMETERS__FilterControls)
+LSP_LV2_URI(PARAMETERS__OscillatorControls,      LV2_PARAMETERS__OscillatorControls)
+LSP_LV2_URI(PARAMETERS__amplitude,               LV2_PARAMETERS__amplitude)
+LSP_LV2_URI(PARAMETERS__attack,                  LV2_PARAMETERS__attack)
+LSP_LV2_URI(PARAMETERS__bypass,                  LV2_PARAMETERS__bypass)
+LSP_LV2_URI(PARAMETERS__cutoffFrequency,         LV2_PARAMETERS__cutoffFrequency)
+LSP_LV2_URI(PARAMETERS__decay,                   LV2_PARAMETERS__decay)
+LSP_LV2_URI(PARAMETERS__delay,                   LV2_PARAMETERS__delay)
+LSP_LV2_URI(PARAMETERS__dryLevel,                LV2_PARAMETERS__dryLevel)
+LSP_LV2_URI(PARAMETERS__frequency,               LV2_PARAMETERS__frequency)
+LSP_LV2_URI(PARAMETERS__gain,                    LV2_PARAMETERS__gain)
+LSP_LV2_URI(PARAMETERS__hold,                    LV2_PARAMETERS__hold)
+LSP_LV2_URI(PARAMETERS__pulseWidth,              LV2_PARAMETERS__pulseWidth)
+LSP_LV2_URI(PARAMETERS__ratio,                   LV2_PARAMETERS__ratio)
+LSP_LV2_URI(PARAMETERS__release,                 LV2_PARAMETERS__release)
+LSP_LV2_URI(PARAMETERS__resonance,               LV2_PARAMETERS__resonance)
+LSP_LV2_URI(PARAMETERS__sampleRate,              LV2_PARAMETERS__sampleRate)
+LSP_LV2_URI(PARAMETERS__sustain,                 LV2_PARAMETERS__sustain)
+LSP_LV2_URI(PARAMETERS__threshold,               LV2_PARAMETERS__threshold)
+LSP_LV2_URI(PARAMETERS__waveform,                LV2_PARAMETERS__waveform)
+LSP_LV2_URI(PARAMETERS__wetDryRatio,             LV2_PARAMETERS__wetDryRatio)
+LSP_LV2_URI(PARAMETERS__wetLevel,                LV2_PARAMETERS__wetLevel)
+
+// lv2/patch/patch.h
+LSP_LV2_URI(PATCH_URI,                           LV2_PATCH_URI)
+LSP_LV2_URI(PATCH__Ack,                          LV2_PATCH__Ack)
+LSP_LV2_URI(PATCH__Delete,                       LV2_PATCH__Delete)
+LSP_LV2_URI(PATCH__Copy,                         LV2_PATCH__Copy)
+LSP_LV2_URI(PATCH__Error,                        LV2_PATCH__Error)
+LSP_LV2_URI(PATCH__Get,                          LV2_PATCH__Get)
+LSP_LV2_URI(PATCH__Message,                      LV2_PATCH__Message)
+LSP_LV2_URI(PATCH__Move,                         LV2_PATCH__Move)
+LSP_LV2_URI(PATCH__Patch,                        LV2_PATCH__Patch)
+LSP_LV2_URI(PATCH__Post,                         LV2_PATCH__Post)
+LSP_LV2_URI(PATCH__Put,                          LV2_PATCH__Put)
+LSP_LV2_URI(PATCH__Request,                      LV2_PATCH__Request)
+LSP_LV2_URI(PATCH__Response,                     LV2_PATCH__Response)
+LSP_LV2_URI(PATCH__Set,                          LV2_PATCH__Set)
+LSP_LV2_URI(PATCH__accept,                       LV2_PATCH__accept)
+LSP_LV2_URI(PATCH__add,                          LV2_PATCH__add)
+LSP_LV2_URI(PATCH__body,                         LV2_PATCH__body)
+LSP_LV2_URI(PATCH__context,                      LV2_PATCH__context)
+LSP_LV2_URI(PATCH__destination,                  LV2_PATCH__destination)
+LSP_LV2_URI(PATCH__property,                     LV2_PATCH__property)
+LSP_LV2_URI(PATCH__readable,                     LV2_PATCH__readable)
+LSP_LV2_URI(PATCH__remove,                       LV2_PATCH__remove)
+LSP_LV2_URI(PATCH__request,                      LV2_PATCH__request)
+LSP_LV2_URI(PATCH__subject,                      LV2_PATCH__subject)
+LSP_LV2_URI(PATCH__sequenceNumber,               LV2_PATCH__sequenceNumber)
+LSP_LV2_URI(PATCH__value,                        LV2_PATCH__value)
+LSP_LV2_URI(PATCH__wildcard,                     LV2_PATCH__wildcard)
+LSP_LV2_URI(PATCH__writable,                     LV2_PATCH__writable)
+
+// lv2/port-groups/port-groups.h
+LSP_LV2_URI(PORT_GROUPS_URI,                     LV2_PORT_GROUPS_URI)
+LSP_LV2_URI(PORT_GROUPS__DiscreteGroup,          LV2_PORT_GROUPS__DiscreteGroup)
+LSP_LV2_URI(PORT_GROUPS__Element,                LV2_PORT_GROUPS__Element)
+LSP_LV2_URI(PORT_GROUPS__FivePointOneGroup,      LV2_PORT_GROUPS__FivePointOneGroup)
+LSP_LV2_URI(PORT_GROUPS__FivePointZeroGroup,     LV2_PORT_GROUPS__FivePointZeroGroup)
+LSP_LV2_URI(PORT_GROUPS__FourPointZeroGroup,     LV2_PORT_GROUPS__FourPointZeroGroup)
+LSP_LV2_URI(PORT_GROUPS__Group,                  LV2_PORT_GROUPS__Group)
+LSP_LV2_URI(PORT_GROUPS__InputGroup,             LV2_PORT_GROUPS__InputGroup)
+LSP_LV2_URI(PORT_GROUPS__MidSideGroup,           LV2_PORT_GROUPS__MidSideGroup)
+LSP_LV2_URI(PORT_GROUPS__MonoGroup,              LV2_PORT_GROUPS__MonoGroup)
+LSP_LV2_URI(PORT_GROUPS__OutputGroup,            LV2_PORT_GROUPS__OutputGroup)
+LSP_LV2_URI(PORT_GROUPS__SevenPointOneGroup,     LV2_PORT_GROUPS__SevenPointOneGroup)
+LSP_LV2_URI(PORT_GROUPS__SevenPointOneWideGroup, LV2_PORT_GROUPS__SevenPointOneWideGroup)
+LSP_LV2_URI(PORT_GROUPS__SixPointOneGroup,       LV2_PORT_GROUPS__SixPointOneGroup)
+LSP_LV2_URI(PORT_GROUPS__StereoGroup,            LV2_PORT_GROUPS__StereoGroup)
+LSP_LV2_URI(PORT_GROUPS__ThreePointZeroGroup,    LV2_PORT_GROUPS__ThreePointZeroGroup)
+LSP_LV2_URI(PORT_GROUPS__center,                 LV2_PORT_GROUPS__center)
+LSP_LV2_URI(PORT_GROUPS__centerLeft,             LV2_PORT_GROUPS__centerLeft)
+LSP_LV2_URI(PORT_GROUPS__centerRight,            LV2_PORT_GROUPS__centerRight)
+LSP_LV2_URI(PORT_GROUPS__element,                LV2_PORT_GROUPS__element)
+LSP_LV2_URI(PORT_GROUPS__group,                  LV2_PORT_GROUPS__group)
+LSP_LV2_URI(PORT_GROUPS__left,                   LV2_PORT_GROUPS__left)
+LSP_LV2_URI(PORT_GROUPS__lowFrequencyEffects,    LV2_PORT_GROUPS__lowFrequencyEffects)
+LSP_LV2_URI(PORT_GROUPS__mainInput,              LV2_PORT_GROUPS__mainInput)
+LSP_LV2_URI(PORT_GROUPS__mainOutput,             LV2_PORT_GROUPS__mainOutput)
+LSP_LV2_URI(PORT_GROUPS__rearCenter,             LV2_PORT_GROUPS__rearCenter)
+LSP_LV2_URI(PORT_GROUPS__rearLeft,               LV2_PORT_GROUPS__rearLeft)
+LSP_LV2_URI(PORT_GROUPS__rearRight,              LV2_PORT_GROUPS__rearRight)
+LSP_LV2_URI(PORT_GROUPS__right,                  LV2_PORT_GROUPS__right)
+LSP_LV2_URI(PORT_GROUPS__side,                   LV2_PORT_GROUPS__side)
+LSP_LV2_URI(PORT_GROUPS__sideChainOf,            LV2_PORT_GROUPS__sideChainOf)
+LSP_LV2_URI(PORT_GROUPS__sideLeft,               LV2_PORT_GROUPS__sideLeft)
+LSP_LV2_URI(PORT_GROUPS__sideRight,              LV2_PORT_GROUPS__sideRight)
+LSP_LV2_URI(PORT_GROUPS__source,                 LV2_PORT_GROUPS__source)
+LSP_LV2_URI(PORT_GROUPS__subGroupOf,             LV2_PORT_GROUPS__subGroupOf)
+
+// lv2/port-props/port-props.h
+LSP_LV2_URI(PORT_PROPS_URI,                      LV2_PORT_PROPS_URI)
+LSP_LV2_URI(PORT_PROPS__causesArtifacts,         LV2_PORT_PROPS__causesArtifacts)
+LSP_LV2_URI(PORT_PROPS__continuousCV,            LV2_PORT_PROPS__continuousCV)
+LSP_LV2_URI(PORT_PROPS__discreteCV,              LV2_PORT_PROPS__discreteCV)
+LSP_LV2_URI(PORT_PROPS__displayPriority,         LV2_PORT_PROPS__displayPriority)
+LSP_LV2_URI(PORT_PROPS__expensive,               LV2_PORT_PROPS__expensive)
+LSP_LV2_URI(PORT_PROPS__hasStrictBounds,         LV2_PORT_PROPS__hasStrictBounds)
+LSP_LV2_URI(PORT_PROPS__logarithmic,             LV2_PORT_PROPS__logarithmic)
+LSP_LV2_URI(PORT_PROPS__notAutomatic,            LV2_PORT_PROPS__notAutomatic)
+LSP_LV2_URI(PORT_PROPS__notOnGUI,                LV2_PORT_PROPS__notOnGUI)
+LSP_LV2_URI(PORT_PROPS__rangeSteps,              LV2_PORT_PROPS__rangeSteps)
+LSP_LV2_URI(PORT_PROPS__supportsStrictBounds,    LV2_PORT_PROPS__supportsStrictBounds)
+LSP_LV2_URI(PORT_PROPS__trigger,                 LV2_PORT_PROPS__trigger)
+
+// lv2/presets/presets.h
+LSP_LV2_URI(PRESETS_URI,                         LV2_PRESETS_URI)
+LSP_LV2_URI(PRESETS__Bank,                       LV2_PRESETS__Bank)
+LSP_LV2_URI(PRESETS__Preset,                     LV2_PRESETS__Preset)
+LSP_LV2_URI(PRESETS__bank,                       LV2_PRESETS__bank)
+LSP_LV2_URI(PRESETS__preset,                     LV2_PRESETS__preset)
+LSP_LV2_URI(PRESETS__value,                      LV2_PRESETS__value)
+
+// lv2/resize-port/resize-port.h
+LSP_LV2_URI(RESIZE_PORT_URI,                     LV2_RESIZE_PORT_URI)
+LSP_LV2_URI(RESIZE_PORT__asLargeAs,              LV2_RESIZE_PORT__asLargeAs)
+LSP_LV2_URI(RESIZE_PORT__minimumSize,            LV2_RESIZE_PORT__minimumSize)
+LSP_LV2_URI(RESIZE_PORT__resize,                 LV2_RESIZE_PORT__resize)
+
+// lv2/state/state.h
+LSP_LV2_URI(STATE_URI,                           LV2_STATE_URI)
+LSP_LV2_URI(STATE__State,                        LV2_STATE__State)
+LSP_LV2_URI(STATE__interface,                    LV2_STATE__interface)
+LSP_LV2_URI(STATE__loadDefaultState,             LV2_STATE__loadDefaultState)
+LSP_LV2_URI(STATE__freePath,                     LV2_STATE__freePath)
+LSP_LV2_URI(STATE__makePath,                     LV2_STATE__makePath)
+LSP_LV2_URI(STATE__mapPath,                      LV2_STATE__mapPath)
+LSP_LV2_URI(STATE__state,                        LV2_STATE__state)
+LSP_LV2_URI(STATE__threadSafeRestore,            LV2_STATE__threadSafeRestore)
+LSP_LV2_URI(STATE__StateChanged,                 LV2_STATE__StateChanged)
+
+// lv2/time/time.h
+LSP_LV2_URI(TIME_URI,                            LV2_TIME_URI)
+LSP_LV2_URI(TIME__Time,                          LV2_TIME__Time)
+LSP_LV2_URI(TIME__Position,                      LV2_TIME__Position)
+LSP_LV2_URI(TIME__Rate,                          LV2_TIME__Rate)
+LSP_LV2_URI(TIME__position,                      LV2_TIME__position)
+LSP_LV2_URI(TIME__barBeat,                       LV2_TIME__barBeat)
+LSP_LV2_URI(TIME__bar,                           LV2_TIME__bar)
+LSP_LV2_URI(TIME__beat,                          LV2_TIME__beat)
+LSP_LV2_URI(TIME__beatUnit,                      LV2_TIME__beatUnit)
+LSP_LV2_URI(TIME__beatsPerBar,                   LV2_TIME__beatsPerBar)
+LSP_LV2_URI(TIME__beatsPerMinute,                LV2_TIME__beatsPerMinute)
+LSP_LV2_URI(TIME__frame,                         LV2_TIME__frame)
+LSP_LV2_URI(TIME__framesPerSecond,               LV2_TIME__framesPerSecond)
+LSP_LV2_URI(TIME__speed,                         LV2_TIME__speed)
+
+// lv2/ui/ui.h
+LSP_LV2_URI(UI_URI,                              LV2_UI_URI)
+LSP_LV2_URI(UI__CocoaUI,                         LV2_UI__CocoaUI)
+LSP_LV2_URI(UI__Gtk3UI,                          LV2_UI__Gtk3UI)
+LSP_LV2_URI(UI__GtkUI,                           LV2_UI__GtkUI)
+LSP_LV2_URI(UI__PortNotification,                LV2_UI__PortNotification)
+LSP_LV2_URI(UI__PortProtocol,                    LV2_UI__PortProtocol)
+LSP_LV2_URI(UI__Qt4UI,                           LV2_UI__Qt4UI)
+LSP_LV2_URI(UI__Qt5UI,                           LV2_UI__Qt5UI)
+LSP_LV2_URI(UI__UI,                              LV2_UI__UI)
+LSP_LV2_URI(UI__WindowsUI,                       LV2_UI__WindowsUI)
+LSP_LV2_URI(UI__X11UI,                           LV2_UI__X11UI)
+LSP_LV2_URI(UI__binary,                          LV2_UI__binary)
+LSP_LV2_URI(UI__fixedSize,                       LV2_UI__fixedSize)
+LSP_LV2_URI(UI__idleInterface,                   LV2_UI__idleInterface)
+LSP_LV2_URI(UI__noUserResize,                    LV2_UI__noUserResize)
+LSP_LV2_URI(UI__notifyType,                      LV2_UI__notifyType)
+LSP_LV2_URI(UI__parent,                          LV2_UI__parent)
+LSP_LV2_URI(UI__plugin,                          LV2_UI__plugin)
+LSP_LV2_URI(UI__portIndex,                       LV2_UI__portIndex)
+LSP_LV2_URI(UI__portMap,                         LV2_UI__portMap)
+LSP_LV2_URI(UI__portNotification,                LV2_UI__portNotification)
+LSP_LV2_URI(UI__portSubscribe,                   LV2_UI__portSubscribe)
+LSP_LV2_URI(UI__protocol,                        LV2_UI__protocol)
+LSP_LV2_URI(UI__requestValue,                    LV2_UI__requestValue)
+LSP_LV2_URI(UI__floatProtocol,                   LV2_UI__floatProtocol)
+LSP_LV2_URI(UI__peakProtocol,                    LV2_UI__peakProtocol)
+LSP_LV2_URI(UI__resize,                          LV2_UI__resize)
+LSP_LV2_URI(UI__showInterface,                   LV2_UI__showInterface)
+LSP_LV2_URI(UI__touch,                           LV2_UI__touch)
+LSP_LV2_URI(UI__ui,                              LV2_UI__ui)
+LSP_LV2_URI(UI__updateRate,                      LV2_UI__updateRate)
+LSP_LV2_URI(UI__windowTitle,                     LV2_UI__windowTitle)
+LSP_LV2_URI(UI__scaleFactor,                     LV2_UI__scaleFactor)
+LSP_LV2_URI(UI__foregroundColor,                 LV2_UI__foregroundColor)
+LSP_LV2_URI(UI__backgroundColor,                 LV2_UI__backgroundColor)
+
+// lv2/units/units.h
+LSP_LV2_URI(UNITS_URI,                           LV2_UNITS_URI)
+LSP_LV2_URI(UNITS__Conversion,                   LV2_UNITS__Conversion)
+LSP_LV2_URI(UNITS__Unit,                         LV2_UNITS__Unit)
+LSP_LV2_URI(UNITS__bar,                          LV2_UNITS__bar)
+LSP_LV2_URI(UNITS__beat,                         LV2_UNITS__beat)
+LSP_LV2_URI(UNITS__bpm,                          LV2_UNITS__bpm)
+LSP_LV2_URI(UNITS__cent,                         LV2_UNITS__cent)
+LSP_LV2_URI(UNITS__cm,                           LV2_UNITS__cm)
+LSP_LV2_URI(UNITS__coef,                         LV2_UNITS__coef)
+LSP_LV2_URI(UNITS__conversion,                   LV2_UNITS__conversion)
+LSP_LV2_URI(UNITS__db,                           LV2_UNITS__db)
+LSP_LV2_URI(UNITS__degree,                       LV2_UNITS__degree)
+LSP_LV2_URI(UNITS__frame,                        LV2_UNITS__frame)
+LSP_LV2_URI(UNITS__hz,                           LV2_UNITS__hz)
+LSP_LV2_URI(UNITS__inch,                         LV2_UNITS__inch)
+LSP_LV2_URI(UNITS__khz,                          LV2_UNITS__khz)
+LSP_LV2_URI(UNITS__km,                           LV2_UNITS__km)
+LSP_LV2_URI(UNITS__m,                            LV2_UNITS__m)
+LSP_LV2_URI(UNITS__mhz,                          LV2_UNITS__mhz)
+LSP_LV2_URI(UNITS__midiNote,                     LV2_UNITS__midiNote)
+LSP_LV2_URI(UNITS__mile,                         LV2_UNITS__mile)
+LSP_LV2_URI(UNITS__min,                          LV2_UNITS__min)
+LSP_LV2_URI(UNITS__mm,                           LV2_UNITS__mm)
+LSP_LV2_URI(UNITS__ms,                           LV2_UNITS__ms)
+LSP_LV2_URI(UNITS__name,                         LV2_UNITS__name)
+LSP_LV2_URI(UNITS__oct,                          LV2_UNITS__oct)
+LSP_LV2_URI(UNITS__pc,                           LV2_UNITS__pc)
+LSP_LV2_URI(UNITS__prefixConversion,             LV2_UNITS__prefixConversion)
+LSP_LV2_URI(UNITS__render,                       LV2_UNITS__render)
+LSP_LV2_URI(UNITS__s,                            LV2_UNITS__s)
+LSP_LV2_URI(UNITS__semitone12TET,                LV2_UNITS__semitone12TET)
+LSP_LV2_URI(UNITS__symbol,                       LV2_UNITS__symbol)
+LSP_LV2_URI(UNITS__unit,                         LV2_UNITS__unit)
+
+// lv2/uri-map/uri-map.h
+LSP_LV2_URI(URI_MAP_URI,                         LV2_URI_MAP_URI)
+
+// lv2/urid/urid.h
+LSP_LV2_URI(URID_URI,                            LV2_URID_URI)
+LSP_LV2_URI(URID__map,                           LV2_URID__map)
+LSP_LV2_URI(URID__unmap,                         LV2_URID__unmap)
+
+// lv2/worker/worker.h
+LSP_LV2_URI(WORKER_URI,                          LV2_WORKER_URI)
+LSP_LV2_URI(WORKER__interface,                   LV2_WORKER__interface)
+LSP_LV2_URI(WORKER__schedule,                    LV2_WORKER__schedule)
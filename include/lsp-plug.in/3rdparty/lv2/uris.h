@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_LV2_URIS_H_
+#define LSP_PLUG_IN_3RD_PARTY_LV2_URIS_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+
+#include <lv2/atom/atom.h>
+#include <lv2/buf-size/buf-size.h>
+#include <lv2/core/lv2.h>
+#include <lv2/data-access/data-access.h>
+#include <lv2/dynmanifest/dynmanifest.h>
+#include <lv2/event/event.h>
+#include <lv2/instance-access/instance-access.h>
+#include <lv2/log/log.h>
+#include <lv2/midi/midi.h>
+#include <lv2/morph/morph.h>
+#include <lv2/options/options.h>
+#include <lv2/parameters/parameters.h>
+#include <lv2/patch/patch.h>
+#include <lv2/port-groups/port-groups.h>
+#include <lv2/port-props/port-props.h>
+#include <lv2/presets/presets.h>
+#include <lv2/resize-port/resize-port.h>
+#include <lv2/state/state.h>
+#include <lv2/time/time.h>
+#include <lv2/ui/ui.h>
+#include <lv2/units/units.h>
+#include <lv2/uri-map/uri-map.h>
+#include <lv2/urid/urid.h>
+#include <lv2/worker/worker.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        /**
+         * Identifiers of URIs defined by the vendored LV2 headers: URI_ATOM__Atom
+         * for LV2_ATOM__Atom and so on
+         */
+        enum uri_t
+        {
+        #define LSP_LV2_URI(id, uri)    URI_ ## id,
+        #include <lsp-plug.in/3rdparty/lv2/uri_list.h>
+        #undef LSP_LV2_URI
+
+            URI_COUNT
+        };
+
+        /**
+         * Contiguous storage of all URI strings of the registry
+         */
+        typedef struct uri_strings_t
+        {
+        #define LSP_LV2_URI(id, uri)    char id[sizeof(uri)];
+        #include <lsp-plug.in/3rdparty/lv2/uri_list.h>
+        #undef LSP_LV2_URI
+        } uri_strings_t;
+
+        /**
+         * URIDs of all URIs of the registry indexed by uri_t
+         */
+        typedef struct urid_bundle_t
+        {
+            LV2_URID                urid[URI_COUNT];
+        } urid_bundle_t;
+
+        /**
+         * Strings of the registry
+         */
+        LSP_3RD_PARTY_EXPORT
+        extern const uri_strings_t uri_strings;
+
+        /**
+         * Offsets of the strings in uri_strings indexed by uri_t
+         */
+        LSP_3RD_PARTY_EXPORT
+        extern const uint32_t uri_offsets[URI_COUNT];
+
+        /**
+         * Get URI string of the registry. The returned pointer is recognized by
+         * uri_index(), so the URI can be mapped without hashing.
+         * @param id identifier of URI
+         * @return URI string
+         */
+        inline const char *uri_string(uri_t id)
+        {
+            return reinterpret_cast<const char *>(&uri_strings) + uri_offsets[id];
+        }
+
+        /**
+         * Get identifier of URI by the pointer, does not compare strings
+         * @param uri pointer to URI
+         * @return identifier of URI or negative value if pointer does not point to the registry string
+         */
+        LSP_3RD_PARTY_EXPORT
+        ssize_t uri_index(const char *uri);
+
+        /**
+         * Map list of URIs of the registry in one pass
+         * @param urids array to store count URIDs
+         * @param ids identifiers of URIs
+         * @param count number of URIs
+         * @param map URID map feature
+         * @return status of operation, STATUS_NOT_FOUND if some URIs were not mapped
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t map_uris(LV2_URID *urids, const uri_t *ids, size_t count, const LV2_URID_Map *map);
+
+        /**
+         * Map all URIs of the registry
+         * @param bundle bundle to store URIDs
+         * @param map URID map feature
+         * @return status of operation, STATUS_NOT_FOUND if some URIs were not mapped
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t map_uri_bundle(urid_bundle_t *bundle, const LV2_URID_Map *map);
+
+    } /* namespace lv2 */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_LV2_URIS_H_ */
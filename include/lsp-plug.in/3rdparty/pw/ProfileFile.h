@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_PW_PROFILEFILE_H_
+#define LSP_PLUG_IN_3RD_PARTY_PW_PROFILEFILE_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+
+#include <pw-headers/spa/pod/pod.h>
+
+namespace lsp
+{
+    namespace pw
+    {
+        /**
+         * Capture file of profiler pods. The file is a plain sequence of pods as they were
+         * received by the pw_profiler_events::profile callback, each pod is padded with
+         * zeros to the multiple of 8 bytes. The size of each pod is limited by SPA_POD_MAX_SIZE.
+         * Such files can be recorded on a live system and processed later with ProfileTable
+         * and ProfileStats.
+         */
+        class LSP_3RD_PARTY_EXPORT ProfileFile
+        {
+            private:
+                FILE           *pFD;                // File descriptor
+                bool            bClose;             // Close descriptor on close()
+                uint8_t        *pBuf;               // Buffer to read pods
+                size_t          nBufSize;           // Size of buffer
+
+            public:
+                explicit ProfileFile();
+                ProfileFile(const ProfileFile &) = delete;
+                ProfileFile(ProfileFile &&) = delete;
+                ~ProfileFile();
+
+                ProfileFile & operator = (const ProfileFile &) = delete;
+                ProfileFile & operator = (ProfileFile &&) = delete;
+
+            public:
+                /**
+                 * Open capture file
+                 * @param path path to the file
+                 * @param write open file for writing (the file is truncated) instead of reading
+                 * @return status of operation
+                 */
+                status_t        open(const char *path, bool write = false);
+
+                /**
+                 * Wrap the already opened file
+                 * @param fd file descriptor
+                 * @param close close the descriptor on close()
+                 * @return status of operation
+                 */
+                status_t        wrap(FILE *fd, bool close = false);
+
+                /**
+                 * Close the file
+                 * @return status of operation
+                 */
+                status_t        close();
+
+                /**
+                 * Write pod to the file
+                 * @param pod pod to write
+                 * @return status of operation
+                 */
+                status_t        write(const struct spa_pod *pod);
+
+                /**
+                 * Read next pod from the file. The pod remains valid until the next call
+                 * or until the file is closed.
+                 * @param pod pointer to store the pointer to the pod
+                 * @return status of operation, STATUS_EOF if there are no more pods,
+                 *   STATUS_CORRUPTED if the file is truncated or contains invalid data
+                 */
+                status_t        read(const struct spa_pod **pod);
+        };
+
+    } /* namespace pw */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_PW_PROFILEFILE_H_ */
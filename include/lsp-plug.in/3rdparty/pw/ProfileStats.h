@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_PW_PROFILESTATS_H_
+#define LSP_PLUG_IN_3RD_PARTY_PW_PROFILESTATS_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+
+#include <lsp-plug.in/3rdparty/pw/ProfileTable.h>
+
+namespace lsp
+{
+    namespace pw
+    {
+        /**
+         * Aggregated statistics of the node, all times are in nanoseconds
+         */
+        typedef struct profile_stats_t
+        {
+            uint32_t        id;                 // Node identifier
+            const char     *name;               // Node name
+            bool            driver;             // The node acted as a driver at least once
+            uint64_t        cycles;             // Number of cycles the node participated in
+            uint64_t        incomplete;         // Number of cycles the node did not finish processing
+            uint64_t        overruns;           // Number of cycles the node did not finish before the end of quantum
+            uint64_t        xruns;              // Number of xruns attributed to the node
+            int64_t         wakeup_p50;         // Median of the signal-to-awake latency
+            int64_t         wakeup_p99;         // 99th percentile of the signal-to-awake latency
+            int64_t         wakeup_max;         // Maximum signal-to-awake latency
+            int64_t         process_p50;        // Median of the awake-to-finish latency
+            int64_t         process_p99;        // 99th percentile of the awake-to-finish latency
+            int64_t         process_max;        // Maximum awake-to-finish latency
+        } profile_stats_t;
+
+        /**
+         * Per-node statistics accumulated from the contents of ProfileTable. Latencies are
+         * collected into log-linear histograms with 32 sub-buckets per octave, so the memory
+         * usage does not depend on the length of the capture and percentiles are estimated
+         * with the relative error not greater than 1/32. Maximum values are exact.
+         */
+        class LSP_3RD_PARTY_EXPORT ProfileStats
+        {
+            public:
+                static constexpr size_t HIST_LINEAR     = 64;       // Number of buckets with exact values
+                static constexpr size_t HIST_SUBBITS    = 5;        // Number of bits for sub-buckets of the octave
+                static constexpr size_t HIST_OCTAVES    = 34;       // Number of octaves after the linear range
+                static constexpr size_t HIST_BUCKETS    = HIST_LINEAR + (HIST_OCTAVES << HIST_SUBBITS);
+
+            private:
+                typedef struct node_t
+                {
+                    uint32_t        id;
+                    bool            driver;
+                    char           *name;
+                    uint64_t        cycles;
+                    uint64_t        incomplete;
+                    uint64_t        overruns;
+                    uint64_t        xruns;
+                    uint64_t        samples;
+                    int64_t         wakeup_max;
+                    int64_t         process_max;
+                    uint32_t        wakeup[HIST_BUCKETS];
+                    uint32_t        process[HIST_BUCKETS];
+                } node_t;
+
+            private:
+                node_t        **vNodes;             // Nodes in order of the ProfileTable dictionary
+                size_t          nNodes;             // Number of nodes
+
+            protected:
+                status_t        sync_nodes(const ProfileTable *table);
+                static int64_t  percentile(const uint32_t *hist, uint64_t samples, int64_t max, double p);
+
+            public:
+                static size_t   bucket(int64_t value);
+                static int64_t  bucket_limit(size_t bucket);
+
+            public:
+                explicit ProfileStats();
+                ProfileStats(const ProfileStats &) = delete;
+                ProfileStats(ProfileStats &&) = delete;
+                ~ProfileStats();
+
+                ProfileStats & operator = (const ProfileStats &) = delete;
+                ProfileStats & operator = (ProfileStats &&) = delete;
+
+            public:
+                /**
+                 * Accumulate all rows of the table. Node indices of the statistics match
+                 * node indices of the table dictionary, so the same table should be passed
+                 * to all calls until the table and the statistics are reset.
+                 *
+                 * @param table table to process
+                 * @return status of operation
+                 */
+                status_t        update(const ProfileTable *table);
+
+                /**
+                 * Append the profiler pod to the table. If the table is full, its rows are
+                 * accumulated and removed before appending the pod. This allows to process
+                 * the capture of any length with the memory bounded by table capacity.
+                 * After the last pod is appended, the update() should be called to accumulate
+                 * the remaining rows.
+                 *
+                 * @param table table to append pod
+                 * @param pod profiler pod
+                 * @return status of operation
+                 */
+                status_t        append(ProfileTable *table, const struct spa_pod *pod);
+
+                /**
+                 * Get number of nodes
+                 * @return number of nodes
+                 */
+                inline size_t   size() const        { return nNodes; }
+
+                /**
+                 * Get statistics of the node
+                 * @param index index of the node
+                 * @param dst statistics to fill
+                 * @return status of operation
+                 */
+                status_t        get(size_t index, profile_stats_t *dst) const;
+
+                /**
+                 * Reset all statistics and free allocated memory
+                 */
+                void            reset();
+        };
+
+    } /* namespace pw */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_PW_PROFILESTATS_H_ */
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_PW_PROFILETABLE_H_
+#define LSP_PLUG_IN_3RD_PARTY_PW_PROFILETABLE_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+
+#include <pw-headers/spa/pod/pod.h>
+
+namespace lsp
+{
+    namespace pw
+    {
+        /**
+         * Columnar table of node timings decoded from the pods emitted by the
+         * pw_profiler_events::profile event. Each row describes one node (driver or
+         * follower) in one cycle of the driver. The table has fixed capacity: when
+         * it is full, the rows should be consumed (for example, by ProfileStats) and
+         * the table cleared. The dictionary of nodes and the state needed to detect
+         * xruns are kept between clears, so the capture of any length can be processed
+         * with bounded memory.
+         *
+         * For each cycle where the xrun counter of the driver has been increased, the
+         * xrun is attributed to the nodes whose own xrun counters have been increased.
+         * If there are no such nodes, the xrun is attributed to the nodes that did not
+         * finish processing before the end of the quantum. If there are no such nodes
+         * too, the xrun is attributed to the node that finished last.
+         */
+        class LSP_3RD_PARTY_EXPORT ProfileTable
+        {
+            public:
+                enum row_flags_t
+                {
+                    F_DRIVER        = 1 << 0,       // The node is the driver of the cycle
+                    F_ASYNC         = 1 << 1,       // The node is scheduled asynchronously
+                    F_FINISHED      = 1 << 2,       // The node has finished processing
+                    F_OVERRUN       = 1 << 3,       // The node did not finish before the end of the quantum
+                    F_XRUN          = 1 << 4,       // An xrun happened in the cycle
+                    F_BLAMED        = 1 << 5,       // The xrun is attributed to the node
+                };
+
+            private:
+                typedef struct node_t
+                {
+                    uint32_t        id;             // Node identifier
+                    uint32_t        xruns;          // Last value of the xrun counter of the node
+                    uint32_t        info_xruns;     // Last value of the xrun counter of the driver graph
+                    bool            seen;           // The xrun counter of the node has been initialized
+                    bool            info_seen;      // The xrun counter of the driver graph has been initialized
+                    char           *name;           // Node name
+                } node_t;
+
+            private:
+                size_t          nRows;              // Number of rows
+                size_t          nCapacity;          // Capacity of the table
+                uint64_t       *vCycle;             // Cycle counter of the driver
+                uint32_t       *vDriver;            // Index of the driver node
+                uint32_t       *vNode;              // Index of the node
+                int64_t        *vSignal;            // Time when the node has been signalled, ns
+                int64_t        *vAwake;             // Time when the node has woken up, ns
+                int64_t        *vFinish;            // Time when the node has finished processing, ns
+                int64_t        *vQuantum;           // Duration of the quantum, ns
+                uint32_t       *vStatus;            // Activation status of the node
+                uint32_t       *vFlags;             // Row flags
+                uint8_t        *pData;              // Allocated data for columns
+
+                node_t         *vNodes;             // Dictionary of nodes
+                size_t          nNodes;             // Number of nodes
+                size_t          nNodeCap;           // Capacity of the node dictionary
+                uint32_t       *vBins;              // Hash bins of dictionary containing node index + 1
+                size_t          nBins;              // Number of hash bins, power of 2
+
+            protected:
+                ssize_t         find_node(uint32_t id) const;
+                ssize_t         add_node(uint32_t id, const char *name);
+                status_t        rehash(size_t bins);
+                status_t        count_rows(const struct spa_pod *pod, size_t *rows) const;
+                status_t        decode_object(const struct spa_pod *pod);
+
+            public:
+                explicit ProfileTable();
+                ProfileTable(const ProfileTable &) = delete;
+                ProfileTable(ProfileTable &&) = delete;
+                ~ProfileTable();
+
+                ProfileTable & operator = (const ProfileTable &) = delete;
+                ProfileTable & operator = (ProfileTable &&) = delete;
+
+                /**
+                 * Initialize table
+                 * @param capacity maximum number of rows
+                 * @return status of operation
+                 */
+                status_t        init(size_t capacity = 0x1000);
+
+                /**
+                 * Destroy table and free all allocated memory
+                 */
+                void            destroy();
+
+            public:
+                /**
+                 * Decode the profiler pod and append rows to the table. The pod may be either
+                 * a struct of SPA_TYPE_OBJECT_Profiler objects as emitted by the profiler module
+                 * or a single object. Rows of all cycles contained in the pod are appended at
+                 * once or not appended at all.
+                 *
+                 * @param pod profiler pod
+                 * @return STATUS_OK on success, STATUS_OVERFLOW if there is not enough space
+                 *   in the table (the table should be consumed and cleared, then the call
+                 *   repeated), STATUS_TOO_BIG if the pod does not fit into the empty table,
+                 *   STATUS_BAD_FORMAT if the pod is not a valid profiler pod
+                 */
+                status_t        append(const struct spa_pod *pod);
+
+                /**
+                 * Remove all rows but keep the dictionary of nodes and xrun counters
+                 */
+                void            clear();
+
+                /**
+                 * Remove all rows, nodes and xrun counters
+                 */
+                void            reset();
+
+            public:
+                inline size_t           size() const                    { return nRows;         }
+                inline size_t           capacity() const                { return nCapacity;     }
+                inline bool             full() const                    { return nRows >= nCapacity; }
+
+                inline const uint64_t  *cycle() const                   { return vCycle;        }
+                inline const uint32_t  *driver() const                  { return vDriver;       }
+                inline const uint32_t  *node() const                    { return vNode;         }
+                inline const int64_t   *signal() const                  { return vSignal;       }
+                inline const int64_t   *awake() const                   { return vAwake;        }
+                inline const int64_t   *finish() const                  { return vFinish;       }
+                inline const int64_t   *quantum() const                 { return vQuantum;      }
+                inline const uint32_t  *status() const                  { return vStatus;       }
+                inline const uint32_t  *flags() const                   { return vFlags;        }
+
+                /**
+                 * Get number of nodes in the dictionary. Node indices referenced by the
+                 * rows are stable until reset() is called.
+                 * @return number of nodes
+                 */
+                inline size_t           nodes() const                   { return nNodes;        }
+
+                /**
+                 * Get identifier of the node
+                 * @param index index of the node
+                 * @return node identifier
+                 */
+                inline uint32_t         node_id(size_t index) const     { return (index < nNodes) ? vNodes[index].id : 0; }
+
+                /**
+                 * Get name of the node
+                 * @param index index of the node
+                 * @return node name or NULL if index is out of range
+                 */
+                inline const char      *node_name(size_t index) const   { return (index < nNodes) ? vNodes[index].name : NULL; }
+        };
+
+    } /* namespace pw */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_PW_PROFILETABLE_H_ */
@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_PW_SLOTMAP_H_
+#define LSP_PLUG_IN_3RD_PARTY_PW_SLOTMAP_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+
+namespace lsp
+{
+    namespace pw
+    {
+        /**
+         * Identifier of the item in the SlotMap: the index of the slot in lower 32 bits
+         * and the generation of the slot in upper 32 bits
+         */
+        typedef uint64_t    slot_id_t;
+
+        static constexpr slot_id_t SLOT_ID_INVALID      = ~slot_id_t(0);
+
+        /**
+         * Map of objects with generation-checked identifiers, an alternative to pw_map.
+         *
+         * Each slot has 32-bit generation counter which is incremented both on insertion
+         * and removal, so the identifier of the removed item never matches the item which
+         * later reuses the same slot. The slot whose counter is exhausted is retired and
+         * never reused.
+         *
+         * Slots are allocated in chunks which are never relocated, so the growth of the map
+         * does not move existing items and pointers returned by lookup_ptr() remain valid
+         * until the item is removed. Pointers to items are also kept in the dense array to
+         * walk over the map without skipping free slots.
+         *
+         * Insertion, lookup and removal take O(1) time.
+         */
+        class LSP_3RD_PARTY_EXPORT SlotMap
+        {
+            public:
+                static constexpr size_t CHUNK_SHIFT     = 8;
+                static constexpr size_t CHUNK_SIZE      = 1 << CHUNK_SHIFT;
+                static constexpr size_t CHUNK_MASK      = CHUNK_SIZE - 1;
+
+            private:
+                typedef struct slot_t
+                {
+                    void           *data;           // Item data
+                    uint32_t        generation;     // Generation, odd for occupied slots
+                    uint32_t        link;           // Index in the dense array or next free slot
+                } slot_t;
+
+            private:
+                slot_t        **vChunks;            // Chunks of slots
+                size_t          nChunks;            // Number of allocated chunks
+                size_t          nChunkCap;          // Capacity of the chunk array
+                size_t          nSlots;             // Number of used slots (occupied, free and retired)
+                uint32_t        nFree;              // First free slot
+                void          **vDense;             // Dense array of item data
+                uint32_t       *vDenseSlot;         // Slot index for each item of the dense array
+                size_t          nItems;             // Number of items
+                size_t          nDenseCap;          // Capacity of the dense array
+
+            protected:
+                inline slot_t  *slot(size_t index) const
+                {
+                    return &vChunks[index >> CHUNK_SHIFT][index & CHUNK_MASK];
+                }
+                inline slot_t  *find(slot_id_t id) const
+                {
+                    const size_t index  = index_of(id);
+                    if (index >= nSlots)
+                        return NULL;
+                    slot_t *s           = slot(index);
+                    return ((s->generation == generation_of(id)) && (s->generation & 1)) ? s : NULL;
+                }
+                status_t        grow_slots();
+                status_t        grow_dense();
+
+            public:
+                static inline uint32_t  index_of(slot_id_t id)          { return uint32_t(id);          }
+                static inline uint32_t  generation_of(slot_id_t id)     { return uint32_t(id >> 32);    }
+
+            public:
+                explicit SlotMap();
+                SlotMap(const SlotMap &) = delete;
+                SlotMap(SlotMap &&) = delete;
+                ~SlotMap();
+
+                SlotMap & operator = (const SlotMap &) = delete;
+                SlotMap & operator = (SlotMap &&) = delete;
+
+            public:
+                /**
+                 * Reserve space for the specified number of items
+                 * @param count number of items
+                 * @return status of operation
+                 */
+                status_t        reserve(size_t count);
+
+                /**
+                 * Insert new item
+                 * @param data item data
+                 * @param id pointer to store the identifier of the item
+                 * @return status of operation
+                 */
+                status_t        insert(void *data, slot_id_t *id);
+
+                /**
+                 * Remove item
+                 * @param id identifier of the item
+                 * @param data pointer to store data of the removed item, may be NULL
+                 * @return STATUS_OK on success, STATUS_NOT_FOUND if there is no such item
+                 */
+                status_t        remove(slot_id_t id, void **data = NULL);
+
+                /**
+                 * Replace data of the item
+                 * @param id identifier of the item
+                 * @param data new item data
+                 * @return STATUS_OK on success, STATUS_NOT_FOUND if there is no such item
+                 */
+                status_t        replace(slot_id_t id, void *data);
+
+                /**
+                 * Get item data
+                 * @param id identifier of the item
+                 * @return item data or NULL if there is no such item
+                 */
+                inline void    *lookup(slot_id_t id) const
+                {
+                    const slot_t *s = find(id);
+                    return (s != NULL) ? s->data : NULL;
+                }
+
+                /**
+                 * Get pointer to the item data stored in the slot. The pointer remains
+                 * valid until the item is removed, even if the map grows.
+                 * @param id identifier of the item
+                 * @return pointer to the item data or NULL if there is no such item
+                 */
+                inline void   **lookup_ptr(slot_id_t id) const
+                {
+                    slot_t *s = find(id);
+                    return (s != NULL) ? &s->data : NULL;
+                }
+
+                /**
+                 * Check that map contains the item
+                 * @param id identifier of the item
+                 * @return true if map contains the item
+                 */
+                inline bool     contains(slot_id_t id) const            { return find(id) != NULL; }
+
+                /**
+                 * Get number of items
+                 * @return number of items
+                 */
+                inline size_t   size() const                            { return nItems; }
+
+                /**
+                 * Get dense array of item data, the order of items changes on removal
+                 * @return dense array of item data of size() elements
+                 */
+                inline void * const *items() const                      { return vDense; }
+
+                /**
+                 * Get identifier of the item in the dense array
+                 * @param index index of the item in the dense array
+                 * @return identifier of the item
+                 */
+                slot_id_t       item_id(size_t index) const;
+
+                /**
+                 * Call the function for each item, like pw_map_for_each(). Items are visited
+                 * from the end of the dense array, so the function may remove the current item
+                 * but should not remove other items.
+                 * @param func function to call, non-zero return value stops the iteration
+                 * @param data argument to pass to the function
+                 * @return the last value returned by the function
+                 */
+                inline int      for_each(int (*func)(void *item_data, void *data), void *data) const
+                {
+                    int res = 0;
+                    for (size_t i=nItems; i > 0; )
+                    {
+                        --i;
+                        if ((res = func(vDense[i], data)) != 0)
+                            break;
+                    }
+                    return res;
+                }
+
+                /**
+                 * Remove all items but keep allocated memory. Generations of slots are kept,
+                 * so identifiers of removed items remain invalid.
+                 */
+                void            clear();
+
+                /**
+                 * Remove all items and free allocated memory. Identifiers of removed
+                 * items may match identifiers of items inserted after this call.
+                 */
+                void            flush();
+        };
+
+    } /* namespace pw */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_PW_SLOTMAP_H_ */
@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_PW_SMALLARRAY_H_
+#define LSP_PLUG_IN_3RD_PARTY_PW_SMALLARRAY_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/common/status.h>
+
+namespace lsp
+{
+    namespace pw
+    {
+        /**
+         * Type-agnostic implementation of the SmallArray, operates on items of
+         * nSizeOf bytes that are moved with memcpy()
+         */
+        class LSP_3RD_PARTY_EXPORT RawSmallArray
+        {
+            protected:
+                uint8_t        *pData;          // Current storage: inline or allocated
+                uint8_t        *pInline;        // Inline storage
+                size_t          nItems;         // Number of items
+                size_t          nCapacity;      // Capacity of current storage in items
+                size_t          nInline;        // Capacity of the inline storage in items
+                size_t          nSizeOf;        // Size of the item
+                size_t          nFailures;      // Number of failed growth attempts, may be polled from another thread
+                bool            bFrozen;        // Growth is forbidden
+
+            protected:
+                status_t        grow(size_t capacity);
+                status_t        ensure(size_t count);
+                void           *add_slow(size_t count);
+
+            public:
+                explicit RawSmallArray(void *storage, size_t inline_items, size_t sizeof_item);
+                RawSmallArray(const RawSmallArray &) = delete;
+                RawSmallArray(RawSmallArray &&) = delete;
+                ~RawSmallArray();
+
+                RawSmallArray & operator = (const RawSmallArray &) = delete;
+                RawSmallArray & operator = (RawSmallArray &&) = delete;
+
+            public:
+                inline void    *add(size_t count)
+                {
+                    if (count > nCapacity - nItems)
+                        return add_slow(count);
+                    uint8_t *ptr    = &pData[nItems * nSizeOf];
+                    nItems         += count;
+                    return ptr;
+                }
+                void           *insert(size_t index, size_t count);
+
+                /**
+                 * Remove items, the tail of array is moved to the place of removed items
+                 * @param index index of the first item to remove
+                 * @param count number of items to remove
+                 * @return true if items have been removed, false if range is out of array
+                 */
+                bool            remove(size_t index, size_t count = 1);
+
+                /**
+                 * Ensure that array can hold the specified number of items without allocations
+                 * @param count number of items
+                 * @return status of operation, STATUS_BAD_STATE if the array is frozen and
+                 *   does not have enough capacity
+                 */
+                status_t        reserve(size_t count);
+
+                /**
+                 * Reduce the capacity of heap storage to the number of items, move items
+                 * to the inline storage if they fit
+                 * @return status of operation
+                 */
+                status_t        shrink();
+
+                /**
+                 * Remove all items and free the heap storage
+                 */
+                void            flush();
+
+                /**
+                 * Remove all items but keep the storage
+                 */
+                inline void     clear()                 { nItems    = 0;    }
+
+                /**
+                 * Forbid or allow memory allocations on growth
+                 */
+                inline void     freeze()                { bFrozen   = true; }
+                inline void     unfreeze()              { bFrozen   = false;}
+                inline bool     frozen() const          { return bFrozen;   }
+
+                /**
+                 * Get number of growth attempts that failed because the array is frozen
+                 * or because of memory allocation error
+                 * @return number of failed growth attempts
+                 */
+                inline size_t   failures() const        { return atomic_load(&nFailures); }
+                inline void     reset_failures()        { atomic_store(&nFailures, size_t(0)); }
+
+                inline size_t   size() const            { return nItems;    }
+                inline size_t   capacity() const        { return nCapacity; }
+                inline bool     is_empty() const        { return nItems == 0; }
+                inline bool     is_inline() const       { return pData == pInline; }
+        };
+
+        /**
+         * Companion of pw_array for trivially copyable items with inline storage for first
+         * N items and geometric growth of the heap storage.
+         *
+         * To use the array on the realtime thread, reserve the required capacity and
+         * freeze the array on the non-realtime thread. Any further attempt to grow the
+         * frozen array fails without allocating memory, and the number of such attempts
+         * is counted to be reported by the non-realtime thread. Note that flush() and
+         * shrink() release memory and should not be called on the realtime thread.
+         *
+         * @tparam T type of items, should be trivially copyable
+         * @tparam N number of items in the inline storage
+         */
+        template <class T, size_t N>
+        class SmallArray: public RawSmallArray
+        {
+            private:
+                static_assert(N > 0, "Inline storage should contain at least one item");
+
+                alignas(T) uint8_t  vInline[N * sizeof(T)];
+
+            public:
+                explicit SmallArray(): RawSmallArray(vInline, N, sizeof(T)) {}
+
+            public:
+                /**
+                 * Add uninitialized items to the end of array
+                 * @param count number of items
+                 * @return pointer to the first added item or NULL if the array can not grow
+                 */
+                inline T       *add(size_t count = 1)               { return static_cast<T *>(RawSmallArray::add(count)); }
+
+                /**
+                 * Insert uninitialized items at the specified position
+                 * @param index position of insertion
+                 * @param count number of items
+                 * @return pointer to the first inserted item or NULL on error
+                 */
+                inline T       *insert(size_t index, size_t count = 1)  { return static_cast<T *>(RawSmallArray::insert(index, count)); }
+
+                /**
+                 * Append item to the end of array
+                 * @param item item to append
+                 * @return true on success, false if the array can not grow
+                 */
+                inline bool     push(const T &item)
+                {
+                    T *dst = add(1);
+                    if (dst == NULL)
+                        return false;
+                    *dst = item;
+                    return true;
+                }
+
+                /**
+                 * Remove the last item
+                 * @param item pointer to store the removed item, may be NULL
+                 * @return true if item has been removed, false if array is empty
+                 */
+                inline bool     pop(T *item = NULL)
+                {
+                    if (nItems <= 0)
+                        return false;
+                    --nItems;
+                    if (item != NULL)
+                        *item = reinterpret_cast<T *>(pData)[nItems];
+                    return true;
+                }
+
+                inline T       *get(size_t index)                   { return (index < nItems) ? &array()[index] : NULL; }
+                inline const T *get(size_t index) const             { return (index < nItems) ? &array()[index] : NULL; }
+                inline T       *uget(size_t index)                  { return &array()[index]; }
+                inline const T *uget(size_t index) const            { return &array()[index]; }
+                inline T       *array()                             { return reinterpret_cast<T *>(pData); }
+                inline const T *array() const                       { return reinterpret_cast<const T *>(pData); }
+                inline T       *first()                             { return get(0); }
+                inline T       *last()                              { return (nItems > 0) ? &array()[nItems - 1] : NULL; }
+        };
+
+    } /* namespace pw */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_PW_SMALLARRAY_H_ */
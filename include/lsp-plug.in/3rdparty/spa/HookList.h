@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_SPA_HOOKLIST_H_
+#define LSP_PLUG_IN_3RD_PARTY_SPA_HOOKLIST_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+
+#include <pw-headers/spa/utils/hook.h>
+
+namespace lsp
+{
+    namespace spa
+    {
+        /**
+         * Hook list with flattened listener snapshot. Listeners are stored both in the
+         * spa_hook_list and in the contiguous array of callbacks which is rebuilt only
+         * when the list of hooks changes, so emission of the event does not walk the
+         * linked list and does not need cursor bookkeeping.
+         *
+         * Hooks should be added with append() and prepend() methods and may be removed
+         * with spa_hook_remove() at any time, including the emission of the event.
+         * The removed listener is not called anymore, the listener added during the
+         * emission is called starting with the next emission. Nested emissions are
+         * allowed. The list is not thread-safe, like spa_hook_list.
+         */
+        class LSP_3RD_PARTY_EXPORT HookList
+        {
+            private:
+                typedef struct listener_t
+                {
+                    const void             *funcs;      // Callbacks, NULL for removed listener
+                    void                   *data;       // Callback data
+                    struct spa_hook        *hook;       // Hook of the listener
+                } listener_t;
+
+            private:
+                struct spa_hook_list    sList;          // List of hooks
+                listener_t             *vItems;         // Snapshot of listeners
+                size_t                  nItems;         // Number of listeners in snapshot
+                size_t                  nCapacity;      // Capacity of the snapshot
+                size_t                  nHooks;         // Number of hooks in the list
+                size_t                  nDepth;         // Emission nesting depth
+                bool                    bDirty;         // Snapshot should be rebuilt
+
+            protected:
+                static void             hook_removed(struct spa_hook *hook);
+
+            protected:
+                status_t                add(struct spa_hook *hook, const void *funcs, void *data, bool prepend);
+                void                    removed(struct spa_hook *hook);
+                void                    rebuild();
+
+                inline void             begin_emit()    { ++nDepth; }
+                inline void             end_emit()
+                {
+                    if ((--nDepth == 0) && (bDirty))
+                        rebuild();
+                }
+
+            public:
+                explicit HookList();
+                HookList(const HookList &) = delete;
+                HookList(HookList &&) = delete;
+                ~HookList();
+
+                HookList & operator = (const HookList &) = delete;
+                HookList & operator = (HookList &&) = delete;
+
+            public:
+                /**
+                 * Append hook to the end of the list
+                 * @param hook hook to append
+                 * @param funcs callbacks, structure with version field
+                 * @param data data passed to callbacks
+                 * @return status of operation
+                 */
+                inline status_t         append(struct spa_hook *hook, const void *funcs, void *data)
+                {
+                    return add(hook, funcs, data, false);
+                }
+
+                /**
+                 * Prepend hook to the beginning of the list
+                 * @param hook hook to prepend
+                 * @param funcs callbacks, structure with version field
+                 * @param data data passed to callbacks
+                 * @return status of operation
+                 */
+                inline status_t         prepend(struct spa_hook *hook, const void *funcs, void *data)
+                {
+                    return add(hook, funcs, data, true);
+                }
+
+                /**
+                 * Remove all hooks from the list
+                 */
+                void                    clean();
+
+                /**
+                 * Get number of hooks in the list
+                 * @return number of hooks in the list
+                 */
+                inline size_t           size() const        { return nHooks; }
+
+                /**
+                 * Check that list is empty
+                 * @return true if list is empty
+                 */
+                inline bool             is_empty() const    { return nHooks == 0; }
+
+                /**
+                 * Get underlying hook list, should not be modified directly
+                 * @return underlying hook list
+                 */
+                inline struct spa_hook_list *list()         { return &sList; }
+
+            public:
+                /**
+                 * Call the method of each listener which supports it, equivalent of spa_hook_list_call()
+                 * @param method pointer to the method in the callback structure
+                 * @param version minimum version of the callback structure
+                 * @param args arguments passed to the method after data
+                 * @return number of called methods
+                 */
+                template <class T, class... A, class... P>
+                inline size_t           call(void (*T::*method)(void *, A...), uint32_t version, P... args)
+                {
+                    size_t count        = 0;
+                    const size_t n      = nItems;
+
+                    begin_emit();
+                    for (size_t i=0; i<n; ++i)
+                    {
+                        // The snapshot may be reallocated by the listener, copy the fields
+                        const T *f          = static_cast<const T *>(vItems[i].funcs);
+                        void *data          = vItems[i].data;
+                        if ((f == NULL) || ((version > 0) && (f->version < version)) || (f->*method == NULL))
+                            continue;
+
+                        (f->*method)(data, args...);
+                        ++count;
+                    }
+                    end_emit();
+
+                    return count;
+                }
+
+                /**
+                 * Call the method of the first listener which supports it, equivalent of spa_hook_list_call_once()
+                 * @param method pointer to the method in the callback structure
+                 * @param version minimum version of the callback structure
+                 * @param args arguments passed to the method after data
+                 * @return number of called methods, 0 or 1
+                 */
+                template <class T, class... A, class... P>
+                inline size_t           call_once(void (*T::*method)(void *, A...), uint32_t version, P... args)
+                {
+                    const size_t n      = nItems;
+                    for (size_t i=0; i<n; ++i)
+                    {
+                        const T *f          = static_cast<const T *>(vItems[i].funcs);
+                        if ((f == NULL) || ((version > 0) && (f->version < version)) || (f->*method == NULL))
+                            continue;
+
+                        begin_emit();
+                        (f->*method)(vItems[i].data, args...);
+                        end_emit();
+                        return 1;
+                    }
+
+                    return 0;
+                }
+        };
+
+    } /* namespace spa */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_SPA_HOOKLIST_H_ */
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_SPA_JSONPODPARSER_H_
+#define LSP_PLUG_IN_3RD_PARTY_SPA_JSONPODPARSER_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+
+#include <pw-headers/spa/pod/builder.h>
+#include <pw-headers/spa/utils/type.h>
+
+namespace lsp
+{
+    namespace spa
+    {
+        /**
+         * Incremental JSON to POD converter. Accepts the JSON text in chunks of arbitrary size
+         * and emits the POD values into the builder as soon as the tokens are complete, so
+         * the whole document never needs to be kept in memory. The conversion rules and the
+         * accepted relaxed JSON syntax are the same as for spa_json_to_pod(), the output
+         * is binary identical. As in the bundled spa_json, commas are treated as whitespace,
+         * while ':' and '=' separators are accepted only between the object key and its value
+         * (any number of them), a separator at any other place is the syntax error.
+         *
+         * The nesting depth is bounded by the value passed to init(), all memory is allocated
+         * by init() and no allocations are performed while parsing.
+         */
+        class LSP_3RD_PARTY_EXPORT JsonPodParser
+        {
+            public:
+                static constexpr size_t DEFAULT_DEPTH       = 128;
+                static constexpr size_t MAX_TOKEN_LENGTH    = 8192;
+                static constexpr size_t MAX_KEY_LENGTH      = 256;
+
+            private:
+                enum lexer_t
+                {
+                    LEX_NONE,
+                    LEX_STRING,
+                    LEX_ESCAPE,
+                    LEX_UTF8,
+                    LEX_BARE,
+                    LEX_COMMENT,
+                    LEX_DONE
+                };
+
+                enum frame_type_t
+                {
+                    FRAME_ROOT,
+                    FRAME_OBJECT,
+                    FRAME_ARRAY
+                };
+
+                typedef struct frame_t
+                {
+                    struct spa_pod_frame        pod;        // Builder frame
+                    const struct spa_type_info *info;       // Type information for array elements
+                    const struct spa_type_info *values;     // Type information for object properties
+                    const struct spa_type_info *prop;       // Type information of the pending property value
+                    uint8_t                     type;       // Type of frame
+                    bool                        pushed;     // Builder frame has been pushed
+                    bool                        skip;       // Skip contents of the frame
+                    bool                        skip_value; // Skip the pending property value
+                    bool                        key;        // Object expects the property key
+                    bool                        sep;        // Key-value separators are allowed
+                } frame_t;
+
+            private:
+                struct spa_pod_builder     *pBuilder;       // POD builder
+                const struct spa_type_info *pInfo;          // Type information of the root value
+                uint32_t                    nId;            // Identifier of objects
+                uint32_t                    nStart;         // Offset of the root value in the builder
+                status_t                    nError;         // Sticky error code
+
+                frame_t                    *vFrames;        // Stack of frames
+                size_t                      nDepth;         // Current depth
+                size_t                      nMaxDepth;      // Maximum depth
+
+                lexer_t                     nLexer;         // Lexer state
+                size_t                      nUtf8;          // Number of pending UTF-8 continuation bytes
+                char                       *vToken;         // Buffer for the token split between chunks
+                size_t                      nTokLength;     // Length of the token
+                bool                        bTokBuffered;   // Token is being accumulated in the buffer
+                char                       *vValue;         // Buffer for unescaped strings
+
+                wsize_t                     nOffset;        // Offset of the current chunk in the input
+                wsize_t                     nLine;          // Current line number
+                wsize_t                     nLineStart;     // Offset of the current line start
+
+            protected:
+                void                        do_destroy();
+                status_t                    fail(status_t code, wsize_t offset);
+                void                        append_token(const char *data, size_t size);
+
+                status_t                    emit_value(const char *tok, size_t len, bool overflow, const struct spa_type_info *info);
+                status_t                    on_key(frame_t *f, const char *tok, size_t len, bool overflow);
+                status_t                    on_token(const char *tok, size_t len, bool overflow);
+                status_t                    on_separator();
+                status_t                    on_open(char c);
+                status_t                    on_close(char c);
+                void                        on_complete();
+
+            public:
+                explicit JsonPodParser();
+                JsonPodParser(const JsonPodParser &) = delete;
+                JsonPodParser(JsonPodParser &&) = delete;
+                ~JsonPodParser();
+
+                JsonPodParser & operator = (const JsonPodParser &) = delete;
+                JsonPodParser & operator = (JsonPodParser &&) = delete;
+
+                /**
+                 * Allocate parser resources
+                 * @param max_depth maximum nesting depth of JSON containers
+                 * @return status of operation
+                 */
+                status_t                    init(size_t max_depth = DEFAULT_DEPTH);
+
+                /**
+                 * Destroy parser and free all allocated resources
+                 */
+                void                        destroy();
+
+            public:
+                /**
+                 * Start conversion of the new document
+                 * @param b POD builder to emit the values to
+                 * @param info type information of the root value, same as for spa_json_to_pod()
+                 * @return status of operation
+                 */
+                status_t                    begin(struct spa_pod_builder *b, const struct spa_type_info *info);
+
+                /**
+                 * Parse the next chunk of the document
+                 * @param data chunk data
+                 * @param size size of the chunk
+                 * @return status of operation, STATUS_OK if more data can be passed, STATUS_BAD_FORMAT
+                 *   on syntax error, STATUS_OVERFLOW if nesting depth has been exceeded or builder has
+                 *   no more space, STATUS_TOO_BIG if string value is too long, STATUS_INVALID_VALUE if
+                 *   the value does not match the type information
+                 */
+                status_t                    parse(const void *data, size_t size);
+
+                /**
+                 * Complete conversion of the document
+                 * @param pod pointer to store the pointer to the root value, may be NULL
+                 * @return status of operation, STATUS_NO_DATA if document has no values,
+                 *   STATUS_CORRUPTED if document is incomplete
+                 */
+                status_t                    end(struct spa_pod **pod = NULL);
+
+            public:
+                /**
+                 * Check that the root value has been completely parsed
+                 * @return true if the root value has been completely parsed
+                 */
+                inline bool                 done() const        { return nLexer == LEX_DONE; }
+
+                /**
+                 * Get line number of the last error or current position
+                 * @return line number starting with 1
+                 */
+                inline wsize_t              line() const        { return nLine; }
+
+                /**
+                 * Get column number of the last error or current position
+                 * @return column number starting with 1
+                 */
+                inline wsize_t              column() const      { return nOffset - nLineStart + 1; }
+        };
+
+    } /* namespace spa */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_SPA_JSONPODPARSER_H_ */
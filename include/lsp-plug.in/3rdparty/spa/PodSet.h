@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_SPA_PODSET_H_
+#define LSP_PLUG_IN_3RD_PARTY_SPA_PODSET_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+
+#include <pw-headers/spa/pod/pod.h>
+
+namespace lsp
+{
+    namespace spa
+    {
+        /**
+         * Set of unique POD values. The values are compared with pod_equals() and
+         * indexed with pod_hash(), so each insertion and lookup takes O(1) time on average.
+         * The set stores copies of the inserted values, the pointers to stored values
+         * remain valid until the set is cleared or destroyed. Values are enumerated
+         * in the order of their insertion.
+         */
+        class LSP_3RD_PARTY_EXPORT PodSet
+        {
+            private:
+                typedef struct item_t
+                {
+                    uint64_t                hash;       // Hash of the value
+                    const struct spa_pod   *pod;        // Stored value
+                } item_t;
+
+                typedef struct chunk_t
+                {
+                    chunk_t                *next;       // Next chunk
+                    size_t                  used;       // Number of bytes used
+                    size_t                  size;       // Capacity of the chunk
+                } chunk_t;
+
+            private:
+                item_t                 *vItems;         // Items in order of insertion
+                size_t                  nItems;         // Number of items
+                size_t                  nCapacity;      // Capacity of the items array
+                uint32_t               *vBins;          // Hash bins containing item index + 1, 0 for empty bin
+                size_t                  nBins;          // Number of hash bins, power of 2
+                chunk_t                *pChunks;        // Storage for POD values
+
+            protected:
+                ssize_t                 lookup(uint64_t hash, const struct spa_pod *pod, size_t *bin) const;
+                status_t                rehash(size_t bins);
+                struct spa_pod         *store(const struct spa_pod *pod);
+                void                    release_chunks();
+
+            public:
+                explicit PodSet();
+                PodSet(const PodSet &) = delete;
+                PodSet(PodSet &&) = delete;
+                ~PodSet();
+
+                PodSet & operator = (const PodSet &) = delete;
+                PodSet & operator = (PodSet &&) = delete;
+
+            public:
+                /**
+                 * Reserve space for the specified number of values
+                 * @param count number of values
+                 * @return status of operation
+                 */
+                status_t                reserve(size_t count);
+
+                /**
+                 * Add value to the set if there is no equivalent value
+                 * @param pod POD value to add
+                 * @param stored pointer to store the pointer to the stored or already existing equivalent value, may be NULL
+                 * @return STATUS_OK if value has been added, STATUS_ALREADY_EXISTS if there already is an equivalent
+                 *   value in the set, error code on error
+                 */
+                status_t                insert(const struct spa_pod *pod, const struct spa_pod **stored = NULL);
+
+                /**
+                 * Find the value equivalent to the passed one
+                 * @param pod POD value to search
+                 * @return pointer to the stored equivalent value or NULL if there is no such value
+                 */
+                const struct spa_pod   *find(const struct spa_pod *pod) const;
+
+                /**
+                 * Check that set contains the equivalent value
+                 * @param pod POD value to search
+                 * @return true if set contains the equivalent value
+                 */
+                inline bool             contains(const struct spa_pod *pod) const   { return find(pod) != NULL; }
+
+                /**
+                 * Get stored value by the index of insertion
+                 * @param index index of the value
+                 * @return pointer to the value or NULL if index is out of range
+                 */
+                inline const struct spa_pod *get(size_t index) const    { return (index < nItems) ? vItems[index].pod : NULL; }
+
+                /**
+                 * Get number of unique values in the set
+                 * @return number of unique values
+                 */
+                inline size_t           size() const                    { return nItems; }
+
+                /**
+                 * Remove all values but keep the allocated index memory
+                 */
+                void                    clear();
+
+                /**
+                 * Remove all values and free all allocated memory
+                 */
+                void                    flush();
+        };
+
+    } /* namespace spa */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_SPA_PODSET_H_ */
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_SPA_RATELIMITER_H_
+#define LSP_PLUG_IN_3RD_PARTY_SPA_RATELIMITER_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/common/status.h>
+
+namespace lsp
+{
+    namespace spa
+    {
+        /**
+         * Keyed rate limiter, applies the spa_ratelimit policy to each source independently.
+         * Each source identified by the 64-bit key gets its own bucket in the fixed hash table
+         * allocated at initialization, the bucket allows up to burst events per interval.
+         * The test() method is lock-free, does not allocate memory and may be called from
+         * any thread including data threads. When the table is full, sources without
+         * bucket share the overflow bucket. Buckets which stay idle for several intervals
+         * are reused by new sources.
+         */
+        class LSP_3RD_PARTY_EXPORT RateLimiter
+        {
+            private:
+                typedef struct bucket_t
+                {
+                    uint64_t                key;            // Hashed key of the source, 0 for empty bucket
+                    uint64_t                state;          // Window start, number of passed and suppressed events
+                } bucket_t;
+
+            public:
+                static constexpr size_t     MAX_PROBE       = 8;        // Maximum number of probed buckets
+                static constexpr size_t     WINDOW_TICKS    = 1024;     // Minimum resolution of the interval
+                static constexpr size_t     IDLE_WINDOWS    = 4;        // Number of idle intervals to reuse bucket
+                static constexpr uint32_t   MAX_COUNT       = 0xffff;   // Maximum burst and suppressed counter
+
+            private:
+                bucket_t               *vBuckets;       // Buckets, the last one is overflow bucket
+                size_t                  nMask;          // Mask of the bucket index
+                size_t                  nShift;         // Shift of time to ticks
+                uint32_t                nWindow;        // Interval in ticks
+                uint32_t                nBurst;         // Number of events passed per interval
+                uint64_t                nSuppressed;    // Total number of suppressed events
+                uint8_t                *pData;          // Allocated data
+
+            protected:
+                bucket_t               *find(uint64_t hash, uint32_t stamp);
+
+            public:
+                explicit RateLimiter();
+                RateLimiter(const RateLimiter &) = delete;
+                RateLimiter(RateLimiter &&) = delete;
+                ~RateLimiter();
+
+                RateLimiter & operator = (const RateLimiter &) = delete;
+                RateLimiter & operator = (RateLimiter &&) = delete;
+
+            public:
+                /**
+                 * Initialize rate limiter
+                 * @param sources maximum number of sources, rounded up to power of 2
+                 * @param interval interval in units of time passed to test(), for example nanoseconds
+                 * @param burst number of events passed per interval, up to MAX_COUNT
+                 * @return status of operation
+                 */
+                status_t                init(size_t sources, uint64_t interval, uint32_t burst);
+
+                /**
+                 * Destroy rate limiter and free allocated memory
+                 */
+                void                    destroy();
+
+                /**
+                 * Forget all sources and reset counters, should not be called concurrently with test()
+                 */
+                void                    reset();
+
+                /**
+                 * Test the event of the source, equivalent of spa_ratelimit_test()
+                 * @param key identifier of the source
+                 * @param now current time
+                 * @return negative value if event should be suppressed, otherwise number of events
+                 *   suppressed since the previous passed event of the source
+                 */
+                int                     test(uint64_t key, uint64_t now);
+
+                /**
+                 * Get total number of suppressed events
+                 * @return total number of suppressed events
+                 */
+                inline uint64_t         suppressed() const  { return atomic_load(&nSuppressed); }
+
+                /**
+                 * Get number of sources which have own bucket
+                 * @return number of sources which have own bucket
+                 */
+                size_t                  sources() const;
+        };
+
+    } /* namespace spa */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_SPA_RATELIMITER_H_ */
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_SPA_REMIXER_H_
+#define LSP_PLUG_IN_3RD_PARTY_SPA_REMIXER_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+
+#include <pw-headers/spa/param/audio/layout.h>
+
+namespace lsp
+{
+    namespace spa
+    {
+        /**
+         * Channel remixer between two channel layouts described by SPA_AUDIO_CHANNEL positions.
+         *
+         * Channels present in both layouts are passed as is, including the AUX channels.
+         * Channels with unknown position are matched by index. Missing source channels are
+         * folded into the destination channels following the ITU-R BS.775 downmix rules:
+         * center and surround channels are mixed into front channels at -3 dB, rear and side
+         * channels substitute each other, height channels are folded into the ear level at -3 dB.
+         * LFE is dropped unless F_MIX_LFE flag is set.
+         *
+         * The coefficient matrix is compiled into the list of operations: each destination
+         * channel is computed by specialized kernels that mix up to four non-zero terms
+         * at a time, so the cost of processing depends only on the number of non-zero coefficients.
+         */
+        class LSP_3RD_PARTY_EXPORT Remixer
+        {
+            public:
+                enum flags_t
+                {
+                    F_MIX_LFE       = 1 << 0,       // Mix LFE into front channels when there is no LFE in the destination
+                    F_UPMIX         = 1 << 1,       // Derive destination channels that have no source from other source channels
+                    F_NORMALIZE     = 1 << 2,       // Scale the matrix so the sum of coefficients of any row does not exceed 1
+                };
+
+            private:
+                static constexpr size_t MAX_TERMS       = 4;
+
+                typedef void (* mix_t)(float *dst, const float * const *src, const float *k, size_t count);
+
+                typedef struct op_t
+                {
+                    mix_t           mix;                // Mixing kernel
+                    uint32_t        dst;                // Destination channel
+                    uint32_t        terms;              // Number of terms
+                    uint32_t        src[MAX_TERMS];     // Source channels
+                    float           k[MAX_TERMS];       // Coefficients
+                } op_t;
+
+            private:
+                float          *vMatrix;                // Coefficient matrix, nDst rows of nSrc coefficients
+                op_t           *vOps;                   // Compiled operations
+                size_t          nOps;                   // Number of compiled operations
+                size_t          nDst;                   // Number of destination channels
+                size_t          nSrc;                   // Number of source channels
+
+            protected:
+                status_t        allocate(size_t dst_channels, size_t src_channels);
+                void            compile();
+
+            public:
+                explicit Remixer();
+                Remixer(const Remixer &) = delete;
+                Remixer(Remixer &&) = delete;
+                ~Remixer();
+
+                Remixer & operator = (const Remixer &) = delete;
+                Remixer & operator = (Remixer &&) = delete;
+
+            public:
+                /**
+                 * Build the remix matrix for channel positions
+                 * @param dst destination channel positions, enum spa_audio_channel
+                 * @param dst_channels number of destination channels
+                 * @param src source channel positions, enum spa_audio_channel
+                 * @param src_channels number of source channels
+                 * @param flags remix flags
+                 * @return status of operation
+                 */
+                status_t        init(const uint32_t *dst, size_t dst_channels, const uint32_t *src, size_t src_channels, size_t flags = 0);
+
+                /**
+                 * Build the remix matrix for channel layouts
+                 * @param dst destination layout
+                 * @param src source layout
+                 * @param flags remix flags
+                 * @return status of operation
+                 */
+                status_t        init(const struct spa_audio_layout_info *dst, const struct spa_audio_layout_info *src, size_t flags = 0);
+
+                /**
+                 * Replace the remix matrix with custom coefficients, the number of channels is kept
+                 * @param matrix dst_channels() rows of src_channels() coefficients
+                 * @return status of operation
+                 */
+                status_t        set_matrix(const float *matrix);
+
+                /**
+                 * Release all allocated resources
+                 */
+                void            destroy();
+
+            public:
+                inline size_t   dst_channels() const        { return nDst; }
+                inline size_t   src_channels() const        { return nSrc; }
+                inline const float *matrix() const          { return vMatrix; }
+
+                /**
+                 * Get coefficient of the matrix
+                 * @param dst destination channel
+                 * @param src source channel
+                 * @return coefficient, zero if channel index is out of range
+                 */
+                float           get(size_t dst, size_t src) const;
+
+                /**
+                 * Get number of non-zero coefficients
+                 * @return number of non-zero coefficients
+                 */
+                size_t          terms() const;
+
+                /**
+                 * Remix planar buffers, the destination buffers should not overlap source buffers
+                 * @param dst array of dst_channels() destination buffers
+                 * @param src array of src_channels() source buffers
+                 * @param samples number of samples to process
+                 */
+                void            process(float * const *dst, const float * const *src, size_t samples) const;
+        };
+
+    } /* namespace spa */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_SPA_REMIXER_H_ */
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_SPA_AUDIO_FORMAT_H_
+#define LSP_PLUG_IN_3RD_PARTY_SPA_AUDIO_FORMAT_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+
+#include <pw-headers/spa/param/audio/raw.h>
+#include <pw-headers/spa/pod/pod.h>
+
+namespace lsp
+{
+    namespace spa
+    {
+        /**
+         * Convert audio data to planar 32-bit floating-point samples
+         * @param dst array of channels destination buffers
+         * @param src array of source buffers: one buffer for interleaved formats,
+         *   channels buffers for planar formats
+         * @param channels number of channels
+         * @param frames number of frames to convert
+         */
+        typedef void (* audio_read_t)(float * const *dst, const void * const *src, size_t channels, size_t frames);
+
+        /**
+         * Convert planar 32-bit floating-point samples to audio data. Integer samples are
+         * rounded to nearest and saturated, NaN values are converted to the minimum value.
+         * @param dst array of destination buffers: one buffer for interleaved formats,
+         *   channels buffers for planar formats
+         * @param src array of channels source buffers
+         * @param channels number of channels
+         * @param frames number of frames to convert
+         */
+        typedef void (* audio_write_t)(void * const *dst, const float * const *src, size_t channels, size_t frames);
+
+        /**
+         * Descriptor of the raw audio sample format
+         */
+        typedef struct audio_format_desc_t
+        {
+            uint32_t            format;         // Format, one of enum spa_audio_format
+            const char         *name;           // Short name of the format
+            uint32_t            sample_size;    // Size of the sample in bytes
+            uint32_t            bits;           // Number of significant bits
+            bool                planar;         // Planar layout
+            bool                big_endian;     // Big-endian byte order
+            bool                is_float;       // Floating-point samples
+            audio_read_t        read;           // Conversion to planar float samples
+            audio_write_t       write;          // Conversion from planar float samples
+        } audio_format_desc_t;
+
+        /**
+         * Converter between raw audio format and planar float samples, initialized once
+         * at format negotiation
+         */
+        typedef struct audio_converter_t
+        {
+            const audio_format_desc_t  *desc;   // Format descriptor
+            uint32_t            rate;           // Sample rate
+            uint32_t            channels;       // Number of channels
+            uint32_t            blocks;         // Number of data blocks: 1 for interleaved, channels for planar
+            uint32_t            stride;         // Stride of data block: size of the frame or size of the sample
+            audio_read_t        read;           // Conversion to planar float samples
+            audio_write_t       write;          // Conversion from planar float samples
+        } audio_converter_t;
+
+        /**
+         * Get descriptor of the raw audio format. Supported are S16, S24, S24_32, S32, F32 and F64
+         * formats in both byte orders and their planar variants.
+         *
+         * @param format format, one of enum spa_audio_format
+         * @return descriptor of the format or NULL if format is not supported
+         */
+        LSP_3RD_PARTY_EXPORT
+        const audio_format_desc_t *audio_format_desc(uint32_t format);
+
+        /**
+         * Initialize converter for the negotiated format
+         * @param conv converter to initialize
+         * @param info parsed raw audio format
+         * @return status of operation, STATUS_UNSUPPORTED_FORMAT if format is not supported
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t audio_converter_init(audio_converter_t *conv, const struct spa_audio_info_raw *info);
+
+        /**
+         * Parse the raw audio format and initialize converter for it
+         * @param conv converter to initialize
+         * @param format SPA_TYPE_OBJECT_Format object with SPA_MEDIA_SUBTYPE_raw audio format
+         * @return status of operation, STATUS_BAD_FORMAT if format could not be parsed,
+         *   STATUS_UNSUPPORTED_FORMAT if format is not supported
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t audio_converter_init(audio_converter_t *conv, const struct spa_pod *format);
+
+        /**
+         * Convert audio data to planar float samples
+         * @param conv converter
+         * @param dst array of conv->channels destination buffers
+         * @param src array of conv->blocks source buffers
+         * @param frames number of frames
+         */
+        inline void audio_convert_read(const audio_converter_t *conv, float * const *dst, const void * const *src, size_t frames)
+        {
+            conv->read(dst, src, conv->channels, frames);
+        }
+
+        /**
+         * Convert planar float samples to audio data
+         * @param conv converter
+         * @param dst array of conv->blocks destination buffers
+         * @param src array of conv->channels source buffers
+         * @param frames number of frames
+         */
+        inline void audio_convert_write(const audio_converter_t *conv, void * const *dst, const float * const *src, size_t frames)
+        {
+            conv->write(dst, src, conv->channels, frames);
+        }
+
+    } /* namespace spa */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_SPA_AUDIO_FORMAT_H_ */
@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_SPA_AUDIO_PASSTHROUGH_H_
+#define LSP_PLUG_IN_3RD_PARTY_SPA_AUDIO_PASSTHROUGH_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+
+#include <pw-headers/spa/param/audio/dsd.h>
+#include <pw-headers/spa/param/audio/iec958.h>
+
+namespace lsp
+{
+    namespace spa
+    {
+        static constexpr uint8_t  DOP_MARKER_1          = 0x05;     // DoP marker of even frames
+        static constexpr uint8_t  DOP_MARKER_2          = 0xfa;     // DoP marker of odd frames
+
+        static constexpr uint16_t IEC61937_PA           = 0xf872;   // First burst sync word
+        static constexpr uint16_t IEC61937_PB           = 0x4e1f;   // Second burst sync word
+        static constexpr size_t   IEC61937_HEADER_SIZE  = 8;        // Size of the burst preamble in bytes
+
+        /**
+         * Layout of DSD data in the buffer, prepared from spa_audio_info_dsd
+         */
+        typedef struct dsd_layout_t
+        {
+            uint32_t            channels;       // Number of channels
+            uint32_t            group;          // Number of bytes of one channel in the interleaved group, 0 for planar
+            bool                reverse_bytes;  // Bytes in the group are stored in reverse order
+            bool                lsb_first;      // Bits in the byte are stored LSB first
+        } dsd_layout_t;
+
+        /**
+         * State of the DSD over PCM (DoP) stream
+         */
+        typedef struct dop_state_t
+        {
+            uint8_t             marker;         // Marker of the next frame, 0 if stream is not synchronized
+        } dop_state_t;
+
+        /**
+         * IEC 61937 burst encoder parameters, prepared from spa_audio_info_iec958.
+         * The data type and the repetition period can be adjusted after initialization,
+         * for example for MPEG-1 layer 1 or DTS type II/III frames.
+         */
+        typedef struct iec61937_t
+        {
+            uint32_t            codec;          // Codec, one of enum spa_audio_iec958_codec
+            uint32_t            data_type;      // IEC 61937 data type stored in Pc
+            uint32_t            period;         // Burst repetition period in IEC 958 frames
+            bool                length_bytes;   // Pd contains length in bytes instead of bits
+        } iec61937_t;
+
+        /**
+         * Decoded IEC 61937 burst
+         */
+        typedef struct iec61937_burst_t
+        {
+            uint32_t            data_type;      // Data type, bits 0-6 of Pc
+            uint32_t            pc;             // Raw value of Pc
+            size_t              offset;         // Offset of the preamble in the source buffer in bytes
+            size_t              length;         // Length of the payload in bytes
+            size_t              end;            // Offset of the end of payload in the source buffer in bytes
+        } iec61937_burst_t;
+
+        /**
+         * Prepare DSD layout
+         * @param layout layout to initialize
+         * @param info DSD format
+         * @return status of operation, STATUS_BAD_FORMAT if format is invalid
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t dsd_layout_init(dsd_layout_t *layout, const struct spa_audio_info_dsd *info);
+
+        /**
+         * Get number of buffers used by DSD layout
+         * @param layout DSD layout
+         * @return number of buffers: 1 for interleaved layout, number of channels for planar
+         */
+        inline size_t dsd_layout_blocks(const dsd_layout_t *layout)
+        {
+            return (layout->group > 0) ? 1 : layout->channels;
+        }
+
+        /**
+         * Reverse order of bits in each byte, the buffers may be the same
+         * @param dst destination buffer
+         * @param src source buffer
+         * @param count number of bytes
+         */
+        LSP_3RD_PARTY_EXPORT
+        void dsd_reverse_bits(uint8_t *dst, const uint8_t *src, size_t count);
+
+        /**
+         * Convert DSD data stored in the layout to planar MSB-first channel buffers
+         * @param layout DSD layout
+         * @param dst array of layout->channels destination buffers
+         * @param src array of dsd_layout_blocks() source buffers
+         * @param bytes number of bytes per channel, should be multiple of layout->group
+         * @return number of bytes per channel converted
+         */
+        LSP_3RD_PARTY_EXPORT
+        size_t dsd_unpack(const dsd_layout_t *layout, uint8_t * const *dst, const void * const *src, size_t bytes);
+
+        /**
+         * Convert planar MSB-first channel buffers to DSD data stored in the layout
+         * @param layout DSD layout
+         * @param dst array of dsd_layout_blocks() destination buffers
+         * @param src array of layout->channels source buffers
+         * @param bytes number of bytes per channel, should be multiple of layout->group
+         * @return number of bytes per channel converted
+         */
+        LSP_3RD_PARTY_EXPORT
+        size_t dsd_pack(const dsd_layout_t *layout, void * const *dst, const uint8_t * const *src, size_t bytes);
+
+        /**
+         * Reset DoP stream state
+         * @param state state to reset
+         */
+        inline void dop_init(dop_state_t *state)
+        {
+            state->marker       = 0;
+        }
+
+        /**
+         * Get PCM sample rate of the DoP stream
+         * @param info DSD format, the rate is specified in bytes per second
+         * @return PCM sample rate
+         */
+        inline uint32_t dop_rate(const struct spa_audio_info_dsd *info)
+        {
+            return info->rate / 2;
+        }
+
+        /**
+         * Encode planar MSB-first DSD data to interleaved DoP frames. Each 32-bit sample
+         * contains marker in bits 24-31 and two DSD bytes in bits 8-23, the earliest byte first.
+         * @param state DoP stream state
+         * @param dst interleaved 32-bit destination samples
+         * @param src array of channels buffers containing frames*2 bytes each
+         * @param channels number of channels
+         * @param frames number of frames to encode
+         */
+        LSP_3RD_PARTY_EXPORT
+        void dop_encode(dop_state_t *state, int32_t *dst, const uint8_t * const *src, size_t channels, size_t frames);
+
+        /**
+         * Decode interleaved DoP frames to planar MSB-first DSD data. Decoding stops at the first frame
+         * that does not contain the expected marker, in this case the state is reset and the caller
+         * should treat the rest of data as PCM.
+         * @param state DoP stream state
+         * @param dst array of channels buffers for frames*2 bytes each
+         * @param src interleaved 32-bit source samples
+         * @param channels number of channels
+         * @param frames number of frames to decode
+         * @return number of decoded frames
+         */
+        LSP_3RD_PARTY_EXPORT
+        size_t dop_decode(dop_state_t *state, uint8_t * const *dst, const int32_t *src, size_t channels, size_t frames);
+
+        /**
+         * Prepare IEC 61937 encoder
+         * @param enc encoder to initialize
+         * @param info IEC 958 format
+         * @return status of operation, STATUS_UNSUPPORTED_FORMAT for codecs that require
+         *   additional framing (PCM, TrueHD, DTS-HD)
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t iec61937_init(iec61937_t *enc, const struct spa_audio_info_iec958 *info);
+
+        /**
+         * Get size of the burst in bytes
+         * @param enc encoder
+         * @return size of the burst, equal to the repetition period of 16-bit stereo frames
+         */
+        inline size_t iec61937_burst_size(const iec61937_t *enc)
+        {
+            return size_t(enc->period) * 4;
+        }
+
+        /**
+         * Pack codec frame into the IEC 61937 burst of native-endian 16-bit words
+         * padded with zeros up to the repetition period
+         * @param enc encoder
+         * @param dst destination buffer
+         * @param dst_size size of destination buffer
+         * @param payload codec frame
+         * @param size size of codec frame in bytes
+         * @return status of operation, STATUS_OVERFLOW if destination buffer is less than burst size,
+         *   STATUS_TOO_BIG if the frame does not fit into the burst
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t iec61937_pack(const iec61937_t *enc, void *dst, size_t dst_size, const void *payload, size_t size);
+
+        /**
+         * Find the first IEC 61937 burst in the stream of native-endian 16-bit words and extract the payload
+         * @param burst burst descriptor to store
+         * @param dst destination buffer for the payload
+         * @param dst_size size of the destination buffer
+         * @param src source stream
+         * @param size size of the source stream in bytes
+         * @return status of operation, STATUS_NOT_FOUND if there is no burst preamble, STATUS_EOF if
+         *   the burst is truncated, STATUS_OVERFLOW if the payload does not fit into the destination buffer
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t iec61937_unpack(iec61937_burst_t *burst, void *dst, size_t dst_size, const void *src, size_t size);
+
+    } /* namespace spa */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_SPA_AUDIO_PASSTHROUGH_H_ */
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_SPA_CHANNEL_MAP_H_
+#define LSP_PLUG_IN_3RD_PARTY_SPA_CHANNEL_MAP_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+
+#include <clap/ext/ambisonic.h>
+#include <pw-headers/spa/param/audio/raw.h>
+
+namespace lsp
+{
+    namespace spa
+    {
+        static constexpr uint32_t CHANNEL_MAP_NONE      = 0xffffffff;   // Channel is missing in the permutation
+
+        /*
+         * Translation between SPA_AUDIO_CHANNEL positions and plugin format channel layouts:
+         *   - VST3 speaker arrangements: channels are ordered by ascending speaker bits,
+         *     ambisonic ACN channels are mapped to AUX positions with the same index;
+         *   - CLAP surround channel maps: CLAP_SURROUND_* identifier for each channel;
+         *   - CLAP ambisonic configuration: FuMa or ACN channel ordering, AUX position
+         *     is the ACN index of the channel.
+         * Back channels of VST3 (Ls, Rs, Cs) and CLAP (BL, BR, BC) correspond to SPA
+         * rear channels (RL, RR, RC), side channels correspond to SPA side channels.
+         */
+
+        /**
+         * Get SPA position of VST3 speaker
+         * @param speaker Steinberg::Vst::Speaker, single bit
+         * @return SPA position or SPA_AUDIO_CHANNEL_UNKNOWN if there is no such position
+         */
+        LSP_3RD_PARTY_EXPORT
+        uint32_t vst3_speaker_to_position(uint64_t speaker);
+
+        /**
+         * Get VST3 speaker of SPA position
+         * @param position SPA position
+         * @return Steinberg::Vst::Speaker or 0 if there is no such speaker
+         */
+        LSP_3RD_PARTY_EXPORT
+        uint64_t position_to_vst3_speaker(uint32_t position);
+
+        /**
+         * Get SPA position of CLAP surround channel
+         * @param id CLAP_SURROUND_* identifier
+         * @return SPA position or SPA_AUDIO_CHANNEL_UNKNOWN if there is no such position
+         */
+        LSP_3RD_PARTY_EXPORT
+        uint32_t clap_surround_to_position(uint32_t id);
+
+        /**
+         * Get CLAP surround channel of SPA position
+         * @param position SPA position
+         * @return CLAP_SURROUND_* identifier or negative value if there is no such channel
+         */
+        LSP_3RD_PARTY_EXPORT
+        int position_to_clap_surround(uint32_t position);
+
+        /**
+         * Convert VST3 speaker arrangement to the list of SPA positions in VST3 channel order
+         * @param pos array to store positions
+         * @param count pointer to store number of channels
+         * @param capacity capacity of the array
+         * @param arrangement Steinberg::Vst::SpeakerArrangement
+         * @return status of operation, STATUS_OVERFLOW if capacity is not enough,
+         *   STATUS_NOT_FOUND if some speakers have no SPA position
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t vst3_arrangement_to_positions(uint32_t *pos, size_t *count, size_t capacity, uint64_t arrangement);
+
+        /**
+         * Convert list of SPA positions to VST3 speaker arrangement. The channel order of
+         * the arrangement may differ from the order of positions, use channel_permutation()
+         * to map channels.
+         * @param arrangement pointer to store Steinberg::Vst::SpeakerArrangement
+         * @param pos SPA positions
+         * @param count number of channels
+         * @return status of operation, STATUS_NOT_FOUND if some positions have no VST3 speaker,
+         *   STATUS_BAD_FORMAT if positions are duplicated
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t positions_to_vst3_arrangement(uint64_t *arrangement, const uint32_t *pos, size_t count);
+
+        /**
+         * Convert CLAP surround channel map to the list of SPA positions
+         * @param pos array to store count positions
+         * @param map CLAP channel map
+         * @param count number of channels
+         * @return status of operation, STATUS_NOT_FOUND if some channels have no SPA position
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t clap_surround_to_positions(uint32_t *pos, const uint8_t *map, size_t count);
+
+        /**
+         * Convert list of SPA positions to CLAP surround channel map
+         * @param map array to store count channel identifiers
+         * @param pos SPA positions
+         * @param count number of channels
+         * @return status of operation, STATUS_NOT_FOUND if some positions have no CLAP surround channel
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t positions_to_clap_surround(uint8_t *map, const uint32_t *pos, size_t count);
+
+        /**
+         * Compute CLAP surround channel mask
+         * @param map CLAP channel map
+         * @param count number of channels
+         * @return channel mask
+         */
+        inline uint64_t clap_surround_mask(const uint8_t *map, size_t count)
+        {
+            uint64_t mask = 0;
+            for (size_t i=0; i<count; ++i)
+                mask       |= uint64_t(1) << map[i];
+            return mask;
+        }
+
+        /**
+         * Convert CLAP ambisonic configuration to the list of SPA AUX positions indexed by ACN
+         * @param pos array to store count positions
+         * @param config CLAP ambisonic configuration, normalization is not taken into account
+         * @param count number of channels, should be (order + 1)^2, up to 16 for FuMa ordering
+         *   and up to 64 for ACN ordering
+         * @return status of operation, STATUS_BAD_FORMAT if number of channels or ordering is invalid
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t clap_ambisonic_to_positions(uint32_t *pos, const clap_ambisonic_config_t *config, size_t count);
+
+        /**
+         * Compute channel permutation between two layouts. Duplicated positions are matched
+         * in order of their appearance.
+         * @param perm array to store dst_count source channel indices or CHANNEL_MAP_NONE
+         * @param dst destination positions
+         * @param dst_count number of destination channels
+         * @param src source positions
+         * @param src_count number of source channels
+         * @return status of operation, STATUS_NOT_FOUND if some destination channels have no source
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t channel_permutation(uint32_t *perm, const uint32_t *dst, size_t dst_count, const uint32_t *src, size_t src_count);
+
+        /**
+         * Permute array of channel buffer pointers, audio data is not moved
+         * @param dst destination array of count pointers
+         * @param src source array of pointers
+         * @param perm permutation computed by channel_permutation()
+         * @param count number of destination channels
+         * @param fill pointer to use for missing channels, for example silence buffer
+         */
+        template <class T>
+        inline void channel_permute(T *dst, const T *src, const uint32_t *perm, size_t count, T fill)
+        {
+            for (size_t i=0; i<count; ++i)
+                dst[i]      = (perm[i] != CHANNEL_MAP_NONE) ? src[perm[i]] : fill;
+        }
+
+    } /* namespace spa */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_SPA_CHANNEL_MAP_H_ */
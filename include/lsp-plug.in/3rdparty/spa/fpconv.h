@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_SPA_FPCONV_H_
+#define LSP_PLUG_IN_3RD_PARTY_SPA_FPCONV_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+
+namespace lsp
+{
+    namespace spa
+    {
+        /**
+         * Size of the buffer enough to store any formatted floating-point value
+         * including the terminating zero character
+         */
+        static constexpr size_t FPCONV_BUF_SIZE     = 32;
+
+        /**
+         * Format single-precision floating-point value using the shortest decimal
+         * representation that converts back to the same value. The output does not
+         * depend on the current locale and always is a valid JSON number for finite
+         * values: the fixed notation is used for decimal exponents in range [-6, 21),
+         * the scientific notation is used otherwise. Integer values are emitted with
+         * the '.0' suffix. Non-finite values are formatted as 'nan', 'inf' and '-inf'.
+         *
+         * @param dst destination buffer, the output is always zero-terminated
+         * @param size size of the destination buffer
+         * @param value value to format
+         * @return number of characters in the formatted value, if it is not less than
+         *   size then the output has been truncated
+         */
+        LSP_3RD_PARTY_EXPORT
+        size_t format_float(char *dst, size_t size, float value);
+
+        /**
+         * Format double-precision floating-point value using the shortest decimal
+         * representation that converts back to the same value. The output format is
+         * the same as for format_float().
+         *
+         * @param dst destination buffer, the output is always zero-terminated
+         * @param size size of the destination buffer
+         * @param value value to format
+         * @return number of characters in the formatted value, if it is not less than
+         *   size then the output has been truncated
+         */
+        LSP_3RD_PARTY_EXPORT
+        size_t format_double(char *dst, size_t size, double value);
+
+        /**
+         * Parse the decimal floating-point number with correct rounding independently
+         * of the current locale. The longest prefix matching the syntax
+         * [+-]digits[.digits][(e|E)[+-]digits] is parsed, the leading whitespace,
+         * hexadecimal numbers, infinities and NaNs are not accepted. As strtof(),
+         * the function sets errno to ERANGE if the value overflows or is not
+         * representable as a normal floating-point number.
+         *
+         * @param src source string, should not necessarily be zero-terminated
+         * @param len maximum number of characters to parse
+         * @param value pointer to store the parsed value
+         * @return number of parsed characters, zero if the source does not start with
+         *   a decimal number
+         */
+        LSP_3RD_PARTY_EXPORT
+        size_t parse_float(const char *src, size_t len, float *value);
+
+        /**
+         * Parse the decimal floating-point number with correct rounding independently
+         * of the current locale. The syntax and error reporting are the same as for
+         * parse_float().
+         *
+         * @param src source string, should not necessarily be zero-terminated
+         * @param len maximum number of characters to parse
+         * @param value pointer to store the parsed value
+         * @return number of parsed characters, zero if the source does not start with
+         *   a decimal number
+         */
+        LSP_3RD_PARTY_EXPORT
+        size_t parse_double(const char *src, size_t len, double *value);
+
+    } /* namespace spa */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_SPA_FPCONV_H_ */
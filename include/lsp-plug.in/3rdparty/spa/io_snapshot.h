@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_SPA_IO_SNAPSHOT_H_
+#define LSP_PLUG_IN_3RD_PARTY_SPA_IO_SNAPSHOT_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+
+#include <pw-headers/spa/node/io.h>
+
+namespace lsp
+{
+    namespace spa
+    {
+        /**
+         * Default number of attempts to read consistent snapshot
+         */
+        static constexpr size_t IO_SNAPSHOT_RETRIES     = 64;
+
+        /**
+         * Consistent copy of spa_io_clock with derived values
+         */
+        typedef struct clock_snapshot_t
+        {
+            uint32_t            flags;              // Clock flags
+            uint32_t            id;                 // Clock identifier
+            uint32_t            cycle;              // Cycle counter
+            uint64_t            nsec;               // Time of the cycle start, ns
+            uint64_t            next_nsec;          // Estimated time of the next cycle start, ns
+            struct spa_fraction rate;               // Rate of position, duration and delay
+            uint64_t            position;           // Position, samples
+            uint64_t            duration;           // Duration of the cycle, samples
+            int64_t             delay;              // Delay between position and hardware, samples
+            double              rate_diff;          // Rate difference between clock and monotonic time
+            struct spa_fraction target_rate;        // Target rate of the next cycle
+            uint64_t            target_duration;    // Target duration of the next cycle
+            uint64_t            xrun;               // Estimated accumulated xrun duration
+
+            // Derived values
+            double              sample_rate;        // Nominal sample rate, 0 if rate is not set
+            double              actual_rate;        // Sample rate measured against monotonic time
+            double              ns_per_sample;      // Monotonic time per sample corrected with rate_diff, ns
+            int64_t             cycle_ns;           // Duration of the cycle in monotonic time, ns
+        } clock_snapshot_t;
+
+        /**
+         * Consistent copy of spa_io_position with derived values
+         */
+        typedef struct position_snapshot_t
+        {
+            clock_snapshot_t    clock;              // Clock of the driver
+            int64_t             offset;             // Offset to subtract from clock position to get running time
+            uint32_t            state;              // Transport state, one of enum spa_io_position_state
+            int64_t             running;            // Running time at the cycle start, samples
+
+            // Active segment
+            bool                has_segment;        // There is an active segment
+            bool                has_position;       // Stream position is valid
+            bool                has_bbt;            // Bar and beat information is valid
+            uint32_t            segment_flags;      // Flags of the active segment
+            double              segment_rate;       // Rate of the active segment
+            double              stream_position;    // Position of the stream at the cycle start, samples
+
+            // Bar and beat information of the active segment
+            float               signature_num;      // Time signature numerator, beats per bar
+            float               signature_denom;    // Time signature denominator
+            double              bpm;                // Beats per minute
+            double              ticks_per_beat;     // Ticks per beat
+            double              beat;               // Absolute beat position at the cycle start
+            int64_t             bar;                // Current bar, 1-based
+            int32_t             bar_beat;           // Current beat in the bar, 1-based
+            double              tick;               // Current tick in the beat
+            double              bar_start_tick;     // Tick at the start of the bar as reported by the segment
+        } position_snapshot_t;
+
+        /**
+         * Start update of the clock. The writer should wrap all updates of the clock
+         * into clock_write_begin() and clock_write_end() calls to allow readers to
+         * detect the concurrent update. The protocol is compatible with the use of
+         * target_seq for target_rate and target_duration fields.
+         *
+         * @param clock clock to update
+         */
+        LSP_3RD_PARTY_EXPORT
+        void clock_write_begin(struct spa_io_clock *clock);
+
+        /**
+         * Complete update of the clock
+         * @param clock clock to update
+         */
+        LSP_3RD_PARTY_EXPORT
+        void clock_write_end(struct spa_io_clock *clock);
+
+        /**
+         * Read consistent snapshot of the clock. The read is retried while the sequence
+         * counter is odd or changes during the read, or while two subsequent copies of
+         * the clock differ. The consistency is guaranteed only for writers that use
+         * clock_write_begin() and clock_write_end(), for other writers the torn read is
+         * detected only if the writer makes progress during the read.
+         *
+         * @param dst snapshot to fill
+         * @param src clock to read
+         * @param retries maximum number of attempts
+         * @return STATUS_OK on success, STATUS_RETRY if consistent snapshot could not be
+         *   read with the specified number of attempts, dst is not modified in this case
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t read_clock(clock_snapshot_t *dst, const struct spa_io_clock *src, size_t retries = IO_SNAPSHOT_RETRIES);
+
+        /**
+         * Read consistent snapshot of the position, derive running time, stream position
+         * and bar and beat information of the segment active at the cycle start. The clock
+         * of the position is protected by its sequence counter the same way as read_clock().
+         *
+         * @param dst snapshot to fill
+         * @param src position to read
+         * @param retries maximum number of attempts
+         * @return STATUS_OK on success, STATUS_RETRY if consistent snapshot could not be
+         *   read with the specified number of attempts, dst is not modified in this case
+         */
+        LSP_3RD_PARTY_EXPORT
+        status_t read_position(position_snapshot_t *dst, const struct spa_io_position *src, size_t retries = IO_SNAPSHOT_RETRIES);
+
+        /**
+         * Convert sample offset from the cycle start to the monotonic time
+         * @param clock clock snapshot
+         * @param offset offset in samples
+         * @return monotonic time, ns
+         */
+        LSP_3RD_PARTY_EXPORT
+        int64_t clock_sample_time(const clock_snapshot_t *clock, int64_t offset);
+
+    } /* namespace spa */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_SPA_IO_SNAPSHOT_H_ */
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_3RD_PARTY_SPA_POD_HASH_H_
+#define LSP_PLUG_IN_3RD_PARTY_SPA_POD_HASH_H_
+
+#include <lsp-plug.in/3rdparty/version.h>
+#include <lsp-plug.in/common/types.h>
+
+#include <pw-headers/spa/pod/pod.h>
+
+namespace lsp
+{
+    namespace spa
+    {
+        /**
+         * Compute canonical hash of the POD value. The hash does not depend on the
+         * padding bytes, on the order of object properties, on the order of alternatives
+         * of the enumeration and flags choices, on the sign of floating-point zero and
+         * on the non-reduced form of fractions. Single-value choices of SPA_CHOICE_None
+         * type are hashed the same way as the plain value.
+         *
+         * The hash is consistent with pod_equals(): equivalent values always have the same
+         * hash. It is consistent with spa_pod_compare() only for the values which are
+         * compared by spa_pod_compare() completely: plain values and arrays except NaN
+         * values and 0/0 fractions. Structures, objects and choices are not, so PodSet
+         * relies on the pod_equals() rules for them.
+         *
+         * @param pod POD value to hash
+         * @return hash value, zero for NULL pointer
+         */
+        LSP_3RD_PARTY_EXPORT
+        uint64_t pod_hash(const struct spa_pod *pod);
+
+        /**
+         * Check that two POD values are equivalent. The equivalence relation is consistent
+         * with pod_hash(): equivalent values always have the same hash. For plain values
+         * and arrays it matches the spa_pod_compare() semantics, structures, objects and
+         * choices are compared by own rules. The differences are:
+         *   - choices are also compared by choice type and all alternatives, not only
+         *     by the default value;
+         *   - objects are also compared by object type, object identifier and flags
+         *     of the properties;
+         *   - NaN values are equal only to NaN values;
+         *   - 0/0 fraction is equal only to itself;
+         *   - structures are compared element-wise (spa_pod_compare() never reports them
+         *     as equal).
+         *
+         * @param a first POD value
+         * @param b second POD value
+         * @return true if values are equivalent
+         */
+        LSP_3RD_PARTY_EXPORT
+        bool pod_equals(const struct spa_pod *a, const struct spa_pod *b);
+
+    } /* namespace spa */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_3RD_PARTY_SPA_POD_HASH_H_ */
@@ -65,6 +65,13 @@ struct spa_json_builder {
 #define SPA_JSON_BUILDER_COLOR_STRING		4
 #define SPA_JSON_BUILDER_COLOR_CONTAINER	5
 	const char *color[8];
+	/* memory sink, used when f is NULL */
+	char *mem;
+	size_t mem_size;
+	size_t mem_len;
+	char **mem_result;
+	size_t *mem_result_size;
+	int mem_error;
 };
 
 SPA_API_JSON_BUILDER int spa_json_builder_file(struct spa_json_builder *b, FILE *f, uint32_t flags)
@@ -108,40 +115,184 @@ SPA_API_JSON_BUILDER int spa_json_builder_membuf(struct spa_json_builder *b,
 	return spa_json_builder_file(b, f, flags | SPA_JSON_BUILDER_FLAG_CLOSE);
 }
 
+/**
+ * Initialize the builder that appends the output directly to the memory buffer
+ * growing it as needed. After spa_json_builder_close() \a mem contains the
+ * zero-terminated text allocated with malloc() or NULL if the allocation
+ * has failed, \a size contains the length of the text.
+ */
+SPA_API_JSON_BUILDER int spa_json_builder_buffer(struct spa_json_builder *b,
+		char **mem, size_t *size, uint32_t flags)
+{
+	spa_json_builder_file(b, NULL, flags & ~SPA_JSON_BUILDER_FLAG_CLOSE);
+	b->mem_result = mem;
+	b->mem_result_size = size;
+	return 0;
+}
+
+/**
+ * Initialize the builder that appends the output directly to the fixed-size
+ * memory buffer. The output is always zero-terminated, extra data is dropped
+ * and spa_json_builder_error() returns -ENOSPC after that.
+ */
+SPA_API_JSON_BUILDER int spa_json_builder_buffer_fixed(struct spa_json_builder *b,
+		char *mem, size_t size, uint32_t flags)
+{
+	if (mem == NULL || size == 0)
+		return -EINVAL;
+	spa_json_builder_file(b, NULL, flags & ~SPA_JSON_BUILDER_FLAG_CLOSE);
+	b->mem = mem;
+	b->mem_size = size;
+	b->mem[0] = '\0';
+	return 0;
+}
+
+/** Return the number of bytes written to the memory buffer */
+SPA_API_JSON_BUILDER size_t spa_json_builder_length(const struct spa_json_builder *b)
+{
+	return b->mem_len;
+}
+
+/** Return the error of the memory buffer: -ENOMEM or -ENOSPC, 0 if no error */
+SPA_API_JSON_BUILDER int spa_json_builder_error(const struct spa_json_builder *b)
+{
+	return b->mem_error;
+}
+
 SPA_API_JSON_BUILDER void spa_json_builder_close(struct spa_json_builder *b)
 {
 	if (b->flags & SPA_JSON_BUILDER_FLAG_CLOSE)
 		fclose(b->f);
+	if (b->mem_result != NULL) {
+		if (b->mem == NULL && b->mem_error == 0)
+			b->mem = (char *)calloc(1, 1);
+		if (b->mem == NULL || b->mem_error != 0) {
+			free(b->mem);
+			b->mem = NULL;
+			b->mem_len = 0;
+		}
+		*b->mem_result = b->mem;
+		if (b->mem_result_size != NULL)
+			*b->mem_result_size = b->mem_len;
+		b->mem_result = NULL;
+		b->mem = NULL;
+	}
+}
+
+SPA_API_JSON_BUILDER bool spa_json_builder_reserve(struct spa_json_builder *b, size_t len)
+{
+	size_t avail, size;
+	char *mem;
+
+	if (b->mem_error != 0)
+		return false;
+	if (b->mem_result == NULL) {
+		b->mem_error = -ENOSPC;
+		return false;
+	}
+
+	for (size = SPA_MAX(b->mem_size, (size_t)4096); size - b->mem_len <= len; size <<= 1)
+		/* nothing */;
+	if ((mem = (char *)realloc(b->mem, size)) == NULL) {
+		b->mem_error = -ENOMEM;
+		return false;
+	}
+	b->mem = mem;
+	b->mem_size = size;
+	avail = size - b->mem_len;
+	return avail > len;
+}
+
+SPA_API_JSON_BUILDER int spa_json_builder_write(struct spa_json_builder *b,
+		const char *data, size_t len)
+{
+	if (b->f != NULL)
+		return fwrite(data, 1, len, b->f);
+
+	if (b->mem_size - b->mem_len <= len && !spa_json_builder_reserve(b, len)) {
+		/* truncate the output of the fixed buffer */
+		if (b->mem_size == 0 || b->mem_result != NULL)
+			return 0;
+		len = b->mem_size - b->mem_len - 1;
+	}
+	memcpy(b->mem + b->mem_len, data, len);
+	b->mem_len += len;
+	b->mem[b->mem_len] = '\0';
+	return len;
+}
+
+SPA_API_JSON_BUILDER int spa_json_builder_puts(struct spa_json_builder *b, const char *str)
+{
+	return spa_json_builder_write(b, str, strlen(str));
+}
+
+SPA_API_JSON_BUILDER int spa_json_builder_putc(struct spa_json_builder *b, char c)
+{
+	if (b->f == NULL && b->mem_size - b->mem_len > 1) {
+		b->mem[b->mem_len++] = c;
+		b->mem[b->mem_len] = '\0';
+		return 1;
+	}
+	return spa_json_builder_write(b, &c, 1);
+}
+
+SPA_API_JSON_BUILDER int spa_json_builder_pad(struct spa_json_builder *b, int count)
+{
+	static const char spaces[] = "                                ";
+	int len = 0, n;
+	while (count > 0) {
+		n = SPA_MIN(count, (int)sizeof(spaces) - 1);
+		len += spa_json_builder_write(b, spaces, n);
+		count -= n;
+	}
+	return len;
 }
 
 SPA_API_JSON_BUILDER int spa_json_builder_encode_string(struct spa_json_builder *b,
 		bool raw, const char *before, const char *val, int size, const char *after)
 {
-	FILE *f = b->f;
-	int i, len;
+	static const char hex[] = { "0123456789abcdef" };
+	char esc[6];
+	int i, n, len;
+
+	size = (int)strnlen(val, size);
+	len = spa_json_builder_puts(b, before);
 	if (raw) {
-		len = fprintf(f, "%s%.*s%s", before, size, val, after) - 1;
+		len += spa_json_builder_write(b, val, size);
+		len += spa_json_builder_puts(b, after) - 1;
 	} else {
-		len = fprintf(f, "%s\"", before);
-		for (i = 0; i < size && val[i]; i++) {
+		len += spa_json_builder_putc(b, '"');
+		for (i = 0; i < size; i++) {
+			/* copy the run of characters that need no escaping at once */
+			n = spa_json_escape_span(val + i, size - i);
+			if (n > 0) {
+				len += spa_json_builder_write(b, val + i, n);
+				if ((i += n) >= size)
+					break;
+			}
 			char v = val[i];
+			esc[0] = '\\';
 			switch (v) {
-			case '\n': len += fprintf(f, "\\n"); break;
-			case '\r': len += fprintf(f, "\\r"); break;
-			case '\b': len += fprintf(f, "\\b"); break;
-			case '\t': len += fprintf(f, "\\t"); break;
-			case '\f': len += fprintf(f, "\\f"); break;
+			case '\n': esc[1] = 'n'; n = 2; break;
+			case '\r': esc[1] = 'r'; n = 2; break;
+			case '\b': esc[1] = 'b'; n = 2; break;
+			case '\t': esc[1] = 't'; n = 2; break;
+			case '\f': esc[1] = 'f'; n = 2; break;
 			case '\\':
-			case '"': len += fprintf(f, "\\%c", v); break;
+			case '"': esc[1] = v; n = 2; break;
 			default:
-				if (v > 0 && v < 0x20)
-					len += fprintf(f, "\\u%04x", v);
-				else
-					len += fprintf(f, "%c", v);
+				esc[1] = 'u';
+				esc[2] = '0';
+				esc[3] = '0';
+				esc[4] = hex[(v >> 4) & 0xf];
+				esc[5] = hex[v & 0xf];
+				n = 6;
 				break;
 			}
+			len += spa_json_builder_write(b, esc, n);
 		}
-		len += fprintf(f, "\"%s", after);
+		len += spa_json_builder_putc(b, '"');
+		len += spa_json_builder_puts(b, after);
 	}
 	return len-1;
 }
@@ -186,14 +337,17 @@ void spa_json_builder_add_simple(struct spa_json_builder *b, const char *key, in
 		break;
 	}
 
-	fprintf(b->f, "%s%s%*s", b->delim, b->count == 0 ? "" : indent ? "\n" : space ? " " : "",
-			indent ? b->level : 0, "");
+	spa_json_builder_puts(b, b->delim);
+	spa_json_builder_puts(b, b->count == 0 ? "" : indent ? "\n" : space ? " " : "");
+	spa_json_builder_pad(b, indent ? b->level : 0);
 	if (key) {
 		bool key_raw = force_raw || (simple && spa_json_make_simple_string(&key, &key_len)) ||
 			spa_json_is_string(key, key_len);
 		spa_json_builder_encode_string(b, key_raw,
 				b->color[1], key, key_len, b->color[0]);
-		fprintf(b->f, "%s%s", b->key_sep, space ? " " : "");
+		spa_json_builder_puts(b, b->key_sep);
+		if (space)
+			spa_json_builder_putc(b, ' ');
 	}
 	b->delim = b->comma;
 	switch (type) {
@@ -268,7 +422,7 @@ SPA_API_JSON_BUILDER void spa_json_builder_object_double(struct spa_json_builder
 		const char *key, double val)
 {
 	char str[64];
-	spa_json_format_float(str, sizeof(str), (float)val);
+	spa_json_format_double(str, sizeof(str), val);
 	spa_json_builder_add_simple(b, key, INT_MAX, 'd', str, INT_MAX);
 }
 SPA_API_JSON_BUILDER void spa_json_builder_object_string(struct spa_json_builder *b,
@@ -425,11 +579,13 @@ SPA_API_JSON_BUILDER char *spa_json_builder_reformat(const char *json, uint32_t
 	char *mem;
 	size_t size;
 	int res;
-	if ((res = spa_json_builder_memstream(&b, &mem, &size, flags)) < 0) {
+	if ((res = spa_json_builder_buffer(&b, &mem, &size, flags)) < 0) {
 		errno = -res;
 		return NULL;
 	}
 	spa_json_builder_array_value(&b, true, json);
+	if ((res = spa_json_builder_error(&b)) < 0)
+		errno = -res;
 	spa_json_builder_close(&b);
 	return mem;
 }
@@ -15,6 +15,15 @@
 #include <pw-headers/spa/utils/defs.h>
 #include <pw-headers/spa/utils/string.h>
 
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#define SPA_JSON_SSE2
+#endif
+#if defined(__AVX2__) && defined(__GNUC__)
+#include <immintrin.h>
+#define SPA_JSON_AVX2
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #else
@@ -430,6 +439,10 @@ SPA_API_JSON int spa_json_parse_float(const char *val, int len, float *result)
 	if (len <= 0 || len >= (int)sizeof(buf))
 		return 0;
 
+#ifdef SPA_LSP_FPCONV
+	if (lsp::spa::parse_float(val, len, result) == (size_t)len)
+		return 1;
+#endif
 	memcpy(buf, val, len);
 	buf[len] = '\0';
 
@@ -451,7 +464,28 @@ SPA_API_JSON char *spa_json_format_float(char *str, int size, float val)
 		else
 			val = 0.0f;
 	}
+#ifdef SPA_LSP_FPCONV
+	lsp::spa::format_float(str, size, val);
+	return str;
+#else
 	return spa_dtoa(str, size, val);
+#endif
+}
+
+SPA_API_JSON char *spa_json_format_double(char *str, int size, double val)
+{
+	if (SPA_UNLIKELY(!isnormal(val))) {
+		if (isinf(val))
+			val = signbit(val) ? -DBL_MAX : DBL_MAX;
+		else
+			val = 0.0;
+	}
+#ifdef SPA_LSP_FPCONV
+	lsp::spa::format_double(str, size, val);
+	return str;
+#else
+	return spa_dtoa(str, size, val);
+#endif
 }
 
 /* int */
@@ -578,6 +612,109 @@ SPA_API_JSON bool spa_json_make_simple_string(const char **val, int *len)
 	return false;
 }
 
+/**
+ * Return the length of the longest prefix of \a val, at most \a size bytes, that
+ * can be placed into a JSON string as is: it contains no quotes, backslashes and
+ * control characters including zero bytes. The bytes are checked in blocks.
+ */
+SPA_API_JSON int spa_json_escape_span(const char *val, int size)
+{
+	int i = 0;
+#ifdef SPA_JSON_AVX2
+	const __m256i quote32 = _mm256_set1_epi8('"');
+	const __m256i bslash32 = _mm256_set1_epi8('\\');
+	const __m256i ctrl32 = _mm256_set1_epi8(0x1f);
+	for (; i + 32 <= size; i += 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(val + i));
+		__m256i m = _mm256_or_si256(
+				_mm256_or_si256(_mm256_cmpeq_epi8(v, quote32), _mm256_cmpeq_epi8(v, bslash32)),
+				_mm256_cmpeq_epi8(_mm256_min_epu8(v, ctrl32), v));
+		unsigned int mask = (unsigned int)_mm256_movemask_epi8(m);
+		if (mask != 0)
+			return i + __builtin_ctz(mask);
+	}
+#endif
+#ifdef SPA_JSON_SSE2
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i bslash = _mm_set1_epi8('\\');
+	const __m128i ctrl = _mm_set1_epi8(0x1f);
+	for (; i + 16 <= size; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(val + i));
+		__m128i m = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, bslash)),
+				_mm_cmpeq_epi8(_mm_min_epu8(v, ctrl), v));
+		int mask = _mm_movemask_epi8(m);
+		if (mask != 0)
+			return i + __builtin_ctz(mask);
+	}
+#else
+	/* check 8 bytes at once: any byte below 0x20, equal to '"' or '\\' */
+	const uint64_t ones = 0x0101010101010101ULL, highs = 0x8080808080808080ULL;
+	for (; i + 8 <= size; i += 8) {
+		uint64_t v, q, s;
+		memcpy(&v, val + i, sizeof(v));
+		q = v ^ (ones * '"');
+		s = v ^ (ones * '\\');
+		if (((v - ones * 0x20) | (q - ones) | (s - ones)) & ~v & highs)
+			break;
+	}
+#endif
+	for (; i < size; i++) {
+		unsigned char c = (unsigned char)val[i];
+		if (c < 0x20 || c == '"' || c == '\\')
+			break;
+	}
+	return i;
+}
+
+/**
+ * Return the length of the longest prefix of \a val, at most \a size bytes, that
+ * contains no quotes and backslashes and thus can be copied from a JSON string
+ * as is. The bytes are checked in blocks.
+ */
+SPA_API_JSON int spa_json_unescape_span(const char *val, int size)
+{
+	int i = 0;
+#ifdef SPA_JSON_AVX2
+	const __m256i quote32 = _mm256_set1_epi8('"');
+	const __m256i bslash32 = _mm256_set1_epi8('\\');
+	for (; i + 32 <= size; i += 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(val + i));
+		__m256i m = _mm256_or_si256(_mm256_cmpeq_epi8(v, quote32), _mm256_cmpeq_epi8(v, bslash32));
+		unsigned int mask = (unsigned int)_mm256_movemask_epi8(m);
+		if (mask != 0)
+			return i + __builtin_ctz(mask);
+	}
+#endif
+#ifdef SPA_JSON_SSE2
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i bslash = _mm_set1_epi8('\\');
+	for (; i + 16 <= size; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(val + i));
+		__m128i m = _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, bslash));
+		int mask = _mm_movemask_epi8(m);
+		if (mask != 0)
+			return i + __builtin_ctz(mask);
+	}
+#else
+	/* check 8 bytes at once: any byte equal to '"' or '\\' */
+	const uint64_t ones = 0x0101010101010101ULL, highs = 0x8080808080808080ULL;
+	for (; i + 8 <= size; i += 8) {
+		uint64_t v, q, s;
+		memcpy(&v, val + i, sizeof(v));
+		q = v ^ (ones * '"');
+		s = v ^ (ones * '\\');
+		if ((((q - ones) & ~q) | ((s - ones) & ~s)) & highs)
+			break;
+	}
+#endif
+	for (; i < size; i++) {
+		if (val[i] == '"' || val[i] == '\\')
+			break;
+	}
+	return i;
+}
+
 SPA_API_JSON int spa_json_parse_hex(const char *p, int num, uint32_t *res)
 {
 	int i;
@@ -608,6 +745,14 @@ SPA_API_JSON int spa_json_parse_stringn(const char *val, int len, char *result,
 		result += len;
 	} else {
 		for (p = val+1; p < val + len; p++) {
+			/* copy the run of characters that need no unescaping at once */
+			int n = spa_json_unescape_span(p, val + len - p);
+			if (n > 0) {
+				memmove(result, p, n);
+				result += n;
+				if ((p += n) >= val + len)
+					break;
+			}
 			if (*p == '\\') {
 				p++;
 				if (*p == 'n')
@@ -667,11 +812,24 @@ SPA_API_JSON int spa_json_parse_string(const char *val, int len, char *result)
 
 SPA_API_JSON int spa_json_encode_string(char *str, int size, const char *val)
 {
-	int len = 0;
+	int len = 0, n, rem;
 	static const char hex[] = { "0123456789abcdef" };
 #define __PUT(c) { if (len < size) *str++ = c; len++; }
 	__PUT('"');
-	while (*val) {
+	rem = (int)strlen(val);
+	while (rem > 0) {
+		/* copy the run of characters that need no escaping at once */
+		n = spa_json_escape_span(val, rem);
+		if (n > 0) {
+			if (len < size) {
+				memcpy(str, val, SPA_MIN(n, size - len));
+				str += SPA_MIN(n, size - len);
+			}
+			len += n;
+			val += n;
+			if ((rem -= n) <= 0)
+				break;
+		}
 		switch (*val) {
 		case '\n':
 			__PUT('\\'); __PUT('n');
@@ -703,6 +861,7 @@ SPA_API_JSON int spa_json_encode_string(char *str, int size, const char *val)
 			break;
 		}
 		val++;
+		rem--;
 	}
 	__PUT('"');
 	__PUT('\0');
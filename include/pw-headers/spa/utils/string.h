@@ -13,6 +13,15 @@
 #include <pw-headers/spa/utils/defs.h>
 #include <sys/types.h>
 
+/*
+ * When compiled as C++ with LSP_3RD_PARTY_SPA_FAST_FLOAT defined, the floating-point
+ * conversion routines use locale-independent shortest round-trip formatting and
+ * correctly rounded parsing provided by lsp-3rd-party library.
+ */
+#if defined(__cplusplus) && defined(LSP_3RD_PARTY_SPA_FAST_FLOAT)
+	#include <lsp-plug.in/3rdparty/spa/fpconv.h>
+	#define SPA_LSP_FPCONV
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -269,6 +278,14 @@ SPA_API_STRING float spa_strtof(const char *str, char **endptr)
 	locale_t prev;
 #endif
 	float v;
+#ifdef SPA_LSP_FPCONV
+	size_t n = lsp::spa::parse_float(str, (size_t)-1, &v);
+	if (n > 0 && str[n] != 'x' && str[n] != 'X') {
+		if (endptr)
+			*endptr = (char *)str + n;
+		return v;
+	}
+#endif
 #ifndef __LOCALE_C_ONLY
 	if (SPA_UNLIKELY(locale == NULL))
 		locale = newlocale(LC_ALL_MASK, "C", NULL);
@@ -319,6 +336,14 @@ SPA_API_STRING double spa_strtod(const char *str, char **endptr)
 	locale_t prev;
 #endif
 	double v;
+#ifdef SPA_LSP_FPCONV
+	size_t n = lsp::spa::parse_double(str, (size_t)-1, &v);
+	if (n > 0 && str[n] != 'x' && str[n] != 'X') {
+		if (endptr)
+			*endptr = (char *)str + n;
+		return v;
+	}
+#endif
 #ifndef __LOCALE_C_ONLY
 	if (SPA_UNLIKELY(locale == NULL))
 		locale = newlocale(LC_ALL_MASK, "C", NULL);
@@ -357,12 +382,17 @@ SPA_API_STRING bool spa_atod(const char *str, double *val)
 
 SPA_API_STRING char *spa_dtoa(char *str, size_t size, double val)
 {
+#ifdef SPA_LSP_FPCONV
+	lsp::spa::format_double(str, size, val);
+	return str;
+#else
 	int i, l;
 	l = spa_scnprintf(str, size, "%f", val);
 	for (i = 0; i < l; i++)
 		if (str[i] == ',')
 			str[i] = '.';
 	return str;
+#endif
 }
 
 struct spa_strbuf {
@@ -0,0 +1,780 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/DeferredLog.h>
+#include <lsp-plug.in/3rdparty/lv2/uris.h>
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <wchar.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        constexpr size_t DeferredLog::DEFAULT_THREADS;
+        constexpr size_t DeferredLog::DEFAULT_RING_SIZE;
+        constexpr size_t DeferredLog::MAX_ARGS;
+        constexpr size_t DeferredLog::MAX_STRING;
+        constexpr size_t DeferredLog::MAX_RECORD;
+        constexpr size_t DeferredLog::MAX_MESSAGE;
+
+        enum length_t
+        {
+            LEN_NONE,
+            LEN_HH,
+            LEN_H,
+            LEN_L,
+            LEN_LL,
+            LEN_Z,
+            LEN_J,
+            LEN_T,
+            LEN_BIG_L
+        };
+
+        enum record_flags_t
+        {
+            RECORD_TRUNCATED    = 1 << 0        // Some arguments have not been captured
+        };
+
+        typedef struct record_t
+        {
+            uint32_t            size;           // Size of the record, 0 marks the end of data in the ring
+            LV2_URID            type;           // Message type
+            const char         *format;         // Format string
+            uint32_t            args;           // Number of captured argument slots
+            uint32_t            flags;          // Flags of the record
+        } record_t;
+
+        typedef union slot_t
+        {
+            int64_t             i;              // Signed integer
+            uint64_t            u;              // Unsigned integer, pointer or offset of the string
+            double              d;              // Floating-point value
+        } slot_t;
+
+        typedef struct spec_t
+        {
+            const char         *begin;          // Start of the conversion specification
+            const char         *flags;          // Start of flags
+            size_t              nflags;         // Number of flags
+            const char         *end;            // End of the conversion specification
+            int                 width;          // Width, negative if not specified
+            int                 precision;      // Precision, negative if not specified
+            bool                width_arg;      // Width is passed as argument
+            bool                precision_arg;  // Precision is passed as argument
+            uint8_t             length;         // Length modifier
+            char                conv;           // Conversion
+        } spec_t;
+
+        static constexpr size_t RECORD_HEADER   = (sizeof(record_t) + 7) & ~size_t(7);  // Offset of argument slots
+        static constexpr uint32_t STRING_NULL   = 0xffffffff;   // Offset of the string for NULL pointer
+
+        // Generation counter to validate the per-thread ring cache
+        static size_t log_generation            = 0;
+
+        // Per-thread cache of the ring buffer, the address of the marker identifies the thread
+        static thread_local uint8_t tls_marker  = 0;
+        static thread_local struct
+        {
+            const void         *log;
+            size_t              generation;
+            void               *ring;
+        } tls_ring                              = { NULL, 0, NULL };
+
+        #ifdef LSP_TESTING
+        // Number of calls of the methods which are not realtime-safe made by the thread
+        static thread_local size_t tls_unsafe_calls = 0;
+        #endif /* LSP_TESTING */
+
+        static inline void unsafe_call()
+        {
+            #ifdef LSP_TESTING
+            ++tls_unsafe_calls;
+            #endif /* LSP_TESTING */
+        }
+
+        static inline size_t align8(size_t value)
+        {
+            return (value + 7) & ~size_t(7);
+        }
+
+        /**
+         * Parse the conversion specification
+         * @param spec specification to fill
+         * @param s pointer to the '%' character
+         * @return true if specification is valid
+         */
+        static bool parse_spec(spec_t *spec, const char *s)
+        {
+            spec->begin         = s++;
+            spec->width         = -1;
+            spec->precision     = -1;
+            spec->width_arg     = false;
+            spec->precision_arg = false;
+            spec->length        = LEN_NONE;
+
+            // Flags
+            spec->flags         = s;
+            while ((*s != '\0') && (strchr("-+ #0", *s) != NULL))
+                ++s;
+            spec->nflags        = s - spec->flags;
+
+            // Width
+            if (*s == '*')
+            {
+                spec->width_arg     = true;
+                ++s;
+            }
+            else if ((*s >= '0') && (*s <= '9'))
+            {
+                spec->width         = 0;
+                for ( ; (*s >= '0') && (*s <= '9'); ++s)
+                    spec->width         = lsp_min(spec->width * 10 + (*s - '0'), 0x10000);
+            }
+
+            // Precision
+            if (*s == '.')
+            {
+                ++s;
+                if (*s == '*')
+                {
+                    spec->precision_arg = true;
+                    ++s;
+                }
+                else
+                {
+                    spec->precision     = 0;
+                    for ( ; (*s >= '0') && (*s <= '9'); ++s)
+                        spec->precision     = lsp_min(spec->precision * 10 + (*s - '0'), 0x10000);
+                }
+            }
+
+            // Length modifier
+            switch (*s)
+            {
+                case 'h':
+                    ++s;
+                    spec->length        = (*s == 'h') ? LEN_HH : LEN_H;
+                    s                  += (spec->length == LEN_HH);
+                    break;
+                case 'l':
+                    ++s;
+                    spec->length        = (*s == 'l') ? LEN_LL : LEN_L;
+                    s                  += (spec->length == LEN_LL);
+                    break;
+                case 'z': spec->length = LEN_Z; ++s; break;
+                case 'j': spec->length = LEN_J; ++s; break;
+                case 't': spec->length = LEN_T; ++s; break;
+                case 'L': spec->length = LEN_BIG_L; ++s; break;
+                default:
+                    break;
+            }
+
+            // Conversion
+            spec->conv          = *s;
+            if ((spec->conv == '\0') || (strchr("diuoxXcsfFeEgGaApn%", spec->conv) == NULL))
+                return false;
+            spec->end           = s + 1;
+
+            return true;
+        }
+
+        static int64_t capture_signed(const spec_t *spec, va_list *ap)
+        {
+            switch (spec->length)
+            {
+                case LEN_HH:    return static_cast<signed char>(va_arg(*ap, int));
+                case LEN_H:     return static_cast<short>(va_arg(*ap, int));
+                case LEN_L:     return va_arg(*ap, long);
+                case LEN_LL:    return va_arg(*ap, long long);
+                case LEN_Z:     return va_arg(*ap, ssize_t);
+                case LEN_J:     return va_arg(*ap, intmax_t);
+                case LEN_T:     return va_arg(*ap, ptrdiff_t);
+                default:        break;
+            }
+            return va_arg(*ap, int);
+        }
+
+        static uint64_t capture_unsigned(const spec_t *spec, va_list *ap)
+        {
+            switch (spec->length)
+            {
+                case LEN_HH:    return static_cast<unsigned char>(va_arg(*ap, unsigned int));
+                case LEN_H:     return static_cast<unsigned short>(va_arg(*ap, unsigned int));
+                case LEN_L:     return va_arg(*ap, unsigned long);
+                case LEN_LL:    return va_arg(*ap, unsigned long long);
+                case LEN_Z:     return va_arg(*ap, size_t);
+                case LEN_J:     return va_arg(*ap, uintmax_t);
+                case LEN_T:     return static_cast<uint64_t>(va_arg(*ap, ptrdiff_t));
+                default:        break;
+            }
+            return va_arg(*ap, unsigned int);
+        }
+
+        /**
+         * Capture message into the buffer
+         * @param buf buffer of MAX_RECORD bytes
+         * @param type message type
+         * @param fmt format string
+         * @param ap arguments
+         * @return size of the record
+         */
+        static size_t capture(uint8_t *buf, LV2_URID type, const char *fmt, va_list *ap)
+        {
+            record_t *rec       = reinterpret_cast<record_t *>(buf);
+            slot_t *slots       = reinterpret_cast<slot_t *>(&buf[RECORD_HEADER]);
+            const size_t strings= RECORD_HEADER + DeferredLog::MAX_ARGS * sizeof(slot_t);
+            size_t str_size     = 0;
+            size_t nargs        = 0;
+            uint32_t flags      = 0;
+            spec_t spec;
+
+            for (const char *s = fmt; *s != '\0'; )
+            {
+                if (*s != '%')
+                {
+                    ++s;
+                    continue;
+                }
+                if (!parse_spec(&spec, s))
+                    break;
+                s                   = spec.end;
+                if (spec.conv == '%')
+                    continue;
+
+                // Check that all arguments of the specification fit
+                const size_t count  = size_t(spec.width_arg) + size_t(spec.precision_arg) + size_t(spec.conv != 'n');
+                if ((nargs + count > DeferredLog::MAX_ARGS) ||
+                    ((spec.conv == 's') && (strings + str_size >= DeferredLog::MAX_RECORD)))
+                {
+                    flags              |= RECORD_TRUNCATED;
+                    break;
+                }
+
+                if (spec.width_arg)
+                    slots[nargs++].i    = va_arg(*ap, int);
+                if (spec.precision_arg)
+                    slots[nargs++].i    = va_arg(*ap, int);
+
+                switch (spec.conv)
+                {
+                    case 'd': case 'i':
+                        slots[nargs++].i    = capture_signed(&spec, ap);
+                        break;
+                    case 'u': case 'o': case 'x': case 'X':
+                        slots[nargs++].u    = capture_unsigned(&spec, ap);
+                        break;
+                    case 'c':
+                        slots[nargs++].i    = (spec.length == LEN_L) ? int64_t(va_arg(*ap, wint_t)) : int64_t(va_arg(*ap, int));
+                        break;
+                    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                        slots[nargs++].d    = (spec.length == LEN_BIG_L) ? double(va_arg(*ap, long double)) : va_arg(*ap, double);
+                        break;
+                    case 'p':
+                        slots[nargs++].u    = uintptr_t(va_arg(*ap, void *));
+                        break;
+                    case 'n':
+                        va_arg(*ap, void *);
+                        break;
+                    case 's':
+                    {
+                        // Wide strings are not captured
+                        const char *str     = NULL;
+                        if (spec.length == LEN_L)
+                            va_arg(*ap, const wchar_t *);
+                        else
+                            str                 = va_arg(*ap, const char *);
+                        if (str == NULL)
+                        {
+                            slots[nargs++].u    = STRING_NULL;
+                            break;
+                        }
+
+                        // Copy the string, the offset is relative to the beginning of strings. The string
+                        // limited with precision may have no terminating zero, it is never read past precision
+                        const int precision = (spec.precision_arg) ? int(slots[nargs - 1].i) : spec.precision;
+                        const size_t avail  = DeferredLog::MAX_RECORD - strings - str_size;
+                        size_t limit        = lsp_min(DeferredLog::MAX_STRING, avail) - 1;
+                        const bool bounded  = (precision >= 0) && (size_t(precision) <= limit);
+                        if (bounded)
+                            limit               = precision;
+
+                        size_t len          = 0;
+                        while ((len < limit) && (str[len] != '\0'))
+                            ++len;
+                        if ((!bounded) && (len == limit) && (str[len] != '\0'))
+                            flags              |= RECORD_TRUNCATED;
+
+                        char *dst           = reinterpret_cast<char *>(&buf[strings + str_size]);
+                        memcpy(dst, str, len);
+                        dst[len]            = '\0';
+                        slots[nargs++].u    = str_size;
+                        str_size           += len + 1;
+                        break;
+                    }
+                    default:
+                        break;
+                }
+            }
+
+            // Move strings next to the slots
+            const size_t str_offset = RECORD_HEADER + nargs * sizeof(slot_t);
+            if (str_size > 0)
+                memmove(&buf[str_offset], &buf[strings], str_size);
+
+            rec->size           = uint32_t(align8(str_offset + str_size));
+            rec->type           = type;
+            rec->format         = fmt;
+            rec->args           = uint32_t(nargs);
+            rec->flags          = flags;
+
+            return rec->size;
+        }
+
+        static inline void append(char *dst, size_t *len, size_t cap, int written)
+        {
+            if (written > 0)
+                *len    = lsp_min(*len + size_t(written), cap - 1);
+        }
+
+        static size_t put_int(char *dst, int value)
+        {
+            char buf[0x10];
+            size_t n        = 0;
+            unsigned int v  = (value < 0) ? 0u - unsigned(value) : unsigned(value);
+            do
+            {
+                buf[n++]        = '0' + (v % 10);
+                v              /= 10;
+            } while (v > 0);
+
+            size_t len      = 0;
+            if (value < 0)
+                dst[len++]      = '-';
+            while (n > 0)
+                dst[len++]      = buf[--n];
+            return len;
+        }
+
+        // Build the specification for the single argument without calling snprintf()
+        static void build_spec(char *dst, const spec_t *spec, int width, int precision, const char *length)
+        {
+            size_t n        = 0;
+            dst[n++]        = '%';
+            const size_t nflags = lsp_min(spec->nflags, size_t(8));
+            memcpy(&dst[n], spec->flags, nflags);
+            n              += nflags;
+            if ((spec->width_arg) || (spec->width >= 0))
+                n              += put_int(&dst[n], width);
+            if (precision >= 0)
+            {
+                dst[n++]        = '.';
+                n              += put_int(&dst[n], precision);
+            }
+            for ( ; *length != '\0'; ++length)
+                dst[n++]        = *length;
+            dst[n++]        = spec->conv;
+            dst[n]          = '\0';
+        }
+
+        DeferredLog::DeferredLog()
+        {
+            vRings          = NULL;
+            nRings          = 0;
+            nRingSize       = 0;
+            pData           = NULL;
+            nGeneration     = 0;
+            nUnowned        = 0;
+            nWritten        = 0;
+            pWriter         = default_writer;
+            pWriterArg      = this;
+            for (size_t i=0; i<4; ++i)
+                vTypes[i]       = 0;
+            sMessage[0]     = '\0';
+
+            sLog.handle     = this;
+            sLog.printf     = do_printf;
+            sLog.vprintf    = do_vprintf;
+            sFeature.URI    = LV2_LOG__log;
+            sFeature.data   = &sLog;
+        }
+
+        DeferredLog::~DeferredLog()
+        {
+            destroy();
+        }
+
+        status_t DeferredLog::init(const LV2_URID_Map *map, size_t threads, size_t ring_size)
+        {
+            unsafe_call();
+            if ((threads <= 0) || (threads > 0x400) || (ring_size < 0x100) || (ring_size >= 0x80000000U))
+                return STATUS_BAD_ARGUMENTS;
+
+            static const uri_t uris[] = { URI_LOG__Error, URI_LOG__Warning, URI_LOG__Note, URI_LOG__Trace };
+            LV2_URID types[4];
+            status_t res = map_uris(types, uris, 4, map);
+            if (res != STATUS_OK)
+                return res;
+
+            // Allocate ring descriptors and ring buffers in one chunk
+            ring_size           = align8(ring_size);
+            uint8_t *data       = NULL;
+            uint8_t *ptr        = alloc_aligned<uint8_t>(data, threads * (sizeof(ring_t) + ring_size), 64);
+            if (ptr == NULL)
+                return STATUS_NO_MEM;
+
+            destroy();
+
+            pData               = data;
+            vRings              = reinterpret_cast<ring_t *>(ptr);
+            ptr                += threads * sizeof(ring_t);
+            for (size_t i=0; i<threads; ++i)
+            {
+                ring_t *r           = &vRings[i];
+                r->owner            = 0;
+                r->head             = 0;
+                r->tail             = 0;
+                r->dropped          = 0;
+                r->data             = ptr;
+                ptr                += ring_size;
+            }
+
+            nRings              = threads;
+            nRingSize           = uint32_t(ring_size);
+            nGeneration         = atomic_add(&log_generation, size_t(1)) + 1;
+            for (size_t i=0; i<4; ++i)
+                vTypes[i]           = types[i];
+
+            return STATUS_OK;
+        }
+
+        void DeferredLog::destroy()
+        {
+            unsafe_call();
+            free_aligned(pData);
+            vRings          = NULL;
+            nRings          = 0;
+            nRingSize       = 0;
+            nGeneration     = 0;
+            nUnowned        = 0;
+            nWritten        = 0;
+        }
+
+        void DeferredLog::set_writer(writer_t writer, void *arg)
+        {
+            pWriter         = (writer != NULL) ? writer : default_writer;
+            pWriterArg      = (writer != NULL) ? arg : this;
+        }
+
+        void DeferredLog::default_writer(void *arg, LV2_URID type, const char *message)
+        {
+            static const char * const prefixes[] = { "ERROR", "WARNING", "NOTE", "TRACE" };
+
+            const DeferredLog *self = static_cast<const DeferredLog *>(arg);
+            const char *prefix  = "LOG";
+            for (size_t i=0; i<4; ++i)
+                if (self->vTypes[i] == type)
+                {
+                    prefix              = prefixes[i];
+                    break;
+                }
+
+            fprintf(stderr, "[%s] %s", prefix, message);
+        }
+
+        int DeferredLog::do_printf(LV2_Log_Handle handle, LV2_URID type, const char *fmt, ...)
+        {
+            va_list ap;
+            va_start(ap, fmt);
+            const int res = static_cast<DeferredLog *>(handle)->vprintf(type, fmt, ap);
+            va_end(ap);
+            return res;
+        }
+
+        int DeferredLog::do_vprintf(LV2_Log_Handle handle, LV2_URID type, const char *fmt, va_list ap)
+        {
+            return static_cast<DeferredLog *>(handle)->vprintf(type, fmt, ap);
+        }
+
+        int DeferredLog::printf(LV2_URID type, const char *fmt, ...)
+        {
+            va_list ap;
+            va_start(ap, fmt);
+            const int res = vprintf(type, fmt, ap);
+            va_end(ap);
+            return res;
+        }
+
+        DeferredLog::ring_t *DeferredLog::thread_ring()
+        {
+            if ((tls_ring.log == this) && (tls_ring.generation == nGeneration))
+                return static_cast<ring_t *>(tls_ring.ring);
+
+            // Find the ring owned by the thread or claim the free one
+            const uintptr_t id  = uintptr_t(&tls_marker);
+            ring_t *ring        = NULL;
+            for (size_t i=0; (i<nRings) && (ring == NULL); ++i)
+                if (atomic_load(&vRings[i].owner) == id)
+                    ring                = &vRings[i];
+            for (size_t i=0; (i<nRings) && (ring == NULL); ++i)
+                if (atomic_cas(&vRings[i].owner, uintptr_t(0), id))
+                    ring                = &vRings[i];
+            if (ring == NULL)
+                return NULL;
+
+            tls_ring.log        = this;
+            tls_ring.generation = nGeneration;
+            tls_ring.ring       = ring;
+
+            return ring;
+        }
+
+        void DeferredLog::release_thread()
+        {
+            const uintptr_t id  = uintptr_t(&tls_marker);
+            for (size_t i=0; i<nRings; ++i)
+            {
+                ring_t *r           = &vRings[i];
+                if (atomic_load(&r->owner) == id)
+                    atomic_store(&r->owner, uintptr_t(0));
+            }
+
+            if (tls_ring.log == this)
+                tls_ring.log        = NULL;
+        }
+
+        int DeferredLog::vprintf(LV2_URID type, const char *fmt, va_list ap)
+        {
+            if ((fmt == NULL) || (vRings == NULL))
+                return -1;
+
+            ring_t *r           = thread_ring();
+            if (r == NULL)
+            {
+                atomic_add(&nUnowned, size_t(1));
+                return -1;
+            }
+
+            // Capture the message on the stack
+            uint64_t buf[MAX_RECORD / sizeof(uint64_t)];
+            va_list args;
+            va_copy(args, ap);
+            const uint32_t size = uint32_t(capture(reinterpret_cast<uint8_t *>(buf), type, fmt, &args));
+            va_end(args);
+
+            // The ring buffer is never filled completely, so equal positions mean the empty buffer
+            const uint32_t tail = atomic_load(&r->tail);
+            const uint32_t head = r->head;
+            uint32_t pos        = nRingSize;
+
+            if (head >= tail)
+            {
+                const uint32_t avail = nRingSize - head;
+                if ((size < avail) || ((size == avail) && (tail > 0)))
+                    pos             = head;
+                else if (size < tail)
+                {
+                    // Mark the rest of the buffer as unused and write to the beginning
+                    reinterpret_cast<record_t *>(&r->data[head])->size = 0;
+                    pos             = 0;
+                }
+            }
+            else if (size < tail - head)
+                pos             = head;
+
+            if (pos >= nRingSize)
+            {
+                atomic_add(&r->dropped, size_t(1));
+                return -1;
+            }
+
+            memcpy(&r->data[pos], buf, size);
+            pos                += size;
+            atomic_store(&r->head, (pos >= nRingSize) ? uint32_t(0) : pos);
+
+            return 0;
+        }
+
+        void DeferredLog::format(const uint8_t *data)
+        {
+            const record_t *rec = reinterpret_cast<const record_t *>(data);
+            const slot_t *slots = reinterpret_cast<const slot_t *>(&data[RECORD_HEADER]);
+            const char *strings = reinterpret_cast<const char *>(&data[RECORD_HEADER + rec->args * sizeof(slot_t)]);
+            const size_t cap    = MAX_MESSAGE;
+            char *dst           = sMessage;
+            size_t len          = 0;
+            size_t arg          = 0;
+            char fmt[0x40];
+            spec_t spec;
+
+            for (const char *s = rec->format; (*s != '\0') && (len < cap - 1); )
+            {
+                // Copy the literal text
+                const char *p       = strchr(s, '%');
+                const size_t count  = lsp_min((p != NULL) ? size_t(p - s) : strlen(s), cap - 1 - len);
+                memcpy(&dst[len], s, count);
+                len                += count;
+                if (p == NULL)
+                    break;
+
+                // Copy the invalid specification as is
+                if (!parse_spec(&spec, p))
+                {
+                    append(dst, &len, cap, snprintf(&dst[len], cap - len, "%s", p));
+                    break;
+                }
+                s                   = spec.end;
+
+                if (spec.conv == '%')
+                {
+                    if (len < cap - 1)
+                        dst[len++]          = '%';
+                    continue;
+                }
+                if (spec.conv == 'n')
+                    continue;
+
+                // Arguments which have not been captured
+                const size_t need   = size_t(spec.width_arg) + size_t(spec.precision_arg) + 1;
+                if (arg + need > rec->args)
+                {
+                    append(dst, &len, cap, snprintf(&dst[len], cap - len, "%.*s", int(spec.end - spec.begin), spec.begin));
+                    continue;
+                }
+
+                // Build the specification for the single argument
+                const int width     = (spec.width_arg) ? int(lsp_limit(slots[arg++].i, -int64_t(cap), int64_t(cap))) : spec.width;
+                const int precision = (spec.precision_arg) ? int(lsp_limit(slots[arg++].i, -1, int64_t(cap))) : spec.precision;
+                const slot_t *v     = &slots[arg++];
+                const char *length  = "";
+
+                switch (spec.conv)
+                {
+                    case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+                        length              = "ll";
+                        break;
+                    default:
+                        break;
+                }
+
+                // Plain strings do not need formatting
+                if ((spec.conv == 's') && (spec.nflags == 0) && (!spec.width_arg) && (spec.width < 0) && (precision < 0))
+                {
+                    const char *str     = (v->u != STRING_NULL) ? &strings[v->u] : "(null)";
+                    const size_t count  = lsp_min(strlen(str), cap - 1 - len);
+                    memcpy(&dst[len], str, count);
+                    len                += count;
+                    continue;
+                }
+
+                build_spec(fmt, &spec, width, precision, length);
+
+                switch (spec.conv)
+                {
+                    case 'd': case 'i':
+                        append(dst, &len, cap, snprintf(&dst[len], cap - len, fmt, static_cast<long long>(v->i)));
+                        break;
+                    case 'u': case 'o': case 'x': case 'X':
+                        append(dst, &len, cap, snprintf(&dst[len], cap - len, fmt, static_cast<unsigned long long>(v->u)));
+                        break;
+                    case 'c':
+                        append(dst, &len, cap, snprintf(&dst[len], cap - len, fmt, int(v->i)));
+                        break;
+                    case 'p':
+                        append(dst, &len, cap, snprintf(&dst[len], cap - len, fmt, reinterpret_cast<void *>(uintptr_t(v->u))));
+                        break;
+                    case 's':
+                        append(dst, &len, cap, snprintf(&dst[len], cap - len, fmt, (v->u != STRING_NULL) ? &strings[v->u] : "(null)"));
+                        break;
+                    default:
+                        append(dst, &len, cap, snprintf(&dst[len], cap - len, fmt, v->d));
+                        break;
+                }
+            }
+
+            dst[len]            = '\0';
+            pWriter(pWriterArg, rec->type, dst);
+        }
+
+        size_t DeferredLog::drain(ring_t *r)
+        {
+            const uint32_t head = atomic_load(&r->head);
+            uint32_t pos        = r->tail;
+            size_t count        = 0;
+
+            while (pos != head)
+            {
+                const record_t *rec = reinterpret_cast<const record_t *>(&r->data[pos]);
+                if (rec->size == 0)
+                {
+                    pos                 = 0;
+                    continue;
+                }
+
+                format(&r->data[pos]);
+                ++count;
+
+                pos                += rec->size;
+                if (pos >= nRingSize)
+                    pos                 = 0;
+                atomic_store(&r->tail, pos);
+            }
+
+            atomic_store(&r->tail, pos);
+            return count;
+        }
+
+        size_t DeferredLog::drain()
+        {
+            unsafe_call();
+
+            size_t count = 0;
+            for (size_t i=0; i<nRings; ++i)
+                count      += drain(&vRings[i]);
+
+            if (count > 0)
+                atomic_add(&nWritten, count);
+
+            return count;
+        }
+
+        size_t DeferredLog::dropped() const
+        {
+            size_t count = atomic_load(&nUnowned);
+            for (size_t i=0; i<nRings; ++i)
+                count      += atomic_load(&vRings[i].dropped);
+            return count;
+        }
+
+        #ifdef LSP_TESTING
+        size_t DeferredLog::thread_unsafe_calls()
+        {
+            return tls_unsafe_calls;
+        }
+        #endif /* LSP_TESTING */
+    } /* namespace lv2 */
+} /* namespace lsp */
@@ -0,0 +1,345 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/EventConverter.h>
+#include <lsp-plug.in/3rdparty/lv2/uris.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <lv2/atom/util.h>
+
+LV2_DISABLE_DEPRECATION_WARNINGS
+
+namespace lsp
+{
+    namespace lv2
+    {
+        namespace
+        {
+            static constexpr double SUBFRAMES       = 4294967296.0;     // Number of sub-frames per frame
+
+            inline uint32_t event_pad_size(uint32_t size)
+            {
+                return (size + 7) & (~7U);
+            }
+        } /* namespace */
+
+        EventConverter::EventConverter()
+        {
+            vUrids          = NULL;
+            nEventTypes     = 0;
+            vTypes          = NULL;
+            nMask           = 0;
+            nTypes          = 0;
+            pMap            = NULL;
+            pUriMap         = NULL;
+            nBeatTime       = 0;
+            fFramesPerBeat  = 0.0;
+        }
+
+        EventConverter::~EventConverter()
+        {
+            destroy();
+        }
+
+        void EventConverter::destroy()
+        {
+            if (vUrids != NULL)
+            {
+                free(vUrids);
+                vUrids          = NULL;
+            }
+            if (vTypes != NULL)
+            {
+                free(vTypes);
+                vTypes          = NULL;
+            }
+
+            nEventTypes     = 0;
+            nMask           = 0;
+            nTypes          = 0;
+            pMap            = NULL;
+            pUriMap         = NULL;
+            nBeatTime       = 0;
+        }
+
+        status_t EventConverter::init(const LV2_URID_Map *map, const LV2_URI_Map_Feature *uri_map)
+        {
+            if ((map == NULL) || (map->map == NULL) || (uri_map == NULL) || (uri_map->uri_to_id == NULL))
+                return STATUS_BAD_ARGUMENTS;
+
+            destroy();
+            pMap            = map;
+            pUriMap         = uri_map;
+            nBeatTime       = map->map(map->handle, uri_string(URI_ATOM__beatTime));
+
+            return rehash(8);
+        }
+
+        status_t EventConverter::rehash(size_t size)
+        {
+            type_t *types   = static_cast<type_t *>(malloc(size * sizeof(type_t)));
+            if (types == NULL)
+                return STATUS_NO_MEM;
+            for (size_t i=0; i<size; ++i)
+            {
+                types[i].urid   = 0;
+                types[i].type   = 0;
+            }
+
+            const size_t mask = size - 1;
+            for (size_t i=0; i<=nMask; ++i)
+            {
+                const type_t *t = &vTypes[i];
+                if ((vTypes == NULL) || (t->urid == 0))
+                    continue;
+
+                size_t index    = t->urid & mask;
+                while (types[index].urid != 0)
+                    index           = (index + 1) & mask;
+                types[index]    = *t;
+            }
+
+            if (vTypes != NULL)
+                free(vTypes);
+            vTypes          = types;
+            nMask           = mask;
+
+            return STATUS_OK;
+        }
+
+        uint32_t EventConverter::event_type(LV2_URID urid) const
+        {
+            for (size_t index = urid & nMask; ; index = (index + 1) & nMask)
+            {
+                const type_t *t = &vTypes[index];
+                if (t->urid == urid)
+                    return t->type;
+                if (t->urid == 0)
+                    return 0;
+            }
+        }
+
+        status_t EventConverter::add_type(const char *uri)
+        {
+            if (uri == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            if (vTypes == NULL)
+                return STATUS_BAD_STATE;
+
+            // Map URI with both features
+            const LV2_URID urid = pMap->map(pMap->handle, uri);
+            const uint32_t type = pUriMap->uri_to_id(pUriMap->callback_data, LV2_EVENT_URI, uri);
+            if ((urid == 0) || (type == 0))
+                return STATUS_NOT_FOUND;
+            if (type > UINT16_MAX)
+                return STATUS_OVERFLOW;
+            if (event_type(urid) != 0)
+                return STATUS_OK;
+
+            // Extend the table of URIDs
+            if (type >= nEventTypes)
+            {
+                LV2_URID *urids = static_cast<LV2_URID *>(realloc(vUrids, (type + 1) * sizeof(LV2_URID)));
+                if (urids == NULL)
+                    return STATUS_NO_MEM;
+                for (size_t i=nEventTypes; i<=type; ++i)
+                    urids[i]        = 0;
+                vUrids          = urids;
+                nEventTypes     = type + 1;
+            }
+
+            // Keep the load factor of the hash table not greater than 0.5
+            if ((nTypes + 1) * 2 > nMask + 1)
+            {
+                const status_t res = rehash((nMask + 1) * 2);
+                if (res != STATUS_OK)
+                    return res;
+            }
+
+            size_t index    = urid & nMask;
+            while (vTypes[index].urid != 0)
+                index           = (index + 1) & nMask;
+            vTypes[index].urid  = urid;
+            vTypes[index].type  = type;
+            vUrids[type]        = urid;
+            ++nTypes;
+
+            return STATUS_OK;
+        }
+
+        status_t EventConverter::to_events(LV2_Event_Buffer *dst, const LV2_Atom_Sequence *src, size_t *dropped) const
+        {
+            const bool beats        = (nBeatTime != 0) && (src->body.unit == nBeatTime);
+            if ((vTypes == NULL) || ((beats) && (!(fFramesPerBeat > 0.0))))
+                return STATUS_BAD_STATE;
+
+            uint8_t *out            = dst->data;
+            const uint32_t capacity = dst->capacity;
+            uint32_t size           = 0;
+            uint32_t count          = 0;
+            size_t skipped          = 0;
+            status_t res            = STATUS_OK;
+            LV2_URID last_urid      = 0;        // Most recently translated URID, events usually are of the same type
+            uint32_t last_type      = 0;
+
+            LV2_ATOM_SEQUENCE_FOREACH(src, ev)
+            {
+                if (ev->body.type != last_urid)
+                {
+                    last_urid               = ev->body.type;
+                    last_type               = event_type(last_urid);
+                }
+                if ((last_type == 0) || (ev->body.size > UINT16_MAX))
+                {
+                    ++skipped;
+                    continue;
+                }
+                const uint32_t type     = last_type;
+
+                const uint32_t total    = sizeof(LV2_Event) + ev->body.size;
+                if ((size > capacity) || (capacity - size < total))
+                {
+                    res                     = STATUS_OVERFLOW;
+                    break;
+                }
+
+                LV2_Event *e            = reinterpret_cast<LV2_Event *>(&out[size]);
+                if (beats)
+                {
+                    const double frames     = ev->time.beats * fFramesPerBeat;
+                    if (frames >= double(UINT32_MAX))
+                    {
+                        e->frames               = UINT32_MAX;
+                        e->subframes            = 0;
+                    }
+                    else if (frames > 0.0)
+                    {
+                        e->frames               = uint32_t(frames);
+                        e->subframes            = uint32_t(lsp_min((frames - double(e->frames)) * SUBFRAMES, double(UINT32_MAX)));
+                    }
+                    else
+                    {
+                        e->frames               = 0;
+                        e->subframes            = 0;
+                    }
+                }
+                else
+                {
+                    e->frames               = uint32_t(lsp_limit(ev->time.frames, int64_t(0), int64_t(UINT32_MAX)));
+                    e->subframes            = 0;
+                }
+                e->type                 = uint16_t(type);
+                e->size                 = uint16_t(ev->body.size);
+                memcpy(&e[1], LV2_ATOM_BODY_CONST(&ev->body), ev->body.size);
+
+                size                   += event_pad_size(total);
+                ++count;
+            }
+
+            dst->header_size        = sizeof(LV2_Event_Buffer);
+            dst->stamp_type         = LV2_EVENT_AUDIO_STAMP;
+            dst->event_count        = count;
+            dst->size               = size;
+            if (dropped != NULL)
+                *dropped                = skipped;
+
+            return res;
+        }
+
+        status_t EventConverter::to_sequence(
+            LV2_Atom_Sequence *dst, uint32_t capacity,
+            const LV2_Event_Buffer *src, LV2_URID unit, size_t *dropped) const
+        {
+            const bool beats        = (nBeatTime != 0) && (unit == nBeatTime);
+            if ((vTypes == NULL) || ((beats) && (!(fFramesPerBeat > 0.0))))
+                return STATUS_BAD_STATE;
+            if (src->stamp_type != LV2_EVENT_AUDIO_STAMP)
+                return STATUS_UNSUPPORTED_FORMAT;
+            if (capacity < sizeof(LV2_Atom_Sequence_Body))
+                return STATUS_OVERFLOW;
+
+            const double kbeat      = (beats) ? 1.0 / fFramesPerBeat : 0.0;
+            const uint8_t *data     = src->data;
+            const uint32_t limit    = lsp_min(src->size, src->capacity);
+            uint8_t *out            = reinterpret_cast<uint8_t *>(&dst->body);
+            uint32_t size           = sizeof(LV2_Atom_Sequence_Body);
+            uint32_t offset         = 0;
+            size_t skipped          = 0;
+            status_t res            = STATUS_OK;
+
+            dst->body.unit          = unit;
+            dst->body.pad           = 0;
+
+            for (uint32_t i=0; i<src->event_count; ++i)
+            {
+                // Validate the event
+                if ((offset > limit) || (limit - offset < sizeof(LV2_Event)))
+                {
+                    res                     = STATUS_CORRUPTED;
+                    break;
+                }
+                const LV2_Event *e      = reinterpret_cast<const LV2_Event *>(&data[offset]);
+                if (limit - offset - sizeof(LV2_Event) < e->size)
+                {
+                    res                     = STATUS_CORRUPTED;
+                    break;
+                }
+                offset                 += event_pad_size(sizeof(LV2_Event) + e->size);
+
+                // Translate the type
+                const LV2_URID urid     = (e->type < nEventTypes) ? vUrids[e->type] : 0;
+                if (urid == 0)
+                {
+                    ++skipped;
+                    continue;
+                }
+
+                const uint32_t total    = sizeof(LV2_Atom_Event) + e->size;
+                if ((size > capacity) || (capacity - size < total))
+                {
+                    res                     = STATUS_OVERFLOW;
+                    break;
+                }
+
+                LV2_Atom_Event *ev      = reinterpret_cast<LV2_Atom_Event *>(&out[size]);
+                if (beats)
+                    ev->time.beats          = (double(e->frames) + double(e->subframes) / SUBFRAMES) * kbeat;
+                else
+                    ev->time.frames         = e->frames;
+                ev->body.type           = urid;
+                ev->body.size           = e->size;
+                memcpy(LV2_ATOM_BODY(&ev->body), &e[1], e->size);
+
+                size                   += lv2_atom_pad_size(total);
+            }
+
+            dst->atom.size          = size;
+            if (dropped != NULL)
+                *dropped                = skipped;
+
+            return res;
+        }
+
+    } /* namespace lv2 */
+} /* namespace lsp */
+
+LV2_RESTORE_WARNINGS
@@ -0,0 +1,393 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/PortEventBatcher.h>
+#include <lsp-plug.in/3rdparty/lv2/uris.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        constexpr uint32_t PortEventBatcher::WRAP_MARKER;
+
+        // Sets the bits of the word and returns the previous value of the word
+        static inline uint64_t atomic_set_bits(uint64_t *word, uint64_t bits)
+        {
+            uint64_t old = atomic_load(word);
+            while (!atomic_cas(word, old, old | bits))
+                old         = atomic_load(word);
+            return old;
+        }
+
+        // Clears the bits of the word and returns the previous value of the word
+        static inline uint64_t atomic_clear_bits(uint64_t *word, uint64_t bits)
+        {
+            uint64_t old = atomic_load(word);
+            while (!atomic_cas(word, old, old & (~bits)))
+                old         = atomic_load(word);
+            return old;
+        }
+
+        static inline uint32_t record_size(uint32_t atom_size)
+        {
+            return (2 * sizeof(uint32_t) + sizeof(LV2_Atom) + atom_size + 7) & ~uint32_t(7);
+        }
+
+        PortEventBatcher::PortEventBatcher()
+        {
+            nPorts                  = 0;
+            nWords                  = 0;
+            vValues                 = NULL;
+            vDirty                  = NULL;
+            vSubscribed             = NULL;
+            vFirst                  = NULL;
+            vLast                   = NULL;
+            vTouched                = NULL;
+            pRing                   = NULL;
+            nRingSize               = 0;
+            nHead                   = 0;
+            nTail                   = 0;
+            nEventTransfer          = 0;
+            nFloatProtocol          = 0;
+            nDelivered              = 0;
+            nDropped                = 0;
+            nDiscarded              = 0;
+            nCoalesced              = 0;
+
+            sSubscribe.handle       = this;
+            sSubscribe.subscribe    = do_subscribe;
+            sSubscribe.unsubscribe  = do_unsubscribe;
+            sFeature.URI            = LV2_UI__portSubscribe;
+            sFeature.data           = &sSubscribe;
+        }
+
+        PortEventBatcher::~PortEventBatcher()
+        {
+            destroy();
+        }
+
+        void PortEventBatcher::destroy()
+        {
+            // Bitmaps and port arrays are allocated as a single chunk
+            if (vDirty != NULL)
+            {
+                free(vDirty);
+                vDirty                  = NULL;
+            }
+            if (pRing != NULL)
+            {
+                free(pRing);
+                pRing                   = NULL;
+            }
+
+            nPorts                  = 0;
+            nWords                  = 0;
+            vValues                 = NULL;
+            vSubscribed             = NULL;
+            vFirst                  = NULL;
+            vLast                   = NULL;
+            vTouched                = NULL;
+            nRingSize               = 0;
+            nHead                   = 0;
+            nTail                   = 0;
+            nDelivered              = 0;
+            nDropped                = 0;
+            nDiscarded              = 0;
+            nCoalesced              = 0;
+        }
+
+        status_t PortEventBatcher::init(size_t ports, size_t atom_capacity, const LV2_URID_Map *map)
+        {
+            if ((ports <= 0) || (ports >= 0x80000000U) || (atom_capacity >= 0x80000000U))
+                return STATUS_BAD_ARGUMENTS;
+            if ((map == NULL) || (map->map == NULL))
+                return STATUS_BAD_ARGUMENTS;
+
+            static const uri_t uris[] = { URI_ATOM__eventTransfer, URI_UI__floatProtocol };
+            LV2_URID urids[2];
+            status_t res = map_uris(urids, uris, 2, map);
+            if (res != STATUS_OK)
+                return res;
+
+            // Allocate all per-port data in one chunk
+            const size_t words      = (ports + 63) >> 6;
+            const size_t szof_bits  = words * sizeof(uint64_t);
+            const size_t szof_ports = ((ports * sizeof(uint32_t) + sizeof(uint64_t) - 1) / sizeof(uint64_t)) * sizeof(uint64_t);
+            uint8_t *ptr            = static_cast<uint8_t *>(malloc(szof_bits * 2 + szof_ports * 4));
+            if (ptr == NULL)
+                return STATUS_NO_MEM;
+
+            const size_t ring_size  = (atom_capacity + 7) & ~size_t(7);
+            uint8_t *ring           = NULL;
+            if (ring_size > 0)
+            {
+                ring                    = static_cast<uint8_t *>(malloc(ring_size));
+                if (ring == NULL)
+                {
+                    free(ptr);
+                    return STATUS_NO_MEM;
+                }
+            }
+
+            destroy();
+
+            vDirty                  = reinterpret_cast<uint64_t *>(ptr);
+            ptr                    += szof_bits;
+            vSubscribed             = reinterpret_cast<uint64_t *>(ptr);
+            ptr                    += szof_bits;
+            vValues                 = reinterpret_cast<uint32_t *>(ptr);
+            ptr                    += szof_ports;
+            vFirst                  = reinterpret_cast<uint32_t *>(ptr);
+            ptr                    += szof_ports;
+            vLast                   = reinterpret_cast<uint32_t *>(ptr);
+            ptr                    += szof_ports;
+            vTouched                = reinterpret_cast<uint32_t *>(ptr);
+
+            memset(vDirty, 0, szof_bits * 2);
+            memset(vValues, 0, szof_ports * 4);
+
+            nPorts                  = ports;
+            nWords                  = words;
+            pRing                   = ring;
+            nRingSize               = uint32_t(ring_size);
+            nEventTransfer          = urids[0];
+            nFloatProtocol          = urids[1];
+
+            return STATUS_OK;
+        }
+
+        uint32_t PortEventBatcher::do_subscribe(LV2UI_Feature_Handle handle, uint32_t port, uint32_t protocol, const LV2_Feature * const *features)
+        {
+            PortEventBatcher *self = static_cast<PortEventBatcher *>(handle);
+            if ((protocol != self->nFloatProtocol) && (protocol != self->nEventTransfer))
+                return 1;
+            return (self->subscribe(port, true) == STATUS_OK) ? 0 : 1;
+        }
+
+        uint32_t PortEventBatcher::do_unsubscribe(LV2UI_Feature_Handle handle, uint32_t port, uint32_t protocol, const LV2_Feature * const *features)
+        {
+            PortEventBatcher *self = static_cast<PortEventBatcher *>(handle);
+            if ((protocol != self->nFloatProtocol) && (protocol != self->nEventTransfer))
+                return 1;
+            return (self->subscribe(port, false) == STATUS_OK) ? 0 : 1;
+        }
+
+        status_t PortEventBatcher::subscribe(uint32_t port, bool subscribe)
+        {
+            if (port >= nPorts)
+                return STATUS_INVALID_VALUE;
+
+            const uint64_t bit  = uint64_t(1) << (port & 0x3f);
+            if (subscribe)
+                atomic_set_bits(&vSubscribed[port >> 6], bit);
+            else
+                atomic_clear_bits(&vSubscribed[port >> 6], bit);
+
+            return STATUS_OK;
+        }
+
+        bool PortEventBatcher::subscribed(uint32_t port) const
+        {
+            if (port >= nPorts)
+                return false;
+            return atomic_load(&vSubscribed[port >> 6]) & (uint64_t(1) << (port & 0x3f));
+        }
+
+        bool PortEventBatcher::write_control(uint32_t port, float value)
+        {
+            if (!subscribed(port))
+            {
+                atomic_add(&nDropped, size_t(1));
+                return false;
+            }
+
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            atomic_store(&vValues[port], bits);
+
+            // The previous value has not been delivered yet
+            const uint64_t bit  = uint64_t(1) << (port & 0x3f);
+            if (atomic_set_bits(&vDirty[port >> 6], bit) & bit)
+                atomic_add(&nCoalesced, size_t(1));
+
+            return true;
+        }
+
+        bool PortEventBatcher::write_atom(uint32_t port, const LV2_Atom *atom)
+        {
+            if ((atom == NULL) || (!subscribed(port)))
+            {
+                atomic_add(&nDropped, size_t(1));
+                return false;
+            }
+
+            // The ring buffer is never filled completely, so equal positions mean the empty buffer
+            const uint32_t tail = atomic_load(&nTail);
+            const uint32_t size = (atom->size < nRingSize) ? record_size(atom->size) : nRingSize;
+            uint32_t head       = nHead;
+            uint32_t pos;
+
+            if (head >= tail)
+            {
+                const uint32_t avail = nRingSize - head;
+                if ((size < avail) || ((size == avail) && (tail > 0)))
+                    pos             = head;
+                else if (size < tail)
+                {
+                    // Mark the rest of the buffer as unused and write to the beginning
+                    if (avail > 0)
+                        reinterpret_cast<record_t *>(&pRing[head])->port = WRAP_MARKER;
+                    pos             = 0;
+                }
+                else
+                    pos             = nRingSize;
+            }
+            else
+                pos             = (size < tail - head) ? head : nRingSize;
+
+            if (pos >= nRingSize)
+            {
+                atomic_add(&nDropped, size_t(1));
+                return false;
+            }
+
+            record_t *rec       = reinterpret_cast<record_t *>(&pRing[pos]);
+            rec->port           = port;
+            rec->next           = 0;
+            memcpy(&rec->atom, atom, sizeof(LV2_Atom) + atom->size);
+
+            head                = pos + size;
+            if (head >= nRingSize)
+                head                = 0;
+            atomic_store(&nHead, head);
+
+            return true;
+        }
+
+        size_t PortEventBatcher::flush_controls(const LV2UI_Descriptor *ui, LV2UI_Handle handle)
+        {
+            size_t delivered = 0, dropped = 0;
+
+            for (size_t i=0; i<nWords; ++i)
+            {
+                if (atomic_load(&vDirty[i]) == 0)
+                    continue;
+
+                uint64_t bits       = atomic_swap(&vDirty[i], uint64_t(0));
+                const uint64_t subs = atomic_load(&vSubscribed[i]);
+                dropped            += __builtin_popcountll(bits & ~subs);
+                bits               &= subs;
+
+                for ( ; bits != 0; bits &= bits - 1)
+                {
+                    const uint32_t port = uint32_t((i << 6) + __builtin_ctzll(bits));
+                    const uint32_t raw  = atomic_load(&vValues[port]);
+                    float value;
+                    memcpy(&value, &raw, sizeof(value));
+
+                    ui->port_event(handle, port, sizeof(float), 0, &value);
+                    ++delivered;
+                }
+            }
+
+            if (dropped > 0)
+                atomic_add(&nDiscarded, dropped);
+
+            return delivered;
+        }
+
+        size_t PortEventBatcher::flush_atoms(const LV2UI_Descriptor *ui, LV2UI_Handle handle)
+        {
+            const uint32_t head = atomic_load(&nHead);
+            uint32_t pos        = nTail;
+            if (pos == head)
+                return 0;
+
+            // Link records of each port into the list
+            size_t touched = 0, dropped = 0;
+            while (pos != head)
+            {
+                record_t *rec       = reinterpret_cast<record_t *>(&pRing[pos]);
+                if (rec->port == WRAP_MARKER)
+                {
+                    pos                 = 0;
+                    continue;
+                }
+
+                const uint32_t port = rec->port;
+                if (subscribed(port))
+                {
+                    if (vFirst[port] == 0)
+                    {
+                        vFirst[port]        = pos + 1;
+                        vTouched[touched++] = port;
+                    }
+                    else
+                        reinterpret_cast<record_t *>(&pRing[vLast[port] - 1])->next = pos + 1;
+                    vLast[port]         = pos + 1;
+                }
+                else
+                    ++dropped;
+
+                pos                += record_size(rec->atom.size);
+                if (pos >= nRingSize)
+                    pos                 = 0;
+            }
+
+            // Deliver atoms port by port
+            size_t delivered = 0;
+            for (size_t i=0; i<touched; ++i)
+            {
+                const uint32_t port = vTouched[i];
+                for (uint32_t off = vFirst[port]; off != 0; )
+                {
+                    const record_t *rec = reinterpret_cast<const record_t *>(&pRing[off - 1]);
+                    ui->port_event(handle, port, sizeof(LV2_Atom) + rec->atom.size, nEventTransfer, &rec->atom);
+                    ++delivered;
+                    off                 = rec->next;
+                }
+                vFirst[port]        = 0;
+                vLast[port]         = 0;
+            }
+
+            atomic_store(&nTail, head);
+            if (dropped > 0)
+                atomic_add(&nDiscarded, dropped);
+
+            return delivered;
+        }
+
+        size_t PortEventBatcher::flush(const LV2UI_Descriptor *ui, LV2UI_Handle handle)
+        {
+            if ((ui == NULL) || (ui->port_event == NULL) || (vDirty == NULL))
+                return 0;
+
+            const size_t delivered = flush_controls(ui, handle) + flush_atoms(ui, handle);
+            if (delivered > 0)
+                atomic_add(&nDelivered, delivered);
+
+            return delivered;
+        }
+
+    } /* namespace lv2 */
+} /* namespace lsp */
@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/ResizePortHost.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <lv2/atom/atom.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        ResizePortHost::ResizePortHost()
+        {
+            pPool           = NULL;
+            vPorts          = NULL;
+            nPorts          = 0;
+            pDescriptor     = NULL;
+            hInstance       = NULL;
+            nResizes        = 0;
+            nFailures       = 0;
+
+            sResize.data    = this;
+            sResize.resize  = do_resize;
+            sFeature.URI    = LV2_RESIZE_PORT__resize;
+            sFeature.data   = &sResize;
+        }
+
+        ResizePortHost::~ResizePortHost()
+        {
+            destroy();
+        }
+
+        status_t ResizePortHost::init(ResizePortPool *pool)
+        {
+            if (pool == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            destroy();
+            pPool           = pool;
+
+            return STATUS_OK;
+        }
+
+        void ResizePortHost::destroy()
+        {
+            if (vPorts != NULL)
+            {
+                for (size_t i=0; i<nPorts; ++i)
+                {
+                    port_t *p       = &vPorts[i];
+                    if (p->host != p->buffer)
+                        pPool->release(p->host);
+                    pPool->release(p->buffer);
+                }
+                free(vPorts);
+                vPorts          = NULL;
+            }
+
+            pPool           = NULL;
+            nPorts          = 0;
+            pDescriptor     = NULL;
+            hInstance       = NULL;
+            nResizes        = 0;
+            nFailures       = 0;
+        }
+
+        status_t ResizePortHost::add_port(uint32_t index, size_t min_size, bool atom)
+        {
+            if (pPool == NULL)
+                return STATUS_BAD_STATE;
+            if ((index < nPorts) && (vPorts[index].buffer != NULL))
+                return STATUS_ALREADY_EXISTS;
+
+            // Atom ports should be able to hold at least the sequence of default size
+            size_t size     = (atom) ? lsp_max(min_size, pPool->sequence_size()) : min_size;
+            size            = lsp_max(size, sizeof(LV2_Atom));
+            if (ResizePortPool::size_class(size) < 0)
+                return STATUS_TOO_BIG;
+
+            // Grow the port table
+            if (index >= nPorts)
+            {
+                port_t *ports   = static_cast<port_t *>(realloc(vPorts, (index + 1) * sizeof(port_t)));
+                if (ports == NULL)
+                    return STATUS_NO_MEM;
+                for (size_t i=nPorts; i<=index; ++i)
+                {
+                    port_t *p       = &ports[i];
+                    p->buffer       = NULL;
+                    p->host         = NULL;
+                    p->capacity     = 0;
+                    p->atom         = false;
+                }
+                vPorts          = ports;
+                nPorts          = index + 1;
+            }
+
+            // Acquire the buffer, allocate it if the pool is empty
+            size_t capacity = 0;
+            uint8_t *buf    = static_cast<uint8_t *>(pPool->acquire(size, &capacity));
+            if (buf == NULL)
+            {
+                status_t res    = pPool->reserve(size, 1);
+                if (res != STATUS_OK)
+                    return res;
+                buf             = static_cast<uint8_t *>(pPool->acquire(size, &capacity));
+                if (buf == NULL)
+                    return STATUS_NO_MEM;
+            }
+
+            // Initialize the atom as an empty one
+            if (atom)
+            {
+                LV2_Atom *a     = reinterpret_cast<LV2_Atom *>(buf);
+                a->size         = 0;
+                a->type         = 0;
+            }
+
+            port_t *p       = &vPorts[index];
+            p->buffer       = buf;
+            p->host         = buf;
+            p->capacity     = capacity;
+            p->atom         = atom;
+
+            if (hInstance != NULL)
+                pDescriptor->connect_port(hInstance, index, buf);
+
+            return STATUS_OK;
+        }
+
+        status_t ResizePortHost::bind(const LV2_Descriptor *descriptor, LV2_Handle instance)
+        {
+            if ((descriptor == NULL) || (descriptor->connect_port == NULL) || (instance == NULL))
+                return STATUS_BAD_ARGUMENTS;
+
+            pDescriptor     = descriptor;
+            hInstance       = instance;
+
+            for (size_t i=0; i<nPorts; ++i)
+            {
+                port_t *p       = &vPorts[i];
+                if (p->buffer != NULL)
+                    pDescriptor->connect_port(hInstance, i, p->buffer);
+            }
+
+            return STATUS_OK;
+        }
+
+        LV2_Resize_Port_Status ResizePortHost::do_resize(LV2_Resize_Port_Feature_Data data, uint32_t index, size_t size)
+        {
+            ResizePortHost *self = static_cast<ResizePortHost *>(data);
+            return self->resize(index, size);
+        }
+
+        LV2_Resize_Port_Status ResizePortHost::resize(uint32_t index, size_t size)
+        {
+            if (index >= nPorts)
+                return LV2_RESIZE_PORT_ERR_UNKNOWN;
+            port_t *p       = &vPorts[index];
+            if (p->buffer == NULL)
+                return LV2_RESIZE_PORT_ERR_UNKNOWN;
+            if (size <= p->capacity)
+                return LV2_RESIZE_PORT_SUCCESS;
+
+            size_t capacity = 0;
+            uint8_t *buf    = static_cast<uint8_t *>(pPool->acquire(size, &capacity));
+            if (buf == NULL)
+            {
+                ++nFailures;
+                return LV2_RESIZE_PORT_ERR_NO_SPACE;
+            }
+
+            // Copy only the meaningful part of the atom
+            size_t count    = p->capacity;
+            if (p->atom)
+            {
+                const LV2_Atom *a   = reinterpret_cast<const LV2_Atom *>(p->buffer);
+                count           = lsp_min(count, sizeof(LV2_Atom) + a->size);
+            }
+            memcpy(buf, p->buffer, count);
+
+            // The buffer has never been seen by the host, it can be returned immediately
+            if (p->buffer != p->host)
+                pPool->release(p->buffer);
+
+            p->buffer       = buf;
+            p->capacity     = capacity;
+            ++nResizes;
+
+            if (hInstance != NULL)
+                pDescriptor->connect_port(hInstance, index, buf);
+
+            return LV2_RESIZE_PORT_SUCCESS;
+        }
+
+        void ResizePortHost::end_cycle()
+        {
+            for (size_t i=0; i<nPorts; ++i)
+            {
+                port_t *p       = &vPorts[i];
+                if (p->host == p->buffer)
+                    continue;
+
+                pPool->release(p->host);
+                p->host         = p->buffer;
+            }
+        }
+
+    } /* namespace lv2 */
+} /* namespace lsp */
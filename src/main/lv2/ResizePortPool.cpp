@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/ResizePortPool.h>
+#include <lsp-plug.in/3rdparty/lv2/uris.h>
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        static constexpr uint32_t BLOCK_MAGIC       = 0x52535a50;   // 'RSZP'
+
+        constexpr size_t ResizePortPool::MIN_SHIFT;
+        constexpr size_t ResizePortPool::MAX_SHIFT;
+        constexpr size_t ResizePortPool::CLASSES;
+        constexpr size_t ResizePortPool::HEADER_SIZE;
+        constexpr size_t ResizePortPool::DEFAULT_SEQUENCE;
+        constexpr size_t ResizePortPool::DEFAULT_BLOCKS;
+
+        ResizePortPool::ResizePortPool()
+        {
+            vBlocks         = NULL;
+            nMaxBlocks      = 0;
+            nBlocks         = 0;
+            for (size_t i=0; i<CLASSES; ++i)
+            {
+                vHeads[i]       = 0;
+                vFree[i]        = 0;
+                vReserve[i]     = 0;
+            }
+            nMisses         = 0;
+            nAllocated      = 0;
+            nSequenceSize   = DEFAULT_SEQUENCE;
+        }
+
+        ResizePortPool::~ResizePortPool()
+        {
+            destroy();
+        }
+
+        void ResizePortPool::destroy()
+        {
+            if (vBlocks != NULL)
+            {
+                for (size_t i=0; i<nBlocks; ++i)
+                    free_aligned(vBlocks[i].data);
+                free(vBlocks);
+                vBlocks         = NULL;
+            }
+
+            nMaxBlocks      = 0;
+            nBlocks         = 0;
+            for (size_t i=0; i<CLASSES; ++i)
+            {
+                vHeads[i]       = 0;
+                vFree[i]        = 0;
+                vReserve[i]     = 0;
+            }
+            nMisses         = 0;
+            nAllocated      = 0;
+        }
+
+        status_t ResizePortPool::init(size_t sequence_size, size_t max_blocks)
+        {
+            if ((sequence_size < sizeof(uint64_t)) || (sequence_size > class_size(CLASSES - 1)))
+                return STATUS_BAD_ARGUMENTS;
+            if ((max_blocks <= 0) || (max_blocks >= 0x80000000U))
+                return STATUS_BAD_ARGUMENTS;
+
+            block_t *blocks = static_cast<block_t *>(malloc(max_blocks * sizeof(block_t)));
+            if (blocks == NULL)
+                return STATUS_NO_MEM;
+
+            destroy();
+            vBlocks         = blocks;
+            nMaxBlocks      = max_blocks;
+            nSequenceSize   = int32_t(sequence_size);
+
+            return STATUS_OK;
+        }
+
+        ssize_t ResizePortPool::size_class(size_t size)
+        {
+            if (size <= class_size(0))
+                return 0;
+            if (size > class_size(CLASSES - 1))
+                return -1;
+
+            size_t cls = 0;
+            for (size_t n = (size - 1) >> MIN_SHIFT; n > 0; n >>= 1)
+                ++cls;
+            return cls;
+        }
+
+        void ResizePortPool::push(size_t cls, uint32_t index)
+        {
+            while (true)
+            {
+                const uint64_t head = atomic_load(&vHeads[cls]);
+                atomic_store(&vBlocks[index].next, uint32_t(head));
+                const uint64_t next = (((head >> 32) + 1) << 32) | (index + 1);
+                if (atomic_cas(&vHeads[cls], head, next))
+                    break;
+            }
+
+            atomic_add(&vFree[cls], uint32_t(1));
+        }
+
+        ssize_t ResizePortPool::pop(size_t cls)
+        {
+            // The tag in the upper half of the head prevents ABA problem
+            uint32_t top;
+            while (true)
+            {
+                const uint64_t head = atomic_load(&vHeads[cls]);
+                top                 = uint32_t(head);
+                if (top == 0)
+                    return -1;
+                const uint64_t next = (((head >> 32) + 1) << 32) | atomic_load(&vBlocks[top - 1].next);
+                if (atomic_cas(&vHeads[cls], head, next))
+                    break;
+            }
+
+            atomic_add(&vFree[cls], uint32_t(-1));
+            return top - 1;
+        }
+
+        status_t ResizePortPool::allocate(size_t cls, size_t count)
+        {
+            if (vBlocks == NULL)
+                return STATUS_BAD_STATE;
+
+            const size_t size   = class_size(cls);
+            for (size_t i=0; i<count; ++i)
+            {
+                const uint32_t index    = nBlocks;
+                if (index >= nMaxBlocks)
+                    return STATUS_OVERFLOW;
+
+                block_t *b          = &vBlocks[index];
+                b->data             = NULL;
+                uint8_t *ptr        = alloc_aligned<uint8_t>(b->data, HEADER_SIZE + size, HEADER_SIZE);
+                if (ptr == NULL)
+                    return STATUS_NO_MEM;
+
+                header_t *hdr       = reinterpret_cast<header_t *>(ptr);
+                hdr->index          = index;
+                hdr->magic          = BLOCK_MAGIC;
+                b->buffer           = &ptr[HEADER_SIZE];
+                b->next             = 0;
+                b->cls              = uint32_t(cls);
+
+                atomic_store(&nBlocks, uint32_t(index + 1));
+                atomic_add(&nAllocated, size_t(size));
+                push(cls, index);
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t ResizePortPool::reserve(size_t size, size_t count)
+        {
+            const ssize_t cls   = size_class(size);
+            if (cls < 0)
+                return STATUS_TOO_BIG;
+
+            const size_t avail  = free_blocks(cls);
+            return (avail < count) ? allocate(cls, count - avail) : STATUS_OK;
+        }
+
+        status_t ResizePortPool::set_reserve(size_t size, size_t count)
+        {
+            const ssize_t cls   = size_class(size);
+            if (cls < 0)
+                return STATUS_TOO_BIG;
+
+            vReserve[cls]       = uint32_t(count);
+            return STATUS_OK;
+        }
+
+        status_t ResizePortPool::maintain()
+        {
+            for (size_t i=0; i<CLASSES; ++i)
+            {
+                const size_t avail  = free_blocks(i);
+                if (avail >= vReserve[i])
+                    continue;
+
+                const status_t res  = allocate(i, vReserve[i] - avail);
+                if (res != STATUS_OK)
+                    return res;
+            }
+
+            return STATUS_OK;
+        }
+
+        void *ResizePortPool::acquire(size_t size, size_t *capacity)
+        {
+            const ssize_t cls   = size_class(size);
+            if ((cls < 0) || (vBlocks == NULL))
+                return NULL;
+
+            // Use buffer of greater size class if there are no free buffers of the requested class
+            for (size_t i=cls; i<CLASSES; ++i)
+            {
+                const ssize_t index = pop(i);
+                if (index < 0)
+                    continue;
+
+                if (i != size_t(cls))
+                    atomic_add(&nMisses, uint32_t(1));
+                if (capacity != NULL)
+                    *capacity       = class_size(i);
+                return vBlocks[index].buffer;
+            }
+
+            atomic_add(&nMisses, uint32_t(1));
+            return NULL;
+        }
+
+        void ResizePortPool::release(void *buf)
+        {
+            if (buf == NULL)
+                return;
+
+            const header_t *hdr = reinterpret_cast<const header_t *>(static_cast<uint8_t *>(buf) - HEADER_SIZE);
+            if ((hdr->magic != BLOCK_MAGIC) || (hdr->index >= atomic_load(&nBlocks)))
+                return;
+
+            const block_t *b    = &vBlocks[hdr->index];
+            if (b->buffer == buf)
+                push(b->cls, hdr->index);
+        }
+
+        size_t ResizePortPool::capacity(const void *buf) const
+        {
+            const header_t *hdr = reinterpret_cast<const header_t *>(static_cast<const uint8_t *>(buf) - HEADER_SIZE);
+            return class_size(vBlocks[hdr->index].cls);
+        }
+
+        status_t ResizePortPool::sequence_size_option(LV2_Options_Option *opt, const LV2_URID_Map *map) const
+        {
+            if ((opt == NULL) || (map == NULL) || (map->map == NULL))
+                return STATUS_BAD_ARGUMENTS;
+
+            opt->context        = LV2_OPTIONS_INSTANCE;
+            opt->subject        = 0;
+            opt->key            = map->map(map->handle, uri_string(URI_BUF_SIZE__sequenceSize));
+            opt->size           = sizeof(nSequenceSize);
+            opt->type           = map->map(map->handle, uri_string(URI_ATOM__Int));
+            opt->value          = &nSequenceSize;
+
+            return ((opt->key != 0) && (opt->type != 0)) ? STATUS_OK : STATUS_NOT_FOUND;
+        }
+
+    } /* namespace lv2 */
+} /* namespace lsp */
@@ -0,0 +1,406 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/StateReader.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#ifndef PLATFORM_WINDOWS
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif /* PLATFORM_WINDOWS */
+
+namespace lsp
+{
+    namespace lv2
+    {
+        namespace
+        {
+            inline size_t urid_bin(LV2_URID urid, size_t mask)
+            {
+                return (uint32_t(urid) * 0x9e3779b1u) & mask;
+            }
+
+            // Check that the section [offset, offset + size) is located within [begin, end)
+            inline bool section_fits(uint64_t offset, uint64_t size, uint64_t begin, uint64_t end)
+            {
+                return (offset >= begin) && (offset <= end) && (size <= end - offset);
+            }
+        } /* namespace */
+
+        StateReader::StateReader()
+        {
+            pImage          = NULL;
+            nImageSize      = 0;
+            enStorage       = STORAGE_NONE;
+            pHeader         = NULL;
+            vEntries        = NULL;
+            vUris           = NULL;
+            vIndex          = NULL;
+            pStrings        = NULL;
+            pValues         = NULL;
+            vCache          = NULL;
+            nCacheMask      = 0;
+            nCached         = 0;
+            vTypes          = NULL;
+            pMap            = NULL;
+            pUnmap          = NULL;
+        }
+
+        StateReader::~StateReader()
+        {
+            close();
+        }
+
+        status_t StateReader::open(const char *path, const LV2_URID_Map *map, const LV2_URID_Unmap *unmap)
+        {
+            if ((path == NULL) || (map == NULL) || (unmap == NULL))
+                return STATUS_BAD_ARGUMENTS;
+            if (enStorage != STORAGE_NONE)
+                return STATUS_OPENED;
+
+        #ifdef PLATFORM_WINDOWS
+            FILE *fd        = fopen(path, "rb");
+            if (fd == NULL)
+                return STATUS_IO_ERROR;
+
+            long size       = -1;
+            if (fseek(fd, 0, SEEK_END) == 0)
+                size            = ftell(fd);
+            if ((size < 0) || (fseek(fd, 0, SEEK_SET) != 0))
+            {
+                fclose(fd);
+                return STATUS_IO_ERROR;
+            }
+            if (size_t(size) < sizeof(state_header_t))
+            {
+                fclose(fd);
+                return STATUS_CORRUPTED;
+            }
+
+            uint8_t *data   = static_cast<uint8_t *>(malloc(size));
+            if (data == NULL)
+            {
+                fclose(fd);
+                return STATUS_NO_MEM;
+            }
+            const bool ok   = fread(data, size, 1, fd) == 1;
+            fclose(fd);
+            if (!ok)
+            {
+                free(data);
+                return STATUS_IO_ERROR;
+            }
+
+            pImage          = data;
+            nImageSize      = size;
+            enStorage       = STORAGE_HEAP;
+        #else
+            const int fd    = ::open(path, O_RDONLY);
+            if (fd < 0)
+                return STATUS_IO_ERROR;
+
+            struct stat st;
+            if (fstat(fd, &st) != 0)
+            {
+                ::close(fd);
+                return STATUS_IO_ERROR;
+            }
+            if (size_t(st.st_size) < sizeof(state_header_t))
+            {
+                ::close(fd);
+                return STATUS_CORRUPTED;
+            }
+
+            void *data      = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (data == MAP_FAILED)
+                return STATUS_IO_ERROR;
+
+            pImage          = static_cast<uint8_t *>(data);
+            nImageSize      = st.st_size;
+            enStorage       = STORAGE_MMAP;
+        #endif /* PLATFORM_WINDOWS */
+
+            const status_t res  = attach(map, unmap);
+            if (res != STATUS_OK)
+                close();
+            return res;
+        }
+
+        status_t StateReader::wrap(const void *data, size_t size, const LV2_URID_Map *map, const LV2_URID_Unmap *unmap)
+        {
+            if ((data == NULL) || (map == NULL) || (unmap == NULL))
+                return STATUS_BAD_ARGUMENTS;
+            if (uintptr_t(data) & (STATE_FILE_ALIGN - 1))
+                return STATUS_BAD_ARGUMENTS;
+            if (enStorage != STORAGE_NONE)
+                return STATUS_OPENED;
+
+            pImage          = static_cast<uint8_t *>(const_cast<void *>(data));
+            nImageSize      = size;
+            enStorage       = STORAGE_WRAP;
+
+            const status_t res  = attach(map, unmap);
+            if (res != STATUS_OK)
+                close();
+            return res;
+        }
+
+        void StateReader::close()
+        {
+            switch (enStorage)
+            {
+                case STORAGE_HEAP:
+                    free(pImage);
+                    break;
+            #ifndef PLATFORM_WINDOWS
+                case STORAGE_MMAP:
+                    munmap(pImage, nImageSize);
+                    break;
+            #endif /* PLATFORM_WINDOWS */
+                default:
+                    break;
+            }
+
+            if (vCache != NULL)
+            {
+                free(vCache);
+                vCache          = NULL;
+            }
+
+            pImage          = NULL;
+            nImageSize      = 0;
+            enStorage       = STORAGE_NONE;
+            pHeader         = NULL;
+            vEntries        = NULL;
+            vUris           = NULL;
+            vIndex          = NULL;
+            pStrings        = NULL;
+            pValues         = NULL;
+            nCacheMask      = 0;
+            nCached         = 0;
+            vTypes          = NULL;
+            pMap            = NULL;
+            pUnmap          = NULL;
+        }
+
+        status_t StateReader::attach(const LV2_URID_Map *map, const LV2_URID_Unmap *unmap)
+        {
+            if (nImageSize < sizeof(state_header_t))
+                return STATUS_CORRUPTED;
+
+            const state_header_t *hdr   = reinterpret_cast<const state_header_t *>(pImage);
+            if (hdr->magic != STATE_FILE_MAGIC)
+                return STATUS_BAD_FORMAT;
+            if (hdr->byte_order != STATE_FILE_BYTE_ORDER)
+                return STATUS_UNSUPPORTED_FORMAT;
+            if (hdr->version != STATE_FILE_VERSION)
+                return STATUS_UNSUPPORTED_FORMAT;
+
+            // Offsets are not trusted, so the pointers to sections are formed after they are checked
+            pHeader         = hdr;
+            status_t res    = validate_sections();
+            if (res != STATUS_OK)
+                return res;
+
+            vEntries        = reinterpret_cast<const state_entry_t *>(&pImage[hdr->entries_offset]);
+            vUris           = reinterpret_cast<const state_uri_t *>(&pImage[hdr->uris_offset]);
+            vIndex          = reinterpret_cast<const uint32_t *>(&pImage[hdr->bins_offset]);
+            pStrings        = reinterpret_cast<const char *>(&pImage[hdr->strings_offset]);
+            pValues         = &pImage[hdr->data_offset];
+
+            res             = validate();
+            if (res != STATUS_OK)
+                return res;
+
+            // Allocate the cache of keys and the types of URIs, the cache is never filled by more than 3/4
+            size_t cache    = 0x10;
+            while (cache < size_t(hdr->entries) * 4)
+                cache         <<= 1;
+
+            uint8_t *ptr    = static_cast<uint8_t *>(calloc(1, cache * sizeof(cache_t) + hdr->uris * sizeof(LV2_URID)));
+            if (ptr == NULL)
+                return STATUS_NO_MEM;
+
+            vCache          = reinterpret_cast<cache_t *>(ptr);
+            nCacheMask      = cache - 1;
+            nCached         = 0;
+            vTypes          = reinterpret_cast<LV2_URID *>(&vCache[cache]);
+            pMap            = map;
+            pUnmap          = unmap;
+
+            return STATUS_OK;
+        }
+
+        status_t StateReader::validate_sections() const
+        {
+            const state_header_t *hdr   = pHeader;
+            const uint64_t size         = nImageSize;
+
+            // Sections should be aligned, follow each other and fit the container
+            if ((hdr->entries_offset | hdr->uris_offset | hdr->bins_offset | hdr->strings_offset | hdr->data_offset) & (STATE_FILE_ALIGN - 1))
+                return STATUS_CORRUPTED;
+            if (!section_fits(hdr->entries_offset, uint64_t(hdr->entries) * sizeof(state_entry_t), sizeof(state_header_t), size))
+                return STATUS_CORRUPTED;
+            if (!section_fits(hdr->uris_offset, uint64_t(hdr->uris) * sizeof(state_uri_t), hdr->entries_offset + uint64_t(hdr->entries) * sizeof(state_entry_t), size))
+                return STATUS_CORRUPTED;
+            if (!section_fits(hdr->bins_offset, uint64_t(hdr->bins) * sizeof(uint32_t), hdr->uris_offset + uint64_t(hdr->uris) * sizeof(state_uri_t), size))
+                return STATUS_CORRUPTED;
+            if (!section_fits(hdr->strings_offset, hdr->strings, hdr->bins_offset + uint64_t(hdr->bins) * sizeof(uint32_t), size))
+                return STATUS_CORRUPTED;
+            if (!section_fits(hdr->data_offset, hdr->data, hdr->strings_offset + hdr->strings, size))
+                return STATUS_CORRUPTED;
+
+            return STATUS_OK;
+        }
+
+        status_t StateReader::validate() const
+        {
+            const state_header_t *hdr   = pHeader;
+
+            // The hash index should always have empty bins
+            if ((hdr->bins & (hdr->bins - 1)) || (hdr->bins <= hdr->entries))
+                return STATUS_CORRUPTED;
+            for (size_t i=0; i<hdr->bins; ++i)
+                if (vIndex[i] > hdr->entries)
+                    return STATUS_CORRUPTED;
+
+            // Each URI should be terminated with zero
+            for (size_t i=0; i<hdr->uris; ++i)
+            {
+                const state_uri_t *u    = &vUris[i];
+                if ((uint64_t(u->offset) + u->length >= hdr->strings) || (pStrings[u->offset + u->length] != '\0'))
+                    return STATUS_CORRUPTED;
+            }
+
+            // Each entry should refer existing URIs and aligned value within the data section
+            for (size_t i=0; i<hdr->entries; ++i)
+            {
+                const state_entry_t *e  = &vEntries[i];
+                if ((e->key >= hdr->uris) || (e->type >= hdr->uris))
+                    return STATUS_CORRUPTED;
+                if ((e->offset & (STATE_FILE_ALIGN - 1)) || (!section_fits(e->offset, e->size, 0, hdr->data)))
+                    return STATUS_CORRUPTED;
+            }
+
+            return STATUS_OK;
+        }
+
+        ssize_t StateReader::lookup(const char *uri, size_t len) const
+        {
+            const uint64_t hash = state_hash_uri(uri, len);
+            const size_t mask   = pHeader->bins - 1;
+
+            for (size_t bin = hash & mask; vIndex[bin] != 0; bin = (bin + 1) & mask)
+            {
+                const size_t index      = vIndex[bin] - 1;
+                const state_entry_t *e  = &vEntries[index];
+                if (e->hash != uint32_t(hash))
+                    continue;
+
+                const state_uri_t *u    = &vUris[e->key];
+                if ((u->length == len) && (memcmp(&pStrings[u->offset], uri, len) == 0))
+                    return index;
+            }
+
+            return -1;
+        }
+
+        const void *StateReader::value(size_t index, size_t *size, uint32_t *flags) const
+        {
+            const state_entry_t *e  = &vEntries[index];
+            if (size != NULL)
+                *size                   = e->size;
+            if (flags != NULL)
+                *flags                  = e->flags;
+            return &pValues[e->offset];
+        }
+
+        const void *StateReader::do_retrieve(LV2_State_Handle handle, uint32_t key, size_t *size, uint32_t *type, uint32_t *flags)
+        {
+            StateReader *self = static_cast<StateReader *>(handle);
+            return self->retrieve(key, size, type, flags);
+        }
+
+        const void *StateReader::retrieve(LV2_URID key, size_t *size, uint32_t *type, uint32_t *flags)
+        {
+            if ((pHeader == NULL) || (key == 0))
+                return NULL;
+
+            // Lookup the cache
+            size_t bin      = urid_bin(key, nCacheMask);
+            while ((vCache[bin].urid != 0) && (vCache[bin].urid != key))
+                bin             = (bin + 1) & nCacheMask;
+
+            cache_t *c      = &vCache[bin];
+            if (c->urid == 0)
+            {
+                // Search the container
+                const char *uri     = pUnmap->unmap(pUnmap->handle, key);
+                if (uri == NULL)
+                    return NULL;
+                const ssize_t index = lookup(uri, strlen(uri));
+
+                // Missing keys are cached only while there is enough space for all existing keys
+                if ((index < 0) && ((nCached + 1) * 2 > nCacheMask + 1))
+                    return NULL;
+                c->urid             = key;
+                c->entry            = uint32_t(index + 1);
+                ++nCached;
+            }
+            if (c->entry == 0)
+                return NULL;
+
+            // Map the type
+            const size_t index  = c->entry - 1;
+            const uint32_t tidx = vEntries[index].type;
+            if (vTypes[tidx] == 0)
+            {
+                vTypes[tidx]        = pMap->map(pMap->handle, &pStrings[vUris[tidx].offset]);
+                if (vTypes[tidx] == 0)
+                    return NULL;
+            }
+            if (type != NULL)
+                *type               = vTypes[tidx];
+
+            return value(index, size, flags);
+        }
+
+        const void *StateReader::find(const char *uri, size_t *size, const char **type, uint32_t *flags) const
+        {
+            if ((pHeader == NULL) || (uri == NULL))
+                return NULL;
+
+            const ssize_t index = lookup(uri, strlen(uri));
+            if (index < 0)
+                return NULL;
+
+            if (type != NULL)
+                *type               = &pStrings[vUris[vEntries[index].type].offset];
+            return value(index, size, flags);
+        }
+
+    } /* namespace lv2 */
+} /* namespace lsp */
@@ -0,0 +1,489 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/StateWriter.h>
+#include <lsp-plug.in/3rdparty/lv2/state_file.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        namespace
+        {
+            inline size_t urid_bin(LV2_URID urid, size_t mask)
+            {
+                return (uint32_t(urid) * 0x9e3779b1u) & mask;
+            }
+
+            inline size_t bins_for(size_t count)
+            {
+                // Keep the load factor of the hash table not greater than 0.5
+                size_t bins = 0x10;
+                while (bins < count * 2)
+                    bins      <<= 1;
+                return bins;
+            }
+        } /* namespace */
+
+        StateWriter::StateWriter()
+        {
+            vItems          = NULL;
+            nItems          = 0;
+            nCapacity       = 0;
+            vBins           = NULL;
+            nBins           = 0;
+            pData           = NULL;
+            nDataSize       = 0;
+            nDataCap        = 0;
+            vUris           = NULL;
+            nUris           = 0;
+            nUriCap         = 0;
+            vUriBins        = NULL;
+            nUriBins        = 0;
+            nStamp          = 0;
+            pImage          = NULL;
+            nImageCap       = 0;
+            pUnmap          = NULL;
+        }
+
+        StateWriter::~StateWriter()
+        {
+            destroy();
+        }
+
+        status_t StateWriter::init(const LV2_URID_Unmap *unmap)
+        {
+            if ((unmap == NULL) || (unmap->unmap == NULL))
+                return STATUS_BAD_ARGUMENTS;
+
+            destroy();
+            pUnmap          = unmap;
+            return STATUS_OK;
+        }
+
+        void StateWriter::destroy()
+        {
+            if (vItems != NULL)
+            {
+                free(vItems);
+                vItems          = NULL;
+            }
+            if (vBins != NULL)
+            {
+                free(vBins);
+                vBins           = NULL;
+            }
+            if (pData != NULL)
+            {
+                free(pData);
+                pData           = NULL;
+            }
+            if (vUris != NULL)
+            {
+                free(vUris);
+                vUris           = NULL;
+            }
+            if (vUriBins != NULL)
+            {
+                free(vUriBins);
+                vUriBins        = NULL;
+            }
+            if (pImage != NULL)
+            {
+                free(pImage);
+                pImage          = NULL;
+            }
+
+            nItems          = 0;
+            nCapacity       = 0;
+            nBins           = 0;
+            nDataSize       = 0;
+            nDataCap        = 0;
+            nUris           = 0;
+            nUriCap         = 0;
+            nUriBins        = 0;
+            nStamp          = 0;
+            nImageCap       = 0;
+            pUnmap          = NULL;
+        }
+
+        void StateWriter::clear()
+        {
+            if (vBins != NULL)
+                memset(vBins, 0, nBins * sizeof(uint32_t));
+            nItems          = 0;
+            nDataSize       = 0;
+        }
+
+        status_t StateWriter::rehash(size_t bins)
+        {
+            uint32_t *vb    = static_cast<uint32_t *>(calloc(bins, sizeof(uint32_t)));
+            if (vb == NULL)
+                return STATUS_NO_MEM;
+
+            const size_t mask   = bins - 1;
+            for (size_t i=0; i<nItems; ++i)
+            {
+                size_t bin          = urid_bin(vItems[i].key, mask);
+                while (vb[bin] != 0)
+                    bin                 = (bin + 1) & mask;
+                vb[bin]             = uint32_t(i + 1);
+            }
+
+            if (vBins != NULL)
+                free(vBins);
+            vBins           = vb;
+            nBins           = bins;
+
+            return STATUS_OK;
+        }
+
+        status_t StateWriter::reserve_data(size_t size)
+        {
+            if (nDataSize + size <= nDataCap)
+                return STATUS_OK;
+
+            size_t cap      = lsp_max(nDataCap, size_t(0x1000));
+            while (cap < nDataSize + size)
+                cap           <<= 1;
+
+            uint8_t *data   = static_cast<uint8_t *>(realloc(pData, cap));
+            if (data == NULL)
+                return STATUS_NO_MEM;
+
+            pData           = data;
+            nDataCap        = cap;
+            return STATUS_OK;
+        }
+
+        LV2_State_Status StateWriter::do_store(LV2_State_Handle handle, uint32_t key, const void *value, size_t size, uint32_t type, uint32_t flags)
+        {
+            StateWriter *self = static_cast<StateWriter *>(handle);
+            return self->store(key, value, size, type, flags);
+        }
+
+        LV2_State_Status StateWriter::store(LV2_URID key, const void *value, size_t size, LV2_URID type, uint32_t flags)
+        {
+            if ((pUnmap == NULL) || (key == 0) || ((value == NULL) && (size > 0)))
+                return LV2_STATE_ERR_UNKNOWN;
+            if (type == 0)
+                return LV2_STATE_ERR_BAD_TYPE;
+            if (!(flags & LV2_STATE_IS_POD))
+                return LV2_STATE_ERR_BAD_FLAGS;
+
+            // Search for the already stored value
+            item_t *item    = NULL;
+            size_t bin      = 0;
+            if (nBins > 0)
+            {
+                const size_t mask   = nBins - 1;
+                for (bin = urid_bin(key, mask); vBins[bin] != 0; bin = (bin + 1) & mask)
+                {
+                    if (vItems[vBins[bin] - 1].key == key)
+                    {
+                        item                = &vItems[vBins[bin] - 1];
+                        break;
+                    }
+                }
+            }
+
+            if (item == NULL)
+            {
+                // Allocate new item
+                if (nItems >= nCapacity)
+                {
+                    const size_t cap    = lsp_max(nCapacity * 2, size_t(0x40));
+                    item_t *vi          = static_cast<item_t *>(realloc(vItems, cap * sizeof(item_t)));
+                    if (vi == NULL)
+                        return LV2_STATE_ERR_NO_SPACE;
+                    vItems              = vi;
+                    nCapacity           = cap;
+                }
+                if ((nItems + 1) * 2 > nBins)
+                {
+                    if (rehash(bins_for(nItems + 1)) != STATUS_OK)
+                        return LV2_STATE_ERR_NO_SPACE;
+                    const size_t mask   = nBins - 1;
+                    for (bin = urid_bin(key, mask); vBins[bin] != 0; bin = (bin + 1) & mask)
+                        /* nothing */;
+                }
+
+                item                = &vItems[nItems];
+                item->key           = key;
+                item->capacity      = 0;
+                item->offset        = 0;
+                vBins[bin]          = uint32_t(++nItems);
+            }
+
+            // Replace the value in place if it fits the reserved space
+            const size_t padded = state_align(size);
+            if (padded > item->capacity)
+            {
+                if (reserve_data(padded) != STATUS_OK)
+                    return LV2_STATE_ERR_NO_SPACE;
+                item->offset        = nDataSize;
+                item->capacity      = padded;
+                nDataSize          += padded;
+            }
+
+            if (size > 0)
+                memcpy(&pData[item->offset], value, size);
+            item->type          = type;
+            item->flags         = flags;
+            item->size          = size;
+
+            return LV2_STATE_SUCCESS;
+        }
+
+        status_t StateWriter::rehash_uris(size_t bins)
+        {
+            uint32_t *vb    = static_cast<uint32_t *>(calloc(bins, sizeof(uint32_t)));
+            if (vb == NULL)
+                return STATUS_NO_MEM;
+
+            const size_t mask   = bins - 1;
+            for (size_t i=0; i<nUris; ++i)
+            {
+                size_t bin          = urid_bin(vUris[i].urid, mask);
+                while (vb[bin] != 0)
+                    bin                 = (bin + 1) & mask;
+                vb[bin]             = uint32_t(i + 1);
+            }
+
+            if (vUriBins != NULL)
+                free(vUriBins);
+            vUriBins        = vb;
+            nUriBins        = bins;
+
+            return STATUS_OK;
+        }
+
+        ssize_t StateWriter::cache_uri(LV2_URID urid)
+        {
+            // Lookup the cache
+            size_t bin      = 0;
+            if (nUriBins > 0)
+            {
+                const size_t mask   = nUriBins - 1;
+                for (bin = urid_bin(urid, mask); vUriBins[bin] != 0; bin = (bin + 1) & mask)
+                    if (vUris[vUriBins[bin] - 1].urid == urid)
+                        return vUriBins[bin] - 1;
+            }
+
+            // Unmap the URI and add it to the cache
+            const char *uri = pUnmap->unmap(pUnmap->handle, urid);
+            if (uri == NULL)
+                return -STATUS_NOT_FOUND;
+            const size_t len = strlen(uri);
+            if (len >= UINT32_MAX)
+                return -STATUS_TOO_BIG;
+
+            if (nUris >= nUriCap)
+            {
+                const size_t cap    = lsp_max(nUriCap * 2, size_t(0x40));
+                uri_t *vu           = static_cast<uri_t *>(realloc(vUris, cap * sizeof(uri_t)));
+                if (vu == NULL)
+                    return -STATUS_NO_MEM;
+                vUris               = vu;
+                nUriCap             = cap;
+            }
+            if ((nUris + 1) * 2 > nUriBins)
+            {
+                if (rehash_uris(bins_for(nUris + 1)) != STATUS_OK)
+                    return -STATUS_NO_MEM;
+                const size_t mask   = nUriBins - 1;
+                for (bin = urid_bin(urid, mask); vUriBins[bin] != 0; bin = (bin + 1) & mask)
+                    /* nothing */;
+            }
+
+            uri_t *u        = &vUris[nUris];
+            u->uri          = uri;
+            u->hash         = state_hash_uri(uri, len);
+            u->urid         = urid;
+            u->length       = uint32_t(len);
+            u->stamp        = 0;
+            u->index        = 0;
+            u->offset       = 0;
+            vUriBins[bin]   = uint32_t(++nUris);
+
+            return nUris - 1;
+        }
+
+        status_t StateWriter::serialize(const void **data, size_t *size)
+        {
+            if ((data == NULL) || (size == NULL))
+                return STATUS_BAD_ARGUMENTS;
+            if (pUnmap == NULL)
+                return STATUS_BAD_STATE;
+
+            // Each serialization marks used URIs with two stamps: one for assigning indices, one for emitting
+            if (nStamp >= UINT32_MAX - 2)
+            {
+                for (size_t i=0; i<nUris; ++i)
+                    vUris[i].stamp      = 0;
+                nStamp              = 0;
+            }
+            const uint32_t used     = nStamp + 1;
+            const uint32_t emitted  = nStamp + 2;
+            nStamp                 += 2;
+
+            // Assign indices to URIs used by the items
+            size_t num_uris         = 0;
+            uint64_t strings        = 0;
+            uint64_t values         = 0;
+
+            for (size_t i=0; i<nItems; ++i)
+            {
+                item_t *it          = &vItems[i];
+                const ssize_t key   = cache_uri(it->key);
+                if (key < 0)
+                    return status_t(-key);
+                const ssize_t type  = cache_uri(it->type);
+                if (type < 0)
+                    return status_t(-type);
+
+                it->key_uri         = uint32_t(key);
+                it->type_uri        = uint32_t(type);
+                values             += state_align(it->size);
+
+                for (size_t j=0; j<2; ++j)
+                {
+                    uri_t *u            = &vUris[(j == 0) ? key : type];
+                    if (u->stamp == used)
+                        continue;
+                    u->stamp            = used;
+                    u->index            = uint32_t(num_uris++);
+                    u->offset           = strings;
+                    strings            += u->length + 1;
+                }
+            }
+            if (strings > UINT32_MAX)
+                return STATUS_TOO_BIG;
+
+            // Compute the layout of the container
+            const size_t bins       = bins_for(nItems);
+            state_header_t hdr;
+            memset(&hdr, 0, sizeof(hdr));
+            hdr.magic               = STATE_FILE_MAGIC;
+            hdr.version             = STATE_FILE_VERSION;
+            hdr.byte_order          = STATE_FILE_BYTE_ORDER;
+            hdr.entries             = uint32_t(nItems);
+            hdr.uris                = uint32_t(num_uris);
+            hdr.bins                = uint32_t(bins);
+            hdr.entries_offset      = state_align(sizeof(state_header_t));
+            hdr.uris_offset         = hdr.entries_offset + nItems * sizeof(state_entry_t);
+            hdr.bins_offset         = state_align(hdr.uris_offset + num_uris * sizeof(state_uri_t));
+            hdr.strings_offset      = state_align(hdr.bins_offset + bins * sizeof(uint32_t));
+            hdr.strings             = strings;
+            hdr.data_offset         = state_align(hdr.strings_offset + strings);
+            hdr.data                = values;
+
+            const size_t total      = hdr.data_offset + values;
+            if (total > nImageCap)
+            {
+                uint8_t *buf            = static_cast<uint8_t *>(realloc(pImage, total));
+                if (buf == NULL)
+                    return STATUS_NO_MEM;
+                pImage                  = buf;
+                nImageCap               = total;
+            }
+
+            // Emit the container, the padding is filled with zeros
+            uint8_t *buf            = pImage;
+            memset(buf, 0, hdr.strings_offset);
+            memcpy(buf, &hdr, sizeof(hdr));
+
+            state_entry_t *entries  = reinterpret_cast<state_entry_t *>(&buf[hdr.entries_offset]);
+            state_uri_t *uri_table  = reinterpret_cast<state_uri_t *>(&buf[hdr.uris_offset]);
+            uint32_t *vb            = reinterpret_cast<uint32_t *>(&buf[hdr.bins_offset]);
+            char *str               = reinterpret_cast<char *>(&buf[hdr.strings_offset]);
+            uint8_t *dst            = &buf[hdr.data_offset];
+            uint64_t offset         = 0;
+
+            for (size_t i=0; i<nItems; ++i)
+            {
+                const item_t *it        = &vItems[i];
+                const uri_t *key        = &vUris[it->key_uri];
+                state_entry_t *e        = &entries[i];
+
+                for (size_t j=0; j<2; ++j)
+                {
+                    uri_t *u                = &vUris[(j == 0) ? it->key_uri : it->type_uri];
+                    if (u->stamp == emitted)
+                        continue;
+                    u->stamp                = emitted;
+                    uri_table[u->index].offset  = uint32_t(u->offset);
+                    uri_table[u->index].length  = u->length;
+                    memcpy(&str[u->offset], u->uri, u->length + 1);
+                }
+
+                e->key                  = key->index;
+                e->type                 = vUris[it->type_uri].index;
+                e->flags                = it->flags;
+                e->hash                 = uint32_t(key->hash);
+                e->offset               = offset;
+                e->size                 = it->size;
+
+                const size_t padded     = state_align(it->size);
+                memcpy(&dst[offset], &pData[it->offset], it->size);
+                memset(&dst[offset + it->size], 0, padded - it->size);
+                offset                 += padded;
+
+                size_t bin              = key->hash & (bins - 1);
+                while (vb[bin] != 0)
+                    bin                     = (bin + 1) & (bins - 1);
+                vb[bin]                 = uint32_t(i + 1);
+            }
+            memset(&str[strings], 0, hdr.data_offset - hdr.strings_offset - strings);
+
+            *data                   = buf;
+            *size                   = total;
+            return STATUS_OK;
+        }
+
+        status_t StateWriter::save(const char *path)
+        {
+            if (path == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            const void *data    = NULL;
+            size_t size         = 0;
+            status_t res        = serialize(&data, &size);
+            if (res != STATUS_OK)
+                return res;
+
+            FILE *fd            = fopen(path, "wb");
+            if (fd == NULL)
+                return STATUS_IO_ERROR;
+
+            if (fwrite(data, size, 1, fd) != 1)
+                res                 = STATUS_IO_ERROR;
+            if (fclose(fd) != 0)
+                res                 = STATUS_IO_ERROR;
+
+            return res;
+        }
+
+    } /* namespace lv2 */
+} /* namespace lsp */
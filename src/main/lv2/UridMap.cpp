@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/UridMap.h>
+#include <lsp-plug.in/3rdparty/lv2/uris.h>
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        static constexpr size_t URID_MAP_ALIGN          = 0x40;
+
+        constexpr size_t UridMap::DEFAULT_CAPACITY;
+        constexpr size_t UridMap::CHUNK_SIZE;
+
+        namespace
+        {
+            inline uint64_t hash_uri(const char *uri, size_t *len)
+            {
+                // FNV-1a
+                uint64_t hash       = 0xcbf29ce484222325ULL;
+                const char *p       = uri;
+                for ( ; *p != '\0'; ++p)
+                {
+                    hash               ^= uint8_t(*p);
+                    hash               *= 0x100000001b3ULL;
+                }
+                *len                = p - uri;
+                return hash;
+            }
+
+            // The tag may be zero, but URIDs start from 1, so an occupied slot is never zero
+            inline uint64_t make_slot(uint64_t hash, LV2_URID urid)
+            {
+                return (hash & 0xffffffff00000000ULL) | urid;
+            }
+
+            inline bool slot_tag_matches(uint64_t slot, uint64_t hash)
+            {
+                return ((slot ^ hash) & 0xffffffff00000000ULL) == 0;
+            }
+        } /* namespace */
+
+        UridMap::UridMap()
+        {
+            vSlots          = NULL;
+            nMask           = 0;
+            vStrings        = NULL;
+            nCapacity       = 0;
+            nNext           = 1;
+            nSize           = 0;
+            nSeeded         = 0;
+            pChunks         = NULL;
+            pData           = NULL;
+
+            sMap.handle     = this;
+            sMap.map        = map_uri;
+            sUnmap.handle   = this;
+            sUnmap.unmap    = unmap_uri;
+        }
+
+        UridMap::~UridMap()
+        {
+            destroy();
+        }
+
+        LV2_URID UridMap::map_uri(LV2_URID_Map_Handle handle, const char *uri)
+        {
+            return static_cast<UridMap *>(handle)->map(uri);
+        }
+
+        const char *UridMap::unmap_uri(LV2_URID_Unmap_Handle handle, LV2_URID urid)
+        {
+            return static_cast<UridMap *>(handle)->unmap(urid);
+        }
+
+        void UridMap::release_chunks()
+        {
+            for (chunk_t *c = pChunks; c != NULL; )
+            {
+                chunk_t *next   = c->next;
+                free(c);
+                c               = next;
+            }
+            pChunks         = NULL;
+        }
+
+        void UridMap::destroy()
+        {
+            release_chunks();
+            free_aligned(pData);
+
+            vSlots          = NULL;
+            nMask           = 0;
+            vStrings        = NULL;
+            nCapacity       = 0;
+            nNext           = 1;
+            nSize           = 0;
+            nSeeded         = 0;
+        }
+
+        status_t UridMap::init(size_t capacity)
+        {
+            if ((capacity < URI_COUNT) || (capacity >= 0x80000000U))
+                return STATUS_BAD_ARGUMENTS;
+
+            // Keep the load factor of the hash table not greater than 0.5
+            size_t slots        = 1;
+            while (slots < capacity * 2)
+                slots             <<= 1;
+
+            const size_t szof_slots     = align_size(slots * sizeof(uint64_t), URID_MAP_ALIGN);
+            const size_t szof_strings   = (capacity + 1) * sizeof(const char *);
+
+            uint8_t *data       = NULL;
+            uint8_t *ptr        = alloc_aligned<uint8_t>(data, szof_slots + szof_strings, URID_MAP_ALIGN);
+            if (ptr == NULL)
+                return STATUS_NO_MEM;
+
+            destroy();
+
+            vSlots              = reinterpret_cast<uint64_t *>(ptr);
+            ptr                += szof_slots;
+            vStrings            = reinterpret_cast<const char **>(ptr);
+            nMask               = slots - 1;
+            nCapacity           = capacity;
+            pData               = data;
+
+            memset(vSlots, 0, slots * sizeof(uint64_t));
+            memset(vStrings, 0, szof_strings);
+
+            // Map URIs of the registry, the URID of each URI is the index in the registry plus 1
+            for (size_t i=0; i<URI_COUNT; ++i)
+                insert(uri_string(uri_t(i)), false);
+            nSeeded             = nSize;
+
+            return STATUS_OK;
+        }
+
+        char *UridMap::store(const char *uri, size_t len)
+        {
+            const size_t size   = len + 1;
+
+            while (true)
+            {
+                // Try to allocate string in the current chunk
+                chunk_t *c          = atomic_load(&pChunks);
+                if (c != NULL)
+                {
+                    const size_t offset = atomic_add(&c->used, size);
+                    if (offset + size <= c->size)
+                    {
+                        char *dst           = reinterpret_cast<char *>(&c[1]) + offset;
+                        memcpy(dst, uri, size);
+                        return dst;
+                    }
+                }
+
+                // Allocate new chunk with the string at the beginning
+                const size_t capacity = lsp_max(size, CHUNK_SIZE);
+                chunk_t *nc         = static_cast<chunk_t *>(malloc(sizeof(chunk_t) + capacity));
+                if (nc == NULL)
+                    return NULL;
+                nc->next            = c;
+                nc->size            = capacity;
+                nc->used            = size;
+
+                if (atomic_cas(&pChunks, c, nc))
+                {
+                    char *dst           = reinterpret_cast<char *>(&nc[1]);
+                    memcpy(dst, uri, size);
+                    return dst;
+                }
+
+                // Other thread has installed new chunk, use it
+                free(nc);
+            }
+        }
+
+        LV2_URID UridMap::find(const char *uri) const
+        {
+            if ((uri == NULL) || (vSlots == NULL))
+                return 0;
+
+            // Registry strings are mapped without hashing
+            const ssize_t index = uri_index(uri);
+            if (index >= 0)
+                return LV2_URID(index + 1);
+
+            size_t len          = 0;
+            const uint64_t hash = hash_uri(uri, &len);
+
+            for (size_t i=0; i<=nMask; ++i)
+            {
+                const uint64_t slot = atomic_load(&vSlots[(hash + i) & nMask]);
+                if (slot == 0)
+                    return 0;
+                if (!slot_tag_matches(slot, hash))
+                    continue;
+
+                const LV2_URID urid = LV2_URID(slot & 0xffffffff);
+                if (strcmp(vStrings[urid], uri) == 0)
+                    return urid;
+            }
+
+            return 0;
+        }
+
+        LV2_URID UridMap::insert(const char *uri, bool copy)
+        {
+            size_t len          = 0;
+            const uint64_t hash = hash_uri(uri, &len);
+            LV2_URID urid       = 0;
+
+            for (size_t i=0; i<=nMask; ++i)
+            {
+                uint64_t *p         = &vSlots[(hash + i) & nMask];
+                uint64_t slot       = atomic_load(p);
+
+                while (slot == 0)
+                {
+                    // Allocate URID and publish the string before publishing the slot
+                    if (urid == 0)
+                    {
+                        if (atomic_load(&nNext) > nCapacity)
+                            return 0;
+                        urid                = atomic_add(&nNext, uint32_t(1));
+                        if (urid > nCapacity)
+                            return 0;
+
+                        const char *s       = (copy) ? store(uri, len) : uri;
+                        if (s == NULL)
+                            return 0;
+                        atomic_store(&vStrings[urid], s);
+                    }
+
+                    if (atomic_cas(p, uint64_t(0), make_slot(hash, urid)))
+                    {
+                        atomic_add(&nSize, uint32_t(1));
+                        return urid;
+                    }
+                    slot                = atomic_load(p);
+                }
+
+                // The slot is occupied, check the URI
+                if (!slot_tag_matches(slot, hash))
+                    continue;
+
+                const LV2_URID id   = LV2_URID(slot & 0xffffffff);
+                if (strcmp(vStrings[id], uri) == 0)
+                {
+                    // Other thread could map the same URI, the allocated URID remains unused
+                    if (urid != 0)
+                        atomic_store(&vStrings[urid], static_cast<const char *>(NULL));
+                    return id;
+                }
+            }
+
+            return 0;
+        }
+
+        LV2_URID UridMap::map(const char *uri)
+        {
+            if ((uri == NULL) || (vSlots == NULL))
+                return 0;
+
+            const LV2_URID urid = find(uri);
+            return (urid != 0) ? urid : insert(uri, true);
+        }
+
+        const char *UridMap::unmap(LV2_URID urid) const
+        {
+            if ((urid == 0) || (urid > nCapacity))
+                return NULL;
+            return atomic_load(&vStrings[urid]);
+        }
+
+    } /* namespace lv2 */
+} /* namespace lsp */
@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/block_size.h>
+#include <lsp-plug.in/3rdparty/lv2/uris.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <lv2/atom/atom.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        enum block_option_t
+        {
+            BLOCK_OPT_MIN_LENGTH,
+            BLOCK_OPT_MAX_LENGTH,
+            BLOCK_OPT_NOMINAL_LENGTH,
+            BLOCK_OPT_SEQUENCE_SIZE,
+            BLOCK_OPT_SAMPLE_RATE,
+            BLOCK_OPT_ATOM_INT,
+            BLOCK_OPT_ATOM_LONG,
+            BLOCK_OPT_ATOM_FLOAT,
+            BLOCK_OPT_ATOM_DOUBLE,
+
+            BLOCK_OPT_TOTAL
+        };
+
+        static const uri_t block_option_uris[] =
+        {
+            URI_BUF_SIZE__minBlockLength,
+            URI_BUF_SIZE__maxBlockLength,
+            URI_BUF_SIZE__nominalBlockLength,
+            URI_BUF_SIZE__sequenceSize,
+            URI_PARAMETERS__sampleRate,
+            URI_ATOM__Int,
+            URI_ATOM__Long,
+            URI_ATOM__Float,
+            URI_ATOM__Double
+        };
+
+        static_assert(
+            sizeof(block_option_uris) / sizeof(uri_t) == BLOCK_OPT_TOTAL,
+            "List of URIs does not match the block_option_t enumeration");
+
+        static const struct
+        {
+            uri_t           uri;
+            uint32_t        flag;
+        } block_features[] =
+        {
+            { URI_BUF_SIZE__boundedBlockLength,     BLOCK_BOUNDED       },
+            { URI_BUF_SIZE__fixedBlockLength,       BLOCK_FIXED         },
+            { URI_BUF_SIZE__powerOf2BlockLength,    BLOCK_POWER_OF_2    },
+            { URI_BUF_SIZE__coarseBlockLength,      BLOCK_COARSE        }
+        };
+
+        static inline bool is_power_of_2(uint32_t value)
+        {
+            return (value > 0) && ((value & (value - 1)) == 0);
+        }
+
+        static bool read_option(double *dst, const LV2_Options_Option *opt, const LV2_URID *urids)
+        {
+            if (opt->value == NULL)
+                return false;
+
+            if (opt->type == urids[BLOCK_OPT_ATOM_INT])
+            {
+                if (opt->size < sizeof(int32_t))
+                    return false;
+                *dst        = *static_cast<const int32_t *>(opt->value);
+            }
+            else if (opt->type == urids[BLOCK_OPT_ATOM_LONG])
+            {
+                if (opt->size < sizeof(int64_t))
+                    return false;
+                *dst        = double(*static_cast<const int64_t *>(opt->value));
+            }
+            else if (opt->type == urids[BLOCK_OPT_ATOM_FLOAT])
+            {
+                if (opt->size < sizeof(float))
+                    return false;
+                *dst        = *static_cast<const float *>(opt->value);
+            }
+            else if (opt->type == urids[BLOCK_OPT_ATOM_DOUBLE])
+            {
+                if (opt->size < sizeof(double))
+                    return false;
+                *dst        = *static_cast<const double *>(opt->value);
+            }
+            else
+                return false;
+
+            return true;
+        }
+
+        static inline uint32_t to_length(double value)
+        {
+            return ((value >= 0.0) && (value <= double(0xffffffffU))) ? uint32_t(value) : 0;
+        }
+
+        void block_size_reset(block_size_t *bs)
+        {
+            bs->min_length          = 0;
+            bs->max_length          = 0;
+            bs->nominal_length      = 0;
+            bs->sequence_size       = 0;
+            bs->sample_rate         = 0.0f;
+            bs->flags               = 0;
+        }
+
+        status_t block_size_parse_options(block_size_t *bs, const LV2_Options_Option *options, const LV2_URID_Map *map)
+        {
+            if ((bs == NULL) || (map == NULL) || (map->map == NULL))
+                return STATUS_BAD_ARGUMENTS;
+            if (options == NULL)
+                return STATUS_OK;
+
+            LV2_URID urids[BLOCK_OPT_TOTAL];
+            const status_t res = map_uris(urids, block_option_uris, BLOCK_OPT_TOTAL, map);
+            if (res == STATUS_BAD_ARGUMENTS)
+                return res;
+
+            double value = 0.0;
+            for (const LV2_Options_Option *opt = options; opt->key != 0; ++opt)
+            {
+                if ((opt->context != LV2_OPTIONS_INSTANCE) || (!read_option(&value, opt, urids)))
+                    continue;
+
+                if (opt->key == urids[BLOCK_OPT_MIN_LENGTH])
+                    bs->min_length          = to_length(value);
+                else if (opt->key == urids[BLOCK_OPT_MAX_LENGTH])
+                    bs->max_length          = to_length(value);
+                else if (opt->key == urids[BLOCK_OPT_NOMINAL_LENGTH])
+                    bs->nominal_length      = to_length(value);
+                else if (opt->key == urids[BLOCK_OPT_SEQUENCE_SIZE])
+                    bs->sequence_size       = to_length(value);
+                else if (opt->key == urids[BLOCK_OPT_SAMPLE_RATE])
+                    bs->sample_rate         = (value > 0.0) ? float(value) : 0.0f;
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t block_size_parse(block_size_t *bs, const LV2_Feature * const *features)
+        {
+            if (bs == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            block_size_reset(bs);
+            if (features == NULL)
+                return STATUS_OK;
+
+            // Scan features
+            const LV2_URID_Map *map             = NULL;
+            const LV2_Options_Option *options   = NULL;
+            const char *urid_map                = uri_string(URI_URID__map);
+            const char *opt_options             = uri_string(URI_OPTIONS__options);
+
+            for (const LV2_Feature * const *f = features; *f != NULL; ++f)
+            {
+                const char *uri = (*f)->URI;
+                if (uri == NULL)
+                    continue;
+
+                if (!strcmp(uri, urid_map))
+                    map         = static_cast<const LV2_URID_Map *>((*f)->data);
+                else if (!strcmp(uri, opt_options))
+                    options     = static_cast<const LV2_Options_Option *>((*f)->data);
+                else
+                {
+                    for (size_t i=0; i<sizeof(block_features)/sizeof(block_features[0]); ++i)
+                        if (!strcmp(uri, uri_string(block_features[i].uri)))
+                        {
+                            bs->flags      |= block_features[i].flag;
+                            break;
+                        }
+                }
+            }
+
+            if ((options != NULL) && (map != NULL))
+            {
+                const status_t res = block_size_parse_options(bs, options, map);
+                if (res != STATUS_OK)
+                    return res;
+            }
+
+            // Complete the lengths: fixed length is the only possible length
+            if (bs->flags & BLOCK_FIXED)
+            {
+                uint32_t length = (bs->max_length > 0) ? bs->max_length :
+                                  (bs->nominal_length > 0) ? bs->nominal_length : bs->min_length;
+                if (bs->min_length == 0)
+                    bs->min_length      = length;
+                if (bs->max_length == 0)
+                    bs->max_length      = length;
+                if (bs->nominal_length == 0)
+                    bs->nominal_length  = length;
+            }
+
+            // Validate the guarantees
+            bool valid = ((bs->max_length == 0) || (bs->min_length <= bs->max_length));
+            if ((valid) && (bs->flags & BLOCK_FIXED))
+                valid = (bs->min_length > 0) && (bs->min_length == bs->max_length);
+            if ((valid) && (bs->flags & BLOCK_POWER_OF_2))
+                valid = ((bs->min_length == 0) || (is_power_of_2(bs->min_length))) &&
+                        ((bs->max_length == 0) || (is_power_of_2(bs->max_length)));
+
+            if (!valid)
+            {
+                bs->flags      &= ~uint32_t(BLOCK_FIXED | BLOCK_POWER_OF_2);
+                return STATUS_BAD_FORMAT;
+            }
+
+            return STATUS_OK;
+        }
+
+        uint32_t block_size_quantum(const block_size_t *bs)
+        {
+            // Fixed block length
+            if ((bs->flags & BLOCK_FIXED) && (bs->max_length > 0))
+                return bs->max_length;
+
+            // All lengths are powers of 2 not less than the minimum one
+            if ((bs->flags & BLOCK_POWER_OF_2) && (is_power_of_2(bs->min_length)))
+                return bs->min_length;
+
+            return 0;
+        }
+
+    } /* namespace lv2 */
+} /* namespace lsp */
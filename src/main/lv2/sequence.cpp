@@ -0,0 +1,471 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/sequence.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <lv2/atom/util.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        static constexpr size_t MOVE_BUFFER_SIZE    = 256;      // Size of the stack buffer for moving events
+
+        template <class T>
+        struct merge_cursor_t
+        {
+            const LV2_Atom_Event   *ev;         // Current event
+            const uint8_t          *end;        // End of the sequence
+            T                       time;       // Time stamp of the current event
+            size_t                  index;      // Index of the sequence
+        };
+
+        template <class T>
+        static inline T event_time(const LV2_Atom_Event *ev);
+
+        template <>
+        inline int64_t event_time<int64_t>(const LV2_Atom_Event *ev)
+        {
+            return ev->time.frames;
+        }
+
+        template <>
+        inline double event_time<double>(const LV2_Atom_Event *ev)
+        {
+            return ev->time.beats;
+        }
+
+        static inline size_t event_stride(const LV2_Atom_Event *ev)
+        {
+            return sizeof(LV2_Atom_Event) + lv2_atom_pad_size(ev->body.size);
+        }
+
+        static inline const LV2_Atom_Event *valid_event(const uint8_t *ptr, const uint8_t *end)
+        {
+            if ((ptr >= end) || (size_t(end - ptr) < sizeof(LV2_Atom_Event)))
+                return NULL;
+            const LV2_Atom_Event *ev = reinterpret_cast<const LV2_Atom_Event *>(ptr);
+            return (size_t(end - ptr) - sizeof(LV2_Atom_Event) >= ev->body.size) ? ev : NULL;
+        }
+
+        static inline const uint8_t *sequence_begin(const LV2_Atom_Sequence *seq)
+        {
+            return reinterpret_cast<const uint8_t *>(&seq->body + 1);
+        }
+
+        static inline const uint8_t *sequence_end(const LV2_Atom_Sequence *seq)
+        {
+            return (seq->atom.size >= sizeof(LV2_Atom_Sequence_Body)) ?
+                reinterpret_cast<const uint8_t *>(&seq->body) + seq->atom.size :
+                sequence_begin(seq);
+        }
+
+        static inline bool is_beat_time(uint32_t unit, LV2_URID beat_time)
+        {
+            return (beat_time != 0) && (unit == beat_time);
+        }
+
+        template <class T>
+        static inline bool cursor_less(const merge_cursor_t<T> *a, const merge_cursor_t<T> *b)
+        {
+            return (a->time < b->time) || ((a->time == b->time) && (a->index < b->index));
+        }
+
+        template <class T>
+        static void sift_down(merge_cursor_t<T> **heap, size_t count, size_t i)
+        {
+            merge_cursor_t<T> *c = heap[i];
+            while (true)
+            {
+                size_t child    = i * 2 + 1;
+                if (child >= count)
+                    break;
+                if ((child + 1 < count) && (cursor_less(heap[child + 1], heap[child])))
+                    ++child;
+                if (!cursor_less(heap[child], c))
+                    break;
+                heap[i]         = heap[child];
+                i               = child;
+            }
+            heap[i]         = c;
+        }
+
+        template <class T>
+        static status_t merge_sequences(
+            LV2_Atom_Sequence *dst, uint32_t capacity,
+            const LV2_Atom_Sequence * const *src, size_t count,
+            merge_cursor_t<T> *cursors, merge_cursor_t<T> **heap)
+        {
+            // Initialize heap
+            size_t n = 0;
+            for (size_t i=0; i<count; ++i)
+            {
+                if (src[i] == NULL)
+                    continue;
+
+                merge_cursor_t<T> *c    = &cursors[n];
+                c->end                  = sequence_end(src[i]);
+                c->ev                   = valid_event(sequence_begin(src[i]), c->end);
+                if (c->ev == NULL)
+                    continue;
+                c->time                 = event_time<T>(c->ev);
+                c->index                = i;
+                heap[n++]               = c;
+            }
+            for (size_t i = n >> 1; i > 0; )
+                sift_down(heap, n, --i);
+
+            // Merge events, copy runs of events of the same input preceding events of other inputs at once
+            uint8_t *out    = reinterpret_cast<uint8_t *>(&dst->body);
+            uint32_t size   = sizeof(LV2_Atom_Sequence_Body);
+            while (n > 0)
+            {
+                merge_cursor_t<T> *top  = heap[0];
+                const merge_cursor_t<T> *bound =
+                    (n <= 1) ? NULL :
+                    (n <= 2) ? heap[1] :
+                    (cursor_less(heap[2], heap[1])) ? heap[2] : heap[1];
+
+                const uint8_t *first    = reinterpret_cast<const uint8_t *>(top->ev);
+                const uint8_t *last;
+                do
+                {
+                    last                    = reinterpret_cast<const uint8_t *>(top->ev) + sizeof(LV2_Atom_Event) + top->ev->body.size;
+                    top->ev                 = valid_event(reinterpret_cast<const uint8_t *>(top->ev) + event_stride(top->ev), top->end);
+                    if (top->ev == NULL)
+                        break;
+                    top->time               = event_time<T>(top->ev);
+                } while ((bound == NULL) || (cursor_less(top, bound)));
+
+                // Emit the run
+                const uint32_t bytes    = last - first;
+                const uint32_t padded   = lv2_atom_pad_size(bytes);
+                if ((size > capacity) || (capacity - size < padded))
+                {
+                    // Emit the fitting part of the run, the padding should fit too
+                    for (const LV2_Atom_Event *ev = reinterpret_cast<const LV2_Atom_Event *>(first); ; )
+                    {
+                        const uint32_t total    = sizeof(LV2_Atom_Event) + ev->body.size;
+                        if ((size > capacity) || (capacity - size < lv2_atom_pad_size(total)))
+                            break;
+                        memcpy(&out[size], ev, total);
+                        size                   += lv2_atom_pad_size(total);
+                        ev                      = reinterpret_cast<const LV2_Atom_Event *>(reinterpret_cast<const uint8_t *>(ev) + event_stride(ev));
+                    }
+
+                    dst->atom.size      = size;
+                    return STATUS_OVERFLOW;
+                }
+
+                memcpy(&out[size], first, bytes);
+                size                   += padded;
+
+                // Update the heap
+                if ((top->ev == NULL) && (--n > 0))
+                    heap[0]                 = heap[n];
+                if (n > 1)
+                    sift_down(heap, n, 0);
+            }
+
+            dst->atom.size  = size;
+            return STATUS_OK;
+        }
+
+        template <class T>
+        static status_t merge_sequences(
+            LV2_Atom_Sequence *dst, uint32_t capacity,
+            const LV2_Atom_Sequence * const *src, size_t count)
+        {
+            if (count <= SEQUENCE_MERGE_INPUTS)
+            {
+                merge_cursor_t<T> cursors[SEQUENCE_MERGE_INPUTS];
+                merge_cursor_t<T> *heap[SEQUENCE_MERGE_INPUTS];
+                return merge_sequences(dst, capacity, src, count, cursors, heap);
+            }
+
+            uint8_t *data = static_cast<uint8_t *>(malloc(count * (sizeof(merge_cursor_t<T>) + sizeof(merge_cursor_t<T> *))));
+            if (data == NULL)
+                return STATUS_NO_MEM;
+            merge_cursor_t<T> *cursors  = reinterpret_cast<merge_cursor_t<T> *>(data);
+            merge_cursor_t<T> **heap    = reinterpret_cast<merge_cursor_t<T> **>(&cursors[count]);
+            const status_t res = merge_sequences(dst, capacity, src, count, cursors, heap);
+            free(data);
+            return res;
+        }
+
+        status_t sequence_merge(
+            LV2_Atom_Sequence *dst, uint32_t capacity,
+            const LV2_Atom_Sequence * const *src, size_t count,
+            LV2_URID beat_time)
+        {
+            if ((dst == NULL) || ((src == NULL) && (count > 0)))
+                return STATUS_BAD_ARGUMENTS;
+            if (capacity < sizeof(LV2_Atom_Sequence_Body))
+                return STATUS_OVERFLOW;
+
+            // Check time units of inputs
+            const LV2_Atom_Sequence *first = NULL;
+            for (size_t i=0; i<count; ++i)
+            {
+                const LV2_Atom_Sequence *seq = src[i];
+                if (seq == NULL)
+                    continue;
+                if (seq == dst)
+                    return STATUS_BAD_ARGUMENTS;
+                if (first == NULL)
+                    first           = seq;
+                else if (seq->atom.size <= sizeof(LV2_Atom_Sequence_Body))
+                    continue;
+                else if (first->atom.size <= sizeof(LV2_Atom_Sequence_Body))
+                    first           = seq;
+                else if (is_beat_time(seq->body.unit, beat_time) != is_beat_time(first->body.unit, beat_time))
+                    return STATUS_BAD_FORMAT;
+            }
+
+            dst->body.unit  = (first != NULL) ? first->body.unit : 0;
+            dst->body.pad   = 0;
+
+            return ((first != NULL) && (is_beat_time(first->body.unit, beat_time))) ?
+                merge_sequences<double>(dst, capacity, src, count) :
+                merge_sequences<int64_t>(dst, capacity, src, count);
+        }
+
+        template <class T>
+        static bool events_sorted(const uint8_t *ptr, const uint8_t *end)
+        {
+            const LV2_Atom_Event *ev = valid_event(ptr, end);
+            if (ev == NULL)
+                return true;
+
+            T prev = event_time<T>(ev);
+            for (ptr += event_stride(ev); (ev = valid_event(ptr, end)) != NULL; ptr += event_stride(ev))
+            {
+                const T t = event_time<T>(ev);
+                if (t < prev)
+                    return false;
+                prev = t;
+            }
+
+            return true;
+        }
+
+        bool sequence_is_sorted(const LV2_Atom_Sequence *seq, LV2_URID beat_time)
+        {
+            const uint8_t *begin    = sequence_begin(seq);
+            const uint8_t *end      = sequence_end(seq);
+            return (is_beat_time(seq->body.unit, beat_time)) ?
+                events_sorted<double>(begin, end) :
+                events_sorted<int64_t>(begin, end);
+        }
+
+        template <class T>
+        static const uint8_t *run_end(const uint8_t *ptr, const uint8_t *end)
+        {
+            const LV2_Atom_Event *ev = reinterpret_cast<const LV2_Atom_Event *>(ptr);
+            T prev = event_time<T>(ev);
+            for (ptr += event_stride(ev); ptr < end; ptr += event_stride(ev))
+            {
+                ev          = reinterpret_cast<const LV2_Atom_Event *>(ptr);
+                const T t   = event_time<T>(ev);
+                if (t < prev)
+                    break;
+                prev        = t;
+            }
+            return ptr;
+        }
+
+        template <class T>
+        static size_t count_runs(const uint8_t *ptr, const uint8_t *end)
+        {
+            size_t runs = 0;
+            for ( ; ptr < end; ++runs)
+                ptr = run_end<T>(ptr, end);
+            return runs;
+        }
+
+        template <class T>
+        static size_t merge_runs(uint8_t *dst, const uint8_t *src, size_t size)
+        {
+            const uint8_t *end = &src[size];
+            size_t runs = 0;
+
+            for (const uint8_t *ptr = src; ptr < end; ++runs)
+            {
+                const uint8_t *a        = ptr;
+                const uint8_t *a_end    = run_end<T>(a, end);
+                const uint8_t *b        = a_end;
+                const uint8_t *b_end    = (b < end) ? run_end<T>(b, end) : end;
+
+                // Merge two runs, prefer events of the first run for the stability
+                while ((a < a_end) && (b < b_end))
+                {
+                    const LV2_Atom_Event *ea = reinterpret_cast<const LV2_Atom_Event *>(a);
+                    const LV2_Atom_Event *eb = reinterpret_cast<const LV2_Atom_Event *>(b);
+                    if (event_time<T>(eb) < event_time<T>(ea))
+                    {
+                        const size_t stride = event_stride(eb);
+                        memcpy(dst, b, stride);
+                        b      += stride;
+                        dst    += stride;
+                    }
+                    else
+                    {
+                        const size_t stride = event_stride(ea);
+                        memcpy(dst, a, stride);
+                        a      += stride;
+                        dst    += stride;
+                    }
+                }
+
+                // Copy the tail
+                if (a < a_end)
+                {
+                    memcpy(dst, a, a_end - a);
+                    dst    += a_end - a;
+                }
+                if (b < b_end)
+                {
+                    memcpy(dst, b, b_end - b);
+                    dst    += b_end - b;
+                }
+
+                ptr     = b_end;
+            }
+
+            return runs;
+        }
+
+        static void reverse_bytes(uint8_t *first, uint8_t *last)
+        {
+            while (first < --last)
+            {
+                const uint8_t tmp   = *first;
+                *(first++)          = *last;
+                *last               = tmp;
+            }
+        }
+
+        static void move_event(uint8_t *dst, uint8_t *ev, size_t stride)
+        {
+            // Move event at ev to dst and shift events between them to the end
+            if (stride <= MOVE_BUFFER_SIZE)
+            {
+                uint64_t tmp[MOVE_BUFFER_SIZE / sizeof(uint64_t)];
+                memcpy(tmp, ev, stride);
+                memmove(&dst[stride], dst, ev - dst);
+                memcpy(dst, tmp, stride);
+            }
+            else
+            {
+                reverse_bytes(dst, ev);
+                reverse_bytes(ev, &ev[stride]);
+                reverse_bytes(dst, &ev[stride]);
+            }
+        }
+
+        template <class T>
+        static void insertion_sort(uint8_t *begin, uint8_t *end)
+        {
+            uint8_t *ptr    = begin;
+            T last          = event_time<T>(reinterpret_cast<const LV2_Atom_Event *>(ptr));
+
+            for (ptr += event_stride(reinterpret_cast<const LV2_Atom_Event *>(ptr)); ptr < end; )
+            {
+                const LV2_Atom_Event *ev = reinterpret_cast<const LV2_Atom_Event *>(ptr);
+                const size_t stride = event_stride(ev);
+                const T t           = event_time<T>(ev);
+                if (!(t < last))
+                {
+                    last                = t;
+                    ptr                += stride;
+                    continue;
+                }
+
+                // Find the first event with greater time stamp
+                uint8_t *pos        = begin;
+                while (!(t < event_time<T>(reinterpret_cast<const LV2_Atom_Event *>(pos))))
+                    pos                += event_stride(reinterpret_cast<const LV2_Atom_Event *>(pos));
+
+                move_event(pos, ptr, stride);
+                ptr                += stride;
+            }
+        }
+
+        template <class T>
+        static void sort_events(uint8_t *begin, uint8_t *end, uint8_t *scratch)
+        {
+            if (count_runs<T>(begin, end) <= 1)
+                return;
+
+            if (scratch == NULL)
+            {
+                insertion_sort<T>(begin, end);
+                return;
+            }
+
+            // Natural merge sort with ping-pong between the sequence and scratch buffer
+            const size_t size   = end - begin;
+            uint8_t *src        = begin;
+            uint8_t *dst        = scratch;
+            size_t runs;
+            do
+            {
+                runs                = merge_runs<T>(dst, src, size);
+                uint8_t *tmp        = src;
+                src                 = dst;
+                dst                 = tmp;
+            } while (runs > 1);
+
+            if (src != begin)
+                memcpy(begin, src, size);
+        }
+
+        status_t sequence_sort(LV2_Atom_Sequence *seq, LV2_URID beat_time, void *scratch)
+        {
+            if (seq == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            // Validate events, each event should be padded
+            uint8_t *begin          = const_cast<uint8_t *>(sequence_begin(seq));
+            uint8_t *end            = const_cast<uint8_t *>(sequence_end(seq));
+            for (uint8_t *ptr = begin; ptr < end; )
+            {
+                const LV2_Atom_Event *ev = valid_event(ptr, end);
+                if (ev == NULL)
+                    return STATUS_CORRUPTED;
+                const size_t stride = event_stride(ev);
+                if (size_t(end - ptr) < stride)
+                    return STATUS_CORRUPTED;
+                ptr                += stride;
+            }
+
+            if (is_beat_time(seq->body.unit, beat_time))
+                sort_events<double>(begin, end, static_cast<uint8_t *>(scratch));
+            else
+                sort_events<int64_t>(begin, end, static_cast<uint8_t *>(scratch));
+
+            return STATUS_OK;
+        }
+
+    } /* namespace lv2 */
+} /* namespace lsp */
@@ -0,0 +1,309 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/transport.h>
+#include <lsp-plug.in/3rdparty/lv2/uris.h>
+
+#include <lv2/atom/util.h>
+
+#include <stddef.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        static const uri_t transport_uris[] =
+        {
+            URI_ATOM__Blank,
+            URI_ATOM__Bool,
+            URI_ATOM__Double,
+            URI_ATOM__Float,
+            URI_ATOM__Int,
+            URI_ATOM__Long,
+            URI_ATOM__Object,
+            URI_TIME__Position,
+
+            // Keys in order of transport_field_t
+            URI_TIME__frame,
+            URI_TIME__speed,
+            URI_TIME__bar,
+            URI_TIME__barBeat,
+            URI_TIME__beat,
+            URI_TIME__beatUnit,
+            URI_TIME__beatsPerBar,
+            URI_TIME__beatsPerMinute,
+            URI_TIME__framesPerSecond
+        };
+
+        static_assert(
+            sizeof(transport_uris) / sizeof(uri_t) == offsetof(transport_urids_t, key_first) / sizeof(LV2_URID),
+            "List of URIs does not match the transport_urids_t structure");
+
+        status_t transport_urids_init(transport_urids_t *urids, const LV2_URID_Map *map)
+        {
+            LV2_URID v[sizeof(transport_uris) / sizeof(uri_t)];
+            const status_t res = map_uris(v, transport_uris, sizeof(transport_uris) / sizeof(uri_t), map);
+            if (res == STATUS_BAD_ARGUMENTS)
+                return res;
+
+            urids->atom_Blank       = v[0];
+            urids->atom_Bool        = v[1];
+            urids->atom_Double      = v[2];
+            urids->atom_Float       = v[3];
+            urids->atom_Int         = v[4];
+            urids->atom_Long        = v[5];
+            urids->atom_Object      = v[6];
+            urids->time_Position    = v[7];
+            for (size_t i=0; i<TRANSPORT_FIELDS; ++i)
+                urids->key[i]           = v[8 + i];
+
+            // Build direct lookup table if keys are mapped close to each other,
+            // that is always true for the URID maps seeded from the URI registry
+            LV2_URID first = urids->key[0], last = urids->key[0];
+            for (size_t i=1; i<TRANSPORT_FIELDS; ++i)
+            {
+                first   = lsp_min(first, urids->key[i]);
+                last    = lsp_max(last, urids->key[i]);
+            }
+
+            urids->key_first        = first;
+            urids->key_range        = ((res == STATUS_OK) && (last - first < TRANSPORT_KEY_RANGE)) ? last - first + 1 : 0;
+            for (size_t i=0; i<TRANSPORT_KEY_RANGE; ++i)
+                urids->key_index[i]     = TRANSPORT_FIELDS;
+            if (urids->key_range > 0)
+            {
+                for (size_t i=0; i<TRANSPORT_FIELDS; ++i)
+                    urids->key_index[urids->key[i] - first] = i;
+            }
+
+            return res;
+        }
+
+        void transport_reset(transport_t *t)
+        {
+            t->frame                = 0;
+            t->bar                  = 0;
+            t->beat                 = 0.0;
+            t->speed                = 0.0f;
+            t->bar_beat             = 0.0f;
+            t->beats_per_bar        = 4.0f;
+            t->beats_per_minute     = 120.0f;
+            t->frames_per_second    = 0.0f;
+            t->beat_unit            = 4;
+            t->fields               = 0;
+        }
+
+        static bool read_double(double *dst, const LV2_Atom *atom, const transport_urids_t *urids)
+        {
+            const void *body    = LV2_ATOM_BODY_CONST(atom);
+
+            if (atom->type == urids->atom_Float)
+            {
+                if (atom->size < sizeof(float))
+                    return false;
+                *dst                = *static_cast<const float *>(body);
+            }
+            else if (atom->type == urids->atom_Double)
+            {
+                if (atom->size < sizeof(double))
+                    return false;
+                *dst                = *static_cast<const double *>(body);
+            }
+            else if ((atom->type == urids->atom_Int) || (atom->type == urids->atom_Bool))
+            {
+                if (atom->size < sizeof(int32_t))
+                    return false;
+                *dst                = *static_cast<const int32_t *>(body);
+            }
+            else if (atom->type == urids->atom_Long)
+            {
+                if (atom->size < sizeof(int64_t))
+                    return false;
+                *dst                = double(*static_cast<const int64_t *>(body));
+            }
+            else
+                return false;
+
+            return true;
+        }
+
+        static bool read_long(int64_t *dst, const LV2_Atom *atom, const transport_urids_t *urids)
+        {
+            const void *body    = LV2_ATOM_BODY_CONST(atom);
+
+            if (atom->type == urids->atom_Long)
+            {
+                if (atom->size < sizeof(int64_t))
+                    return false;
+                *dst                = *static_cast<const int64_t *>(body);
+            }
+            else if ((atom->type == urids->atom_Int) || (atom->type == urids->atom_Bool))
+            {
+                if (atom->size < sizeof(int32_t))
+                    return false;
+                *dst                = *static_cast<const int32_t *>(body);
+            }
+            else
+            {
+                double v;
+                if (!read_double(&v, atom, urids))
+                    return false;
+                *dst                = int64_t(v);
+            }
+
+            return true;
+        }
+
+        template <class T>
+        static inline uint32_t update_field(T *dst, T value, uint32_t mask)
+        {
+            if (*dst == value)
+                return 0;
+            *dst    = value;
+            return mask;
+        }
+
+        static inline size_t find_field(LV2_URID key, const transport_urids_t *urids)
+        {
+            if (urids->key_range > 0)
+            {
+                const uint32_t index = key - urids->key_first;
+                return (index < urids->key_range) ? urids->key_index[index] : size_t(TRANSPORT_FIELDS);
+            }
+
+            size_t field = 0;
+            while ((field < TRANSPORT_FIELDS) && (urids->key[field] != key))
+                ++field;
+            return field;
+        }
+
+        uint32_t transport_decode(transport_t *t, const LV2_Atom *atom, const transport_urids_t *urids)
+        {
+            if ((atom->type != urids->atom_Object) && (atom->type != urids->atom_Blank))
+                return 0;
+            if (atom->size < sizeof(LV2_Atom_Object_Body))
+                return 0;
+
+            const LV2_Atom_Object *obj  = reinterpret_cast<const LV2_Atom_Object *>(atom);
+            if (obj->body.otype != urids->time_Position)
+                return 0;
+
+            uint32_t changed = 0, present = 0;
+            int64_t lv;
+            double dv;
+
+            LV2_ATOM_OBJECT_FOREACH(obj, prop)
+            {
+                const size_t field      = find_field(prop->key, urids);
+                if (field >= TRANSPORT_FIELDS)
+                    continue;
+
+                const LV2_Atom *value   = &prop->value;
+                const uint32_t mask     = 1 << field;
+
+                switch (field)
+                {
+                    case TRANSPORT_FRAME:
+                        if (!read_long(&lv, value, urids))
+                            continue;
+                        changed    |= update_field(&t->frame, lv, mask);
+                        break;
+                    case TRANSPORT_BAR:
+                        if (!read_long(&lv, value, urids))
+                            continue;
+                        changed    |= update_field(&t->bar, lv, mask);
+                        break;
+                    case TRANSPORT_BEAT:
+                        if (!read_double(&dv, value, urids))
+                            continue;
+                        changed    |= update_field(&t->beat, dv, mask);
+                        break;
+                    case TRANSPORT_BEAT_UNIT:
+                        if (!read_long(&lv, value, urids))
+                            continue;
+                        changed    |= update_field(&t->beat_unit, int32_t(lv), mask);
+                        break;
+                    default:
+                    {
+                        if (!read_double(&dv, value, urids))
+                            continue;
+
+                        float *dst =
+                            (field == TRANSPORT_SPEED) ? &t->speed :
+                            (field == TRANSPORT_BAR_BEAT) ? &t->bar_beat :
+                            (field == TRANSPORT_BEATS_PER_BAR) ? &t->beats_per_bar :
+                            (field == TRANSPORT_BEATS_PER_MINUTE) ? &t->beats_per_minute :
+                            &t->frames_per_second;
+                        changed    |= update_field(dst, float(dv), mask);
+                        break;
+                    }
+                }
+
+                present    |= mask;
+            }
+
+            // Fields received for the first time are always reported as changed
+            changed    |= present & (~t->fields);
+            t->fields  |= present;
+
+            return changed;
+        }
+
+        LV2_Atom_Forge_Ref transport_encode(
+            LV2_Atom_Forge *forge, const transport_t *t, uint32_t fields,
+            const transport_urids_t *urids)
+        {
+            LV2_Atom_Forge_Frame frame;
+            LV2_Atom_Forge_Ref ref  = lv2_atom_forge_object(forge, &frame, 0, urids->time_Position);
+            if (!ref)
+                return 0;
+
+            bool ok = true;
+            fields &= t->fields;
+            for (size_t field=0; (ok) && (field < TRANSPORT_FIELDS); ++field)
+            {
+                if (!(fields & (1 << field)))
+                    continue;
+
+                ok = lv2_atom_forge_key(forge, urids->key[field]);
+                if (!ok)
+                    break;
+
+                switch (field)
+                {
+                    case TRANSPORT_FRAME:               ok = lv2_atom_forge_long(forge, t->frame); break;
+                    case TRANSPORT_SPEED:               ok = lv2_atom_forge_float(forge, t->speed); break;
+                    case TRANSPORT_BAR:                 ok = lv2_atom_forge_long(forge, t->bar); break;
+                    case TRANSPORT_BAR_BEAT:            ok = lv2_atom_forge_float(forge, t->bar_beat); break;
+                    case TRANSPORT_BEAT:                ok = lv2_atom_forge_double(forge, t->beat); break;
+                    case TRANSPORT_BEAT_UNIT:           ok = lv2_atom_forge_int(forge, t->beat_unit); break;
+                    case TRANSPORT_BEATS_PER_BAR:       ok = lv2_atom_forge_float(forge, t->beats_per_bar); break;
+                    case TRANSPORT_BEATS_PER_MINUTE:    ok = lv2_atom_forge_float(forge, t->beats_per_minute); break;
+                    default:                            ok = lv2_atom_forge_float(forge, t->frames_per_second); break;
+                }
+            }
+
+            lv2_atom_forge_pop(forge, &frame);
+            return (ok) ? ref : 0;
+        }
+
+    } /* namespace lv2 */
+} /* namespace lsp */
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/uris.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <stddef.h>
+
+namespace lsp
+{
+    namespace lv2
+    {
+        const uri_strings_t uri_strings =
+        {
+        #define LSP_LV2_URI(id, uri)    uri,
+        #include <lsp-plug.in/3rdparty/lv2/uri_list.h>
+        #undef LSP_LV2_URI
+        };
+
+        constexpr uint32_t uri_offsets[URI_COUNT] =
+        {
+        #define LSP_LV2_URI(id, uri)    offsetof(uri_strings_t, id),
+        #include <lsp-plug.in/3rdparty/lv2/uri_list.h>
+        #undef LSP_LV2_URI
+        };
+
+        static_assert(sizeof(uri_strings_t) < 0x10000, "Registry strings are too large");
+
+        ssize_t uri_index(const char *uri)
+        {
+            const uintptr_t base    = reinterpret_cast<uintptr_t>(&uri_strings);
+            const uintptr_t ptr     = reinterpret_cast<uintptr_t>(uri);
+            if ((ptr < base) || (ptr >= base + sizeof(uri_strings_t)))
+                return -1;
+
+            // Binary search of the offset
+            const uint32_t offset   = uint32_t(ptr - base);
+            ssize_t first = 0, last = URI_COUNT - 1;
+            while (first <= last)
+            {
+                const ssize_t mid       = (first + last) >> 1;
+                const uint32_t off      = uri_offsets[mid];
+                if (off == offset)
+                    return mid;
+                else if (off < offset)
+                    first                   = mid + 1;
+                else
+                    last                    = mid - 1;
+            }
+
+            return -1;
+        }
+
+        status_t map_uris(LV2_URID *urids, const uri_t *ids, size_t count, const LV2_URID_Map *map)
+        {
+            if ((map == NULL) || (map->map == NULL))
+                return STATUS_BAD_ARGUMENTS;
+
+            status_t res = STATUS_OK;
+            for (size_t i=0; i<count; ++i)
+            {
+                urids[i]        = map->map(map->handle, uri_string(ids[i]));
+                if (urids[i] == 0)
+                    res             = STATUS_NOT_FOUND;
+            }
+
+            return res;
+        }
+
+        status_t map_uri_bundle(urid_bundle_t *bundle, const LV2_URID_Map *map)
+        {
+            if ((map == NULL) || (map->map == NULL))
+                return STATUS_BAD_ARGUMENTS;
+
+            status_t res = STATUS_OK;
+            for (size_t i=0; i<URI_COUNT; ++i)
+            {
+                bundle->urid[i] = map->map(map->handle, uri_string(uri_t(i)));
+                if (bundle->urid[i] == 0)
+                    res             = STATUS_NOT_FOUND;
+            }
+
+            return res;
+        }
+
+    } /* namespace lv2 */
+} /* namespace lsp */
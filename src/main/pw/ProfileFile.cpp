@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/pw/ProfileFile.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+namespace lsp
+{
+    namespace pw
+    {
+        static const uint8_t profile_padding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+        ProfileFile::ProfileFile()
+        {
+            pFD             = NULL;
+            bClose          = false;
+            pBuf            = NULL;
+            nBufSize        = 0;
+        }
+
+        ProfileFile::~ProfileFile()
+        {
+            close();
+        }
+
+        status_t ProfileFile::open(const char *path, bool write)
+        {
+            if (path == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            if (pFD != NULL)
+                return STATUS_OPENED;
+
+            FILE *fd = fopen(path, (write) ? "wb" : "rb");
+            if (fd == NULL)
+                return STATUS_IO_ERROR;
+
+            pFD             = fd;
+            bClose          = true;
+            return STATUS_OK;
+        }
+
+        status_t ProfileFile::wrap(FILE *fd, bool close)
+        {
+            if (fd == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            if (pFD != NULL)
+                return STATUS_OPENED;
+
+            pFD             = fd;
+            bClose          = close;
+            return STATUS_OK;
+        }
+
+        status_t ProfileFile::close()
+        {
+            status_t res = STATUS_OK;
+            if (pFD != NULL)
+            {
+                if (bClose)
+                {
+                    if (fclose(pFD) != 0)
+                        res             = STATUS_IO_ERROR;
+                }
+                else if (fflush(pFD) != 0)
+                    res             = STATUS_IO_ERROR;
+                pFD             = NULL;
+            }
+            if (pBuf != NULL)
+            {
+                free(pBuf);
+                pBuf            = NULL;
+            }
+            nBufSize        = 0;
+
+            return res;
+        }
+
+        status_t ProfileFile::write(const struct spa_pod *pod)
+        {
+            if (pod == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            if (pFD == NULL)
+                return STATUS_CLOSED;
+
+            if (!SPA_POD_IS_VALID(pod))
+                return STATUS_TOO_BIG;
+            const size_t size   = SPA_POD_SIZE(pod);
+            const size_t pad    = ((size + 7) & ~size_t(7)) - size;
+
+            if (fwrite(pod, size, 1, pFD) != 1)
+                return STATUS_IO_ERROR;
+            if ((pad > 0) && (fwrite(profile_padding, pad, 1, pFD) != 1))
+                return STATUS_IO_ERROR;
+
+            return STATUS_OK;
+        }
+
+        status_t ProfileFile::read(const struct spa_pod **pod)
+        {
+            if (pod == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            if (pFD == NULL)
+                return STATUS_CLOSED;
+
+            // Read the header
+            struct spa_pod hdr;
+            const size_t n      = fread(&hdr, 1, sizeof(hdr), pFD);
+            if (n == 0)
+                return (ferror(pFD)) ? STATUS_IO_ERROR : STATUS_EOF;
+            if (n != sizeof(hdr))
+                return STATUS_CORRUPTED;
+
+            if (!SPA_POD_IS_VALID(&hdr))
+                return STATUS_CORRUPTED;
+            const size_t size   = SPA_POD_SIZE(&hdr);
+            const size_t padded = ((size + 7) & ~size_t(7));
+
+            // Ensure that the buffer has enough space
+            if (padded > nBufSize)
+            {
+                size_t cap          = lsp_max(nBufSize, size_t(0x1000));
+                while (cap < padded)
+                    cap                <<= 1;
+                uint8_t *buf        = static_cast<uint8_t *>(realloc(pBuf, cap));
+                if (buf == NULL)
+                    return STATUS_NO_MEM;
+                pBuf                = buf;
+                nBufSize            = cap;
+            }
+
+            // Read the body
+            memcpy(pBuf, &hdr, sizeof(hdr));
+            const size_t body   = padded - sizeof(hdr);
+            if ((body > 0) && (fread(&pBuf[sizeof(hdr)], body, 1, pFD) != 1))
+                return (ferror(pFD)) ? STATUS_IO_ERROR : STATUS_CORRUPTED;
+
+            *pod                = reinterpret_cast<const struct spa_pod *>(pBuf);
+            return STATUS_OK;
+        }
+
+    } /* namespace pw */
+} /* namespace lsp */
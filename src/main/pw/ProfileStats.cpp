@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/pw/ProfileStats.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+namespace lsp
+{
+    namespace pw
+    {
+        constexpr size_t ProfileStats::HIST_LINEAR;
+        constexpr size_t ProfileStats::HIST_SUBBITS;
+        constexpr size_t ProfileStats::HIST_OCTAVES;
+        constexpr size_t ProfileStats::HIST_BUCKETS;
+
+        ProfileStats::ProfileStats()
+        {
+            vNodes          = NULL;
+            nNodes          = 0;
+        }
+
+        ProfileStats::~ProfileStats()
+        {
+            reset();
+        }
+
+        void ProfileStats::reset()
+        {
+            if (vNodes != NULL)
+            {
+                for (size_t i=0; i<nNodes; ++i)
+                {
+                    node_t *n = vNodes[i];
+                    if (n == NULL)
+                        continue;
+                    free(n->name);
+                    free(n);
+                }
+                free(vNodes);
+                vNodes          = NULL;
+            }
+            nNodes          = 0;
+        }
+
+        size_t ProfileStats::bucket(int64_t value)
+        {
+            if (value < int64_t(HIST_LINEAR))
+                return (value > 0) ? size_t(value) : 0;
+
+            const uint64_t v    = uint64_t(value);
+            const size_t octave = (63 - __builtin_clzll(v)) - HIST_SUBBITS - 1;
+            if (octave >= HIST_OCTAVES)
+                return HIST_BUCKETS - 1;
+
+            const size_t sub    = (v >> (octave + 1)) & ((1 << HIST_SUBBITS) - 1);
+            return HIST_LINEAR + (octave << HIST_SUBBITS) + sub;
+        }
+
+        int64_t ProfileStats::bucket_limit(size_t bucket)
+        {
+            if (bucket < HIST_LINEAR)
+                return bucket;
+
+            bucket             -= HIST_LINEAR;
+            const size_t octave = bucket >> HIST_SUBBITS;
+            const size_t sub    = bucket & ((1 << HIST_SUBBITS) - 1);
+            const uint64_t low  = uint64_t((1 << HIST_SUBBITS) + sub) << (octave + 1);
+
+            return int64_t(low + (uint64_t(1) << (octave + 1)) - 1);
+        }
+
+        int64_t ProfileStats::percentile(const uint32_t *hist, uint64_t samples, int64_t max, double p)
+        {
+            if (samples == 0)
+                return 0;
+
+            // Rank of the sample, 1-based
+            uint64_t rank       = uint64_t(p * samples + 0.5);
+            rank                = lsp_max(rank, uint64_t(1));
+            rank                = lsp_min(rank, samples);
+
+            uint64_t count      = 0;
+            for (size_t i=0; i<HIST_BUCKETS; ++i)
+            {
+                count              += hist[i];
+                if (count >= rank)
+                    return lsp_min(bucket_limit(i), max);
+            }
+
+            return max;
+        }
+
+        status_t ProfileStats::sync_nodes(const ProfileTable *table)
+        {
+            const size_t count  = table->nodes();
+            if (count > nNodes)
+            {
+                node_t **vn         = static_cast<node_t **>(realloc(vNodes, count * sizeof(node_t *)));
+                if (vn == NULL)
+                    return STATUS_NO_MEM;
+                vNodes              = vn;
+
+                for (size_t i=nNodes; i<count; ++i)
+                {
+                    node_t *n           = static_cast<node_t *>(malloc(sizeof(node_t)));
+                    if (n == NULL)
+                        return STATUS_NO_MEM;
+                    memset(n, 0, sizeof(node_t));
+                    n->id               = table->node_id(i);
+                    vNodes[nNodes++]    = n;
+                }
+            }
+
+            // Keep the actual names of nodes
+            for (size_t i=0; i<nNodes; ++i)
+            {
+                node_t *n           = vNodes[i];
+                const char *name    = table->node_name(i);
+                if (name == NULL)
+                    continue;
+                if ((n->name != NULL) && (strcmp(n->name, name) == 0))
+                    continue;
+
+                char *s             = strdup(name);
+                if (s == NULL)
+                    return STATUS_NO_MEM;
+                free(n->name);
+                n->name             = s;
+                n->id               = table->node_id(i);
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t ProfileStats::update(const ProfileTable *table)
+        {
+            if (table == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            status_t res = sync_nodes(table);
+            if (res != STATUS_OK)
+                return res;
+
+            const size_t rows       = table->size();
+            const uint32_t *vnode   = table->node();
+            const uint32_t *vflags  = table->flags();
+            const int64_t *vsignal  = table->signal();
+            const int64_t *vawake   = table->awake();
+            const int64_t *vfinish  = table->finish();
+
+            for (size_t i=0; i<rows; ++i)
+            {
+                node_t *n           = vNodes[vnode[i]];
+                const uint32_t f    = vflags[i];
+
+                ++n->cycles;
+                if (f & ProfileTable::F_DRIVER)
+                    n->driver           = true;
+                if (f & ProfileTable::F_OVERRUN)
+                    ++n->overruns;
+                if (f & ProfileTable::F_BLAMED)
+                    ++n->xruns;
+                if (!(f & ProfileTable::F_FINISHED))
+                {
+                    ++n->incomplete;
+                    continue;
+                }
+
+                const int64_t wakeup    = vawake[i] - vsignal[i];
+                const int64_t process   = vfinish[i] - vawake[i];
+                ++n->wakeup[bucket(wakeup)];
+                ++n->process[bucket(process)];
+                n->wakeup_max           = lsp_max(n->wakeup_max, wakeup);
+                n->process_max          = lsp_max(n->process_max, process);
+                ++n->samples;
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t ProfileStats::append(ProfileTable *table, const struct spa_pod *pod)
+        {
+            if (table == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            status_t res = table->append(pod);
+            if (res != STATUS_OVERFLOW)
+                return res;
+
+            // Consume the table and retry
+            if ((res = update(table)) != STATUS_OK)
+                return res;
+            table->clear();
+
+            return table->append(pod);
+        }
+
+        status_t ProfileStats::get(size_t index, profile_stats_t *dst) const
+        {
+            if (dst == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            if (index >= nNodes)
+                return STATUS_NOT_FOUND;
+
+            const node_t *n     = vNodes[index];
+            dst->id             = n->id;
+            dst->name           = n->name;
+            dst->driver         = n->driver;
+            dst->cycles         = n->cycles;
+            dst->incomplete     = n->incomplete;
+            dst->overruns       = n->overruns;
+            dst->xruns          = n->xruns;
+            dst->wakeup_p50     = percentile(n->wakeup, n->samples, n->wakeup_max, 0.50);
+            dst->wakeup_p99     = percentile(n->wakeup, n->samples, n->wakeup_max, 0.99);
+            dst->wakeup_max     = n->wakeup_max;
+            dst->process_p50    = percentile(n->process, n->samples, n->process_max, 0.50);
+            dst->process_p99    = percentile(n->process, n->samples, n->process_max, 0.99);
+            dst->process_max    = n->process_max;
+
+            return STATUS_OK;
+        }
+
+    } /* namespace pw */
+} /* namespace lsp */
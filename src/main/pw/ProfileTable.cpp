@@ -0,0 +1,595 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/pw/ProfileTable.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <pw-headers/spa/param/profiler.h>
+#include <pw-headers/spa/pod/iter.h>
+#include <pw-headers/spa/pod/parser.h>
+#include <pw-headers/spa/utils/type.h>
+
+namespace lsp
+{
+    namespace pw
+    {
+        static constexpr size_t PROFILE_MIN_BINS        = 64;
+        static constexpr int32_t PROFILE_STATUS_FINISHED = 3;
+
+        namespace
+        {
+            /**
+             * Contents of the driver or follower block
+             */
+            typedef struct block_t
+            {
+                int32_t             id;
+                const char         *name;
+                int64_t             prev_signal;
+                int64_t             signal;
+                int64_t             awake;
+                int64_t             finish;
+                int32_t             status;
+                struct spa_fraction latency;
+                int32_t             xruns;
+                bool                async;
+            } block_t;
+
+            inline bool is_block(uint32_t key)
+            {
+                return (key == SPA_PROFILER_driverBlock) || (key == SPA_PROFILER_followerBlock);
+            }
+
+            inline uint32_t hash_id(uint32_t id)
+            {
+                return id * 0x9e3779b1U;
+            }
+
+            status_t parse_block(block_t *b, const struct spa_pod *pod)
+            {
+                struct spa_pod_parser p;
+                struct spa_pod_frame f;
+
+                b->latency      = SPA_FRACTION(0, 0);
+                b->xruns        = -1;
+                b->async        = false;
+
+                spa_pod_parser_pod(&p, pod);
+                if (spa_pod_parser_push_struct(&p, &f) < 0)
+                    return STATUS_BAD_FORMAT;
+                if ((spa_pod_parser_get_int(&p, &b->id) < 0) ||
+                    (spa_pod_parser_get_string(&p, &b->name) < 0) ||
+                    (spa_pod_parser_get_long(&p, &b->prev_signal) < 0) ||
+                    (spa_pod_parser_get_long(&p, &b->signal) < 0) ||
+                    (spa_pod_parser_get_long(&p, &b->awake) < 0) ||
+                    (spa_pod_parser_get_long(&p, &b->finish) < 0) ||
+                    (spa_pod_parser_get_int(&p, &b->status) < 0))
+                    return STATUS_BAD_FORMAT;
+
+                // Fields added in later versions of the profiler
+                if (spa_pod_parser_get_fraction(&p, &b->latency) >= 0)
+                {
+                    if (spa_pod_parser_get_int(&p, &b->xruns) >= 0)
+                        spa_pod_parser_get_bool(&p, &b->async);
+                }
+
+                return STATUS_OK;
+            }
+
+            status_t parse_info(uint64_t *counter, int32_t *xruns, const struct spa_pod *pod)
+            {
+                struct spa_pod_parser p;
+                struct spa_pod_frame f;
+                int64_t cnt;
+                float load[3];
+
+                spa_pod_parser_pod(&p, pod);
+                if (spa_pod_parser_push_struct(&p, &f) < 0)
+                    return STATUS_BAD_FORMAT;
+                if ((spa_pod_parser_get_long(&p, &cnt) < 0) ||
+                    (spa_pod_parser_get_float(&p, &load[0]) < 0) ||
+                    (spa_pod_parser_get_float(&p, &load[1]) < 0) ||
+                    (spa_pod_parser_get_float(&p, &load[2]) < 0))
+                    return STATUS_BAD_FORMAT;
+
+                *counter    = uint64_t(cnt);
+                if (spa_pod_parser_get_int(&p, xruns) < 0)
+                    *xruns      = -1;
+
+                return STATUS_OK;
+            }
+
+            status_t parse_clock(int64_t *quantum, bool *xrun, const struct spa_pod *pod)
+            {
+                struct spa_pod_parser p;
+                struct spa_pod_frame f;
+                int32_t flags, id, transport, cycle;
+                const char *name;
+                int64_t nsec, position, duration, delay, next_nsec, xrun_duration;
+                struct spa_fraction rate;
+                double rate_diff;
+
+                spa_pod_parser_pod(&p, pod);
+                if (spa_pod_parser_push_struct(&p, &f) < 0)
+                    return STATUS_BAD_FORMAT;
+                if ((spa_pod_parser_get_int(&p, &flags) < 0) ||
+                    (spa_pod_parser_get_int(&p, &id) < 0) ||
+                    (spa_pod_parser_get_string(&p, &name) < 0) ||
+                    (spa_pod_parser_get_long(&p, &nsec) < 0) ||
+                    (spa_pod_parser_get_fraction(&p, &rate) < 0) ||
+                    (spa_pod_parser_get_long(&p, &position) < 0) ||
+                    (spa_pod_parser_get_long(&p, &duration) < 0) ||
+                    (spa_pod_parser_get_long(&p, &delay) < 0) ||
+                    (spa_pod_parser_get_double(&p, &rate_diff) < 0) ||
+                    (spa_pod_parser_get_long(&p, &next_nsec) < 0))
+                    return STATUS_BAD_FORMAT;
+
+                // Duration of the quantum: duration * rate seconds
+                *quantum    = ((rate.denom > 0) && (duration > 0)) ?
+                    int64_t((double(duration) * rate.num * 1e9) / rate.denom) : 0;
+
+                // Fields added in later versions of the profiler
+                *xrun       = false;
+                if ((spa_pod_parser_get_int(&p, &transport) >= 0) &&
+                    (spa_pod_parser_get_int(&p, &cycle) >= 0) &&
+                    (spa_pod_parser_get_long(&p, &xrun_duration) >= 0))
+                    *xrun       = xrun_duration > 0;
+
+                return STATUS_OK;
+            }
+        } /* namespace */
+
+        ProfileTable::ProfileTable()
+        {
+            nRows           = 0;
+            nCapacity       = 0;
+            vCycle          = NULL;
+            vDriver         = NULL;
+            vNode           = NULL;
+            vSignal         = NULL;
+            vAwake          = NULL;
+            vFinish         = NULL;
+            vQuantum        = NULL;
+            vStatus         = NULL;
+            vFlags          = NULL;
+            pData           = NULL;
+
+            vNodes          = NULL;
+            nNodes          = 0;
+            nNodeCap        = 0;
+            vBins           = NULL;
+            nBins           = 0;
+        }
+
+        ProfileTable::~ProfileTable()
+        {
+            destroy();
+        }
+
+        status_t ProfileTable::init(size_t capacity)
+        {
+            if (capacity == 0)
+                return STATUS_BAD_ARGUMENTS;
+
+            destroy();
+
+            // Columns with 64-bit values go first to keep the alignment
+            const size_t size   = capacity * (sizeof(uint64_t) * 5 + sizeof(uint32_t) * 4);
+            uint8_t *ptr        = static_cast<uint8_t *>(malloc(size));
+            if (ptr == NULL)
+                return STATUS_NO_MEM;
+
+            pData               = ptr;
+            vCycle              = reinterpret_cast<uint64_t *>(ptr);
+            ptr                += capacity * sizeof(uint64_t);
+            vSignal             = reinterpret_cast<int64_t *>(ptr);
+            ptr                += capacity * sizeof(int64_t);
+            vAwake              = reinterpret_cast<int64_t *>(ptr);
+            ptr                += capacity * sizeof(int64_t);
+            vFinish             = reinterpret_cast<int64_t *>(ptr);
+            ptr                += capacity * sizeof(int64_t);
+            vQuantum            = reinterpret_cast<int64_t *>(ptr);
+            ptr                += capacity * sizeof(int64_t);
+            vDriver             = reinterpret_cast<uint32_t *>(ptr);
+            ptr                += capacity * sizeof(uint32_t);
+            vNode               = reinterpret_cast<uint32_t *>(ptr);
+            ptr                += capacity * sizeof(uint32_t);
+            vStatus             = reinterpret_cast<uint32_t *>(ptr);
+            ptr                += capacity * sizeof(uint32_t);
+            vFlags              = reinterpret_cast<uint32_t *>(ptr);
+
+            nCapacity           = capacity;
+            nRows               = 0;
+
+            return STATUS_OK;
+        }
+
+        void ProfileTable::destroy()
+        {
+            reset();
+
+            if (pData != NULL)
+            {
+                free(pData);
+                pData           = NULL;
+            }
+            vCycle          = NULL;
+            vDriver         = NULL;
+            vNode           = NULL;
+            vSignal         = NULL;
+            vAwake          = NULL;
+            vFinish         = NULL;
+            vQuantum        = NULL;
+            vStatus         = NULL;
+            vFlags          = NULL;
+            nCapacity       = 0;
+            nRows           = 0;
+        }
+
+        void ProfileTable::clear()
+        {
+            nRows           = 0;
+        }
+
+        void ProfileTable::reset()
+        {
+            nRows           = 0;
+
+            if (vNodes != NULL)
+            {
+                for (size_t i=0; i<nNodes; ++i)
+                    free(vNodes[i].name);
+                free(vNodes);
+                vNodes          = NULL;
+            }
+            if (vBins != NULL)
+            {
+                free(vBins);
+                vBins           = NULL;
+            }
+            nNodes          = 0;
+            nNodeCap        = 0;
+            nBins           = 0;
+        }
+
+        ssize_t ProfileTable::find_node(uint32_t id) const
+        {
+            if (nBins == 0)
+                return -1;
+
+            const size_t mask   = nBins - 1;
+            for (size_t bin = hash_id(id) & mask; vBins[bin] != 0; bin = (bin + 1) & mask)
+            {
+                const size_t index  = vBins[bin] - 1;
+                if (vNodes[index].id == id)
+                    return index;
+            }
+
+            return -1;
+        }
+
+        status_t ProfileTable::rehash(size_t bins)
+        {
+            uint32_t *vb    = static_cast<uint32_t *>(malloc(bins * sizeof(uint32_t)));
+            if (vb == NULL)
+                return STATUS_NO_MEM;
+            memset(vb, 0, bins * sizeof(uint32_t));
+
+            const size_t mask = bins - 1;
+            for (size_t i=0; i<nNodes; ++i)
+            {
+                size_t bin      = hash_id(vNodes[i].id) & mask;
+                while (vb[bin] != 0)
+                    bin             = (bin + 1) & mask;
+                vb[bin]         = uint32_t(i + 1);
+            }
+
+            if (vBins != NULL)
+                free(vBins);
+            vBins           = vb;
+            nBins           = bins;
+
+            return STATUS_OK;
+        }
+
+        ssize_t ProfileTable::add_node(uint32_t id, const char *name)
+        {
+            // Update the name of the existing node
+            ssize_t index = find_node(id);
+            if (index >= 0)
+            {
+                node_t *n       = &vNodes[index];
+                if ((n->name != NULL) && (strcmp(n->name, name) == 0))
+                    return index;
+
+                char *s         = strdup(name);
+                if (s == NULL)
+                    return -STATUS_NO_MEM;
+                free(n->name);
+                n->name         = s;
+                n->seen         = false;    // Probably a new node with the same identifier
+                return index;
+            }
+
+            // Grow the dictionary and the index
+            if (nNodes >= nNodeCap)
+            {
+                const size_t cap    = lsp_max(nNodeCap * 2, size_t(16));
+                node_t *vn          = static_cast<node_t *>(realloc(vNodes, cap * sizeof(node_t)));
+                if (vn == NULL)
+                    return -STATUS_NO_MEM;
+                vNodes              = vn;
+                nNodeCap            = cap;
+            }
+            if ((nNodes + 1) * 4 > nBins * 3)
+            {
+                status_t res        = rehash(lsp_max(nBins * 2, PROFILE_MIN_BINS));
+                if (res != STATUS_OK)
+                    return -res;
+            }
+
+            node_t *n       = &vNodes[nNodes];
+            n->id           = id;
+            n->xruns        = 0;
+            n->info_xruns   = 0;
+            n->seen         = false;
+            n->info_seen    = false;
+            n->name         = strdup(name);
+            if (n->name == NULL)
+                return -STATUS_NO_MEM;
+
+            const size_t mask   = nBins - 1;
+            size_t bin          = hash_id(id) & mask;
+            while (vBins[bin] != 0)
+                bin                 = (bin + 1) & mask;
+            vBins[bin]          = uint32_t(nNodes + 1);
+
+            return nNodes++;
+        }
+
+        status_t ProfileTable::count_rows(const struct spa_pod *pod, size_t *rows) const
+        {
+            const struct spa_pod_prop *p;
+            size_t count = 0;
+
+            if (spa_pod_is_object_type(pod, SPA_TYPE_OBJECT_Profiler))
+            {
+                const struct spa_pod_object *obj = reinterpret_cast<const struct spa_pod_object *>(pod);
+                SPA_POD_OBJECT_FOREACH(obj, p)
+                {
+                    if (is_block(p->key))
+                        ++count;
+                }
+            }
+            else if (spa_pod_is_struct(pod))
+            {
+                const struct spa_pod *item;
+                SPA_POD_STRUCT_FOREACH(pod, item)
+                {
+                    if (!spa_pod_is_object_type(item, SPA_TYPE_OBJECT_Profiler))
+                        continue;
+
+                    const struct spa_pod_object *obj = reinterpret_cast<const struct spa_pod_object *>(item);
+                    SPA_POD_OBJECT_FOREACH(obj, p)
+                    {
+                        if (is_block(p->key))
+                            ++count;
+                    }
+                }
+            }
+            else
+                return STATUS_BAD_FORMAT;
+
+            *rows   = count;
+            return STATUS_OK;
+        }
+
+        status_t ProfileTable::decode_object(const struct spa_pod *pod)
+        {
+            const struct spa_pod_object *obj = reinterpret_cast<const struct spa_pod_object *>(pod);
+            const struct spa_pod_prop *p;
+            const size_t first  = nRows;
+            uint64_t counter    = 0;
+            int32_t info_xruns  = -1;
+            int64_t quantum     = 0;
+            bool clock_xrun     = false;
+            ssize_t driver      = -1;
+            size_t blamed       = 0;
+            status_t res;
+            block_t b;
+
+            SPA_POD_OBJECT_FOREACH(obj, p)
+            {
+                switch (p->key)
+                {
+                    case SPA_PROFILER_info:
+                        if ((res = parse_info(&counter, &info_xruns, &p->value)) != STATUS_OK)
+                            return res;
+                        break;
+
+                    case SPA_PROFILER_clock:
+                        if ((res = parse_clock(&quantum, &clock_xrun, &p->value)) != STATUS_OK)
+                            return res;
+                        break;
+
+                    case SPA_PROFILER_driverBlock:
+                    case SPA_PROFILER_followerBlock:
+                    {
+                        if ((res = parse_block(&b, &p->value)) != STATUS_OK)
+                            return res;
+                        const ssize_t index = add_node(uint32_t(b.id), b.name);
+                        if (index < 0)
+                            return status_t(-index);
+
+                        // Track changes of the xrun counter of the node
+                        node_t *n           = &vNodes[index];
+                        uint32_t flags      = 0;
+                        if (b.xruns >= 0)
+                        {
+                            if ((n->seen) && (uint32_t(b.xruns) != n->xruns))
+                                flags              |= F_BLAMED;
+                            n->xruns            = uint32_t(b.xruns);
+                            n->seen             = true;
+                        }
+
+                        if (p->key == SPA_PROFILER_driverBlock)
+                        {
+                            flags              |= F_DRIVER;
+                            driver              = index;
+                        }
+                        if (b.async)
+                            flags              |= F_ASYNC;
+                        if ((b.signal > 0) && (b.awake >= b.signal) && (b.finish >= b.awake))
+                            flags              |= F_FINISHED;
+
+                        const size_t row    = nRows++;
+                        vCycle[row]         = 0;
+                        vNode[row]          = uint32_t(index);
+                        vSignal[row]        = b.signal;
+                        vAwake[row]         = b.awake;
+                        vFinish[row]        = b.finish;
+                        vStatus[row]        = uint32_t(b.status);
+                        vFlags[row]         = flags;
+                        blamed             += (flags & F_BLAMED) ? 1 : 0;
+                        break;
+                    }
+
+                    default:
+                        break;
+                }
+            }
+
+            if (nRows <= first)
+                return STATUS_OK;
+
+            // Detect xrun in the cycle
+            bool xrun           = clock_xrun;
+            int64_t deadline    = 0;
+            if (driver >= 0)
+            {
+                node_t *n           = &vNodes[driver];
+                if (info_xruns >= 0)
+                {
+                    if ((n->info_seen) && (uint32_t(info_xruns) != n->info_xruns))
+                        xrun                = true;
+                    n->info_xruns       = uint32_t(info_xruns);
+                    n->info_seen        = true;
+                }
+
+                for (size_t i=first; i<nRows; ++i)
+                    if (vNode[i] == uint32_t(driver))
+                    {
+                        deadline            = (quantum > 0) ? vSignal[i] + quantum : 0;
+                        break;
+                    }
+            }
+
+            // Fill the cycle data and detect overruns
+            size_t overruns     = 0;
+            size_t last         = first;
+            for (size_t i=first; i<nRows; ++i)
+            {
+                uint32_t flags      = vFlags[i];
+                if (!(flags & F_FINISHED))
+                    flags              |= F_OVERRUN;
+                else if ((deadline > 0) && (vFinish[i] > deadline))
+                    flags              |= F_OVERRUN;
+                if (flags & F_OVERRUN)
+                    ++overruns;
+                if (vFinish[i] > vFinish[last])
+                    last                = i;
+
+                vCycle[i]           = counter;
+                vDriver[i]          = (driver >= 0) ? uint32_t(driver) : vNode[i];
+                vQuantum[i]         = quantum;
+                vFlags[i]           = flags;
+            }
+
+            // Attribute the xrun
+            if (!xrun)
+            {
+                for (size_t i=first; i<nRows; ++i)
+                    vFlags[i]          &= ~F_BLAMED;
+                return STATUS_OK;
+            }
+
+            for (size_t i=first; i<nRows; ++i)
+            {
+                uint32_t flags      = vFlags[i] | F_XRUN;
+                if (blamed == 0)
+                {
+                    if (overruns > 0)
+                    {
+                        if (flags & F_OVERRUN)
+                            flags              |= F_BLAMED;
+                    }
+                    else if (i == last)
+                        flags              |= F_BLAMED;
+                }
+                vFlags[i]           = flags;
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t ProfileTable::append(const struct spa_pod *pod)
+        {
+            if (pod == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            if (pData == NULL)
+                return STATUS_BAD_STATE;
+
+            // Ensure that all rows fit into the table
+            size_t rows = 0;
+            status_t res = count_rows(pod, &rows);
+            if (res != STATUS_OK)
+                return res;
+            if (rows > nCapacity)
+                return STATUS_TOO_BIG;
+            if (nRows + rows > nCapacity)
+                return STATUS_OVERFLOW;
+
+            // Decode objects
+            const size_t first = nRows;
+            if (spa_pod_is_struct(pod))
+            {
+                const struct spa_pod *item;
+                SPA_POD_STRUCT_FOREACH(pod, item)
+                {
+                    if (!spa_pod_is_object_type(item, SPA_TYPE_OBJECT_Profiler))
+                        continue;
+                    if ((res = decode_object(item)) != STATUS_OK)
+                        break;
+                }
+            }
+            else
+                res = decode_object(pod);
+
+            // Rollback on error
+            if (res != STATUS_OK)
+                nRows       = first;
+
+            return res;
+        }
+
+    } /* namespace pw */
+} /* namespace lsp */
@@ -0,0 +1,258 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/pw/SlotMap.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+namespace lsp
+{
+    namespace pw
+    {
+        constexpr size_t SlotMap::CHUNK_SHIFT;
+        constexpr size_t SlotMap::CHUNK_SIZE;
+        constexpr size_t SlotMap::CHUNK_MASK;
+
+        static constexpr uint32_t SLOT_NONE         = 0xffffffff;
+        static constexpr size_t SLOT_MAX            = 0xfffffff0;
+
+        SlotMap::SlotMap()
+        {
+            vChunks         = NULL;
+            nChunks         = 0;
+            nChunkCap       = 0;
+            nSlots          = 0;
+            nFree           = SLOT_NONE;
+            vDense          = NULL;
+            vDenseSlot      = NULL;
+            nItems          = 0;
+            nDenseCap       = 0;
+        }
+
+        SlotMap::~SlotMap()
+        {
+            flush();
+        }
+
+        status_t SlotMap::grow_slots()
+        {
+            if (nSlots >= SLOT_MAX)
+                return STATUS_OVERFLOW;
+
+            // Grow the array of chunks, chunks themselves are never relocated
+            if (nChunks >= nChunkCap)
+            {
+                const size_t cap    = lsp_max(nChunkCap * 2, size_t(16));
+                slot_t **vc         = static_cast<slot_t **>(realloc(vChunks, cap * sizeof(slot_t *)));
+                if (vc == NULL)
+                    return STATUS_NO_MEM;
+                vChunks             = vc;
+                nChunkCap           = cap;
+            }
+
+            slot_t *chunk       = static_cast<slot_t *>(malloc(CHUNK_SIZE * sizeof(slot_t)));
+            if (chunk == NULL)
+                return STATUS_NO_MEM;
+            vChunks[nChunks++]  = chunk;
+
+            return STATUS_OK;
+        }
+
+        status_t SlotMap::grow_dense()
+        {
+            const size_t cap    = lsp_max(nDenseCap * 2, CHUNK_SIZE);
+            void **vd           = static_cast<void **>(realloc(vDense, cap * sizeof(void *)));
+            if (vd == NULL)
+                return STATUS_NO_MEM;
+            vDense              = vd;
+
+            uint32_t *vs        = static_cast<uint32_t *>(realloc(vDenseSlot, cap * sizeof(uint32_t)));
+            if (vs == NULL)
+                return STATUS_NO_MEM;
+            vDenseSlot          = vs;
+            nDenseCap           = cap;
+
+            return STATUS_OK;
+        }
+
+        status_t SlotMap::reserve(size_t count)
+        {
+            status_t res;
+            while (nDenseCap < count)
+            {
+                if ((res = grow_dense()) != STATUS_OK)
+                    return res;
+            }
+            while ((nChunks << CHUNK_SHIFT) < count)
+            {
+                if ((res = grow_slots()) != STATUS_OK)
+                    return res;
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t SlotMap::insert(void *data, slot_id_t *id)
+        {
+            status_t res;
+            if (nItems >= nDenseCap)
+            {
+                if ((res = grow_dense()) != STATUS_OK)
+                    return res;
+            }
+
+            // Take the free slot or allocate the new one
+            size_t index;
+            slot_t *s;
+            if (nFree != SLOT_NONE)
+            {
+                index           = nFree;
+                s               = slot(index);
+                nFree           = s->link;
+            }
+            else
+            {
+                if (nSlots >= (nChunks << CHUNK_SHIFT))
+                {
+                    if ((res = grow_slots()) != STATUS_OK)
+                        return res;
+                }
+                index           = nSlots++;
+                s               = slot(index);
+                s->generation   = 0;
+            }
+
+            s->data         = data;
+            s->generation   = s->generation + 1;
+            s->link         = uint32_t(nItems);
+            vDense[nItems]  = data;
+            vDenseSlot[nItems++]    = uint32_t(index);
+
+            if (id != NULL)
+                *id             = (slot_id_t(s->generation) << 32) | index;
+
+            return STATUS_OK;
+        }
+
+        status_t SlotMap::remove(slot_id_t id, void **data)
+        {
+            slot_t *s       = find(id);
+            if (s == NULL)
+                return STATUS_NOT_FOUND;
+            if (data != NULL)
+                *data           = s->data;
+
+            // Move the last item of the dense array to the place of removed one
+            const size_t pos    = s->link;
+            const size_t last   = --nItems;
+            if (pos != last)
+            {
+                vDense[pos]         = vDense[last];
+                vDenseSlot[pos]     = vDenseSlot[last];
+                slot(vDenseSlot[pos])->link = uint32_t(pos);
+            }
+
+            // Release the slot, retire it if generation is exhausted
+            s->data         = NULL;
+            s->generation   = s->generation + 1;
+            if (s->generation != 0)
+            {
+                s->link         = nFree;
+                nFree           = index_of(id);
+            }
+            else
+                s->link         = SLOT_NONE;
+
+            return STATUS_OK;
+        }
+
+        status_t SlotMap::replace(slot_id_t id, void *data)
+        {
+            slot_t *s       = find(id);
+            if (s == NULL)
+                return STATUS_NOT_FOUND;
+
+            s->data         = data;
+            vDense[s->link] = data;
+
+            return STATUS_OK;
+        }
+
+        slot_id_t SlotMap::item_id(size_t index) const
+        {
+            if (index >= nItems)
+                return SLOT_ID_INVALID;
+
+            const size_t si     = vDenseSlot[index];
+            return (slot_id_t(slot(si)->generation) << 32) | si;
+        }
+
+        void SlotMap::clear()
+        {
+            // Rebuild the free list in the order of slots to keep further insertions sequential
+            nFree           = SLOT_NONE;
+            for (size_t index = nSlots; index > 0; )
+            {
+                slot_t *s               = slot(--index);
+                if (s->generation & 1)
+                {
+                    s->data                 = NULL;
+                    s->generation           = s->generation + 1;
+                }
+                if (s->generation == 0)
+                    continue;
+
+                s->link                 = nFree;
+                nFree                   = uint32_t(index);
+            }
+            nItems          = 0;
+        }
+
+        void SlotMap::flush()
+        {
+            if (vChunks != NULL)
+            {
+                for (size_t i=0; i<nChunks; ++i)
+                    free(vChunks[i]);
+                free(vChunks);
+                vChunks         = NULL;
+            }
+            if (vDense != NULL)
+            {
+                free(vDense);
+                vDense          = NULL;
+            }
+            if (vDenseSlot != NULL)
+            {
+                free(vDenseSlot);
+                vDenseSlot      = NULL;
+            }
+
+            nChunks         = 0;
+            nChunkCap       = 0;
+            nSlots          = 0;
+            nFree           = SLOT_NONE;
+            nItems          = 0;
+            nDenseCap       = 0;
+        }
+
+    } /* namespace pw */
+} /* namespace lsp */
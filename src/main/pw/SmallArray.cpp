@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/pw/SmallArray.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+namespace lsp
+{
+    namespace pw
+    {
+        static constexpr size_t SMALL_ARRAY_MIN_GROW    = 16;
+
+        RawSmallArray::RawSmallArray(void *storage, size_t inline_items, size_t sizeof_item)
+        {
+            pData           = static_cast<uint8_t *>(storage);
+            pInline         = pData;
+            nItems          = 0;
+            nCapacity       = inline_items;
+            nInline         = inline_items;
+            nSizeOf         = sizeof_item;
+            nFailures       = 0;
+            bFrozen         = false;
+        }
+
+        RawSmallArray::~RawSmallArray()
+        {
+            flush();
+        }
+
+        status_t RawSmallArray::grow(size_t capacity)
+        {
+            if (capacity > (~size_t(0)) / nSizeOf)
+                return STATUS_OVERFLOW;
+
+            // The inline storage can not be reallocated
+            uint8_t *ptr;
+            if (pData == pInline)
+            {
+                ptr             = static_cast<uint8_t *>(malloc(capacity * nSizeOf));
+                if (ptr == NULL)
+                    return STATUS_NO_MEM;
+                memcpy(ptr, pData, nItems * nSizeOf);
+            }
+            else
+            {
+                ptr             = static_cast<uint8_t *>(realloc(pData, capacity * nSizeOf));
+                if (ptr == NULL)
+                    return STATUS_NO_MEM;
+            }
+
+            pData           = ptr;
+            nCapacity       = capacity;
+
+            return STATUS_OK;
+        }
+
+        status_t RawSmallArray::ensure(size_t count)
+        {
+            if (count > (~size_t(0)) - nItems)
+                return STATUS_OVERFLOW;
+            const size_t need   = nItems + count;
+            if (need <= nCapacity)
+                return STATUS_OK;
+
+            // Growth attempts of the frozen array fail without allocation
+            if (bFrozen)
+            {
+                atomic_add(&nFailures, size_t(1));
+                return STATUS_BAD_STATE;
+            }
+
+            // Geometric growth
+            size_t capacity     = lsp_max(nCapacity + (nCapacity >> 1), SMALL_ARRAY_MIN_GROW);
+            capacity            = lsp_max(capacity, need);
+
+            status_t res        = grow(capacity);
+            if (res != STATUS_OK)
+                atomic_add(&nFailures, size_t(1));
+            return res;
+        }
+
+        void *RawSmallArray::add_slow(size_t count)
+        {
+            if (ensure(count) != STATUS_OK)
+                return NULL;
+
+            uint8_t *ptr    = &pData[nItems * nSizeOf];
+            nItems         += count;
+            return ptr;
+        }
+
+        void *RawSmallArray::insert(size_t index, size_t count)
+        {
+            if (index > nItems)
+                return NULL;
+            if (ensure(count) != STATUS_OK)
+                return NULL;
+
+            uint8_t *ptr    = &pData[index * nSizeOf];
+            if (index < nItems)
+                memmove(&ptr[count * nSizeOf], ptr, (nItems - index) * nSizeOf);
+            nItems         += count;
+            return ptr;
+        }
+
+        bool RawSmallArray::remove(size_t index, size_t count)
+        {
+            if ((index > nItems) || (count > nItems - index))
+                return false;
+
+            const size_t tail   = nItems - index - count;
+            if (tail > 0)
+            {
+                uint8_t *ptr        = &pData[index * nSizeOf];
+                memmove(ptr, &ptr[count * nSizeOf], tail * nSizeOf);
+            }
+            nItems             -= count;
+            return true;
+        }
+
+        status_t RawSmallArray::reserve(size_t count)
+        {
+            if (count <= nCapacity)
+                return STATUS_OK;
+            if (bFrozen)
+            {
+                atomic_add(&nFailures, size_t(1));
+                return STATUS_BAD_STATE;
+            }
+
+            return grow(count);
+        }
+
+        status_t RawSmallArray::shrink()
+        {
+            if (pData == pInline)
+                return STATUS_OK;
+
+            // Move items back to the inline storage
+            if (nItems <= nInline)
+            {
+                memcpy(pInline, pData, nItems * nSizeOf);
+                free(pData);
+                pData           = pInline;
+                nCapacity       = nInline;
+                return STATUS_OK;
+            }
+
+            if (nItems >= nCapacity)
+                return STATUS_OK;
+
+            uint8_t *ptr    = static_cast<uint8_t *>(realloc(pData, nItems * nSizeOf));
+            if (ptr == NULL)
+                return STATUS_NO_MEM;
+            pData           = ptr;
+            nCapacity       = nItems;
+
+            return STATUS_OK;
+        }
+
+        void RawSmallArray::flush()
+        {
+            if (pData != pInline)
+            {
+                free(pData);
+                pData           = pInline;
+                nCapacity       = nInline;
+            }
+            nItems          = 0;
+        }
+
+    } /* namespace pw */
+} /* namespace lsp */
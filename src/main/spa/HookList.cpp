@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/HookList.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+
+namespace lsp
+{
+    namespace spa
+    {
+        static constexpr size_t HOOK_LIST_MIN_CAPACITY  = 8;
+
+        HookList::HookList()
+        {
+            spa_hook_list_init(&sList);
+            vItems          = NULL;
+            nItems          = 0;
+            nCapacity       = 0;
+            nHooks          = 0;
+            nDepth          = 0;
+            bDirty          = false;
+        }
+
+        HookList::~HookList()
+        {
+            clean();
+            if (vItems != NULL)
+            {
+                free(vItems);
+                vItems          = NULL;
+            }
+            nCapacity       = 0;
+        }
+
+        void HookList::hook_removed(struct spa_hook *hook)
+        {
+            HookList *self  = static_cast<HookList *>(hook->priv);
+            hook->removed   = NULL;
+            hook->priv      = NULL;
+            if (self != NULL)
+                self->removed(hook);
+        }
+
+        status_t HookList::add(struct spa_hook *hook, const void *funcs, void *data, bool prepend)
+        {
+            // Reserve space for the snapshot, so rebuild never fails
+            if (nHooks >= nCapacity)
+            {
+                size_t cap      = (nCapacity > 0) ? nCapacity << 1 : HOOK_LIST_MIN_CAPACITY;
+                listener_t *vi  = static_cast<listener_t *>(realloc(vItems, cap * sizeof(listener_t)));
+                if (vi == NULL)
+                    return STATUS_NO_MEM;
+                vItems          = vi;
+                nCapacity       = cap;
+            }
+
+            if (prepend)
+                spa_hook_list_prepend(&sList, hook, funcs, data);
+            else
+                spa_hook_list_append(&sList, hook, funcs, data);
+            hook->removed   = hook_removed;
+            hook->priv      = this;
+            ++nHooks;
+
+            if (nDepth > 0)
+                bDirty          = true;
+            else
+                rebuild();
+
+            return STATUS_OK;
+        }
+
+        void HookList::removed(struct spa_hook *hook)
+        {
+            --nHooks;
+
+            if (nDepth == 0)
+            {
+                rebuild();
+                return;
+            }
+
+            // Emission is in progress, just disable the listener
+            for (size_t i=0; i<nItems; ++i)
+            {
+                listener_t *l   = &vItems[i];
+                if (l->hook != hook)
+                    continue;
+                l->funcs        = NULL;
+                l->hook         = NULL;
+                break;
+            }
+            bDirty          = true;
+        }
+
+        void HookList::rebuild()
+        {
+            size_t n        = 0;
+            struct spa_hook *h;
+            spa_list_for_each(h, &sList.list, link)
+            {
+                listener_t *l   = &vItems[n++];
+                l->funcs        = h->cb.funcs;
+                l->data         = h->cb.data;
+                l->hook         = h;
+            }
+
+            nItems          = n;
+            bDirty          = false;
+        }
+
+        void HookList::clean()
+        {
+            // Disable rebuild of the snapshot for each removed hook
+            ++nDepth;
+            spa_hook_list_clean(&sList);
+            --nDepth;
+
+            nItems          = 0;
+            bDirty          = (nDepth > 0);
+        }
+
+    } /* namespace spa */
+} /* namespace lsp */
@@ -0,0 +1,678 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/JsonPodParser.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <pw-headers/spa/debug/types.h>
+#include <pw-headers/spa/utils/json.h>
+#include <pw-headers/spa/utils/string.h>
+
+namespace lsp
+{
+    namespace spa
+    {
+        constexpr size_t JsonPodParser::DEFAULT_DEPTH;
+        constexpr size_t JsonPodParser::MAX_TOKEN_LENGTH;
+        constexpr size_t JsonPodParser::MAX_KEY_LENGTH;
+
+        JsonPodParser::JsonPodParser()
+        {
+            pBuilder        = NULL;
+            pInfo           = NULL;
+            nId             = 0;
+            nStart          = 0;
+            nError          = STATUS_OK;
+
+            vFrames         = NULL;
+            nDepth          = 0;
+            nMaxDepth       = 0;
+
+            nLexer          = LEX_NONE;
+            nUtf8           = 0;
+            vToken          = NULL;
+            nTokLength      = 0;
+            bTokBuffered    = false;
+            vValue          = NULL;
+
+            nOffset         = 0;
+            nLine           = 1;
+            nLineStart      = 0;
+        }
+
+        JsonPodParser::~JsonPodParser()
+        {
+            do_destroy();
+        }
+
+        void JsonPodParser::do_destroy()
+        {
+            if (vFrames != NULL)
+            {
+                free(vFrames);
+                vFrames         = NULL;
+            }
+            if (vToken != NULL)
+            {
+                free(vToken);
+                vToken          = NULL;
+            }
+            vValue          = NULL;
+            pBuilder        = NULL;
+            nMaxDepth       = 0;
+        }
+
+        void JsonPodParser::destroy()
+        {
+            do_destroy();
+        }
+
+        status_t JsonPodParser::init(size_t max_depth)
+        {
+            if (max_depth == 0)
+                return STATUS_BAD_ARGUMENTS;
+
+            // The root frame is always present
+            frame_t *frames = static_cast<frame_t *>(malloc(sizeof(frame_t) * (max_depth + 1)));
+            if (frames == NULL)
+                return STATUS_NO_MEM;
+
+            // Allocate token buffer and buffer for unescaped value at once
+            char *buf       = static_cast<char *>(malloc((MAX_TOKEN_LENGTH + 1) * 2));
+            if (buf == NULL)
+            {
+                free(frames);
+                return STATUS_NO_MEM;
+            }
+
+            do_destroy();
+
+            vFrames         = frames;
+            nMaxDepth       = max_depth;
+            vToken          = buf;
+            vValue          = &buf[MAX_TOKEN_LENGTH + 1];
+
+            return STATUS_OK;
+        }
+
+        status_t JsonPodParser::begin(struct spa_pod_builder *b, const struct spa_type_info *info)
+        {
+            if ((b == NULL) || (info == NULL))
+                return STATUS_BAD_ARGUMENTS;
+            if (vFrames == NULL)
+                return STATUS_BAD_STATE;
+
+            pBuilder        = b;
+            pInfo           = info;
+            nId             = info->type;
+            nStart          = b->state.offset;
+            nError          = STATUS_OK;
+
+            frame_t *f      = &vFrames[0];
+            f->info         = info;
+            f->values       = NULL;
+            f->prop         = NULL;
+            f->type         = FRAME_ROOT;
+            f->pushed       = false;
+            f->skip         = false;
+            f->skip_value   = false;
+            f->key          = false;
+            f->sep          = false;
+            nDepth          = 0;
+
+            nLexer          = LEX_NONE;
+            nUtf8           = 0;
+            nTokLength      = 0;
+            bTokBuffered    = false;
+
+            nOffset         = 0;
+            nLine           = 1;
+            nLineStart      = 0;
+
+            return STATUS_OK;
+        }
+
+        status_t JsonPodParser::fail(status_t code, wsize_t offset)
+        {
+            nOffset         = offset;
+            nError          = code;
+            return code;
+        }
+
+        void JsonPodParser::append_token(const char *data, size_t size)
+        {
+            if (nTokLength < MAX_TOKEN_LENGTH)
+                memcpy(&vToken[nTokLength], data, lsp_min(size, MAX_TOKEN_LENGTH - nTokLength));
+            nTokLength     += size;
+            bTokBuffered    = true;
+        }
+
+        status_t JsonPodParser::emit_value(const char *tok, size_t len, bool overflow, const struct spa_type_info *info)
+        {
+            struct spa_pod_builder *b   = pBuilder;
+            const uint32_t type         = (info != NULL) ? info->parent : uint32_t(SPA_TYPE_Struct);
+            int res                     = 0;
+            float fv                    = 0.0f;
+            bool bv                     = false;
+
+            // Follow the same order of checks as spa_json_to_pod_part() does
+            if ((!overflow) && (spa_json_parse_float(tok, len, &fv)))
+            {
+                switch (type)
+                {
+                    case SPA_TYPE_Bool:     res = spa_pod_builder_bool(b, fv >= 0.5f); break;
+                    case SPA_TYPE_Id:       res = spa_pod_builder_id(b, uint32_t(fv)); break;
+                    case SPA_TYPE_Int:      res = spa_pod_builder_int(b, int32_t(fv)); break;
+                    case SPA_TYPE_Long:     res = spa_pod_builder_long(b, int64_t(fv)); break;
+                    case SPA_TYPE_Float:    res = spa_pod_builder_float(b, fv); break;
+                    case SPA_TYPE_Double:   res = spa_pod_builder_double(b, fv); break;
+                    case SPA_TYPE_Struct:
+                        res = (spa_json_is_int(tok, len)) ?
+                            spa_pod_builder_int(b, int32_t(fv)) :
+                            spa_pod_builder_float(b, fv);
+                        break;
+                    default:
+                        res = spa_pod_builder_none(b);
+                        break;
+                }
+            }
+            else if ((!overflow) && (spa_json_is_bool(tok, len)))
+            {
+                spa_json_parse_bool(tok, len, &bv);
+                res = spa_pod_builder_bool(b, bv);
+            }
+            else if ((!overflow) && (spa_json_is_null(tok, len)))
+                res = spa_pod_builder_none(b);
+            else
+            {
+                if ((overflow) || (len > MAX_TOKEN_LENGTH))
+                    return STATUS_TOO_BIG;
+
+                spa_json_parse_stringn(tok, len, vValue, len + 1);
+                switch (type)
+                {
+                    case SPA_TYPE_Id:
+                    {
+                        uint32_t id;
+                        const struct spa_type_info *ti = spa_debug_type_find_short(info->values, vValue);
+                        if (ti != NULL)
+                            id      = ti->type;
+                        else if (!spa_atou32(vValue, &id, 0))
+                            return STATUS_INVALID_VALUE;
+                        res     = spa_pod_builder_id(b, id);
+                        break;
+                    }
+                    case SPA_TYPE_Struct:
+                    case SPA_TYPE_String:
+                        res     = spa_pod_builder_string(b, vValue);
+                        break;
+                    default:
+                        res     = spa_pod_builder_none(b);
+                        break;
+                }
+            }
+
+            return (res < 0) ? STATUS_OVERFLOW : STATUS_OK;
+        }
+
+        status_t JsonPodParser::on_key(frame_t *f, const char *tok, size_t len, bool overflow)
+        {
+            char key[MAX_KEY_LENGTH];
+            uint32_t type;
+
+            f->key          = false;
+            f->sep          = true;
+            f->prop         = NULL;
+            f->skip_value   = true;
+
+            if ((f->skip) || (overflow) || (len >= MAX_KEY_LENGTH))
+                return STATUS_OK;
+
+            spa_json_parse_stringn(tok, len, key, sizeof(key));
+
+            const struct spa_type_info *pi = spa_debug_type_find_short(f->values, key);
+            if (pi != NULL)
+                type            = pi->type;
+            else if (!spa_atou32(key, &type, 0))
+                return STATUS_OK;
+
+            f->prop         = pi;
+            f->skip_value   = false;
+
+            return (spa_pod_builder_prop(pBuilder, type, 0) < 0) ? STATUS_OVERFLOW : STATUS_OK;
+        }
+
+        void JsonPodParser::on_complete()
+        {
+            frame_t *f      = &vFrames[nDepth];
+            switch (f->type)
+            {
+                case FRAME_ROOT:
+                    nLexer          = LEX_DONE;
+                    break;
+                case FRAME_OBJECT:
+                    f->key          = true;
+                    f->sep          = false;
+                    f->skip_value   = false;
+                    f->prop         = NULL;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        status_t JsonPodParser::on_token(const char *tok, size_t len, bool overflow)
+        {
+            frame_t *f      = &vFrames[nDepth];
+            status_t res    = STATUS_OK;
+
+            switch (f->type)
+            {
+                case FRAME_ROOT:
+                    res             = emit_value(tok, len, overflow, pInfo);
+                    break;
+                case FRAME_ARRAY:
+                    if (!f->skip)
+                        res             = emit_value(tok, len, overflow, f->info);
+                    break;
+                case FRAME_OBJECT:
+                    if (f->key)
+                        return on_key(f, tok, len, overflow);
+                    if ((!f->skip) && (!f->skip_value))
+                        res             = emit_value(tok, len, overflow, f->prop);
+                    break;
+                default:
+                    return STATUS_BAD_STATE;
+            }
+
+            if (res == STATUS_OK)
+                on_complete();
+            return res;
+        }
+
+        status_t JsonPodParser::on_separator()
+        {
+            // Any number of separators is allowed between the key and the value only
+            const frame_t *f    = &vFrames[nDepth];
+            return ((f->type == FRAME_OBJECT) && (f->sep)) ? STATUS_OK : STATUS_BAD_FORMAT;
+        }
+
+        status_t JsonPodParser::on_open(char c)
+        {
+            frame_t *p      = &vFrames[nDepth];
+            const struct spa_type_info *info = NULL;
+            bool skip       = false;
+
+            switch (p->type)
+            {
+                case FRAME_ROOT:
+                    info            = pInfo;
+                    break;
+                case FRAME_ARRAY:
+                    info            = p->info;
+                    skip            = p->skip;
+                    break;
+                case FRAME_OBJECT:
+                    if (p->key)
+                        return STATUS_BAD_FORMAT;
+                    info            = p->prop;
+                    skip            = (p->skip) || (p->skip_value);
+                    p->sep          = false;
+                    break;
+                default:
+                    return STATUS_BAD_STATE;
+            }
+
+            if (nDepth >= nMaxDepth)
+                return STATUS_OVERFLOW;
+
+            frame_t *f      = &vFrames[++nDepth];
+            f->info         = NULL;
+            f->values       = NULL;
+            f->prop         = NULL;
+            f->type         = (c == '{') ? FRAME_OBJECT : FRAME_ARRAY;
+            f->pushed       = false;
+            f->skip         = skip;
+            f->skip_value   = false;
+            f->key          = (c == '{');
+            f->sep          = false;
+
+            if (skip)
+                return STATUS_OK;
+
+            int res         = 0;
+            if (c == '{')
+            {
+                if (info == NULL)
+                {
+                    // spa_json_to_pod() emits the opening brace of untyped object as a string
+                    f->skip         = true;
+                    res             = spa_pod_builder_string(pBuilder, "{");
+                }
+                else
+                {
+                    const struct spa_type_info *ti = spa_debug_type_find(NULL, info->parent);
+                    if (ti == NULL)
+                        return STATUS_INVALID_VALUE;
+                    f->values       = ti->values;
+                    f->pushed       = true;
+                    res             = spa_pod_builder_push_object(pBuilder, &f->pod, info->parent, nId);
+                }
+            }
+            else
+            {
+                f->pushed       = true;
+                if ((info == NULL) || (info->parent == SPA_TYPE_Struct))
+                {
+                    f->info         = info;
+                    res             = spa_pod_builder_push_struct(pBuilder, &f->pod);
+                }
+                else
+                {
+                    f->info         = info->values;
+                    res             = spa_pod_builder_push_array(pBuilder, &f->pod);
+                }
+            }
+
+            return (res < 0) ? STATUS_OVERFLOW : STATUS_OK;
+        }
+
+        status_t JsonPodParser::on_close(char c)
+        {
+            frame_t *f      = &vFrames[nDepth];
+            switch (f->type)
+            {
+                case FRAME_OBJECT:
+                    if ((c != '}') || (!f->key))
+                        return STATUS_BAD_FORMAT;
+                    break;
+                case FRAME_ARRAY:
+                    if (c != ']')
+                        return STATUS_BAD_FORMAT;
+                    break;
+                default:
+                    return STATUS_BAD_FORMAT;
+            }
+
+            if (f->pushed)
+                spa_pod_builder_pop(pBuilder, &f->pod);
+
+            --nDepth;
+            on_complete();
+
+            return STATUS_OK;
+        }
+
+        status_t JsonPodParser::parse(const void *data, size_t size)
+        {
+            if (nError != STATUS_OK)
+                return nError;
+            if (pBuilder == NULL)
+                return STATUS_BAD_STATE;
+            if (size == 0)
+                return STATUS_OK;
+
+            const char *head    = static_cast<const char *>(data);
+            const char *p       = head;
+            const char *end     = p + size;
+            const char *ts      = p;            // Start of the non-buffered part of the token
+            status_t res;
+            uint8_t c;
+
+            #define OFFSET(ptr)     (nOffset + wsize_t((ptr) - head))
+            #define FAIL(code, ptr) return fail(code, OFFSET(ptr))
+
+            while (p < end)
+            {
+                switch (nLexer)
+                {
+                    case LEX_NONE:
+                        c = uint8_t(*p);
+                        switch (c)
+                        {
+                            case '\n':
+                                ++nLine;
+                                nLineStart  = OFFSET(p + 1);
+                                ++p;
+                                break;
+                            case '\0': case '\t': case ' ': case '\r': case ',':
+                                ++p;
+                                break;
+                            case ':': case '=':
+                                if ((res = on_separator()) != STATUS_OK)
+                                    FAIL(res, p);
+                                ++p;
+                                break;
+                            case '#':
+                                nLexer      = LEX_COMMENT;
+                                ++p;
+                                break;
+                            case '"':
+                                nLexer      = LEX_STRING;
+                                ts          = p++;
+                                nTokLength  = 0;
+                                bTokBuffered= false;
+                                break;
+                            case '{': case '[':
+                                if ((res = on_open(c)) != STATUS_OK)
+                                    FAIL(res, p);
+                                ++p;
+                                break;
+                            case '}': case ']':
+                                if ((res = on_close(c)) != STATUS_OK)
+                                    FAIL(res, p);
+                                ++p;
+                                break;
+                            default:
+                                if ((c < 32) || (c > 126) || (c == '\\'))
+                                    FAIL(STATUS_BAD_FORMAT, p);
+                                nLexer      = LEX_BARE;
+                                ts          = p++;
+                                nTokLength  = 0;
+                                bTokBuffered= false;
+                                break;
+                        }
+                        break;
+
+                    case LEX_STRING:
+                        while (p < end)
+                        {
+                            c = uint8_t(*p);
+                            if ((c >= 32) && (c <= 127) && (c != '"') && (c != '\\'))
+                            {
+                                ++p;
+                                continue;
+                            }
+
+                            if (c == '"')
+                            {
+                                const char *tok = ts;
+                                size_t len      = ++p - ts;
+                                if (bTokBuffered)
+                                {
+                                    append_token(ts, len);
+                                    tok             = vToken;
+                                    len             = nTokLength;
+                                }
+
+                                nLexer          = LEX_NONE;
+                                if ((res = on_token(tok, len, len > MAX_TOKEN_LENGTH)) != STATUS_OK)
+                                    FAIL(res, p - 1);
+                            }
+                            else if (c == '\\')
+                            {
+                                nLexer          = LEX_ESCAPE;
+                                ++p;
+                            }
+                            else if ((c >= 192) && (c <= 247))
+                            {
+                                nUtf8           = (c >= 240) ? 3 : (c >= 224) ? 2 : 1;
+                                nLexer          = LEX_UTF8;
+                                ++p;
+                            }
+                            else
+                                FAIL(STATUS_BAD_FORMAT, p);
+                            break;
+                        }
+                        break;
+
+                    case LEX_ESCAPE:
+                        switch (*p)
+                        {
+                            case '"': case '\\': case '/': case 'b': case 'f':
+                            case 'n': case 'r': case 't': case 'u':
+                                nLexer          = LEX_STRING;
+                                ++p;
+                                break;
+                            default:
+                                FAIL(STATUS_BAD_FORMAT, p);
+                        }
+                        break;
+
+                    case LEX_UTF8:
+                        c = uint8_t(*p);
+                        if ((c < 128) || (c > 191))
+                            FAIL(STATUS_BAD_FORMAT, p);
+                        if ((--nUtf8) == 0)
+                            nLexer          = LEX_STRING;
+                        ++p;
+                        break;
+
+                    case LEX_BARE:
+                        while (p < end)
+                        {
+                            c = uint8_t(*p);
+                            switch (c)
+                            {
+                                case '\0': case '\t': case ' ': case '\r': case '\n':
+                                case '"': case '#': case '{': case '[':
+                                case ':': case ',': case '=': case ']': case '}':
+                                {
+                                    // Delimiter is processed again in the LEX_NONE state
+                                    const char *tok = ts;
+                                    size_t len      = p - ts;
+                                    if (bTokBuffered)
+                                    {
+                                        append_token(ts, len);
+                                        tok             = vToken;
+                                        len             = nTokLength;
+                                    }
+
+                                    nLexer          = LEX_NONE;
+                                    if ((res = on_token(tok, len, len > MAX_TOKEN_LENGTH)) != STATUS_OK)
+                                        FAIL(res, p);
+                                    break;
+                                }
+                                case '\\':
+                                    FAIL(STATUS_BAD_FORMAT, p);
+                                default:
+                                    if ((c < 32) || (c > 126))
+                                        FAIL(STATUS_BAD_FORMAT, p);
+                                    ++p;
+                                    continue;
+                            }
+                            break;
+                        }
+                        break;
+
+                    case LEX_COMMENT:
+                        while (p < end)
+                        {
+                            c = uint8_t(*(p++));
+                            if ((c == '\n') || (c == '\r'))
+                            {
+                                if (c == '\n')
+                                {
+                                    ++nLine;
+                                    nLineStart      = OFFSET(p);
+                                }
+                                nLexer          = LEX_NONE;
+                                break;
+                            }
+                        }
+                        break;
+
+                    case LEX_DONE:
+                        // The rest of document is ignored as spa_json_to_pod() does
+                        p       = end;
+                        break;
+
+                    default:
+                        FAIL(STATUS_BAD_STATE, p);
+                }
+            }
+
+            // Save the incomplete token
+            switch (nLexer)
+            {
+                case LEX_STRING:
+                case LEX_ESCAPE:
+                case LEX_UTF8:
+                case LEX_BARE:
+                    append_token(ts, end - ts);
+                    break;
+                default:
+                    break;
+            }
+
+            #undef FAIL
+            #undef OFFSET
+
+            nOffset    += size;
+            return STATUS_OK;
+        }
+
+        status_t JsonPodParser::end(struct spa_pod **pod)
+        {
+            if (nError != STATUS_OK)
+                return nError;
+            if (pBuilder == NULL)
+                return STATUS_BAD_STATE;
+
+            status_t res;
+            switch (nLexer)
+            {
+                case LEX_BARE:
+                    nLexer      = LEX_NONE;
+                    if ((res = on_token(vToken, nTokLength, nTokLength > MAX_TOKEN_LENGTH)) != STATUS_OK)
+                        return fail(res, nOffset);
+                    break;
+                case LEX_STRING:
+                case LEX_ESCAPE:
+                case LEX_UTF8:
+                    return fail(STATUS_CORRUPTED, nOffset);
+                default:
+                    break;
+            }
+
+            if (nLexer != LEX_DONE)
+                return fail((nDepth > 0) ? STATUS_CORRUPTED : STATUS_NO_DATA, nOffset);
+
+            if (pod != NULL)
+                *pod        = static_cast<struct spa_pod *>(spa_pod_builder_deref(pBuilder, nStart));
+            pBuilder    = NULL;
+
+            return STATUS_OK;
+        }
+
+    } /* namespace spa */
+} /* namespace lsp */
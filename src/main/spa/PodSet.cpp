@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/PodSet.h>
+#include <lsp-plug.in/3rdparty/spa/pod_hash.h>
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+namespace lsp
+{
+    namespace spa
+    {
+        static constexpr size_t POD_SET_MIN_BINS        = 16;
+        static constexpr size_t POD_SET_CHUNK_SIZE      = 0x10000;
+
+        PodSet::PodSet()
+        {
+            vItems          = NULL;
+            nItems          = 0;
+            nCapacity       = 0;
+            vBins           = NULL;
+            nBins           = 0;
+            pChunks         = NULL;
+        }
+
+        PodSet::~PodSet()
+        {
+            flush();
+        }
+
+        void PodSet::release_chunks()
+        {
+            for (chunk_t *c = pChunks; c != NULL; )
+            {
+                chunk_t *next   = c->next;
+                free(c);
+                c               = next;
+            }
+            pChunks         = NULL;
+        }
+
+        void PodSet::clear()
+        {
+            release_chunks();
+            if (vBins != NULL)
+                memset(vBins, 0, nBins * sizeof(uint32_t));
+            nItems          = 0;
+        }
+
+        void PodSet::flush()
+        {
+            release_chunks();
+            if (vItems != NULL)
+            {
+                free(vItems);
+                vItems          = NULL;
+            }
+            if (vBins != NULL)
+            {
+                free(vBins);
+                vBins           = NULL;
+            }
+
+            nItems          = 0;
+            nCapacity       = 0;
+            nBins           = 0;
+        }
+
+        status_t PodSet::rehash(size_t bins)
+        {
+            uint32_t *vb    = static_cast<uint32_t *>(malloc(bins * sizeof(uint32_t)));
+            if (vb == NULL)
+                return STATUS_NO_MEM;
+            memset(vb, 0, bins * sizeof(uint32_t));
+
+            const size_t mask = bins - 1;
+            for (size_t i=0; i<nItems; ++i)
+            {
+                size_t bin      = vItems[i].hash & mask;
+                while (vb[bin] != 0)
+                    bin             = (bin + 1) & mask;
+                vb[bin]         = uint32_t(i + 1);
+            }
+
+            if (vBins != NULL)
+                free(vBins);
+            vBins           = vb;
+            nBins           = bins;
+
+            return STATUS_OK;
+        }
+
+        status_t PodSet::reserve(size_t count)
+        {
+            if (count > nCapacity)
+            {
+                item_t *vi      = static_cast<item_t *>(realloc(vItems, count * sizeof(item_t)));
+                if (vi == NULL)
+                    return STATUS_NO_MEM;
+                vItems          = vi;
+                nCapacity       = count;
+            }
+
+            // Keep the load factor of bins not greater than 0.75
+            size_t bins     = lsp_max(nBins, POD_SET_MIN_BINS);
+            while ((bins * 3) < (count * 4))
+                bins          <<= 1;
+
+            return (bins != nBins) ? rehash(bins) : STATUS_OK;
+        }
+
+        ssize_t PodSet::lookup(uint64_t hash, const struct spa_pod *pod, size_t *bin) const
+        {
+            if (nBins == 0)
+                return -1;
+
+            const size_t mask   = nBins - 1;
+            size_t idx          = hash & mask;
+
+            for (uint32_t ref; (ref = vBins[idx]) != 0; idx = (idx + 1) & mask)
+            {
+                const item_t *it    = &vItems[ref - 1];
+                if ((it->hash == hash) && (pod_equals(it->pod, pod)))
+                    return ref - 1;
+            }
+
+            if (bin != NULL)
+                *bin                = idx;
+            return -1;
+        }
+
+        struct spa_pod *PodSet::store(const struct spa_pod *pod)
+        {
+            const size_t size   = align_size(SPA_POD_SIZE(pod), SPA_POD_ALIGN);
+            const size_t hdr    = align_size(sizeof(chunk_t), SPA_POD_ALIGN);
+
+            chunk_t *c          = pChunks;
+            if ((c == NULL) || ((c->used + size) > c->size))
+            {
+                const size_t cap    = lsp_max(size, POD_SET_CHUNK_SIZE);
+                c                   = static_cast<chunk_t *>(malloc(hdr + cap));
+                if (c == NULL)
+                    return NULL;
+
+                c->next             = pChunks;
+                c->used             = 0;
+                c->size             = cap;
+                pChunks             = c;
+            }
+
+            uint8_t *dst        = reinterpret_cast<uint8_t *>(c) + hdr + c->used;
+            memcpy(dst, pod, SPA_POD_SIZE(pod));
+            c->used            += size;
+
+            return reinterpret_cast<struct spa_pod *>(dst);
+        }
+
+        status_t PodSet::insert(const struct spa_pod *pod, const struct spa_pod **stored)
+        {
+            if (pod == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            // Ensure that there is enough space before lookup to keep the found bin index valid
+            if ((nItems >= nCapacity) || ((nItems + 1) * 4 > nBins * 3))
+            {
+                status_t res        = reserve(lsp_max(nItems * 2, POD_SET_MIN_BINS));
+                if (res != STATUS_OK)
+                    return res;
+            }
+
+            const uint64_t hash = pod_hash(pod);
+            size_t bin          = 0;
+            ssize_t index       = lookup(hash, pod, &bin);
+            if (index >= 0)
+            {
+                if (stored != NULL)
+                    *stored             = vItems[index].pod;
+                return STATUS_ALREADY_EXISTS;
+            }
+
+            struct spa_pod *copy= store(pod);
+            if (copy == NULL)
+                return STATUS_NO_MEM;
+
+            item_t *it          = &vItems[nItems++];
+            it->hash            = hash;
+            it->pod             = copy;
+            vBins[bin]          = uint32_t(nItems);
+
+            if (stored != NULL)
+                *stored             = copy;
+
+            return STATUS_OK;
+        }
+
+        const struct spa_pod *PodSet::find(const struct spa_pod *pod) const
+        {
+            if (pod == NULL)
+                return NULL;
+
+            ssize_t index       = lookup(pod_hash(pod), pod, NULL);
+            return (index >= 0) ? vItems[index].pod : NULL;
+        }
+
+    } /* namespace spa */
+} /* namespace lsp */
@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/RateLimiter.h>
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+namespace lsp
+{
+    namespace spa
+    {
+        static constexpr size_t RATE_LIMITER_ALIGN      = 0x40;
+
+        constexpr size_t RateLimiter::MAX_PROBE;
+        constexpr size_t RateLimiter::WINDOW_TICKS;
+        constexpr size_t RateLimiter::IDLE_WINDOWS;
+        constexpr uint32_t RateLimiter::MAX_COUNT;
+
+        namespace
+        {
+            // Bucket state: | window start: 32 bits | passed: 16 bits | suppressed: 16 bits |
+            inline uint64_t make_state(uint32_t begin, uint32_t passed, uint32_t suppressed)
+            {
+                return (uint64_t(begin) << 32) | (uint64_t(passed) << 16) | uint64_t(suppressed);
+            }
+
+            inline uint32_t state_begin(uint64_t state)         { return uint32_t(state >> 32);             }
+            inline uint32_t state_passed(uint64_t state)        { return uint32_t(state >> 16) & 0xffff;    }
+            inline uint32_t state_suppressed(uint64_t state)    { return uint32_t(state) & 0xffff;          }
+
+            // Marker of the bucket which is being reclaimed, test() never produces states
+            // with zero passed events except the initial zero state
+            static constexpr uint64_t STATE_CLAIMING            = 0xffff;
+
+            // Bijective mix of the key, the lowest bit marks non-empty bucket
+            inline uint64_t hash_key(uint64_t key)
+            {
+                key ^= key >> 33;
+                key *= 0xff51afd7ed558ccdULL;
+                key ^= key >> 33;
+                key *= 0xc4ceb9fe1a85ec53ULL;
+                key ^= key >> 33;
+                return key | 1;
+            }
+        } /* namespace */
+
+        RateLimiter::RateLimiter()
+        {
+            vBuckets        = NULL;
+            nMask           = 0;
+            nShift          = 0;
+            nWindow         = 0;
+            nBurst          = 0;
+            nSuppressed     = 0;
+            pData           = NULL;
+        }
+
+        RateLimiter::~RateLimiter()
+        {
+            destroy();
+        }
+
+        void RateLimiter::destroy()
+        {
+            free_aligned(pData);
+            vBuckets        = NULL;
+            nMask           = 0;
+            nShift          = 0;
+            nWindow         = 0;
+            nBurst          = 0;
+            nSuppressed     = 0;
+        }
+
+        status_t RateLimiter::init(size_t sources, uint64_t interval, uint32_t burst)
+        {
+            if ((sources == 0) || (interval == 0) || (burst == 0) || (burst > MAX_COUNT))
+                return STATUS_BAD_ARGUMENTS;
+
+            size_t count        = 1;
+            while (count < sources)
+                count             <<= 1;
+
+            // Allocate buckets and one overflow bucket
+            uint8_t *data       = NULL;
+            bucket_t *buckets   = alloc_aligned<bucket_t>(data, count + 1, RATE_LIMITER_ALIGN);
+            if (buckets == NULL)
+                return STATUS_NO_MEM;
+
+            destroy();
+
+            // Choose the power of 2 tick to keep at least WINDOW_TICKS ticks per interval
+            size_t shift        = 0;
+            while ((interval >> (shift + 1)) >= WINDOW_TICKS)
+                ++shift;
+
+            vBuckets            = buckets;
+            nMask               = count - 1;
+            nShift              = shift;
+            nWindow             = uint32_t(interval >> shift);
+            nBurst              = burst;
+            pData               = data;
+
+            reset();
+
+            return STATUS_OK;
+        }
+
+        void RateLimiter::reset()
+        {
+            if (vBuckets != NULL)
+                memset(vBuckets, 0, (nMask + 2) * sizeof(bucket_t));
+            nSuppressed         = 0;
+        }
+
+        RateLimiter::bucket_t *RateLimiter::find(uint64_t hash, uint32_t stamp)
+        {
+            const size_t index  = size_t(hash >> 1);
+
+            // Lookup for existing bucket or claim the empty one
+            for (size_t i=0; i<MAX_PROBE; ++i)
+            {
+                bucket_t *b         = &vBuckets[(index + i) & nMask];
+                const uint64_t k    = atomic_load(&b->key);
+                if (k == hash)
+                    return b;
+                if (k != 0)
+                    continue;
+                if (atomic_cas(&b->key, uint64_t(0), hash))
+                    return b;
+                if (atomic_load(&b->key) == hash)
+                    return b;
+            }
+
+            // Reuse the bucket which stays idle for a long time
+            const int32_t idle  = int32_t(nWindow * IDLE_WINDOWS);
+            for (size_t i=0; i<MAX_PROBE; ++i)
+            {
+                bucket_t *b         = &vBuckets[(index + i) & nMask];
+                const uint64_t k    = atomic_load(&b->key);
+                const uint64_t s    = atomic_load(&b->state);
+
+                // The bucket which has been claimed but not used yet has no window and is not idle,
+                // the bucket which is being reclaimed by other thread is not idle too
+                if ((k == 0) || (state_passed(s) == 0))
+                    continue;
+                const int32_t delta = int32_t(stamp - state_begin(s));
+                if ((delta <= idle) && (delta >= -idle))
+                    continue;
+
+                // Mark the bucket as being reclaimed: this fails if the owner has updated the state since
+                // it has been checked. While the bucket is marked, the owner uses the overflow bucket.
+                if (!atomic_cas(&b->state, s, STATE_CLAIMING))
+                    continue;
+
+                // Non-empty key is changed only by the thread which has marked the bucket
+                if (!atomic_cas(&b->key, k, hash))
+                {
+                    atomic_store(&b->state, s);
+                    continue;
+                }
+
+                // Publish the new key with the fresh state
+                atomic_store(&b->state, uint64_t(0));
+                return b;
+            }
+
+            // Use the overflow bucket
+            return &vBuckets[nMask + 1];
+        }
+
+        int RateLimiter::test(uint64_t key, uint64_t now)
+        {
+            if (vBuckets == NULL)
+                return 0;
+
+            const uint64_t hash     = hash_key(key);
+            const uint32_t stamp    = uint32_t(now >> nShift);
+            bucket_t *overflow      = &vBuckets[nMask + 1];
+            bucket_t *b             = find(hash, stamp);
+
+            uint64_t s              = atomic_load(&b->state);
+            uint64_t ns;
+            int res;
+
+            while (true)
+            {
+                // The bucket is being reclaimed or has been reclaimed by other source: the key is
+                // changed before the state is released, so the key check after the state load is
+                // enough to detect it
+                if ((b != overflow) &&
+                    ((s == STATE_CLAIMING) || (atomic_load(&b->key) != hash)))
+                {
+                    b                       = overflow;
+                    s                       = atomic_load(&b->state);
+                }
+
+                const uint32_t begin    = state_begin(s);
+                const uint32_t passed   = state_passed(s);
+                const uint32_t supp     = state_suppressed(s);
+
+                const int32_t delta     = int32_t(stamp - begin);
+
+                // Events of other threads with time a bit earlier than the window start fall into the window
+                if ((passed == 0) || (delta > int32_t(nWindow)) || (delta < -int32_t(nWindow)))
+                {
+                    // Open new window and report suppressed events
+                    ns                      = make_state(stamp, 1, 0);
+                    res                     = int(supp);
+                }
+                else if (passed >= nBurst)
+                {
+                    ns                      = make_state(begin, passed, lsp_min(supp + 1, MAX_COUNT));
+                    res                     = -1;
+                }
+                else
+                {
+                    ns                      = make_state(begin, passed + 1, supp);
+                    res                     = 0;
+                }
+
+                if (atomic_cas(&b->state, s, ns))
+                    break;
+                s                       = atomic_load(&b->state);
+            }
+
+            if (res < 0)
+                atomic_add(&nSuppressed, uint64_t(1));
+
+            return res;
+        }
+
+        size_t RateLimiter::sources() const
+        {
+            size_t count = 0;
+            for (size_t i=0; i<=nMask; ++i)
+                if ((vBuckets != NULL) && (atomic_load(&vBuckets[i].key) != 0))
+                    ++count;
+            return count;
+        }
+
+    } /* namespace spa */
+} /* namespace lsp */
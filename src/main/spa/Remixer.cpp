@@ -0,0 +1,512 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/Remixer.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#if defined(__SSE2__) && defined(__GNUC__)
+    #include <emmintrin.h>
+    #define LSP_SPA_REMIXER_SSE2
+#endif /* __SSE2__ */
+
+namespace lsp
+{
+    namespace spa
+    {
+        namespace
+        {
+            // Number of samples processed by all operations at once, keeps destination buffers in cache
+            static constexpr size_t REMIX_BLOCK_SIZE    = 1024;
+
+            // Maximum depth of the fold rule chain
+            static constexpr size_t REMIX_MAX_DEPTH     = 8;
+
+            // Pseudo-position of channel with unknown position, combined with channel index
+            static constexpr uint32_t POSITION_INDEXED  = 0x80000000;
+
+            static constexpr float K_3DB                = 0.70710678f;
+
+            typedef struct target_t
+            {
+                uint32_t        pos;            // Target position
+                float           k;              // Coefficient
+            } target_t;
+
+            typedef struct fold_t
+            {
+                uint32_t        pos;            // Folded position
+                uint32_t        flags;          // Flags required to apply the rule
+                uint32_t        count;          // Number of targets
+                target_t        t[2];           // Targets
+            } fold_t;
+
+            /**
+             * Fold rules: the position is replaced with the combination of targets. Rules
+             * for the same position are listed in order of preference, the rule is applicable
+             * if all targets are present or can be folded further. Rules with all targets present
+             * take precedence over rules that need further folding.
+             */
+            static const fold_t fold_rules[] =
+            {
+                { SPA_AUDIO_CHANNEL_MONO,   0,  1, { { SPA_AUDIO_CHANNEL_FC,    1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_MONO,   0,  2, { { SPA_AUDIO_CHANNEL_FL,    1.0f    }, { SPA_AUDIO_CHANNEL_FR,  1.0f    } } },
+                { SPA_AUDIO_CHANNEL_FL,     0,  1, { { SPA_AUDIO_CHANNEL_MONO,  0.5f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_FR,     0,  1, { { SPA_AUDIO_CHANNEL_MONO,  0.5f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_FC,     0,  2, { { SPA_AUDIO_CHANNEL_FL,    K_3DB   }, { SPA_AUDIO_CHANNEL_FR,  K_3DB   } } },
+                { SPA_AUDIO_CHANNEL_FC,     0,  1, { { SPA_AUDIO_CHANNEL_MONO,  1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_LFE,    0,  1, { { SPA_AUDIO_CHANNEL_LFE2,  1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_LFE,    Remixer::F_MIX_LFE,
+                                                2, { { SPA_AUDIO_CHANNEL_FL,    0.5f    }, { SPA_AUDIO_CHANNEL_FR,  0.5f    } } },
+                { SPA_AUDIO_CHANNEL_LFE2,   0,  1, { { SPA_AUDIO_CHANNEL_LFE,   1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_LFE2,   Remixer::F_MIX_LFE,
+                                                2, { { SPA_AUDIO_CHANNEL_FL,    0.5f    }, { SPA_AUDIO_CHANNEL_FR,  0.5f    } } },
+                { SPA_AUDIO_CHANNEL_SL,     0,  1, { { SPA_AUDIO_CHANNEL_RL,    1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_SL,     0,  1, { { SPA_AUDIO_CHANNEL_FL,    K_3DB   }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_SR,     0,  1, { { SPA_AUDIO_CHANNEL_RR,    1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_SR,     0,  1, { { SPA_AUDIO_CHANNEL_FR,    K_3DB   }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_RL,     0,  1, { { SPA_AUDIO_CHANNEL_SL,    1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_RL,     0,  1, { { SPA_AUDIO_CHANNEL_FL,    K_3DB   }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_RR,     0,  1, { { SPA_AUDIO_CHANNEL_SR,    1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_RR,     0,  1, { { SPA_AUDIO_CHANNEL_FR,    K_3DB   }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_RC,     0,  2, { { SPA_AUDIO_CHANNEL_RL,    K_3DB   }, { SPA_AUDIO_CHANNEL_RR,  K_3DB   } } },
+                { SPA_AUDIO_CHANNEL_FLC,    0,  1, { { SPA_AUDIO_CHANNEL_FL,    1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_FRC,    0,  1, { { SPA_AUDIO_CHANNEL_FR,    1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_FLW,    0,  1, { { SPA_AUDIO_CHANNEL_FL,    1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_FRW,    0,  1, { { SPA_AUDIO_CHANNEL_FR,    1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_RLC,    0,  1, { { SPA_AUDIO_CHANNEL_RL,    1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_RRC,    0,  1, { { SPA_AUDIO_CHANNEL_RR,    1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_TC,     0,  2, { { SPA_AUDIO_CHANNEL_TFL,   K_3DB   }, { SPA_AUDIO_CHANNEL_TFR, K_3DB   } } },
+                { SPA_AUDIO_CHANNEL_TFL,    0,  1, { { SPA_AUDIO_CHANNEL_FL,    K_3DB   }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_TFR,    0,  1, { { SPA_AUDIO_CHANNEL_FR,    K_3DB   }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_TFC,    0,  1, { { SPA_AUDIO_CHANNEL_FC,    K_3DB   }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_TRL,    0,  1, { { SPA_AUDIO_CHANNEL_RL,    K_3DB   }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_TRR,    0,  1, { { SPA_AUDIO_CHANNEL_RR,    K_3DB   }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_TRC,    0,  1, { { SPA_AUDIO_CHANNEL_RC,    K_3DB   }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_TSL,    0,  1, { { SPA_AUDIO_CHANNEL_SL,    K_3DB   }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_TSR,    0,  1, { { SPA_AUDIO_CHANNEL_SR,    K_3DB   }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_FLH,    0,  1, { { SPA_AUDIO_CHANNEL_TFL,   1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_FRH,    0,  1, { { SPA_AUDIO_CHANNEL_TFR,   1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_FCH,    0,  1, { { SPA_AUDIO_CHANNEL_TFC,   1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_TFLC,   0,  1, { { SPA_AUDIO_CHANNEL_TFL,   1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_TFRC,   0,  1, { { SPA_AUDIO_CHANNEL_TFR,   1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_LLFE,   0,  1, { { SPA_AUDIO_CHANNEL_LFE,   1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_RLFE,   0,  1, { { SPA_AUDIO_CHANNEL_LFE,   1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_BC,     0,  1, { { SPA_AUDIO_CHANNEL_FC,    1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_BLC,    0,  1, { { SPA_AUDIO_CHANNEL_FL,    1.0f    }, { 0, 0.0f } } },
+                { SPA_AUDIO_CHANNEL_BRC,    0,  1, { { SPA_AUDIO_CHANNEL_FR,    1.0f    }, { 0, 0.0f } } },
+            };
+
+            typedef struct layout_t
+            {
+                const uint32_t *pos;            // Effective channel positions
+                size_t          count;          // Number of channels
+                size_t          flags;          // Remix flags
+            } layout_t;
+
+            inline uint32_t effective_position(uint32_t pos, size_t index)
+            {
+                return (pos == SPA_AUDIO_CHANNEL_UNKNOWN) ? POSITION_INDEXED | uint32_t(index) : pos;
+            }
+
+            bool contains(const layout_t *l, uint32_t pos)
+            {
+                for (size_t i=0; i<l->count; ++i)
+                    if (l->pos[i] == pos)
+                        return true;
+                return false;
+            }
+
+            bool reachable(const layout_t *l, uint32_t pos, uint32_t *path, size_t depth);
+
+            bool direct(const layout_t *l, const fold_t *rule)
+            {
+                if ((rule->flags & ~l->flags) != 0)
+                    return false;
+                for (size_t i=0; i<rule->count; ++i)
+                    if (!contains(l, rule->t[i].pos))
+                        return false;
+                return true;
+            }
+
+            bool applicable(const layout_t *l, const fold_t *rule, uint32_t *path, size_t depth)
+            {
+                if ((rule->flags & ~l->flags) != 0)
+                    return false;
+                for (size_t i=0; i<rule->count; ++i)
+                    if (!reachable(l, rule->t[i].pos, path, depth + 1))
+                        return false;
+                return true;
+            }
+
+            /**
+             * Find the first applicable fold rule for the position
+             * @param l layout
+             * @param pos position to fold
+             * @param path positions folded on the way to this position, used to break cycles
+             * @param depth depth of the fold rule chain
+             * @return fold rule or NULL
+             */
+            const fold_t *find_rule(const layout_t *l, uint32_t pos, uint32_t *path, size_t depth)
+            {
+                if (depth >= REMIX_MAX_DEPTH)
+                    return NULL;
+                for (size_t i=0; i<depth; ++i)
+                    if (path[i] == pos)
+                        return NULL;
+
+                path[depth]     = pos;
+
+                // Prefer rules with targets present in the layout over chains of rules
+                for (size_t i=0; i<sizeof(fold_rules)/sizeof(fold_rules[0]); ++i)
+                {
+                    const fold_t *rule = &fold_rules[i];
+                    if ((rule->pos == pos) && (direct(l, rule)))
+                        return rule;
+                }
+                for (size_t i=0; i<sizeof(fold_rules)/sizeof(fold_rules[0]); ++i)
+                {
+                    const fold_t *rule = &fold_rules[i];
+                    if ((rule->pos == pos) && (applicable(l, rule, path, depth)))
+                        return rule;
+                }
+                return NULL;
+            }
+
+            bool reachable(const layout_t *l, uint32_t pos, uint32_t *path, size_t depth)
+            {
+                return (contains(l, pos)) || (find_rule(l, pos, path, depth) != NULL);
+            }
+
+            /**
+             * Distribute the coefficient of position over channels of the layout
+             * @param l layout
+             * @param row coefficients for each channel of the layout
+             * @param stride stride between coefficients
+             * @param pos position to distribute
+             * @param k coefficient
+             * @param path positions folded on the way to this position
+             * @param depth depth of the fold rule chain
+             */
+            void distribute(const layout_t *l, float *row, size_t stride, uint32_t pos, float k, uint32_t *path, size_t depth)
+            {
+                if (contains(l, pos))
+                {
+                    for (size_t i=0; i<l->count; ++i)
+                        if (l->pos[i] == pos)
+                            row[i * stride]    += k;
+                    return;
+                }
+
+                const fold_t *rule = find_rule(l, pos, path, depth);
+                if (rule == NULL)
+                    return;
+                for (size_t i=0; i<rule->count; ++i)
+                    distribute(l, row, stride, rule->t[i].pos, k * rule->t[i].k, path, depth + 1);
+            }
+
+            /**
+             * Mix N terms into destination buffer
+             * @param N number of terms
+             * @param ACC add result to the destination buffer
+             */
+            template <size_t N, bool ACC>
+            void mix(float *dst, const float * const *src, const float *k, size_t count)
+            {
+                size_t i = 0;
+
+            #ifdef LSP_SPA_REMIXER_SSE2
+                __m128 vk[N];
+                for (size_t j=0; j<N; ++j)
+                    vk[j]       = _mm_set1_ps(k[j]);
+
+                for ( ; i + 8 <= count; i += 8)
+                {
+                    __m128 a    = (ACC) ? _mm_loadu_ps(&dst[i]) : _mm_setzero_ps();
+                    __m128 b    = (ACC) ? _mm_loadu_ps(&dst[i + 4]) : _mm_setzero_ps();
+                    for (size_t j=0; j<N; ++j)
+                    {
+                        a           = _mm_add_ps(a, _mm_mul_ps(_mm_loadu_ps(&src[j][i]), vk[j]));
+                        b           = _mm_add_ps(b, _mm_mul_ps(_mm_loadu_ps(&src[j][i + 4]), vk[j]));
+                    }
+                    _mm_storeu_ps(&dst[i], a);
+                    _mm_storeu_ps(&dst[i + 4], b);
+                }
+            #endif /* LSP_SPA_REMIXER_SSE2 */
+
+                for ( ; i < count; ++i)
+                {
+                    float v     = (ACC) ? dst[i] : 0.0f;
+                    for (size_t j=0; j<N; ++j)
+                        v          += src[j][i] * k[j];
+                    dst[i]      = v;
+                }
+            }
+
+            void mix_zero(float *dst, const float * const *src, const float *k, size_t count)
+            {
+                memset(dst, 0, count * sizeof(float));
+            }
+
+            void mix_copy(float *dst, const float * const *src, const float *k, size_t count)
+            {
+                memcpy(dst, src[0], count * sizeof(float));
+            }
+
+            typedef void (* mix_t)(float *dst, const float * const *src, const float *k, size_t count);
+
+            static const mix_t mix_kernels[2][4] =
+            {
+                { mix<1, false>,    mix<2, false>,  mix<3, false>,  mix<4, false>   },
+                { mix<1, true>,     mix<2, true>,   mix<3, true>,   mix<4, true>    },
+            };
+        } /* namespace */
+
+        constexpr size_t Remixer::MAX_TERMS;
+
+        Remixer::Remixer()
+        {
+            vMatrix         = NULL;
+            vOps            = NULL;
+            nOps            = 0;
+            nDst            = 0;
+            nSrc            = 0;
+        }
+
+        Remixer::~Remixer()
+        {
+            destroy();
+        }
+
+        void Remixer::destroy()
+        {
+            if (vMatrix != NULL)
+            {
+                free(vMatrix);
+                vMatrix         = NULL;
+            }
+            if (vOps != NULL)
+            {
+                free(vOps);
+                vOps            = NULL;
+            }
+            nOps            = 0;
+            nDst            = 0;
+            nSrc            = 0;
+        }
+
+        status_t Remixer::allocate(size_t dst_channels, size_t src_channels)
+        {
+            // Each row produces at most one operation per MAX_TERMS coefficients
+            const size_t ops    = dst_channels * ((src_channels + MAX_TERMS - 1) / MAX_TERMS);
+            float *m            = static_cast<float *>(malloc(dst_channels * src_channels * sizeof(float)));
+            op_t *o             = static_cast<op_t *>(malloc(lsp_max(ops, dst_channels) * sizeof(op_t)));
+            if ((m == NULL) || (o == NULL))
+            {
+                free(m);
+                free(o);
+                return STATUS_NO_MEM;
+            }
+
+            destroy();
+            vMatrix         = m;
+            vOps            = o;
+            nDst            = dst_channels;
+            nSrc            = src_channels;
+            memset(vMatrix, 0, nDst * nSrc * sizeof(float));
+
+            return STATUS_OK;
+        }
+
+        void Remixer::compile()
+        {
+            nOps            = 0;
+
+            for (size_t i=0; i<nDst; ++i)
+            {
+                const float *row    = &vMatrix[i * nSrc];
+                op_t *op            = NULL;
+                size_t chunks       = 0;
+
+                for (size_t j=0; j<nSrc; ++j)
+                {
+                    if (row[j] == 0.0f)
+                        continue;
+                    if ((op == NULL) || (op->terms >= MAX_TERMS))
+                    {
+                        op                  = &vOps[nOps++];
+                        op->dst             = uint32_t(i);
+                        op->terms           = 0;
+                        op->mix             = NULL;
+                        ++chunks;
+                    }
+                    op->src[op->terms]  = uint32_t(j);
+                    op->k[op->terms]    = row[j];
+                    ++op->terms;
+                }
+
+                if (chunks == 0)
+                {
+                    op                  = &vOps[nOps++];
+                    op->mix             = mix_zero;
+                    op->dst             = uint32_t(i);
+                    op->terms           = 0;
+                    continue;
+                }
+
+                // Assign kernels: the first operation of the row overwrites, others accumulate
+                op_t *first         = &vOps[nOps - chunks];
+                for (op = first; op < &vOps[nOps]; ++op)
+                    op->mix             = mix_kernels[(op == first) ? 0 : 1][op->terms - 1];
+                if ((chunks == 1) && (first->terms == 1) && (first->k[0] == 1.0f))
+                    first->mix          = mix_copy;
+            }
+        }
+
+        status_t Remixer::init(const uint32_t *dst, size_t dst_channels, const uint32_t *src, size_t src_channels, size_t flags)
+        {
+            if ((dst == NULL) || (src == NULL) || (dst_channels <= 0) || (src_channels <= 0))
+                return STATUS_BAD_ARGUMENTS;
+
+            uint32_t *dpos      = static_cast<uint32_t *>(malloc((dst_channels + src_channels) * sizeof(uint32_t)));
+            if (dpos == NULL)
+                return STATUS_NO_MEM;
+            uint32_t *spos      = &dpos[dst_channels];
+            for (size_t i=0; i<dst_channels; ++i)
+                dpos[i]             = effective_position(dst[i], i);
+            for (size_t i=0; i<src_channels; ++i)
+                spos[i]             = effective_position(src[i], i);
+
+            status_t res        = allocate(dst_channels, src_channels);
+            if (res != STATUS_OK)
+            {
+                free(dpos);
+                return res;
+            }
+
+            const layout_t dl   = { dpos, dst_channels, flags };
+            const layout_t sl   = { spos, src_channels, flags };
+            uint32_t path[REMIX_MAX_DEPTH];
+
+            // Fold each source channel into destination channels
+            for (size_t j=0; j<src_channels; ++j)
+            {
+                if (spos[j] != SPA_AUDIO_CHANNEL_NA)
+                    distribute(&dl, &vMatrix[j], nSrc, spos[j], 1.0f, path, 0);
+            }
+
+            // Derive destination channels that have no source
+            if (flags & F_UPMIX)
+            {
+                for (size_t i=0; i<dst_channels; ++i)
+                {
+                    float *row          = &vMatrix[i * nSrc];
+                    if ((dpos[i] == SPA_AUDIO_CHANNEL_NA) || (dpos[i] & POSITION_INDEXED) ||
+                        (SPA_AUDIO_CHANNEL_IS_AUX(dpos[i])))
+                        continue;
+
+                    bool empty          = true;
+                    for (size_t j=0; (empty) && (j<src_channels); ++j)
+                        empty               = (row[j] == 0.0f);
+                    if (empty)
+                        distribute(&sl, row, 1, dpos[i], 1.0f, path, 0);
+                }
+            }
+
+            free(dpos);
+
+            // Normalize the matrix
+            if (flags & F_NORMALIZE)
+            {
+                float max           = 0.0f;
+                for (size_t i=0; i<nDst; ++i)
+                {
+                    float sum           = 0.0f;
+                    for (size_t j=0; j<nSrc; ++j)
+                        sum                += fabsf(vMatrix[i * nSrc + j]);
+                    max                 = lsp_max(max, sum);
+                }
+                if (max > 1.0f)
+                {
+                    const float k       = 1.0f / max;
+                    for (size_t i=0, n=nDst * nSrc; i<n; ++i)
+                        vMatrix[i]         *= k;
+                }
+            }
+
+            compile();
+
+            return STATUS_OK;
+        }
+
+        status_t Remixer::init(const struct spa_audio_layout_info *dst, const struct spa_audio_layout_info *src, size_t flags)
+        {
+            if ((dst == NULL) || (src == NULL))
+                return STATUS_BAD_ARGUMENTS;
+            return init(dst->position, dst->n_channels, src->position, src->n_channels, flags);
+        }
+
+        status_t Remixer::set_matrix(const float *matrix)
+        {
+            if (matrix == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            if (vMatrix == NULL)
+                return STATUS_BAD_STATE;
+
+            memcpy(vMatrix, matrix, nDst * nSrc * sizeof(float));
+            compile();
+
+            return STATUS_OK;
+        }
+
+        float Remixer::get(size_t dst, size_t src) const
+        {
+            return ((dst < nDst) && (src < nSrc)) ? vMatrix[dst * nSrc + src] : 0.0f;
+        }
+
+        size_t Remixer::terms() const
+        {
+            size_t count = 0;
+            for (size_t i=0; i<nOps; ++i)
+                count          += vOps[i].terms;
+            return count;
+        }
+
+        void Remixer::process(float * const *dst, const float * const *src, size_t samples) const
+        {
+            const float *s[MAX_TERMS];
+
+            for (size_t offset=0; offset < samples; offset += REMIX_BLOCK_SIZE)
+            {
+                const size_t count  = lsp_min(samples - offset, REMIX_BLOCK_SIZE);
+                for (size_t i=0; i<nOps; ++i)
+                {
+                    const op_t *op      = &vOps[i];
+                    for (size_t j=0; j<op->terms; ++j)
+                        s[j]                = &src[op->src[j]][offset];
+                    op->mix(&dst[op->dst][offset], s, op->k, count);
+                }
+            }
+        }
+
+    } /* namespace spa */
+} /* namespace lsp */
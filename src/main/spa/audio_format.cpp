@@ -0,0 +1,547 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/audio_format.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <pw-headers/spa/param/audio/raw-utils.h>
+#include <pw-headers/spa/param/format-utils.h>
+
+#if defined(__SSE2__) && defined(__GNUC__)
+    #include <emmintrin.h>
+    #define LSP_SPA_AUDIO_SSE2
+#endif /* __SSE2__ */
+
+namespace lsp
+{
+    namespace spa
+    {
+        namespace
+        {
+        #if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            static constexpr bool SWAP_LE   = true;
+            static constexpr bool SWAP_BE   = false;
+        #else
+            static constexpr bool SWAP_LE   = false;
+            static constexpr bool SWAP_BE   = true;
+        #endif /* __BYTE_ORDER__ */
+
+            /**
+             * Integer sample codec
+             * @param BITS number of significant bits
+             * @param BYTES size of the sample in bytes
+             * @param SWAP swap bytes when reading and writing
+             */
+            template <size_t BITS, size_t BYTES, bool SWAP>
+            struct int_codec
+            {
+                static constexpr size_t SIZE    = BYTES;
+                static constexpr float  K_READ  = 1.0f / float(1u << (BITS - 1));
+                static constexpr float  K_WRITE = float(1u << (BITS - 1));
+                static constexpr float  V_MIN   = -float(1u << (BITS - 1));
+                static constexpr float  V_MAX   = float((1u << (BITS - 1)) - 1);
+                static constexpr float  V_OVER  = float(1u << (BITS - 1));
+
+                static inline int32_t decode(const uint8_t *p)
+                {
+                    if (BYTES == 2)
+                    {
+                        uint16_t v;
+                        memcpy(&v, p, sizeof(v));
+                        if (SWAP)
+                            v   = __builtin_bswap16(v);
+                        return int16_t(v);
+                    }
+                    if (BYTES == 3)
+                    {
+                        const uint32_t v = (SWAP) ?
+                            (uint32_t(p[0]) << 16) | (uint32_t(p[1]) << 8) | uint32_t(p[2]) :
+                            (uint32_t(p[2]) << 16) | (uint32_t(p[1]) << 8) | uint32_t(p[0]);
+                        return int32_t(v << 8) >> 8;
+                    }
+
+                    uint32_t v;
+                    memcpy(&v, p, sizeof(v));
+                    if (SWAP)
+                        v   = __builtin_bswap32(v);
+                    return (BITS < 32) ? int32_t(v << (32 - BITS)) >> (32 - BITS) : int32_t(v);
+                }
+
+                static inline void encode(uint8_t *p, int32_t x)
+                {
+                    if (BYTES == 2)
+                    {
+                        uint16_t v  = uint16_t(x);
+                        if (SWAP)
+                            v   = __builtin_bswap16(v);
+                        memcpy(p, &v, sizeof(v));
+                        return;
+                    }
+                    if (BYTES == 3)
+                    {
+                        const uint32_t v = uint32_t(x);
+                        p[0]        = uint8_t((SWAP) ? v >> 16 : v);
+                        p[1]        = uint8_t(v >> 8);
+                        p[2]        = uint8_t((SWAP) ? v : v >> 16);
+                        return;
+                    }
+
+                    uint32_t v  = uint32_t(x);
+                    if (SWAP)
+                        v   = __builtin_bswap32(v);
+                    memcpy(p, &v, sizeof(v));
+                }
+
+                static inline float load(const uint8_t *p)
+                {
+                    return float(decode(p)) * K_READ;
+                }
+
+                static inline void store(uint8_t *p, float v)
+                {
+                    // Comparisons are written so that NaN turns into the minimum value
+                    float x     = v * K_WRITE;
+                    x           = (x >= V_MIN) ? x : V_MIN;
+                    if (BITS >= 32)
+                        encode(p, (x >= V_OVER) ? INT32_MAX : int32_t(lrintf(x)));
+                    else
+                    {
+                        x           = (x <= V_MAX) ? x : V_MAX;
+                        encode(p, int32_t(lrintf(x)));
+                    }
+                }
+            };
+
+            /**
+             * Floating-point sample codec
+             * @param F floating-point type
+             * @param U unsigned integer type of the same size
+             * @param SWAP swap bytes when reading and writing
+             */
+            template <class F, class U, bool SWAP>
+            struct float_codec
+            {
+                static constexpr size_t SIZE    = sizeof(F);
+
+                static inline U bswap(U v)
+                {
+                    return (sizeof(U) == sizeof(uint64_t)) ? U(__builtin_bswap64(v)) : U(__builtin_bswap32(uint32_t(v)));
+                }
+
+                static inline float load(const uint8_t *p)
+                {
+                    U v;
+                    F f;
+                    memcpy(&v, p, sizeof(v));
+                    if (SWAP)
+                        v   = bswap(v);
+                    memcpy(&f, &v, sizeof(f));
+                    return float(f);
+                }
+
+                static inline void store(uint8_t *p, float v)
+                {
+                    const F f = F(v);
+                    U u;
+                    memcpy(&u, &f, sizeof(u));
+                    if (SWAP)
+                        u   = bswap(u);
+                    memcpy(p, &u, sizeof(u));
+                }
+            };
+
+            typedef int_codec<16, 2, SWAP_LE>           s16_le_t;
+            typedef int_codec<16, 2, SWAP_BE>           s16_be_t;
+            typedef int_codec<24, 4, SWAP_LE>           s24_32_le_t;
+            typedef int_codec<24, 4, SWAP_BE>           s24_32_be_t;
+            typedef int_codec<32, 4, SWAP_LE>           s32_le_t;
+            typedef int_codec<32, 4, SWAP_BE>           s32_be_t;
+            typedef int_codec<24, 3, SWAP_LE>           s24_le_t;
+            typedef int_codec<24, 3, SWAP_BE>           s24_be_t;
+            typedef float_codec<float, uint32_t, SWAP_LE>   f32_le_t;
+            typedef float_codec<float, uint32_t, SWAP_BE>   f32_be_t;
+            typedef float_codec<double, uint64_t, SWAP_LE>  f64_le_t;
+            typedef float_codec<double, uint64_t, SWAP_BE>  f64_be_t;
+
+            typedef int_codec<16, 2, false>             s16_t;
+            typedef int_codec<24, 4, false>             s24_32_t;
+            typedef int_codec<32, 4, false>             s32_t;
+            typedef int_codec<24, 3, false>             s24_t;
+            typedef float_codec<float, uint32_t, false> f32_t;
+            typedef float_codec<double, uint64_t, false>    f64_t;
+
+            /**
+             * Conversion kernels over codec. Contiguous and stereo kernels are explicitly
+             * specialized for native formats where the vectorized version is available.
+             */
+            template <class C>
+            struct kernels
+            {
+                static void read_n(float *dst, const uint8_t *src, size_t n)
+                {
+                    for (size_t i=0; i<n; ++i, src += C::SIZE)
+                        dst[i]      = C::load(src);
+                }
+
+                static void write_n(uint8_t *dst, const float *src, size_t n)
+                {
+                    for (size_t i=0; i<n; ++i, dst += C::SIZE)
+                        C::store(dst, src[i]);
+                }
+
+                static void read_stereo(float *l, float *r, const uint8_t *src, size_t n)
+                {
+                    for (size_t i=0; i<n; ++i, src += C::SIZE * 2)
+                    {
+                        l[i]        = C::load(src);
+                        r[i]        = C::load(&src[C::SIZE]);
+                    }
+                }
+
+                static void write_stereo(uint8_t *dst, const float *l, const float *r, size_t n)
+                {
+                    for (size_t i=0; i<n; ++i, dst += C::SIZE * 2)
+                    {
+                        C::store(dst, l[i]);
+                        C::store(&dst[C::SIZE], r[i]);
+                    }
+                }
+
+                static void read_interleaved(float * const *dst, const void * const *src, size_t channels, size_t frames)
+                {
+                    const uint8_t *s    = static_cast<const uint8_t *>(src[0]);
+                    if (channels == 1)
+                        read_n(dst[0], s, frames);
+                    else if (channels == 2)
+                        read_stereo(dst[0], dst[1], s, frames);
+                    else
+                    {
+                        for (size_t i=0; i<frames; ++i)
+                            for (size_t j=0; j<channels; ++j, s += C::SIZE)
+                                dst[j][i]   = C::load(s);
+                    }
+                }
+
+                static void write_interleaved(void * const *dst, const float * const *src, size_t channels, size_t frames)
+                {
+                    uint8_t *d          = static_cast<uint8_t *>(dst[0]);
+                    if (channels == 1)
+                        write_n(d, src[0], frames);
+                    else if (channels == 2)
+                        write_stereo(d, src[0], src[1], frames);
+                    else
+                    {
+                        for (size_t i=0; i<frames; ++i)
+                            for (size_t j=0; j<channels; ++j, d += C::SIZE)
+                                C::store(d, src[j][i]);
+                    }
+                }
+
+                static void read_planar(float * const *dst, const void * const *src, size_t channels, size_t frames)
+                {
+                    for (size_t j=0; j<channels; ++j)
+                        read_n(dst[j], static_cast<const uint8_t *>(src[j]), frames);
+                }
+
+                static void write_planar(void * const *dst, const float * const *src, size_t channels, size_t frames)
+                {
+                    for (size_t j=0; j<channels; ++j)
+                        write_n(static_cast<uint8_t *>(dst[j]), src[j], frames);
+                }
+            };
+
+            template <>
+            void kernels<f32_t>::read_n(float *dst, const uint8_t *src, size_t n)
+            {
+                memcpy(dst, src, n * sizeof(float));
+            }
+
+            template <>
+            void kernels<f32_t>::write_n(uint8_t *dst, const float *src, size_t n)
+            {
+                memcpy(dst, src, n * sizeof(float));
+            }
+
+        #ifdef LSP_SPA_AUDIO_SSE2
+            /**
+             * Convert 4 floats to saturated integers, NaN values are converted to minimum
+             */
+            template <class C>
+            inline __m128i sse2_float_to_int(__m128 v)
+            {
+                __m128 x        = _mm_mul_ps(v, _mm_set1_ps(C::K_WRITE));
+                x               = _mm_max_ps(x, _mm_set1_ps(C::V_MIN));
+                x               = _mm_min_ps(x, _mm_set1_ps(C::V_MAX));
+                return _mm_cvtps_epi32(x);
+            }
+
+            template <>
+            inline __m128i sse2_float_to_int<s32_t>(__m128 v)
+            {
+                // Values at or above 2^31 are converted to 0x80000000 and then flipped to INT32_MAX
+                __m128 x        = _mm_mul_ps(v, _mm_set1_ps(s32_t::K_WRITE));
+                x               = _mm_max_ps(x, _mm_set1_ps(s32_t::V_MIN));
+                const __m128i m = _mm_castps_si128(_mm_cmpge_ps(x, _mm_set1_ps(s32_t::V_OVER)));
+                return _mm_xor_si128(_mm_cvtps_epi32(x), m);
+            }
+
+            template <>
+            void kernels<s16_t>::read_n(float *dst, const uint8_t *src, size_t n)
+            {
+                const __m128 k  = _mm_set1_ps(s16_t::K_READ);
+                for ( ; n >= 8; n -= 8, src += 16, dst += 8)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+                    const __m128i a = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+                    const __m128i b = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+                    _mm_storeu_ps(&dst[0], _mm_mul_ps(_mm_cvtepi32_ps(a), k));
+                    _mm_storeu_ps(&dst[4], _mm_mul_ps(_mm_cvtepi32_ps(b), k));
+                }
+                for (size_t i=0; i<n; ++i, src += s16_t::SIZE)
+                    dst[i]      = s16_t::load(src);
+            }
+
+            template <>
+            void kernels<s16_t>::write_n(uint8_t *dst, const float *src, size_t n)
+            {
+                for ( ; n >= 8; n -= 8, src += 8, dst += 16)
+                {
+                    const __m128i a = sse2_float_to_int<s16_t>(_mm_loadu_ps(&src[0]));
+                    const __m128i b = sse2_float_to_int<s16_t>(_mm_loadu_ps(&src[4]));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_packs_epi32(a, b));
+                }
+                for (size_t i=0; i<n; ++i, dst += s16_t::SIZE)
+                    s16_t::store(dst, src[i]);
+            }
+
+            template <>
+            void kernels<s16_t>::read_stereo(float *l, float *r, const uint8_t *src, size_t n)
+            {
+                const __m128 k  = _mm_set1_ps(s16_t::K_READ);
+                for ( ; n >= 4; n -= 4, src += 16, l += 4, r += 4)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+                    const __m128i a = _mm_srai_epi32(_mm_slli_epi32(v, 16), 16);
+                    const __m128i b = _mm_srai_epi32(v, 16);
+                    _mm_storeu_ps(l, _mm_mul_ps(_mm_cvtepi32_ps(a), k));
+                    _mm_storeu_ps(r, _mm_mul_ps(_mm_cvtepi32_ps(b), k));
+                }
+                for (size_t i=0; i<n; ++i, src += s16_t::SIZE * 2)
+                {
+                    l[i]        = s16_t::load(src);
+                    r[i]        = s16_t::load(&src[s16_t::SIZE]);
+                }
+            }
+
+            template <>
+            void kernels<s16_t>::write_stereo(uint8_t *dst, const float *l, const float *r, size_t n)
+            {
+                const __m128i mask  = _mm_set1_epi32(0xffff);
+                for ( ; n >= 4; n -= 4, dst += 16, l += 4, r += 4)
+                {
+                    const __m128i a = sse2_float_to_int<s16_t>(_mm_loadu_ps(l));
+                    const __m128i b = sse2_float_to_int<s16_t>(_mm_loadu_ps(r));
+                    const __m128i v = _mm_or_si128(_mm_and_si128(a, mask), _mm_slli_epi32(b, 16));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), v);
+                }
+                for (size_t i=0; i<n; ++i, dst += s16_t::SIZE * 2)
+                {
+                    s16_t::store(dst, l[i]);
+                    s16_t::store(&dst[s16_t::SIZE], r[i]);
+                }
+            }
+
+            template <>
+            void kernels<s24_32_t>::read_n(float *dst, const uint8_t *src, size_t n)
+            {
+                const __m128 k  = _mm_set1_ps(s24_32_t::K_READ);
+                for ( ; n >= 4; n -= 4, src += 16, dst += 4)
+                {
+                    __m128i v       = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+                    v               = _mm_srai_epi32(_mm_slli_epi32(v, 8), 8);
+                    _mm_storeu_ps(dst, _mm_mul_ps(_mm_cvtepi32_ps(v), k));
+                }
+                for (size_t i=0; i<n; ++i, src += s24_32_t::SIZE)
+                    dst[i]      = s24_32_t::load(src);
+            }
+
+            template <>
+            void kernels<s24_32_t>::write_n(uint8_t *dst, const float *src, size_t n)
+            {
+                for ( ; n >= 4; n -= 4, src += 4, dst += 16)
+                {
+                    const __m128i v = sse2_float_to_int<s24_32_t>(_mm_loadu_ps(src));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), v);
+                }
+                for (size_t i=0; i<n; ++i, dst += s24_32_t::SIZE)
+                    s24_32_t::store(dst, src[i]);
+            }
+
+            template <>
+            void kernels<s32_t>::read_n(float *dst, const uint8_t *src, size_t n)
+            {
+                const __m128 k  = _mm_set1_ps(s32_t::K_READ);
+                for ( ; n >= 4; n -= 4, src += 16, dst += 4)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+                    _mm_storeu_ps(dst, _mm_mul_ps(_mm_cvtepi32_ps(v), k));
+                }
+                for (size_t i=0; i<n; ++i, src += s32_t::SIZE)
+                    dst[i]      = s32_t::load(src);
+            }
+
+            template <>
+            void kernels<s32_t>::write_n(uint8_t *dst, const float *src, size_t n)
+            {
+                for ( ; n >= 4; n -= 4, src += 4, dst += 16)
+                {
+                    const __m128i v = sse2_float_to_int<s32_t>(_mm_loadu_ps(src));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), v);
+                }
+                for (size_t i=0; i<n; ++i, dst += s32_t::SIZE)
+                    s32_t::store(dst, src[i]);
+            }
+
+            template <>
+            void kernels<f32_t>::read_stereo(float *l, float *r, const uint8_t *src, size_t n)
+            {
+                const float *s  = reinterpret_cast<const float *>(src);
+                for ( ; n >= 4; n -= 4, s += 8, l += 4, r += 4)
+                {
+                    const __m128 a  = _mm_loadu_ps(&s[0]);
+                    const __m128 b  = _mm_loadu_ps(&s[4]);
+                    _mm_storeu_ps(l, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+                    _mm_storeu_ps(r, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+                }
+                for (size_t i=0; i<n; ++i, s += 2)
+                {
+                    l[i]        = s[0];
+                    r[i]        = s[1];
+                }
+            }
+
+            template <>
+            void kernels<f32_t>::write_stereo(uint8_t *dst, const float *l, const float *r, size_t n)
+            {
+                float *d        = reinterpret_cast<float *>(dst);
+                for ( ; n >= 4; n -= 4, d += 8, l += 4, r += 4)
+                {
+                    const __m128 a  = _mm_loadu_ps(l);
+                    const __m128 b  = _mm_loadu_ps(r);
+                    _mm_storeu_ps(&d[0], _mm_unpacklo_ps(a, b));
+                    _mm_storeu_ps(&d[4], _mm_unpackhi_ps(a, b));
+                }
+                for (size_t i=0; i<n; ++i, d += 2)
+                {
+                    d[0]        = l[i];
+                    d[1]        = r[i];
+                }
+            }
+        #endif /* LSP_SPA_AUDIO_SSE2 */
+
+        #define INTERLEAVED(fmt, codec, bits, be, flt) \
+            { SPA_AUDIO_FORMAT_ ## fmt, #fmt, codec::SIZE, bits, false, be, flt, \
+              kernels<codec>::read_interleaved, kernels<codec>::write_interleaved }
+        #define PLANAR(fmt, codec, bits, be, flt) \
+            { SPA_AUDIO_FORMAT_ ## fmt, #fmt, codec::SIZE, bits, true, be, flt, \
+              kernels<codec>::read_planar, kernels<codec>::write_planar }
+
+            static const audio_format_desc_t formats[] =
+            {
+                INTERLEAVED(S16_LE,     s16_le_t,       16, false,  false),
+                INTERLEAVED(S16_BE,     s16_be_t,       16, true,   false),
+                INTERLEAVED(S24_32_LE,  s24_32_le_t,    24, false,  false),
+                INTERLEAVED(S24_32_BE,  s24_32_be_t,    24, true,   false),
+                INTERLEAVED(S32_LE,     s32_le_t,       32, false,  false),
+                INTERLEAVED(S32_BE,     s32_be_t,       32, true,   false),
+                INTERLEAVED(S24_LE,     s24_le_t,       24, false,  false),
+                INTERLEAVED(S24_BE,     s24_be_t,       24, true,   false),
+                INTERLEAVED(F32_LE,     f32_le_t,       32, false,  true),
+                INTERLEAVED(F32_BE,     f32_be_t,       32, true,   true),
+                INTERLEAVED(F64_LE,     f64_le_t,       64, false,  true),
+                INTERLEAVED(F64_BE,     f64_be_t,       64, true,   true),
+                PLANAR(S16P,            s16_t,          16, SWAP_LE, false),
+                PLANAR(S24_32P,         s24_32_t,       24, SWAP_LE, false),
+                PLANAR(S32P,            s32_t,          32, SWAP_LE, false),
+                PLANAR(S24P,            s24_t,          24, SWAP_LE, false),
+                PLANAR(F32P,            f32_t,          32, SWAP_LE, true),
+                PLANAR(F64P,            f64_t,          64, SWAP_LE, true),
+            };
+
+        #undef INTERLEAVED
+        #undef PLANAR
+
+        } /* namespace */
+
+        const audio_format_desc_t *audio_format_desc(uint32_t format)
+        {
+            for (const audio_format_desc_t *d = formats, *end = &formats[sizeof(formats)/sizeof(formats[0])]; d < end; ++d)
+            {
+                if (d->format == format)
+                    return d;
+            }
+            return NULL;
+        }
+
+        status_t audio_converter_init(audio_converter_t *conv, const struct spa_audio_info_raw *info)
+        {
+            if ((conv == NULL) || (info == NULL))
+                return STATUS_BAD_ARGUMENTS;
+            if (info->channels <= 0)
+                return STATUS_BAD_FORMAT;
+
+            const audio_format_desc_t *desc = audio_format_desc(info->format);
+            if (desc == NULL)
+                return STATUS_UNSUPPORTED_FORMAT;
+
+            conv->desc          = desc;
+            conv->rate          = info->rate;
+            conv->channels      = info->channels;
+            conv->blocks        = (desc->planar) ? info->channels : 1;
+            conv->stride        = (desc->planar) ? desc->sample_size : desc->sample_size * info->channels;
+            conv->read          = desc->read;
+            conv->write         = desc->write;
+
+            return STATUS_OK;
+        }
+
+        status_t audio_converter_init(audio_converter_t *conv, const struct spa_pod *format)
+        {
+            if ((conv == NULL) || (format == NULL))
+                return STATUS_BAD_ARGUMENTS;
+
+            uint32_t media_type, media_subtype;
+            if (spa_format_parse(format, &media_type, &media_subtype) < 0)
+                return STATUS_BAD_FORMAT;
+            if ((media_type != SPA_MEDIA_TYPE_audio) || (media_subtype != SPA_MEDIA_SUBTYPE_raw))
+                return STATUS_UNSUPPORTED_FORMAT;
+
+            struct spa_audio_info_raw info;
+            memset(&info, 0, sizeof(info));
+            if (spa_format_audio_raw_parse(format, &info) < 0)
+                return STATUS_BAD_FORMAT;
+
+            return audio_converter_init(conv, &info);
+        }
+
+    } /* namespace spa */
+} /* namespace lsp */
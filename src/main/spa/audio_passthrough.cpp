@@ -0,0 +1,519 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/audio_passthrough.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#if defined(__SSE2__) && defined(__GNUC__)
+    #include <emmintrin.h>
+    #define LSP_SPA_PASSTHROUGH_SSE2
+#endif /* __SSE2__ */
+
+namespace lsp
+{
+    namespace spa
+    {
+        namespace
+        {
+            typedef struct iec61937_codec_t
+            {
+                uint32_t        codec;
+                uint32_t        data_type;
+                uint32_t        period;
+                bool            length_bytes;
+            } iec61937_codec_t;
+
+            static const iec61937_codec_t iec61937_codecs[] =
+            {
+                { SPA_AUDIO_IEC958_CODEC_AC3,       1,  1536,   false   },
+                { SPA_AUDIO_IEC958_CODEC_MPEG,      5,  1152,   false   },  // MPEG-1 layer 2/3
+                { SPA_AUDIO_IEC958_CODEC_MPEG2_AAC, 7,  1024,   false   },
+                { SPA_AUDIO_IEC958_CODEC_DTS,       11, 512,    false   },  // DTS type I
+                { SPA_AUDIO_IEC958_CODEC_EAC3,      21, 6144,   true    },
+            };
+
+            // Data types with Pd containing length in bytes: DTS-HD, E-AC-3, TrueHD
+            inline bool iec61937_length_in_bytes(uint32_t data_type)
+            {
+                return (data_type == 17) || (data_type == 21) || (data_type == 22);
+            }
+
+            static const uint8_t bit_reverse[256] =
+            {
+                0x00, 0x80, 0x40, 0xc0, 0x20, 0xa0, 0x60, 0xe0, 0x10, 0x90, 0x50, 0xd0, 0x30, 0xb0, 0x70, 0xf0,
+                0x08, 0x88, 0x48, 0xc8, 0x28, 0xa8, 0x68, 0xe8, 0x18, 0x98, 0x58, 0xd8, 0x38, 0xb8, 0x78, 0xf8,
+                0x04, 0x84, 0x44, 0xc4, 0x24, 0xa4, 0x64, 0xe4, 0x14, 0x94, 0x54, 0xd4, 0x34, 0xb4, 0x74, 0xf4,
+                0x0c, 0x8c, 0x4c, 0xcc, 0x2c, 0xac, 0x6c, 0xec, 0x1c, 0x9c, 0x5c, 0xdc, 0x3c, 0xbc, 0x7c, 0xfc,
+                0x02, 0x82, 0x42, 0xc2, 0x22, 0xa2, 0x62, 0xe2, 0x12, 0x92, 0x52, 0xd2, 0x32, 0xb2, 0x72, 0xf2,
+                0x0a, 0x8a, 0x4a, 0xca, 0x2a, 0xaa, 0x6a, 0xea, 0x1a, 0x9a, 0x5a, 0xda, 0x3a, 0xba, 0x7a, 0xfa,
+                0x06, 0x86, 0x46, 0xc6, 0x26, 0xa6, 0x66, 0xe6, 0x16, 0x96, 0x56, 0xd6, 0x36, 0xb6, 0x76, 0xf6,
+                0x0e, 0x8e, 0x4e, 0xce, 0x2e, 0xae, 0x6e, 0xee, 0x1e, 0x9e, 0x5e, 0xde, 0x3e, 0xbe, 0x7e, 0xfe,
+                0x01, 0x81, 0x41, 0xc1, 0x21, 0xa1, 0x61, 0xe1, 0x11, 0x91, 0x51, 0xd1, 0x31, 0xb1, 0x71, 0xf1,
+                0x09, 0x89, 0x49, 0xc9, 0x29, 0xa9, 0x69, 0xe9, 0x19, 0x99, 0x59, 0xd9, 0x39, 0xb9, 0x79, 0xf9,
+                0x05, 0x85, 0x45, 0xc5, 0x25, 0xa5, 0x65, 0xe5, 0x15, 0x95, 0x55, 0xd5, 0x35, 0xb5, 0x75, 0xf5,
+                0x0d, 0x8d, 0x4d, 0xcd, 0x2d, 0xad, 0x6d, 0xed, 0x1d, 0x9d, 0x5d, 0xdd, 0x3d, 0xbd, 0x7d, 0xfd,
+                0x03, 0x83, 0x43, 0xc3, 0x23, 0xa3, 0x63, 0xe3, 0x13, 0x93, 0x53, 0xd3, 0x33, 0xb3, 0x73, 0xf3,
+                0x0b, 0x8b, 0x4b, 0xcb, 0x2b, 0xab, 0x6b, 0xeb, 0x1b, 0x9b, 0x5b, 0xdb, 0x3b, 0xbb, 0x7b, 0xfb,
+                0x07, 0x87, 0x47, 0xc7, 0x27, 0xa7, 0x67, 0xe7, 0x17, 0x97, 0x57, 0xd7, 0x37, 0xb7, 0x77, 0xf7,
+                0x0f, 0x8f, 0x4f, 0xcf, 0x2f, 0xaf, 0x6f, 0xef, 0x1f, 0x9f, 0x5f, 0xdf, 0x3f, 0xbf, 0x7f, 0xff,
+            };
+
+            /**
+             * Swap bytes in 16-bit words, the buffers may be the same
+             */
+            void swab16(uint8_t *dst, const uint8_t *src, size_t words)
+            {
+            #ifdef LSP_SPA_PASSTHROUGH_SSE2
+                for ( ; words >= 8; words -= 8, src += 16, dst += 16)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+                }
+            #endif /* LSP_SPA_PASSTHROUGH_SSE2 */
+                for ( ; words > 0; --words, src += 2, dst += 2)
+                {
+                    const uint8_t a = src[0];
+                    dst[0]      = src[1];
+                    dst[1]      = a;
+                }
+            }
+
+            /**
+             * Convert big-endian byte stream to native-endian 16-bit words and back
+             */
+            inline void stream_to_words(uint8_t *dst, const uint8_t *src, size_t words)
+            {
+            #if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                memmove(dst, src, words * 2);
+            #else
+                swab16(dst, src, words);
+            #endif /* __BYTE_ORDER__ */
+            }
+
+            inline void put_word(uint8_t *dst, uint16_t v)
+            {
+                memcpy(dst, &v, sizeof(v));
+            }
+
+            inline uint16_t get_word(const uint8_t *src)
+            {
+                uint16_t v;
+                memcpy(&v, src, sizeof(v));
+                return v;
+            }
+
+            template <size_t G> struct group_word {};
+            template <> struct group_word<1> { typedef uint8_t type_t; };
+            template <> struct group_word<2> { typedef uint16_t type_t; };
+            template <> struct group_word<4> { typedef uint32_t type_t; };
+            template <> struct group_word<8> { typedef uint64_t type_t; };
+
+            inline uint8_t  reverse_bytes(uint8_t v)    { return v; }
+            inline uint16_t reverse_bytes(uint16_t v)   { return __builtin_bswap16(v); }
+            inline uint32_t reverse_bytes(uint32_t v)   { return __builtin_bswap32(v); }
+            inline uint64_t reverse_bytes(uint64_t v)   { return __builtin_bswap64(v); }
+
+            /**
+             * Copy groups between interleaved and planar layouts
+             * @param G group size
+             * @param REV reverse bytes in the group
+             * @param UNPACK copy from interleaved to planar
+             */
+            template <size_t G, bool REV, bool UNPACK>
+            void copy_groups(uint8_t *il, uint8_t * const *pl, size_t channels, size_t groups)
+            {
+                typedef typename group_word<G>::type_t word_t;
+
+                for (size_t i=0; i<groups; ++i)
+                {
+                    const size_t off    = i * G;
+                    for (size_t j=0; j<channels; ++j, il += G)
+                    {
+                        uint8_t *p          = &pl[j][off];
+                        word_t v;
+                        memcpy(&v, (UNPACK) ? il : p, G);
+                        if (REV)
+                            v                   = reverse_bytes(v);
+                        memcpy((UNPACK) ? p : il, &v, G);
+                    }
+                }
+            }
+
+            void copy_groups_generic(uint8_t *il, uint8_t * const *pl, size_t channels, size_t groups, size_t g, bool rev, bool unpack)
+            {
+                for (size_t i=0; i<groups; ++i)
+                {
+                    const size_t off    = i * g;
+                    for (size_t j=0; j<channels; ++j, il += g)
+                    {
+                        uint8_t *p          = &pl[j][off];
+                        uint8_t *d          = (unpack) ? p : il;
+                        const uint8_t *s    = (unpack) ? il : p;
+                        if (rev)
+                        {
+                            for (size_t k=0; k<g; ++k)
+                                d[k]                = s[g - k - 1];
+                        }
+                        else
+                            memcpy(d, s, g);
+                    }
+                }
+            }
+
+            template <bool UNPACK>
+            void copy_interleaved(const dsd_layout_t *layout, uint8_t *il, uint8_t * const *pl, size_t groups)
+            {
+                const size_t channels   = layout->channels;
+                const bool rev          = layout->reverse_bytes;
+
+                switch (layout->group)
+                {
+                    case 1: copy_groups<1, false, UNPACK>(il, pl, channels, groups); break;
+                    case 2:
+                        if (rev)
+                            copy_groups<2, true, UNPACK>(il, pl, channels, groups);
+                        else
+                            copy_groups<2, false, UNPACK>(il, pl, channels, groups);
+                        break;
+                    case 4:
+                        if (rev)
+                            copy_groups<4, true, UNPACK>(il, pl, channels, groups);
+                        else
+                            copy_groups<4, false, UNPACK>(il, pl, channels, groups);
+                        break;
+                    case 8:
+                        if (rev)
+                            copy_groups<8, true, UNPACK>(il, pl, channels, groups);
+                        else
+                            copy_groups<8, false, UNPACK>(il, pl, channels, groups);
+                        break;
+                    default:
+                        copy_groups_generic(il, pl, channels, groups, layout->group, rev, UNPACK);
+                        break;
+                }
+            }
+
+        #ifdef LSP_SPA_PASSTHROUGH_SSE2
+            /**
+             * Encode 8 stereo DoP frames, the marker is the same each two frames
+             */
+            inline void dop_encode_stereo8(int32_t *dst, const uint8_t *l, const uint8_t *r, __m128i marker)
+            {
+                const __m128i zero  = _mm_setzero_si128();
+                __m128i vl          = _mm_loadu_si128(reinterpret_cast<const __m128i *>(l));
+                __m128i vr          = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r));
+                vl                  = _mm_or_si128(_mm_slli_epi16(vl, 8), _mm_srli_epi16(vl, 8));
+                vr                  = _mm_or_si128(_mm_slli_epi16(vr, 8), _mm_srli_epi16(vr, 8));
+
+                const __m128i l0    = _mm_slli_epi32(_mm_unpacklo_epi16(vl, zero), 8);
+                const __m128i l1    = _mm_slli_epi32(_mm_unpackhi_epi16(vl, zero), 8);
+                const __m128i r0    = _mm_slli_epi32(_mm_unpacklo_epi16(vr, zero), 8);
+                const __m128i r1    = _mm_slli_epi32(_mm_unpackhi_epi16(vr, zero), 8);
+
+                __m128i *d          = reinterpret_cast<__m128i *>(dst);
+                _mm_storeu_si128(&d[0], _mm_or_si128(_mm_unpacklo_epi32(l0, r0), marker));
+                _mm_storeu_si128(&d[1], _mm_or_si128(_mm_unpackhi_epi32(l0, r0), marker));
+                _mm_storeu_si128(&d[2], _mm_or_si128(_mm_unpacklo_epi32(l1, r1), marker));
+                _mm_storeu_si128(&d[3], _mm_or_si128(_mm_unpackhi_epi32(l1, r1), marker));
+            }
+        #endif /* LSP_SPA_PASSTHROUGH_SSE2 */
+
+            inline uint8_t dop_next_marker(uint8_t marker)
+            {
+                return (marker == DOP_MARKER_1) ? DOP_MARKER_2 : DOP_MARKER_1;
+            }
+        } /* namespace */
+
+        status_t dsd_layout_init(dsd_layout_t *layout, const struct spa_audio_info_dsd *info)
+        {
+            if ((layout == NULL) || (info == NULL))
+                return STATUS_BAD_ARGUMENTS;
+            if (info->channels <= 0)
+                return STATUS_BAD_FORMAT;
+
+            // The bit order is parsed from the format pod as a raw Id and may be out of the enum
+            // range, so it is read as integer to not load invalid enum value
+            static_assert(sizeof(info->bitorder) == sizeof(uint32_t), "Unexpected size of enum spa_param_bitorder");
+            uint32_t bitorder;
+            memcpy(&bitorder, &info->bitorder, sizeof(bitorder));
+
+            bool lsb_first;
+            switch (bitorder)
+            {
+                case SPA_PARAM_BITORDER_unknown:
+                case SPA_PARAM_BITORDER_msb:
+                    lsb_first           = false;
+                    break;
+                case SPA_PARAM_BITORDER_lsb:
+                    lsb_first           = true;
+                    break;
+                default:
+                    return STATUS_BAD_FORMAT;
+            }
+
+            layout->channels        = info->channels;
+            layout->group           = (info->interleave < 0) ? uint32_t(-int64_t(info->interleave)) : uint32_t(info->interleave);
+            layout->reverse_bytes   = (info->interleave < 0);
+            layout->lsb_first       = lsb_first;
+
+            return STATUS_OK;
+        }
+
+        void dsd_reverse_bits(uint8_t *dst, const uint8_t *src, size_t count)
+        {
+        #ifdef LSP_SPA_PASSTHROUGH_SSE2
+            const __m128i m1    = _mm_set1_epi8(0x55);
+            const __m128i m2    = _mm_set1_epi8(0x33);
+            const __m128i m4    = _mm_set1_epi8(0x0f);
+
+            // Shifts of 16-bit lanes are masked so that no bits cross the byte boundary
+            for ( ; count >= 16; count -= 16, src += 16, dst += 16)
+            {
+                __m128i v       = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+                v               = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(v, 1), m1), _mm_slli_epi16(_mm_and_si128(v, m1), 1));
+                v               = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(v, 2), m2), _mm_slli_epi16(_mm_and_si128(v, m2), 2));
+                v               = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(v, 4), m4), _mm_slli_epi16(_mm_and_si128(v, m4), 4));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), v);
+            }
+        #endif /* LSP_SPA_PASSTHROUGH_SSE2 */
+            for (size_t i=0; i<count; ++i)
+                dst[i]          = bit_reverse[src[i]];
+        }
+
+        size_t dsd_unpack(const dsd_layout_t *layout, uint8_t * const *dst, const void * const *src, size_t bytes)
+        {
+            const size_t channels   = layout->channels;
+
+            if (layout->group == 0)
+            {
+                for (size_t i=0; i<channels; ++i)
+                {
+                    const uint8_t *s    = static_cast<const uint8_t *>(src[i]);
+                    if (layout->lsb_first)
+                        dsd_reverse_bits(dst[i], s, bytes);
+                    else
+                        memcpy(dst[i], s, bytes);
+                }
+                return bytes;
+            }
+
+            const size_t groups     = bytes / layout->group;
+            bytes                   = groups * layout->group;
+            copy_interleaved<true>(layout, static_cast<uint8_t *>(const_cast<void *>(src[0])), dst, groups);
+            if (layout->lsb_first)
+            {
+                for (size_t i=0; i<channels; ++i)
+                    dsd_reverse_bits(dst[i], dst[i], bytes);
+            }
+
+            return bytes;
+        }
+
+        size_t dsd_pack(const dsd_layout_t *layout, void * const *dst, const uint8_t * const *src, size_t bytes)
+        {
+            const size_t channels   = layout->channels;
+
+            if (layout->group == 0)
+            {
+                for (size_t i=0; i<channels; ++i)
+                {
+                    uint8_t *d          = static_cast<uint8_t *>(dst[i]);
+                    if (layout->lsb_first)
+                        dsd_reverse_bits(d, src[i], bytes);
+                    else
+                        memcpy(d, src[i], bytes);
+                }
+                return bytes;
+            }
+
+            const size_t groups     = bytes / layout->group;
+            bytes                   = groups * layout->group;
+            uint8_t *d              = static_cast<uint8_t *>(dst[0]);
+            copy_interleaved<false>(layout, d, const_cast<uint8_t * const *>(src), groups);
+            if (layout->lsb_first)
+                dsd_reverse_bits(d, d, bytes * channels);
+
+            return bytes;
+        }
+
+        void dop_encode(dop_state_t *state, int32_t *dst, const uint8_t * const *src, size_t channels, size_t frames)
+        {
+            uint8_t marker      = (state->marker != 0) ? state->marker : DOP_MARKER_1;
+            size_t i            = 0;
+
+        #ifdef LSP_SPA_PASSTHROUGH_SSE2
+            if (channels == 2)
+            {
+                const uint32_t m1   = uint32_t(marker) << 24;
+                const uint32_t m2   = uint32_t(dop_next_marker(marker)) << 24;
+                const __m128i vm    = _mm_setr_epi32(int32_t(m1), int32_t(m1), int32_t(m2), int32_t(m2));
+                for ( ; i + 8 <= frames; i += 8, dst += 16)
+                    dop_encode_stereo8(dst, &src[0][i * 2], &src[1][i * 2], vm);
+            }
+        #endif /* LSP_SPA_PASSTHROUGH_SSE2 */
+
+            for ( ; i < frames; ++i)
+            {
+                const uint32_t m    = uint32_t(marker) << 24;
+                for (size_t j=0; j<channels; ++j)
+                {
+                    const uint8_t *s    = &src[j][i * 2];
+                    *(dst++)            = int32_t(m | (uint32_t(s[0]) << 16) | (uint32_t(s[1]) << 8));
+                }
+                marker              = dop_next_marker(marker);
+            }
+
+            state->marker       = marker;
+        }
+
+        size_t dop_decode(dop_state_t *state, uint8_t * const *dst, const int32_t *src, size_t channels, size_t frames)
+        {
+            uint8_t marker      = state->marker;
+
+            for (size_t i=0; i<frames; ++i, src += channels)
+            {
+                const uint8_t m     = uint8_t(uint32_t(src[0]) >> 24);
+                if (marker == 0)
+                {
+                    if ((m != DOP_MARKER_1) && (m != DOP_MARKER_2))
+                        return i;
+                    marker              = m;
+                }
+
+                for (size_t j=0; j<channels; ++j)
+                {
+                    const uint32_t v    = uint32_t(src[j]);
+                    if ((v >> 24) != marker)
+                    {
+                        state->marker       = 0;
+                        return i;
+                    }
+                    uint8_t *d          = &dst[j][i * 2];
+                    d[0]                = uint8_t(v >> 16);
+                    d[1]                = uint8_t(v >> 8);
+                }
+
+                marker              = dop_next_marker(marker);
+                state->marker       = marker;
+            }
+
+            return frames;
+        }
+
+        status_t iec61937_init(iec61937_t *enc, const struct spa_audio_info_iec958 *info)
+        {
+            if ((enc == NULL) || (info == NULL))
+                return STATUS_BAD_ARGUMENTS;
+
+            for (size_t i=0; i<sizeof(iec61937_codecs)/sizeof(iec61937_codecs[0]); ++i)
+            {
+                const iec61937_codec_t *c = &iec61937_codecs[i];
+                if (c->codec != uint32_t(info->codec))
+                    continue;
+
+                enc->codec          = c->codec;
+                enc->data_type      = c->data_type;
+                enc->period         = c->period;
+                enc->length_bytes   = c->length_bytes;
+                return STATUS_OK;
+            }
+
+            return STATUS_UNSUPPORTED_FORMAT;
+        }
+
+        status_t iec61937_pack(const iec61937_t *enc, void *dst, size_t dst_size, const void *payload, size_t size)
+        {
+            const size_t burst  = iec61937_burst_size(enc);
+            if (dst_size < burst)
+                return STATUS_OVERFLOW;
+            if (size > burst - IEC61937_HEADER_SIZE)
+                return STATUS_TOO_BIG;
+
+            const size_t length = (enc->length_bytes) ? size : size * 8;
+            if (length > 0xffff)
+                return STATUS_TOO_BIG;
+
+            uint8_t *d          = static_cast<uint8_t *>(dst);
+            const uint8_t *s    = static_cast<const uint8_t *>(payload);
+            put_word(&d[0], IEC61937_PA);
+            put_word(&d[2], IEC61937_PB);
+            put_word(&d[4], uint16_t(enc->data_type));
+            put_word(&d[6], uint16_t(length));
+            d                  += IEC61937_HEADER_SIZE;
+
+            const size_t words  = size >> 1;
+            stream_to_words(d, s, words);
+            d                  += words * 2;
+            if (size & 1)
+            {
+                put_word(d, uint16_t(s[size - 1]) << 8);
+                d                  += 2;
+            }
+
+            memset(d, 0, static_cast<uint8_t *>(dst) + burst - d);
+
+            return STATUS_OK;
+        }
+
+        status_t iec61937_unpack(iec61937_burst_t *burst, void *dst, size_t dst_size, const void *src, size_t size)
+        {
+            const uint8_t *s    = static_cast<const uint8_t *>(src);
+            const size_t words  = size >> 1;
+
+            for (size_t i=0; i + 1 < words; ++i)
+            {
+                if ((get_word(&s[i * 2]) != IEC61937_PA) || (get_word(&s[i * 2 + 2]) != IEC61937_PB))
+                    continue;
+
+                const size_t offset = i * 2;
+                if (offset + IEC61937_HEADER_SIZE > size)
+                    return STATUS_EOF;
+
+                const uint16_t pc   = get_word(&s[offset + 4]);
+                const uint16_t pd   = get_word(&s[offset + 6]);
+                const uint32_t type = pc & 0x7f;
+                const size_t length = (iec61937_length_in_bytes(type)) ? pd : (size_t(pd) + 7) >> 3;
+                const size_t end    = offset + IEC61937_HEADER_SIZE + ((length + 1) & ~size_t(1));
+                if (end > size)
+                    return STATUS_EOF;
+                if (length > dst_size)
+                    return STATUS_OVERFLOW;
+
+                uint8_t *d          = static_cast<uint8_t *>(dst);
+                const uint8_t *p    = &s[offset + IEC61937_HEADER_SIZE];
+                stream_to_words(d, p, length >> 1);
+                if (length & 1)
+                    d[length - 1]       = uint8_t(get_word(&p[length - 1]) >> 8);
+
+                burst->data_type    = type;
+                burst->pc           = pc;
+                burst->offset       = offset;
+                burst->length       = length;
+                burst->end          = end;
+
+                return STATUS_OK;
+            }
+
+            return STATUS_NOT_FOUND;
+        }
+
+    } /* namespace spa */
+} /* namespace lsp */
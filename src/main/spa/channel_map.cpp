@@ -0,0 +1,379 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/channel_map.h>
+
+#include <clap/ext/surround.h>
+
+namespace lsp
+{
+    namespace spa
+    {
+        namespace
+        {
+            static constexpr uint32_t AUX               = SPA_AUDIO_CHANNEL_START_Aux;
+            static constexpr uint32_t NONE              = SPA_AUDIO_CHANNEL_UNKNOWN;
+
+            static constexpr size_t VST3_SPEAKERS       = 64;
+            static constexpr size_t CLAP_SPEAKERS       = 20;
+            static constexpr size_t VST3_ACN_LOW        = 20;   // Bit of Steinberg::Vst::kSpeakerACN0
+            static constexpr size_t VST3_ACN_HIGH       = 38;   // Bit of Steinberg::Vst::kSpeakerACN4
+            static constexpr size_t VST3_ACN_COUNT      = 25;   // Number of ACN speakers in VST3
+            static constexpr size_t FUMA_CHANNELS       = 16;
+            static constexpr size_t ACN_CHANNELS        = 64;
+
+            typedef struct speaker_t
+            {
+                uint32_t        position;       // SPA position
+                int8_t          vst3;           // Bit of VST3 speaker
+                int8_t          clap;           // CLAP surround channel identifier
+            } speaker_t;
+
+            // Speakers indexed by SPA position
+            static constexpr speaker_t speakers[] =
+            {
+                { SPA_AUDIO_CHANNEL_UNKNOWN,    -1, -1 },
+                { SPA_AUDIO_CHANNEL_NA,         -1, -1 },
+                { SPA_AUDIO_CHANNEL_MONO,       19, -1 },
+                { SPA_AUDIO_CHANNEL_FL,          0,  0 },
+                { SPA_AUDIO_CHANNEL_FR,          1,  1 },
+                { SPA_AUDIO_CHANNEL_FC,          2,  2 },
+                { SPA_AUDIO_CHANNEL_LFE,         3,  3 },
+                { SPA_AUDIO_CHANNEL_SL,          9,  9 },
+                { SPA_AUDIO_CHANNEL_SR,         10, 10 },
+                { SPA_AUDIO_CHANNEL_FLC,         6,  6 },
+                { SPA_AUDIO_CHANNEL_FRC,         7,  7 },
+                { SPA_AUDIO_CHANNEL_RC,          8,  8 },
+                { SPA_AUDIO_CHANNEL_RL,          4,  4 },
+                { SPA_AUDIO_CHANNEL_RR,          5,  5 },
+                { SPA_AUDIO_CHANNEL_TC,         11, 11 },
+                { SPA_AUDIO_CHANNEL_TFL,        12, 12 },
+                { SPA_AUDIO_CHANNEL_TFC,        13, 13 },
+                { SPA_AUDIO_CHANNEL_TFR,        14, 14 },
+                { SPA_AUDIO_CHANNEL_TRL,        15, 15 },
+                { SPA_AUDIO_CHANNEL_TRC,        16, 16 },
+                { SPA_AUDIO_CHANNEL_TRR,        17, 17 },
+                { SPA_AUDIO_CHANNEL_RLC,        26, -1 },
+                { SPA_AUDIO_CHANNEL_RRC,        27, -1 },
+                { SPA_AUDIO_CHANNEL_FLW,        59, -1 },
+                { SPA_AUDIO_CHANNEL_FRW,        60, -1 },
+                { SPA_AUDIO_CHANNEL_LFE2,       18, -1 },
+                { SPA_AUDIO_CHANNEL_FLH,        -1, -1 },
+                { SPA_AUDIO_CHANNEL_FCH,        -1, -1 },
+                { SPA_AUDIO_CHANNEL_FRH,        -1, -1 },
+                { SPA_AUDIO_CHANNEL_TFLC,       -1, -1 },
+                { SPA_AUDIO_CHANNEL_TFRC,       -1, -1 },
+                { SPA_AUDIO_CHANNEL_TSL,        24, 18 },
+                { SPA_AUDIO_CHANNEL_TSR,        25, 19 },
+                { SPA_AUDIO_CHANNEL_LLFE,       -1, -1 },
+                { SPA_AUDIO_CHANNEL_RLFE,       -1, -1 },
+                { SPA_AUDIO_CHANNEL_BC,         29, -1 },
+                { SPA_AUDIO_CHANNEL_BLC,        28, -1 },
+                { SPA_AUDIO_CHANNEL_BRC,        30, -1 },
+            };
+
+            static constexpr size_t SPEAKERS    = sizeof(speakers) / sizeof(speaker_t);
+
+            // SPA positions indexed by bit of VST3 speaker
+            static constexpr uint32_t vst3_speakers[VST3_SPEAKERS] =
+            {
+                SPA_AUDIO_CHANNEL_FL,           // kSpeakerL
+                SPA_AUDIO_CHANNEL_FR,           // kSpeakerR
+                SPA_AUDIO_CHANNEL_FC,           // kSpeakerC
+                SPA_AUDIO_CHANNEL_LFE,          // kSpeakerLfe
+                SPA_AUDIO_CHANNEL_RL,           // kSpeakerLs
+                SPA_AUDIO_CHANNEL_RR,           // kSpeakerRs
+                SPA_AUDIO_CHANNEL_FLC,          // kSpeakerLc
+                SPA_AUDIO_CHANNEL_FRC,          // kSpeakerRc
+                SPA_AUDIO_CHANNEL_RC,           // kSpeakerCs
+                SPA_AUDIO_CHANNEL_SL,           // kSpeakerSl
+                SPA_AUDIO_CHANNEL_SR,           // kSpeakerSr
+                SPA_AUDIO_CHANNEL_TC,           // kSpeakerTc
+                SPA_AUDIO_CHANNEL_TFL,          // kSpeakerTfl
+                SPA_AUDIO_CHANNEL_TFC,          // kSpeakerTfc
+                SPA_AUDIO_CHANNEL_TFR,          // kSpeakerTfr
+                SPA_AUDIO_CHANNEL_TRL,          // kSpeakerTrl
+                SPA_AUDIO_CHANNEL_TRC,          // kSpeakerTrc
+                SPA_AUDIO_CHANNEL_TRR,          // kSpeakerTrr
+                SPA_AUDIO_CHANNEL_LFE2,         // kSpeakerLfe2
+                SPA_AUDIO_CHANNEL_MONO,         // kSpeakerM
+                AUX + 0,                        // kSpeakerACN0
+                AUX + 1,                        // kSpeakerACN1
+                AUX + 2,                        // kSpeakerACN2
+                AUX + 3,                        // kSpeakerACN3
+                SPA_AUDIO_CHANNEL_TSL,          // kSpeakerTsl
+                SPA_AUDIO_CHANNEL_TSR,          // kSpeakerTsr
+                SPA_AUDIO_CHANNEL_RLC,          // kSpeakerLcs
+                SPA_AUDIO_CHANNEL_RRC,          // kSpeakerRcs
+                SPA_AUDIO_CHANNEL_BLC,          // kSpeakerBfl
+                SPA_AUDIO_CHANNEL_BC,           // kSpeakerBfc
+                SPA_AUDIO_CHANNEL_BRC,          // kSpeakerBfr
+                NONE,                           // kSpeakerPl
+                NONE,                           // kSpeakerPr
+                NONE,                           // kSpeakerBsl
+                NONE,                           // kSpeakerBsr
+                NONE,                           // kSpeakerBrl
+                NONE,                           // kSpeakerBrc
+                NONE,                           // kSpeakerBrr
+                AUX + 4,  AUX + 5,  AUX + 6,  AUX + 7,      // kSpeakerACN4 - kSpeakerACN7
+                AUX + 8,  AUX + 9,  AUX + 10, AUX + 11,     // kSpeakerACN8 - kSpeakerACN11
+                AUX + 12, AUX + 13, AUX + 14, AUX + 15,     // kSpeakerACN12 - kSpeakerACN15
+                AUX + 16, AUX + 17, AUX + 18, AUX + 19,     // kSpeakerACN16 - kSpeakerACN19
+                AUX + 20, AUX + 21, AUX + 22, AUX + 23,     // kSpeakerACN20 - kSpeakerACN23
+                AUX + 24,                       // kSpeakerACN24
+                SPA_AUDIO_CHANNEL_FLW,          // kSpeakerLw
+                SPA_AUDIO_CHANNEL_FRW,          // kSpeakerRw
+                NONE,
+                NONE,
+                NONE,
+            };
+
+            // SPA positions indexed by CLAP surround channel identifier
+            static constexpr uint32_t clap_speakers[CLAP_SPEAKERS] =
+            {
+                SPA_AUDIO_CHANNEL_FL,           // CLAP_SURROUND_FL
+                SPA_AUDIO_CHANNEL_FR,           // CLAP_SURROUND_FR
+                SPA_AUDIO_CHANNEL_FC,           // CLAP_SURROUND_FC
+                SPA_AUDIO_CHANNEL_LFE,          // CLAP_SURROUND_LFE
+                SPA_AUDIO_CHANNEL_RL,           // CLAP_SURROUND_BL
+                SPA_AUDIO_CHANNEL_RR,           // CLAP_SURROUND_BR
+                SPA_AUDIO_CHANNEL_FLC,          // CLAP_SURROUND_FLC
+                SPA_AUDIO_CHANNEL_FRC,          // CLAP_SURROUND_FRC
+                SPA_AUDIO_CHANNEL_RC,           // CLAP_SURROUND_BC
+                SPA_AUDIO_CHANNEL_SL,           // CLAP_SURROUND_SL
+                SPA_AUDIO_CHANNEL_SR,           // CLAP_SURROUND_SR
+                SPA_AUDIO_CHANNEL_TC,           // CLAP_SURROUND_TC
+                SPA_AUDIO_CHANNEL_TFL,          // CLAP_SURROUND_TFL
+                SPA_AUDIO_CHANNEL_TFC,          // CLAP_SURROUND_TFC
+                SPA_AUDIO_CHANNEL_TFR,          // CLAP_SURROUND_TFR
+                SPA_AUDIO_CHANNEL_TRL,          // CLAP_SURROUND_TBL
+                SPA_AUDIO_CHANNEL_TRC,          // CLAP_SURROUND_TBC
+                SPA_AUDIO_CHANNEL_TRR,          // CLAP_SURROUND_TBR
+                SPA_AUDIO_CHANNEL_TSL,          // CLAP_SURROUND_TSL
+                SPA_AUDIO_CHANNEL_TSR,          // CLAP_SURROUND_TSR
+            };
+
+            // ACN index of FuMa channel: W X Y Z R S T U V K L M N O P Q
+            static constexpr uint8_t fuma_to_acn[FUMA_CHANNELS] =
+            {
+                0, 3, 1, 2, 6, 7, 5, 8, 4, 12, 13, 11, 14, 10, 15, 9
+            };
+
+            // Compile-time consistency checks of the tables
+            constexpr bool check_speakers(size_t i)
+            {
+                return (i >= SPEAKERS) ||
+                    ((speakers[i].position == i) && (check_speakers(i + 1)));
+            }
+
+            constexpr bool check_vst3_speaker(size_t bit)
+            {
+                return (vst3_speakers[bit] == NONE) ?
+                    true :
+                    (vst3_speakers[bit] >= AUX) ?
+                        ((bit >= VST3_ACN_LOW) && (bit < VST3_ACN_LOW + 4)) ||
+                        ((bit >= VST3_ACN_HIGH) && (bit < VST3_ACN_HIGH + VST3_ACN_COUNT - 4)) :
+                        size_t(speakers[vst3_speakers[bit]].vst3) == bit;
+            }
+
+            constexpr bool check_vst3_speakers(size_t bit)
+            {
+                return (bit >= VST3_SPEAKERS) ||
+                    ((check_vst3_speaker(bit)) && (check_vst3_speakers(bit + 1)));
+            }
+
+            constexpr bool check_clap_speakers(size_t id)
+            {
+                return (id >= CLAP_SPEAKERS) ||
+                    ((size_t(speakers[clap_speakers[id]].clap) == id) && (check_clap_speakers(id + 1)));
+            }
+
+            static_assert(check_speakers(0), "Speaker table is not indexed by SPA position");
+            static_assert(check_vst3_speakers(0), "VST3 speaker table does not match speaker table");
+            static_assert(check_clap_speakers(0), "CLAP speaker table does not match speaker table");
+            static_assert(SPEAKERS == SPA_AUDIO_CHANNEL_BRC + 1, "Speaker table does not cover all SPA positions");
+            static_assert(CLAP_SPEAKERS == CLAP_SURROUND_TSR + 1, "CLAP speaker table does not cover all channels");
+        } /* namespace */
+
+        uint32_t vst3_speaker_to_position(uint64_t speaker)
+        {
+            if ((speaker == 0) || (speaker & (speaker - 1)))
+                return SPA_AUDIO_CHANNEL_UNKNOWN;
+            return vst3_speakers[__builtin_ctzll(speaker)];
+        }
+
+        uint64_t position_to_vst3_speaker(uint32_t position)
+        {
+            if (position < SPEAKERS)
+            {
+                const int bit       = speakers[position].vst3;
+                return (bit >= 0) ? uint64_t(1) << bit : 0;
+            }
+            if ((position < AUX) || (position >= AUX + VST3_ACN_COUNT))
+                return 0;
+
+            const size_t acn    = position - AUX;
+            return (acn < 4) ?
+                uint64_t(1) << (VST3_ACN_LOW + acn) :
+                uint64_t(1) << (VST3_ACN_HIGH + acn - 4);
+        }
+
+        uint32_t clap_surround_to_position(uint32_t id)
+        {
+            return (id < CLAP_SPEAKERS) ? clap_speakers[id] : NONE;
+        }
+
+        int position_to_clap_surround(uint32_t position)
+        {
+            return (position < SPEAKERS) ? speakers[position].clap : -1;
+        }
+
+        status_t vst3_arrangement_to_positions(uint32_t *pos, size_t *count, size_t capacity, uint64_t arrangement)
+        {
+            status_t res        = STATUS_OK;
+            size_t n            = 0;
+
+            for (uint64_t rest = arrangement; rest != 0; rest &= rest - 1)
+            {
+                if (n >= capacity)
+                    return STATUS_OVERFLOW;
+
+                const uint32_t p    = vst3_speakers[__builtin_ctzll(rest)];
+                if (p == NONE)
+                    res                 = STATUS_NOT_FOUND;
+                pos[n++]            = p;
+            }
+
+            if (count != NULL)
+                *count              = n;
+
+            return res;
+        }
+
+        status_t positions_to_vst3_arrangement(uint64_t *arrangement, const uint32_t *pos, size_t count)
+        {
+            uint64_t result     = 0;
+            for (size_t i=0; i<count; ++i)
+            {
+                const uint64_t speaker  = position_to_vst3_speaker(pos[i]);
+                if (speaker == 0)
+                    return STATUS_NOT_FOUND;
+                if (result & speaker)
+                    return STATUS_BAD_FORMAT;
+                result             |= speaker;
+            }
+
+            *arrangement        = result;
+            return STATUS_OK;
+        }
+
+        status_t clap_surround_to_positions(uint32_t *pos, const uint8_t *map, size_t count)
+        {
+            status_t res        = STATUS_OK;
+            for (size_t i=0; i<count; ++i)
+            {
+                pos[i]              = clap_surround_to_position(map[i]);
+                if (pos[i] == NONE)
+                    res                 = STATUS_NOT_FOUND;
+            }
+
+            return res;
+        }
+
+        status_t positions_to_clap_surround(uint8_t *map, const uint32_t *pos, size_t count)
+        {
+            for (size_t i=0; i<count; ++i)
+            {
+                const int id        = position_to_clap_surround(pos[i]);
+                if (id < 0)
+                    return STATUS_NOT_FOUND;
+                map[i]              = uint8_t(id);
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t clap_ambisonic_to_positions(uint32_t *pos, const clap_ambisonic_config_t *config, size_t count)
+        {
+            // Number of channels should be (order + 1)^2
+            size_t order = 0;
+            while ((order + 1) * (order + 1) < count)
+                ++order;
+            if ((count == 0) || ((order + 1) * (order + 1) != count))
+                return STATUS_BAD_FORMAT;
+
+            switch (config->ordering)
+            {
+                case CLAP_AMBISONIC_ORDERING_FUMA:
+                    if (count > FUMA_CHANNELS)
+                        return STATUS_BAD_FORMAT;
+                    for (size_t i=0; i<count; ++i)
+                        pos[i]              = AUX + fuma_to_acn[i];
+                    break;
+
+                case CLAP_AMBISONIC_ORDERING_ACN:
+                    if (count > ACN_CHANNELS)
+                        return STATUS_BAD_FORMAT;
+                    for (size_t i=0; i<count; ++i)
+                        pos[i]              = AUX + i;
+                    break;
+
+                default:
+                    return STATUS_BAD_FORMAT;
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t channel_permutation(uint32_t *perm, const uint32_t *dst, size_t dst_count, const uint32_t *src, size_t src_count)
+        {
+            status_t res        = STATUS_OK;
+
+            for (size_t i=0; i<dst_count; ++i)
+            {
+                // Skip source channels matched by previous duplicates of the position
+                size_t skip         = 0;
+                for (size_t j=0; j<i; ++j)
+                    if (dst[j] == dst[i])
+                        ++skip;
+
+                perm[i]             = CHANNEL_MAP_NONE;
+                for (size_t j=0; j<src_count; ++j)
+                {
+                    if (src[j] != dst[i])
+                        continue;
+                    if (skip == 0)
+                    {
+                        perm[i]             = uint32_t(j);
+                        break;
+                    }
+                    --skip;
+                }
+
+                if (perm[i] == CHANNEL_MAP_NONE)
+                    res                 = STATUS_NOT_FOUND;
+            }
+
+            return res;
+        }
+
+    } /* namespace spa */
+} /* namespace lsp */
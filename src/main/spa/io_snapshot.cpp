@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/io_snapshot.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <sched.h>
+
+namespace lsp
+{
+    namespace spa
+    {
+        namespace
+        {
+            // Number of spins before yielding the CPU to the writer
+            static constexpr size_t SPINS_BEFORE_YIELD  = 4;
+
+            inline void backoff(size_t attempt)
+            {
+                if (attempt >= SPINS_BEFORE_YIELD)
+                    sched_yield();
+            }
+
+            /**
+             * Copy the memory region twice and check that the sequence counter
+             * has not been changed and both copies match
+             */
+            bool read_stable(void *dst, void *tmp, const void *src, size_t size, const struct spa_io_clock *clock)
+            {
+                const uint32_t s1   = atomic_load(&clock->target_seq);
+                if (s1 & 1)
+                    return false;
+
+                // The copies are plain memory reads, so only fences keep them between the loads of the counter
+                memcpy(dst, src, size);
+                __atomic_thread_fence(__ATOMIC_ACQUIRE);
+                memcpy(tmp, src, size);
+                __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+                const uint32_t s2   = atomic_load(&clock->target_seq);
+                return (s1 == s2) && (memcmp(dst, tmp, size) == 0);
+            }
+
+            void derive_clock(clock_snapshot_t *dst, const struct spa_io_clock *src)
+            {
+                dst->flags              = src->flags;
+                dst->id                 = src->id;
+                dst->cycle              = src->cycle;
+                dst->nsec               = src->nsec;
+                dst->next_nsec          = src->next_nsec;
+                dst->rate               = src->rate;
+                dst->position           = src->position;
+                dst->duration           = src->duration;
+                dst->delay              = src->delay;
+                dst->rate_diff          = src->rate_diff;
+                dst->target_rate        = src->target_rate;
+                dst->target_duration    = src->target_duration;
+                dst->xrun               = src->xrun;
+
+                const double rate_diff  = (src->rate_diff > 0.0) ? src->rate_diff : 1.0;
+                if ((src->rate.num > 0) && (src->rate.denom > 0))
+                {
+                    dst->sample_rate        = double(src->rate.denom) / double(src->rate.num);
+                    dst->actual_rate        = dst->sample_rate * rate_diff;
+                    dst->ns_per_sample      = 1e+9 / dst->actual_rate;
+                    dst->cycle_ns           = int64_t(src->duration * dst->ns_per_sample + 0.5);
+                }
+                else
+                {
+                    dst->sample_rate        = 0.0;
+                    dst->actual_rate        = 0.0;
+                    dst->ns_per_sample      = 0.0;
+                    dst->cycle_ns           = 0;
+                }
+            }
+
+            const struct spa_io_segment *active_segment(const struct spa_io_position *pos, size_t count, int64_t running)
+            {
+                const struct spa_io_segment *res = NULL;
+                for (size_t i=0; i<count; ++i)
+                {
+                    const struct spa_io_segment *s = &pos->segments[i];
+                    if (int64_t(s->start) > running)
+                        break;      // Segments are sorted by start time
+                    if ((s->duration > 0) &&
+                        (!(s->flags & SPA_IO_SEGMENT_FLAG_LOOPING)) &&
+                        (running >= int64_t(s->start + s->duration)))
+                        continue;
+                    res = s;
+                }
+                return res;
+            }
+
+            void derive_position(position_snapshot_t *dst, const struct spa_io_position *src, size_t count)
+            {
+                derive_clock(&dst->clock, &src->clock);
+                dst->offset             = src->offset;
+                dst->state              = src->state;
+                dst->running            = int64_t(src->clock.position) - src->offset;
+
+                dst->has_segment        = false;
+                dst->has_position       = false;
+                dst->has_bbt            = false;
+                dst->segment_flags      = 0;
+                dst->segment_rate       = 1.0;
+                dst->stream_position    = 0.0;
+                dst->signature_num      = 0.0f;
+                dst->signature_denom    = 0.0f;
+                dst->bpm                = 0.0;
+                dst->ticks_per_beat     = 0.0;
+                dst->beat               = 0.0;
+                dst->bar                = 0;
+                dst->bar_beat           = 0;
+                dst->tick               = 0.0;
+                dst->bar_start_tick     = 0.0;
+
+                const struct spa_io_segment *s = active_segment(src, count, dst->running);
+                if (s == NULL)
+                    return;
+
+                dst->has_segment        = true;
+                dst->segment_flags      = s->flags;
+                dst->segment_rate       = s->rate;
+
+                // Stream position, wrap around the loop
+                if (!(s->flags & SPA_IO_SEGMENT_FLAG_NO_POSITION))
+                {
+                    int64_t elapsed         = dst->running - int64_t(s->start);
+                    if ((s->flags & SPA_IO_SEGMENT_FLAG_LOOPING) && (s->duration > 0))
+                        elapsed                 = elapsed % int64_t(s->duration);
+                    dst->has_position       = true;
+                    dst->stream_position    = double(elapsed) * s->rate + double(s->position);
+                }
+
+                // Bar and beat information
+                const struct spa_io_segment_bar *b = &s->bar;
+                if ((!(b->flags & SPA_IO_SEGMENT_BAR_FLAG_VALID)) || (b->signature_num <= 0.0f))
+                    return;
+
+                // The beat is located at the offset in samples from the cycle start
+                double position             = b->beat;
+                if ((b->offset > 0) && (dst->clock.sample_rate > 0.0))
+                    position                   -= double(b->offset) * s->rate * b->bpm / (60.0 * dst->clock.sample_rate);
+
+                const double beats_per_bar  = b->signature_num;
+                const double bar            = floor(position / beats_per_bar);
+                const double bar_beats      = bar * beats_per_bar;
+                const double beat           = floor(position - bar_beats);
+
+                dst->has_bbt            = true;
+                dst->signature_num      = b->signature_num;
+                dst->signature_denom    = b->signature_denom;
+                dst->bpm                = b->bpm;
+                dst->ticks_per_beat     = b->ticks_per_beat;
+                dst->beat               = position;
+                dst->bar                = int64_t(bar) + 1;
+                dst->bar_beat           = int32_t(beat) + 1;
+                dst->tick               = (position - bar_beats - beat) * b->ticks_per_beat;
+                dst->bar_start_tick     = b->bar_start_tick;
+            }
+        } /* namespace */
+
+        void clock_write_begin(struct spa_io_clock *clock)
+        {
+            atomic_add(&clock->target_seq, uint32_t(1));
+            __atomic_thread_fence(__ATOMIC_RELEASE);
+        }
+
+        void clock_write_end(struct spa_io_clock *clock)
+        {
+            atomic_add(&clock->target_seq, uint32_t(1));
+        }
+
+        status_t read_clock(clock_snapshot_t *dst, const struct spa_io_clock *src, size_t retries)
+        {
+            if ((dst == NULL) || (src == NULL))
+                return STATUS_BAD_ARGUMENTS;
+
+            struct spa_io_clock c, tmp;
+            for (size_t i=0; i<retries; ++i)
+            {
+                if (read_stable(&c, &tmp, src, sizeof(c), src))
+                {
+                    derive_clock(dst, &c);
+                    return STATUS_OK;
+                }
+                backoff(i);
+            }
+
+            return STATUS_RETRY;
+        }
+
+        status_t read_position(position_snapshot_t *dst, const struct spa_io_position *src, size_t retries)
+        {
+            if ((dst == NULL) || (src == NULL))
+                return STATUS_BAD_ARGUMENTS;
+
+            struct spa_io_position p, tmp;
+            for (size_t i=0; i<retries; ++i)
+            {
+                // Copy only segments in use
+                const uint32_t count    = lsp_min(atomic_load(&src->n_segments), uint32_t(SPA_IO_POSITION_MAX_SEGMENTS));
+                const size_t size       = offsetof(struct spa_io_position, segments) + count * sizeof(struct spa_io_segment);
+
+                if ((read_stable(&p, &tmp, src, size, &src->clock)) && (p.n_segments == count))
+                {
+                    derive_position(dst, &p, count);
+                    return STATUS_OK;
+                }
+                backoff(i);
+            }
+
+            return STATUS_RETRY;
+        }
+
+        int64_t clock_sample_time(const clock_snapshot_t *clock, int64_t offset)
+        {
+            return int64_t(clock->nsec) + int64_t(llround(double(offset) * clock->ns_per_sample));
+        }
+
+    } /* namespace spa */
+} /* namespace lsp */
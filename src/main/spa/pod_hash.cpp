@@ -0,0 +1,504 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/pod_hash.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <pw-headers/spa/pod/iter.h>
+
+namespace lsp
+{
+    namespace spa
+    {
+        namespace
+        {
+            static constexpr uint64_t HASH_SEED         = 0x9e3779b97f4a7c15ULL;
+            static constexpr uint64_t HASH_SET_SEED     = 0xc2b2ae3d27d4eb4fULL;
+
+            /**
+             * Unified view on the plain value or the choice of values
+             */
+            typedef struct value_t
+            {
+                uint32_t            type;       // Type of value
+                uint32_t            size;       // Size of single value
+                uint32_t            choice;     // Choice type
+                uint32_t            count;      // Number of values
+                const uint8_t      *data;       // Pointer to the first value
+            } value_t;
+
+            inline uint64_t hash_mix(uint64_t h, uint64_t v)
+            {
+                v      *= 0x87c37b91114253d5ULL;
+                v       = (v << 31) | (v >> 33);
+                v      *= 0x4cf5ad432745937fULL;
+                h      ^= v;
+                h       = (h << 27) | (h >> 37);
+                return h * 5 + 0x52dce729;
+            }
+
+            inline uint64_t hash_final(uint64_t h)
+            {
+                h      ^= h >> 33;
+                h      *= 0xff51afd7ed558ccdULL;
+                h      ^= h >> 33;
+                h      *= 0xc4ceb9fe1a85ec53ULL;
+                h      ^= h >> 33;
+                return h;
+            }
+
+            uint64_t hash_bytes(uint64_t h, const void *data, size_t size)
+            {
+                const uint8_t *ptr  = static_cast<const uint8_t *>(data);
+                uint64_t v;
+
+                for (size_t i=size >> 3; i > 0; --i, ptr += sizeof(uint64_t))
+                {
+                    memcpy(&v, ptr, sizeof(uint64_t));
+                    h       = hash_mix(h, v);
+                }
+
+                size_t tail     = size & 0x7;
+                if (tail > 0)
+                {
+                    v       = 0;
+                    memcpy(&v, ptr, tail);
+                    h       = hash_mix(h, v);
+                }
+
+                return hash_mix(h, size);
+            }
+
+            inline uint32_t canonical_float(const void *ptr)
+            {
+                float v;
+                uint32_t res;
+                memcpy(&v, ptr, sizeof(v));
+                if (v != v)
+                    return 0x7fc00000;
+                if (v == 0.0f)
+                    return 0;
+                memcpy(&res, &v, sizeof(res));
+                return res;
+            }
+
+            inline uint64_t canonical_double(const void *ptr)
+            {
+                double v;
+                uint64_t res;
+                memcpy(&v, ptr, sizeof(v));
+                if (v != v)
+                    return 0x7ff8000000000000ULL;
+                if (v == 0.0)
+                    return 0;
+                memcpy(&res, &v, sizeof(res));
+                return res;
+            }
+
+            inline uint64_t canonical_rectangle(const void *ptr)
+            {
+                struct spa_rectangle r;
+                memcpy(&r, ptr, sizeof(r));
+                // spa_pod_compare() compares area and width, so height does not matter for zero width
+                return (r.width > 0) ? (uint64_t(r.width) << 32) | r.height : 0;
+            }
+
+            inline uint64_t canonical_fraction(const void *ptr)
+            {
+                struct spa_fraction f;
+                memcpy(&f, ptr, sizeof(f));
+
+                if (f.denom == 0)
+                    return (f.num != 0) ? uint64_t(1) << 32 : 0;
+                if (f.num == 0)
+                    return 1;
+
+                uint32_t a = f.num, b = f.denom;
+                while (b != 0)
+                {
+                    const uint32_t t = a % b;
+                    a   = b;
+                    b   = t;
+                }
+
+                return (uint64_t(f.num / a) << 32) | (f.denom / a);
+            }
+
+            uint64_t hash_value(uint64_t h, uint32_t type, const void *data, uint32_t size)
+            {
+                switch (type)
+                {
+                    case SPA_TYPE_None:
+                        return h;
+                    case SPA_TYPE_Bool:
+                        return hash_mix(h, *static_cast<const int32_t *>(data) != 0);
+                    case SPA_TYPE_Id:
+                    case SPA_TYPE_Int:
+                        return hash_mix(h, *static_cast<const uint32_t *>(data));
+                    case SPA_TYPE_Long:
+                        return hash_mix(h, *static_cast<const uint64_t *>(data));
+                    case SPA_TYPE_Float:
+                        return hash_mix(h, canonical_float(data));
+                    case SPA_TYPE_Double:
+                        return hash_mix(h, canonical_double(data));
+                    case SPA_TYPE_String:
+                        return hash_bytes(h, data, strnlen(static_cast<const char *>(data), size));
+                    case SPA_TYPE_Rectangle:
+                        return hash_mix(h, canonical_rectangle(data));
+                    case SPA_TYPE_Fraction:
+                        return hash_mix(h, canonical_fraction(data));
+                    default:
+                        break;
+                }
+
+                return hash_bytes(h, data, size);
+            }
+
+            bool value_equals(uint32_t type, const void *a, const void *b, uint32_t size)
+            {
+                switch (type)
+                {
+                    case SPA_TYPE_None:
+                        return true;
+                    case SPA_TYPE_Bool:
+                        return (*static_cast<const int32_t *>(a) != 0) == (*static_cast<const int32_t *>(b) != 0);
+                    case SPA_TYPE_Id:
+                    case SPA_TYPE_Int:
+                        return *static_cast<const uint32_t *>(a) == *static_cast<const uint32_t *>(b);
+                    case SPA_TYPE_Long:
+                        return *static_cast<const uint64_t *>(a) == *static_cast<const uint64_t *>(b);
+                    case SPA_TYPE_Float:
+                        return canonical_float(a) == canonical_float(b);
+                    case SPA_TYPE_Double:
+                        return canonical_double(a) == canonical_double(b);
+                    case SPA_TYPE_String:
+                        return strncmp(static_cast<const char *>(a), static_cast<const char *>(b), size) == 0;
+                    case SPA_TYPE_Rectangle:
+                        return canonical_rectangle(a) == canonical_rectangle(b);
+                    case SPA_TYPE_Fraction:
+                        return canonical_fraction(a) == canonical_fraction(b);
+                    default:
+                        break;
+                }
+
+                return memcmp(a, b, size) == 0;
+            }
+
+            /**
+             * Get the value view of the POD
+             * @param v value view to fill
+             * @param pod POD value
+             * @return false if POD is not a valid leaf value or choice and should be processed as raw data
+             */
+            bool get_value(value_t *v, const struct spa_pod *pod)
+            {
+                const struct spa_pod *child = spa_pod_get_values(pod, &v->count, &v->choice);
+
+                v->type     = child->type;
+                v->size     = child->size;
+                v->data     = static_cast<const uint8_t *>(SPA_POD_BODY_CONST(child));
+
+                if ((v->count == 0) || (v->size < spa_pod_type_size(v->type)))
+                    return false;
+
+                switch (v->type)
+                {
+                    case SPA_TYPE_Choice:
+                    case SPA_TYPE_Struct:
+                    case SPA_TYPE_Object:
+                        return false;
+                    default:
+                        break;
+                }
+
+                return true;
+            }
+
+            inline const uint8_t *value_at(const value_t *v, uint32_t index)
+            {
+                return &v->data[size_t(index) * v->size];
+            }
+
+            inline bool is_set_choice(uint32_t choice)
+            {
+                return (choice == SPA_CHOICE_Enum) || (choice == SPA_CHOICE_Flags);
+            }
+
+            bool contains_value(const value_t *v, uint32_t first, uint32_t last, const uint8_t *value)
+            {
+                for (uint32_t i=first; i<last; ++i)
+                    if (value_equals(v->type, value_at(v, i), value, v->size))
+                        return true;
+                return false;
+            }
+
+            uint64_t hash_choice(const value_t *v)
+            {
+                uint64_t h  = hash_mix(HASH_SEED, v->type);
+                h           = hash_mix(h, v->size);
+
+                // Single-value choice of 'None' type is the same to the plain value
+                if ((v->choice != SPA_CHOICE_None) || (v->count != 1))
+                {
+                    h           = hash_mix(h, SPA_TYPE_Choice);
+                    h           = hash_mix(h, (uint64_t(v->choice) << 32) | v->count);
+                }
+                h           = hash_value(h, v->type, v->data, v->size);
+                if (v->count <= 1)
+                    return h;
+
+                if (is_set_choice(v->choice))
+                {
+                    // Alternatives form a set: the order and duplicates do not matter
+                    uint64_t sum = 0;
+                    for (uint32_t i=1; i<v->count; ++i)
+                    {
+                        const uint8_t *value = value_at(v, i);
+                        if (!contains_value(v, 1, i, value))
+                            sum    += hash_final(hash_value(HASH_SET_SEED, v->type, value, v->size));
+                    }
+                    return hash_mix(h, sum);
+                }
+
+                for (uint32_t i=1; i<v->count; ++i)
+                    h           = hash_value(h, v->type, value_at(v, i), v->size);
+
+                return h;
+            }
+
+            bool choice_equals(const value_t *a, const value_t *b)
+            {
+                if ((a->type != b->type) ||
+                    (a->size != b->size) ||
+                    (a->choice != b->choice) ||
+                    (a->count != b->count))
+                    return false;
+
+                if (!value_equals(a->type, a->data, b->data, a->size))
+                    return false;
+
+                if (is_set_choice(a->choice))
+                {
+                    for (uint32_t i=1; i<a->count; ++i)
+                        if (!contains_value(b, 1, b->count, value_at(a, i)))
+                            return false;
+                    for (uint32_t i=1; i<b->count; ++i)
+                        if (!contains_value(a, 1, a->count, value_at(b, i)))
+                            return false;
+                    return true;
+                }
+
+                for (uint32_t i=1; i<a->count; ++i)
+                    if (!value_equals(a->type, value_at(a, i), value_at(b, i), a->size))
+                        return false;
+
+                return true;
+            }
+
+            /**
+             * Find first property with specified key
+             * @param obj object
+             * @param key property key
+             * @param until the property to stop search at, NULL if the whole object should be searched
+             * @return pointer to the property or NULL if not found
+             */
+            const struct spa_pod_prop *find_prop(const struct spa_pod_object *obj, uint32_t key, const struct spa_pod_prop *until)
+            {
+                const struct spa_pod_prop *p;
+                SPA_POD_OBJECT_FOREACH(obj, p)
+                {
+                    if (p == until)
+                        break;
+                    if (p->key == key)
+                        return p;
+                }
+                return NULL;
+            }
+
+            uint64_t hash_pod(const struct spa_pod *pod);
+
+            uint64_t hash_struct(const struct spa_pod *pod)
+            {
+                uint64_t h          = hash_mix(HASH_SEED, SPA_TYPE_Struct);
+                uint32_t count      = 0;
+                const struct spa_pod *p;
+
+                SPA_POD_STRUCT_FOREACH(pod, p)
+                {
+                    h                   = hash_mix(h, hash_pod(p));
+                    ++count;
+                }
+
+                return hash_mix(h, count);
+            }
+
+            uint64_t hash_object(const struct spa_pod_object *obj)
+            {
+                uint64_t h          = hash_mix(HASH_SEED, SPA_TYPE_Object);
+                h                   = hash_mix(h, (uint64_t(obj->body.type) << 32) | obj->body.id);
+
+                // Properties form a set: the order does not matter, only first property matches the key
+                uint64_t sum        = 0;
+                uint32_t count      = 0;
+                const struct spa_pod_prop *p;
+
+                SPA_POD_OBJECT_FOREACH(obj, p)
+                {
+                    if (find_prop(obj, p->key, p) != NULL)
+                        continue;
+
+                    uint64_t ph         = hash_mix(HASH_SET_SEED, (uint64_t(p->key) << 32) | p->flags);
+                    sum                += hash_final(hash_mix(ph, hash_pod(&p->value)));
+                    ++count;
+                }
+
+                h                   = hash_mix(h, sum);
+                return hash_mix(h, count);
+            }
+
+            uint64_t hash_pod(const struct spa_pod *pod)
+            {
+                value_t v;
+
+                switch (pod->type)
+                {
+                    case SPA_TYPE_Struct:
+                        return hash_struct(pod);
+                    case SPA_TYPE_Object:
+                        if (pod->size >= sizeof(struct spa_pod_object_body))
+                            return hash_object(reinterpret_cast<const struct spa_pod_object *>(pod));
+                        break;
+                    default:
+                        if (get_value(&v, pod))
+                            return hash_choice(&v);
+                        break;
+                }
+
+                return hash_bytes(hash_mix(HASH_SEED, pod->type), pod, SPA_POD_SIZE(pod));
+            }
+
+            bool raw_equals(const struct spa_pod *a, const struct spa_pod *b)
+            {
+                return (a->size == b->size) &&
+                    (memcmp(a, b, SPA_POD_SIZE(a)) == 0);
+            }
+
+            bool equals(const struct spa_pod *a, const struct spa_pod *b);
+
+            bool struct_equals(const struct spa_pod *a, const struct spa_pod *b)
+            {
+                const struct spa_pod *pa  = SPA_POD_STRUCT_BODY_CONST(a);
+                const struct spa_pod *pb  = SPA_POD_STRUCT_BODY_CONST(b);
+
+                while (true)
+                {
+                    const bool ia       = spa_pod_is_inside(SPA_POD_BODY_CONST(a), SPA_POD_BODY_SIZE(a), pa);
+                    const bool ib       = spa_pod_is_inside(SPA_POD_BODY_CONST(b), SPA_POD_BODY_SIZE(b), pb);
+                    if ((!ia) || (!ib))
+                        return ia == ib;
+                    if (!equals(pa, pb))
+                        return false;
+
+                    pa  = static_cast<const struct spa_pod *>(spa_pod_next(pa));
+                    pb  = static_cast<const struct spa_pod *>(spa_pod_next(pb));
+                }
+            }
+
+            bool object_equals(const struct spa_pod_object *a, const struct spa_pod_object *b)
+            {
+                if ((a->body.type != b->body.type) || (a->body.id != b->body.id))
+                    return false;
+
+                const struct spa_pod_prop *pa, *pb;
+                uint32_t count_a = 0, count_b = 0;
+
+                SPA_POD_OBJECT_FOREACH(a, pa)
+                {
+                    if (find_prop(a, pa->key, pa) != NULL)
+                        continue;
+                    if ((pb = find_prop(b, pa->key, NULL)) == NULL)
+                        return false;
+                    if ((pa->flags != pb->flags) || (!equals(&pa->value, &pb->value)))
+                        return false;
+                    ++count_a;
+                }
+
+                SPA_POD_OBJECT_FOREACH(b, pb)
+                {
+                    if (find_prop(b, pb->key, pb) == NULL)
+                        ++count_b;
+                }
+
+                return count_a == count_b;
+            }
+
+            bool equals(const struct spa_pod *a, const struct spa_pod *b)
+            {
+                if (a == b)
+                    return true;
+
+                value_t va, vb;
+                const bool ca   = (a->type == SPA_TYPE_Choice);
+                const bool cb   = (b->type == SPA_TYPE_Choice);
+
+                if ((a->type != b->type) && (!ca) && (!cb))
+                    return false;
+
+                switch (a->type)
+                {
+                    case SPA_TYPE_Struct:
+                        return (b->type == SPA_TYPE_Struct) && (struct_equals(a, b));
+                    case SPA_TYPE_Object:
+                        if (b->type != SPA_TYPE_Object)
+                            return false;
+                        if ((a->size >= sizeof(struct spa_pod_object_body)) &&
+                            (b->size >= sizeof(struct spa_pod_object_body)))
+                            return object_equals(
+                                reinterpret_cast<const struct spa_pod_object *>(a),
+                                reinterpret_cast<const struct spa_pod_object *>(b));
+                        return raw_equals(a, b);
+                    default:
+                        break;
+                }
+
+                const bool wa   = get_value(&va, a);
+                const bool wb   = get_value(&vb, b);
+                if (wa && wb)
+                    return choice_equals(&va, &vb);
+
+                return (!wa) && (!wb) && (a->type == b->type) && (raw_equals(a, b));
+            }
+        } /* namespace */
+
+        uint64_t pod_hash(const struct spa_pod *pod)
+        {
+            return (pod != NULL) ? hash_final(hash_pod(pod)) : 0;
+        }
+
+        bool pod_equals(const struct spa_pod *a, const struct spa_pod *b)
+        {
+            if ((a == NULL) || (b == NULL))
+                return a == b;
+            return equals(a, b);
+        }
+
+    } /* namespace spa */
+} /* namespace lsp */
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/BlockDispatcher.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define BUF_SIZE            4096
+#define NUM_CHANNELS        4
+
+namespace
+{
+    // Plugin mixing several channels with per-channel gain
+    class Mixer
+    {
+        public:
+            float      *vIn[NUM_CHANNELS];
+            float      *vOut;
+            float       vGain[NUM_CHANNELS];
+
+        public:
+            template <uint32_t N>
+            void process(uint32_t offset, uint32_t samples)
+            {
+                const uint32_t count    = (N > 0) ? N : samples;
+                float * __restrict dst  = &vOut[offset];
+
+                for (uint32_t i=0; i<count; ++i)
+                    dst[i]      = vIn[0][offset + i] * vGain[0];
+                for (size_t j=1; j<NUM_CHANNELS; ++j)
+                {
+                    const float * __restrict src = &vIn[j][offset];
+                    const float g   = vGain[j];
+                    for (uint32_t i=0; i<count; ++i)
+                        dst[i]     += src[i] * g;
+                }
+            }
+    };
+} /* namespace */
+
+PTEST_BEGIN("3rdparty.lv2", block_size, 5, 1000)
+
+    void call(Mixer *m, uint32_t length)
+    {
+        char label[0x40];
+        lsp::lv2::BlockDispatcher<Mixer> generic, fixed;
+
+        if (fixed.select(length) != length)
+            PTEST_FAIL();
+
+        snprintf(label, sizeof(label), "generic x%d", int(length));
+        PTEST_LOOP(label,
+            for (uint32_t off=0; off<BUF_SIZE; off += length)
+                generic.run(m, length);
+        );
+
+        snprintf(label, sizeof(label), "fixed x%d", int(length));
+        PTEST_LOOP(label,
+            for (uint32_t off=0; off<BUF_SIZE; off += length)
+                fixed.run(m, length);
+        );
+
+        PTEST_SEPARATOR;
+    }
+
+    PTEST_MAIN
+    {
+        Mixer m;
+        float *buf = static_cast<float *>(malloc((NUM_CHANNELS + 1) * BUF_SIZE * sizeof(float)));
+        if (buf == NULL)
+            PTEST_FAIL();
+
+        for (size_t i=0; i<(NUM_CHANNELS + 1) * BUF_SIZE; ++i)
+            buf[i]      = float(rand()) / RAND_MAX;
+        for (size_t j=0; j<NUM_CHANNELS; ++j)
+        {
+            m.vIn[j]        = &buf[j * BUF_SIZE];
+            m.vGain[j]      = 1.0f / (j + 1);
+        }
+        m.vOut          = &buf[NUM_CHANNELS * BUF_SIZE];
+
+        call(&m, 32);
+        call(&m, 64);
+        call(&m, 128);
+        call(&m, 256);
+
+        free(buf);
+    }
+
+PTEST_END
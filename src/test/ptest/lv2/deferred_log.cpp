@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/DeferredLog.h>
+#include <lsp-plug.in/3rdparty/lv2/UridMap.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#include <lv2/log/log.h>
+
+#define BURST_SIZE          32
+
+namespace
+{
+    typedef struct sink_t
+    {
+        size_t          messages;
+        size_t          bytes;
+    } sink_t;
+
+    // Writer which only accounts the messages, the cost of actual output is out of scope
+    static void sink_writer(void *arg, LV2_URID type, const char *message)
+    {
+        sink_t *sink    = static_cast<sink_t *>(arg);
+        ++sink->messages;
+        sink->bytes    += strlen(message);
+    }
+
+    // Typical message of the plugin: formatted and written on the calling thread
+    static void direct_burst(sink_t *sink, LV2_URID type, const char *name, size_t frame)
+    {
+        char buf[lsp::lv2::DeferredLog::MAX_MESSAGE];
+        for (size_t i=0; i<BURST_SIZE; ++i)
+        {
+            snprintf(buf, sizeof(buf), "%s: buffer underrun at frame %lld, load %5.1f%%\n",
+                name, (long long)(frame + i), 42.25);
+            sink_writer(sink, type, buf);
+        }
+    }
+
+    // The same message captured by the deferred log
+    static void deferred_burst(lsp::lv2::DeferredLog *log, LV2_URID type, const char *name, size_t frame)
+    {
+        for (size_t i=0; i<BURST_SIZE; ++i)
+            log->printf(type, "%s: buffer underrun at frame %lld, load %5.1f%%\n",
+                name, (long long)(frame + i), 42.25);
+    }
+
+    class Drainer: public lsp::ipc::Thread
+    {
+        private:
+            lsp::lv2::DeferredLog  *pLog;
+            uint32_t                nExit;
+
+        public:
+            explicit Drainer(lsp::lv2::DeferredLog *log)
+            {
+                pLog        = log;
+                nExit       = 0;
+            }
+
+            void stop()
+            {
+                lsp::atomic_store(&nExit, uint32_t(1));
+            }
+
+            virtual lsp::status_t run() override
+            {
+                while (lsp::atomic_load(&nExit) == 0)
+                {
+                    if (pLog->drain() == 0)
+                        lsp::ipc::Thread::yield();
+                }
+                pLog->drain();
+                return lsp::STATUS_OK;
+            }
+    };
+} /* namespace */
+
+PTEST_BEGIN("3rdparty.lv2", deferred_log, 5, 1000)
+
+    PTEST_MAIN
+    {
+        lsp::lv2::UridMap map;
+        if (map.init() != lsp::STATUS_OK)
+            PTEST_FAIL();
+
+        const LV2_URID type = map.map_feature()->map(map.map_feature()->handle, LV2_LOG__Error);
+        const char *name    = "lsp-plugins";
+        size_t frame        = 0;
+
+        sink_t sink;
+        sink.messages       = 0;
+        sink.bytes          = 0;
+
+        lsp::lv2::DeferredLog log;
+        if (log.init(map.map_feature(), 2, 0x40000) != lsp::STATUS_OK)
+            PTEST_FAIL();
+        log.set_writer(sink_writer, &sink);
+
+        // Cost of logging on the calling thread
+        PTEST_LOOP("formatted in place",
+            direct_burst(&sink, type, name, frame);
+            frame += BURST_SIZE;
+        );
+
+        // Capture and format on the same thread
+        PTEST_LOOP("captured and drained",
+            deferred_burst(&log, type, name, frame);
+            log.drain();
+            frame += BURST_SIZE;
+        );
+
+        // Capture with formatting on the background thread
+        Drainer drainer(&log);
+        if (drainer.start() != lsp::STATUS_OK)
+            PTEST_FAIL();
+
+        PTEST_LOOP("captured",
+            deferred_burst(&log, type, name, frame);
+            frame += BURST_SIZE;
+        );
+
+        drainer.stop();
+        drainer.join();
+        log.release_thread();
+
+        printf("Deferred messages written: %d, dropped: %d\n", int(log.written()), int(log.dropped()));
+        PTEST_SEPARATOR;
+
+        log.destroy();
+    }
+
+PTEST_END
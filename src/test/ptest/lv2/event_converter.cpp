@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/EventConverter.h>
+#include <lsp-plug.in/3rdparty/lv2/UridMap.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#include <lv2/atom/util.h>
+#include <lv2/event/event-helpers.h>
+#include <lv2/midi/midi.h>
+
+#define BUF_CAPACITY        0x40000
+#define BLOCK_SIZE          1024
+
+LV2_DISABLE_DEPRECATION_WARNINGS
+
+namespace
+{
+    static uint32_t uri_to_id(LV2_URI_Map_Callback_Data data, const char *map, const char *uri)
+    {
+        return static_cast<lsp::lv2::UridMap *>(data)->map(uri);
+    }
+
+    // Typical host code: write events one by one with the event iterator
+    static void naive_to_events(LV2_Event_Buffer *dst, const LV2_Atom_Sequence *src, LV2_URID midi_urid, uint16_t midi_type)
+    {
+        LV2_Event_Iterator it;
+        lv2_event_buffer_reset(dst, LV2_EVENT_AUDIO_STAMP, dst->data);
+        lv2_event_begin(&it, dst);
+
+        LV2_ATOM_SEQUENCE_FOREACH(src, ev)
+        {
+            if (ev->body.type != midi_urid)
+                continue;
+            if (!lv2_event_write(&it, uint32_t(ev->time.frames), 0, midi_type, uint16_t(ev->body.size),
+                static_cast<const uint8_t *>(LV2_ATOM_BODY_CONST(&ev->body))))
+                break;
+        }
+    }
+
+    static void naive_to_sequence(LV2_Atom_Sequence *dst, LV2_Event_Buffer *src, LV2_URID midi_urid, uint16_t midi_type)
+    {
+        dst->atom.size      = sizeof(LV2_Atom_Sequence_Body);
+        dst->body.unit      = 0;
+        dst->body.pad       = 0;
+
+        uint64_t buf[0x20];
+        LV2_Atom_Event *ae  = reinterpret_cast<LV2_Atom_Event *>(buf);
+
+        LV2_Event_Iterator it;
+        for (lv2_event_begin(&it, src); lv2_event_is_valid(&it); lv2_event_increment(&it))
+        {
+            uint8_t *data = NULL;
+            const LV2_Event *e  = lv2_event_get(&it, &data);
+            if ((e->type != midi_type) || (e->size > sizeof(buf) - sizeof(LV2_Atom_Event)))
+                continue;
+
+            ae->time.frames     = e->frames;
+            ae->body.type       = midi_urid;
+            ae->body.size       = e->size;
+            memcpy(&ae[1], data, e->size);
+            if (!lv2_atom_sequence_append_event(dst, BUF_CAPACITY, ae))
+                break;
+        }
+    }
+} /* namespace */
+
+PTEST_BEGIN("3rdparty.lv2", event_converter, 5, 100)
+
+    void call(lsp::lv2::EventConverter *conv, size_t events, LV2_URID midi_urid, LV2_Atom_Sequence *seq, LV2_Atom_Sequence *out, LV2_Event_Buffer *evbuf)
+    {
+        char label[0x40];
+        const uint16_t midi_type = uint16_t(midi_urid);
+
+        // MIDI-dense sequence
+        seq->atom.size      = sizeof(LV2_Atom_Sequence_Body);
+        seq->body.unit      = 0;
+        seq->body.pad       = 0;
+        for (size_t i=0; i<events; ++i)
+        {
+            struct
+            {
+                LV2_Atom_Event  ev;
+                uint8_t         msg[3];
+            } me;
+            me.ev.time.frames   = (i * BLOCK_SIZE) / events;
+            me.ev.body.type     = midi_urid;
+            me.ev.body.size     = 3;
+            me.msg[0]           = (i & 1) ? 0x80 : 0x90;
+            me.msg[1]           = uint8_t(i & 0x7f);
+            me.msg[2]           = 0x40;
+            lv2_atom_sequence_append_event(seq, BUF_CAPACITY, &me.ev);
+        }
+
+        snprintf(label, sizeof(label), "lv2_event_write x%d", int(events));
+        PTEST_LOOP(label,
+            naive_to_events(evbuf, seq, midi_urid, midi_type);
+        );
+
+        snprintf(label, sizeof(label), "to_events x%d", int(events));
+        PTEST_LOOP(label,
+            conv->to_events(evbuf, seq);
+        );
+
+        snprintf(label, sizeof(label), "lv2_atom_sequence_append_event x%d", int(events));
+        PTEST_LOOP(label,
+            naive_to_sequence(out, evbuf, midi_urid, midi_type);
+        );
+
+        snprintf(label, sizeof(label), "to_sequence x%d", int(events));
+        PTEST_LOOP(label,
+            conv->to_sequence(out, BUF_CAPACITY, evbuf, 0);
+        );
+
+        PTEST_SEPARATOR;
+    }
+
+    PTEST_MAIN
+    {
+        lsp::lv2::UridMap map;
+        if (map.init() != lsp::STATUS_OK)
+            PTEST_FAIL();
+
+        LV2_URI_Map_Feature uri_map;
+        uri_map.callback_data   = &map;
+        uri_map.uri_to_id       = uri_to_id;
+
+        lsp::lv2::EventConverter conv;
+        if (conv.init(map.map_feature(), &uri_map) != lsp::STATUS_OK)
+            PTEST_FAIL();
+        if (conv.add_type(LV2_MIDI__MidiEvent) != lsp::STATUS_OK)
+            PTEST_FAIL();
+        const LV2_URID midi_urid = map.map(LV2_MIDI__MidiEvent);
+
+        LV2_Atom_Sequence *seq  = static_cast<LV2_Atom_Sequence *>(malloc(BUF_CAPACITY + sizeof(LV2_Atom)));
+        LV2_Atom_Sequence *out  = static_cast<LV2_Atom_Sequence *>(malloc(BUF_CAPACITY + sizeof(LV2_Atom)));
+        LV2_Event_Buffer *evbuf = lv2_event_buffer_new(BUF_CAPACITY, LV2_EVENT_AUDIO_STAMP);
+        if ((seq == NULL) || (out == NULL) || (evbuf == NULL))
+            PTEST_FAIL();
+
+        call(&conv, 64, midi_urid, seq, out, evbuf);
+        call(&conv, 1024, midi_urid, seq, out, evbuf);
+        call(&conv, 4096, midi_urid, seq, out, evbuf);
+
+        free(seq);
+        free(out);
+        free(evbuf);
+    }
+
+PTEST_END
+
+LV2_RESTORE_WARNINGS
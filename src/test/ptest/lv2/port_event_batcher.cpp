@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/PortEventBatcher.h>
+#include <lsp-plug.in/3rdparty/lv2/UridMap.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#include <lv2/atom/atom.h>
+
+#define NUM_PORTS           2000
+#define NUM_ATOM_PORTS      100
+#define UI_RATE             60
+#define BLOCK_RATE          180         // 48 kHz with 267-frame blocks, 3 blocks per UI frame
+
+namespace
+{
+    typedef struct ui_t
+    {
+        float       values[NUM_PORTS];
+        bool        redraw[NUM_PORTS];
+        size_t      calls;
+    } ui_t;
+
+    // Typical meter widget: convert the value to decibels and request redraw on change
+    static void port_event(LV2UI_Handle handle, uint32_t port, uint32_t size, uint32_t format, const void *buffer)
+    {
+        ui_t *ui        = static_cast<ui_t *>(handle);
+        const float v   = (format == 0) ? *static_cast<const float *>(buffer) : float(size);
+        const float db  = 20.0f * log10f(fabsf(v) + 1e-6f);
+        if (db != ui->values[port])
+        {
+            ui->values[port]    = db;
+            ui->redraw[port]    = true;
+        }
+        ++ui->calls;
+    }
+
+    typedef struct atom_msg_t
+    {
+        LV2_Atom    atom;
+        uint32_t    body[4];
+    } atom_msg_t;
+
+    static inline bool is_atom_port(uint32_t port)
+    {
+        return port >= NUM_PORTS - NUM_ATOM_PORTS;
+    }
+
+    // Typical host code: each update of each port is sent to the UI
+    static void naive_frame(const LV2UI_Descriptor *d, ui_t *ui, const atom_msg_t *msg)
+    {
+        for (size_t j=0; j<BLOCK_RATE / UI_RATE; ++j)
+            for (uint32_t i=0; i<NUM_PORTS; ++i)
+            {
+                if (is_atom_port(i))
+                    d->port_event(ui, i, sizeof(LV2_Atom) + msg->atom.size, 1, &msg->atom);
+                else
+                {
+                    const float v = float(i + j);
+                    d->port_event(ui, i, sizeof(float), 0, &v);
+                }
+            }
+    }
+
+    static void batched_write(lsp::lv2::PortEventBatcher *b, const atom_msg_t *msg)
+    {
+        for (size_t j=0; j<BLOCK_RATE / UI_RATE; ++j)
+            for (uint32_t i=0; i<NUM_PORTS; ++i)
+            {
+                if (is_atom_port(i))
+                    b->write_atom(i, &msg->atom);
+                else
+                    b->write_control(i, float(i + j));
+            }
+    }
+
+    static void batched_frame(lsp::lv2::PortEventBatcher *b, const LV2UI_Descriptor *d, ui_t *ui, const atom_msg_t *msg)
+    {
+        batched_write(b, msg);
+        b->flush(d, ui);
+    }
+} /* namespace */
+
+PTEST_BEGIN("3rdparty.lv2", port_event_batcher, 5, 10)
+
+    void call(lsp::lv2::UridMap *map, const LV2UI_Descriptor *d, ui_t *ui, const atom_msg_t *msg, size_t subscribed)
+    {
+        char label[0x40];
+
+        lsp::lv2::PortEventBatcher b;
+        if (b.init(NUM_PORTS, 0x10000, map->map_feature()) != lsp::STATUS_OK)
+            PTEST_FAIL();
+        for (size_t i=0; i<NUM_PORTS; ++i)
+            if (b.subscribe(i, (i * 100) < (subscribed * NUM_PORTS)) != lsp::STATUS_OK)
+                PTEST_FAIL();
+
+        // Count events delivered to the UI per second
+        ui->calls   = 0;
+        for (size_t i=0; i<UI_RATE; ++i)
+            naive_frame(d, ui, msg);
+        const size_t naive_calls = ui->calls;
+
+        ui->calls   = 0;
+        for (size_t i=0; i<UI_RATE; ++i)
+            batched_frame(&b, d, ui, msg);
+
+        printf("Events per second with %d%% ports subscribed:\n", int(subscribed));
+        printf("  per-update delivery:  %8d\n", int(naive_calls));
+        printf("  batched delivery:     %8d (dropped %d, coalesced %d)\n",
+            int(b.delivered()), int(b.dropped()), int(b.coalesced()));
+
+        snprintf(label, sizeof(label), "port_event per update %d%%", int(subscribed));
+        PTEST_LOOP(label,
+            naive_frame(d, ui, msg);
+        );
+
+        snprintf(label, sizeof(label), "batched %d%%", int(subscribed));
+        PTEST_LOOP(label,
+            batched_frame(&b, d, ui, msg);
+        );
+
+        PTEST_SEPARATOR;
+    }
+
+    PTEST_MAIN
+    {
+        lsp::lv2::UridMap map;
+        if (map.init() != lsp::STATUS_OK)
+            PTEST_FAIL();
+
+        ui_t *ui = static_cast<ui_t *>(malloc(sizeof(ui_t)));
+        if (ui == NULL)
+            PTEST_FAIL();
+        memset(ui, 0, sizeof(ui_t));
+
+        LV2UI_Descriptor d;
+        memset(&d, 0, sizeof(d));
+        d.URI           = "urn:test:ui";
+        d.port_event    = port_event;
+
+        atom_msg_t msg;
+        msg.atom.type   = 1;
+        msg.atom.size   = sizeof(msg.body);
+        memset(msg.body, 0, sizeof(msg.body));
+
+        call(&map, &d, ui, &msg, 100);
+        call(&map, &d, ui, &msg, 25);
+
+        free(ui);
+    }
+
+PTEST_END
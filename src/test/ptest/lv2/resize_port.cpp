@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/ResizePortHost.h>
+#include <lsp-plug.in/3rdparty/lv2/ResizePortPool.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define NUM_PLUGINS         300
+#define NUM_PORTS           2
+#define WORST_CASE_SIZE     0x100000
+#define RESIZED_SIZE        0x20000
+#define RESIZED_STEP        16
+
+namespace
+{
+    static void connect_port(LV2_Handle instance, uint32_t port, void *data)
+    {
+        static_cast<void **>(instance)[port] = data;
+    }
+
+    static const LV2_Descriptor descriptor =
+    {
+        "urn:test:resize-port",
+        NULL,
+        connect_port,
+        NULL,
+        NULL,
+        NULL,
+        NULL,
+        NULL
+    };
+} /* namespace */
+
+PTEST_BEGIN("3rdparty.lv2", resize_port, 5, 1000)
+
+    PTEST_MAIN
+    {
+        lsp::lv2::ResizePortPool pool;
+        if (pool.init() != lsp::STATUS_OK)
+            PTEST_FAIL();
+
+        // Session: each plugin has one atom input and one atom output port
+        lsp::lv2::ResizePortHost *hosts = new lsp::lv2::ResizePortHost[NUM_PLUGINS];
+        void **ports = static_cast<void **>(malloc(NUM_PLUGINS * NUM_PORTS * sizeof(void *)));
+        if ((hosts == NULL) || (ports == NULL))
+            PTEST_FAIL();
+
+        for (size_t i=0; i<NUM_PLUGINS; ++i)
+        {
+            lsp::lv2::ResizePortHost *h = &hosts[i];
+            if (h->init(&pool) != lsp::STATUS_OK)
+                PTEST_FAIL();
+            for (size_t j=0; j<NUM_PORTS; ++j)
+                if (h->add_port(j, 0, true) != lsp::STATUS_OK)
+                    PTEST_FAIL();
+            if (h->bind(&descriptor, &ports[i * NUM_PORTS]) != lsp::STATUS_OK)
+                PTEST_FAIL();
+        }
+
+        // Some plugins request greater buffers for the output port
+        if (pool.reserve(RESIZED_SIZE, NUM_PLUGINS / RESIZED_STEP + 1) != lsp::STATUS_OK)
+            PTEST_FAIL();
+        for (size_t i=0; i<NUM_PLUGINS; i += RESIZED_STEP)
+            if (hosts[i].resize(1, RESIZED_SIZE) != LV2_RESIZE_PORT_SUCCESS)
+                PTEST_FAIL();
+        for (size_t i=0; i<NUM_PLUGINS; ++i)
+            hosts[i].end_cycle();
+
+        const size_t worst  = size_t(NUM_PLUGINS) * NUM_PORTS * WORST_CASE_SIZE;
+        const size_t pooled = pool.allocated();
+        printf("Memory for %d plugins x %d atom ports:\n", NUM_PLUGINS, NUM_PORTS);
+        printf("  worst-case allocation:  %8d KiB\n", int(worst >> 10));
+        printf("  pooled allocation:      %8d KiB\n", int(pooled >> 10));
+        printf("  saved:                  %8d KiB (%.1f%%)\n", int((worst - pooled) >> 10), 100.0 * (worst - pooled) / worst);
+        PTEST_SEPARATOR;
+
+        char label[0x40];
+
+        snprintf(label, sizeof(label), "end_cycle x%d", NUM_PLUGINS);
+        PTEST_LOOP(label,
+            for (size_t i=0; i<NUM_PLUGINS; ++i)
+                hosts[i].end_cycle();
+        );
+
+        snprintf(label, sizeof(label), "resize (fits) x%d", NUM_PLUGINS * NUM_PORTS);
+        PTEST_LOOP(label,
+            for (size_t i=0; i<NUM_PLUGINS; ++i)
+                for (size_t j=0; j<NUM_PORTS; ++j)
+                    hosts[i].resize(j, pool.sequence_size());
+        );
+
+        PTEST_SEPARATOR;
+
+        void * volatile bufs[NUM_PORTS];
+        if (pool.reserve(RESIZED_SIZE, NUM_PORTS) != lsp::STATUS_OK)
+            PTEST_FAIL();
+
+        PTEST_LOOP("malloc + free",
+            for (size_t j=0; j<NUM_PORTS; ++j)
+                bufs[j] = malloc(RESIZED_SIZE);
+            for (size_t j=0; j<NUM_PORTS; ++j)
+                free(bufs[j]);
+        );
+
+        PTEST_LOOP("acquire + release",
+            for (size_t j=0; j<NUM_PORTS; ++j)
+                bufs[j] = pool.acquire(RESIZED_SIZE);
+            for (size_t j=0; j<NUM_PORTS; ++j)
+                pool.release(bufs[j]);
+        );
+
+        PTEST_SEPARATOR;
+
+        delete [] hosts;
+        free(ports);
+    }
+
+PTEST_END
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/sequence.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#include <lv2/atom/util.h>
+
+#define BEAT_TIME           100
+#define MIDI_EVENT          200
+#define TOTAL_EVENTS        4096
+#define BLOCK_SIZE          1024
+#define MAX_INPUTS          32
+#define SEQ_CAPACITY        (TOTAL_EVENTS * 32)
+
+namespace
+{
+    typedef struct midi_event_t
+    {
+        LV2_Atom_Event      ev;
+        uint8_t             data[8];
+    } midi_event_t;
+
+    static void seq_init(LV2_Atom_Sequence *seq)
+    {
+        seq->atom.size      = sizeof(LV2_Atom_Sequence_Body);
+        seq->atom.type      = 0;
+        seq->body.unit      = 0;
+        seq->body.pad       = 0;
+    }
+
+    static void seq_append(LV2_Atom_Sequence *seq, int64_t frame)
+    {
+        midi_event_t me;
+        me.ev.time.frames   = frame;
+        me.ev.body.type     = MIDI_EVENT;
+        me.ev.body.size     = 3;
+        me.data[0]          = 0x90;
+        me.data[1]          = uint8_t(frame & 0x7f);
+        me.data[2]          = 0x40;
+        lv2_atom_sequence_append_event(seq, SEQ_CAPACITY, &me.ev);
+    }
+
+    // Typical host code: select the earliest event among heads of all inputs
+    static void naive_merge(LV2_Atom_Sequence *dst, LV2_Atom_Sequence * const *src, size_t count)
+    {
+        LV2_Atom_Event *heads[MAX_INPUTS];
+        for (size_t i=0; i<count; ++i)
+            heads[i]    = lv2_atom_sequence_begin(&src[i]->body);
+
+        seq_init(dst);
+        while (true)
+        {
+            ssize_t first = -1;
+            for (size_t i=0; i<count; ++i)
+            {
+                if (lv2_atom_sequence_is_end(&src[i]->body, src[i]->atom.size, heads[i]))
+                    continue;
+                if ((first < 0) || (heads[i]->time.frames < heads[first]->time.frames))
+                    first       = i;
+            }
+            if (first < 0)
+                break;
+
+            lv2_atom_sequence_append_event(dst, SEQ_CAPACITY, heads[first]);
+            heads[first]    = lv2_atom_sequence_next(heads[first]);
+        }
+    }
+} /* namespace */
+
+PTEST_BEGIN("3rdparty.lv2", sequence, 5, 100)
+
+    LV2_Atom_Sequence      *vInputs[MAX_INPUTS];
+    LV2_Atom_Sequence      *pOutput;
+    LV2_Atom_Sequence      *pUnsorted;
+    LV2_Atom_Sequence      *pTemp;
+    void                   *pScratch;
+
+    void call_merge(size_t inputs)
+    {
+        char label[0x40];
+
+        // Distribute events over inputs, each input has sorted time stamps within the block
+        for (size_t i=0; i<inputs; ++i)
+        {
+            seq_init(vInputs[i]);
+            for (size_t j=0, n=TOTAL_EVENTS / inputs; j<n; ++j)
+                seq_append(vInputs[i], (j * BLOCK_SIZE) / n + (rand() % 4));
+        }
+
+        snprintf(label, sizeof(label), "naive merge x%d", int(inputs));
+        PTEST_LOOP(label,
+            naive_merge(pOutput, vInputs, inputs);
+        );
+
+        snprintf(label, sizeof(label), "sequence_merge x%d", int(inputs));
+        PTEST_LOOP(label,
+            lsp::lv2::sequence_merge(pOutput, SEQ_CAPACITY, vInputs, inputs, BEAT_TIME);
+        );
+
+        PTEST_SEPARATOR;
+    }
+
+    void call_sort(const char *name, size_t outliers)
+    {
+        char label[0x40];
+
+        seq_init(pUnsorted);
+        for (size_t i=0; i<TOTAL_EVENTS; ++i)
+        {
+            int64_t frame = (i * BLOCK_SIZE) / TOTAL_EVENTS;
+            if ((outliers > 0) && ((rand() % outliers) == 0))
+                frame       = rand() % BLOCK_SIZE;
+            seq_append(pUnsorted, frame);
+        }
+
+        const size_t size = pUnsorted->atom.size + sizeof(LV2_Atom);
+
+        snprintf(label, sizeof(label), "%s: copy", name);
+        PTEST_LOOP(label,
+            memcpy(pTemp, pUnsorted, size);
+        );
+
+        snprintf(label, sizeof(label), "%s: copy + sort with scratch", name);
+        PTEST_LOOP(label,
+            memcpy(pTemp, pUnsorted, size);
+            lsp::lv2::sequence_sort(pTemp, BEAT_TIME, pScratch);
+        );
+
+        snprintf(label, sizeof(label), "%s: copy + sort in place", name);
+        PTEST_LOOP(label,
+            memcpy(pTemp, pUnsorted, size);
+            lsp::lv2::sequence_sort(pTemp, BEAT_TIME);
+        );
+
+        PTEST_SEPARATOR;
+    }
+
+    PTEST_MAIN
+    {
+        srand(0x44);
+
+        for (size_t i=0; i<MAX_INPUTS; ++i)
+            vInputs[i]      = static_cast<LV2_Atom_Sequence *>(malloc(SEQ_CAPACITY + sizeof(LV2_Atom)));
+        pOutput         = static_cast<LV2_Atom_Sequence *>(malloc(SEQ_CAPACITY + sizeof(LV2_Atom)));
+        pUnsorted       = static_cast<LV2_Atom_Sequence *>(malloc(SEQ_CAPACITY + sizeof(LV2_Atom)));
+        pTemp           = static_cast<LV2_Atom_Sequence *>(malloc(SEQ_CAPACITY + sizeof(LV2_Atom)));
+        pScratch        = malloc(SEQ_CAPACITY + sizeof(LV2_Atom));
+
+        call_merge(2);
+        call_merge(8);
+        call_merge(32);
+
+        call_sort("sorted", 0);
+        call_sort("1/64 outliers", 64);
+        call_sort("1/8 outliers", 8);
+        call_sort("random", 1);
+
+        for (size_t i=0; i<MAX_INPUTS; ++i)
+            free(vInputs[i]);
+        free(pOutput);
+        free(pUnsorted);
+        free(pTemp);
+        free(pScratch);
+    }
+
+PTEST_END
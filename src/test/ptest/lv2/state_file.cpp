@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/StateReader.h>
+#include <lsp-plug.in/3rdparty/lv2/StateWriter.h>
+#include <lsp-plug.in/3rdparty/lv2/UridMap.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#include <lv2/atom/atom.h>
+
+#define NUM_KEYS            10000
+#define BLOB_SIZE           0x100
+
+namespace
+{
+    // Plugin state: mostly scalar parameters with some blobs
+    typedef struct plugin_t
+    {
+        LV2_URID        keys[NUM_KEYS];
+        LV2_URID        types[NUM_KEYS];
+        uint8_t         values[NUM_KEYS][BLOB_SIZE];
+        size_t          sizes[NUM_KEYS];
+        size_t          checksum;
+    } plugin_t;
+
+    static void plugin_init(plugin_t *p, LV2_URID_Map *map)
+    {
+        char key[0x40];
+        const LV2_URID tfloat   = map->map(map->handle, LV2_ATOM__Float);
+        const LV2_URID tchunk   = map->map(map->handle, LV2_ATOM__Chunk);
+
+        for (size_t i=0; i<NUM_KEYS; ++i)
+        {
+            snprintf(key, sizeof(key), "http://lsp-plug.in/plugins/lv2/test#param_%d", int(i));
+            p->keys[i]      = map->map(map->handle, key);
+            p->types[i]     = ((i % 100) == 0) ? tchunk : tfloat;
+            p->sizes[i]     = ((i % 100) == 0) ? BLOB_SIZE : sizeof(float);
+            for (size_t j=0; j<BLOB_SIZE; ++j)
+                p->values[i][j] = uint8_t(i + j);
+        }
+        p->checksum     = 0;
+    }
+
+    static void plugin_save(plugin_t *p, LV2_State_Store_Function store, LV2_State_Handle handle)
+    {
+        for (size_t i=0; i<NUM_KEYS; ++i)
+            store(handle, p->keys[i], p->values[i], p->sizes[i], p->types[i], LV2_STATE_IS_POD | LV2_STATE_IS_PORTABLE);
+    }
+
+    static void plugin_restore(plugin_t *p, LV2_State_Retrieve_Function retrieve, LV2_State_Handle handle)
+    {
+        size_t size;
+        uint32_t type, flags;
+        for (size_t i=0; i<NUM_KEYS; ++i)
+        {
+            const uint8_t *v = static_cast<const uint8_t *>(retrieve(handle, p->keys[i], &size, &type, &flags));
+            if ((v != NULL) && (size > 0))
+                p->checksum    += v[size - 1];
+        }
+    }
+
+    // Baseline: the host serializes the state to Turtle-like text and keeps parsed statements in a list
+    typedef struct statement_t
+    {
+        char           *key;
+        char           *type;
+        uint8_t        *value;
+        size_t          size;
+        uint32_t        flags;
+    } statement_t;
+
+    typedef struct turtle_t
+    {
+        LV2_URID_Map   *map;
+        LV2_URID_Unmap *unmap;
+        char           *text;
+        size_t          length;
+        size_t          capacity;
+        statement_t    *statements;
+        size_t          count;
+    } turtle_t;
+
+    static void turtle_append(turtle_t *t, const char *s, size_t len)
+    {
+        if (t->length + len + 1 > t->capacity)
+        {
+            t->capacity     = lsp_max(t->capacity * 2, t->length + len + 0x1000);
+            t->text         = static_cast<char *>(realloc(t->text, t->capacity));
+        }
+        memcpy(&t->text[t->length], s, len);
+        t->length      += len;
+        t->text[t->length]  = '\0';
+    }
+
+    static LV2_State_Status turtle_store(LV2_State_Handle handle, uint32_t key, const void *value, size_t size, uint32_t type, uint32_t flags)
+    {
+        static const char *hex = "0123456789abcdef";
+        turtle_t *t     = static_cast<turtle_t *>(handle);
+        char buf[BLOB_SIZE * 2 + 0x100];
+
+        const uint8_t *v= static_cast<const uint8_t *>(value);
+        size_t n        = snprintf(buf, sizeof(buf), "<%s> a <%s> ; <flags> %u ; <value> \"",
+            t->unmap->unmap(t->unmap->handle, key), t->unmap->unmap(t->unmap->handle, type), unsigned(flags));
+        for (size_t i=0; i<size; ++i)
+        {
+            buf[n++]        = hex[v[i] >> 4];
+            buf[n++]        = hex[v[i] & 0xf];
+        }
+        buf[n++]        = '"';
+        buf[n++]        = ' ';
+        buf[n++]        = '.';
+        buf[n++]        = '\n';
+        turtle_append(t, buf, n);
+
+        return LV2_STATE_SUCCESS;
+    }
+
+    static inline uint8_t unhex(char c)
+    {
+        return (c <= '9') ? c - '0' : c - 'a' + 10;
+    }
+
+    static char *turtle_uri(const char **s)
+    {
+        const char *start   = strchr(*s, '<') + 1;
+        const char *end     = strchr(start, '>');
+        *s                  = end + 1;
+        return strndup(start, end - start);
+    }
+
+    static void turtle_clear(turtle_t *t)
+    {
+        for (size_t i=0; i<t->count; ++i)
+        {
+            free(t->statements[i].key);
+            free(t->statements[i].type);
+            free(t->statements[i].value);
+        }
+        free(t->statements);
+        t->statements   = NULL;
+        t->count        = 0;
+    }
+
+    static void turtle_parse(turtle_t *t)
+    {
+        turtle_clear(t);
+
+        size_t cap      = 0;
+        for (const char *s = t->text; *s != '\0'; )
+        {
+            if (t->count >= cap)
+            {
+                cap             = lsp_max(cap * 2, size_t(0x100));
+                t->statements   = static_cast<statement_t *>(realloc(t->statements, cap * sizeof(statement_t)));
+            }
+
+            statement_t *st = &t->statements[t->count++];
+            st->key         = turtle_uri(&s);
+            st->type        = turtle_uri(&s);
+            turtle_uri(&s); // <flags>
+            st->flags       = strtoul(s, const_cast<char **>(&s), 10);
+            free(turtle_uri(&s)); // <value>
+
+            const char *begin   = strchr(s, '"') + 1;
+            const char *end     = strchr(begin, '"');
+            st->size        = (end - begin) / 2;
+            st->value       = static_cast<uint8_t *>(malloc(lsp_max(st->size, size_t(1))));
+            for (size_t i=0; i<st->size; ++i)
+                st->value[i]    = (unhex(begin[i*2]) << 4) | unhex(begin[i*2 + 1]);
+            s               = strchr(end, '\n') + 1;
+        }
+    }
+
+    static const void *turtle_retrieve(LV2_State_Handle handle, uint32_t key, size_t *size, uint32_t *type, uint32_t *flags)
+    {
+        turtle_t *t     = static_cast<turtle_t *>(handle);
+        const char *uri = t->unmap->unmap(t->unmap->handle, key);
+
+        for (size_t i=0; i<t->count; ++i)
+        {
+            const statement_t *st = &t->statements[i];
+            if (strcmp(st->key, uri) != 0)
+                continue;
+
+            *size           = st->size;
+            *type           = t->map->map(t->map->handle, st->type);
+            *flags          = st->flags;
+            return st->value;
+        }
+
+        return NULL;
+    }
+} /* namespace */
+
+PTEST_BEGIN("3rdparty.lv2", state_file, 5, 1)
+
+    PTEST_MAIN
+    {
+        lsp::lv2::UridMap map;
+        if (map.init() != lsp::STATUS_OK)
+            PTEST_FAIL();
+
+        plugin_t *p = static_cast<plugin_t *>(malloc(sizeof(plugin_t)));
+        if (p == NULL)
+            PTEST_FAIL();
+        plugin_init(p, map.map_feature());
+
+        turtle_t t;
+        memset(&t, 0, sizeof(t));
+        t.map           = map.map_feature();
+        t.unmap         = map.unmap_feature();
+
+        lsp::lv2::StateWriter w;
+        lsp::lv2::StateReader r;
+        if (w.init(map.unmap_feature()) != lsp::STATUS_OK)
+            PTEST_FAIL();
+
+        const void *data    = NULL;
+        size_t size         = 0;
+
+        // Save
+        PTEST_LOOP("save turtle",
+            t.length        = 0;
+            plugin_save(p, turtle_store, &t);
+        );
+
+        PTEST_LOOP("save binary",
+            w.clear();
+            plugin_save(p, w.store_function(), w.handle());
+            if (w.serialize(&data, &size) != lsp::STATUS_OK)
+                PTEST_FAIL();
+        );
+
+        printf("State size: turtle %d bytes, binary %d bytes\n", int(t.length), int(size));
+        PTEST_SEPARATOR;
+
+        // Restore
+        PTEST_LOOP("restore turtle",
+            turtle_parse(&t);
+            plugin_restore(p, turtle_retrieve, &t);
+        );
+
+        PTEST_LOOP("restore binary",
+            r.close();
+            if (r.wrap(data, size, map.map_feature(), map.unmap_feature()) != lsp::STATUS_OK)
+                PTEST_FAIL();
+            plugin_restore(p, r.retrieve_function(), r.handle());
+        );
+
+        PTEST_SEPARATOR;
+
+        // Retrieve only
+        PTEST_LOOP("retrieve turtle",
+            plugin_restore(p, turtle_retrieve, &t);
+        );
+
+        PTEST_LOOP("retrieve binary",
+            plugin_restore(p, r.retrieve_function(), r.handle());
+        );
+
+        PTEST_SEPARATOR;
+
+        r.close();
+        turtle_clear(&t);
+        free(t.text);
+        free(p);
+    }
+
+PTEST_END
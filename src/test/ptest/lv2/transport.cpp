@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/transport.h>
+#include <lsp-plug.in/3rdparty/lv2/UridMap.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#include <lv2/atom/util.h>
+
+#define SUB_BLOCK           16
+#define MAX_POSITIONS       (4096 / SUB_BLOCK)
+#define POSITION_SIZE       0x100
+
+namespace
+{
+    // Typical plugin code which fetches the properties with lv2_atom_object_get()
+    static uint32_t object_get_decode(lsp::lv2::transport_t *t, const LV2_Atom *atom, const lsp::lv2::transport_urids_t *u)
+    {
+        const LV2_Atom_Object *obj = reinterpret_cast<const LV2_Atom_Object *>(atom);
+        if (obj->body.otype != u->time_Position)
+            return 0;
+
+        const LV2_Atom *frame = NULL, *speed = NULL, *bar = NULL, *bar_beat = NULL, *beat = NULL;
+        const LV2_Atom *beat_unit = NULL, *beats_per_bar = NULL, *bpm = NULL, *fps = NULL;
+        lv2_atom_object_get(obj,
+            u->key[lsp::lv2::TRANSPORT_FRAME], &frame,
+            u->key[lsp::lv2::TRANSPORT_SPEED], &speed,
+            u->key[lsp::lv2::TRANSPORT_BAR], &bar,
+            u->key[lsp::lv2::TRANSPORT_BAR_BEAT], &bar_beat,
+            u->key[lsp::lv2::TRANSPORT_BEAT], &beat,
+            u->key[lsp::lv2::TRANSPORT_BEAT_UNIT], &beat_unit,
+            u->key[lsp::lv2::TRANSPORT_BEATS_PER_BAR], &beats_per_bar,
+            u->key[lsp::lv2::TRANSPORT_BEATS_PER_MINUTE], &bpm,
+            u->key[lsp::lv2::TRANSPORT_FRAMES_PER_SECOND], &fps,
+            0);
+
+        uint32_t fields = 0;
+        if ((frame != NULL) && (frame->type == u->atom_Long))
+        {
+            t->frame                = reinterpret_cast<const LV2_Atom_Long *>(frame)->body;
+            fields                 |= lsp::lv2::TRANSPORT_M_FRAME;
+        }
+        if ((speed != NULL) && (speed->type == u->atom_Float))
+        {
+            t->speed                = reinterpret_cast<const LV2_Atom_Float *>(speed)->body;
+            fields                 |= lsp::lv2::TRANSPORT_M_SPEED;
+        }
+        if ((bar != NULL) && (bar->type == u->atom_Long))
+        {
+            t->bar                  = reinterpret_cast<const LV2_Atom_Long *>(bar)->body;
+            fields                 |= lsp::lv2::TRANSPORT_M_BAR;
+        }
+        if ((bar_beat != NULL) && (bar_beat->type == u->atom_Float))
+        {
+            t->bar_beat             = reinterpret_cast<const LV2_Atom_Float *>(bar_beat)->body;
+            fields                 |= lsp::lv2::TRANSPORT_M_BAR_BEAT;
+        }
+        if ((beat != NULL) && (beat->type == u->atom_Double))
+        {
+            t->beat                 = reinterpret_cast<const LV2_Atom_Double *>(beat)->body;
+            fields                 |= lsp::lv2::TRANSPORT_M_BEAT;
+        }
+        if ((beat_unit != NULL) && (beat_unit->type == u->atom_Int))
+        {
+            t->beat_unit            = reinterpret_cast<const LV2_Atom_Int *>(beat_unit)->body;
+            fields                 |= lsp::lv2::TRANSPORT_M_BEAT_UNIT;
+        }
+        if ((beats_per_bar != NULL) && (beats_per_bar->type == u->atom_Float))
+        {
+            t->beats_per_bar        = reinterpret_cast<const LV2_Atom_Float *>(beats_per_bar)->body;
+            fields                 |= lsp::lv2::TRANSPORT_M_BEATS_PER_BAR;
+        }
+        if ((bpm != NULL) && (bpm->type == u->atom_Float))
+        {
+            t->beats_per_minute     = reinterpret_cast<const LV2_Atom_Float *>(bpm)->body;
+            fields                 |= lsp::lv2::TRANSPORT_M_BEATS_PER_MINUTE;
+        }
+        if ((fps != NULL) && (fps->type == u->atom_Float))
+        {
+            t->frames_per_second    = reinterpret_cast<const LV2_Atom_Float *>(fps)->body;
+            fields                 |= lsp::lv2::TRANSPORT_M_FRAMES_PER_SECOND;
+        }
+
+        t->fields  |= fields;
+        return fields;
+    }
+} /* namespace */
+
+PTEST_BEGIN("3rdparty.lv2", transport, 5, 1000)
+
+    lsp::lv2::transport_urids_t urids;
+    LV2_Atom_Forge          forge;
+    uint8_t                *vBuffer;
+    const LV2_Atom         *vPositions[MAX_POSITIONS];
+
+    void encode_positions(size_t count)
+    {
+        lsp::lv2::transport_t t;
+        lsp::lv2::transport_reset(&t);
+        t.speed             = 1.0f;
+        t.frames_per_second = 48000.0f;
+        t.fields            = lsp::lv2::TRANSPORT_M_ALL;
+
+        lv2_atom_forge_set_buffer(&forge, vBuffer, count * POSITION_SIZE);
+        for (size_t j=0; j<count; ++j)
+        {
+            const LV2_Atom_Forge_Ref ref = lsp::lv2::transport_encode(&forge, &t, lsp::lv2::TRANSPORT_M_ALL, &urids);
+            if (!ref)
+                PTEST_FAIL();
+            vPositions[j]      = lv2_atom_forge_deref(&forge, ref);
+
+            // Advance transport by one sub-block
+            const double beats  = double(SUB_BLOCK) * t.beats_per_minute / (60.0 * t.frames_per_second);
+            t.frame            += SUB_BLOCK;
+            t.beat             += beats;
+            t.bar_beat         += float(beats);
+            if (t.bar_beat >= t.beats_per_bar)
+            {
+                t.bar_beat         -= t.beats_per_bar;
+                ++t.bar;
+            }
+        }
+    }
+
+    void call(size_t frames)
+    {
+        char label[0x40];
+        const size_t count = frames / SUB_BLOCK;
+        uint32_t changed = 0;
+
+        encode_positions(count);
+
+        lsp::lv2::transport_t t;
+        lsp::lv2::transport_reset(&t);
+
+        snprintf(label, sizeof(label), "lv2_atom_object_get x%d", int(count));
+        PTEST_LOOP(label,
+            for (size_t j=0; j<count; ++j)
+                changed    |= object_get_decode(&t, vPositions[j], &urids);
+        );
+
+        snprintf(label, sizeof(label), "transport_decode x%d", int(count));
+        PTEST_LOOP(label,
+            for (size_t j=0; j<count; ++j)
+                changed    |= lsp::lv2::transport_decode(&t, vPositions[j], &urids);
+        );
+
+        snprintf(label, sizeof(label), "transport_encode x%d", int(count));
+        PTEST_LOOP(label,
+            lv2_atom_forge_set_buffer(&forge, &vBuffer[MAX_POSITIONS * POSITION_SIZE], count * POSITION_SIZE);
+            for (size_t j=0; j<count; ++j)
+                changed    |= uint32_t(lsp::lv2::transport_encode(&forge, &t, lsp::lv2::TRANSPORT_M_ALL, &urids) != 0);
+        );
+
+        if (changed == 0)
+            PTEST_FAIL();
+
+        PTEST_SEPARATOR;
+    }
+
+    PTEST_MAIN
+    {
+        lsp::lv2::UridMap map;
+        if (map.init() != lsp::STATUS_OK)
+            PTEST_FAIL();
+        if (lsp::lv2::transport_urids_init(&urids, map.map_feature()) != lsp::STATUS_OK)
+            PTEST_FAIL();
+        lv2_atom_forge_init(&forge, map.map_feature());
+
+        vBuffer = static_cast<uint8_t *>(malloc(MAX_POSITIONS * POSITION_SIZE * 2));
+        if (vBuffer == NULL)
+            PTEST_FAIL();
+
+        call(64);
+        call(256);
+        call(1024);
+        call(4096);
+
+        free(vBuffer);
+    }
+
+PTEST_END
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/UridMap.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#include <lv2/atom/atom.h>
+#include <lv2/midi/midi.h>
+#include <lv2/patch/patch.h>
+#include <lv2/time/time.h>
+
+#include <pthread.h>
+#include <map>
+#include <string>
+
+#define NUM_THREADS         64
+#define NUM_URIS            100000
+#define URI_LENGTH          0x30
+
+namespace
+{
+    static const char * const common_uris[] =
+    {
+        LV2_ATOM__Atom, LV2_ATOM__Sequence, LV2_ATOM__Object, LV2_ATOM__Float,
+        LV2_ATOM__Int, LV2_ATOM__Long, LV2_ATOM__URID, LV2_ATOM__eventTransfer,
+        LV2_MIDI__MidiEvent, LV2_TIME__Position, LV2_TIME__barBeat, LV2_TIME__beatsPerMinute,
+        LV2_TIME__speed, LV2_TIME__frame, LV2_PATCH__Set, LV2_PATCH__property
+    };
+
+    static constexpr size_t COMMON_URIS = sizeof(common_uris) / sizeof(common_uris[0]);
+
+    // Mutex-guarded std::map, the conventional host implementation
+    class NaiveMap
+    {
+        private:
+            pthread_mutex_t                     sMutex;
+            std::map<std::string, LV2_URID>     sMap;
+            LV2_URID                            nNext;
+
+        public:
+            explicit NaiveMap()
+            {
+                pthread_mutex_init(&sMutex, NULL);
+                nNext       = 1;
+            }
+
+            ~NaiveMap()
+            {
+                pthread_mutex_destroy(&sMutex);
+            }
+
+            LV2_URID map(const char *uri)
+            {
+                pthread_mutex_lock(&sMutex);
+                std::map<std::string, LV2_URID>::iterator it = sMap.find(uri);
+                LV2_URID res;
+                if (it == sMap.end())
+                {
+                    res         = nNext++;
+                    sMap.insert(std::make_pair(std::string(uri), res));
+                }
+                else
+                    res         = it->second;
+                pthread_mutex_unlock(&sMutex);
+                return res;
+            }
+    };
+
+    template <class M>
+    class Mapper: public lsp::ipc::Thread
+    {
+        public:
+            M                  *pMap;
+            const char         *vUris;
+            size_t              nIndex;
+
+        public:
+            explicit Mapper(M *map, const char *uris, size_t index)
+            {
+                pMap        = map;
+                vUris       = uris;
+                nIndex      = index;
+            }
+
+            virtual lsp::status_t run() override
+            {
+                // Each thread maps own slice of unique URIs and common URIs like plugin instantiate() does
+                for (size_t i=nIndex; i<NUM_URIS; i += NUM_THREADS)
+                {
+                    pMap->map(&vUris[i * URI_LENGTH]);
+                    pMap->map(common_uris[i % COMMON_URIS]);
+                }
+                return lsp::STATUS_OK;
+            }
+    };
+
+    template <class M>
+    void map_parallel(M *map, const char *uris)
+    {
+        Mapper<M> *threads[NUM_THREADS];
+        for (size_t i=0; i<NUM_THREADS; ++i)
+        {
+            threads[i]  = new Mapper<M>(map, uris, i);
+            threads[i]->start();
+        }
+        for (size_t i=0; i<NUM_THREADS; ++i)
+        {
+            threads[i]->join();
+            delete threads[i];
+        }
+    }
+} /* namespace */
+
+PTEST_BEGIN("3rdparty.lv2", urid_map, 5, 1)
+
+    void test_lookup()
+    {
+        NaiveMap naive;
+        lsp::lv2::UridMap map;
+        if (map.init() != lsp::STATUS_OK)
+            PTEST_FAIL();
+        for (size_t i=0; i<COMMON_URIS; ++i)
+            naive.map(common_uris[i]);
+
+        PTEST_LOOP("std::map lookup x1000",
+            for (size_t j=0; j<1000; ++j)
+                naive.map(common_uris[j % COMMON_URIS]);
+        );
+        PTEST_LOOP("UridMap lookup x1000",
+            for (size_t j=0; j<1000; ++j)
+                map.map(common_uris[j % COMMON_URIS]);
+        );
+        PTEST_SEPARATOR;
+    }
+
+    void test_parallel(const char *uris)
+    {
+        char label[0x40];
+
+        snprintf(label, sizeof(label), "std::map %d threads x%d URIs", NUM_THREADS, NUM_URIS);
+        PTEST_LOOP(label,
+            NaiveMap naive;
+            map_parallel(&naive, uris);
+        );
+
+        snprintf(label, sizeof(label), "UridMap %d threads x%d URIs", NUM_THREADS, NUM_URIS);
+        PTEST_LOOP(label,
+            lsp::lv2::UridMap map;
+            if (map.init(NUM_URIS * 2) != lsp::STATUS_OK)
+                PTEST_FAIL();
+            map_parallel(&map, uris);
+        );
+        PTEST_SEPARATOR;
+    }
+
+    PTEST_MAIN
+    {
+        char *uris = static_cast<char *>(malloc(NUM_URIS * URI_LENGTH));
+        if (uris == NULL)
+            PTEST_FAIL();
+        for (size_t i=0; i<NUM_URIS; ++i)
+            snprintf(&uris[i * URI_LENGTH], URI_LENGTH, "urn:lsp-plug.in:test:uri-%d", int(i));
+
+        test_lookup();
+        test_parallel(uris);
+
+        free(uris);
+    }
+
+PTEST_END
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/UridMap.h>
+#include <lsp-plug.in/3rdparty/lv2/uris.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define NUM_INSTANCES       500
+
+namespace
+{
+    // URIs mapped by typical plugin at instantiation
+    static const char * const plugin_uris[] =
+    {
+        LV2_ATOM__Atom, LV2_ATOM__Blank, LV2_ATOM__Bool, LV2_ATOM__Chunk,
+        LV2_ATOM__Double, LV2_ATOM__Float, LV2_ATOM__Int, LV2_ATOM__Long,
+        LV2_ATOM__Object, LV2_ATOM__Path, LV2_ATOM__Property, LV2_ATOM__Sequence,
+        LV2_ATOM__String, LV2_ATOM__Tuple, LV2_ATOM__URID, LV2_ATOM__Vector,
+        LV2_ATOM__eventTransfer, LV2_MIDI__MidiEvent, LV2_TIME__Position, LV2_TIME__bar,
+        LV2_TIME__barBeat, LV2_TIME__beatUnit, LV2_TIME__beatsPerBar, LV2_TIME__beatsPerMinute,
+        LV2_TIME__frame, LV2_TIME__speed, LV2_PATCH__Get, LV2_PATCH__Set,
+        LV2_PATCH__property, LV2_PATCH__value, LV2_PATCH__subject, LV2_BUF_SIZE__maxBlockLength
+    };
+
+    static const lsp::lv2::uri_t plugin_ids[] =
+    {
+        lsp::lv2::URI_ATOM__Atom, lsp::lv2::URI_ATOM__Blank, lsp::lv2::URI_ATOM__Bool, lsp::lv2::URI_ATOM__Chunk,
+        lsp::lv2::URI_ATOM__Double, lsp::lv2::URI_ATOM__Float, lsp::lv2::URI_ATOM__Int, lsp::lv2::URI_ATOM__Long,
+        lsp::lv2::URI_ATOM__Object, lsp::lv2::URI_ATOM__Path, lsp::lv2::URI_ATOM__Property, lsp::lv2::URI_ATOM__Sequence,
+        lsp::lv2::URI_ATOM__String, lsp::lv2::URI_ATOM__Tuple, lsp::lv2::URI_ATOM__URID, lsp::lv2::URI_ATOM__Vector,
+        lsp::lv2::URI_ATOM__eventTransfer, lsp::lv2::URI_MIDI__MidiEvent, lsp::lv2::URI_TIME__Position, lsp::lv2::URI_TIME__bar,
+        lsp::lv2::URI_TIME__barBeat, lsp::lv2::URI_TIME__beatUnit, lsp::lv2::URI_TIME__beatsPerBar, lsp::lv2::URI_TIME__beatsPerMinute,
+        lsp::lv2::URI_TIME__frame, lsp::lv2::URI_TIME__speed, lsp::lv2::URI_PATCH__Get, lsp::lv2::URI_PATCH__Set,
+        lsp::lv2::URI_PATCH__property, lsp::lv2::URI_PATCH__value, lsp::lv2::URI_PATCH__subject, lsp::lv2::URI_BUF_SIZE__maxBlockLength
+    };
+
+    static constexpr size_t PLUGIN_URIS     = sizeof(plugin_uris) / sizeof(plugin_uris[0]);
+
+    static_assert(PLUGIN_URIS == sizeof(plugin_ids) / sizeof(plugin_ids[0]), "Lists of URIs do not match");
+} /* namespace */
+
+PTEST_BEGIN("3rdparty.lv2", uris, 5, 10)
+
+    PTEST_MAIN
+    {
+        lsp::lv2::UridMap map;
+        if (map.init() != lsp::STATUS_OK)
+            PTEST_FAIL();
+
+        const LV2_URID_Map *feature = map.map_feature();
+        LV2_URID urids[NUM_INSTANCES][PLUGIN_URIS];
+        lsp::lv2::urid_bundle_t *bundles = static_cast<lsp::lv2::urid_bundle_t *>(malloc(NUM_INSTANCES * sizeof(lsp::lv2::urid_bundle_t)));
+        if (bundles == NULL)
+            PTEST_FAIL();
+
+        PTEST_LOOP("map() x500 instances",
+            for (size_t j=0; j<NUM_INSTANCES; ++j)
+                for (size_t k=0; k<PLUGIN_URIS; ++k)
+                    urids[j][k] = feature->map(feature->handle, plugin_uris[k]);
+        );
+
+        PTEST_LOOP("map_uris() x500 instances",
+            for (size_t j=0; j<NUM_INSTANCES; ++j)
+                lsp::lv2::map_uris(urids[j], plugin_ids, PLUGIN_URIS, feature);
+        );
+
+        PTEST_LOOP("map_uri_bundle() x500 instances",
+            for (size_t j=0; j<NUM_INSTANCES; ++j)
+                lsp::lv2::map_uri_bundle(&bundles[j], feature);
+        );
+
+        free(bundles);
+    }
+
+PTEST_END
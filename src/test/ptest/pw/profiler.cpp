@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/pw/ProfileStats.h>
+#include <lsp-plug.in/3rdparty/pw/ProfileTable.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#include <pw-headers/spa/param/profiler.h>
+#include <pw-headers/spa/pod/builder.h>
+#include <pw-headers/spa/utils/type.h>
+
+#define CYCLES_COUNT        1000
+#define NODES_COUNT         16
+#define CYCLES_PER_POD      10
+#define PODS_COUNT          (CYCLES_COUNT / CYCLES_PER_POD)
+
+PTEST_BEGIN("3rdparty.pw", profiler, 5, 10)
+
+    void build_capture(struct spa_pod_builder *b, const struct spa_pod **vp)
+    {
+        struct spa_pod_frame sf, of, f;
+        char name[0x20];
+
+        for (size_t k=0; k<CYCLES_COUNT; ++k)
+        {
+            if ((k % CYCLES_PER_POD) == 0)
+                spa_pod_builder_push_struct(b, &sf);
+
+            int64_t t = 1000000000 + k * 21333333;
+
+            spa_pod_builder_push_object(b, &of, SPA_TYPE_OBJECT_Profiler, 0);
+
+            spa_pod_builder_prop(b, SPA_PROFILER_info, 0);
+            spa_pod_builder_push_struct(b, &f);
+            spa_pod_builder_long(b, k);
+            spa_pod_builder_float(b, 0.1f);
+            spa_pod_builder_float(b, 0.2f);
+            spa_pod_builder_float(b, 0.3f);
+            spa_pod_builder_int(b, 0);
+            spa_pod_builder_pop(b, &f);
+
+            spa_pod_builder_prop(b, SPA_PROFILER_clock, 0);
+            spa_pod_builder_push_struct(b, &f);
+            spa_pod_builder_int(b, 0);
+            spa_pod_builder_int(b, 1);
+            spa_pod_builder_string(b, "driver");
+            spa_pod_builder_long(b, t);
+            spa_pod_builder_fraction(b, 1, 48000);
+            spa_pod_builder_long(b, k * 1024);
+            spa_pod_builder_long(b, 1024);
+            spa_pod_builder_long(b, 0);
+            spa_pod_builder_double(b, 1.0);
+            spa_pod_builder_long(b, t + 21333333);
+            spa_pod_builder_int(b, 0);
+            spa_pod_builder_int(b, int32_t(k));
+            spa_pod_builder_long(b, 0);
+            spa_pod_builder_pop(b, &f);
+
+            for (size_t i=0; i<NODES_COUNT; ++i)
+            {
+                const int64_t awake     = t + 2000 + (k * 7919 + i * 104729) % 20000;
+                const int64_t finish    = awake + 10000 + (k * 104729 + i * 7919) % 500000;
+                snprintf(name, sizeof(name), "node-%d", int(i));
+
+                spa_pod_builder_prop(b, (i == 0) ? SPA_PROFILER_driverBlock : SPA_PROFILER_followerBlock, 0);
+                spa_pod_builder_push_struct(b, &f);
+                spa_pod_builder_int(b, int32_t(i + 1));
+                spa_pod_builder_string(b, name);
+                spa_pod_builder_long(b, t - 21333333);
+                spa_pod_builder_long(b, t);
+                spa_pod_builder_long(b, awake);
+                spa_pod_builder_long(b, finish);
+                spa_pod_builder_int(b, 3);
+                spa_pod_builder_fraction(b, 1024, 48000);
+                spa_pod_builder_int(b, 0);
+                spa_pod_builder_bool(b, false);
+                spa_pod_builder_pop(b, &f);
+                t = finish;
+            }
+
+            spa_pod_builder_pop(b, &of);
+            if ((k % CYCLES_PER_POD) == (CYCLES_PER_POD - 1))
+                vp[k / CYCLES_PER_POD] = static_cast<const struct spa_pod *>(spa_pod_builder_pop(b, &sf));
+        }
+    }
+
+    void decode(lsp::pw::ProfileTable *table, const struct spa_pod * const *vp)
+    {
+        table->clear();
+        for (size_t i=0; i<PODS_COUNT; ++i)
+        {
+            if (table->append(vp[i]) != lsp::STATUS_OK)
+                PTEST_FAIL();
+        }
+    }
+
+    void aggregate(lsp::pw::ProfileTable *table, lsp::pw::ProfileStats *stats)
+    {
+        if (stats->update(table) != lsp::STATUS_OK)
+            PTEST_FAIL();
+    }
+
+    PTEST_MAIN
+    {
+        const size_t buf_size   = CYCLES_COUNT * NODES_COUNT * 0x100;
+        uint8_t *buf            = static_cast<uint8_t *>(malloc(buf_size));
+        const struct spa_pod **vp   = static_cast<const struct spa_pod **>(malloc(sizeof(struct spa_pod *) * PODS_COUNT));
+        if ((buf == NULL) || (vp == NULL))
+            PTEST_FAIL();
+
+        struct spa_pod_builder b;
+        spa_pod_builder_init(&b, buf, buf_size);
+        build_capture(&b, vp);
+        if (b.state.offset > buf_size)
+            PTEST_FAIL();
+
+        lsp::pw::ProfileTable table;
+        lsp::pw::ProfileStats stats;
+        if (table.init(CYCLES_COUNT * NODES_COUNT) != lsp::STATUS_OK)
+            PTEST_FAIL();
+        decode(&table, vp);
+
+        char label[0x40];
+        printf("Processing %d cycles with %d nodes\n", CYCLES_COUNT, NODES_COUNT);
+
+        snprintf(label, sizeof(label), "decode x %d", CYCLES_COUNT);
+        PTEST_LOOP(label, decode(&table, vp); );
+        snprintf(label, sizeof(label), "aggregate x %d", CYCLES_COUNT);
+        PTEST_LOOP(label, aggregate(&table, &stats); );
+        PTEST_SEPARATOR;
+
+        free(vp);
+        free(buf);
+    }
+
+PTEST_END
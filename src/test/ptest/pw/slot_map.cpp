@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/pw/SlotMap.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#include <pw-headers/pipewire/map.h>
+
+#define OBJECTS_COUNT       100000
+
+PTEST_BEGIN("3rdparty.pw", slot_map, 5, 10)
+
+    volatile uintptr_t sink;
+
+    static int sum_item(void *item_data, void *data)
+    {
+        *static_cast<uintptr_t *>(data) += uintptr_t(item_data);
+        return 0;
+    }
+
+    static void *object_ptr(size_t i)
+    {
+        return reinterpret_cast<void *>(uintptr_t((i + 1) * 16));
+    }
+
+    // Insert all objects, remove every second one and insert them again
+    void churn_pw_map(struct pw_map *map, uint32_t *ids)
+    {
+        pw_map_reset(map);
+        for (size_t i=0; i<OBJECTS_COUNT; ++i)
+            ids[i]  = pw_map_insert_new(map, object_ptr(i));
+        for (size_t i=0; i<OBJECTS_COUNT; i += 2)
+            pw_map_remove(map, ids[i]);
+        for (size_t i=0; i<OBJECTS_COUNT; i += 2)
+            ids[i]  = pw_map_insert_new(map, object_ptr(i));
+    }
+
+    void churn_slot_map(lsp::pw::SlotMap *map, lsp::pw::slot_id_t *ids)
+    {
+        map->clear();
+        for (size_t i=0; i<OBJECTS_COUNT; ++i)
+            map->insert(object_ptr(i), &ids[i]);
+        for (size_t i=0; i<OBJECTS_COUNT; i += 2)
+            map->remove(ids[i]);
+        for (size_t i=0; i<OBJECTS_COUNT; i += 2)
+            map->insert(object_ptr(i), &ids[i]);
+    }
+
+    uintptr_t lookup_pw_map(const struct pw_map *map, const uint32_t *ids, const uint32_t *order)
+    {
+        uintptr_t sum = 0;
+        for (size_t i=0; i<OBJECTS_COUNT; ++i)
+            sum += uintptr_t(pw_map_lookup(map, ids[order[i]]));
+        return sum;
+    }
+
+    uintptr_t lookup_slot_map(const lsp::pw::SlotMap *map, const lsp::pw::slot_id_t *ids, const uint32_t *order)
+    {
+        uintptr_t sum = 0;
+        for (size_t i=0; i<OBJECTS_COUNT; ++i)
+            sum += uintptr_t(map->lookup(ids[order[i]]));
+        return sum;
+    }
+
+    uintptr_t walk_pw_map(const struct pw_map *map)
+    {
+        uintptr_t sum = 0;
+        pw_map_for_each(map, sum_item, &sum);
+        return sum;
+    }
+
+    uintptr_t walk_slot_map(const lsp::pw::SlotMap *map)
+    {
+        uintptr_t sum = 0;
+        map->for_each(sum_item, &sum);
+        return sum;
+    }
+
+    PTEST_MAIN
+    {
+        uint32_t *pw_ids            = static_cast<uint32_t *>(malloc(OBJECTS_COUNT * sizeof(uint32_t)));
+        uint32_t *order             = static_cast<uint32_t *>(malloc(OBJECTS_COUNT * sizeof(uint32_t)));
+        lsp::pw::slot_id_t *sm_ids  = static_cast<lsp::pw::slot_id_t *>(malloc(OBJECTS_COUNT * sizeof(lsp::pw::slot_id_t)));
+        if ((pw_ids == NULL) || (order == NULL) || (sm_ids == NULL))
+            PTEST_FAIL();
+
+        // Random order of lookups
+        srand(0x5107);
+        for (size_t i=0; i<OBJECTS_COUNT; ++i)
+            order[i]    = uint32_t(i);
+        for (size_t i=OBJECTS_COUNT-1; i > 0; --i)
+        {
+            const size_t j  = rand() % (i + 1);
+            const uint32_t t = order[i];
+            order[i]        = order[j];
+            order[j]        = t;
+        }
+
+        // Maps with a half of objects re-inserted
+        struct pw_map pw_map = PW_MAP_INIT(64);
+        lsp::pw::SlotMap slot_map;
+        for (size_t i=0; i<OBJECTS_COUNT; ++i)
+        {
+            pw_ids[i]   = pw_map_insert_new(&pw_map, object_ptr(i));
+            slot_map.insert(object_ptr(i), &sm_ids[i]);
+        }
+        for (size_t i=0; i<OBJECTS_COUNT; i += 3)
+        {
+            pw_map_remove(&pw_map, pw_ids[i]);
+            slot_map.remove(sm_ids[i]);
+        }
+        for (size_t i=0; i<OBJECTS_COUNT; i += 3)
+        {
+            pw_ids[i]   = pw_map_insert_new(&pw_map, object_ptr(i));
+            slot_map.insert(object_ptr(i), &sm_ids[i]);
+        }
+        if ((lookup_pw_map(&pw_map, pw_ids, order) != lookup_slot_map(&slot_map, sm_ids, order)) ||
+            (walk_pw_map(&pw_map) != walk_slot_map(&slot_map)))
+            PTEST_FAIL();
+
+        char label[0x40];
+        printf("Processing %d objects\n", OBJECTS_COUNT);
+
+        {
+            struct pw_map churn_pw = PW_MAP_INIT(64);
+            lsp::pw::SlotMap churn_sm;
+
+            snprintf(label, sizeof(label), "pw_map churn x %d", OBJECTS_COUNT);
+            PTEST_LOOP(label, churn_pw_map(&churn_pw, pw_ids); );
+            snprintf(label, sizeof(label), "SlotMap churn x %d", OBJECTS_COUNT);
+            PTEST_LOOP(label, churn_slot_map(&churn_sm, sm_ids); );
+            PTEST_SEPARATOR;
+
+            pw_map_clear(&churn_pw);
+        }
+
+        for (size_t i=0; i<OBJECTS_COUNT; ++i)
+        {
+            pw_ids[i]   = i;
+            sm_ids[i]   = slot_map.item_id(i);
+        }
+        snprintf(label, sizeof(label), "pw_map lookup x %d", OBJECTS_COUNT);
+        PTEST_LOOP(label, sink = lookup_pw_map(&pw_map, pw_ids, order); );
+        snprintf(label, sizeof(label), "SlotMap lookup x %d", OBJECTS_COUNT);
+        PTEST_LOOP(label, sink = lookup_slot_map(&slot_map, sm_ids, order); );
+        PTEST_SEPARATOR;
+
+        snprintf(label, sizeof(label), "pw_map_for_each x %d", OBJECTS_COUNT);
+        PTEST_LOOP(label, sink = walk_pw_map(&pw_map); );
+        snprintf(label, sizeof(label), "SlotMap::for_each x %d", OBJECTS_COUNT);
+        PTEST_LOOP(label, sink = walk_slot_map(&slot_map); );
+        PTEST_SEPARATOR;
+
+        pw_map_clear(&pw_map);
+        slot_map.flush();
+        free(pw_ids);
+        free(order);
+        free(sm_ids);
+    }
+
+PTEST_END
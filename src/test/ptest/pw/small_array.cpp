@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/pw/SmallArray.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#include <pw-headers/pipewire/array.h>
+
+#define MAX_ITEMS           1000000
+
+PTEST_BEGIN("3rdparty.pw", small_array, 5, 10)
+
+    void append_pw_array(size_t count, size_t extend)
+    {
+        struct pw_array a = PW_ARRAY_INIT(extend);
+        for (size_t i=0; i<count; ++i)
+        {
+            if (pw_array_add_ptr(&a, reinterpret_cast<void *>(i)) < 0)
+                PTEST_FAIL();
+        }
+        pw_array_clear(&a);
+    }
+
+    void append_small_array(size_t count)
+    {
+        lsp::pw::SmallArray<void *, 16> a;
+        for (size_t i=0; i<count; ++i)
+        {
+            if (!a.push(reinterpret_cast<void *>(i)))
+                PTEST_FAIL();
+        }
+    }
+
+    void append_frozen(lsp::pw::SmallArray<void *, 16> *a, size_t count)
+    {
+        a->clear();
+        for (size_t i=0; i<count; ++i)
+        {
+            if (!a->push(reinterpret_cast<void *>(i)))
+                PTEST_FAIL();
+        }
+    }
+
+    PTEST_MAIN
+    {
+        char label[0x40];
+        lsp::pw::SmallArray<void *, 16> frozen;
+        if (frozen.reserve(MAX_ITEMS) != lsp::STATUS_OK)
+            PTEST_FAIL();
+        frozen.freeze();
+
+        for (size_t count = 10; count <= MAX_ITEMS; count *= 10)
+        {
+            printf("Appending %d pointers\n", int(count));
+
+            snprintf(label, sizeof(label), "pw_array extend=16 x %d", int(count));
+            PTEST_LOOP(label, append_pw_array(count, 16); );
+            snprintf(label, sizeof(label), "pw_array extend=4096 x %d", int(count));
+            PTEST_LOOP(label, append_pw_array(count, 4096); );
+            snprintf(label, sizeof(label), "SmallArray x %d", int(count));
+            PTEST_LOOP(label, append_small_array(count); );
+            snprintf(label, sizeof(label), "SmallArray frozen x %d", int(count));
+            PTEST_LOOP(label, append_frozen(&frozen, count); );
+            PTEST_SEPARATOR;
+        }
+
+        if (frozen.failures() != 0)
+            PTEST_FAIL();
+    }
+
+PTEST_END
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/audio_format.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define FRAMES              1024
+#define CHANNELS            2
+
+namespace
+{
+    static const uint32_t formats[] =
+    {
+        SPA_AUDIO_FORMAT_S16_LE,
+        SPA_AUDIO_FORMAT_S16_BE,
+        SPA_AUDIO_FORMAT_S24_32_LE,
+        SPA_AUDIO_FORMAT_S32_LE,
+        SPA_AUDIO_FORMAT_S24_LE,
+        SPA_AUDIO_FORMAT_F32_LE,
+        SPA_AUDIO_FORMAT_F32_BE,
+        SPA_AUDIO_FORMAT_F64_LE,
+        SPA_AUDIO_FORMAT_S16P,
+        SPA_AUDIO_FORMAT_S24_32P,
+        SPA_AUDIO_FORMAT_S32P,
+        SPA_AUDIO_FORMAT_S24P,
+        SPA_AUDIO_FORMAT_F32P,
+        SPA_AUDIO_FORMAT_F64P,
+    };
+} /* namespace */
+
+PTEST_BEGIN("3rdparty.spa", audio_format, 5, 1000)
+
+    void test_format(uint32_t format, uint8_t *raw, float *pcm)
+    {
+        struct spa_audio_info_raw info;
+        memset(&info, 0, sizeof(info));
+        info.format     = static_cast<enum spa_audio_format>(format);
+        info.rate       = 48000;
+        info.channels   = CHANNELS;
+
+        lsp::spa::audio_converter_t conv;
+        if (lsp::spa::audio_converter_init(&conv, &info) != lsp::STATUS_OK)
+            PTEST_FAIL();
+
+        void *raw_ptr[CHANNELS];
+        const void *craw_ptr[CHANNELS];
+        float *pcm_ptr[CHANNELS];
+        const float *cpcm_ptr[CHANNELS];
+        for (size_t i=0; i<CHANNELS; ++i)
+        {
+            raw_ptr[i]      = &raw[i * FRAMES * conv.desc->sample_size];
+            craw_ptr[i]     = raw_ptr[i];
+            pcm_ptr[i]      = &pcm[i * FRAMES];
+            cpcm_ptr[i]     = pcm_ptr[i];
+        }
+
+        char label[0x40];
+        snprintf(label, sizeof(label), "read %s x %d", conv.desc->name, FRAMES);
+        PTEST_LOOP(label,
+            lsp::spa::audio_convert_read(&conv, pcm_ptr, craw_ptr, FRAMES);
+        );
+        snprintf(label, sizeof(label), "write %s x %d", conv.desc->name, FRAMES);
+        PTEST_LOOP(label,
+            lsp::spa::audio_convert_write(&conv, raw_ptr, cpcm_ptr, FRAMES);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        uint8_t *raw    = static_cast<uint8_t *>(malloc(FRAMES * CHANNELS * sizeof(double)));
+        float *pcm      = static_cast<float *>(malloc(FRAMES * CHANNELS * sizeof(float)));
+        if ((raw == NULL) || (pcm == NULL))
+            PTEST_FAIL();
+
+        for (size_t i=0; i<FRAMES * CHANNELS; ++i)
+            pcm[i]          = (float(rand()) / float(RAND_MAX)) * 2.0f - 1.0f;
+        memset(raw, 0, FRAMES * CHANNELS * sizeof(double));
+
+        for (size_t i=0; i<sizeof(formats)/sizeof(formats[0]); ++i)
+            test_format(formats[i], raw, pcm);
+        PTEST_SEPARATOR;
+
+        free(raw);
+        free(pcm);
+    }
+
+PTEST_END
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/audio_passthrough.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+// 1 ms of DSD512 stream: 22.5792 MHz / 8 bits / 1000
+#define BYTES               2823
+#define CHANNELS            2
+
+PTEST_BEGIN("3rdparty.spa", audio_passthrough, 5, 1000)
+
+    void reverse_naive(uint8_t *dst, const uint8_t *src, size_t count)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            uint8_t v = src[i], r = 0;
+            for (size_t j=0; j<8; ++j, v >>= 1)
+                r       = (r << 1) | (v & 1);
+            dst[i]  = r;
+        }
+    }
+
+    void test_layout(int32_t interleave, bool lsb, uint8_t * const *planes, void * const *packed)
+    {
+        struct spa_audio_info_dsd info;
+        memset(&info, 0, sizeof(info));
+        info.bitorder   = (lsb) ? SPA_PARAM_BITORDER_lsb : SPA_PARAM_BITORDER_msb;
+        info.interleave = interleave;
+        info.rate       = 2822400;
+        info.channels   = CHANNELS;
+
+        lsp::spa::dsd_layout_t l;
+        if (lsp::spa::dsd_layout_init(&l, &info) != lsp::STATUS_OK)
+            PTEST_FAIL();
+
+        const void * const *cpacked = const_cast<const void * const *>(packed);
+        char label[0x40];
+        snprintf(label, sizeof(label), "dsd_pack i=%d %s x %d", int(interleave), (lsb) ? "lsb" : "msb", BYTES);
+        PTEST_LOOP(label,
+            lsp::spa::dsd_pack(&l, packed, planes, BYTES);
+        );
+        snprintf(label, sizeof(label), "dsd_unpack i=%d %s x %d", int(interleave), (lsb) ? "lsb" : "msb", BYTES);
+        PTEST_LOOP(label,
+            lsp::spa::dsd_unpack(&l, planes, cpacked, BYTES);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        uint8_t *planes[CHANNELS];
+        void *packed[CHANNELS];
+        int32_t *pcm    = static_cast<int32_t *>(malloc(BYTES * CHANNELS * sizeof(int32_t)));
+        if (pcm == NULL)
+            PTEST_FAIL();
+        for (size_t i=0; i<CHANNELS; ++i)
+        {
+            planes[i]       = static_cast<uint8_t *>(malloc(BYTES));
+            packed[i]       = malloc(BYTES * CHANNELS);
+            if ((planes[i] == NULL) || (packed[i] == NULL))
+                PTEST_FAIL();
+            for (size_t j=0; j<BYTES; ++j)
+                planes[i][j]    = uint8_t(rand());
+        }
+        uint8_t *tmp    = static_cast<uint8_t *>(packed[0]);
+        char label[0x40];
+
+        snprintf(label, sizeof(label), "reverse_naive x %d", BYTES);
+        PTEST_LOOP(label, reverse_naive(tmp, planes[0], BYTES); );
+        snprintf(label, sizeof(label), "dsd_reverse_bits x %d", BYTES);
+        PTEST_LOOP(label, lsp::spa::dsd_reverse_bits(tmp, planes[0], BYTES); );
+        PTEST_SEPARATOR;
+
+        test_layout(0, true, planes, packed);
+        test_layout(1, false, planes, packed);
+        test_layout(1, true, planes, packed);
+        test_layout(4, false, planes, packed);
+        test_layout(-4, true, planes, packed);
+        PTEST_SEPARATOR;
+
+        lsp::spa::dop_state_t st;
+        lsp::spa::dop_init(&st);
+        const uint8_t * const *cplanes = const_cast<const uint8_t * const *>(planes);
+        snprintf(label, sizeof(label), "dop_encode stereo x %d", BYTES / 2);
+        PTEST_LOOP(label, lsp::spa::dop_encode(&st, pcm, cplanes, CHANNELS, BYTES / 2); );
+        snprintf(label, sizeof(label), "dop_decode stereo x %d", BYTES / 2);
+        PTEST_LOOP(label,
+            lsp::spa::dop_init(&st);
+            lsp::spa::dop_decode(&st, planes, pcm, CHANNELS, BYTES / 2);
+        );
+        PTEST_SEPARATOR;
+
+        lsp::spa::iec61937_t enc;
+        struct spa_audio_info_iec958 info;
+        memset(&info, 0, sizeof(info));
+        info.codec      = SPA_AUDIO_IEC958_CODEC_AC3;
+        info.rate       = 48000;
+        if (lsp::spa::iec61937_init(&enc, &info) != lsp::STATUS_OK)
+            PTEST_FAIL();
+
+        const size_t burst_size = lsp::spa::iec61937_burst_size(&enc);
+        uint8_t *burst  = static_cast<uint8_t *>(malloc(burst_size));
+        uint8_t *frame  = static_cast<uint8_t *>(malloc(burst_size));
+        if ((burst == NULL) || (frame == NULL))
+            PTEST_FAIL();
+        memset(frame, 0x5a, burst_size);
+        lsp::spa::iec61937_burst_t b;
+
+        PTEST_LOOP("iec61937_pack AC3 x 3840",
+            lsp::spa::iec61937_pack(&enc, burst, burst_size, frame, 3840);
+        );
+        PTEST_LOOP("iec61937_unpack AC3 x 3840",
+            lsp::spa::iec61937_unpack(&b, frame, burst_size, burst, burst_size);
+        );
+        PTEST_SEPARATOR;
+
+        free(burst);
+        free(frame);
+        for (size_t i=0; i<CHANNELS; ++i)
+        {
+            free(planes[i]);
+            free(packed[i]);
+        }
+        free(pcm);
+    }
+
+PTEST_END
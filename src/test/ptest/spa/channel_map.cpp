@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/channel_map.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#include <steinberg/vst3/vst/Speaker.h>
+
+#define MAX_CHANNELS        64
+#define BUF_SAMPLES         1024
+
+namespace
+{
+    // Reference implementation with switch chain
+    static uint32_t naive_speaker_to_position(uint64_t speaker)
+    {
+        using namespace Steinberg::Vst;
+
+        switch (speaker)
+        {
+            case kSpeakerL:     return SPA_AUDIO_CHANNEL_FL;
+            case kSpeakerR:     return SPA_AUDIO_CHANNEL_FR;
+            case kSpeakerC:     return SPA_AUDIO_CHANNEL_FC;
+            case kSpeakerLfe:   return SPA_AUDIO_CHANNEL_LFE;
+            case kSpeakerLs:    return SPA_AUDIO_CHANNEL_RL;
+            case kSpeakerRs:    return SPA_AUDIO_CHANNEL_RR;
+            case kSpeakerLc:    return SPA_AUDIO_CHANNEL_FLC;
+            case kSpeakerRc:    return SPA_AUDIO_CHANNEL_FRC;
+            case kSpeakerCs:    return SPA_AUDIO_CHANNEL_RC;
+            case kSpeakerSl:    return SPA_AUDIO_CHANNEL_SL;
+            case kSpeakerSr:    return SPA_AUDIO_CHANNEL_SR;
+            case kSpeakerTc:    return SPA_AUDIO_CHANNEL_TC;
+            case kSpeakerTfl:   return SPA_AUDIO_CHANNEL_TFL;
+            case kSpeakerTfc:   return SPA_AUDIO_CHANNEL_TFC;
+            case kSpeakerTfr:   return SPA_AUDIO_CHANNEL_TFR;
+            case kSpeakerTrl:   return SPA_AUDIO_CHANNEL_TRL;
+            case kSpeakerTrc:   return SPA_AUDIO_CHANNEL_TRC;
+            case kSpeakerTrr:   return SPA_AUDIO_CHANNEL_TRR;
+            case kSpeakerLfe2:  return SPA_AUDIO_CHANNEL_LFE2;
+            case kSpeakerM:     return SPA_AUDIO_CHANNEL_MONO;
+            case kSpeakerTsl:   return SPA_AUDIO_CHANNEL_TSL;
+            case kSpeakerTsr:   return SPA_AUDIO_CHANNEL_TSR;
+            case kSpeakerLcs:   return SPA_AUDIO_CHANNEL_RLC;
+            case kSpeakerRcs:   return SPA_AUDIO_CHANNEL_RRC;
+            case kSpeakerBfl:   return SPA_AUDIO_CHANNEL_BLC;
+            case kSpeakerBfc:   return SPA_AUDIO_CHANNEL_BC;
+            case kSpeakerBfr:   return SPA_AUDIO_CHANNEL_BRC;
+            case kSpeakerLw:    return SPA_AUDIO_CHANNEL_FLW;
+            case kSpeakerRw:    return SPA_AUDIO_CHANNEL_FRW;
+            default:            break;
+        }
+        return SPA_AUDIO_CHANNEL_UNKNOWN;
+    }
+
+    static size_t naive_arrangement(uint32_t *pos, uint64_t arrangement)
+    {
+        size_t n = 0;
+        for (size_t i=0; i<64; ++i)
+        {
+            const uint64_t speaker = uint64_t(1) << i;
+            if (arrangement & speaker)
+                pos[n++]    = naive_speaker_to_position(speaker);
+        }
+        return n;
+    }
+} /* namespace */
+
+PTEST_BEGIN("3rdparty.spa", channel_map, 5, 10000)
+
+    void test_arrangement(const char *name, uint64_t arr)
+    {
+        char label[0x40];
+        uint32_t pos[MAX_CHANNELS];
+        size_t count = 0;
+
+        snprintf(label, sizeof(label), "naive %s", name);
+        PTEST_LOOP(label,
+            naive_arrangement(pos, arr);
+        );
+
+        snprintf(label, sizeof(label), "table %s", name);
+        PTEST_LOOP(label,
+            lsp::spa::vst3_arrangement_to_positions(pos, &count, MAX_CHANNELS, arr);
+        );
+
+        PTEST_SEPARATOR;
+    }
+
+    void test_remap(float *buf, size_t channels)
+    {
+        char label[0x40];
+        uint32_t src[MAX_CHANNELS], dst[MAX_CHANNELS], perm[MAX_CHANNELS];
+        float *vsrc[MAX_CHANNELS], *vdst[MAX_CHANNELS];
+        float *tmp = &buf[channels * BUF_SAMPLES];
+
+        for (size_t i=0; i<channels; ++i)
+        {
+            src[i]      = SPA_AUDIO_CHANNEL_AUX0 + i;
+            dst[i]      = SPA_AUDIO_CHANNEL_AUX0 + channels - i - 1;
+            vsrc[i]     = &buf[i * BUF_SAMPLES];
+        }
+        if (lsp::spa::channel_permutation(perm, dst, channels, src, channels) != lsp::STATUS_OK)
+            PTEST_FAIL();
+
+        snprintf(label, sizeof(label), "copy %d ch", int(channels));
+        PTEST_LOOP(label,
+            for (size_t i=0; i<channels; ++i)
+                memcpy(&tmp[i * BUF_SAMPLES], vsrc[perm[i]], BUF_SAMPLES * sizeof(float));
+        );
+
+        snprintf(label, sizeof(label), "permute %d ch", int(channels));
+        PTEST_LOOP(label,
+            lsp::spa::channel_permute(vdst, vsrc, perm, channels, static_cast<float *>(NULL));
+        );
+
+        PTEST_SEPARATOR;
+    }
+
+    PTEST_MAIN
+    {
+        using namespace Steinberg::Vst::SpeakerArr;
+
+        test_arrangement("stereo", kStereo);
+        test_arrangement("5.1", k51);
+        test_arrangement("7.1.4", k71_4);
+        test_arrangement("22.2", k222);
+
+        float *buf = static_cast<float *>(malloc(MAX_CHANNELS * 2 * BUF_SAMPLES * sizeof(float)));
+        if (buf == NULL)
+            PTEST_FAIL();
+        for (size_t i=0; i<MAX_CHANNELS * 2 * BUF_SAMPLES; ++i)
+            buf[i]      = float(rand()) / RAND_MAX;
+
+        test_remap(buf, 2);
+        test_remap(buf, 6);
+        test_remap(buf, 12);
+        test_remap(buf, 24);
+
+        free(buf);
+    }
+
+PTEST_END
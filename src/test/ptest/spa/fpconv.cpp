@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/fpconv.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#include <pw-headers/spa/utils/json-core.h>
+
+#define CORPUS_SIZE         0x10000
+#define TEXT_SIZE           32
+
+PTEST_BEGIN("3rdparty.spa", fpconv, 5, 1000)
+
+    void make_corpus(float *values)
+    {
+        uint32_t seed = 0x12345678;
+
+        for (size_t i=0; i<CORPUS_SIZE; ++i)
+        {
+            seed            = seed * 1664525 + 1013904223;
+            const float r   = float(seed >> 8) / float(1 << 24);
+
+            switch (i % 5)
+            {
+                case 0: values[i] = r;                                  break;  // Normalized value
+                case 1: values[i] = float(seed % 48000);                break;  // Integer value
+                case 2: values[i] = int(r * 7200.0f - 6000.0f) * 0.01f; break;  // Gain in decibels
+                case 3: values[i] = r * 1e-6f;                          break;  // Small value
+                default:
+                {
+                    uint32_t bits   = seed & 0xbfffffffU;                       // Avoid NaN and infinities
+                    memcpy(&values[i], &bits, sizeof(float));
+                    break;
+                }
+            }
+        }
+    }
+
+    void format_spa(char *text, const float *values)
+    {
+        for (size_t i=0; i<CORPUS_SIZE; ++i, text += TEXT_SIZE)
+            spa_json_format_float(text, TEXT_SIZE, values[i]);
+    }
+
+    void format_printf(char *text, const float *values)
+    {
+        for (size_t i=0; i<CORPUS_SIZE; ++i, text += TEXT_SIZE)
+            snprintf(text, TEXT_SIZE, "%.9g", values[i]);
+    }
+
+    void format_float(char *text, const float *values)
+    {
+        for (size_t i=0; i<CORPUS_SIZE; ++i, text += TEXT_SIZE)
+            lsp::spa::format_float(text, TEXT_SIZE, values[i]);
+    }
+
+    void format_double(char *text, const float *values)
+    {
+        for (size_t i=0; i<CORPUS_SIZE; ++i, text += TEXT_SIZE)
+            lsp::spa::format_double(text, TEXT_SIZE, values[i]);
+    }
+
+    void parse_spa(float *values, const char *text)
+    {
+        for (size_t i=0; i<CORPUS_SIZE; ++i, text += TEXT_SIZE)
+            spa_json_parse_float(text, strlen(text), &values[i]);
+    }
+
+    void parse_strtof(float *values, const char *text)
+    {
+        for (size_t i=0; i<CORPUS_SIZE; ++i, text += TEXT_SIZE)
+            values[i] = strtof(text, NULL);
+    }
+
+    void parse_float(float *values, const char *text)
+    {
+        for (size_t i=0; i<CORPUS_SIZE; ++i, text += TEXT_SIZE)
+            lsp::spa::parse_float(text, strlen(text), &values[i]);
+    }
+
+    void parse_double(float *values, const char *text)
+    {
+        double v;
+        for (size_t i=0; i<CORPUS_SIZE; ++i, text += TEXT_SIZE)
+        {
+            lsp::spa::parse_double(text, strlen(text), &v);
+            values[i] = v;
+        }
+    }
+
+    PTEST_MAIN
+    {
+        float *values       = static_cast<float *>(malloc(CORPUS_SIZE * sizeof(float)));
+        float *parsed       = static_cast<float *>(malloc(CORPUS_SIZE * sizeof(float)));
+        char *text          = static_cast<char *>(malloc(CORPUS_SIZE * TEXT_SIZE));
+        if ((values == NULL) || (parsed == NULL) || (text == NULL))
+            PTEST_FAIL();
+
+        make_corpus(values);
+        printf("Converting %d values per call\n", int(CORPUS_SIZE));
+
+        PTEST_LOOP("spa_json_format_float", format_spa(text, values); );
+        PTEST_LOOP("snprintf %.9g", format_printf(text, values); );
+        PTEST_LOOP("format_float", format_float(text, values); );
+        PTEST_LOOP("format_double", format_double(text, values); );
+        PTEST_SEPARATOR;
+
+        format_float(text, values);
+        PTEST_LOOP("spa_json_parse_float", parse_spa(parsed, text); );
+        PTEST_LOOP("strtof", parse_strtof(parsed, text); );
+        PTEST_LOOP("parse_float", parse_float(parsed, text); );
+        PTEST_LOOP("parse_double", parse_double(parsed, text); );
+        PTEST_SEPARATOR;
+
+        free(text);
+        free(parsed);
+        free(values);
+    }
+
+PTEST_END
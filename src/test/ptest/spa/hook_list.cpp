@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/HookList.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define MAX_LISTENERS       256
+
+namespace
+{
+    typedef struct events_t
+    {
+        uint32_t    version;
+        void      (*global)(void *data, uint32_t id, uint32_t permissions, const char *type);
+    } events_t;
+
+    static void on_global(void *data, uint32_t id, uint32_t permissions, const char *type)
+    {
+        size_t *counter     = static_cast<size_t *>(data);
+        *counter           += id + permissions;
+    }
+
+    static const events_t events = { 0, on_global };
+
+    // The cursor of spa_hook_list_call() is initialized with { 0 }
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+    static int spa_emit(struct spa_hook_list *list, uint32_t id)
+    {
+        return spa_hook_list_call(list, events_t, global, 0, id, 0x1ff, "PipeWire:Interface:Node");
+    }
+    #pragma GCC diagnostic pop
+} /* namespace */
+
+PTEST_BEGIN("3rdparty.spa", hook_list, 5, 1000)
+
+    void test_emit(size_t listeners, struct spa_hook *hooks, size_t *counters)
+    {
+        char label[0x40];
+        lsp::spa::HookList list;
+        struct spa_hook_list slist;
+        struct spa_hook *shooks = &hooks[MAX_LISTENERS];
+
+        spa_hook_list_init(&slist);
+        for (size_t i=0; i<listeners; ++i)
+        {
+            if (list.append(&hooks[i], &events, &counters[i]) != lsp::STATUS_OK)
+                PTEST_FAIL();
+            spa_hook_list_append(&slist, &shooks[i], &events, &counters[i]);
+        }
+
+        snprintf(label, sizeof(label), "spa_hook_list_call x%d", int(listeners));
+        PTEST_LOOP(label,
+            spa_emit(&slist, 1);
+        );
+
+        snprintf(label, sizeof(label), "HookList::call x%d", int(listeners));
+        PTEST_LOOP(label,
+            list.call(&events_t::global, 0, uint32_t(1), uint32_t(0x1ff), "PipeWire:Interface:Node");
+        );
+
+        PTEST_SEPARATOR;
+
+        spa_hook_list_clean(&slist);
+        list.clean();
+    }
+
+    PTEST_MAIN
+    {
+        struct spa_hook *hooks = static_cast<struct spa_hook *>(malloc(MAX_LISTENERS * 2 * sizeof(struct spa_hook)));
+        size_t *counters = static_cast<size_t *>(malloc(MAX_LISTENERS * sizeof(size_t)));
+        if ((hooks == NULL) || (counters == NULL))
+            PTEST_FAIL();
+        for (size_t i=0; i<MAX_LISTENERS; ++i)
+            counters[i]     = 0;
+
+        test_emit(1, hooks, counters);
+        test_emit(16, hooks, counters);
+        test_emit(256, hooks, counters);
+
+        free(hooks);
+        free(counters);
+    }
+
+PTEST_END
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/io_snapshot.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define READS_COUNT         1000
+
+PTEST_BEGIN("3rdparty.spa", io_snapshot, 5, 10)
+
+    void read_naive(struct spa_io_position *dst, const struct spa_io_position *src)
+    {
+        for (size_t i=0; i<READS_COUNT; ++i)
+        {
+            memcpy(dst, src, sizeof(struct spa_io_position));
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        }
+    }
+
+    void read_clock(lsp::spa::clock_snapshot_t *dst, const struct spa_io_position *src)
+    {
+        for (size_t i=0; i<READS_COUNT; ++i)
+        {
+            if (lsp::spa::read_clock(dst, &src->clock) != lsp::STATUS_OK)
+                PTEST_FAIL();
+        }
+    }
+
+    void read_position(lsp::spa::position_snapshot_t *dst, const struct spa_io_position *src)
+    {
+        for (size_t i=0; i<READS_COUNT; ++i)
+        {
+            if (lsp::spa::read_position(dst, src) != lsp::STATUS_OK)
+                PTEST_FAIL();
+        }
+    }
+
+    PTEST_MAIN
+    {
+        struct spa_io_position *pos = static_cast<struct spa_io_position *>(malloc(sizeof(struct spa_io_position)));
+        struct spa_io_position *raw = static_cast<struct spa_io_position *>(malloc(sizeof(struct spa_io_position)));
+        if ((pos == NULL) || (raw == NULL))
+            PTEST_FAIL();
+
+        memset(pos, 0, sizeof(*pos));
+        pos->clock.rate             = SPA_FRACTION(1, 48000);
+        pos->clock.duration         = 1024;
+        pos->clock.rate_diff        = 1.0;
+        pos->state                  = SPA_IO_POSITION_STATE_RUNNING;
+        pos->n_segments             = 1;
+        pos->segments[0].rate       = 1.0;
+        pos->segments[0].bar.flags  = SPA_IO_SEGMENT_BAR_FLAG_VALID;
+        pos->segments[0].bar.signature_num      = 4.0f;
+        pos->segments[0].bar.signature_denom    = 4.0f;
+        pos->segments[0].bar.bpm                = 120.0;
+        pos->segments[0].bar.ticks_per_beat     = 1920.0;
+
+        lsp::spa::clock_snapshot_t cs;
+        lsp::spa::position_snapshot_t ps;
+        char label[0x40];
+
+        snprintf(label, sizeof(label), "memcpy spa_io_position x %d", READS_COUNT);
+        PTEST_LOOP(label, read_naive(raw, pos); );
+        snprintf(label, sizeof(label), "read_clock x %d", READS_COUNT);
+        PTEST_LOOP(label, read_clock(&cs, pos); );
+        snprintf(label, sizeof(label), "read_position x %d", READS_COUNT);
+        PTEST_LOOP(label, read_position(&ps, pos); );
+        PTEST_SEPARATOR;
+
+        free(pos);
+        free(raw);
+    }
+
+PTEST_END
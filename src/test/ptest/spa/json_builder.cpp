@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#include <pw-headers/spa/utils/json-builder.h>
+
+#define REGISTRY_OBJECTS        50000
+#define FIXED_BUFFER_SIZE       (64 * 1024 * 1024)
+
+PTEST_BEGIN("3rdparty.spa", json_builder, 5, 10)
+
+    static void dump_registry(struct spa_json_builder *b)
+    {
+        char name[0x80];
+
+        spa_json_builder_array_push(b, "[");
+        for (int i=0; i<REGISTRY_OBJECTS; ++i)
+        {
+            snprintf(name, sizeof(name), "alsa_output.pci-0000_00_1f.%d.analog-stereo", i);
+
+            spa_json_builder_array_push(b, "{");
+            spa_json_builder_object_int(b, "id", i);
+            spa_json_builder_object_string(b, "type", "PipeWire:Interface:Node");
+            spa_json_builder_object_int(b, "version", 3);
+            spa_json_builder_object_push(b, "permissions", "[");
+            spa_json_builder_array_string(b, "r");
+            spa_json_builder_array_string(b, "w");
+            spa_json_builder_array_string(b, "x");
+            spa_json_builder_array_string(b, "m");
+            spa_json_builder_pop(b, "]");
+            spa_json_builder_object_push(b, "info", "{");
+            spa_json_builder_object_int(b, "max-input-ports", 0);
+            spa_json_builder_object_int(b, "max-output-ports", 2);
+            spa_json_builder_object_string(b, "state", (i & 1) ? "running" : "suspended");
+            spa_json_builder_object_push(b, "props", "{");
+            spa_json_builder_object_string(b, "node.name", name);
+            spa_json_builder_object_string(b, "node.description", "Built-in Audio \"Analog\" Stereo");
+            spa_json_builder_object_string(b, "media.class", "Audio/Sink");
+            spa_json_builder_object_string(b, "api.alsa.path", "front:0");
+            spa_json_builder_object_int(b, "priority.session", 1009);
+            spa_json_builder_object_bool(b, "node.pause-on-idle", false);
+            spa_json_builder_object_uint(b, "object.serial", 100000 + i);
+            spa_json_builder_pop(b, "}");
+            spa_json_builder_pop(b, "}");
+            spa_json_builder_pop(b, "}");
+        }
+        spa_json_builder_pop(b, "]");
+    }
+
+    void dump_memstream(uint32_t flags)
+    {
+        struct spa_json_builder b;
+        char *mem = NULL;
+        size_t size = 0;
+
+        if (spa_json_builder_memstream(&b, &mem, &size, flags) < 0)
+            return;
+        dump_registry(&b);
+        spa_json_builder_close(&b);
+        free(mem);
+    }
+
+    void dump_buffer(uint32_t flags)
+    {
+        struct spa_json_builder b;
+        char *mem = NULL;
+        size_t size = 0;
+
+        spa_json_builder_buffer(&b, &mem, &size, flags);
+        dump_registry(&b);
+        spa_json_builder_close(&b);
+        free(mem);
+    }
+
+    void dump_fixed(char *buf, uint32_t flags)
+    {
+        struct spa_json_builder b;
+
+        spa_json_builder_buffer_fixed(&b, buf, FIXED_BUFFER_SIZE, flags);
+        dump_registry(&b);
+        spa_json_builder_close(&b);
+    }
+
+    PTEST_MAIN
+    {
+        static const uint32_t flags[] = { 0, SPA_JSON_BUILDER_FLAG_PRETTY };
+        static const char *flag_names[] = { "compact", "pretty" };
+
+        char *buf = static_cast<char *>(malloc(FIXED_BUFFER_SIZE));
+        if (buf == NULL)
+            PTEST_FAIL();
+
+        char label[0x40];
+        printf("Dumping registry of %d objects per call\n", REGISTRY_OBJECTS);
+
+        for (size_t i=0; i<sizeof(flags)/sizeof(flags[0]); ++i)
+        {
+            snprintf(label, sizeof(label), "memstream %s", flag_names[i]);
+            PTEST_LOOP(label, dump_memstream(flags[i]); );
+            snprintf(label, sizeof(label), "buffer %s", flag_names[i]);
+            PTEST_LOOP(label, dump_buffer(flags[i]); );
+            snprintf(label, sizeof(label), "fixed buffer %s", flag_names[i]);
+            PTEST_LOOP(label, dump_fixed(buf, flags[i]); );
+            PTEST_SEPARATOR;
+        }
+
+        free(buf);
+    }
+
+PTEST_END
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/JsonPodParser.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#include <pw-headers/spa/param/param-types.h>
+#include <pw-headers/spa/utils/json-pod.h>
+
+#define DOCUMENT_ENTRIES        100000
+#define BUILDER_SIZE            (32 * 1024 * 1024)
+
+PTEST_BEGIN("3rdparty.spa", json_pod_parser, 5, 10)
+
+    char *make_document(size_t *size)
+    {
+        const size_t cap    = DOCUMENT_ENTRIES * 0x80;
+        char *doc           = static_cast<char *>(malloc(cap));
+        if (doc == NULL)
+            return NULL;
+
+        size_t len = snprintf(doc, cap, "{\n  \"volume\": 0.5,\n  \"mute\": false,\n  \"params\": [\n");
+        for (size_t i=0; (i<DOCUMENT_ENTRIES) && (len < cap - 0x100); ++i)
+        {
+            switch (i % 4)
+            {
+                case 0:
+                    len += snprintf(&doc[len], cap - len, "    \"filter.graph.node%d.gain\", %d.25,\n", int(i), int(i % 1000));
+                    break;
+                case 1:
+                    len += snprintf(&doc[len], cap - len, "    \"filter.graph.node%d.name\", \"convolver \\\"%d\\\"\",\n", int(i), int(i));
+                    break;
+                case 2:
+                    len += snprintf(&doc[len], cap - len, "    \"filter.graph.node%d.ir\", [ %d, %d, %d, %d ],\n", int(i), int(i), int(i+1), int(i+2), int(i+3));
+                    break;
+                default:
+                    len += snprintf(&doc[len], cap - len, "    \"filter.graph.node%d.enabled\", true,\n", int(i));
+                    break;
+            }
+        }
+        len += snprintf(&doc[len], cap - len, "  ]\n}\n");
+
+        *size = len;
+        return doc;
+    }
+
+    void parse_spa(struct spa_pod_builder *b, uint8_t *buf, const char *doc, size_t len)
+    {
+        spa_pod_builder_init(b, buf, BUILDER_SIZE);
+        spa_json_to_pod(b, 0, &spa_type_param[SPA_PARAM_Props], doc, len);
+    }
+
+    void parse_stream(lsp::spa::JsonPodParser *p, struct spa_pod_builder *b, uint8_t *buf, const char *doc, size_t len, size_t chunk)
+    {
+        spa_pod_builder_init(b, buf, BUILDER_SIZE);
+        p->begin(b, &spa_type_param[SPA_PARAM_Props]);
+        for (size_t off = 0; off < len; off += chunk)
+            p->parse(&doc[off], lsp_min(chunk, len - off));
+        p->end();
+    }
+
+    PTEST_MAIN
+    {
+        static const size_t chunks[] = { 0x100, 0x1000, 0x10000 };
+
+        size_t len          = 0;
+        char *doc           = make_document(&len);
+        uint8_t *buf        = static_cast<uint8_t *>(malloc(BUILDER_SIZE));
+        if ((doc == NULL) || (buf == NULL))
+            PTEST_FAIL();
+
+        struct spa_pod_builder b;
+        lsp::spa::JsonPodParser p;
+        if (p.init() != lsp::STATUS_OK)
+            PTEST_FAIL();
+
+        char label[0x40];
+        printf("Converting document of %.2f MB, multiply calls/s by document size to get MB/s\n", double(len) / (1024.0 * 1024.0));
+
+        PTEST_LOOP("spa_json_to_pod", parse_spa(&b, buf, doc, len); );
+        for (size_t i=0; i<sizeof(chunks)/sizeof(chunks[0]); ++i)
+        {
+            snprintf(label, sizeof(label), "JsonPodParser chunk=%d", int(chunks[i]));
+            PTEST_LOOP(label, parse_stream(&p, &b, buf, doc, len, chunks[i]); );
+        }
+        PTEST_LOOP("JsonPodParser whole", parse_stream(&p, &b, buf, doc, len, len); );
+        PTEST_SEPARATOR;
+
+        p.destroy();
+        free(buf);
+        free(doc);
+    }
+
+PTEST_END
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#include <pw-headers/spa/utils/json-core.h>
+
+#define STRING_COUNT            3
+#define BLOB_LENGTH             4096
+#define BUFFER_SIZE             (BLOB_LENGTH * 6 + 8)
+
+PTEST_BEGIN("3rdparty.spa", json_string, 5, 100000)
+
+    void encode(char **dst, int *len, char **src)
+    {
+        for (size_t i=0; i<STRING_COUNT; ++i)
+            len[i] = spa_json_encode_string(dst[i], BUFFER_SIZE, src[i]);
+    }
+
+    void parse(char *dst, char **src, const int *len)
+    {
+        for (size_t i=0; i<STRING_COUNT; ++i)
+            spa_json_parse_stringn(src[i], len[i], dst, BUFFER_SIZE);
+    }
+
+    PTEST_MAIN
+    {
+        static const char *base64 = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        char *src[STRING_COUNT];
+        char *enc[STRING_COUNT];
+        int len[STRING_COUNT];
+        char *buf = static_cast<char *>(malloc(BUFFER_SIZE * (STRING_COUNT * 2 + 1)));
+        if (buf == NULL)
+            PTEST_FAIL();
+        for (size_t i=0; i<STRING_COUNT; ++i)
+        {
+            src[i]  = &buf[BUFFER_SIZE * i];
+            enc[i]  = &buf[BUFFER_SIZE * (STRING_COUNT + i)];
+        }
+        char *out = &buf[BUFFER_SIZE * STRING_COUNT * 2];
+
+        // Typical metadata values
+        strcpy(src[0], "Firefox - \"Live concert\" - very long media name with many words in it, 1080p60 HDR");
+        strcpy(src[1], "/usr/lib/x86_64-linux-gnu/pipewire-0.3/jack/libjack.so.0.3.1200\t--name \"My App\"");
+        for (size_t i=0; i<BLOB_LENGTH; ++i)
+            src[2][i] = base64[(i * 7) % 64];
+        src[2][BLOB_LENGTH] = '\0';
+
+        encode(enc, len, src);
+        size_t total = 0;
+        for (size_t i=0; i<STRING_COUNT; ++i)
+            total  += len[i];
+        printf("Processing %d bytes of encoded strings per call\n", int(total));
+
+        PTEST_LOOP("spa_json_encode_string", encode(enc, len, src); );
+        PTEST_LOOP("spa_json_parse_stringn", parse(out, enc, len); );
+        PTEST_SEPARATOR;
+
+        free(buf);
+    }
+
+PTEST_END
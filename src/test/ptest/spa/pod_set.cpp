@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/pod_hash.h>
+#include <lsp-plug.in/3rdparty/spa/PodSet.h>
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#include <pw-headers/spa/param/format.h>
+#include <pw-headers/spa/param/audio/raw.h>
+#include <pw-headers/spa/pod/builder.h>
+#include <pw-headers/spa/pod/compare.h>
+
+#define PARAMS_COUNT        10000
+#define UNIQUE_COUNT        256
+
+PTEST_BEGIN("3rdparty.spa", pod_set, 5, 10)
+
+    void build_params(struct spa_pod_builder *b, const struct spa_pod **vp, size_t count)
+    {
+        static const uint32_t fmts[] = { SPA_AUDIO_FORMAT_F32, SPA_AUDIO_FORMAT_S16, SPA_AUDIO_FORMAT_S24, SPA_AUDIO_FORMAT_S32 };
+        struct spa_pod_frame of, cf;
+
+        for (size_t i=0; i<count; ++i)
+        {
+            const size_t key = (i * 7919) % UNIQUE_COUNT;
+
+            spa_pod_builder_push_object(b, &of, SPA_TYPE_OBJECT_Format, SPA_PARAM_EnumFormat);
+            spa_pod_builder_prop(b, SPA_FORMAT_mediaType, 0);
+            spa_pod_builder_id(b, SPA_MEDIA_TYPE_audio);
+            spa_pod_builder_prop(b, SPA_FORMAT_mediaSubtype, 0);
+            spa_pod_builder_id(b, SPA_MEDIA_SUBTYPE_raw);
+            spa_pod_builder_prop(b, SPA_FORMAT_AUDIO_format, 0);
+            spa_pod_builder_push_choice(b, &cf, SPA_CHOICE_Enum, 0);
+            for (size_t j=0; j<=4; ++j)
+                spa_pod_builder_id(b, fmts[(key + j) & 3]);
+            spa_pod_builder_pop(b, &cf);
+            spa_pod_builder_prop(b, SPA_FORMAT_AUDIO_rate, 0);
+            spa_pod_builder_push_choice(b, &cf, SPA_CHOICE_Range, 0);
+            spa_pod_builder_int(b, 48000);
+            spa_pod_builder_int(b, 1);
+            spa_pod_builder_int(b, 384000);
+            spa_pod_builder_pop(b, &cf);
+            spa_pod_builder_prop(b, SPA_FORMAT_AUDIO_channels, 0);
+            spa_pod_builder_int(b, key + 1);
+            vp[i] = static_cast<const struct spa_pod *>(spa_pod_builder_pop(b, &of));
+        }
+    }
+
+    size_t dedup_compare(const struct spa_pod **dst, const struct spa_pod * const *src, size_t count)
+    {
+        size_t n = 0;
+        for (size_t i=0; i<count; ++i)
+        {
+            size_t j = 0;
+            for ( ; j<n; ++j)
+                if (spa_pod_compare(dst[j], src[i]) == 0)
+                    break;
+            if (j >= n)
+                dst[n++] = src[i];
+        }
+        return n;
+    }
+
+    size_t dedup_equals(const struct spa_pod **dst, const struct spa_pod * const *src, size_t count)
+    {
+        size_t n = 0;
+        for (size_t i=0; i<count; ++i)
+        {
+            size_t j = 0;
+            for ( ; j<n; ++j)
+                if (lsp::spa::pod_equals(dst[j], src[i]))
+                    break;
+            if (j >= n)
+                dst[n++] = src[i];
+        }
+        return n;
+    }
+
+    size_t dedup_set(lsp::spa::PodSet *set, const struct spa_pod * const *src, size_t count)
+    {
+        set->clear();
+        for (size_t i=0; i<count; ++i)
+            set->insert(src[i]);
+        return set->size();
+    }
+
+    uint64_t hash_all(const struct spa_pod * const *src, size_t count)
+    {
+        uint64_t res = 0;
+        for (size_t i=0; i<count; ++i)
+            res    ^= lsp::spa::pod_hash(src[i]);
+        return res;
+    }
+
+    PTEST_MAIN
+    {
+        const size_t buf_size   = PARAMS_COUNT * 0x100;
+        uint8_t *data           = NULL;
+        uint8_t *buf            = lsp::alloc_aligned<uint8_t>(data, buf_size, 0x40);
+        const struct spa_pod **vp   = static_cast<const struct spa_pod **>(malloc(sizeof(struct spa_pod *) * PARAMS_COUNT * 2));
+        if ((buf == NULL) || (vp == NULL))
+            PTEST_FAIL();
+        const struct spa_pod **vu   = &vp[PARAMS_COUNT];
+        lsp::spa::PodSet set;
+
+        struct spa_pod_builder b;
+        spa_pod_builder_init(&b, buf, buf_size);
+        build_params(&b, vp, PARAMS_COUNT);
+
+        if ((dedup_compare(vu, vp, PARAMS_COUNT) != UNIQUE_COUNT) ||
+            (dedup_equals(vu, vp, PARAMS_COUNT) != UNIQUE_COUNT) ||
+            (dedup_set(&set, vp, PARAMS_COUNT) != UNIQUE_COUNT))
+            PTEST_FAIL();
+
+        char label[0x40];
+        printf("Deduplicating %d parameters with %d unique values\n", PARAMS_COUNT, UNIQUE_COUNT);
+
+        snprintf(label, sizeof(label), "spa_pod_compare x %d", PARAMS_COUNT);
+        PTEST_LOOP(label, dedup_compare(vu, vp, PARAMS_COUNT); );
+        snprintf(label, sizeof(label), "pod_equals x %d", PARAMS_COUNT);
+        PTEST_LOOP(label, dedup_equals(vu, vp, PARAMS_COUNT); );
+        snprintf(label, sizeof(label), "pod_hash x %d", PARAMS_COUNT);
+        PTEST_LOOP(label, hash_all(vp, PARAMS_COUNT); );
+        snprintf(label, sizeof(label), "PodSet x %d", PARAMS_COUNT);
+        PTEST_LOOP(label, dedup_set(&set, vp, PARAMS_COUNT); );
+        PTEST_SEPARATOR;
+
+        set.flush();
+        free(vp);
+        lsp::free_aligned(data);
+    }
+
+PTEST_END
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/RateLimiter.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#include <pw-headers/spa/utils/ratelimit.h>
+
+#define MAX_THREADS         3
+#define NUM_SOURCES         256
+#define INTERVAL            1000000000ULL
+
+namespace
+{
+    class Emitter: public lsp::ipc::Thread
+    {
+        public:
+            lsp::spa::RateLimiter  *pLimiter;
+            size_t                  nKeys;
+            volatile bool           bStop;
+
+        public:
+            explicit Emitter(lsp::spa::RateLimiter *limiter, size_t keys)
+            {
+                pLimiter    = limiter;
+                nKeys       = keys;
+                bStop       = false;
+            }
+
+            virtual lsp::status_t run() override
+            {
+                for (uint64_t i=0; !bStop; ++i)
+                    pLimiter->test(i % nKeys, i * 1000);
+                return lsp::STATUS_OK;
+            }
+    };
+} /* namespace */
+
+PTEST_BEGIN("3rdparty.spa", rate_limiter, 5, 10000)
+
+    void test_limiter(size_t keys, size_t threads)
+    {
+        char label[0x40];
+        lsp::spa::RateLimiter rl;
+        if (rl.init(NUM_SOURCES * 2, INTERVAL, 10) != lsp::STATUS_OK)
+            PTEST_FAIL();
+
+        Emitter *emitters[MAX_THREADS];
+        for (size_t i=0; i<threads; ++i)
+        {
+            emitters[i] = new Emitter(&rl, keys);
+            if ((emitters[i] == NULL) || (emitters[i]->start() != lsp::STATUS_OK))
+                PTEST_FAIL();
+        }
+
+        uint64_t ts = 0;
+        snprintf(label, sizeof(label), "RateLimiter %d keys %d threads", int(keys), int(threads + 1));
+        PTEST_LOOP(label,
+            rl.test(ts % keys, ts * 1000);
+            ++ts;
+        );
+
+        for (size_t i=0; i<threads; ++i)
+        {
+            emitters[i]->bStop  = true;
+            emitters[i]->join();
+            delete emitters[i];
+        }
+    }
+
+    PTEST_MAIN
+    {
+        // Baseline: single spa_ratelimit for all sources
+        struct spa_ratelimit ref;
+        memset(&ref, 0, sizeof(ref));
+        ref.interval    = INTERVAL;
+        ref.burst       = 10;
+
+        uint64_t ts = 0;
+        PTEST_LOOP("spa_ratelimit_test",
+            spa_ratelimit_test(&ref, ts * 1000);
+            ++ts;
+        );
+        PTEST_SEPARATOR;
+
+        for (size_t threads=0; threads<=MAX_THREADS; ++threads)
+        {
+            test_limiter(1, threads);
+            test_limiter(NUM_SOURCES, threads);
+            PTEST_SEPARATOR;
+        }
+    }
+
+PTEST_END
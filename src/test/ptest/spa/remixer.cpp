@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/Remixer.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define MAX_CHANNELS        12
+#define MAX_SAMPLES         192000
+
+namespace
+{
+    static const uint32_t pos_stereo[]  = { SPA_AUDIO_CHANNEL_FL, SPA_AUDIO_CHANNEL_FR };
+    static const uint32_t pos_5_1[]     =
+    {
+        SPA_AUDIO_CHANNEL_FL, SPA_AUDIO_CHANNEL_FR, SPA_AUDIO_CHANNEL_FC,
+        SPA_AUDIO_CHANNEL_LFE, SPA_AUDIO_CHANNEL_SL, SPA_AUDIO_CHANNEL_SR
+    };
+    static const uint32_t pos_7_1_4[]   =
+    {
+        SPA_AUDIO_CHANNEL_FL, SPA_AUDIO_CHANNEL_FR, SPA_AUDIO_CHANNEL_FC, SPA_AUDIO_CHANNEL_LFE,
+        SPA_AUDIO_CHANNEL_SL, SPA_AUDIO_CHANNEL_SR, SPA_AUDIO_CHANNEL_RL, SPA_AUDIO_CHANNEL_RR,
+        SPA_AUDIO_CHANNEL_TFL, SPA_AUDIO_CHANNEL_TFR, SPA_AUDIO_CHANNEL_TRL, SPA_AUDIO_CHANNEL_TRR
+    };
+} /* namespace */
+
+PTEST_BEGIN("3rdparty.spa", remixer, 5, 10)
+
+    void naive(const lsp::spa::Remixer *r, float * const *dst, const float * const *src, size_t samples)
+    {
+        const size_t nd = r->dst_channels(), ns = r->src_channels();
+        const float *m  = r->matrix();
+
+        for (size_t i=0; i<nd; ++i)
+        {
+            float *d        = dst[i];
+            const float *k  = &m[i * ns];
+            for (size_t j=0; j<samples; ++j)
+            {
+                float v         = 0.0f;
+                for (size_t l=0; l<ns; ++l)
+                    v              += src[l][j] * k[l];
+                d[j]            = v;
+            }
+        }
+    }
+
+    void test_remix(const char *name, const uint32_t *dpos, size_t nd, const uint32_t *spos, size_t ns,
+        size_t flags, float * const *dst, const float * const *src)
+    {
+        lsp::spa::Remixer r;
+        if (r.init(dpos, nd, spos, ns, flags) != lsp::STATUS_OK)
+            PTEST_FAIL();
+
+        static const size_t samples[] = { 1024, 48000, MAX_SAMPLES };
+        char label[0x40];
+        for (size_t i=0; i<sizeof(samples)/sizeof(samples[0]); ++i)
+        {
+            const size_t n = samples[i];
+            snprintf(label, sizeof(label), "naive %s x %d", name, int(n));
+            PTEST_LOOP(label, naive(&r, dst, src, n); );
+            snprintf(label, sizeof(label), "Remixer %s x %d", name, int(n));
+            PTEST_LOOP(label, r.process(dst, src, n); );
+        }
+        PTEST_SEPARATOR;
+    }
+
+    PTEST_MAIN
+    {
+        float *src[MAX_CHANNELS], *dst[MAX_CHANNELS];
+        for (size_t i=0; i<MAX_CHANNELS; ++i)
+        {
+            src[i]          = static_cast<float *>(malloc(MAX_SAMPLES * sizeof(float)));
+            dst[i]          = static_cast<float *>(malloc(MAX_SAMPLES * sizeof(float)));
+            if ((src[i] == NULL) || (dst[i] == NULL))
+                PTEST_FAIL();
+            for (size_t j=0; j<MAX_SAMPLES; ++j)
+                src[i][j]       = float(rand()) / float(RAND_MAX) - 0.5f;
+        }
+
+        test_remix("7.1.4->2.0", pos_stereo, 2, pos_7_1_4, 12, lsp::spa::Remixer::F_NORMALIZE, dst, src);
+        test_remix("2.0->5.1", pos_5_1, 6, pos_stereo, 2, lsp::spa::Remixer::F_UPMIX, dst, src);
+
+        for (size_t i=0; i<MAX_CHANNELS; ++i)
+        {
+            free(src[i]);
+            free(dst[i]);
+        }
+    }
+
+PTEST_END
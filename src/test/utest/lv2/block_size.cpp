@@ -0,0 +1,286 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/BlockDispatcher.h>
+#include <lsp-plug.in/3rdparty/lv2/block_size.h>
+#include <lsp-plug.in/3rdparty/lv2/UridMap.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <lv2/atom/atom.h>
+#include <lv2/buf-size/buf-size.h>
+#include <lv2/parameters/parameters.h>
+
+#define MAX_CALLS           64
+
+namespace
+{
+    class Plugin
+    {
+        public:
+            uint32_t    vOffsets[MAX_CALLS];
+            uint32_t    vSamples[MAX_CALLS];
+            uint32_t    vLengths[MAX_CALLS];
+            size_t      nCalls;
+
+        public:
+            explicit Plugin()
+            {
+                nCalls      = 0;
+            }
+
+            template <uint32_t N>
+            void process(uint32_t offset, uint32_t samples)
+            {
+                if (nCalls >= MAX_CALLS)
+                    return;
+                vOffsets[nCalls]    = offset;
+                vSamples[nCalls]    = samples;
+                vLengths[nCalls]    = N;
+                ++nCalls;
+            }
+    };
+
+    class Options
+    {
+        public:
+            lsp::lv2::UridMap       sMap;
+            LV2_Options_Option      vOptions[8];
+            int32_t                 vInts[8];
+            float                   fSampleRate;
+            const LV2_Feature      *vFeatures[8];
+            LV2_Feature             vItems[8];
+            size_t                  nOptions;
+            size_t                  nFeatures;
+
+        public:
+            explicit Options()
+            {
+                sMap.init();
+                nOptions    = 0;
+                nFeatures   = 0;
+                fSampleRate = 0.0f;
+                vFeatures[0] = NULL;
+                finish();
+            }
+
+            void add_int(const char *key, int32_t value)
+            {
+                LV2_Options_Option *opt = &vOptions[nOptions];
+                vInts[nOptions]     = value;
+                opt->context        = LV2_OPTIONS_INSTANCE;
+                opt->subject        = 0;
+                opt->key            = sMap.map(key);
+                opt->size           = sizeof(int32_t);
+                opt->type           = sMap.map(LV2_ATOM__Int);
+                opt->value          = &vInts[nOptions];
+                ++nOptions;
+                finish();
+            }
+
+            void add_sample_rate(float value)
+            {
+                LV2_Options_Option *opt = &vOptions[nOptions];
+                fSampleRate         = value;
+                opt->context        = LV2_OPTIONS_INSTANCE;
+                opt->subject        = 0;
+                opt->key            = sMap.map(LV2_PARAMETERS__sampleRate);
+                opt->size           = sizeof(float);
+                opt->type           = sMap.map(LV2_ATOM__Float);
+                opt->value          = &fSampleRate;
+                ++nOptions;
+                finish();
+            }
+
+            void add_feature(const char *uri, void *data = NULL)
+            {
+                LV2_Feature *f      = &vItems[nFeatures];
+                f->URI              = uri;
+                f->data             = data;
+                vFeatures[nFeatures++]  = f;
+                vFeatures[nFeatures]    = NULL;
+            }
+
+            void finish()
+            {
+                memset(&vOptions[nOptions], 0, sizeof(LV2_Options_Option));
+            }
+
+            void add_standard()
+            {
+                add_feature(LV2_URID__map, sMap.map_feature());
+                add_feature(LV2_OPTIONS__options, vOptions);
+            }
+    };
+} /* namespace */
+
+UTEST_BEGIN("3rdparty.lv2", block_size)
+
+    void test_parse()
+    {
+        printf("Testing block size contract...\n");
+
+        lsp::lv2::block_size_t bs;
+        UTEST_ASSERT(lsp::lv2::block_size_parse(NULL, NULL) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(lsp::lv2::block_size_parse(&bs, NULL) == lsp::STATUS_OK);
+        UTEST_ASSERT(bs.flags == 0);
+        UTEST_ASSERT(bs.max_length == 0);
+        UTEST_ASSERT(lsp::lv2::block_size_quantum(&bs) == 0);
+
+        // Bounded block length, options only
+        {
+            Options o;
+            o.add_int(LV2_BUF_SIZE__minBlockLength, 16);
+            o.add_int(LV2_BUF_SIZE__maxBlockLength, 4096);
+            o.add_int(LV2_BUF_SIZE__nominalBlockLength, 1024);
+            o.add_int(LV2_BUF_SIZE__sequenceSize, 0x8000);
+            o.add_int(LV2_ATOM__Int, 123);
+            o.add_sample_rate(48000.0f);
+            o.add_standard();
+            o.add_feature(LV2_BUF_SIZE__boundedBlockLength);
+
+            UTEST_ASSERT(lsp::lv2::block_size_parse(&bs, o.vFeatures) == lsp::STATUS_OK);
+            UTEST_ASSERT(bs.flags == lsp::lv2::BLOCK_BOUNDED);
+            UTEST_ASSERT(bs.min_length == 16);
+            UTEST_ASSERT(bs.max_length == 4096);
+            UTEST_ASSERT(bs.nominal_length == 1024);
+            UTEST_ASSERT(bs.sequence_size == 0x8000);
+            UTEST_ASSERT(bs.sample_rate == 48000.0f);
+            UTEST_ASSERT(lsp::lv2::block_size_quantum(&bs) == 0);
+
+            // Options without the map are ignored
+            UTEST_ASSERT(lsp::lv2::block_size_parse_options(&bs, o.vOptions, NULL) == lsp::STATUS_BAD_ARGUMENTS);
+            lsp::lv2::block_size_reset(&bs);
+            UTEST_ASSERT(lsp::lv2::block_size_parse_options(&bs, NULL, o.sMap.map_feature()) == lsp::STATUS_OK);
+            UTEST_ASSERT(bs.max_length == 0);
+            UTEST_ASSERT(lsp::lv2::block_size_parse_options(&bs, o.vOptions, o.sMap.map_feature()) == lsp::STATUS_OK);
+            UTEST_ASSERT(bs.max_length == 4096);
+        }
+
+        // Fixed block length completed from the maximum length
+        {
+            Options o;
+            o.add_int(LV2_BUF_SIZE__maxBlockLength, 128);
+            o.add_standard();
+            o.add_feature(LV2_BUF_SIZE__fixedBlockLength);
+
+            UTEST_ASSERT(lsp::lv2::block_size_parse(&bs, o.vFeatures) == lsp::STATUS_OK);
+            UTEST_ASSERT(bs.flags == lsp::lv2::BLOCK_FIXED);
+            UTEST_ASSERT(bs.min_length == 128);
+            UTEST_ASSERT(bs.max_length == 128);
+            UTEST_ASSERT(bs.nominal_length == 128);
+            UTEST_ASSERT(lsp::lv2::block_size_quantum(&bs) == 128);
+        }
+
+        // Power of 2 block length
+        {
+            Options o;
+            o.add_int(LV2_BUF_SIZE__minBlockLength, 64);
+            o.add_int(LV2_BUF_SIZE__maxBlockLength, 2048);
+            o.add_standard();
+            o.add_feature(LV2_BUF_SIZE__powerOf2BlockLength);
+            o.add_feature(LV2_BUF_SIZE__coarseBlockLength);
+
+            UTEST_ASSERT(lsp::lv2::block_size_parse(&bs, o.vFeatures) == lsp::STATUS_OK);
+            UTEST_ASSERT(bs.flags == (lsp::lv2::BLOCK_POWER_OF_2 | lsp::lv2::BLOCK_COARSE));
+            UTEST_ASSERT(lsp::lv2::block_size_quantum(&bs) == 64);
+        }
+
+        // Contradicting guarantees are dropped
+        {
+            Options o;
+            o.add_int(LV2_BUF_SIZE__minBlockLength, 64);
+            o.add_int(LV2_BUF_SIZE__maxBlockLength, 1000);
+            o.add_standard();
+            o.add_feature(LV2_BUF_SIZE__powerOf2BlockLength);
+            o.add_feature(LV2_BUF_SIZE__fixedBlockLength);
+            o.add_feature(LV2_BUF_SIZE__boundedBlockLength);
+
+            UTEST_ASSERT(lsp::lv2::block_size_parse(&bs, o.vFeatures) == lsp::STATUS_BAD_FORMAT);
+            UTEST_ASSERT(bs.flags == lsp::lv2::BLOCK_BOUNDED);
+            UTEST_ASSERT(lsp::lv2::block_size_quantum(&bs) == 0);
+        }
+
+        // Fixed block length without any length
+        {
+            Options o;
+            o.add_feature(LV2_BUF_SIZE__fixedBlockLength);
+            UTEST_ASSERT(lsp::lv2::block_size_parse(&bs, o.vFeatures) == lsp::STATUS_BAD_FORMAT);
+            UTEST_ASSERT(bs.flags == 0);
+        }
+    }
+
+    void test_dispatch()
+    {
+        printf("Testing block dispatcher...\n");
+
+        Plugin p;
+        lsp::lv2::BlockDispatcher<Plugin> d;
+        UTEST_ASSERT(d.block_length() == 0);
+
+        // Generic routine
+        d.run(&p, 100);
+        UTEST_ASSERT(p.nCalls == 1);
+        UTEST_ASSERT((p.vOffsets[0] == 0) && (p.vSamples[0] == 100) && (p.vLengths[0] == 0));
+
+        // Selection of routines
+        UTEST_ASSERT(d.select(uint32_t(0)) == 0);
+        UTEST_ASSERT(d.select(48) == 0);
+        UTEST_ASSERT(d.select(32) == 32);
+        UTEST_ASSERT(d.select(96) == 32);
+        UTEST_ASSERT(d.select(64) == 64);
+        UTEST_ASSERT(d.select(384) == 128);
+        UTEST_ASSERT(d.select(256) == 256);
+        UTEST_ASSERT(d.select(4096) == 256);
+        UTEST_ASSERT(d.block_length() == 256);
+
+        lsp::lv2::block_size_t bs;
+        lsp::lv2::block_size_reset(&bs);
+        bs.flags        = lsp::lv2::BLOCK_FIXED;
+        bs.max_length   = 192;
+        UTEST_ASSERT(d.select(&bs) == 64);
+
+        // Blocks are split into fixed-length parts
+        p.nCalls = 0;
+        d.run(&p, 192);
+        UTEST_ASSERT(p.nCalls == 3);
+        for (size_t i=0; i<3; ++i)
+        {
+            UTEST_ASSERT(p.vOffsets[i] == i * 64);
+            UTEST_ASSERT(p.vSamples[i] == 64);
+            UTEST_ASSERT(p.vLengths[i] == 64);
+        }
+
+        // Blocks breaking the guarantee fall back to the generic routine
+        p.nCalls = 0;
+        d.run(&p, 100);
+        UTEST_ASSERT(p.nCalls == 1);
+        UTEST_ASSERT((p.vOffsets[0] == 0) && (p.vSamples[0] == 100) && (p.vLengths[0] == 0));
+    }
+
+    UTEST_MAIN
+    {
+        test_parse();
+        test_dispatch();
+    }
+
+UTEST_END
@@ -0,0 +1,496 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/DeferredLog.h>
+#include <lsp-plug.in/3rdparty/lv2/UridMap.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <lv2/log/logger.h>
+
+#include <stdarg.h>
+
+#define MAX_MESSAGES        0x100
+#define RT_ITERATIONS       1000
+
+#ifdef __linux__
+    #define TRACK_WRITE_CALLS
+    #define GUARD_PAGES
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif /* __linux__ */
+
+namespace
+{
+    // Counters of forbidden calls made by the realtime thread:
+    // calls of the methods which are not realtime-safe are counted by the log itself,
+    // write() system calls are read from procfs
+    static ssize_t              rt_unsafe   = 0;
+    static ssize_t              rt_writes   = 0;
+
+#ifdef TRACK_WRITE_CALLS
+    // Get number of write system calls made by the calling thread, negative value if not supported
+    static ssize_t thread_write_calls()
+    {
+        char buf[0x400];
+        const int fd = open("/proc/thread-self/io", O_RDONLY);
+        if (fd < 0)
+            return -1;
+        const ssize_t count = read(fd, buf, sizeof(buf) - 1);
+        close(fd);
+        if (count <= 0)
+            return -1;
+        buf[count] = '\0';
+
+        const char *p = strstr(buf, "syscw:");
+        return (p != NULL) ? strtol(&p[6], NULL, 10) : -1;
+    }
+#endif /* TRACK_WRITE_CALLS */
+} /* namespace */
+
+namespace
+{
+    typedef struct messages_t
+    {
+        char        text[MAX_MESSAGES][0x200];
+        LV2_URID    type[MAX_MESSAGES];
+        size_t      count;
+    } messages_t;
+
+    static void writer(void *arg, LV2_URID type, const char *message)
+    {
+        messages_t *m   = static_cast<messages_t *>(arg);
+        if (m->count >= MAX_MESSAGES)
+            return;
+        strncpy(m->text[m->count], message, sizeof(m->text[0]) - 1);
+        m->text[m->count][sizeof(m->text[0]) - 1] = '\0';
+        m->type[m->count] = type;
+        ++m->count;
+    }
+
+    // Plugin which logs messages from the run() method
+    typedef struct plugin_t
+    {
+        LV2_Log_Logger  logger;
+        size_t          frame;
+        char            name[0x20];
+    } plugin_t;
+
+    static void plugin_run(plugin_t *p, uint32_t samples)
+    {
+        p->frame       += samples;
+        lv2_log_error(&p->logger, "%s: buffer underrun at frame %lld\n", p->name, (long long)p->frame);
+        lv2_log_warning(&p->logger, "%s: gain %.2f dB exceeds %d dB\n", p->name, 6.5, 6);
+        lv2_log_note(&p->logger, "%s: %zu samples, %5.1f%% load\n", p->name, size_t(samples), 42.25);
+        lv2_log_trace(&p->logger, "%s: state %p, flags 0x%08x\n", p->name, static_cast<void *>(p), 0xbeefu);
+    }
+
+    class Logger: public lsp::ipc::Thread
+    {
+        public:
+            lsp::lv2::DeferredLog  *pLog;
+            size_t                  nIndex;
+            size_t                  nCount;
+            size_t                  nCaptured;
+            bool                    bRelease;
+            uint32_t                nLogged;
+            uint32_t                nExit;
+
+        public:
+            explicit Logger(lsp::lv2::DeferredLog *log, size_t index, size_t count, bool release)
+            {
+                pLog        = log;
+                nIndex      = index;
+                nCount      = count;
+                nCaptured   = 0;
+                bRelease    = release;
+                nLogged     = 0;
+                nExit       = (release) ? 1 : 0;
+            }
+
+            virtual lsp::status_t run() override
+            {
+                for (size_t i=0; i<nCount; ++i)
+                    if (pLog->printf(0, "thread %d message %d\n", int(nIndex), int(i)) == 0)
+                        ++nCaptured;
+                if (bRelease)
+                    pLog->release_thread();
+
+                // Keep the thread alive until the test allows to exit
+                lsp::atomic_store(&nLogged, uint32_t(1));
+                while (lsp::atomic_load(&nExit) == 0)
+                    lsp::ipc::Thread::yield();
+
+                return lsp::STATUS_OK;
+            }
+    };
+
+    class RealtimeThread: public lsp::ipc::Thread
+    {
+        public:
+            plugin_t               *pPlugin;
+
+        public:
+            explicit RealtimeThread(plugin_t *plugin)
+            {
+                pPlugin     = plugin;
+            }
+
+            virtual lsp::status_t run() override
+            {
+            #ifdef TRACK_WRITE_CALLS
+                const ssize_t writes = thread_write_calls();
+            #endif /* TRACK_WRITE_CALLS */
+            #ifdef LSP_TESTING
+                const size_t unsafe = lsp::lv2::DeferredLog::thread_unsafe_calls();
+            #endif /* LSP_TESTING */
+
+                for (size_t i=0; i<RT_ITERATIONS; ++i)
+                    plugin_run(pPlugin, 256);
+
+            #ifdef LSP_TESTING
+                rt_unsafe   = lsp::lv2::DeferredLog::thread_unsafe_calls() - unsafe;
+            #else
+                rt_unsafe   = -1;
+            #endif /* LSP_TESTING */
+            #ifdef TRACK_WRITE_CALLS
+                rt_writes   = ((writes >= 0) && (thread_write_calls() >= 0)) ? thread_write_calls() - writes : -1;
+            #else
+                rt_writes   = -1;
+            #endif /* TRACK_WRITE_CALLS */
+
+                return lsp::STATUS_OK;
+            }
+    };
+} /* namespace */
+
+UTEST_BEGIN("3rdparty.lv2", deferred_log)
+
+    lsp::lv2::UridMap   sMap;
+    messages_t         *pMessages;
+
+    void check_message(lsp::lv2::DeferredLog *log, const char *expected, const char *fmt, va_list ap)
+    {
+        pMessages->count    = 0;
+        UTEST_ASSERT(log->vprintf(0, fmt, ap) == 0);
+
+        UTEST_ASSERT(log->drain() == 1);
+        UTEST_ASSERT(pMessages->count == 1);
+        UTEST_ASSERT_MSG(strcmp(pMessages->text[0], expected) == 0,
+            "format '%s': expected '%s', got '%s'", fmt, expected, pMessages->text[0]);
+    }
+
+    // Check the message against the output of vsnprintf()
+    void check_format(lsp::lv2::DeferredLog *log, const char *fmt, ...)
+    {
+        char expected[0x200];
+        va_list ap, copy;
+        va_start(ap, fmt);
+        va_copy(copy, ap);
+        vsnprintf(expected, sizeof(expected), fmt, copy);
+        va_end(copy);
+
+        check_message(log, expected, fmt, ap);
+        va_end(ap);
+    }
+
+    // Check the message against the expected text
+    void check_text(lsp::lv2::DeferredLog *log, const char *expected, const char *fmt, ...)
+    {
+        va_list ap;
+        va_start(ap, fmt);
+        check_message(log, expected, fmt, ap);
+        va_end(ap);
+    }
+
+    void test_format()
+    {
+        printf("Testing message formatting...\n");
+
+        lsp::lv2::DeferredLog log;
+        UTEST_ASSERT(log.printf(0, "not initialized") < 0);
+        UTEST_ASSERT(log.init(NULL) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(log.init(sMap.map_feature(), 0) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(log.init(sMap.map_feature(), 4, 0x10) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(log.init(sMap.map_feature()) == lsp::STATUS_OK);
+        log.set_writer(writer, pMessages);
+
+        check_format(&log, "plain text\n");
+        check_format(&log, "100%% done");
+        check_format(&log, "%d %i %u %x %X %o", -12, 34, 56u, 0xabcu, 0xdefu, 8u);
+        check_format(&log, "%hhd %hd %ld %lld %zu %zd", 300, 70000, -5L, 1LL << 40, size_t(123), ssize_t(-7));
+        check_format(&log, "%hhu %hu %lu %llu %jd %td", 300u, 70000u, 5UL, 1ULL << 63, intmax_t(-9), ptrdiff_t(-3));
+        check_format(&log, "[%5d] [%-5d] [%05d] [%+d] [% d] [%#x]", 42, 42, 42, 42, 42, 255u);
+        check_format(&log, "[%*d] [%-*d] [%.*f] [%*.*f]", 6, 1, 6, 2, 3, 3.14159, 10, 2, 2.71828);
+        check_format(&log, "%f %e %g %.3f %10.4E %a", 1.5, 12345.678, 0.0001, 2.0 / 3.0, -1e-10, 0.5);
+        check_format(&log, "%Lf %Lg", (long double)(1.25), (long double)(1e20));
+        check_format(&log, "%c%c%c", 'a', 'b', 'c');
+        check_format(&log, "[%s] [%10s] [%-10s] [%.3s]", "text", "right", "left", "truncated");
+        check_format(&log, "%s", static_cast<const char *>(NULL));
+        check_format(&log, "%p %p", static_cast<void *>(&log), static_cast<void *>(NULL));
+        check_format(&log, "%s=%d; %s=%g; %s=%c\n", "int", 1, "float", 2.5, "char", 'x');
+
+        // Strings limited with precision may have no terminating zero, place the string right
+        // before the inaccessible page to catch reads past the precision
+    #ifdef GUARD_PAGES
+        const size_t page   = sysconf(_SC_PAGESIZE);
+        uint8_t *pages      = static_cast<uint8_t *>(mmap(NULL, page * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        UTEST_ASSERT(pages != MAP_FAILED);
+        UTEST_ASSERT(mprotect(&pages[page], page, PROT_NONE) == 0);
+        char *raw           = reinterpret_cast<char *>(&pages[page - 4]);
+    #else
+        char storage[8]     = { 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x' };
+        char *raw           = &storage[4];
+    #endif /* GUARD_PAGES */
+        memcpy(raw, "abcd", 4);
+        // The expected text is given explicitly: sanitizers of vsnprintf() may read such strings
+        // up to the terminating zero
+        check_text(&log, "[abcd] [abcd] [ab] [abc   ]", "[%.4s] [%.*s] [%.2s] [%-6.3s]", raw, 4, raw, raw, raw);
+        check_text(&log, "[  abcd] []", "[%*.*s] [%.0s]", 6, 4, raw, raw);
+    #ifdef GUARD_PAGES
+        munmap(pages, page * 2);
+    #endif /* GUARD_PAGES */
+
+        // Invalid specifications are copied as is
+        pMessages->count    = 0;
+        UTEST_ASSERT(log.printf(0, "unfinished %") == 0);
+        UTEST_ASSERT(log.printf(0, "invalid %y conversion %d", 1) == 0);
+        UTEST_ASSERT(log.drain() == 2);
+        UTEST_ASSERT(strcmp(pMessages->text[0], "unfinished %") == 0);
+        UTEST_ASSERT(strcmp(pMessages->text[1], "invalid %y conversion %d") == 0);
+
+        // Type of the message
+        UTEST_ASSERT(log.printf(sMap.map(LV2_LOG__Warning), "warning") == 0);
+        pMessages->count    = 0;
+        UTEST_ASSERT(log.drain() == 1);
+        UTEST_ASSERT(pMessages->type[0] == sMap.map(LV2_LOG__Warning));
+        UTEST_ASSERT(log.written() == 19);
+        UTEST_ASSERT(log.dropped() == 0);
+    }
+
+    void test_arguments()
+    {
+        printf("Testing argument capture...\n");
+
+        lsp::lv2::DeferredLog log;
+        UTEST_ASSERT(log.init(sMap.map_feature()) == lsp::STATUS_OK);
+        log.set_writer(writer, pMessages);
+        pMessages->count    = 0;
+
+        // Strings are copied at the moment of the call
+        char buf[0x20];
+        strcpy(buf, "before");
+        UTEST_ASSERT(log.printf(0, "value: %s", buf) == 0);
+        strcpy(buf, "after");
+        UTEST_ASSERT(log.drain() == 1);
+        UTEST_ASSERT(strcmp(pMessages->text[0], "value: before") == 0);
+
+        // Long strings are truncated
+        char *big = static_cast<char *>(malloc(0x1000));
+        UTEST_ASSERT(big != NULL);
+        memset(big, 'x', 0xfff);
+        big[0xfff] = '\0';
+        UTEST_ASSERT(log.printf(0, "%s", big) == 0);
+        UTEST_ASSERT(log.drain() == 1);
+        UTEST_ASSERT(strlen(pMessages->text[1]) == lsp::lv2::DeferredLog::MAX_STRING - 1);
+        free(big);
+
+        // Arguments exceeding the limit are not formatted
+        UTEST_ASSERT(log.printf(0, "%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d|%d%d",
+            0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 1, 2, 3, 4, 5, 6, 7) == 0);
+        UTEST_ASSERT(log.drain() == 1);
+        UTEST_ASSERT(strcmp(pMessages->text[2], "0123456789012345|%d%d") == 0);
+
+        UTEST_ASSERT(log.printf(0, NULL) < 0);
+    }
+
+    void test_overflow()
+    {
+        printf("Testing overflow...\n");
+
+        lsp::lv2::DeferredLog log;
+        UTEST_ASSERT(log.init(sMap.map_feature(), 2, 0x100) == lsp::STATUS_OK);
+        log.set_writer(writer, pMessages);
+        pMessages->count    = 0;
+
+        // Each record takes 32 bytes, the ring is never filled completely, so 7 records fit
+        size_t captured = 0;
+        for (size_t i=0; i<10; ++i)
+            if (log.printf(0, "message %d", int(i)) == 0)
+                ++captured;
+        const size_t expected_count = 0x100 / 32 - 1;
+        UTEST_ASSERT(captured == expected_count);
+        UTEST_ASSERT(log.dropped() == 10 - expected_count);
+        UTEST_ASSERT(log.drain() == expected_count);
+        for (size_t i=0; i<expected_count; ++i)
+        {
+            char expected[0x20];
+            snprintf(expected, sizeof(expected), "message %d", int(i));
+            UTEST_ASSERT(strcmp(pMessages->text[i], expected) == 0);
+        }
+
+        // The ring buffer wraps around
+        for (size_t j=0; j<10; ++j)
+        {
+            pMessages->count    = 0;
+            for (size_t i=0; i<4; ++i)
+                UTEST_ASSERT(log.printf(0, "message %d", int(j * 4 + i)) == 0);
+            UTEST_ASSERT(log.drain() == 4);
+            for (size_t i=0; i<4; ++i)
+            {
+                char expected[0x20];
+                snprintf(expected, sizeof(expected), "message %d", int(j * 4 + i));
+                UTEST_ASSERT(strcmp(pMessages->text[i], expected) == 0);
+            }
+        }
+
+        // Too large message
+        char big[0x200];
+        memset(big, 'x', sizeof(big) - 1);
+        big[sizeof(big) - 1] = '\0';
+        UTEST_ASSERT(log.printf(0, "%s", big) < 0);
+        UTEST_ASSERT(log.dropped() == 11 - expected_count);
+    }
+
+    void test_threads()
+    {
+        printf("Testing per-thread ring buffers...\n");
+
+        lsp::lv2::DeferredLog log;
+        UTEST_ASSERT(log.init(sMap.map_feature(), 2) == lsp::STATUS_OK);
+        log.set_writer(writer, pMessages);
+        pMessages->count    = 0;
+
+        // Two threads own the rings, the third one has no ring
+        Logger t1(&log, 1, 10, false), t2(&log, 2, 10, false), t3(&log, 3, 10, false);
+        Logger *threads[] = { &t1, &t2, &t3 };
+        for (size_t i=0; i<3; ++i)
+        {
+            UTEST_ASSERT(threads[i]->start() == lsp::STATUS_OK);
+            while (lsp::atomic_load(&threads[i]->nLogged) == 0)
+                lsp::ipc::Thread::yield();
+        }
+        for (size_t i=0; i<3; ++i)
+        {
+            lsp::atomic_store(&threads[i]->nExit, uint32_t(1));
+            threads[i]->join();
+        }
+        UTEST_ASSERT(t1.nCaptured == 10);
+        UTEST_ASSERT(t2.nCaptured == 10);
+        UTEST_ASSERT(t3.nCaptured == 0);
+        UTEST_ASSERT(log.dropped() == 10);
+
+        // Messages of each thread are written in order
+        UTEST_ASSERT(log.drain() == 20);
+        for (size_t i=0; i<20; ++i)
+        {
+            char expected[0x40];
+            snprintf(expected, sizeof(expected), "thread %d message %d\n", int(i / 10 + 1), int(i % 10));
+            UTEST_ASSERT(strcmp(pMessages->text[i], expected) == 0);
+        }
+
+        // Released rings are reused by other threads
+        lsp::lv2::DeferredLog log2;
+        UTEST_ASSERT(log2.init(sMap.map_feature(), 1) == lsp::STATUS_OK);
+        log2.set_writer(writer, pMessages);
+        Logger t4(&log2, 4, 5, true), t5(&log2, 5, 5, true);
+        UTEST_ASSERT(t4.start() == lsp::STATUS_OK);
+        t4.join();
+        UTEST_ASSERT(t5.start() == lsp::STATUS_OK);
+        t5.join();
+        UTEST_ASSERT(t4.nCaptured == 5);
+        UTEST_ASSERT(t5.nCaptured == 5);
+        UTEST_ASSERT(log2.drain() == 10);
+    }
+
+    void test_realtime()
+    {
+        printf("Testing logging from the realtime thread...\n");
+
+        lsp::lv2::DeferredLog log;
+        UTEST_ASSERT(log.init(sMap.map_feature(), 4, 0x40000) == lsp::STATUS_OK);
+        log.set_writer(writer, pMessages);
+        pMessages->count    = 0;
+
+        // The plugin gets the log through the feature
+        const LV2_Feature *f = log.feature();
+        UTEST_ASSERT(strcmp(f->URI, LV2_LOG__log) == 0);
+
+        plugin_t plugin;
+        lv2_log_logger_init(&plugin.logger, sMap.map_feature(), static_cast<LV2_Log_Log *>(f->data));
+        plugin.frame    = 0;
+        strcpy(plugin.name, "test");
+
+        RealtimeThread rt(&plugin);
+        UTEST_ASSERT(rt.start() == lsp::STATUS_OK);
+        rt.join();
+
+        printf("  unsafe calls: %d, write calls: %d\n", int(rt_unsafe), int(rt_writes));
+        UTEST_ASSERT(rt_unsafe <= 0);
+        UTEST_ASSERT(rt_writes <= 0);
+
+        // Messages are formatted by the background thread
+        UTEST_ASSERT(log.dropped() == 0);
+    #ifdef LSP_TESTING
+        const size_t unsafe = lsp::lv2::DeferredLog::thread_unsafe_calls();
+        UTEST_ASSERT(log.drain() == RT_ITERATIONS * 4);
+        UTEST_ASSERT(lsp::lv2::DeferredLog::thread_unsafe_calls() == unsafe + 1);
+    #else
+        UTEST_ASSERT(log.drain() == RT_ITERATIONS * 4);
+    #endif /* LSP_TESTING */
+        UTEST_ASSERT(pMessages->count == MAX_MESSAGES);
+
+        char expected[0x200];
+        snprintf(expected, sizeof(expected), "test: buffer underrun at frame %lld\n", 256LL);
+        UTEST_ASSERT(strcmp(pMessages->text[0], expected) == 0);
+        UTEST_ASSERT(pMessages->type[0] == sMap.map(LV2_LOG__Error));
+        snprintf(expected, sizeof(expected), "test: gain %.2f dB exceeds %d dB\n", 6.5, 6);
+        UTEST_ASSERT(strcmp(pMessages->text[1], expected) == 0);
+        UTEST_ASSERT(pMessages->type[1] == sMap.map(LV2_LOG__Warning));
+        snprintf(expected, sizeof(expected), "test: %zu samples, %5.1f%% load\n", size_t(256), 42.25);
+        UTEST_ASSERT(strcmp(pMessages->text[2], expected) == 0);
+        snprintf(expected, sizeof(expected), "test: state %p, flags 0x%08x\n", static_cast<void *>(&plugin), 0xbeefu);
+        UTEST_ASSERT(strcmp(pMessages->text[3], expected) == 0);
+        UTEST_ASSERT(pMessages->type[3] == sMap.map(LV2_LOG__Trace));
+    }
+
+    UTEST_MAIN
+    {
+        UTEST_ASSERT(sMap.init() == lsp::STATUS_OK);
+        pMessages = static_cast<messages_t *>(malloc(sizeof(messages_t)));
+        UTEST_ASSERT(pMessages != NULL);
+        pMessages->count    = 0;
+
+        test_format();
+        test_arguments();
+        test_overflow();
+        test_threads();
+        test_realtime();
+
+        free(pMessages);
+    }
+
+UTEST_END
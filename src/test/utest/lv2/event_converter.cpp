@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/EventConverter.h>
+#include <lsp-plug.in/3rdparty/lv2/UridMap.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <lv2/atom/util.h>
+#include <lv2/event/event-helpers.h>
+#include <lv2/midi/midi.h>
+
+#define BUF_CAPACITY        0x4000
+#define FRAMES_PER_BEAT     24000.0
+
+LV2_DISABLE_DEPRECATION_WARNINGS
+
+namespace
+{
+    // Legacy URI map which assigns event types distinct from URIDs
+    static uint32_t uri_to_id(LV2_URI_Map_Callback_Data data, const char *map, const char *uri)
+    {
+        lsp::lv2::UridMap *urid_map = static_cast<lsp::lv2::UridMap *>(data);
+        if (strcmp(uri, "http://example.org/huge") == 0)
+            return 0x10000;
+        const LV2_URID urid = urid_map->map(uri);
+        return ((map != NULL) && (strcmp(map, LV2_EVENT_URI) == 0)) ? urid + 1000 : urid;
+    }
+
+    static void seq_init(LV2_Atom_Sequence *seq, uint32_t unit)
+    {
+        seq->atom.size      = sizeof(LV2_Atom_Sequence_Body);
+        seq->atom.type      = 0;
+        seq->body.unit      = unit;
+        seq->body.pad       = 0;
+    }
+
+    static void seq_append(LV2_Atom_Sequence *seq, int64_t frames, double beats, LV2_URID type, uint32_t size, uint8_t fill)
+    {
+        uint64_t buf[0x80];
+        LV2_Atom_Event *ev  = reinterpret_cast<LV2_Atom_Event *>(buf);
+        if (beats >= 0.0)
+            ev->time.beats      = beats;
+        else
+            ev->time.frames     = frames;
+        ev->body.type       = type;
+        ev->body.size       = size;
+        memset(&ev[1], fill, size);
+        lv2_atom_sequence_append_event(seq, BUF_CAPACITY, ev);
+    }
+
+    static void evbuf_append(LV2_Event_Buffer *buf, uint32_t frames, uint32_t subframes, uint16_t type, uint16_t size, uint8_t fill)
+    {
+        LV2_Event_Iterator it;
+        lv2_event_begin(&it, buf);
+        while (lv2_event_is_valid(&it))
+            lv2_event_increment(&it);
+
+        uint8_t data[0x200];
+        memset(data, fill, size);
+        lv2_event_write(&it, frames, subframes, type, size, data);
+    }
+
+    static bool check_data(const void *data, size_t size, uint8_t fill)
+    {
+        const uint8_t *p = static_cast<const uint8_t *>(data);
+        for (size_t i=0; i<size; ++i)
+            if (p[i] != fill)
+                return false;
+        return true;
+    }
+} /* namespace */
+
+UTEST_BEGIN("3rdparty.lv2", event_converter)
+
+    lsp::lv2::UridMap       map;
+    LV2_URI_Map_Feature     uri_map;
+    LV2_URID                midi_urid;
+    LV2_URID                other_urid;
+    uint32_t                midi_type;
+    LV2_URID                beat_time;
+    LV2_URID                frame_time;
+
+    void test_init(lsp::lv2::EventConverter *conv)
+    {
+        printf("Testing initialization...\n");
+
+        UTEST_ASSERT(map.init() == lsp::STATUS_OK);
+        uri_map.callback_data   = &map;
+        uri_map.uri_to_id       = uri_to_id;
+
+        midi_urid       = map.map(LV2_MIDI__MidiEvent);
+        other_urid      = map.map("http://example.org/other");
+        midi_type       = midi_urid + 1000;
+        beat_time       = map.map(LV2_ATOM__beatTime);
+        frame_time      = map.map(LV2_ATOM__frameTime);
+
+        UTEST_ASSERT(conv->add_type(LV2_MIDI__MidiEvent) == lsp::STATUS_BAD_STATE);
+        UTEST_ASSERT(conv->init(NULL, &uri_map) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(conv->init(map.map_feature(), NULL) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(conv->init(map.map_feature(), &uri_map) == lsp::STATUS_OK);
+
+        UTEST_ASSERT(conv->add_type(LV2_MIDI__MidiEvent) == lsp::STATUS_OK);
+        UTEST_ASSERT(conv->add_type(LV2_MIDI__MidiEvent) == lsp::STATUS_OK);
+        UTEST_ASSERT(conv->add_type("http://example.org/huge") == lsp::STATUS_OVERFLOW);
+        UTEST_ASSERT(conv->types() == 1);
+
+        // Force growth of the hash table
+        char uri[0x40];
+        for (size_t i=0; i<20; ++i)
+        {
+            snprintf(uri, sizeof(uri), "http://example.org/type%d", int(i));
+            UTEST_ASSERT(conv->add_type(uri) == lsp::STATUS_OK);
+        }
+        UTEST_ASSERT(conv->types() == 21);
+    }
+
+    void test_frames(lsp::lv2::EventConverter *conv, LV2_Atom_Sequence *seq, LV2_Event_Buffer *evbuf, LV2_Atom_Sequence *out)
+    {
+        printf("Testing conversion with frame time stamps...\n");
+
+        seq_init(seq, frame_time);
+        seq_append(seq, -5, -1.0, midi_urid, 3, 0x11);
+        seq_append(seq, 10, -1.0, midi_urid, 3, 0x22);
+        seq_append(seq, 11, -1.0, other_urid, 3, 0x33);        // Not registered
+        seq_append(seq, 12, -1.0, map.map("http://example.org/type5"), 0x1ff, 0x44);
+        seq_append(seq, 0x100000000LL, -1.0, midi_urid, 1, 0x55);
+
+        size_t dropped = 0;
+        UTEST_ASSERT(conv->to_events(evbuf, seq, &dropped) == lsp::STATUS_OK);
+        UTEST_ASSERT(dropped == 1);
+        UTEST_ASSERT(evbuf->event_count == 4);
+        UTEST_ASSERT(evbuf->stamp_type == LV2_EVENT_AUDIO_STAMP);
+        UTEST_ASSERT(evbuf->header_size == sizeof(LV2_Event_Buffer));
+
+        static const uint32_t frames[]  = { 0, 10, 12, UINT32_MAX };
+        static const uint16_t sizes[]   = { 3, 3, 0x1ff, 1 };
+        static const uint8_t fills[]    = { 0x11, 0x22, 0x44, 0x55 };
+
+        LV2_Event_Iterator it;
+        lv2_event_begin(&it, evbuf);
+        for (size_t i=0; i<4; ++i)
+        {
+            UTEST_ASSERT(lv2_event_is_valid(&it));
+            uint8_t *data = NULL;
+            const LV2_Event *e = lv2_event_get(&it, &data);
+            UTEST_ASSERT(e->frames == frames[i]);
+            UTEST_ASSERT(e->subframes == 0);
+            UTEST_ASSERT(e->size == sizes[i]);
+            UTEST_ASSERT(check_data(data, e->size, fills[i]));
+            UTEST_ASSERT(e->type == ((i == 2) ? uint16_t(map.map("http://example.org/type5") + 1000) : uint16_t(midi_type)));
+            lv2_event_increment(&it);
+        }
+        UTEST_ASSERT(!lv2_event_is_valid(&it));
+
+        // Convert back
+        evbuf_append(evbuf, 20, 0x80000000U, 0, 4, 0x66);     // Non-POD event
+        evbuf_append(evbuf, 21, 0, 0x7fff, 4, 0x77);          // Unknown type
+        UTEST_ASSERT(evbuf->event_count == 6);
+        UTEST_ASSERT(conv->to_sequence(out, BUF_CAPACITY, evbuf, 0, &dropped) == lsp::STATUS_OK);
+        UTEST_ASSERT(dropped == 2);
+        UTEST_ASSERT(out->body.unit == 0);
+
+        size_t i = 0;
+        LV2_ATOM_SEQUENCE_FOREACH(out, ev)
+        {
+            UTEST_ASSERT(i < 4);
+            UTEST_ASSERT(ev->time.frames == frames[i]);
+            UTEST_ASSERT(ev->body.size == sizes[i]);
+            UTEST_ASSERT(ev->body.type == ((i == 2) ? map.map("http://example.org/type5") : midi_urid));
+            UTEST_ASSERT(check_data(LV2_ATOM_BODY_CONST(&ev->body), ev->body.size, fills[i]));
+            ++i;
+        }
+        UTEST_ASSERT(i == 4);
+    }
+
+    void test_beats(lsp::lv2::EventConverter *conv, LV2_Atom_Sequence *seq, LV2_Event_Buffer *evbuf, LV2_Atom_Sequence *out)
+    {
+        printf("Testing conversion with beat time stamps...\n");
+
+        seq_init(seq, beat_time);
+        seq_append(seq, 0, 0.0, midi_urid, 3, 0x11);
+        seq_append(seq, 0, 0.5, midi_urid, 3, 0x22);
+        seq_append(seq, 0, 1.0 + 0.25 / FRAMES_PER_BEAT, midi_urid, 3, 0x33);
+
+        // Frames per beat are not set
+        UTEST_ASSERT(conv->to_events(evbuf, seq) == lsp::STATUS_BAD_STATE);
+        UTEST_ASSERT(conv->to_sequence(out, BUF_CAPACITY, evbuf, beat_time) == lsp::STATUS_BAD_STATE);
+
+        conv->set_frames_per_beat(FRAMES_PER_BEAT);
+        UTEST_ASSERT(conv->frames_per_beat() == FRAMES_PER_BEAT);
+        UTEST_ASSERT(conv->to_events(evbuf, seq) == lsp::STATUS_OK);
+        UTEST_ASSERT(evbuf->event_count == 3);
+
+        static const uint32_t frames[]      = { 0, 12000, 24000 };
+        static const uint32_t subframes[]   = { 0, 0, 0x40000000U };
+
+        LV2_Event_Iterator it;
+        lv2_event_begin(&it, evbuf);
+        for (size_t i=0; i<3; ++i)
+        {
+            const LV2_Event *e = lv2_event_get(&it, NULL);
+            UTEST_ASSERT(e->frames == frames[i]);
+            UTEST_ASSERT_MSG(llabs(int64_t(e->subframes) - int64_t(subframes[i])) < 0x10000, "subframes=0x%x", int(e->subframes));
+            lv2_event_increment(&it);
+        }
+
+        // Sub-frames are kept in beat time stamps
+        UTEST_ASSERT(conv->to_sequence(out, BUF_CAPACITY, evbuf, beat_time) == lsp::STATUS_OK);
+        UTEST_ASSERT(out->body.unit == beat_time);
+        size_t i = 0;
+        const LV2_Atom_Event *src = lv2_atom_sequence_begin(&seq->body);
+        LV2_ATOM_SEQUENCE_FOREACH(out, ev)
+        {
+            UTEST_ASSERT(fabs(ev->time.beats - src->time.beats) < 1e-9);
+            src = lv2_atom_sequence_next(src);
+            ++i;
+        }
+        UTEST_ASSERT(i == 3);
+
+        // Sub-frames are dropped in frame time stamps
+        UTEST_ASSERT(conv->to_sequence(out, BUF_CAPACITY, evbuf, frame_time) == lsp::STATUS_OK);
+        i = 0;
+        LV2_ATOM_SEQUENCE_FOREACH(out, ev)
+            UTEST_ASSERT(ev->time.frames == frames[i++]);
+
+        // Other stamp types are not supported
+        evbuf->stamp_type   = 1;
+        UTEST_ASSERT(conv->to_sequence(out, BUF_CAPACITY, evbuf, frame_time) == lsp::STATUS_UNSUPPORTED_FORMAT);
+        evbuf->stamp_type   = LV2_EVENT_AUDIO_STAMP;
+    }
+
+    void test_errors(lsp::lv2::EventConverter *conv, LV2_Atom_Sequence *seq, LV2_Event_Buffer *evbuf, LV2_Atom_Sequence *out)
+    {
+        printf("Testing overflow and corruption...\n");
+
+        seq_init(seq, frame_time);
+        for (size_t i=0; i<100; ++i)
+            seq_append(seq, i, -1.0, midi_urid, 3, uint8_t(i));
+
+        // Event buffer overflow: each event takes 16 bytes
+        const uint32_t capacity = evbuf->capacity;
+        evbuf->capacity     = 16 * 50 + 14;
+        UTEST_ASSERT(conv->to_events(evbuf, seq) == lsp::STATUS_OVERFLOW);
+        UTEST_ASSERT(evbuf->event_count == 50);
+        UTEST_ASSERT(evbuf->size == 16 * 50);
+        evbuf->capacity     = capacity;
+
+        // Sequence overflow: each event takes 24 bytes
+        UTEST_ASSERT(conv->to_events(evbuf, seq) == lsp::STATUS_OK);
+        UTEST_ASSERT(conv->to_sequence(out, sizeof(LV2_Atom_Sequence_Body) + 24 * 30 + 18, evbuf, 0) == lsp::STATUS_OVERFLOW);
+        UTEST_ASSERT(out->atom.size == sizeof(LV2_Atom_Sequence_Body) + 24 * 30);
+        UTEST_ASSERT(conv->to_sequence(out, 4, evbuf, 0) == lsp::STATUS_OVERFLOW);
+
+        // Truncated event buffer
+        evbuf->size        -= 20;
+        UTEST_ASSERT(conv->to_sequence(out, BUF_CAPACITY, evbuf, 0) == lsp::STATUS_CORRUPTED);
+        UTEST_ASSERT(out->atom.size == sizeof(LV2_Atom_Sequence_Body) + 24 * 98);
+    }
+
+    UTEST_MAIN
+    {
+        LV2_Atom_Sequence *seq  = static_cast<LV2_Atom_Sequence *>(malloc(BUF_CAPACITY + sizeof(LV2_Atom)));
+        LV2_Atom_Sequence *out  = static_cast<LV2_Atom_Sequence *>(malloc(BUF_CAPACITY + sizeof(LV2_Atom)));
+        LV2_Event_Buffer *evbuf = lv2_event_buffer_new(BUF_CAPACITY, LV2_EVENT_AUDIO_STAMP);
+        UTEST_ASSERT((seq != NULL) && (out != NULL) && (evbuf != NULL));
+
+        lsp::lv2::EventConverter conv;
+        test_init(&conv);
+        test_frames(&conv, seq, evbuf, out);
+        test_beats(&conv, seq, evbuf, out);
+        test_errors(&conv, seq, evbuf, out);
+
+        free(seq);
+        free(out);
+        free(evbuf);
+    }
+
+UTEST_END
+
+LV2_RESTORE_WARNINGS
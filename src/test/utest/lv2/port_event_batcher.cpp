@@ -0,0 +1,344 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/PortEventBatcher.h>
+#include <lsp-plug.in/3rdparty/lv2/UridMap.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <lv2/atom/atom.h>
+
+#define NUM_PORTS           200
+#define MAX_EVENTS          0x400
+#define NUM_ITERATIONS      100000
+
+namespace
+{
+    typedef struct event_t
+    {
+        uint32_t    port;
+        uint32_t    size;
+        uint32_t    format;
+        float       value;
+        uint32_t    type;
+        uint32_t    body;
+    } event_t;
+
+    typedef struct ui_t
+    {
+        event_t     events[MAX_EVENTS];
+        size_t      count;
+        uint32_t    last[NUM_PORTS];
+        bool        failed;
+    } ui_t;
+
+    static void port_event(LV2UI_Handle handle, uint32_t port, uint32_t size, uint32_t format, const void *buffer)
+    {
+        ui_t *ui        = static_cast<ui_t *>(handle);
+        if (ui->count >= MAX_EVENTS)
+            return;
+
+        event_t *ev     = &ui->events[ui->count++];
+        ev->port        = port;
+        ev->size        = size;
+        ev->format      = format;
+        ev->value       = 0.0f;
+        ev->type        = 0;
+        ev->body        = 0;
+
+        if (format == 0)
+            ev->value       = *static_cast<const float *>(buffer);
+        else
+        {
+            const LV2_Atom *atom = static_cast<const LV2_Atom *>(buffer);
+            ev->type        = atom->type;
+            if (atom->size >= sizeof(uint32_t))
+                ev->body        = *static_cast<const uint32_t *>(LV2_ATOM_BODY_CONST(atom));
+        }
+    }
+
+    // Checks that atoms of each port arrive in order and control values never go back
+    static void check_event(LV2UI_Handle handle, uint32_t port, uint32_t size, uint32_t format, const void *buffer)
+    {
+        ui_t *ui        = static_cast<ui_t *>(handle);
+        ++ui->count;
+
+        uint32_t value;
+        if (format == 0)
+            value           = uint32_t(*static_cast<const float *>(buffer));
+        else
+            value           = *static_cast<const uint32_t *>(LV2_ATOM_BODY_CONST(static_cast<const LV2_Atom *>(buffer)));
+
+        if ((format == 0) ? (value < ui->last[port]) : (value <= ui->last[port]))
+            ui->failed      = true;
+        ui->last[port]  = value;
+    }
+
+    static LV2UI_Descriptor make_ui(void (*handler)(LV2UI_Handle, uint32_t, uint32_t, uint32_t, const void *))
+    {
+        LV2UI_Descriptor d;
+        memset(&d, 0, sizeof(d));
+        d.URI           = "urn:test:ui";
+        d.port_event    = handler;
+        return d;
+    }
+
+    typedef struct atom_msg_t
+    {
+        LV2_Atom    atom;
+        uint32_t    body[16];
+    } atom_msg_t;
+
+    static const LV2_Atom *make_atom(atom_msg_t *msg, uint32_t type, uint32_t value, uint32_t words)
+    {
+        msg->atom.type  = type;
+        msg->atom.size  = words * sizeof(uint32_t);
+        for (size_t i=0; i<words; ++i)
+            msg->body[i]    = value;
+        return &msg->atom;
+    }
+
+    class Producer: public lsp::ipc::Thread
+    {
+        public:
+            lsp::lv2::PortEventBatcher *pBatcher;
+            uint32_t                    nDone;
+
+        public:
+            explicit Producer(lsp::lv2::PortEventBatcher *batcher)
+            {
+                pBatcher    = batcher;
+                nDone       = 0;
+            }
+
+            virtual lsp::status_t run() override
+            {
+                atom_msg_t msg;
+
+                // Even ports are control ports, odd ports are atom ports
+                for (size_t i=1; i<=NUM_ITERATIONS; ++i)
+                {
+                    const uint32_t port = uint32_t(i % 20);
+                    if (port & 1)
+                    {
+                        // Spin until the atom is accepted to check the order
+                        const LV2_Atom *atom = make_atom(&msg, 1, uint32_t(i), (i % 7) + 1);
+                        while (!pBatcher->write_atom(port, atom))
+                            lsp::ipc::Thread::yield();
+                    }
+                    else
+                        pBatcher->write_control(port, float(i));
+                }
+
+                lsp::atomic_store(&nDone, uint32_t(1));
+                return lsp::STATUS_OK;
+            }
+    };
+} /* namespace */
+
+UTEST_BEGIN("3rdparty.lv2", port_event_batcher)
+
+    static bool ps_subscribe(lsp::lv2::PortEventBatcher *b, LV2_URID protocol, uint32_t port)
+    {
+        const LV2UI_Port_Subscribe *ps = static_cast<const LV2UI_Port_Subscribe *>(b->feature()->data);
+        return ps->subscribe(ps->handle, port, protocol, NULL) == 0;
+    }
+
+    void test_controls(lsp::lv2::UridMap *map)
+    {
+        printf("Testing control port coalescing...\n");
+
+        ui_t *ui = static_cast<ui_t *>(malloc(sizeof(ui_t)));
+        UTEST_ASSERT(ui != NULL);
+        memset(ui, 0, sizeof(ui_t));
+        const LV2UI_Descriptor d = make_ui(port_event);
+
+        lsp::lv2::PortEventBatcher b;
+        UTEST_ASSERT(b.init(0, 0, map->map_feature()) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(b.init(NUM_PORTS, 0, NULL) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(b.init(NUM_PORTS, 0, map->map_feature()) == lsp::STATUS_OK);
+
+        // Subscription through the feature
+        const LV2_Feature *f = b.feature();
+        UTEST_ASSERT(strcmp(f->URI, LV2_UI__portSubscribe) == 0);
+        const LV2UI_Port_Subscribe *ps = static_cast<const LV2UI_Port_Subscribe *>(f->data);
+        const LV2_URID float_protocol = map->map(LV2_UI__floatProtocol);
+        UTEST_ASSERT(ps->subscribe(ps->handle, 1, float_protocol, NULL) == 0);
+        UTEST_ASSERT(ps->subscribe(ps->handle, 2, float_protocol, NULL) == 0);
+        UTEST_ASSERT(ps->subscribe(ps->handle, 3, map->map(LV2_UI__peakProtocol), NULL) != 0);
+        UTEST_ASSERT(ps->subscribe(ps->handle, NUM_PORTS, float_protocol, NULL) != 0);
+        UTEST_ASSERT(b.subscribe(130, true) == lsp::STATUS_OK);
+        UTEST_ASSERT(b.subscribe(NUM_PORTS, true) == lsp::STATUS_INVALID_VALUE);
+        UTEST_ASSERT(b.subscribed(1));
+        UTEST_ASSERT(b.subscribed(130));
+        UTEST_ASSERT(!b.subscribed(3));
+        UTEST_ASSERT(!b.subscribed(NUM_PORTS));
+
+        // Nothing to deliver
+        UTEST_ASSERT(b.flush(&d, ui) == 0);
+        UTEST_ASSERT(ui->count == 0);
+
+        // Write values
+        UTEST_ASSERT(b.write_control(1, 1.0f));
+        UTEST_ASSERT(b.write_control(1, 2.0f));
+        UTEST_ASSERT(b.write_control(1, 3.0f));
+        UTEST_ASSERT(b.write_control(130, 4.0f));
+        UTEST_ASSERT(b.write_control(2, 5.0f));
+        UTEST_ASSERT(!b.write_control(3, 6.0f));
+        UTEST_ASSERT(!b.write_control(NUM_PORTS, 7.0f));
+        UTEST_ASSERT(b.coalesced() == 2);
+        UTEST_ASSERT(b.dropped() == 2);
+
+        // Latest values are delivered once
+        UTEST_ASSERT(b.flush(&d, ui) == 3);
+        UTEST_ASSERT(ui->count == 3);
+        UTEST_ASSERT((ui->events[0].port == 1) && (ui->events[0].value == 3.0f));
+        UTEST_ASSERT((ui->events[0].format == 0) && (ui->events[0].size == sizeof(float)));
+        UTEST_ASSERT((ui->events[1].port == 2) && (ui->events[1].value == 5.0f));
+        UTEST_ASSERT((ui->events[2].port == 130) && (ui->events[2].value == 4.0f));
+        UTEST_ASSERT(b.delivered() == 3);
+        UTEST_ASSERT(b.flush(&d, ui) == 0);
+
+        // Values of ports unsubscribed before the delivery are dropped
+        UTEST_ASSERT(b.write_control(2, 8.0f));
+        UTEST_ASSERT(ps->unsubscribe(ps->handle, 2, float_protocol, NULL) == 0);
+        UTEST_ASSERT(b.flush(&d, ui) == 0);
+        UTEST_ASSERT(b.dropped() == 3);
+        UTEST_ASSERT(b.delivered() == 3);
+
+        free(ui);
+    }
+
+    void test_atoms(lsp::lv2::UridMap *map)
+    {
+        printf("Testing atom batching...\n");
+
+        ui_t *ui = static_cast<ui_t *>(malloc(sizeof(ui_t)));
+        UTEST_ASSERT(ui != NULL);
+        memset(ui, 0, sizeof(ui_t));
+        const LV2UI_Descriptor d = make_ui(port_event);
+        const LV2_URID transfer = map->map(LV2_ATOM__eventTransfer);
+
+        // Each record with 4-byte body takes 24 bytes
+        lsp::lv2::PortEventBatcher b;
+        UTEST_ASSERT(b.init(NUM_PORTS, 24 * 8, map->map_feature()) == lsp::STATUS_OK);
+        UTEST_ASSERT(ps_subscribe(&b, transfer, 5));
+        UTEST_ASSERT(ps_subscribe(&b, transfer, 7));
+
+        atom_msg_t msg;
+        UTEST_ASSERT(!b.write_atom(6, make_atom(&msg, 1, 1, 1)));
+        UTEST_ASSERT(!b.write_atom(5, NULL));
+        UTEST_ASSERT(b.write_atom(7, make_atom(&msg, 2, 10, 1)));
+        UTEST_ASSERT(b.write_atom(5, make_atom(&msg, 3, 20, 1)));
+        UTEST_ASSERT(b.write_atom(7, make_atom(&msg, 4, 11, 1)));
+        UTEST_ASSERT(b.write_atom(5, make_atom(&msg, 5, 21, 1)));
+        UTEST_ASSERT(b.write_atom(7, make_atom(&msg, 6, 12, 1)));
+        UTEST_ASSERT(b.dropped() == 2);
+
+        // Atoms are grouped by port
+        UTEST_ASSERT(b.flush(&d, ui) == 5);
+        static const uint32_t ports[]   = { 7, 7, 7, 5, 5 };
+        static const uint32_t types[]   = { 2, 4, 6, 3, 5 };
+        static const uint32_t values[]  = { 10, 11, 12, 20, 21 };
+        for (size_t i=0; i<5; ++i)
+        {
+            const event_t *ev = &ui->events[i];
+            UTEST_ASSERT(ev->port == ports[i]);
+            UTEST_ASSERT(ev->type == types[i]);
+            UTEST_ASSERT(ev->body == values[i]);
+            UTEST_ASSERT(ev->format == transfer);
+            UTEST_ASSERT(ev->size == sizeof(LV2_Atom) + sizeof(uint32_t));
+        }
+
+        // Wrap around the ring buffer: records are written starting at 120 bytes
+        ui->count = 0;
+        for (size_t i=0; i<7; ++i)
+            UTEST_ASSERT(b.write_atom(5, make_atom(&msg, 1, uint32_t(100 + i), 1)));
+        UTEST_ASSERT(!b.write_atom(5, make_atom(&msg, 1, 200, 1)));
+        UTEST_ASSERT(b.dropped() == 3);
+        UTEST_ASSERT(b.flush(&d, ui) == 7);
+        for (size_t i=0; i<7; ++i)
+            UTEST_ASSERT(ui->events[i].body == 100 + i);
+
+        // Records which do not fit the end of the buffer are written to the beginning
+        ui->count = 0;
+        UTEST_ASSERT(b.write_atom(7, make_atom(&msg, 1, 300, 12)));
+        UTEST_ASSERT(b.write_atom(7, make_atom(&msg, 1, 301, 12)));
+        UTEST_ASSERT(b.flush(&d, ui) == 2);
+        UTEST_ASSERT((ui->events[0].body == 300) && (ui->events[1].body == 301));
+        UTEST_ASSERT(ui->events[0].size == sizeof(LV2_Atom) + 12 * sizeof(uint32_t));
+
+        // Too large atom
+        UTEST_ASSERT(b.init(NUM_PORTS, 16, map->map_feature()) == lsp::STATUS_OK);
+        UTEST_ASSERT(b.subscribe(5, true) == lsp::STATUS_OK);
+        UTEST_ASSERT(!b.write_atom(5, make_atom(&msg, 1, 1, 1)));
+        UTEST_ASSERT(b.dropped() == 1);
+
+        free(ui);
+    }
+
+    void test_threads(lsp::lv2::UridMap *map)
+    {
+        printf("Testing concurrent delivery...\n");
+
+        ui_t *ui = static_cast<ui_t *>(malloc(sizeof(ui_t)));
+        UTEST_ASSERT(ui != NULL);
+        memset(ui, 0, sizeof(ui_t));
+        const LV2UI_Descriptor d = make_ui(check_event);
+
+        lsp::lv2::PortEventBatcher b;
+        UTEST_ASSERT(b.init(NUM_PORTS, 0x400, map->map_feature()) == lsp::STATUS_OK);
+        for (size_t i=0; i<20; ++i)
+            UTEST_ASSERT(b.subscribe(i, true) == lsp::STATUS_OK);
+
+        Producer p(&b);
+        UTEST_ASSERT(p.start() == lsp::STATUS_OK);
+        while (lsp::atomic_load(&p.nDone) == 0)
+            b.flush(&d, ui);
+        p.join();
+        b.flush(&d, ui);
+
+        UTEST_ASSERT(!ui->failed);
+        UTEST_ASSERT(ui->count == b.delivered());
+        UTEST_ASSERT(b.delivered() + b.coalesced() == NUM_ITERATIONS);
+
+        // The latest values are delivered
+        for (size_t i=0; i<20; ++i)
+            UTEST_ASSERT(ui->last[i] == NUM_ITERATIONS - ((NUM_ITERATIONS - i) % 20));
+
+        free(ui);
+    }
+
+    UTEST_MAIN
+    {
+        lsp::lv2::UridMap map;
+        UTEST_ASSERT(map.init() == lsp::STATUS_OK);
+
+        test_controls(&map);
+        test_atoms(&map);
+        test_threads(&map);
+    }
+
+UTEST_END
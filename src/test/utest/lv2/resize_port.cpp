@@ -0,0 +1,374 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/ResizePortHost.h>
+#include <lsp-plug.in/3rdparty/lv2/ResizePortPool.h>
+#include <lsp-plug.in/3rdparty/lv2/UridMap.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <lv2/atom/atom.h>
+#include <lv2/buf-size/buf-size.h>
+
+#define NUM_THREADS         8
+#define NUM_ITERATIONS      20000
+#define NUM_PORTS           4
+
+namespace
+{
+    typedef struct plugin_t
+    {
+        void       *ports[NUM_PORTS];
+        size_t      connects;
+    } plugin_t;
+
+    static void connect_port(LV2_Handle instance, uint32_t port, void *data)
+    {
+        plugin_t *p     = static_cast<plugin_t *>(instance);
+        p->ports[port]  = data;
+        ++p->connects;
+    }
+
+    static const LV2_Descriptor descriptor =
+    {
+        "urn:test:resize-port",
+        NULL,
+        connect_port,
+        NULL,
+        NULL,
+        NULL,
+        NULL,
+        NULL
+    };
+
+    class Worker: public lsp::ipc::Thread
+    {
+        public:
+            lsp::lv2::ResizePortPool   *pPool;
+            size_t                      nSeed;
+            bool                        bFailed;
+
+        public:
+            explicit Worker(lsp::lv2::ResizePortPool *pool, size_t seed)
+            {
+                pPool       = pool;
+                nSeed       = seed;
+                bFailed     = false;
+            }
+
+            virtual lsp::status_t run() override
+            {
+                uint32_t *bufs[4];
+                size_t sizes[4];
+
+                // Each thread fills acquired buffers with the own pattern and checks it before release
+                for (size_t i=0; i<NUM_ITERATIONS; ++i)
+                {
+                    const uint32_t tag  = uint32_t(nSeed * NUM_ITERATIONS + i);
+                    for (size_t j=0; j<4; ++j)
+                    {
+                        sizes[j]    = 0x400 << ((i + j) % 3);
+                        bufs[j]     = static_cast<uint32_t *>(pPool->acquire(sizes[j]));
+                        if (bufs[j] == NULL)
+                            continue;
+                        for (size_t k=0; k<sizes[j]/sizeof(uint32_t); k += 64)
+                            bufs[j][k]  = tag;
+                    }
+                    for (size_t j=0; j<4; ++j)
+                    {
+                        if (bufs[j] == NULL)
+                            continue;
+                        for (size_t k=0; k<sizes[j]/sizeof(uint32_t); k += 64)
+                            if (bufs[j][k] != tag)
+                                bFailed     = true;
+                        pPool->release(bufs[j]);
+                    }
+                }
+
+                return lsp::STATUS_OK;
+            }
+    };
+} /* namespace */
+
+UTEST_BEGIN("3rdparty.lv2", resize_port)
+
+    void test_classes()
+    {
+        printf("Testing size classes...\n");
+
+        using lsp::lv2::ResizePortPool;
+
+        UTEST_ASSERT(ResizePortPool::size_class(0) == 0);
+        UTEST_ASSERT(ResizePortPool::size_class(1) == 0);
+        UTEST_ASSERT(ResizePortPool::size_class(0x400) == 0);
+        UTEST_ASSERT(ResizePortPool::size_class(0x401) == 1);
+        UTEST_ASSERT(ResizePortPool::size_class(0x800) == 1);
+        UTEST_ASSERT(ResizePortPool::size_class(0x801) == 2);
+        UTEST_ASSERT(ResizePortPool::size_class(0x2000) == 3);
+        UTEST_ASSERT(ResizePortPool::size_class(0x1000000) == ssize_t(ResizePortPool::CLASSES - 1));
+        UTEST_ASSERT(ResizePortPool::size_class(0x1000001) < 0);
+
+        for (size_t i=0; i<ResizePortPool::CLASSES; ++i)
+        {
+            const size_t size = ResizePortPool::class_size(i);
+            UTEST_ASSERT(ResizePortPool::size_class(size) == ssize_t(i));
+            UTEST_ASSERT(ResizePortPool::size_class(size - 1) == ssize_t(i));
+        }
+    }
+
+    void test_pool()
+    {
+        printf("Testing buffer pool...\n");
+
+        lsp::lv2::ResizePortPool pool;
+        UTEST_ASSERT(pool.acquire(0x100) == NULL);
+        UTEST_ASSERT(pool.reserve(0x100, 1) == lsp::STATUS_BAD_STATE);
+        UTEST_ASSERT(pool.init(4) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(pool.init(0x2000, 0) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(pool.init(0x2000, 8) == lsp::STATUS_OK);
+        UTEST_ASSERT(pool.sequence_size() == 0x2000);
+
+        // Empty pool
+        UTEST_ASSERT(pool.acquire(0x100) == NULL);
+        UTEST_ASSERT(pool.misses() == 1);
+
+        // Reserve buffers
+        UTEST_ASSERT(pool.reserve(0x2000000, 1) == lsp::STATUS_TOO_BIG);
+        UTEST_ASSERT(pool.reserve(0x400, 2) == lsp::STATUS_OK);
+        UTEST_ASSERT(pool.reserve(0x300, 2) == lsp::STATUS_OK);
+        UTEST_ASSERT(pool.reserve(0x1000, 1) == lsp::STATUS_OK);
+        UTEST_ASSERT(pool.free_blocks(0) == 2);
+        UTEST_ASSERT(pool.free_blocks(2) == 1);
+        UTEST_ASSERT(pool.allocated() == 0x400 * 2 + 0x1000);
+
+        // Acquire buffers
+        size_t cap = 0;
+        void *b1 = pool.acquire(0x10, &cap);
+        UTEST_ASSERT(b1 != NULL);
+        UTEST_ASSERT(cap == 0x400);
+        UTEST_ASSERT((uintptr_t(b1) % lsp::lv2::ResizePortPool::HEADER_SIZE) == 0);
+        UTEST_ASSERT(pool.capacity(b1) == 0x400);
+        void *b2 = pool.acquire(0x400, &cap);
+        UTEST_ASSERT(b2 != NULL);
+        UTEST_ASSERT(b2 != b1);
+        UTEST_ASSERT(pool.misses() == 1);
+        memset(b1, 0x55, 0x400);
+        memset(b2, 0xaa, 0x400);
+
+        // Fall back to the greater size class
+        void *b3 = pool.acquire(0x200, &cap);
+        UTEST_ASSERT(b3 != NULL);
+        UTEST_ASSERT(cap == 0x1000);
+        UTEST_ASSERT(pool.misses() == 2);
+        UTEST_ASSERT(pool.acquire(0x200) == NULL);
+        UTEST_ASSERT(pool.misses() == 3);
+
+        // Release buffers
+        pool.release(NULL);
+        pool.release(b2);
+        UTEST_ASSERT(pool.free_blocks(0) == 1);
+        UTEST_ASSERT(pool.acquire(0x400) == b2);
+        pool.release(b1);
+        pool.release(b2);
+        pool.release(b3);
+        UTEST_ASSERT(pool.free_blocks(0) == 2);
+        UTEST_ASSERT(pool.free_blocks(2) == 1);
+
+        // Maintain reserve
+        UTEST_ASSERT(pool.set_reserve(0x2000000, 1) == lsp::STATUS_TOO_BIG);
+        UTEST_ASSERT(pool.set_reserve(0x800, 3) == lsp::STATUS_OK);
+        UTEST_ASSERT(pool.maintain() == lsp::STATUS_OK);
+        UTEST_ASSERT(pool.free_blocks(1) == 3);
+        UTEST_ASSERT(pool.maintain() == lsp::STATUS_OK);
+        UTEST_ASSERT(pool.free_blocks(1) == 3);
+
+        // Limit of blocks
+        UTEST_ASSERT(pool.reserve(0x400, 5) == lsp::STATUS_OVERFLOW);
+        UTEST_ASSERT(pool.free_blocks(0) == 4);
+    }
+
+    void test_option()
+    {
+        printf("Testing sequence size option...\n");
+
+        lsp::lv2::UridMap map;
+        UTEST_ASSERT(map.init() == lsp::STATUS_OK);
+        lsp::lv2::ResizePortPool pool;
+        UTEST_ASSERT(pool.init(0x3000) == lsp::STATUS_OK);
+
+        LV2_Options_Option opt;
+        UTEST_ASSERT(pool.sequence_size_option(&opt, NULL) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(pool.sequence_size_option(&opt, map.map_feature()) == lsp::STATUS_OK);
+        UTEST_ASSERT(opt.context == LV2_OPTIONS_INSTANCE);
+        UTEST_ASSERT(opt.key == map.map(LV2_BUF_SIZE__sequenceSize));
+        UTEST_ASSERT(opt.type == map.map(LV2_ATOM__Int));
+        UTEST_ASSERT(opt.size == sizeof(int32_t));
+        UTEST_ASSERT(*static_cast<const int32_t *>(opt.value) == 0x3000);
+    }
+
+    void test_host()
+    {
+        printf("Testing resize broker...\n");
+
+        lsp::lv2::ResizePortPool pool;
+        UTEST_ASSERT(pool.init(0x800) == lsp::STATUS_OK);
+
+        lsp::lv2::ResizePortHost host;
+        UTEST_ASSERT(host.add_port(0, 0x100, true) == lsp::STATUS_BAD_STATE);
+        UTEST_ASSERT(host.init(&pool) == lsp::STATUS_OK);
+
+        const LV2_Feature *f = host.feature();
+        UTEST_ASSERT(strcmp(f->URI, LV2_RESIZE_PORT__resize) == 0);
+        const LV2_Resize_Port_Resize *rs = static_cast<const LV2_Resize_Port_Resize *>(f->data);
+
+        // Add ports: atom ports get at least the sequence size
+        UTEST_ASSERT(host.add_port(0, 0x100, true) == lsp::STATUS_OK);
+        UTEST_ASSERT(host.add_port(0, 0x100, true) == lsp::STATUS_ALREADY_EXISTS);
+        UTEST_ASSERT(host.add_port(2, 0x1000, true) == lsp::STATUS_OK);
+        UTEST_ASSERT(host.add_port(3, 0x100, false) == lsp::STATUS_OK);
+        UTEST_ASSERT(host.add_port(1, 0x2000000, false) == lsp::STATUS_TOO_BIG);
+        UTEST_ASSERT(host.capacity(0) == 0x800);
+        UTEST_ASSERT(host.capacity(1) == 0);
+        UTEST_ASSERT(host.capacity(2) == 0x1000);
+        UTEST_ASSERT(host.capacity(3) == 0x400);
+        UTEST_ASSERT(host.buffer(1) == NULL);
+        UTEST_ASSERT(host.buffer(4) == NULL);
+
+        // Bind the plugin
+        plugin_t plugin;
+        memset(&plugin, 0, sizeof(plugin));
+        UTEST_ASSERT(host.bind(NULL, &plugin) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(host.bind(&descriptor, &plugin) == lsp::STATUS_OK);
+        UTEST_ASSERT(plugin.connects == 3);
+        for (size_t i=0; i<NUM_PORTS; ++i)
+            UTEST_ASSERT(plugin.ports[i] == host.buffer(i));
+
+        // Unknown ports and sizes that fit
+        UTEST_ASSERT(rs->resize(rs->data, 1, 0x100) == LV2_RESIZE_PORT_ERR_UNKNOWN);
+        UTEST_ASSERT(rs->resize(rs->data, 10, 0x100) == LV2_RESIZE_PORT_ERR_UNKNOWN);
+        UTEST_ASSERT(rs->resize(rs->data, 0, 0x800) == LV2_RESIZE_PORT_SUCCESS);
+        UTEST_ASSERT(host.resizes() == 0);
+        UTEST_ASSERT(plugin.connects == 3);
+
+        // Fill the atom port
+        void *initial       = host.buffer(0);
+        LV2_Atom *atom      = static_cast<LV2_Atom *>(plugin.ports[0]);
+        atom->type          = 1;
+        atom->size          = 0x100;
+        for (size_t i=0; i<atom->size; ++i)
+            reinterpret_cast<uint8_t *>(&atom[1])[i] = uint8_t(i * 7);
+        memset(plugin.ports[3], 0x5a, 0x400);
+
+        // Resize the ports several times during the cycle
+        UTEST_ASSERT(pool.reserve(0x800, 1) == lsp::STATUS_OK);
+        UTEST_ASSERT(pool.reserve(0x1000, 1) == lsp::STATUS_OK);
+        UTEST_ASSERT(pool.reserve(0x4000, 1) == lsp::STATUS_OK);
+        UTEST_ASSERT(rs->resize(rs->data, 0, 0x1000) == LV2_RESIZE_PORT_SUCCESS);
+        UTEST_ASSERT(host.capacity(0) == 0x1000);
+        UTEST_ASSERT(plugin.ports[0] != initial);
+        UTEST_ASSERT(host.buffer(0) == initial);
+        void *middle        = plugin.ports[0];
+        UTEST_ASSERT(rs->resize(rs->data, 0, 0x3000) == LV2_RESIZE_PORT_SUCCESS);
+        UTEST_ASSERT(host.capacity(0) == 0x4000);
+        UTEST_ASSERT(plugin.ports[0] != middle);
+        UTEST_ASSERT(rs->resize(rs->data, 3, 0x800) == LV2_RESIZE_PORT_SUCCESS);
+        UTEST_ASSERT(host.resizes() == 3);
+        UTEST_ASSERT(plugin.connects == 6);
+
+        // The intermediate buffer has been returned to the pool immediately
+        UTEST_ASSERT(pool.free_blocks(2) == 1);
+
+        // Contents are preserved
+        atom                = static_cast<LV2_Atom *>(plugin.ports[0]);
+        UTEST_ASSERT(atom->type == 1);
+        UTEST_ASSERT(atom->size == 0x100);
+        for (size_t i=0; i<atom->size; ++i)
+            UTEST_ASSERT(reinterpret_cast<uint8_t *>(&atom[1])[i] == uint8_t(i * 7));
+        const uint8_t *data = static_cast<const uint8_t *>(plugin.ports[3]);
+        for (size_t i=0; i<0x400; ++i)
+            UTEST_ASSERT(data[i] == 0x5a);
+
+        // The buffer seen by the host is retired at the end of cycle
+        UTEST_ASSERT(pool.free_blocks(1) == 0);
+        host.end_cycle();
+        UTEST_ASSERT(pool.free_blocks(1) == 1);
+        UTEST_ASSERT(pool.free_blocks(0) == 1);
+        UTEST_ASSERT(host.buffer(0) == plugin.ports[0]);
+        UTEST_ASSERT(host.buffer(3) == plugin.ports[3]);
+
+        // No free buffers
+        UTEST_ASSERT(rs->resize(rs->data, 2, 0x100000) == LV2_RESIZE_PORT_ERR_NO_SPACE);
+        UTEST_ASSERT(host.failures() == 1);
+        UTEST_ASSERT(host.capacity(2) == 0x1000);
+
+        // All buffers are returned to the pool on destroy
+        const size_t allocated = pool.allocated();
+        host.destroy();
+        size_t free_bytes = 0;
+        for (size_t i=0; i<lsp::lv2::ResizePortPool::CLASSES; ++i)
+            free_bytes     += pool.free_blocks(i) * lsp::lv2::ResizePortPool::class_size(i);
+        UTEST_ASSERT(free_bytes == allocated);
+    }
+
+    void test_threads()
+    {
+        printf("Testing concurrent access...\n");
+
+        lsp::lv2::ResizePortPool pool;
+        UTEST_ASSERT(pool.init() == lsp::STATUS_OK);
+        UTEST_ASSERT(pool.reserve(0x400, NUM_THREADS * 2) == lsp::STATUS_OK);
+        UTEST_ASSERT(pool.reserve(0x800, NUM_THREADS) == lsp::STATUS_OK);
+        UTEST_ASSERT(pool.reserve(0x1000, NUM_THREADS) == lsp::STATUS_OK);
+
+        Worker *threads[NUM_THREADS];
+        for (size_t i=0; i<NUM_THREADS; ++i)
+        {
+            threads[i]  = new Worker(&pool, i);
+            UTEST_ASSERT(threads[i] != NULL);
+        }
+        for (size_t i=0; i<NUM_THREADS; ++i)
+            UTEST_ASSERT(threads[i]->start() == lsp::STATUS_OK);
+        for (size_t i=0; i<NUM_THREADS; ++i)
+        {
+            threads[i]->join();
+            UTEST_ASSERT(!threads[i]->bFailed);
+            delete threads[i];
+        }
+
+        // All buffers are back in the pool
+        UTEST_ASSERT(pool.free_blocks(0) == NUM_THREADS * 2);
+        UTEST_ASSERT(pool.free_blocks(1) == NUM_THREADS);
+        UTEST_ASSERT(pool.free_blocks(2) == NUM_THREADS);
+    }
+
+    UTEST_MAIN
+    {
+        test_classes();
+        test_pool();
+        test_option();
+        test_host();
+        test_threads();
+    }
+
+UTEST_END
@@ -0,0 +1,339 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/sequence.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <lv2/atom/util.h>
+
+#define BEAT_TIME           100
+#define FRAME_TIME          101
+#define EVENT_TYPE          200
+#define MAX_INPUTS          70
+#define SEQ_CAPACITY        0x10000
+
+namespace
+{
+    typedef struct event_id_t
+    {
+        uint32_t            src;
+        uint32_t            serial;
+    } event_id_t;
+
+    static void seq_init(LV2_Atom_Sequence *seq, uint32_t unit)
+    {
+        seq->atom.size      = sizeof(LV2_Atom_Sequence_Body);
+        seq->atom.type      = 0;
+        seq->body.unit      = unit;
+        seq->body.pad       = 0;
+    }
+
+    static bool seq_append(LV2_Atom_Sequence *seq, uint32_t capacity, double time, uint32_t src, uint32_t serial, uint32_t size)
+    {
+        uint64_t buf[0x100];
+        LV2_Atom_Event *ev  = reinterpret_cast<LV2_Atom_Event *>(buf);
+        if (seq->body.unit == BEAT_TIME)
+            ev->time.beats      = time;
+        else
+            ev->time.frames     = int64_t(time);
+        ev->body.type       = EVENT_TYPE;
+        ev->body.size       = sizeof(event_id_t) + size;
+
+        uint8_t *data       = reinterpret_cast<uint8_t *>(ev + 1);
+        event_id_t id       = { src, serial };
+        memcpy(data, &id, sizeof(id));
+        for (size_t i=0; i<size; ++i)
+            data[sizeof(id) + i]    = uint8_t(src + serial + i);
+
+        return lv2_atom_sequence_append_event(seq, capacity, ev) != NULL;
+    }
+
+    static double event_time(const LV2_Atom_Sequence *seq, const LV2_Atom_Event *ev)
+    {
+        return (seq->body.unit == BEAT_TIME) ? ev->time.beats : double(ev->time.frames);
+    }
+
+    static const event_id_t *event_id(const LV2_Atom_Event *ev)
+    {
+        return reinterpret_cast<const event_id_t *>(ev + 1);
+    }
+
+    static bool event_valid(const LV2_Atom_Event *ev)
+    {
+        if ((ev->body.type != EVENT_TYPE) || (ev->body.size < sizeof(event_id_t)))
+            return false;
+        const event_id_t *id    = event_id(ev);
+        const uint8_t *data     = reinterpret_cast<const uint8_t *>(ev + 1) + sizeof(event_id_t);
+        for (size_t i=0, n=ev->body.size - sizeof(event_id_t); i<n; ++i)
+            if (data[i] != uint8_t(id->src + id->serial + i))
+                return false;
+        return true;
+    }
+
+    static size_t seq_count(const LV2_Atom_Sequence *seq)
+    {
+        size_t count = 0;
+        LV2_ATOM_SEQUENCE_FOREACH(seq, ev)
+            ++count;
+        return count;
+    }
+} /* namespace */
+
+UTEST_BEGIN("3rdparty.lv2", sequence)
+
+    LV2_Atom_Sequence      *vInputs[MAX_INPUTS];
+    LV2_Atom_Sequence      *pOutput;
+
+    LV2_Atom_Sequence *alloc_sequence()
+    {
+        LV2_Atom_Sequence *seq = static_cast<LV2_Atom_Sequence *>(malloc(SEQ_CAPACITY + sizeof(LV2_Atom)));
+        UTEST_ASSERT(seq != NULL);
+        return seq;
+    }
+
+    void fill_inputs(size_t inputs, size_t events, uint32_t unit)
+    {
+        for (size_t i=0; i<inputs; ++i)
+        {
+            seq_init(vInputs[i], unit);
+            double time = 0.0;
+            for (size_t j=0, n=rand() % (events + 1); j<n; ++j)
+            {
+                // Use coarse time stamps to produce many events with equal time
+                time       += (unit == BEAT_TIME) ? 0.25 * (rand() % 3) : double(rand() % 3);
+                UTEST_ASSERT(seq_append(vInputs[i], SEQ_CAPACITY, time, i, j, rand() % 13));
+            }
+        }
+    }
+
+    size_t check_merged(const LV2_Atom_Sequence *seq, size_t inputs)
+    {
+        uint32_t serial[MAX_INPUTS];
+        for (size_t i=0; i<inputs; ++i)
+            serial[i]   = 0;
+
+        size_t count        = 0;
+        const LV2_Atom_Event *prev = NULL;
+        LV2_ATOM_SEQUENCE_FOREACH(seq, ev)
+        {
+            UTEST_ASSERT(event_valid(ev));
+            const event_id_t *id = event_id(ev);
+
+            // Events of each input are not lost and keep their order
+            UTEST_ASSERT(id->src < inputs);
+            UTEST_ASSERT(id->serial == serial[id->src]);
+            ++serial[id->src];
+
+            // Events are ordered by time, then by index of input
+            if (prev != NULL)
+            {
+                const double t1 = event_time(seq, prev), t2 = event_time(seq, ev);
+                UTEST_ASSERT(t1 <= t2);
+                if (t1 == t2)
+                    UTEST_ASSERT(event_id(prev)->src <= id->src);
+            }
+
+            prev            = ev;
+            ++count;
+        }
+
+        return count;
+    }
+
+    void test_merge(size_t inputs, size_t events, uint32_t unit)
+    {
+        printf("Testing merge of %d inputs with %s...\n", int(inputs), (unit == BEAT_TIME) ? "beats" : "frames");
+
+        for (size_t k=0; k<10; ++k)
+        {
+            fill_inputs(inputs, events, unit);
+            size_t total = 0;
+            for (size_t i=0; i<inputs; ++i)
+                total      += seq_count(vInputs[i]);
+
+            seq_init(pOutput, 0);
+            UTEST_ASSERT(lsp::lv2::sequence_merge(pOutput, SEQ_CAPACITY, vInputs, inputs, BEAT_TIME) == lsp::STATUS_OK);
+            UTEST_ASSERT(pOutput->body.unit == unit);
+            UTEST_ASSERT(check_merged(pOutput, inputs) == total);
+            UTEST_ASSERT(lsp::lv2::sequence_is_sorted(pOutput, BEAT_TIME));
+        }
+    }
+
+    void test_merge_special()
+    {
+        printf("Testing merge special cases...\n");
+
+        // No inputs
+        seq_init(pOutput, FRAME_TIME);
+        UTEST_ASSERT(lsp::lv2::sequence_merge(pOutput, SEQ_CAPACITY, NULL, 0, BEAT_TIME) == lsp::STATUS_OK);
+        UTEST_ASSERT(pOutput->atom.size == sizeof(LV2_Atom_Sequence_Body));
+        UTEST_ASSERT(pOutput->body.unit == 0);
+
+        // NULL and empty inputs do not affect the time unit
+        const LV2_Atom_Sequence *src[3];
+        seq_init(vInputs[0], FRAME_TIME);
+        seq_init(vInputs[1], BEAT_TIME);
+        UTEST_ASSERT(seq_append(vInputs[1], SEQ_CAPACITY, 1.5, 1, 0, 3));
+        src[0] = vInputs[0];
+        src[1] = NULL;
+        src[2] = vInputs[1];
+        UTEST_ASSERT(lsp::lv2::sequence_merge(pOutput, SEQ_CAPACITY, src, 3, BEAT_TIME) == lsp::STATUS_OK);
+        UTEST_ASSERT(pOutput->body.unit == BEAT_TIME);
+        UTEST_ASSERT(seq_count(pOutput) == 1);
+
+        // Different time units
+        UTEST_ASSERT(seq_append(vInputs[0], SEQ_CAPACITY, 1, 0, 0, 3));
+        UTEST_ASSERT(lsp::lv2::sequence_merge(pOutput, SEQ_CAPACITY, src, 3, BEAT_TIME) == lsp::STATUS_BAD_FORMAT);
+
+        // Frame units are compatible
+        seq_init(vInputs[1], 0);
+        UTEST_ASSERT(seq_append(vInputs[1], SEQ_CAPACITY, 0, 1, 0, 3));
+        UTEST_ASSERT(lsp::lv2::sequence_merge(pOutput, SEQ_CAPACITY, src, 3, BEAT_TIME) == lsp::STATUS_OK);
+        UTEST_ASSERT(pOutput->body.unit == FRAME_TIME);
+        UTEST_ASSERT(check_merged(pOutput, 2) == 2);
+        UTEST_ASSERT(event_id(lv2_atom_sequence_begin(&pOutput->body))->src == 1);
+
+        // Invalid arguments
+        src[1] = pOutput;
+        UTEST_ASSERT(lsp::lv2::sequence_merge(pOutput, SEQ_CAPACITY, src, 3, BEAT_TIME) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(lsp::lv2::sequence_merge(NULL, SEQ_CAPACITY, src, 3, BEAT_TIME) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(lsp::lv2::sequence_merge(pOutput, 4, vInputs, 1, BEAT_TIME) == lsp::STATUS_OVERFLOW);
+    }
+
+    void test_merge_overflow()
+    {
+        printf("Testing merge overflow...\n");
+
+        fill_inputs(8, 100, FRAME_TIME);
+        seq_init(pOutput, 0);
+        UTEST_ASSERT(lsp::lv2::sequence_merge(pOutput, SEQ_CAPACITY, vInputs, 8, BEAT_TIME) == lsp::STATUS_OK);
+        const uint32_t full = pOutput->atom.size;
+        const size_t total  = seq_count(pOutput);
+
+        // The padding of the last event should fit into the capacity too
+        for (uint32_t capacity = sizeof(LV2_Atom_Sequence_Body); capacity < full; capacity += (capacity + 8 < full) ? 7 : 1)
+        {
+            seq_init(pOutput, 0);
+            UTEST_ASSERT(lsp::lv2::sequence_merge(pOutput, capacity, vInputs, 8, BEAT_TIME) == lsp::STATUS_OVERFLOW);
+            UTEST_ASSERT(pOutput->atom.size <= capacity);
+            UTEST_ASSERT(seq_count(pOutput) < total);
+            check_merged(pOutput, 8);
+        }
+    }
+
+    void test_sort(size_t events, uint32_t unit, size_t max_size, bool scratch)
+    {
+        printf("Testing sort of %d events with %s, %s scratch buffer...\n",
+            int(events), (unit == BEAT_TIME) ? "beats" : "frames", (scratch) ? "with" : "without");
+
+        void *buf = (scratch) ? malloc(SEQ_CAPACITY) : NULL;
+        for (size_t k=0; k<10; ++k)
+        {
+            // Mostly ordered sequence with random outliers
+            LV2_Atom_Sequence *seq = vInputs[0];
+            seq_init(seq, unit);
+            for (size_t i=0; i<events; ++i)
+            {
+                double time = (k & 1) ? rand() % 64 : (rand() % 8 == 0) ? rand() % 64 : i / 4;
+                if (unit == BEAT_TIME)
+                    time       *= 0.25;
+                UTEST_ASSERT(seq_append(seq, SEQ_CAPACITY, time, 0, i, rand() % max_size));
+            }
+            const uint32_t size = seq->atom.size;
+
+            UTEST_ASSERT(lsp::lv2::sequence_sort(seq, BEAT_TIME, buf) == lsp::STATUS_OK);
+            UTEST_ASSERT(seq->atom.size == size);
+            UTEST_ASSERT(lsp::lv2::sequence_is_sorted(seq, BEAT_TIME));
+
+            // Check stability
+            size_t count = 0;
+            const LV2_Atom_Event *prev = NULL;
+            LV2_ATOM_SEQUENCE_FOREACH(seq, ev)
+            {
+                UTEST_ASSERT(event_valid(ev));
+                if ((prev != NULL) && (event_time(seq, prev) == event_time(seq, ev)))
+                    UTEST_ASSERT(event_id(prev)->serial < event_id(ev)->serial);
+                prev        = ev;
+                ++count;
+            }
+            UTEST_ASSERT(count == events);
+        }
+
+        if (buf != NULL)
+            free(buf);
+    }
+
+    void test_sort_corrupted()
+    {
+        printf("Testing sort of corrupted sequence...\n");
+
+        LV2_Atom_Sequence *seq = vInputs[0];
+        seq_init(seq, FRAME_TIME);
+        UTEST_ASSERT(seq_append(seq, SEQ_CAPACITY, 2, 0, 0, 3));
+        UTEST_ASSERT(seq_append(seq, SEQ_CAPACITY, 1, 0, 1, 3));
+        UTEST_ASSERT(!lsp::lv2::sequence_is_sorted(seq, BEAT_TIME));
+
+        // Not padded event
+        seq->atom.size     -= 1;
+        UTEST_ASSERT(lsp::lv2::sequence_sort(seq, BEAT_TIME) == lsp::STATUS_CORRUPTED);
+        // Truncated event
+        seq->atom.size     -= 8;
+        UTEST_ASSERT(lsp::lv2::sequence_sort(seq, BEAT_TIME) == lsp::STATUS_CORRUPTED);
+
+        seq->atom.size     += 9;
+        UTEST_ASSERT(lsp::lv2::sequence_sort(seq, BEAT_TIME) == lsp::STATUS_OK);
+        UTEST_ASSERT(lsp::lv2::sequence_is_sorted(seq, BEAT_TIME));
+        UTEST_ASSERT(event_id(lv2_atom_sequence_begin(&seq->body))->serial == 1);
+    }
+
+    UTEST_MAIN
+    {
+        srand(0x44);
+
+        for (size_t i=0; i<MAX_INPUTS; ++i)
+            vInputs[i]  = alloc_sequence();
+        pOutput     = alloc_sequence();
+
+        static const size_t inputs[] = { 1, 2, 3, 8, 32, 64, 65, MAX_INPUTS };
+        for (size_t i=0; i<sizeof(inputs)/sizeof(inputs[0]); ++i)
+        {
+            test_merge(inputs[i], 1000 / inputs[i], FRAME_TIME);
+            test_merge(inputs[i], 1000 / inputs[i], BEAT_TIME);
+        }
+        test_merge_special();
+        test_merge_overflow();
+
+        test_sort(500, FRAME_TIME, 13, true);
+        test_sort(500, FRAME_TIME, 13, false);
+        test_sort(500, BEAT_TIME, 13, true);
+        test_sort(500, BEAT_TIME, 13, false);
+        test_sort(50, FRAME_TIME, 600, true);
+        test_sort(50, FRAME_TIME, 600, false);
+        test_sort_corrupted();
+
+        for (size_t i=0; i<MAX_INPUTS; ++i)
+            free(vInputs[i]);
+        free(pOutput);
+    }
+
+UTEST_END
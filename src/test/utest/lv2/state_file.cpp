@@ -0,0 +1,364 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/StateReader.h>
+#include <lsp-plug.in/3rdparty/lv2/StateWriter.h>
+#include <lsp-plug.in/3rdparty/lv2/UridMap.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <lv2/atom/atom.h>
+
+#define NUM_KEYS            1000
+
+namespace
+{
+    typedef struct value_t
+    {
+        char        key[0x40];
+        const char *type;
+        uint8_t     data[0x40];
+        size_t      size;
+        uint32_t    flags;
+    } value_t;
+
+    static void make_value(value_t *v, size_t index)
+    {
+        static const char *types[] = { LV2_ATOM__Int, LV2_ATOM__Float, LV2_ATOM__String, LV2_ATOM__Chunk };
+
+        snprintf(v->key, sizeof(v->key), "urn:test:state#key-%d", int(index));
+        v->type     = types[index % 4];
+        v->size     = (index * 7) % sizeof(v->data);
+        v->flags    = (index & 1) ? LV2_STATE_IS_POD | LV2_STATE_IS_PORTABLE : LV2_STATE_IS_POD;
+        for (size_t i=0; i<v->size; ++i)
+            v->data[i]  = uint8_t(index * 31 + i);
+    }
+} /* namespace */
+
+UTEST_BEGIN("3rdparty.lv2", state_file)
+
+    void build_state(lsp::lv2::UridMap *map, lsp::lv2::StateWriter *w, size_t count)
+    {
+        LV2_URID_Map *m = map->map_feature();
+        UTEST_ASSERT(w->init(map->unmap_feature()) == lsp::STATUS_OK);
+
+        // Store the values through the LV2 store function as the plugin does
+        const LV2_State_Store_Function store = w->store_function();
+        value_t v;
+        for (size_t i=0; i<count; ++i)
+        {
+            make_value(&v, i);
+            UTEST_ASSERT(store(w->handle(), m->map(m->handle, v.key), v.data, v.size, m->map(m->handle, v.type), v.flags) == LV2_STATE_SUCCESS);
+        }
+        UTEST_ASSERT(w->size() == count);
+    }
+
+    void check_state(lsp::lv2::UridMap *map, lsp::lv2::StateReader *r, const void *image, size_t image_size, size_t count)
+    {
+        LV2_URID_Map *m = map->map_feature();
+        UTEST_ASSERT(r->size() == count);
+
+        const LV2_State_Retrieve_Function retrieve = r->retrieve_function();
+        value_t v;
+        for (size_t pass=0; pass<2; ++pass)
+        {
+            for (size_t i=0; i<count; ++i)
+            {
+                make_value(&v, i);
+                const LV2_URID key  = m->map(m->handle, v.key);
+
+                size_t size         = 0;
+                uint32_t type       = 0;
+                uint32_t flags      = 0;
+                const uint8_t *p    = static_cast<const uint8_t *>(retrieve(r->handle(), key, &size, &type, &flags));
+                UTEST_ASSERT_MSG(p != NULL, "key=%s", v.key);
+                UTEST_ASSERT(size == v.size);
+                UTEST_ASSERT(type == m->map(m->handle, v.type));
+                UTEST_ASSERT(flags == v.flags);
+                UTEST_ASSERT(memcmp(p, v.data, size) == 0);
+
+                // Values are not copied and are aligned
+                UTEST_ASSERT((uintptr_t(p) & 7) == 0);
+                if (image != NULL)
+                    UTEST_ASSERT((p >= static_cast<const uint8_t *>(image)) && (p + size <= static_cast<const uint8_t *>(image) + image_size));
+
+                // Lookup by URI
+                const char *type_uri = NULL;
+                UTEST_ASSERT(r->find(v.key, &size, &type_uri, &flags) == p);
+                UTEST_ASSERT(strcmp(type_uri, v.type) == 0);
+            }
+        }
+
+        // Missing keys
+        size_t size         = 0;
+        uint32_t type       = 0;
+        uint32_t flags      = 0;
+        for (size_t i=0; i<2; ++i)
+            UTEST_ASSERT(r->retrieve(m->map(m->handle, "urn:test:state#missing"), &size, &type, &flags) == NULL);
+        UTEST_ASSERT(r->retrieve(0, &size, &type, &flags) == NULL);
+        UTEST_ASSERT(r->retrieve(0xfffffff0, &size, &type, &flags) == NULL);
+        UTEST_ASSERT(r->find("urn:test:state#missing", &size, NULL, &flags) == NULL);
+    }
+
+    void test_store()
+    {
+        printf("Testing store semantics...\n");
+
+        lsp::lv2::UridMap map;
+        UTEST_ASSERT(map.init() == lsp::STATUS_OK);
+        LV2_URID_Map *m     = map.map_feature();
+        const LV2_URID key  = m->map(m->handle, "urn:test:state#key");
+        const LV2_URID k2   = m->map(m->handle, "urn:test:state#empty");
+        const LV2_URID tint = m->map(m->handle, LV2_ATOM__Int);
+        const LV2_URID tstr = m->map(m->handle, "urn:test:state#Text");
+        const int32_t ival  = 42;
+        const char *long_str= "a string which is longer than the previous value";
+
+        lsp::lv2::StateWriter w;
+        UTEST_ASSERT(w.init(NULL) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(w.store(key, &ival, sizeof(ival), tint, LV2_STATE_IS_POD) == LV2_STATE_ERR_UNKNOWN);
+        UTEST_ASSERT(w.init(map.unmap_feature()) == lsp::STATUS_OK);
+
+        // Invalid arguments
+        UTEST_ASSERT(w.store(0, &ival, sizeof(ival), tint, LV2_STATE_IS_POD) == LV2_STATE_ERR_UNKNOWN);
+        UTEST_ASSERT(w.store(key, NULL, sizeof(ival), tint, LV2_STATE_IS_POD) == LV2_STATE_ERR_UNKNOWN);
+        UTEST_ASSERT(w.store(key, &ival, sizeof(ival), 0, LV2_STATE_IS_POD) == LV2_STATE_ERR_BAD_TYPE);
+        UTEST_ASSERT(w.store(key, &ival, sizeof(ival), tint, LV2_STATE_IS_PORTABLE) == LV2_STATE_ERR_BAD_FLAGS);
+        UTEST_ASSERT(w.size() == 0);
+
+        // Replace the value with longer and shorter ones
+        UTEST_ASSERT(w.store(key, &ival, sizeof(ival), tint, LV2_STATE_IS_POD) == LV2_STATE_SUCCESS);
+        UTEST_ASSERT(w.store(key, long_str, strlen(long_str) + 1, tstr, LV2_STATE_IS_POD | LV2_STATE_IS_PORTABLE) == LV2_STATE_SUCCESS);
+        UTEST_ASSERT(w.store(key, "short", 6, tstr, LV2_STATE_IS_POD | LV2_STATE_IS_PORTABLE) == LV2_STATE_SUCCESS);
+        UTEST_ASSERT(w.store(k2, NULL, 0, tstr, LV2_STATE_IS_POD) == LV2_STATE_SUCCESS);
+        UTEST_ASSERT(w.size() == 2);
+
+        const void *data    = NULL;
+        size_t size         = 0;
+        UTEST_ASSERT(w.serialize(&data, &size) == lsp::STATUS_OK);
+        UTEST_ASSERT((size & 7) == 0);
+
+        // Restore in the session with different URIDs
+        lsp::lv2::UridMap map2;
+        UTEST_ASSERT(map2.init() == lsp::STATUS_OK);
+        LV2_URID_Map *m2    = map2.map_feature();
+        const LV2_URID tstr2 = m2->map(m2->handle, "urn:test:state#Text");
+
+        lsp::lv2::StateReader r;
+        UTEST_ASSERT(r.wrap(data, size, NULL, map2.unmap_feature()) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(r.wrap(data, size, map2.map_feature(), map2.unmap_feature()) == lsp::STATUS_OK);
+        UTEST_ASSERT(r.wrap(data, size, map2.map_feature(), map2.unmap_feature()) == lsp::STATUS_OPENED);
+        UTEST_ASSERT(r.size() == 2);
+
+        size_t vsize    = 0;
+        uint32_t type   = 0;
+        uint32_t flags  = 0;
+        const char *v   = static_cast<const char *>(r.retrieve(m2->map(m2->handle, "urn:test:state#key"), &vsize, &type, &flags));
+        UTEST_ASSERT(v != NULL);
+        UTEST_ASSERT(vsize == 6);
+        UTEST_ASSERT(strcmp(v, "short") == 0);
+        UTEST_ASSERT(type == tstr2);
+        UTEST_ASSERT(tstr2 != tstr);
+        UTEST_ASSERT(flags == (LV2_STATE_IS_POD | LV2_STATE_IS_PORTABLE));
+
+        UTEST_ASSERT(r.retrieve(m2->map(m2->handle, "urn:test:state#empty"), &vsize, &type, &flags) != NULL);
+        UTEST_ASSERT(vsize == 0);
+
+        r.close();
+        UTEST_ASSERT(r.size() == 0);
+        UTEST_ASSERT(r.retrieve(m2->map(m2->handle, "urn:test:state#key"), &vsize, &type, &flags) == NULL);
+
+        // Clear the writer
+        w.clear();
+        UTEST_ASSERT(w.size() == 0);
+        UTEST_ASSERT(w.serialize(&data, &size) == lsp::STATUS_OK);
+        UTEST_ASSERT(r.wrap(data, size, map2.map_feature(), map2.unmap_feature()) == lsp::STATUS_OK);
+        UTEST_ASSERT(r.size() == 0);
+        UTEST_ASSERT(r.retrieve(m2->map(m2->handle, "urn:test:state#key"), &vsize, &type, &flags) == NULL);
+        r.close();
+    }
+
+    void test_memory()
+    {
+        printf("Testing container in memory...\n");
+
+        lsp::lv2::UridMap map;
+        lsp::lv2::StateWriter w;
+        lsp::lv2::StateReader r;
+        UTEST_ASSERT(map.init() == lsp::STATUS_OK);
+        build_state(&map, &w, NUM_KEYS);
+
+        const void *data    = NULL;
+        size_t size         = 0;
+        UTEST_ASSERT(w.serialize(&data, &size) == lsp::STATUS_OK);
+        UTEST_ASSERT(r.wrap(data, size, map.map_feature(), map.unmap_feature()) == lsp::STATUS_OK);
+        check_state(&map, &r, data, size, NUM_KEYS);
+        r.close();
+
+        // Repeated serialization uses cached URIs and should produce the same container
+        void *copy          = malloc(size);
+        UTEST_ASSERT(copy != NULL);
+        memcpy(copy, data, size);
+
+        const size_t prev   = size;
+        UTEST_ASSERT(w.serialize(&data, &size) == lsp::STATUS_OK);
+        UTEST_ASSERT(size == prev);
+        UTEST_ASSERT(memcmp(data, copy, size) == 0);
+        free(copy);
+    }
+
+    void test_file()
+    {
+        printf("Testing container file...\n");
+
+        char path[0x400];
+        snprintf(path, sizeof(path), "%s/utest-%s.bin", tempdir(), full_name());
+
+        lsp::lv2::UridMap map;
+        lsp::lv2::StateWriter w;
+        lsp::lv2::StateReader r;
+        UTEST_ASSERT(map.init() == lsp::STATUS_OK);
+        build_state(&map, &w, NUM_KEYS);
+        UTEST_ASSERT(w.save(path) == lsp::STATUS_OK);
+        w.destroy();
+
+        // Restore in the other session
+        lsp::lv2::UridMap map2;
+        UTEST_ASSERT(map2.init() == lsp::STATUS_OK);
+        UTEST_ASSERT(r.open(path, map2.map_feature(), map2.unmap_feature()) == lsp::STATUS_OK);
+        check_state(&map2, &r, NULL, 0, NUM_KEYS);
+        r.close();
+
+        UTEST_ASSERT(r.open("/nonexisting/path/state.bin", map2.map_feature(), map2.unmap_feature()) == lsp::STATUS_IO_ERROR);
+        remove(path);
+    }
+
+    void test_corrupted()
+    {
+        printf("Testing corrupted containers...\n");
+
+        lsp::lv2::UridMap map;
+        lsp::lv2::StateWriter w;
+        lsp::lv2::StateReader r;
+        UTEST_ASSERT(map.init() == lsp::STATUS_OK);
+        build_state(&map, &w, 16);
+
+        const void *data    = NULL;
+        size_t size         = 0;
+        UTEST_ASSERT(w.serialize(&data, &size) == lsp::STATUS_OK);
+        uint64_t *copy  = static_cast<uint64_t *>(malloc(size));
+        UTEST_ASSERT(copy != NULL);
+        uint8_t *bytes  = reinterpret_cast<uint8_t *>(copy);
+
+        // Truncated containers
+        for (size_t len=0; len<size; ++len)
+        {
+            memcpy(copy, data, size);
+            UTEST_ASSERT_MSG(r.wrap(copy, len, map.map_feature(), map.unmap_feature()) != lsp::STATUS_OK, "len=%d", int(len));
+            r.close();
+        }
+
+        // Corrupted header
+        lsp::lv2::state_header_t *hdr = reinterpret_cast<lsp::lv2::state_header_t *>(copy);
+        memcpy(copy, data, size);
+        hdr->magic      ^= 1;
+        UTEST_ASSERT(r.wrap(copy, size, map.map_feature(), map.unmap_feature()) == lsp::STATUS_BAD_FORMAT);
+        memcpy(copy, data, size);
+        hdr->byte_order = 0x0201;
+        UTEST_ASSERT(r.wrap(copy, size, map.map_feature(), map.unmap_feature()) == lsp::STATUS_UNSUPPORTED_FORMAT);
+        memcpy(copy, data, size);
+        hdr->bins       = hdr->entries;
+        UTEST_ASSERT(r.wrap(copy, size, map.map_feature(), map.unmap_feature()) == lsp::STATUS_CORRUPTED);
+        memcpy(copy, data, size);
+        hdr->data      += 8;
+        UTEST_ASSERT(r.wrap(copy, size, map.map_feature(), map.unmap_feature()) == lsp::STATUS_CORRUPTED);
+
+        // Offsets of sections past the end of the container
+        uint64_t *offsets[] =
+        {
+            &hdr->entries_offset, &hdr->uris_offset, &hdr->bins_offset, &hdr->strings_offset, &hdr->data_offset
+        };
+        const uint64_t bad_offsets[] = { (size + 0x10000) & ~uint64_t(0xff), uint64_t(-8), uint64_t(1) << 62 };
+        for (size_t i=0; i<sizeof(offsets)/sizeof(offsets[0]); ++i)
+            for (size_t j=0; j<sizeof(bad_offsets)/sizeof(bad_offsets[0]); ++j)
+            {
+                memcpy(copy, data, size);
+                *offsets[i]     = bad_offsets[j];
+                UTEST_ASSERT_MSG(r.wrap(copy, size, map.map_feature(), map.unmap_feature()) == lsp::STATUS_CORRUPTED,
+                    "section=%d, offset=0x%llx", int(i), (unsigned long long)bad_offsets[j]);
+            }
+
+        // Corrupted entries
+        lsp::lv2::state_entry_t *entries = reinterpret_cast<lsp::lv2::state_entry_t *>(&bytes[hdr->entries_offset]);
+        memcpy(copy, data, size);
+        entries[3].size = uint64_t(-1);
+        UTEST_ASSERT(r.wrap(copy, size, map.map_feature(), map.unmap_feature()) == lsp::STATUS_CORRUPTED);
+        memcpy(copy, data, size);
+        entries[5].type = hdr->uris;
+        UTEST_ASSERT(r.wrap(copy, size, map.map_feature(), map.unmap_feature()) == lsp::STATUS_CORRUPTED);
+
+        // Unterminated URI
+        memcpy(copy, data, size);
+        bytes[hdr->strings_offset + hdr->strings - 1] = 'x';
+        UTEST_ASSERT(r.wrap(copy, size, map.map_feature(), map.unmap_feature()) == lsp::STATUS_CORRUPTED);
+
+        // Unaligned data
+        UTEST_ASSERT(r.wrap(&bytes[4], size - 4, map.map_feature(), map.unmap_feature()) == lsp::STATUS_BAD_ARGUMENTS);
+
+        // Random corruption should never cause invalid memory access
+        for (size_t i=0; i<10000; ++i)
+        {
+            memcpy(copy, data, size);
+            for (size_t j=0; j<4; ++j)
+                bytes[rand() % size] = uint8_t(rand());
+
+            if (r.wrap(copy, size, map.map_feature(), map.unmap_feature()) == lsp::STATUS_OK)
+            {
+                value_t v;
+                LV2_URID_Map *m     = map.map_feature();
+                for (size_t k=0; k<16; ++k)
+                {
+                    make_value(&v, k);
+                    size_t vsize        = 0;
+                    uint32_t type       = 0;
+                    uint32_t flags      = 0;
+                    const uint8_t *p    = static_cast<const uint8_t *>(r.retrieve(m->map(m->handle, v.key), &vsize, &type, &flags));
+                    if (p != NULL)
+                        UTEST_ASSERT((p >= bytes) && (p + vsize <= &bytes[size]));
+                }
+            }
+            r.close();
+        }
+
+        free(copy);
+    }
+
+    UTEST_MAIN
+    {
+        test_store();
+        test_memory();
+        test_file();
+        test_corrupted();
+    }
+
+UTEST_END
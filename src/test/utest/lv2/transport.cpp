@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/transport.h>
+#include <lsp-plug.in/3rdparty/lv2/UridMap.h>
+#include <lsp-plug.in/3rdparty/lv2/uris.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+namespace
+{
+    // URID map with URIDs spread over a wide range
+    typedef struct sparse_map_t
+    {
+        const char         *uris[0x100];
+        size_t              count;
+    } sparse_map_t;
+
+    static LV2_URID sparse_map(LV2_URID_Map_Handle handle, const char *uri)
+    {
+        sparse_map_t *m     = static_cast<sparse_map_t *>(handle);
+        size_t i = 0;
+        for ( ; i < m->count; ++i)
+            if (strcmp(m->uris[i], uri) == 0)
+                break;
+        if (i >= m->count)
+        {
+            if (m->count >= 0x100)
+                return 0;
+            m->uris[m->count++] = uri;
+        }
+        return LV2_URID((i + 1) * 37);
+    }
+} /* namespace */
+
+UTEST_BEGIN("3rdparty.lv2", transport)
+
+    lsp::lv2::UridMap       map;
+    lsp::lv2::transport_urids_t urids;
+    LV2_Atom_Forge          forge;
+    uint8_t                 buf[0x400];
+
+    static bool equals(const lsp::lv2::transport_t *a, const lsp::lv2::transport_t *b)
+    {
+        return
+            (a->frame == b->frame) &&
+            (a->bar == b->bar) &&
+            (a->beat == b->beat) &&
+            (a->speed == b->speed) &&
+            (a->bar_beat == b->bar_beat) &&
+            (a->beats_per_bar == b->beats_per_bar) &&
+            (a->beats_per_minute == b->beats_per_minute) &&
+            (a->frames_per_second == b->frames_per_second) &&
+            (a->beat_unit == b->beat_unit) &&
+            (a->fields == b->fields);
+    }
+
+    const LV2_Atom *encode(const lsp::lv2::transport_t *t, uint32_t fields)
+    {
+        lv2_atom_forge_set_buffer(&forge, buf, sizeof(buf));
+        const LV2_Atom_Forge_Ref ref = lsp::lv2::transport_encode(&forge, t, fields, &urids);
+        UTEST_ASSERT(ref != 0);
+        return lv2_atom_forge_deref(&forge, ref);
+    }
+
+    void test_urids()
+    {
+        printf("Testing URID mapping...\n");
+
+        UTEST_ASSERT(map.init() == lsp::STATUS_OK);
+        UTEST_ASSERT(lsp::lv2::transport_urids_init(&urids, NULL) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(lsp::lv2::transport_urids_init(&urids, map.map_feature()) == lsp::STATUS_OK);
+
+        UTEST_ASSERT(urids.atom_Float == lsp::lv2::URI_ATOM__Float + 1);
+        UTEST_ASSERT(urids.time_Position == lsp::lv2::URI_TIME__Position + 1);
+        UTEST_ASSERT(urids.key[lsp::lv2::TRANSPORT_FRAME] == map.map(LV2_TIME__frame));
+        UTEST_ASSERT(urids.key[lsp::lv2::TRANSPORT_BAR_BEAT] == map.map(LV2_TIME__barBeat));
+        UTEST_ASSERT(urids.key[lsp::lv2::TRANSPORT_BEATS_PER_MINUTE] == map.map(LV2_TIME__beatsPerMinute));
+        UTEST_ASSERT(urids.key[lsp::lv2::TRANSPORT_FRAMES_PER_SECOND] == map.map(LV2_TIME__framesPerSecond));
+
+        UTEST_ASSERT(urids.key_range == lsp::lv2::TRANSPORT_FIELDS);
+
+        lv2_atom_forge_init(&forge, map.map_feature());
+    }
+
+    void test_round_trip()
+    {
+        printf("Testing encoding and decoding...\n");
+
+        lsp::lv2::transport_t src, dst;
+        lsp::lv2::transport_reset(&src);
+        lsp::lv2::transport_reset(&dst);
+        UTEST_ASSERT(src.fields == 0);
+
+        // Nothing is encoded for the transport which has never been updated
+        const LV2_Atom *atom = encode(&src, lsp::lv2::TRANSPORT_M_ALL);
+        UTEST_ASSERT(atom->type == urids.atom_Object);
+        UTEST_ASSERT(atom->size == sizeof(LV2_Atom_Object_Body));
+        UTEST_ASSERT(lsp::lv2::transport_decode(&dst, atom, &urids) == 0);
+        UTEST_ASSERT(dst.fields == 0);
+
+        src.frame               = 0x123456789LL;
+        src.bar                 = 17;
+        src.beat                = 67.125;
+        src.speed               = 1.0f;
+        src.bar_beat            = 3.125f;
+        src.beats_per_bar       = 4.0f;
+        src.beats_per_minute    = 133.5f;
+        src.frames_per_second   = 48000.0f;
+        src.beat_unit           = 4;
+        src.fields              = lsp::lv2::TRANSPORT_M_ALL;
+
+        // All fields are reported on the first decode, even if they match the defaults
+        atom = encode(&src, lsp::lv2::TRANSPORT_M_ALL);
+        UTEST_ASSERT(lsp::lv2::transport_decode(&dst, atom, &urids) == lsp::lv2::TRANSPORT_M_ALL);
+        UTEST_ASSERT(equals(&src, &dst));
+
+        // Same position does not change anything
+        UTEST_ASSERT(lsp::lv2::transport_decode(&dst, atom, &urids) == 0);
+
+        // Running transport
+        src.frame              += 16;
+        src.bar_beat           += 0.0078125f;
+        src.beat               += 0.0078125;
+        atom = encode(&src, lsp::lv2::TRANSPORT_M_ALL);
+        UTEST_ASSERT(lsp::lv2::transport_decode(&dst, atom, &urids) ==
+            (lsp::lv2::TRANSPORT_M_FRAME | lsp::lv2::TRANSPORT_M_BAR_BEAT | lsp::lv2::TRANSPORT_M_BEAT));
+        UTEST_ASSERT(equals(&src, &dst));
+
+        // Partial position keeps other fields
+        src.speed               = 0.0f;
+        src.beats_per_minute    = 90.0f;
+        atom = encode(&src, lsp::lv2::TRANSPORT_M_SPEED | lsp::lv2::TRANSPORT_M_FRAME);
+        UTEST_ASSERT(lsp::lv2::transport_decode(&dst, atom, &urids) == lsp::lv2::TRANSPORT_M_SPEED);
+        UTEST_ASSERT(dst.speed == 0.0f);
+        UTEST_ASSERT(dst.beats_per_minute == 133.5f);
+        UTEST_ASSERT(dst.fields == lsp::lv2::TRANSPORT_M_ALL);
+
+        // Each single field
+        lsp::lv2::transport_reset(&dst);
+        for (size_t i=0; i<lsp::lv2::TRANSPORT_FIELDS; ++i)
+        {
+            const uint32_t mask = 1 << i;
+            atom = encode(&src, mask);
+            UTEST_ASSERT(lsp::lv2::transport_decode(&dst, atom, &urids) == mask);
+            UTEST_ASSERT(dst.fields == ((mask << 1) - 1));
+        }
+        UTEST_ASSERT(equals(&src, &dst));
+    }
+
+    void test_foreign_objects()
+    {
+        printf("Testing decoding of foreign objects...\n");
+
+        lsp::lv2::transport_t t;
+        lsp::lv2::transport_reset(&t);
+
+        // Values of other numeric types and unknown keys
+        LV2_Atom_Forge_Frame frame;
+        lv2_atom_forge_set_buffer(&forge, buf, sizeof(buf));
+        LV2_Atom_Forge_Ref ref = lv2_atom_forge_object(&forge, &frame, 0, urids.time_Position);
+        lv2_atom_forge_key(&forge, map.map("http://example.org/unknown"));
+        lv2_atom_forge_float(&forge, 1.0f);
+        lv2_atom_forge_key(&forge, urids.key[lsp::lv2::TRANSPORT_FRAME]);
+        lv2_atom_forge_int(&forge, 48000);
+        lv2_atom_forge_key(&forge, urids.key[lsp::lv2::TRANSPORT_BEATS_PER_MINUTE]);
+        lv2_atom_forge_double(&forge, 140.0);
+        lv2_atom_forge_key(&forge, urids.key[lsp::lv2::TRANSPORT_BEAT_UNIT]);
+        lv2_atom_forge_long(&forge, 8);
+        lv2_atom_forge_key(&forge, urids.key[lsp::lv2::TRANSPORT_BAR]);
+        lv2_atom_forge_double(&forge, 5.0);
+        lv2_atom_forge_key(&forge, urids.key[lsp::lv2::TRANSPORT_SPEED]);
+        lv2_atom_forge_bool(&forge, true);
+        lv2_atom_forge_key(&forge, urids.key[lsp::lv2::TRANSPORT_BEAT]);
+        lv2_atom_forge_string(&forge, "1.0", 3);
+        lv2_atom_forge_pop(&forge, &frame);
+        UTEST_ASSERT(ref != 0);
+
+        const LV2_Atom *atom = lv2_atom_forge_deref(&forge, ref);
+        UTEST_ASSERT(lsp::lv2::transport_decode(&t, atom, &urids) ==
+            (lsp::lv2::TRANSPORT_M_FRAME | lsp::lv2::TRANSPORT_M_BEATS_PER_MINUTE | lsp::lv2::TRANSPORT_M_BEAT_UNIT |
+             lsp::lv2::TRANSPORT_M_BAR | lsp::lv2::TRANSPORT_M_SPEED));
+        UTEST_ASSERT(t.frame == 48000);
+        UTEST_ASSERT(t.beats_per_minute == 140.0f);
+        UTEST_ASSERT(t.beat_unit == 8);
+        UTEST_ASSERT(t.bar == 5);
+        UTEST_ASSERT(t.speed == 1.0f);
+        UTEST_ASSERT(t.beat == 0.0);
+        UTEST_ASSERT(!(t.fields & lsp::lv2::TRANSPORT_M_BEAT));
+
+        // Objects of other types are not decoded
+        lv2_atom_forge_set_buffer(&forge, buf, sizeof(buf));
+        ref = lv2_atom_forge_object(&forge, &frame, 0, map.map(LV2_TIME__Rate));
+        lv2_atom_forge_key(&forge, urids.key[lsp::lv2::TRANSPORT_FRAME]);
+        lv2_atom_forge_long(&forge, 1);
+        lv2_atom_forge_pop(&forge, &frame);
+        UTEST_ASSERT(lsp::lv2::transport_decode(&t, lv2_atom_forge_deref(&forge, ref), &urids) == 0);
+        UTEST_ASSERT(t.frame == 48000);
+
+        lv2_atom_forge_set_buffer(&forge, buf, sizeof(buf));
+        ref = lv2_atom_forge_long(&forge, 1);
+        UTEST_ASSERT(lsp::lv2::transport_decode(&t, lv2_atom_forge_deref(&forge, ref), &urids) == 0);
+    }
+
+    void test_sparse_urids()
+    {
+        printf("Testing sparse URIDs...\n");
+
+        sparse_map_t sm;
+        sm.count        = 0;
+        LV2_URID_Map smap;
+        smap.handle     = &sm;
+        smap.map        = sparse_map;
+
+        lsp::lv2::transport_urids_t su;
+        UTEST_ASSERT(lsp::lv2::transport_urids_init(&su, &smap) == lsp::STATUS_OK);
+        UTEST_ASSERT(su.key_range == 0);
+
+        LV2_Atom_Forge sforge;
+        lv2_atom_forge_init(&sforge, &smap);
+
+        lsp::lv2::transport_t src, dst;
+        lsp::lv2::transport_reset(&src);
+        lsp::lv2::transport_reset(&dst);
+        src.frame               = 1000;
+        src.beats_per_minute    = 77.0f;
+        src.fields              = lsp::lv2::TRANSPORT_M_ALL;
+
+        lv2_atom_forge_set_buffer(&sforge, buf, sizeof(buf));
+        const LV2_Atom_Forge_Ref ref = lsp::lv2::transport_encode(&sforge, &src, lsp::lv2::TRANSPORT_M_ALL, &su);
+        UTEST_ASSERT(ref != 0);
+        const LV2_Atom *atom = lv2_atom_forge_deref(&sforge, ref);
+        UTEST_ASSERT(lsp::lv2::transport_decode(&dst, atom, &su) == lsp::lv2::TRANSPORT_M_ALL);
+        UTEST_ASSERT(equals(&src, &dst));
+
+        // The URIDs of other map do not match
+        lsp::lv2::transport_reset(&dst);
+        UTEST_ASSERT(lsp::lv2::transport_decode(&dst, atom, &urids) == 0);
+    }
+
+    void test_overflow()
+    {
+        printf("Testing forge overflow...\n");
+
+        lsp::lv2::transport_t t;
+        lsp::lv2::transport_reset(&t);
+        t.fields        = lsp::lv2::TRANSPORT_M_ALL;
+
+        uint8_t small[0x40];
+        lv2_atom_forge_set_buffer(&forge, small, sizeof(small));
+        UTEST_ASSERT(lsp::lv2::transport_encode(&forge, &t, lsp::lv2::TRANSPORT_M_ALL, &urids) == 0);
+
+        lv2_atom_forge_set_buffer(&forge, small, sizeof(small));
+        UTEST_ASSERT(lsp::lv2::transport_encode(&forge, &t, lsp::lv2::TRANSPORT_M_FRAME, &urids) != 0);
+    }
+
+    UTEST_MAIN
+    {
+        test_urids();
+        test_round_trip();
+        test_foreign_objects();
+        test_sparse_urids();
+        test_overflow();
+    }
+
+UTEST_END
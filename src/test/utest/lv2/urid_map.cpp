@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/UridMap.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <lv2/atom/atom.h>
+#include <lv2/midi/midi.h>
+#include <lv2/time/time.h>
+#include <lv2/worker/worker.h>
+
+#define NUM_THREADS         8
+#define NUM_URIS            4000
+
+namespace
+{
+    static void make_uri(char *buf, size_t size, size_t index)
+    {
+        snprintf(buf, size, "urn:test:uri-%d", int(index));
+    }
+
+    class Mapper: public lsp::ipc::Thread
+    {
+        public:
+            lsp::lv2::UridMap  *pMap;
+            LV2_URID           *vUrids;
+            size_t              nOffset;
+
+        public:
+            explicit Mapper(lsp::lv2::UridMap *map, LV2_URID *urids, size_t offset)
+            {
+                pMap        = map;
+                vUrids      = urids;
+                nOffset     = offset;
+            }
+
+            virtual lsp::status_t run() override
+            {
+                char uri[0x40];
+
+                // Each thread maps all URIs starting with different offset
+                for (size_t i=0; i<NUM_URIS; ++i)
+                {
+                    const size_t index  = (i + nOffset) % NUM_URIS;
+                    make_uri(uri, sizeof(uri), index);
+                    vUrids[index]       = pMap->map(uri);
+                }
+
+                return lsp::STATUS_OK;
+            }
+    };
+} /* namespace */
+
+UTEST_BEGIN("3rdparty.lv2", urid_map)
+
+    void test_seeded()
+    {
+        printf("Testing pre-seeded URIs...\n");
+
+        lsp::lv2::UridMap m1, m2;
+        UTEST_ASSERT(m1.map(LV2_ATOM__Atom) == 0);
+        UTEST_ASSERT(m1.init(1) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(m1.init() == lsp::STATUS_OK);
+        UTEST_ASSERT(m2.init(m1.seeded() + 16) == lsp::STATUS_OK);
+
+        printf("  seeded %d URIs\n", int(m1.seeded()));
+        UTEST_ASSERT(m1.seeded() > 300);
+        UTEST_ASSERT(m1.seeded() == m2.seeded());
+        UTEST_ASSERT(m1.size() == m1.seeded());
+
+        // Seeded URIs have stable small URIDs
+        for (LV2_URID id=1; id<=m1.seeded(); ++id)
+        {
+            const char *uri = m1.unmap(id);
+            UTEST_ASSERT(uri != NULL);
+            UTEST_ASSERT(strcmp(uri, m2.unmap(id)) == 0);
+            UTEST_ASSERT(m1.find(uri) == id);
+            UTEST_ASSERT(m2.map(uri) == id);
+        }
+
+        static const char * const uris[] =
+        {
+            LV2_ATOM__Atom, LV2_ATOM__Sequence, LV2_MIDI__MidiEvent,
+            LV2_TIME__Position, LV2_TIME__beatsPerMinute, LV2_WORKER__schedule
+        };
+        for (size_t i=0; i<sizeof(uris)/sizeof(uris[0]); ++i)
+        {
+            const LV2_URID id = m1.find(uris[i]);
+            UTEST_ASSERT(id > 0);
+            UTEST_ASSERT(id <= m1.seeded());
+            UTEST_ASSERT(m2.find(uris[i]) == id);
+        }
+
+        // Legacy aliases map to the same URID
+        UTEST_ASSERT(m1.map(LV2_URID_MAP_URI) == m1.map(LV2_URID__map));
+        UTEST_ASSERT(m1.size() == m1.seeded());
+    }
+
+    void test_map()
+    {
+        printf("Testing map and unmap...\n");
+
+        lsp::lv2::UridMap m;
+        UTEST_ASSERT(m.init() == lsp::STATUS_OK);
+
+        UTEST_ASSERT(m.map(NULL) == 0);
+        UTEST_ASSERT(m.find(NULL) == 0);
+        UTEST_ASSERT(m.unmap(0) == NULL);
+        UTEST_ASSERT(m.unmap(m.seeded() + 1) == NULL);
+        UTEST_ASSERT(m.unmap(0xffffffff) == NULL);
+
+        // Map through the feature
+        LV2_URID_Map *map       = m.map_feature();
+        LV2_URID_Unmap *unmap   = m.unmap_feature();
+
+        char uri[0x40];
+        for (size_t i=0; i<NUM_URIS; ++i)
+        {
+            make_uri(uri, sizeof(uri), i);
+            UTEST_ASSERT(m.find(uri) == 0);
+            const LV2_URID id = map->map(map->handle, uri);
+            UTEST_ASSERT(id == m.seeded() + i + 1);
+            UTEST_ASSERT(map->map(map->handle, uri) == id);
+            UTEST_ASSERT(strcmp(unmap->unmap(unmap->handle, id), uri) == 0);
+        }
+        UTEST_ASSERT(m.size() == m.seeded() + NUM_URIS);
+
+        // Strings are copied
+        make_uri(uri, sizeof(uri), 0);
+        const char *stored = m.unmap(m.seeded() + 1);
+        UTEST_ASSERT(stored != uri);
+        UTEST_ASSERT(strcmp(stored, uri) == 0);
+
+        // Long strings are stored in separate chunk
+        char *big = static_cast<char *>(malloc(lsp::lv2::UridMap::CHUNK_SIZE * 2));
+        UTEST_ASSERT(big != NULL);
+        memset(big, 'x', lsp::lv2::UridMap::CHUNK_SIZE * 2 - 1);
+        big[lsp::lv2::UridMap::CHUNK_SIZE * 2 - 1] = '\0';
+        const LV2_URID big_id = m.map(big);
+        UTEST_ASSERT(big_id != 0);
+        UTEST_ASSERT(strcmp(m.unmap(big_id), big) == 0);
+        free(big);
+
+        // Capacity limit
+        lsp::lv2::UridMap small;
+        UTEST_ASSERT(small.init(m.seeded() + 2) == lsp::STATUS_OK);
+        UTEST_ASSERT(small.map("urn:test:a") == small.seeded() + 1);
+        UTEST_ASSERT(small.map("urn:test:b") == small.seeded() + 2);
+        UTEST_ASSERT(small.map("urn:test:c") == 0);
+        UTEST_ASSERT(small.map("urn:test:a") == small.seeded() + 1);
+        UTEST_ASSERT(small.map(LV2_ATOM__Atom) == m.find(LV2_ATOM__Atom));
+    }
+
+    void test_threads()
+    {
+        printf("Testing concurrent mapping...\n");
+
+        lsp::lv2::UridMap m;
+        UTEST_ASSERT(m.init() == lsp::STATUS_OK);
+
+        LV2_URID *urids = static_cast<LV2_URID *>(malloc(NUM_THREADS * NUM_URIS * sizeof(LV2_URID)));
+        UTEST_ASSERT(urids != NULL);
+
+        Mapper *threads[NUM_THREADS];
+        for (size_t i=0; i<NUM_THREADS; ++i)
+        {
+            threads[i]  = new Mapper(&m, &urids[i * NUM_URIS], (i * NUM_URIS) / NUM_THREADS);
+            UTEST_ASSERT(threads[i] != NULL);
+        }
+        for (size_t i=0; i<NUM_THREADS; ++i)
+            UTEST_ASSERT(threads[i]->start() == lsp::STATUS_OK);
+        for (size_t i=0; i<NUM_THREADS; ++i)
+        {
+            threads[i]->join();
+            delete threads[i];
+        }
+
+        // All threads got the same URID for the same URI
+        char uri[0x40];
+        UTEST_ASSERT(m.size() == m.seeded() + NUM_URIS);
+        for (size_t i=0; i<NUM_URIS; ++i)
+        {
+            const LV2_URID id = urids[i];
+            UTEST_ASSERT(id > m.seeded());
+            for (size_t j=1; j<NUM_THREADS; ++j)
+                UTEST_ASSERT(urids[j * NUM_URIS + i] == id);
+
+            make_uri(uri, sizeof(uri), i);
+            UTEST_ASSERT(strcmp(m.unmap(id), uri) == 0);
+            UTEST_ASSERT(m.find(uri) == id);
+        }
+
+        free(urids);
+    }
+
+    UTEST_MAIN
+    {
+        srand(0x41);
+
+        test_seeded();
+        test_map();
+        test_threads();
+    }
+
+UTEST_END
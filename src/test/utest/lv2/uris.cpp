@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/lv2/UridMap.h>
+#include <lsp-plug.in/3rdparty/lv2/uris.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+namespace
+{
+    typedef struct counting_map_t
+    {
+        size_t              calls;
+        LV2_URID            next;
+    } counting_map_t;
+
+    static LV2_URID counting_map(LV2_URID_Map_Handle handle, const char *uri)
+    {
+        counting_map_t *m   = static_cast<counting_map_t *>(handle);
+        ++m->calls;
+        return (strcmp(uri, LV2_ATOM__Atom) == 0) ? 0 : m->next++;
+    }
+} /* namespace */
+
+UTEST_BEGIN("3rdparty.lv2", uris)
+
+    void test_registry()
+    {
+        printf("Testing URI registry...\n");
+
+        printf("  registry contains %d URIs, %d bytes\n", int(lsp::lv2::URI_COUNT), int(sizeof(lsp::lv2::uri_strings_t)));
+        UTEST_ASSERT(lsp::lv2::URI_COUNT > 400);
+
+        UTEST_ASSERT(strcmp(lsp::lv2::uri_string(lsp::lv2::URI_ATOM__Atom), LV2_ATOM__Atom) == 0);
+        UTEST_ASSERT(strcmp(lsp::lv2::uri_string(lsp::lv2::URI_ATOM_URI), LV2_ATOM_URI) == 0);
+        UTEST_ASSERT(strcmp(lsp::lv2::uri_string(lsp::lv2::URI_TIME__beatsPerMinute), LV2_TIME__beatsPerMinute) == 0);
+        UTEST_ASSERT(strcmp(lsp::lv2::uri_string(lsp::lv2::URI_MIDI__MidiEvent), LV2_MIDI__MidiEvent) == 0);
+        UTEST_ASSERT(strcmp(lsp::lv2::uri_string(lsp::lv2::URI_PATCH__Set), LV2_PATCH__Set) == 0);
+        UTEST_ASSERT(strcmp(lsp::lv2::uri_string(lsp::lv2::URI_WORKER__schedule), LV2_WORKER__schedule) == 0);
+
+        for (size_t i=0; i<lsp::lv2::URI_COUNT; ++i)
+        {
+            const lsp::lv2::uri_t id = lsp::lv2::uri_t(i);
+            const char *uri = lsp::lv2::uri_string(id);
+            UTEST_ASSERT(uri != NULL);
+            UTEST_ASSERT(strncmp(uri, "http://", 7) == 0);
+            UTEST_ASSERT(lsp::lv2::uri_index(uri) == ssize_t(i));
+            UTEST_ASSERT(lsp::lv2::uri_index(uri + 1) < 0);
+            if (i > 0)
+                UTEST_ASSERT(lsp::lv2::uri_offsets[i] > lsp::lv2::uri_offsets[i-1]);
+
+            // URIs are unique
+            for (size_t j=0; j<i; ++j)
+                UTEST_ASSERT_MSG(strcmp(uri, lsp::lv2::uri_string(lsp::lv2::uri_t(j))) != 0, "Duplicate URI: %s", uri);
+        }
+
+        // Other pointers are not recognized
+        static const char atom[] = LV2_ATOM__Atom;
+        UTEST_ASSERT(lsp::lv2::uri_index(NULL) < 0);
+        UTEST_ASSERT(lsp::lv2::uri_index(atom) < 0);
+        UTEST_ASSERT(lsp::lv2::uri_index(reinterpret_cast<const char *>(&lsp::lv2::uri_strings) + sizeof(lsp::lv2::uri_strings_t)) < 0);
+    }
+
+    void test_urid_map()
+    {
+        printf("Testing mapping with UridMap...\n");
+
+        lsp::lv2::UridMap map;
+        UTEST_ASSERT(map.init() == lsp::STATUS_OK);
+        UTEST_ASSERT(map.seeded() == lsp::lv2::URI_COUNT);
+
+        char buf[0x100];
+        for (size_t i=0; i<lsp::lv2::URI_COUNT; ++i)
+        {
+            const char *uri = lsp::lv2::uri_string(lsp::lv2::uri_t(i));
+            strcpy(buf, uri);
+            UTEST_ASSERT(map.map(uri) == i + 1);
+            UTEST_ASSERT(map.map(buf) == i + 1);
+            UTEST_ASSERT(map.unmap(i + 1) == uri);
+        }
+
+        lsp::lv2::urid_bundle_t bundle;
+        UTEST_ASSERT(lsp::lv2::map_uri_bundle(&bundle, map.map_feature()) == lsp::STATUS_OK);
+        for (size_t i=0; i<lsp::lv2::URI_COUNT; ++i)
+            UTEST_ASSERT(bundle.urid[i] == i + 1);
+
+        static const lsp::lv2::uri_t ids[] =
+        {
+            lsp::lv2::URI_ATOM__Sequence, lsp::lv2::URI_MIDI__MidiEvent, lsp::lv2::URI_TIME__Position
+        };
+        LV2_URID urids[3];
+        UTEST_ASSERT(lsp::lv2::map_uris(urids, ids, 3, map.map_feature()) == lsp::STATUS_OK);
+        for (size_t i=0; i<3; ++i)
+            UTEST_ASSERT(urids[i] == LV2_URID(ids[i] + 1));
+        UTEST_ASSERT(map.size() == lsp::lv2::URI_COUNT);
+    }
+
+    void test_foreign_map()
+    {
+        printf("Testing mapping with foreign map...\n");
+
+        counting_map_t cm;
+        cm.calls        = 0;
+        cm.next         = 1000;
+        LV2_URID_Map map;
+        map.handle      = &cm;
+        map.map         = counting_map;
+
+        lsp::lv2::urid_bundle_t bundle;
+        UTEST_ASSERT(lsp::lv2::map_uri_bundle(&bundle, NULL) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(lsp::lv2::map_uri_bundle(&bundle, &map) == lsp::STATUS_NOT_FOUND);
+        UTEST_ASSERT(cm.calls == lsp::lv2::URI_COUNT);
+        UTEST_ASSERT(bundle.urid[lsp::lv2::URI_ATOM__Atom] == 0);
+        UTEST_ASSERT(bundle.urid[lsp::lv2::URI_ATOM_URI] == 1000);
+
+        static const lsp::lv2::uri_t ids[] = { lsp::lv2::URI_TIME__speed, lsp::lv2::URI_TIME__frame };
+        LV2_URID urids[2];
+        UTEST_ASSERT(lsp::lv2::map_uris(urids, ids, 2, &map) == lsp::STATUS_OK);
+        UTEST_ASSERT(cm.calls == lsp::lv2::URI_COUNT + 2);
+        UTEST_ASSERT(urids[0] + 1 == urids[1]);
+    }
+
+    UTEST_MAIN
+    {
+        test_registry();
+        test_urid_map();
+        test_foreign_map();
+    }
+
+UTEST_END
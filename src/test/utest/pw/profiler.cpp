@@ -0,0 +1,490 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/pw/ProfileFile.h>
+#include <lsp-plug.in/3rdparty/pw/ProfileStats.h>
+#include <lsp-plug.in/3rdparty/pw/ProfileTable.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <pw-headers/spa/param/profiler.h>
+#include <pw-headers/spa/pod/builder.h>
+#include <pw-headers/spa/utils/type.h>
+
+#include <algorithm>
+
+namespace
+{
+    static constexpr size_t CYCLES          = 10000;
+    static constexpr size_t NODES           = 3;
+    static constexpr uint32_t RATE          = 48000;
+    static constexpr uint32_t QUANTUM       = 1024;
+    static constexpr int64_t QUANTUM_NS     = (int64_t(QUANTUM) * 1000000000) / RATE;
+
+    static constexpr size_t XRUN_BLOCK      = 1000;     // Xrun reported by the node itself
+    static constexpr size_t XRUN_INCOMPLETE = 2000;     // Xrun with the node that did not finish
+    static constexpr size_t XRUN_LATE       = 3000;     // Xrun without any evidence
+    static constexpr size_t OVERRUN         = 4000;     // Overrun without xrun
+
+    typedef struct node_t
+    {
+        int32_t     id;
+        const char *name;
+    } node_t;
+
+    static const node_t nodes[NODES] =
+    {
+        { 10, "alsa_output.pci" },
+        { 20, "synth" },
+        { 30, "reverb" },
+    };
+
+    typedef struct cycle_t
+    {
+        int64_t     signal[NODES];
+        int64_t     awake[NODES];
+        int64_t     finish[NODES];
+        int32_t     xruns[NODES];
+        int32_t     info_xruns;
+    } cycle_t;
+}
+
+UTEST_BEGIN("3rdparty.pw", profiler)
+
+    static void add_block(struct spa_pod_builder *b, uint32_t key, const cycle_t *c, size_t i)
+    {
+        struct spa_pod_frame f;
+        const bool finished = c->finish[i] > 0;
+
+        spa_pod_builder_prop(b, key, 0);
+        spa_pod_builder_push_struct(b, &f);
+        spa_pod_builder_int(b, nodes[i].id);
+        spa_pod_builder_string(b, nodes[i].name);
+        spa_pod_builder_long(b, c->signal[i] - QUANTUM_NS);
+        spa_pod_builder_long(b, c->signal[i]);
+        spa_pod_builder_long(b, c->awake[i]);
+        spa_pod_builder_long(b, c->finish[i]);
+        spa_pod_builder_int(b, (finished) ? 3 : 2);
+        spa_pod_builder_fraction(b, QUANTUM, RATE);
+        spa_pod_builder_int(b, c->xruns[i]);
+        spa_pod_builder_bool(b, false);
+        spa_pod_builder_pop(b, &f);
+    }
+
+    static void add_object(struct spa_pod_builder *b, size_t counter, const cycle_t *c)
+    {
+        struct spa_pod_frame of, f;
+
+        spa_pod_builder_push_object(b, &of, SPA_TYPE_OBJECT_Profiler, 0);
+
+        spa_pod_builder_prop(b, SPA_PROFILER_info, 0);
+        spa_pod_builder_push_struct(b, &f);
+        spa_pod_builder_long(b, counter);
+        spa_pod_builder_float(b, 0.1f);
+        spa_pod_builder_float(b, 0.2f);
+        spa_pod_builder_float(b, 0.3f);
+        spa_pod_builder_int(b, c->info_xruns);
+        spa_pod_builder_pop(b, &f);
+
+        spa_pod_builder_prop(b, SPA_PROFILER_clock, 0);
+        spa_pod_builder_push_struct(b, &f);
+        spa_pod_builder_int(b, 0);
+        spa_pod_builder_int(b, nodes[0].id);
+        spa_pod_builder_string(b, nodes[0].name);
+        spa_pod_builder_long(b, c->signal[0]);
+        spa_pod_builder_fraction(b, 1, RATE);
+        spa_pod_builder_long(b, counter * QUANTUM);
+        spa_pod_builder_long(b, QUANTUM);
+        spa_pod_builder_long(b, 0);
+        spa_pod_builder_double(b, 1.0);
+        spa_pod_builder_long(b, c->signal[0] + QUANTUM_NS);
+        spa_pod_builder_int(b, 0);
+        spa_pod_builder_int(b, int32_t(counter));
+        spa_pod_builder_long(b, 0);
+        spa_pod_builder_pop(b, &f);
+
+        add_block(b, SPA_PROFILER_driverBlock, c, 0);
+        for (size_t i=1; i<NODES; ++i)
+            add_block(b, SPA_PROFILER_followerBlock, c, i);
+
+        spa_pod_builder_pop(b, &of);
+    }
+
+    static int64_t random_latency(int64_t min, int64_t range)
+    {
+        return min + (rand() % range);
+    }
+
+    void generate(cycle_t *cycles, size_t count)
+    {
+        int32_t info_xruns = 0, reverb_xruns = 0;
+
+        srand(0x5eed);
+        for (size_t k=0; k<count; ++k)
+        {
+            cycle_t *c          = &cycles[k];
+            const int64_t start = 1000000000 + int64_t(k) * QUANTUM_NS;
+
+            // Driver, then synth, then reverb processed by the chain
+            int64_t t           = start;
+            for (size_t i=0; i<NODES; ++i)
+            {
+                c->signal[i]        = t;
+                c->awake[i]         = t + random_latency(2000, 20000);
+                c->finish[i]        = c->awake[i] + random_latency(10000, 500000 * (i + 1));
+                t                   = c->finish[i];
+            }
+
+            if (k == XRUN_BLOCK)
+            {
+                ++reverb_xruns;
+                ++info_xruns;
+            }
+            else if (k == XRUN_INCOMPLETE)
+            {
+                c->awake[1]         = 0;
+                c->finish[1]        = 0;
+                ++info_xruns;
+            }
+            else if (k == XRUN_LATE)
+                ++info_xruns;
+            else if (k == OVERRUN)
+                c->finish[1]        = c->signal[0] + QUANTUM_NS + 1000;
+
+            c->xruns[0]         = 0;
+            c->xruns[1]         = 0;
+            c->xruns[2]         = reverb_xruns;
+            c->info_xruns       = info_xruns;
+        }
+    }
+
+    void write_capture(FILE *fd, const cycle_t *cycles, size_t count)
+    {
+        lsp::pw::ProfileFile file;
+        uint8_t buf[0x4000];
+        struct spa_pod_builder b;
+        struct spa_pod_frame f;
+
+        UTEST_ASSERT(file.wrap(fd) == lsp::STATUS_OK);
+
+        // Pods with different number of objects: single object and struct of objects
+        for (size_t k=0; k<count; )
+        {
+            const size_t n = (k % 7) + 1;
+            spa_pod_builder_init(&b, buf, sizeof(buf));
+            if (n == 1)
+            {
+                add_object(&b, k, &cycles[k]);
+                ++k;
+            }
+            else
+            {
+                spa_pod_builder_push_struct(&b, &f);
+                for (size_t i=0; (i < n) && (k < count); ++i, ++k)
+                    add_object(&b, k, &cycles[k]);
+                spa_pod_builder_pop(&b, &f);
+            }
+            UTEST_ASSERT(b.state.offset <= sizeof(buf));
+
+            UTEST_ASSERT(file.write(reinterpret_cast<const struct spa_pod *>(buf)) == lsp::STATUS_OK);
+        }
+
+        UTEST_ASSERT(file.close() == lsp::STATUS_OK);
+    }
+
+    void read_capture(FILE *fd, size_t capacity, lsp::pw::ProfileTable *table, lsp::pw::ProfileStats *stats)
+    {
+        lsp::pw::ProfileFile file;
+        const struct spa_pod *pod = NULL;
+        lsp::status_t res;
+
+        UTEST_ASSERT(fseek(fd, 0, SEEK_SET) == 0);
+        UTEST_ASSERT(file.wrap(fd) == lsp::STATUS_OK);
+        UTEST_ASSERT(table->init(capacity) == lsp::STATUS_OK);
+
+        while ((res = file.read(&pod)) == lsp::STATUS_OK)
+        {
+            res = stats->append(table, pod);
+            UTEST_ASSERT_MSG(res == lsp::STATUS_OK, "Error appending pod: %d", int(res));
+            UTEST_ASSERT(table->size() <= capacity);
+        }
+        UTEST_ASSERT(res == lsp::STATUS_EOF);
+        UTEST_ASSERT(stats->update(table) == lsp::STATUS_OK);
+        UTEST_ASSERT(file.close() == lsp::STATUS_OK);
+    }
+
+    static int64_t exact_percentile(int64_t *v, size_t count, double p)
+    {
+        size_t rank = size_t(p * count + 0.5);
+        rank        = lsp_max(rank, size_t(1));
+        rank        = lsp_min(rank, count);
+        std::sort(v, v + count);
+        return v[rank - 1];
+    }
+
+    void check_percentile(const char *label, int64_t estimate, int64_t exact)
+    {
+        printf("    %s: estimate=%lld exact=%lld\n", label, (long long)estimate, (long long)exact);
+        UTEST_ASSERT_MSG(estimate >= exact, "Estimate of %s is less than exact value", label);
+        UTEST_ASSERT_MSG(estimate <= exact + exact / 32 + 1, "Estimate of %s is too big", label);
+    }
+
+    void check_stats(const lsp::pw::ProfileTable *table, const lsp::pw::ProfileStats *stats, const cycle_t *cycles, size_t count)
+    {
+        int64_t *wakeup     = static_cast<int64_t *>(malloc(count * sizeof(int64_t)));
+        int64_t *process    = static_cast<int64_t *>(malloc(count * sizeof(int64_t)));
+        UTEST_ASSERT((wakeup != NULL) && (process != NULL));
+
+        UTEST_ASSERT(table->nodes() == NODES);
+        UTEST_ASSERT(stats->size() == NODES);
+
+        for (size_t i=0; i<NODES; ++i)
+        {
+            lsp::pw::profile_stats_t s;
+            UTEST_ASSERT(stats->get(i, &s) == lsp::STATUS_OK);
+            printf("  node id=%d name=%s cycles=%llu incomplete=%llu overruns=%llu xruns=%llu\n",
+                int(s.id), s.name, (unsigned long long)s.cycles, (unsigned long long)s.incomplete,
+                (unsigned long long)s.overruns, (unsigned long long)s.xruns);
+
+            UTEST_ASSERT(s.id == uint32_t(nodes[i].id));
+            UTEST_ASSERT(strcmp(s.name, nodes[i].name) == 0);
+            UTEST_ASSERT(s.driver == (i == 0));
+            UTEST_ASSERT(s.cycles == count);
+
+            // Compute exact values
+            size_t n = 0;
+            int64_t wakeup_max = 0, process_max = 0;
+            for (size_t k=0; k<count; ++k)
+            {
+                const cycle_t *c = &cycles[k];
+                if (c->finish[i] <= 0)
+                    continue;
+                wakeup[n]       = c->awake[i] - c->signal[i];
+                process[n]      = c->finish[i] - c->awake[i];
+                wakeup_max      = lsp_max(wakeup_max, wakeup[n]);
+                process_max     = lsp_max(process_max, process[n]);
+                ++n;
+            }
+
+            UTEST_ASSERT(s.wakeup_max == wakeup_max);
+            UTEST_ASSERT(s.process_max == process_max);
+            check_percentile("wakeup_p50", s.wakeup_p50, exact_percentile(wakeup, n, 0.50));
+            check_percentile("wakeup_p99", s.wakeup_p99, exact_percentile(wakeup, n, 0.99));
+            check_percentile("process_p50", s.process_p50, exact_percentile(process, n, 0.50));
+            check_percentile("process_p99", s.process_p99, exact_percentile(process, n, 0.99));
+
+            // Check the xrun attribution
+            switch (i)
+            {
+                case 0:
+                    UTEST_ASSERT(s.incomplete == 0);
+                    UTEST_ASSERT(s.overruns == 0);
+                    UTEST_ASSERT(s.xruns == 0);
+                    break;
+                case 1:
+                    UTEST_ASSERT(s.incomplete == 1);
+                    UTEST_ASSERT(s.overruns == 2);
+                    UTEST_ASSERT(s.xruns == 1);
+                    break;
+                default:
+                    UTEST_ASSERT(s.incomplete == 0);
+                    UTEST_ASSERT(s.overruns == 0);
+                    UTEST_ASSERT(s.xruns == 2);
+                    break;
+            }
+        }
+
+        free(wakeup);
+        free(process);
+    }
+
+    void test_table()
+    {
+        lsp::pw::ProfileTable table;
+        uint8_t buf[0x2000];
+        struct spa_pod_builder b;
+        struct spa_pod_frame f;
+        cycle_t c[4];
+
+        printf("Testing table...\n");
+        generate(c, 4);
+
+        spa_pod_builder_init(&b, buf, sizeof(buf));
+        spa_pod_builder_push_struct(&b, &f);
+        for (size_t i=0; i<4; ++i)
+            add_object(&b, i + 100, &c[i]);
+        spa_pod_builder_pop(&b, &f);
+        const struct spa_pod *pod = reinterpret_cast<const struct spa_pod *>(buf);
+
+        // Too small table
+        UTEST_ASSERT(table.append(pod) == lsp::STATUS_BAD_STATE);
+        UTEST_ASSERT(table.init(8) == lsp::STATUS_OK);
+        UTEST_ASSERT(table.append(pod) == lsp::STATUS_TOO_BIG);
+        UTEST_ASSERT(table.size() == 0);
+
+        // Table that fits exactly one pod
+        UTEST_ASSERT(table.init(12) == lsp::STATUS_OK);
+        UTEST_ASSERT(table.append(pod) == lsp::STATUS_OK);
+        UTEST_ASSERT(table.size() == 12);
+        UTEST_ASSERT(table.full());
+        UTEST_ASSERT(table.append(pod) == lsp::STATUS_OVERFLOW);
+        UTEST_ASSERT(table.size() == 12);
+
+        for (size_t i=0; i<12; ++i)
+        {
+            const size_t k = i / NODES, n = i % NODES;
+            UTEST_ASSERT(table.cycle()[i] == k + 100);
+            UTEST_ASSERT(table.node()[i] == n);
+            UTEST_ASSERT(table.driver()[i] == 0);
+            UTEST_ASSERT(table.signal()[i] == c[k].signal[n]);
+            UTEST_ASSERT(table.awake()[i] == c[k].awake[n]);
+            UTEST_ASSERT(table.finish()[i] == c[k].finish[n]);
+            UTEST_ASSERT(table.quantum()[i] == QUANTUM_NS);
+            UTEST_ASSERT(table.status()[i] == 3);
+            UTEST_ASSERT(table.flags()[i] == (lsp::pw::ProfileTable::F_FINISHED | ((n == 0) ? lsp::pw::ProfileTable::F_DRIVER : 0)));
+        }
+        for (size_t i=0; i<NODES; ++i)
+        {
+            UTEST_ASSERT(table.node_id(i) == uint32_t(nodes[i].id));
+            UTEST_ASSERT(strcmp(table.node_name(i), nodes[i].name) == 0);
+        }
+        UTEST_ASSERT(table.node_name(NODES) == NULL);
+
+        // Clear keeps nodes, reset drops nodes
+        table.clear();
+        UTEST_ASSERT(table.size() == 0);
+        UTEST_ASSERT(table.nodes() == NODES);
+        table.reset();
+        UTEST_ASSERT(table.nodes() == 0);
+
+        // Invalid pods
+        spa_pod_builder_init(&b, buf, sizeof(buf));
+        spa_pod_builder_int(&b, 42);
+        UTEST_ASSERT(table.append(pod) == lsp::STATUS_BAD_FORMAT);
+
+        spa_pod_builder_init(&b, buf, sizeof(buf));
+        spa_pod_builder_push_object(&b, &f, SPA_TYPE_OBJECT_Profiler, 0);
+        spa_pod_builder_prop(&b, SPA_PROFILER_followerBlock, 0);
+        spa_pod_builder_int(&b, 42);
+        spa_pod_builder_pop(&b, &f);
+        UTEST_ASSERT(table.append(pod) == lsp::STATUS_BAD_FORMAT);
+        UTEST_ASSERT(table.size() == 0);
+    }
+
+    void test_corrupted()
+    {
+        lsp::pw::ProfileFile file;
+        const struct spa_pod *pod = NULL;
+        cycle_t c;
+
+        printf("Testing corrupted file...\n");
+        generate(&c, 1);
+
+        FILE *fd = tmpfile();
+        UTEST_ASSERT(fd != NULL);
+        write_capture(fd, &c, 1);
+
+        // Truncate the last pod
+        UTEST_ASSERT(fseek(fd, 0, SEEK_END) == 0);
+        const long size = ftell(fd);
+        UTEST_ASSERT(size > 16);
+        UTEST_ASSERT(fseek(fd, 0, SEEK_SET) == 0);
+        uint8_t *buf = static_cast<uint8_t *>(malloc(size));
+        UTEST_ASSERT(buf != NULL);
+        UTEST_ASSERT(fread(buf, size, 1, fd) == 1);
+        fclose(fd);
+
+        fd = tmpfile();
+        UTEST_ASSERT(fd != NULL);
+        UTEST_ASSERT(fwrite(buf, size - 8, 1, fd) == 1);
+        UTEST_ASSERT(fseek(fd, 0, SEEK_SET) == 0);
+
+        UTEST_ASSERT(file.wrap(fd, true) == lsp::STATUS_OK);
+        UTEST_ASSERT(file.read(&pod) == lsp::STATUS_CORRUPTED);
+        UTEST_ASSERT(file.close() == lsp::STATUS_OK);
+
+        // Pod with the huge size
+        struct spa_pod *hdr = reinterpret_cast<struct spa_pod *>(buf);
+        hdr->size   = 0x7fffffff;
+        fd = tmpfile();
+        UTEST_ASSERT(fd != NULL);
+        UTEST_ASSERT(fwrite(buf, size, 1, fd) == 1);
+        UTEST_ASSERT(fseek(fd, 0, SEEK_SET) == 0);
+
+        UTEST_ASSERT(file.wrap(fd, true) == lsp::STATUS_OK);
+        UTEST_ASSERT(file.read(&pod) == lsp::STATUS_CORRUPTED);
+        UTEST_ASSERT(file.close() == lsp::STATUS_OK);
+
+        free(buf);
+    }
+
+    void test_capture()
+    {
+        cycle_t *cycles = static_cast<cycle_t *>(malloc(CYCLES * sizeof(cycle_t)));
+        UTEST_ASSERT(cycles != NULL);
+        generate(cycles, CYCLES);
+
+        FILE *fd = tmpfile();
+        UTEST_ASSERT(fd != NULL);
+        write_capture(fd, cycles, CYCLES);
+
+        // Whole capture fits into the table
+        {
+            printf("Testing capture with large table...\n");
+            lsp::pw::ProfileTable table;
+            lsp::pw::ProfileStats stats;
+            read_capture(fd, CYCLES * NODES, &table, &stats);
+            UTEST_ASSERT(table.size() == CYCLES * NODES);
+            check_stats(&table, &stats, cycles, CYCLES);
+
+            // Check flags of the rows
+            const uint32_t *flags = table.flags();
+            UTEST_ASSERT(flags[XRUN_BLOCK * NODES + 2] & lsp::pw::ProfileTable::F_BLAMED);
+            UTEST_ASSERT(flags[XRUN_BLOCK * NODES + 1] & lsp::pw::ProfileTable::F_XRUN);
+            UTEST_ASSERT(!(flags[XRUN_BLOCK * NODES + 1] & lsp::pw::ProfileTable::F_BLAMED));
+            UTEST_ASSERT(flags[XRUN_INCOMPLETE * NODES + 1] & lsp::pw::ProfileTable::F_BLAMED);
+            UTEST_ASSERT(!(flags[XRUN_INCOMPLETE * NODES + 1] & lsp::pw::ProfileTable::F_FINISHED));
+            UTEST_ASSERT(flags[XRUN_LATE * NODES + 2] & lsp::pw::ProfileTable::F_BLAMED);
+            UTEST_ASSERT(flags[OVERRUN * NODES + 1] & lsp::pw::ProfileTable::F_OVERRUN);
+            UTEST_ASSERT(!(flags[OVERRUN * NODES + 1] & lsp::pw::ProfileTable::F_XRUN));
+        }
+
+        // Capture is streamed through the small table
+        {
+            printf("Testing capture with small table...\n");
+            lsp::pw::ProfileTable table;
+            lsp::pw::ProfileStats stats;
+            read_capture(fd, 7 * NODES * 2, &table, &stats);
+            check_stats(&table, &stats, cycles, CYCLES);
+        }
+
+        fclose(fd);
+        free(cycles);
+    }
+
+    UTEST_MAIN
+    {
+        test_table();
+        test_corrupted();
+        test_capture();
+    }
+
+UTEST_END
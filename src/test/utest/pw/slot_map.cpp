@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/pw/SlotMap.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#define ITEMS_COUNT         10000
+#define OPERATIONS          200000
+
+UTEST_BEGIN("3rdparty.pw", slot_map)
+
+    static void *item_ptr(size_t i)
+    {
+        return reinterpret_cast<void *>(uintptr_t((i + 1) * 16));
+    }
+
+    typedef struct walk_t
+    {
+        size_t              visited;
+        uintptr_t           sum;
+    } walk_t;
+
+    static int count_items(void *item_data, void *data)
+    {
+        walk_t *w = static_cast<walk_t *>(data);
+        ++w->visited;
+        w->sum += uintptr_t(item_data);
+        return 0;
+    }
+
+    typedef struct remover_t
+    {
+        lsp::pw::SlotMap   *map;
+        lsp::pw::slot_id_t *ids;
+        size_t              count;
+        size_t              removed;
+    } remover_t;
+
+    static int remove_current(void *item_data, void *data)
+    {
+        remover_t *r = static_cast<remover_t *>(data);
+        const size_t i = uintptr_t(item_data) / 16 - 1;
+        if ((i & 1) == 0)
+            return 0;
+        if (r->map->remove(r->ids[i]) != lsp::STATUS_OK)
+            return -1;
+        r->ids[i] = lsp::pw::SLOT_ID_INVALID;
+        ++r->removed;
+        return 0;
+    }
+
+    static int stop_at(void *item_data, void *data)
+    {
+        return (item_data == data) ? 42 : 0;
+    }
+
+    void test_basic()
+    {
+        lsp::pw::SlotMap map;
+        lsp::pw::slot_id_t a, b, c;
+
+        printf("Testing basic operations...\n");
+
+        UTEST_ASSERT(map.size() == 0);
+        UTEST_ASSERT(map.lookup(0) == NULL);
+        UTEST_ASSERT(map.lookup(lsp::pw::SLOT_ID_INVALID) == NULL);
+
+        UTEST_ASSERT(map.insert(item_ptr(0), &a) == lsp::STATUS_OK);
+        UTEST_ASSERT(map.insert(item_ptr(1), &b) == lsp::STATUS_OK);
+        UTEST_ASSERT(map.size() == 2);
+        UTEST_ASSERT(a != b);
+        UTEST_ASSERT(map.lookup(a) == item_ptr(0));
+        UTEST_ASSERT(map.lookup(b) == item_ptr(1));
+
+        // Stale identifier does not match the item that reuses the slot
+        void *data = NULL;
+        UTEST_ASSERT(map.remove(a, &data) == lsp::STATUS_OK);
+        UTEST_ASSERT(data == item_ptr(0));
+        UTEST_ASSERT(map.remove(a) == lsp::STATUS_NOT_FOUND);
+        UTEST_ASSERT(map.lookup(a) == NULL);
+        UTEST_ASSERT(!map.contains(a));
+
+        UTEST_ASSERT(map.insert(item_ptr(2), &c) == lsp::STATUS_OK);
+        UTEST_ASSERT(lsp::pw::SlotMap::index_of(c) == lsp::pw::SlotMap::index_of(a));
+        UTEST_ASSERT(lsp::pw::SlotMap::generation_of(c) != lsp::pw::SlotMap::generation_of(a));
+        UTEST_ASSERT(map.lookup(a) == NULL);
+        UTEST_ASSERT(map.lookup(c) == item_ptr(2));
+        UTEST_ASSERT(map.replace(a, item_ptr(3)) == lsp::STATUS_NOT_FOUND);
+        UTEST_ASSERT(map.replace(c, item_ptr(3)) == lsp::STATUS_OK);
+        UTEST_ASSERT(map.lookup(c) == item_ptr(3));
+
+        // Free slot with the next generation is not accessible
+        UTEST_ASSERT(map.remove(c) == lsp::STATUS_OK);
+        const lsp::pw::slot_id_t forged = c + (lsp::pw::slot_id_t(1) << 32);
+        UTEST_ASSERT(map.lookup(forged) == NULL);
+
+        // Clear invalidates all identifiers
+        UTEST_ASSERT(map.insert(item_ptr(4), &a) == lsp::STATUS_OK);
+        map.clear();
+        UTEST_ASSERT(map.size() == 0);
+        UTEST_ASSERT(map.lookup(a) == NULL);
+        UTEST_ASSERT(map.lookup(b) == NULL);
+        UTEST_ASSERT(map.insert(item_ptr(5), &c) == lsp::STATUS_OK);
+        UTEST_ASSERT(map.lookup(a) == NULL);
+        UTEST_ASSERT(map.lookup(b) == NULL);
+        UTEST_ASSERT(map.lookup(c) == item_ptr(5));
+
+        UTEST_ASSERT(map.for_each(stop_at, item_ptr(5)) == 42);
+        UTEST_ASSERT(map.for_each(stop_at, item_ptr(6)) == 0);
+
+        map.flush();
+        UTEST_ASSERT(map.size() == 0);
+        UTEST_ASSERT(map.item_id(0) == lsp::pw::SLOT_ID_INVALID);
+    }
+
+    void test_stable()
+    {
+        lsp::pw::SlotMap map;
+        lsp::pw::slot_id_t *ids     = static_cast<lsp::pw::slot_id_t *>(malloc(ITEMS_COUNT * sizeof(lsp::pw::slot_id_t)));
+        void ***ptrs                = static_cast<void ***>(malloc(ITEMS_COUNT * sizeof(void **)));
+        UTEST_ASSERT((ids != NULL) && (ptrs != NULL));
+
+        printf("Testing stable storage and iteration...\n");
+
+        for (size_t i=0; i<ITEMS_COUNT; ++i)
+        {
+            UTEST_ASSERT(map.insert(item_ptr(i), &ids[i]) == lsp::STATUS_OK);
+            ptrs[i]     = map.lookup_ptr(ids[i]);
+            UTEST_ASSERT(ptrs[i] != NULL);
+        }
+
+        // Pointers to slots are not affected by growth
+        uintptr_t sum = 0;
+        for (size_t i=0; i<ITEMS_COUNT; ++i)
+        {
+            UTEST_ASSERT(map.lookup_ptr(ids[i]) == ptrs[i]);
+            UTEST_ASSERT(*ptrs[i] == item_ptr(i));
+            sum    += uintptr_t(item_ptr(i));
+        }
+
+        // Dense array and identifiers
+        UTEST_ASSERT(map.size() == ITEMS_COUNT);
+        for (size_t i=0; i<map.size(); ++i)
+            UTEST_ASSERT(map.lookup(map.item_id(i)) == map.items()[i]);
+
+        walk_t w;
+        w.visited   = 0;
+        w.sum       = 0;
+        UTEST_ASSERT(map.for_each(count_items, &w) == 0);
+        UTEST_ASSERT(w.visited == ITEMS_COUNT);
+        UTEST_ASSERT(w.sum == sum);
+
+        // Remove items during iteration
+        remover_t r;
+        r.map       = &map;
+        r.ids       = ids;
+        r.count     = ITEMS_COUNT;
+        r.removed   = 0;
+        UTEST_ASSERT(map.for_each(remove_current, &r) == 0);
+        UTEST_ASSERT(r.removed == ITEMS_COUNT / 2);
+        UTEST_ASSERT(map.size() == ITEMS_COUNT - r.removed);
+        for (size_t i=0; i<ITEMS_COUNT; ++i)
+        {
+            if (i & 1)
+                UTEST_ASSERT(ids[i] == lsp::pw::SLOT_ID_INVALID);
+            else
+            {
+                UTEST_ASSERT(map.lookup(ids[i]) == item_ptr(i));
+                UTEST_ASSERT(map.lookup_ptr(ids[i]) == ptrs[i]);
+            }
+        }
+
+        free(ids);
+        free(ptrs);
+    }
+
+    void test_random()
+    {
+        lsp::pw::SlotMap map;
+        lsp::pw::slot_id_t *ids     = static_cast<lsp::pw::slot_id_t *>(malloc(ITEMS_COUNT * sizeof(lsp::pw::slot_id_t)));
+        lsp::pw::slot_id_t *stale   = static_cast<lsp::pw::slot_id_t *>(malloc(OPERATIONS * sizeof(lsp::pw::slot_id_t)));
+        UTEST_ASSERT((ids != NULL) && (stale != NULL));
+        size_t n_stale = 0, count = 0;
+
+        printf("Testing random operations...\n");
+
+        for (size_t i=0; i<ITEMS_COUNT; ++i)
+            ids[i]      = lsp::pw::SLOT_ID_INVALID;
+
+        srand(0x51075);
+        for (size_t k=0; k<OPERATIONS; ++k)
+        {
+            const size_t i = rand() % ITEMS_COUNT;
+            if (ids[i] == lsp::pw::SLOT_ID_INVALID)
+            {
+                UTEST_ASSERT(map.insert(item_ptr(i), &ids[i]) == lsp::STATUS_OK);
+                ++count;
+            }
+            else
+            {
+                void *data = NULL;
+                UTEST_ASSERT(map.remove(ids[i], &data) == lsp::STATUS_OK);
+                UTEST_ASSERT(data == item_ptr(i));
+                stale[n_stale++]    = ids[i];
+                ids[i]              = lsp::pw::SLOT_ID_INVALID;
+                --count;
+            }
+
+            UTEST_ASSERT(map.size() == count);
+        }
+
+        for (size_t i=0; i<ITEMS_COUNT; ++i)
+        {
+            if (ids[i] != lsp::pw::SLOT_ID_INVALID)
+                UTEST_ASSERT(map.lookup(ids[i]) == item_ptr(i));
+        }
+        for (size_t i=0; i<n_stale; ++i)
+            UTEST_ASSERT(map.lookup(stale[i]) == NULL);
+        for (size_t i=0; i<map.size(); ++i)
+        {
+            const size_t idx = uintptr_t(map.items()[i]) / 16 - 1;
+            UTEST_ASSERT(idx < ITEMS_COUNT);
+            UTEST_ASSERT(map.item_id(i) == ids[idx]);
+        }
+
+        free(ids);
+        free(stale);
+    }
+
+    UTEST_MAIN
+    {
+        test_basic();
+        test_stable();
+        test_random();
+    }
+
+UTEST_END
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/pw/SmallArray.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+UTEST_BEGIN("3rdparty.pw", small_array)
+
+    typedef struct item_t
+    {
+        uint32_t    key;
+        double      value;
+    } item_t;
+
+    template <class T, size_t N>
+    void check_sequence(lsp::pw::SmallArray<T, N> &a, size_t first, size_t count)
+    {
+        UTEST_ASSERT(a.size() == count);
+        for (size_t i=0; i<count; ++i)
+        {
+            const T *p = a.get(i);
+            UTEST_ASSERT(p != NULL);
+            UTEST_ASSERT_MSG(*p == T(first + i), "Invalid item at index %d", int(i));
+        }
+        UTEST_ASSERT(a.get(count) == NULL);
+    }
+
+    void test_growth()
+    {
+        lsp::pw::SmallArray<uint32_t, 8> a;
+
+        printf("Testing growth...\n");
+
+        UTEST_ASSERT(a.is_empty());
+        UTEST_ASSERT(a.is_inline());
+        UTEST_ASSERT(a.capacity() == 8);
+        UTEST_ASSERT(a.first() == NULL);
+        UTEST_ASSERT(a.last() == NULL);
+        UTEST_ASSERT(!a.pop());
+
+        // Inline storage
+        for (size_t i=0; i<8; ++i)
+            UTEST_ASSERT(a.push(uint32_t(i)));
+        UTEST_ASSERT(a.is_inline());
+        check_sequence(a, 0, 8);
+
+        // Heap storage with geometric growth
+        size_t grows = 0, capacity = a.capacity();
+        for (size_t i=8; i<100000; ++i)
+        {
+            UTEST_ASSERT(a.push(uint32_t(i)));
+            if (a.capacity() != capacity)
+            {
+                capacity    = a.capacity();
+                ++grows;
+            }
+        }
+        printf("  %d items with %d reallocations\n", int(a.size()), int(grows));
+        UTEST_ASSERT(!a.is_inline());
+        UTEST_ASSERT(grows < 40);
+        check_sequence(a, 0, 100000);
+        UTEST_ASSERT(*a.last() == 99999);
+        UTEST_ASSERT(a.failures() == 0);
+
+        // Shrink back to inline storage
+        uint32_t v = 0;
+        while (a.size() > 4)
+            UTEST_ASSERT(a.pop(&v));
+        UTEST_ASSERT(v == 4);
+        UTEST_ASSERT(a.shrink() == lsp::STATUS_OK);
+        UTEST_ASSERT(a.is_inline());
+        UTEST_ASSERT(a.capacity() == 8);
+        check_sequence(a, 0, 4);
+
+        a.flush();
+        UTEST_ASSERT(a.is_empty());
+        UTEST_ASSERT(a.is_inline());
+    }
+
+    void test_insert_remove()
+    {
+        lsp::pw::SmallArray<uint32_t, 4> a;
+
+        printf("Testing insertion and removal...\n");
+
+        uint32_t *p = a.add(3);
+        UTEST_ASSERT(p != NULL);
+        p[0] = 0; p[1] = 4; p[2] = 5;
+
+        p = a.insert(1, 3);
+        UTEST_ASSERT(p != NULL);
+        UTEST_ASSERT(!a.is_inline());
+        p[0] = 1; p[1] = 2; p[2] = 3;
+        check_sequence(a, 0, 6);
+
+        p = a.insert(6);
+        UTEST_ASSERT(p != NULL);
+        *p = 6;
+        check_sequence(a, 0, 7);
+        UTEST_ASSERT(a.insert(8) == NULL);
+
+        UTEST_ASSERT(a.remove(0, 2));
+        check_sequence(a, 2, 5);
+        UTEST_ASSERT(a.remove(4));
+        check_sequence(a, 2, 4);
+        UTEST_ASSERT(!a.remove(4));
+        UTEST_ASSERT(!a.remove(2, 3));
+        UTEST_ASSERT(a.remove(1, 2));
+        UTEST_ASSERT(a.size() == 2);
+        UTEST_ASSERT((*a.uget(0) == 2) && (*a.uget(1) == 5));
+    }
+
+    void test_freeze()
+    {
+        lsp::pw::SmallArray<item_t, 2> a;
+
+        printf("Testing frozen array...\n");
+
+        UTEST_ASSERT(a.reserve(64) == lsp::STATUS_OK);
+        UTEST_ASSERT(a.capacity() == 64);
+        a.freeze();
+        UTEST_ASSERT(a.frozen());
+
+        const item_t *ptr = NULL;
+        for (size_t i=0; i<64; ++i)
+        {
+            item_t it;
+            it.key      = uint32_t(i);
+            it.value    = i * 0.5;
+            UTEST_ASSERT(a.push(it));
+            if (ptr == NULL)
+                ptr     = a.array();
+            UTEST_ASSERT(a.array() == ptr);
+        }
+
+        // Further growth fails and is counted
+        item_t it = { 64, 32.0 };
+        UTEST_ASSERT(!a.push(it));
+        UTEST_ASSERT(a.add(2) == NULL);
+        UTEST_ASSERT(a.insert(0) == NULL);
+        UTEST_ASSERT(a.reserve(128) == lsp::STATUS_BAD_STATE);
+        UTEST_ASSERT(a.failures() == 4);
+        UTEST_ASSERT(a.size() == 64);
+        UTEST_ASSERT(a.array() == ptr);
+        for (size_t i=0; i<64; ++i)
+        {
+            const item_t *p = a.get(i);
+            UTEST_ASSERT((p->key == i) && (p->value == i * 0.5));
+        }
+
+        // Clear keeps the capacity
+        a.clear();
+        UTEST_ASSERT(a.add(64) == ptr);
+        UTEST_ASSERT(a.failures() == 4);
+
+        a.unfreeze();
+        a.reset_failures();
+        UTEST_ASSERT(a.push(it));
+        UTEST_ASSERT(a.failures() == 0);
+        UTEST_ASSERT(a.last()->key == 64);
+    }
+
+    UTEST_MAIN
+    {
+        test_growth();
+        test_insert_remove();
+        test_freeze();
+    }
+
+UTEST_END
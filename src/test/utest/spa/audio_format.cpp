@@ -0,0 +1,351 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/audio_format.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <pw-headers/spa/param/audio/raw-utils.h>
+
+#define MAX_CHANNELS        8
+
+namespace
+{
+    enum byte_order_t
+    {
+        BO_LE,
+        BO_BE,
+        BO_NATIVE
+    };
+
+    typedef struct format_t
+    {
+        uint32_t        format;
+        size_t          bytes;
+        size_t          bits;
+        byte_order_t    order;
+        bool            is_float;
+        bool            planar;
+    } format_t;
+
+    static const format_t formats[] =
+    {
+        { SPA_AUDIO_FORMAT_S16_LE,      2, 16, BO_LE,       false,  false },
+        { SPA_AUDIO_FORMAT_S16_BE,      2, 16, BO_BE,       false,  false },
+        { SPA_AUDIO_FORMAT_S24_32_LE,   4, 24, BO_LE,       false,  false },
+        { SPA_AUDIO_FORMAT_S24_32_BE,   4, 24, BO_BE,       false,  false },
+        { SPA_AUDIO_FORMAT_S32_LE,      4, 32, BO_LE,       false,  false },
+        { SPA_AUDIO_FORMAT_S32_BE,      4, 32, BO_BE,       false,  false },
+        { SPA_AUDIO_FORMAT_S24_LE,      3, 24, BO_LE,       false,  false },
+        { SPA_AUDIO_FORMAT_S24_BE,      3, 24, BO_BE,       false,  false },
+        { SPA_AUDIO_FORMAT_F32_LE,      4, 32, BO_LE,       true,   false },
+        { SPA_AUDIO_FORMAT_F32_BE,      4, 32, BO_BE,       true,   false },
+        { SPA_AUDIO_FORMAT_F64_LE,      8, 64, BO_LE,       true,   false },
+        { SPA_AUDIO_FORMAT_F64_BE,      8, 64, BO_BE,       true,   false },
+        { SPA_AUDIO_FORMAT_S16P,        2, 16, BO_NATIVE,   false,  true  },
+        { SPA_AUDIO_FORMAT_S24_32P,     4, 24, BO_NATIVE,   false,  true  },
+        { SPA_AUDIO_FORMAT_S32P,        4, 32, BO_NATIVE,   false,  true  },
+        { SPA_AUDIO_FORMAT_S24P,        3, 24, BO_NATIVE,   false,  true  },
+        { SPA_AUDIO_FORMAT_F32P,        4, 32, BO_NATIVE,   true,   true  },
+        { SPA_AUDIO_FORMAT_F64P,        8, 64, BO_NATIVE,   true,   true  },
+    };
+
+    static const size_t channel_counts[]    = { 1, 2, 3, MAX_CHANNELS };
+    static const size_t frame_counts[]      = { 0, 1, 3, 7, 8, 33, 1001 };
+
+    static bool is_big_endian(const format_t *f)
+    {
+        if (f->order != BO_NATIVE)
+            return f->order == BO_BE;
+        const uint16_t v = 1;
+        uint8_t b;
+        memcpy(&b, &v, sizeof(b));
+        return b == 0;
+    }
+
+    /**
+     * Reference conversion of the encoded sample to float
+     */
+    static float ref_decode(const format_t *f, const uint8_t *p)
+    {
+        const bool be   = is_big_endian(f);
+        uint64_t v      = 0;
+        for (size_t i=0; i<f->bytes; ++i)
+            v          |= uint64_t(p[(be) ? i : f->bytes - i - 1]) << ((f->bytes - i - 1) * 8);
+
+        if (f->is_float)
+        {
+            if (f->bytes == 4)
+            {
+                const uint32_t u = uint32_t(v);
+                float r;
+                memcpy(&r, &u, sizeof(r));
+                return r;
+            }
+            double r;
+            memcpy(&r, &v, sizeof(r));
+            return float(r);
+        }
+
+        // Sign-extend significant bits, the padding bits are ignored
+        int64_t x       = int64_t(v << (64 - f->bits)) >> (64 - f->bits);
+        return float(ldexp(double(x), -int(f->bits - 1)));
+    }
+
+    /**
+     * Reference conversion of float to the encoded sample
+     */
+    static void ref_encode(const format_t *f, uint8_t *p, float s)
+    {
+        const bool be   = is_big_endian(f);
+        uint64_t v;
+
+        if (f->is_float)
+        {
+            if (f->bytes == 4)
+            {
+                uint32_t u;
+                memcpy(&u, &s, sizeof(u));
+                v               = u;
+            }
+            else
+            {
+                const double d  = s;
+                memcpy(&v, &d, sizeof(v));
+            }
+        }
+        else
+        {
+            const double max    = ldexp(1.0, int(f->bits - 1));
+            double x            = ldexp(double(s), int(f->bits - 1));
+            if (isnan(x))
+                x                   = -max;
+            x                   = lsp_limit(x, -max, max - 1.0);
+            v                   = uint64_t(int64_t(nearbyint(x)));
+        }
+
+        for (size_t i=0; i<f->bytes; ++i)
+            p[(be) ? f->bytes - i - 1 : i] = uint8_t(v >> (i * 8));
+    }
+} /* namespace */
+
+UTEST_BEGIN("3rdparty.spa", audio_format)
+
+    void test_descriptors()
+    {
+        printf("Testing format descriptors...\n");
+
+        for (size_t i=0; i<sizeof(formats)/sizeof(formats[0]); ++i)
+        {
+            const format_t *f = &formats[i];
+            const lsp::spa::audio_format_desc_t *d = lsp::spa::audio_format_desc(f->format);
+            UTEST_ASSERT(d != NULL);
+            UTEST_ASSERT(d->format == f->format);
+            UTEST_ASSERT(d->name != NULL);
+            UTEST_ASSERT(d->sample_size == f->bytes);
+            UTEST_ASSERT(d->bits == f->bits);
+            UTEST_ASSERT(d->planar == f->planar);
+            UTEST_ASSERT(d->big_endian == is_big_endian(f));
+            UTEST_ASSERT(d->is_float == f->is_float);
+            UTEST_ASSERT((d->read != NULL) && (d->write != NULL));
+        }
+
+        UTEST_ASSERT(lsp::spa::audio_format_desc(SPA_AUDIO_FORMAT_UNKNOWN) == NULL);
+        UTEST_ASSERT(lsp::spa::audio_format_desc(SPA_AUDIO_FORMAT_U8) == NULL);
+        UTEST_ASSERT(lsp::spa::audio_format_desc(SPA_AUDIO_FORMAT_S8P) == NULL);
+    }
+
+    void test_negotiation()
+    {
+        printf("Testing converter initialization...\n");
+
+        uint8_t buffer[0x400];
+        struct spa_pod_builder b = SPA_POD_BUILDER_INIT(buffer, sizeof(buffer));
+        struct spa_audio_info_raw info;
+        lsp::spa::audio_converter_t conv;
+
+        memset(&info, 0, sizeof(info));
+        info.format     = SPA_AUDIO_FORMAT_S24_LE;
+        info.rate       = 96000;
+        info.channels   = 6;
+        const struct spa_pod *pod = spa_format_audio_raw_build(&b, SPA_PARAM_Format, &info);
+        UTEST_ASSERT(pod != NULL);
+
+        UTEST_ASSERT(lsp::spa::audio_converter_init(&conv, pod) == lsp::STATUS_OK);
+        UTEST_ASSERT(conv.desc == lsp::spa::audio_format_desc(SPA_AUDIO_FORMAT_S24_LE));
+        UTEST_ASSERT(conv.rate == 96000);
+        UTEST_ASSERT(conv.channels == 6);
+        UTEST_ASSERT(conv.blocks == 1);
+        UTEST_ASSERT(conv.stride == 18);
+
+        info.format     = SPA_AUDIO_FORMAT_F64P;
+        UTEST_ASSERT(lsp::spa::audio_converter_init(&conv, &info) == lsp::STATUS_OK);
+        UTEST_ASSERT(conv.blocks == 6);
+        UTEST_ASSERT(conv.stride == 8);
+
+        info.format     = SPA_AUDIO_FORMAT_U16_LE;
+        UTEST_ASSERT(lsp::spa::audio_converter_init(&conv, &info) == lsp::STATUS_UNSUPPORTED_FORMAT);
+
+        info.format     = SPA_AUDIO_FORMAT_S16_LE;
+        info.channels   = 0;
+        UTEST_ASSERT(lsp::spa::audio_converter_init(&conv, &info) == lsp::STATUS_BAD_FORMAT);
+
+        // Non-audio format
+        b               = SPA_POD_BUILDER_INIT(buffer, sizeof(buffer));
+        pod             = static_cast<const struct spa_pod *>(spa_pod_builder_add_object(&b,
+            SPA_TYPE_OBJECT_Format, SPA_PARAM_Format,
+            SPA_FORMAT_mediaType,       SPA_POD_Id(SPA_MEDIA_TYPE_video),
+            SPA_FORMAT_mediaSubtype,    SPA_POD_Id(SPA_MEDIA_SUBTYPE_raw)));
+        UTEST_ASSERT(pod != NULL);
+        UTEST_ASSERT(lsp::spa::audio_converter_init(&conv, pod) == lsp::STATUS_UNSUPPORTED_FORMAT);
+
+        // Not a format object
+        const struct spa_pod_int ival = SPA_POD_INIT_Int(1);
+        UTEST_ASSERT(lsp::spa::audio_converter_init(&conv, &ival.pod) == lsp::STATUS_BAD_FORMAT);
+    }
+
+    float random_sample(size_t i)
+    {
+        static const float special[] =
+        {
+            0.0f, -0.0f, 1.0f, -1.0f, 0.5f, -0.5f, 1.5f, -1.5f,
+            1e+10f, -1e+10f, 0.99999994f, -0.99999994f, 1e-10f, -1e-10f,
+            INFINITY, -INFINITY, NAN
+        };
+        const size_t n = sizeof(special)/sizeof(special[0]);
+        if ((i % 5) == 0)
+            return special[(i / 5) % n];
+        return (float(rand()) / float(RAND_MAX)) * 2.2f - 1.1f;
+    }
+
+    void test_format(const format_t *f, size_t channels, size_t frames)
+    {
+        const size_t samples    = channels * frames;
+        const size_t bytes      = samples * f->bytes;
+        uint8_t *raw            = static_cast<uint8_t *>(malloc(bytes + 1));
+        uint8_t *ref            = static_cast<uint8_t *>(malloc(bytes + 1));
+        float *pcm              = static_cast<float *>(malloc((samples + 1) * sizeof(float)));
+        float *out              = static_cast<float *>(malloc((samples + 1) * sizeof(float)));
+        UTEST_ASSERT((raw != NULL) && (ref != NULL) && (pcm != NULL) && (out != NULL));
+
+        struct spa_audio_info_raw info;
+        memset(&info, 0, sizeof(info));
+        info.format     = static_cast<enum spa_audio_format>(f->format);
+        info.rate       = 48000;
+        info.channels   = uint32_t(channels);
+
+        lsp::spa::audio_converter_t conv;
+        UTEST_ASSERT(lsp::spa::audio_converter_init(&conv, &info) == lsp::STATUS_OK);
+        UTEST_ASSERT(conv.blocks == ((f->planar) ? channels : 1));
+
+        // Setup buffer pointers
+        void *raw_ptr[MAX_CHANNELS];
+        const void *craw_ptr[MAX_CHANNELS];
+        float *pcm_ptr[MAX_CHANNELS];
+        const float *cpcm_ptr[MAX_CHANNELS];
+        for (size_t i=0; i<channels; ++i)
+        {
+            raw_ptr[i]      = &raw[(f->planar) ? i * frames * f->bytes : 0];
+            craw_ptr[i]     = raw_ptr[i];
+            pcm_ptr[i]      = &out[i * frames];
+            cpcm_ptr[i]     = &pcm[i * frames];
+        }
+
+        // Offset of the sample in the raw buffer
+        auto offset = [&](size_t ch, size_t frame) -> size_t {
+            return ((f->planar) ? ch * frames + frame : frame * channels + ch) * f->bytes;
+        };
+
+        // Read: random encoded data
+        if (f->is_float)
+        {
+            for (size_t i=0; i<samples; ++i)
+                ref_encode(f, &raw[i * f->bytes], random_sample(i + 1));
+        }
+        else
+        {
+            for (size_t i=0; i<bytes; ++i)
+                raw[i]          = uint8_t(rand());
+        }
+        raw[bytes]          = 0x5a;
+        out[samples]        = 42.0f;
+
+        lsp::spa::audio_convert_read(&conv, pcm_ptr, craw_ptr, frames);
+        UTEST_ASSERT(out[samples] == 42.0f);
+        for (size_t ch=0; ch<channels; ++ch)
+            for (size_t i=0; i<frames; ++i)
+            {
+                const float expected    = ref_decode(f, &raw[offset(ch, i)]);
+                const float actual      = pcm_ptr[ch][i];
+                UTEST_ASSERT_MSG(memcmp(&expected, &actual, sizeof(float)) == 0,
+                    "Read mismatch format=%s channels=%d frames=%d ch=%d frame=%d: expected=%.9g actual=%.9g",
+                    conv.desc->name, int(channels), int(frames), int(ch), int(i), expected, actual);
+            }
+
+        // Write: random samples including special values
+        for (size_t i=0; i<samples; ++i)
+            pcm[i]              = random_sample(i);
+        for (size_t ch=0; ch<channels; ++ch)
+            for (size_t i=0; i<frames; ++i)
+                ref_encode(f, &ref[offset(ch, i)], cpcm_ptr[ch][i]);
+
+        memset(raw, 0xa5, bytes + 1);
+        lsp::spa::audio_convert_write(&conv, raw_ptr, cpcm_ptr, frames);
+        UTEST_ASSERT(raw[bytes] == 0xa5);
+        for (size_t ch=0; ch<channels; ++ch)
+            for (size_t i=0; i<frames; ++i)
+            {
+                const size_t off    = offset(ch, i);
+                UTEST_ASSERT_MSG(memcmp(&raw[off], &ref[off], f->bytes) == 0,
+                    "Write mismatch format=%s channels=%d frames=%d ch=%d frame=%d sample=%.9g",
+                    conv.desc->name, int(channels), int(frames), int(ch), int(i), cpcm_ptr[ch][i]);
+            }
+
+        free(raw);
+        free(ref);
+        free(pcm);
+        free(out);
+    }
+
+    void test_conversion()
+    {
+        for (size_t i=0; i<sizeof(formats)/sizeof(formats[0]); ++i)
+        {
+            const format_t *f = &formats[i];
+            printf("Testing conversion of %s...\n", lsp::spa::audio_format_desc(f->format)->name);
+
+            for (size_t j=0; j<sizeof(channel_counts)/sizeof(channel_counts[0]); ++j)
+                for (size_t k=0; k<sizeof(frame_counts)/sizeof(frame_counts[0]); ++k)
+                    test_format(f, channel_counts[j], frame_counts[k]);
+        }
+    }
+
+    UTEST_MAIN
+    {
+        srand(0x35);
+        test_descriptors();
+        test_negotiation();
+        test_conversion();
+    }
+
+UTEST_END
@@ -0,0 +1,428 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/audio_passthrough.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#define MAX_CHANNELS        6
+#define MAX_BYTES           1024
+
+namespace
+{
+    static uint8_t ref_reverse(uint8_t v)
+    {
+        uint8_t r = 0;
+        for (size_t i=0; i<8; ++i)
+            if (v & (1 << i))
+                r      |= 0x80 >> i;
+        return r;
+    }
+
+    static uint16_t word_at(const void *buf, size_t index)
+    {
+        uint16_t v;
+        memcpy(&v, static_cast<const uint8_t *>(buf) + index * 2, sizeof(v));
+        return v;
+    }
+
+    static struct spa_audio_info_dsd dsd_info(uint32_t channels, int32_t interleave, bool lsb)
+    {
+        struct spa_audio_info_dsd info;
+        memset(&info, 0, sizeof(info));
+        info.bitorder   = (lsb) ? SPA_PARAM_BITORDER_lsb : SPA_PARAM_BITORDER_msb;
+        info.interleave = interleave;
+        info.rate       = 352800;
+        info.channels   = channels;
+        return info;
+    }
+} /* namespace */
+
+UTEST_BEGIN("3rdparty.spa", audio_passthrough)
+
+    void test_reverse_bits()
+    {
+        printf("Testing bit reversal...\n");
+
+        static const uint8_t src[] = { 0x01, 0x12, 0xf0, 0x80, 0xa5, 0x3c };
+        static const uint8_t gold[] = { 0x80, 0x48, 0x0f, 0x01, 0xa5, 0x3c };
+        uint8_t dst[sizeof(src)];
+        lsp::spa::dsd_reverse_bits(dst, src, sizeof(src));
+        UTEST_ASSERT(memcmp(dst, gold, sizeof(gold)) == 0);
+
+        uint8_t buf[MAX_BYTES], out[MAX_BYTES];
+        for (size_t i=0; i<MAX_BYTES; ++i)
+            buf[i]      = uint8_t(rand());
+
+        for (size_t len=0; len<64; ++len)
+        {
+            lsp::spa::dsd_reverse_bits(out, &buf[len], len * 13);
+            for (size_t i=0; i<len * 13; ++i)
+                UTEST_ASSERT_MSG(out[i] == ref_reverse(buf[len + i]), "len=%d i=%d", int(len * 13), int(i));
+        }
+
+        // In-place
+        memcpy(out, buf, MAX_BYTES);
+        lsp::spa::dsd_reverse_bits(out, out, MAX_BYTES);
+        for (size_t i=0; i<MAX_BYTES; ++i)
+            UTEST_ASSERT(out[i] == ref_reverse(buf[i]));
+    }
+
+    void test_layout()
+    {
+        printf("Testing DSD layout...\n");
+
+        lsp::spa::dsd_layout_t l;
+        struct spa_audio_info_dsd info = dsd_info(2, -4, true);
+        UTEST_ASSERT(lsp::spa::dsd_layout_init(&l, &info) == lsp::STATUS_OK);
+        UTEST_ASSERT(l.channels == 2);
+        UTEST_ASSERT(l.group == 4);
+        UTEST_ASSERT(l.reverse_bytes);
+        UTEST_ASSERT(l.lsb_first);
+        UTEST_ASSERT(lsp::spa::dsd_layout_blocks(&l) == 1);
+
+        info            = dsd_info(3, 0, false);
+        UTEST_ASSERT(lsp::spa::dsd_layout_init(&l, &info) == lsp::STATUS_OK);
+        UTEST_ASSERT(l.group == 0);
+        UTEST_ASSERT(!l.reverse_bytes);
+        UTEST_ASSERT(!l.lsb_first);
+        UTEST_ASSERT(lsp::spa::dsd_layout_blocks(&l) == 3);
+
+        info            = dsd_info(0, 4, false);
+        UTEST_ASSERT(lsp::spa::dsd_layout_init(&l, &info) == lsp::STATUS_BAD_FORMAT);
+
+        // Unknown bit order as it may come from the format pod, the raw value is written
+        // without storing invalid value to the enum
+        const uint32_t bitorder = 100;
+        info            = dsd_info(2, 4, false);
+        memcpy(&info.bitorder, &bitorder, sizeof(bitorder));
+        UTEST_ASSERT(lsp::spa::dsd_layout_init(&l, &info) == lsp::STATUS_BAD_FORMAT);
+    }
+
+    void check_golden(int32_t interleave, bool lsb, const uint8_t *gold)
+    {
+        static const uint8_t left[]     = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 };
+        static const uint8_t right[]    = { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17 };
+        const uint8_t *planes[]         = { left, right };
+
+        lsp::spa::dsd_layout_t l;
+        struct spa_audio_info_dsd info  = dsd_info(2, interleave, lsb);
+        UTEST_ASSERT(lsp::spa::dsd_layout_init(&l, &info) == lsp::STATUS_OK);
+
+        uint8_t packed[16];
+        void *pptr[]                    = { packed };
+        const void *cpptr[]             = { packed };
+        UTEST_ASSERT(lsp::spa::dsd_pack(&l, pptr, planes, 8) == 8);
+        UTEST_ASSERT_MSG(memcmp(packed, gold, sizeof(packed)) == 0, "pack interleave=%d lsb=%d", int(interleave), int(lsb));
+
+        uint8_t ul[8], ur[8];
+        uint8_t *uptr[]                 = { ul, ur };
+        UTEST_ASSERT(lsp::spa::dsd_unpack(&l, uptr, cpptr, 8) == 8);
+        UTEST_ASSERT_MSG(memcmp(ul, left, 8) == 0, "unpack interleave=%d lsb=%d", int(interleave), int(lsb));
+        UTEST_ASSERT_MSG(memcmp(ur, right, 8) == 0, "unpack interleave=%d lsb=%d", int(interleave), int(lsb));
+    }
+
+    void test_dsd_golden()
+    {
+        printf("Testing DSD golden vectors...\n");
+
+        static const uint8_t i1[]   = { 0x00, 0x10, 0x01, 0x11, 0x02, 0x12, 0x03, 0x13, 0x04, 0x14, 0x05, 0x15, 0x06, 0x16, 0x07, 0x17 };
+        static const uint8_t i2[]   = { 0x00, 0x01, 0x10, 0x11, 0x02, 0x03, 0x12, 0x13, 0x04, 0x05, 0x14, 0x15, 0x06, 0x07, 0x16, 0x17 };
+        static const uint8_t i4[]   = { 0x00, 0x01, 0x02, 0x03, 0x10, 0x11, 0x12, 0x13, 0x04, 0x05, 0x06, 0x07, 0x14, 0x15, 0x16, 0x17 };
+        static const uint8_t r4[]   = { 0x03, 0x02, 0x01, 0x00, 0x13, 0x12, 0x11, 0x10, 0x07, 0x06, 0x05, 0x04, 0x17, 0x16, 0x15, 0x14 };
+        static const uint8_t r4l[]  = { 0xc0, 0x40, 0x80, 0x00, 0xc8, 0x48, 0x88, 0x08, 0xe0, 0x60, 0xa0, 0x20, 0xe8, 0x68, 0xa8, 0x28 };
+        static const uint8_t i8[]   = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17 };
+
+        check_golden(1, false, i1);
+        check_golden(-1, false, i1);
+        check_golden(2, false, i2);
+        check_golden(4, false, i4);
+        check_golden(-4, false, r4);
+        check_golden(-4, true, r4l);
+        check_golden(8, false, i8);
+    }
+
+    void test_dsd_roundtrip()
+    {
+        printf("Testing DSD layout round trip...\n");
+
+        static const int32_t interleaves[] = { 0, 1, 2, -2, 3, -3, 4, -4, 8, -8 };
+        static const size_t channels[] = { 1, 2, MAX_CHANNELS };
+
+        uint8_t *src[MAX_CHANNELS], *dst[MAX_CHANNELS];
+        void *packed[MAX_CHANNELS];
+        const void *cpacked[MAX_CHANNELS];
+        for (size_t i=0; i<MAX_CHANNELS; ++i)
+        {
+            src[i]      = static_cast<uint8_t *>(malloc(MAX_BYTES));
+            dst[i]      = static_cast<uint8_t *>(malloc(MAX_BYTES));
+            packed[i]   = malloc(MAX_BYTES * MAX_CHANNELS);
+            cpacked[i]  = packed[i];
+            UTEST_ASSERT((src[i] != NULL) && (dst[i] != NULL) && (packed[i] != NULL));
+            for (size_t j=0; j<MAX_BYTES; ++j)
+                src[i][j]   = uint8_t(rand());
+        }
+
+        for (size_t i=0; i<sizeof(interleaves)/sizeof(interleaves[0]); ++i)
+            for (size_t j=0; j<sizeof(channels)/sizeof(channels[0]); ++j)
+                for (size_t lsb=0; lsb<2; ++lsb)
+                {
+                    lsp::spa::dsd_layout_t l;
+                    struct spa_audio_info_dsd info = dsd_info(uint32_t(channels[j]), interleaves[i], lsb);
+                    UTEST_ASSERT(lsp::spa::dsd_layout_init(&l, &info) == lsp::STATUS_OK);
+
+                    const size_t bytes      = MAX_BYTES - 1;
+                    const size_t expected   = (l.group > 0) ? bytes - bytes % l.group : bytes;
+                    UTEST_ASSERT(lsp::spa::dsd_pack(&l, packed, src, bytes) == expected);
+
+                    // Check position of each byte in the packed buffer
+                    for (size_t c=0; c<l.channels; ++c)
+                        for (size_t k=0; k<expected; ++k)
+                        {
+                            size_t block = c, off = k;
+                            if (l.group > 0)
+                            {
+                                const size_t g      = k / l.group;
+                                const size_t b      = k % l.group;
+                                block               = 0;
+                                off                 = (g * l.channels + c) * l.group + ((l.reverse_bytes) ? l.group - b - 1 : b);
+                            }
+                            const uint8_t v     = static_cast<const uint8_t *>(packed[block])[off];
+                            UTEST_ASSERT_MSG(v == ((lsb) ? ref_reverse(src[c][k]) : src[c][k]),
+                                "interleave=%d channels=%d lsb=%d c=%d k=%d",
+                                int(interleaves[i]), int(channels[j]), int(lsb), int(c), int(k));
+                        }
+
+                    UTEST_ASSERT(lsp::spa::dsd_unpack(&l, dst, cpacked, bytes) == expected);
+                    for (size_t c=0; c<l.channels; ++c)
+                        UTEST_ASSERT(memcmp(dst[c], src[c], expected) == 0);
+                }
+
+        for (size_t i=0; i<MAX_CHANNELS; ++i)
+        {
+            free(src[i]);
+            free(dst[i]);
+            free(packed[i]);
+        }
+    }
+
+    void test_dop()
+    {
+        printf("Testing DoP encoding...\n");
+
+        // Golden vector
+        static const uint8_t left[]     = { 0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc };
+        static const uint8_t right[]    = { 0xab, 0xcd, 0xef, 0x01, 0x23, 0x45 };
+        static const uint32_t gold[]    =
+        {
+            0x05123400, 0x05abcd00,
+            0xfa567800, 0xfaef0100,
+            0x059abc00, 0x05234500,
+        };
+        const uint8_t *src[]            = { left, right };
+        int32_t frames[6];
+
+        lsp::spa::dop_state_t st;
+        lsp::spa::dop_init(&st);
+        lsp::spa::dop_encode(&st, frames, src, 2, 2);
+        UTEST_ASSERT(st.marker == lsp::spa::DOP_MARKER_1);
+        const uint8_t *tail[]           = { &left[4], &right[4] };
+        lsp::spa::dop_encode(&st, &frames[4], tail, 2, 1);
+        UTEST_ASSERT(st.marker == lsp::spa::DOP_MARKER_2);
+        for (size_t i=0; i<6; ++i)
+            UTEST_ASSERT_MSG(uint32_t(frames[i]) == gold[i], "i=%d value=0x%08x", int(i), unsigned(frames[i]));
+
+        uint8_t dl[6], dr[6];
+        uint8_t *dst[]                  = { dl, dr };
+        lsp::spa::dop_init(&st);
+        UTEST_ASSERT(lsp::spa::dop_decode(&st, dst, frames, 2, 3) == 3);
+        UTEST_ASSERT(memcmp(dl, left, 6) == 0);
+        UTEST_ASSERT(memcmp(dr, right, 6) == 0);
+        UTEST_ASSERT(st.marker == lsp::spa::DOP_MARKER_2);
+
+        // Continuing stream starting with wrong marker
+        UTEST_ASSERT(lsp::spa::dop_decode(&st, dst, frames, 2, 3) == 0);
+        UTEST_ASSERT(st.marker == 0);
+
+        // Broken marker in the middle and PCM data
+        frames[3]                       = 0x00ef0100;
+        UTEST_ASSERT(lsp::spa::dop_decode(&st, dst, frames, 2, 3) == 1);
+        UTEST_ASSERT(st.marker == 0);
+        memset(frames, 0, sizeof(frames));
+        UTEST_ASSERT(lsp::spa::dop_decode(&st, dst, frames, 2, 3) == 0);
+    }
+
+    void test_dop_roundtrip()
+    {
+        printf("Testing DoP round trip...\n");
+
+        static const size_t channels[] = { 1, 2, 3, MAX_CHANNELS };
+        static const size_t counts[] = { 1, 7, 8, 9, 100, 333 };
+
+        uint8_t *src[MAX_CHANNELS], *dst[MAX_CHANNELS];
+        int32_t *pcm    = static_cast<int32_t *>(malloc(MAX_BYTES * MAX_CHANNELS * sizeof(int32_t)));
+        UTEST_ASSERT(pcm != NULL);
+        for (size_t i=0; i<MAX_CHANNELS; ++i)
+        {
+            src[i]      = static_cast<uint8_t *>(malloc(MAX_BYTES));
+            dst[i]      = static_cast<uint8_t *>(malloc(MAX_BYTES));
+            UTEST_ASSERT((src[i] != NULL) && (dst[i] != NULL));
+            for (size_t j=0; j<MAX_BYTES; ++j)
+                src[i][j]   = uint8_t(rand());
+        }
+
+        for (size_t i=0; i<sizeof(channels)/sizeof(channels[0]); ++i)
+        {
+            const size_t nc = channels[i];
+            lsp::spa::dop_state_t enc, dec;
+            lsp::spa::dop_init(&enc);
+            lsp::spa::dop_init(&dec);
+
+            // Encode in chunks of different size to check marker continuity
+            size_t frame    = 0;
+            for (size_t j=0; j<sizeof(counts)/sizeof(counts[0]); ++j)
+            {
+                const uint8_t *s[MAX_CHANNELS];
+                uint8_t *d[MAX_CHANNELS];
+                for (size_t c=0; c<nc; ++c)
+                {
+                    s[c]        = &src[c][frame * 2];
+                    d[c]        = &dst[c][frame * 2];
+                }
+
+                lsp::spa::dop_encode(&enc, pcm, s, nc, counts[j]);
+                for (size_t k=0; k<counts[j]; ++k)
+                    for (size_t c=0; c<nc; ++c)
+                    {
+                        const uint32_t v    = uint32_t(pcm[k * nc + c]);
+                        const uint32_t m    = ((frame + k) & 1) ? lsp::spa::DOP_MARKER_2 : lsp::spa::DOP_MARKER_1;
+                        const uint32_t e    = (m << 24) | (uint32_t(s[c][k*2]) << 16) | (uint32_t(s[c][k*2 + 1]) << 8);
+                        UTEST_ASSERT_MSG(v == e, "channels=%d frame=%d channel=%d: 0x%08x != 0x%08x",
+                            int(nc), int(frame + k), int(c), unsigned(v), unsigned(e));
+                    }
+
+                UTEST_ASSERT(lsp::spa::dop_decode(&dec, d, pcm, nc, counts[j]) == counts[j]);
+                frame          += counts[j];
+            }
+
+            for (size_t c=0; c<nc; ++c)
+                UTEST_ASSERT(memcmp(src[c], dst[c], frame * 2) == 0);
+        }
+
+        for (size_t i=0; i<MAX_CHANNELS; ++i)
+        {
+            free(src[i]);
+            free(dst[i]);
+        }
+        free(pcm);
+    }
+
+    void test_iec61937()
+    {
+        printf("Testing IEC 61937 bursts...\n");
+
+        lsp::spa::iec61937_t enc;
+        struct spa_audio_info_iec958 info;
+        memset(&info, 0, sizeof(info));
+        info.rate       = 48000;
+
+        info.codec      = SPA_AUDIO_IEC958_CODEC_PCM;
+        UTEST_ASSERT(lsp::spa::iec61937_init(&enc, &info) == lsp::STATUS_UNSUPPORTED_FORMAT);
+        info.codec      = SPA_AUDIO_IEC958_CODEC_TRUEHD;
+        UTEST_ASSERT(lsp::spa::iec61937_init(&enc, &info) == lsp::STATUS_UNSUPPORTED_FORMAT);
+        info.codec      = SPA_AUDIO_IEC958_CODEC_AC3;
+        UTEST_ASSERT(lsp::spa::iec61937_init(&enc, &info) == lsp::STATUS_OK);
+        UTEST_ASSERT(enc.data_type == 1);
+        UTEST_ASSERT(enc.period == 1536);
+        UTEST_ASSERT(lsp::spa::iec61937_burst_size(&enc) == 6144);
+
+        // Golden burst: preamble, big-endian payload words and zero padding
+        static const uint8_t frame[]    = { 0x0b, 0x77, 0xaa, 0xbb, 0xcc };
+        static const uint16_t gold[]    = { 0xf872, 0x4e1f, 0x0001, 0x0028, 0x0b77, 0xaabb, 0xcc00 };
+        const size_t size               = lsp::spa::iec61937_burst_size(&enc);
+        uint8_t *buf                    = static_cast<uint8_t *>(malloc(size + 16));
+        UTEST_ASSERT(buf != NULL);
+
+        memset(buf, 0x55, size + 16);
+        uint8_t *burst                  = &buf[6];
+        UTEST_ASSERT(lsp::spa::iec61937_pack(&enc, burst, size, frame, sizeof(frame)) == lsp::STATUS_OK);
+        for (size_t i=0; i<sizeof(gold)/sizeof(gold[0]); ++i)
+            UTEST_ASSERT_MSG(word_at(burst, i) == gold[i], "i=%d value=0x%04x", int(i), unsigned(word_at(burst, i)));
+        for (size_t i=sizeof(gold); i<size; ++i)
+            UTEST_ASSERT(burst[i] == 0);
+        UTEST_ASSERT(burst[size] == 0x55);
+
+        UTEST_ASSERT(lsp::spa::iec61937_pack(&enc, burst, size - 1, frame, sizeof(frame)) == lsp::STATUS_OVERFLOW);
+        UTEST_ASSERT(lsp::spa::iec61937_pack(&enc, burst, size, buf, size - lsp::spa::IEC61937_HEADER_SIZE + 1) == lsp::STATUS_TOO_BIG);
+
+        // Unpack from the stream with leading silence
+        memset(buf, 0, 6);
+        uint8_t payload[0x10];
+        lsp::spa::iec61937_burst_t b;
+        UTEST_ASSERT(lsp::spa::iec61937_unpack(&b, payload, sizeof(payload), buf, size + 6) == lsp::STATUS_OK);
+        UTEST_ASSERT(b.data_type == 1);
+        UTEST_ASSERT(b.pc == 1);
+        UTEST_ASSERT(b.offset == 6);
+        UTEST_ASSERT(b.length == sizeof(frame));
+        UTEST_ASSERT(b.end == 6 + 8 + 6);
+        UTEST_ASSERT(memcmp(payload, frame, sizeof(frame)) == 0);
+
+        UTEST_ASSERT(lsp::spa::iec61937_unpack(&b, payload, 4, buf, size + 6) == lsp::STATUS_OVERFLOW);
+        UTEST_ASSERT(lsp::spa::iec61937_unpack(&b, payload, sizeof(payload), buf, 18) == lsp::STATUS_EOF);
+        UTEST_ASSERT(lsp::spa::iec61937_unpack(&b, payload, sizeof(payload), buf, 6) == lsp::STATUS_NOT_FOUND);
+
+        // E-AC-3 uses length in bytes
+        info.codec      = SPA_AUDIO_IEC958_CODEC_EAC3;
+        UTEST_ASSERT(lsp::spa::iec61937_init(&enc, &info) == lsp::STATUS_OK);
+        UTEST_ASSERT(enc.data_type == 21);
+        UTEST_ASSERT(lsp::spa::iec61937_burst_size(&enc) == 24576);
+        uint8_t *ebuf                   = static_cast<uint8_t *>(malloc(lsp::spa::iec61937_burst_size(&enc)));
+        UTEST_ASSERT(ebuf != NULL);
+
+        uint8_t eframe[1001], eout[1001];
+        for (size_t i=0; i<sizeof(eframe); ++i)
+            eframe[i]       = uint8_t(rand());
+        UTEST_ASSERT(lsp::spa::iec61937_pack(&enc, ebuf, lsp::spa::iec61937_burst_size(&enc), eframe, sizeof(eframe)) == lsp::STATUS_OK);
+        UTEST_ASSERT(word_at(ebuf, 2) == 21);
+        UTEST_ASSERT(word_at(ebuf, 3) == sizeof(eframe));
+        UTEST_ASSERT(word_at(ebuf, 4) == ((uint16_t(eframe[0]) << 8) | eframe[1]));
+        UTEST_ASSERT(lsp::spa::iec61937_unpack(&b, eout, sizeof(eout), ebuf, lsp::spa::iec61937_burst_size(&enc)) == lsp::STATUS_OK);
+        UTEST_ASSERT(b.length == sizeof(eframe));
+        UTEST_ASSERT(memcmp(eout, eframe, sizeof(eframe)) == 0);
+
+        free(ebuf);
+        free(buf);
+    }
+
+    UTEST_MAIN
+    {
+        srand(0x36);
+        test_reverse_bits();
+        test_layout();
+        test_dsd_golden();
+        test_dsd_roundtrip();
+        test_dop();
+        test_dop_roundtrip();
+        test_iec61937();
+    }
+
+UTEST_END
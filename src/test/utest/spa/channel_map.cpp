@@ -0,0 +1,423 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/channel_map.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <clap/ext/surround.h>
+#include <steinberg/vst3/vst/Speaker.h>
+
+#define MAX_CHANNELS        64
+
+namespace
+{
+    using namespace Steinberg::Vst::SpeakerArr;
+
+    static const Steinberg::Vst::SpeakerArrangement arrangements[] =
+    {
+        kMono, kStereo, kStereoWide, kStereoSurround, kStereoCenter, kStereoSide, kStereoCLfe,
+        kStereoTF, kStereoTS, kStereoTR, kStereoBF, kCineFront, k30Cine, k31Cine, k30Music,
+        k31Music, k40Cine, k41Cine, k40Music, k41Music, k50, k51, k60Cine, k61Cine, k60Music,
+        k61Music, k70Cine, k71Cine, k71CineFullFront, k70Music, k71Music, k71CineFullRear,
+        k71CineSideFill, k71Proximity, k80Cine, k81Cine, k80Music, k81Music, k90Cine, k91Cine,
+        k100Cine, k101Cine, kAmbi1stOrderACN, kAmbi2cdOrderACN, kAmbi3rdOrderACN, kAmbi4thOrderACN,
+        kAmbi5thOrderACN, kAmbi6thOrderACN, kAmbi7thOrderACN, k80Cube, k40_4, k71CineTopCenter,
+        k71CineCenterHigh, k70CineFrontHigh, k70MPEG3D, k50_2, k71CineFrontHigh, k71MPEG3D,
+        k51_2, k70CineSideHigh, k50_2_TS, k71CineSideHigh, k51_2_TS, k81MPEG3D, k41_4_1, k90,
+        k50_4, k91, k51_4, k50_4_1, k51_4_1, k70_2, k71_2, k91Atmos, k70_2_TF, k71_2_TF,
+        k70_3, k72_3, k70_4, k71_4, k111MPEG3D, k70_6, k71_6, k90_4, k91_4, k90_6, k91_6,
+        k90_4_W, k91_4_W, k90_6_W, k91_6_W, k100, k50_5, k101, k101MPEG3D, k51_5, k102, k52_5,
+        k110, k50_6, k111, k51_6, k122, k72_5, k130, k131, k140, k60_4_4, k220, k100_9_3,
+        k222, k102_9_3, k50_5_3, k51_5_3, k50_2_2, k50_4_2, k70_4_2, k50_5_Sony, k40_2_2,
+        k40_4_2, k50_3_2, k30_5_2, k40_4_4, k50_4_4
+    };
+
+    // VST3 speakers which have no SPA position
+    static const uint64_t vst3_unmapped =
+        Steinberg::Vst::kSpeakerPl | Steinberg::Vst::kSpeakerPr |
+        Steinberg::Vst::kSpeakerBsl | Steinberg::Vst::kSpeakerBsr |
+        Steinberg::Vst::kSpeakerBrl | Steinberg::Vst::kSpeakerBrc | Steinberg::Vst::kSpeakerBrr |
+        (uint64_t(7) << 61);
+
+    static size_t popcount(uint64_t v)
+    {
+        size_t n = 0;
+        for ( ; v != 0; v &= v - 1)
+            ++n;
+        return n;
+    }
+} /* namespace */
+
+UTEST_BEGIN("3rdparty.spa", channel_map)
+
+    void test_vst3_speakers()
+    {
+        printf("Testing VST3 speaker round trip...\n");
+
+        size_t mapped = 0;
+        for (size_t bit=0; bit<64; ++bit)
+        {
+            const uint64_t speaker  = uint64_t(1) << bit;
+            const uint32_t pos      = lsp::spa::vst3_speaker_to_position(speaker);
+            if (pos == SPA_AUDIO_CHANNEL_UNKNOWN)
+            {
+                UTEST_ASSERT_MSG(vst3_unmapped & speaker, "Speaker bit %d is not mapped", int(bit));
+                UTEST_ASSERT(lsp::spa::position_to_vst3_speaker(pos) == 0);
+                continue;
+            }
+
+            UTEST_ASSERT_MSG(!(vst3_unmapped & speaker), "Speaker bit %d should not be mapped", int(bit));
+            UTEST_ASSERT_MSG(lsp::spa::position_to_vst3_speaker(pos) == speaker,
+                "Speaker bit %d -> position %d -> speaker 0x%llx", int(bit), int(pos),
+                (unsigned long long)lsp::spa::position_to_vst3_speaker(pos));
+            ++mapped;
+        }
+        UTEST_ASSERT(mapped == 64 - popcount(vst3_unmapped));
+
+        // Invalid speakers
+        UTEST_ASSERT(lsp::spa::vst3_speaker_to_position(0) == SPA_AUDIO_CHANNEL_UNKNOWN);
+        UTEST_ASSERT(lsp::spa::vst3_speaker_to_position(Steinberg::Vst::kSpeakerL | Steinberg::Vst::kSpeakerR) == SPA_AUDIO_CHANNEL_UNKNOWN);
+
+        // Well-known speakers
+        UTEST_ASSERT(lsp::spa::vst3_speaker_to_position(Steinberg::Vst::kSpeakerL) == SPA_AUDIO_CHANNEL_FL);
+        UTEST_ASSERT(lsp::spa::vst3_speaker_to_position(Steinberg::Vst::kSpeakerLs) == SPA_AUDIO_CHANNEL_RL);
+        UTEST_ASSERT(lsp::spa::vst3_speaker_to_position(Steinberg::Vst::kSpeakerSr) == SPA_AUDIO_CHANNEL_SR);
+        UTEST_ASSERT(lsp::spa::vst3_speaker_to_position(Steinberg::Vst::kSpeakerCs) == SPA_AUDIO_CHANNEL_RC);
+        UTEST_ASSERT(lsp::spa::vst3_speaker_to_position(Steinberg::Vst::kSpeakerM) == SPA_AUDIO_CHANNEL_MONO);
+        UTEST_ASSERT(lsp::spa::vst3_speaker_to_position(Steinberg::Vst::kSpeakerTrr) == SPA_AUDIO_CHANNEL_TRR);
+        UTEST_ASSERT(lsp::spa::vst3_speaker_to_position(Steinberg::Vst::kSpeakerLw) == SPA_AUDIO_CHANNEL_FLW);
+        UTEST_ASSERT(lsp::spa::vst3_speaker_to_position(Steinberg::Vst::kSpeakerBfc) == SPA_AUDIO_CHANNEL_BC);
+        UTEST_ASSERT(lsp::spa::vst3_speaker_to_position(Steinberg::Vst::kSpeakerACN0) == SPA_AUDIO_CHANNEL_AUX0);
+        UTEST_ASSERT(lsp::spa::vst3_speaker_to_position(Steinberg::Vst::kSpeakerACN3) == SPA_AUDIO_CHANNEL_AUX3);
+        UTEST_ASSERT(lsp::spa::vst3_speaker_to_position(Steinberg::Vst::kSpeakerACN4) == SPA_AUDIO_CHANNEL_AUX4);
+        UTEST_ASSERT(lsp::spa::vst3_speaker_to_position(Steinberg::Vst::kSpeakerACN24) == SPA_AUDIO_CHANNEL_AUX24);
+    }
+
+    void test_clap_speakers()
+    {
+        printf("Testing CLAP surround channel round trip...\n");
+
+        for (uint32_t id=0; id<=CLAP_SURROUND_TSR; ++id)
+        {
+            const uint32_t pos      = lsp::spa::clap_surround_to_position(id);
+            UTEST_ASSERT_MSG(pos != SPA_AUDIO_CHANNEL_UNKNOWN, "CLAP channel %d is not mapped", int(id));
+            UTEST_ASSERT_MSG(lsp::spa::position_to_clap_surround(pos) == int(id),
+                "CLAP channel %d -> position %d -> channel %d", int(id), int(pos),
+                lsp::spa::position_to_clap_surround(pos));
+        }
+        UTEST_ASSERT(lsp::spa::clap_surround_to_position(CLAP_SURROUND_TSR + 1) == SPA_AUDIO_CHANNEL_UNKNOWN);
+
+        UTEST_ASSERT(lsp::spa::clap_surround_to_position(CLAP_SURROUND_BL) == SPA_AUDIO_CHANNEL_RL);
+        UTEST_ASSERT(lsp::spa::clap_surround_to_position(CLAP_SURROUND_BC) == SPA_AUDIO_CHANNEL_RC);
+        UTEST_ASSERT(lsp::spa::clap_surround_to_position(CLAP_SURROUND_SL) == SPA_AUDIO_CHANNEL_SL);
+        UTEST_ASSERT(lsp::spa::clap_surround_to_position(CLAP_SURROUND_TBR) == SPA_AUDIO_CHANNEL_TRR);
+        UTEST_ASSERT(lsp::spa::clap_surround_to_position(CLAP_SURROUND_TSL) == SPA_AUDIO_CHANNEL_TSL);
+    }
+
+    void test_positions()
+    {
+        printf("Testing SPA position round trip...\n");
+
+        size_t vst3 = 0, clap = 0;
+        for (uint32_t pos=0; pos<=SPA_AUDIO_CHANNEL_LAST_Aux; ++pos)
+        {
+            if ((pos > SPA_AUDIO_CHANNEL_BRC) && (pos < SPA_AUDIO_CHANNEL_START_Aux))
+                continue;
+
+            const uint64_t speaker  = lsp::spa::position_to_vst3_speaker(pos);
+            if (speaker != 0)
+            {
+                UTEST_ASSERT_MSG(popcount(speaker) == 1, "Position %d -> multiple speakers", int(pos));
+                UTEST_ASSERT_MSG(lsp::spa::vst3_speaker_to_position(speaker) == pos,
+                    "Position %d -> speaker 0x%llx -> position %d", int(pos),
+                    (unsigned long long)speaker, int(lsp::spa::vst3_speaker_to_position(speaker)));
+                ++vst3;
+            }
+
+            const int id            = lsp::spa::position_to_clap_surround(pos);
+            if (id >= 0)
+            {
+                UTEST_ASSERT_MSG(lsp::spa::clap_surround_to_position(id) == pos,
+                    "Position %d -> CLAP channel %d -> position %d", int(pos), id,
+                    int(lsp::spa::clap_surround_to_position(id)));
+                ++clap;
+            }
+        }
+
+        UTEST_ASSERT(vst3 == 64 - popcount(vst3_unmapped));
+        UTEST_ASSERT(clap == CLAP_SURROUND_TSR + 1);
+        UTEST_ASSERT(lsp::spa::position_to_vst3_speaker(SPA_AUDIO_CHANNEL_AUX25) == 0);
+        UTEST_ASSERT(lsp::spa::position_to_vst3_speaker(SPA_AUDIO_CHANNEL_FLH) == 0);
+        UTEST_ASSERT(lsp::spa::position_to_vst3_speaker(SPA_AUDIO_CHANNEL_START_Custom) == 0);
+        UTEST_ASSERT(lsp::spa::position_to_clap_surround(SPA_AUDIO_CHANNEL_MONO) < 0);
+        UTEST_ASSERT(lsp::spa::position_to_clap_surround(SPA_AUDIO_CHANNEL_AUX0) < 0);
+    }
+
+    void test_arrangements()
+    {
+        printf("Testing VST3 speaker arrangements...\n");
+
+        uint32_t pos[MAX_CHANNELS];
+        size_t count = 0;
+
+        for (size_t i=0; i<sizeof(arrangements)/sizeof(arrangements[0]); ++i)
+        {
+            const uint64_t arr      = arrangements[i];
+            const lsp::status_t res = lsp::spa::vst3_arrangement_to_positions(pos, &count, MAX_CHANNELS, arr);
+            UTEST_ASSERT(count == popcount(arr));
+
+            if (arr & vst3_unmapped)
+            {
+                UTEST_ASSERT_MSG(res == lsp::STATUS_NOT_FOUND, "Arrangement 0x%llx should be unmapped", (unsigned long long)arr);
+                uint64_t out = 0;
+                UTEST_ASSERT(lsp::spa::positions_to_vst3_arrangement(&out, pos, count) == lsp::STATUS_NOT_FOUND);
+                continue;
+            }
+
+            UTEST_ASSERT_MSG(res == lsp::STATUS_OK, "Arrangement 0x%llx failed: %d", (unsigned long long)arr, int(res));
+
+            // Channels follow in ascending order of speaker bits
+            for (size_t j=1; j<count; ++j)
+                UTEST_ASSERT(lsp::spa::position_to_vst3_speaker(pos[j-1]) < lsp::spa::position_to_vst3_speaker(pos[j]));
+
+            uint64_t out = 0;
+            UTEST_ASSERT(lsp::spa::positions_to_vst3_arrangement(&out, pos, count) == lsp::STATUS_OK);
+            UTEST_ASSERT_MSG(out == arr, "Arrangement 0x%llx -> 0x%llx", (unsigned long long)arr, (unsigned long long)out);
+        }
+
+        // Random arrangements
+        for (size_t i=0; i<0x1000; ++i)
+        {
+            const uint64_t arr      = ((uint64_t(rand()) << 40) ^ (uint64_t(rand()) << 20) ^ uint64_t(rand())) & (~vst3_unmapped);
+            UTEST_ASSERT(lsp::spa::vst3_arrangement_to_positions(pos, &count, MAX_CHANNELS, arr) == lsp::STATUS_OK);
+            uint64_t out = 0;
+            UTEST_ASSERT(lsp::spa::positions_to_vst3_arrangement(&out, pos, count) == lsp::STATUS_OK);
+            UTEST_ASSERT(out == arr);
+        }
+
+        // 5.1: L R C Lfe Ls Rs
+        static const uint32_t pos_5_1[] =
+        {
+            SPA_AUDIO_CHANNEL_FL, SPA_AUDIO_CHANNEL_FR, SPA_AUDIO_CHANNEL_FC,
+            SPA_AUDIO_CHANNEL_LFE, SPA_AUDIO_CHANNEL_RL, SPA_AUDIO_CHANNEL_RR
+        };
+        UTEST_ASSERT(lsp::spa::vst3_arrangement_to_positions(pos, &count, MAX_CHANNELS, k51) == lsp::STATUS_OK);
+        UTEST_ASSERT(count == 6);
+        UTEST_ASSERT(memcmp(pos, pos_5_1, sizeof(pos_5_1)) == 0);
+
+        // Errors
+        UTEST_ASSERT(lsp::spa::vst3_arrangement_to_positions(pos, &count, 5, k51) == lsp::STATUS_OVERFLOW);
+        static const uint32_t dup[] = { SPA_AUDIO_CHANNEL_FL, SPA_AUDIO_CHANNEL_FR, SPA_AUDIO_CHANNEL_FL };
+        uint64_t out = 0;
+        UTEST_ASSERT(lsp::spa::positions_to_vst3_arrangement(&out, dup, 3) == lsp::STATUS_BAD_FORMAT);
+        static const uint32_t unk[] = { SPA_AUDIO_CHANNEL_FL, SPA_AUDIO_CHANNEL_FLH };
+        UTEST_ASSERT(lsp::spa::positions_to_vst3_arrangement(&out, unk, 2) == lsp::STATUS_NOT_FOUND);
+    }
+
+    void test_clap_maps()
+    {
+        printf("Testing CLAP surround channel maps...\n");
+
+        static const uint8_t map_7_1[] =
+        {
+            CLAP_SURROUND_FL, CLAP_SURROUND_FR, CLAP_SURROUND_FC, CLAP_SURROUND_LFE,
+            CLAP_SURROUND_BL, CLAP_SURROUND_BR, CLAP_SURROUND_SL, CLAP_SURROUND_SR
+        };
+        static const uint32_t pos_7_1[] =
+        {
+            SPA_AUDIO_CHANNEL_FL, SPA_AUDIO_CHANNEL_FR, SPA_AUDIO_CHANNEL_FC, SPA_AUDIO_CHANNEL_LFE,
+            SPA_AUDIO_CHANNEL_RL, SPA_AUDIO_CHANNEL_RR, SPA_AUDIO_CHANNEL_SL, SPA_AUDIO_CHANNEL_SR
+        };
+
+        uint32_t pos[MAX_CHANNELS];
+        uint8_t map[MAX_CHANNELS];
+
+        UTEST_ASSERT(lsp::spa::clap_surround_to_positions(pos, map_7_1, 8) == lsp::STATUS_OK);
+        UTEST_ASSERT(memcmp(pos, pos_7_1, sizeof(pos_7_1)) == 0);
+        UTEST_ASSERT(lsp::spa::positions_to_clap_surround(map, pos, 8) == lsp::STATUS_OK);
+        UTEST_ASSERT(memcmp(map, map_7_1, sizeof(map_7_1)) == 0);
+        UTEST_ASSERT(lsp::spa::clap_surround_mask(map, 8) == 0x63f);
+
+        // VST3 and CLAP channel orders of 7.1 are equal
+        uint64_t arr = 0;
+        UTEST_ASSERT(lsp::spa::positions_to_vst3_arrangement(&arr, pos, 8) == lsp::STATUS_OK);
+        UTEST_ASSERT(arr == k71Music);
+
+        // Random channel maps
+        for (size_t i=0; i<0x1000; ++i)
+        {
+            const size_t count = rand() % (CLAP_SURROUND_TSR + 2);
+            for (size_t j=0; j<count; ++j)
+                map[j]          = rand() % (CLAP_SURROUND_TSR + 1);
+
+            uint8_t out[MAX_CHANNELS];
+            UTEST_ASSERT(lsp::spa::clap_surround_to_positions(pos, map, count) == lsp::STATUS_OK);
+            UTEST_ASSERT(lsp::spa::positions_to_clap_surround(out, pos, count) == lsp::STATUS_OK);
+            UTEST_ASSERT(memcmp(out, map, count) == 0);
+        }
+
+        // Errors
+        map[0] = CLAP_SURROUND_FL;
+        map[1] = CLAP_SURROUND_TSR + 1;
+        UTEST_ASSERT(lsp::spa::clap_surround_to_positions(pos, map, 2) == lsp::STATUS_NOT_FOUND);
+        UTEST_ASSERT(pos[1] == SPA_AUDIO_CHANNEL_UNKNOWN);
+        pos[1] = SPA_AUDIO_CHANNEL_LFE2;
+        UTEST_ASSERT(lsp::spa::positions_to_clap_surround(map, pos, 2) == lsp::STATUS_NOT_FOUND);
+    }
+
+    void test_ambisonic()
+    {
+        printf("Testing CLAP ambisonic configurations...\n");
+
+        uint32_t pos[MAX_CHANNELS];
+        clap_ambisonic_config_t cfg;
+        cfg.normalization   = CLAP_AMBISONIC_NORMALIZATION_SN3D;
+
+        // ACN ordering
+        cfg.ordering        = CLAP_AMBISONIC_ORDERING_ACN;
+        for (size_t order=0; order<8; ++order)
+        {
+            const size_t count = (order + 1) * (order + 1);
+            UTEST_ASSERT(lsp::spa::clap_ambisonic_to_positions(pos, &cfg, count) == lsp::STATUS_OK);
+            for (size_t i=0; i<count; ++i)
+                UTEST_ASSERT(pos[i] == SPA_AUDIO_CHANNEL_AUX0 + i);
+
+            // Ambisonic orders supported by VST3 match
+            uint64_t arr = 0;
+            if (order <= 4)
+            {
+                UTEST_ASSERT(lsp::spa::positions_to_vst3_arrangement(&arr, pos, count) == lsp::STATUS_OK);
+                UTEST_ASSERT(popcount(arr) == count);
+            }
+        }
+        UTEST_ASSERT(lsp::spa::clap_ambisonic_to_positions(pos, &cfg, 0) == lsp::STATUS_BAD_FORMAT);
+        UTEST_ASSERT(lsp::spa::clap_ambisonic_to_positions(pos, &cfg, 5) == lsp::STATUS_BAD_FORMAT);
+        UTEST_ASSERT(lsp::spa::clap_ambisonic_to_positions(pos, &cfg, 81) == lsp::STATUS_BAD_FORMAT);
+
+        // FuMa ordering: W X Y Z R S T U V K L M N O P Q
+        static const uint32_t fuma[] =
+        {
+            SPA_AUDIO_CHANNEL_AUX0, SPA_AUDIO_CHANNEL_AUX3, SPA_AUDIO_CHANNEL_AUX1, SPA_AUDIO_CHANNEL_AUX2,
+            SPA_AUDIO_CHANNEL_AUX6, SPA_AUDIO_CHANNEL_AUX7, SPA_AUDIO_CHANNEL_AUX5, SPA_AUDIO_CHANNEL_AUX8,
+            SPA_AUDIO_CHANNEL_AUX4, SPA_AUDIO_CHANNEL_AUX12, SPA_AUDIO_CHANNEL_AUX13, SPA_AUDIO_CHANNEL_AUX11,
+            SPA_AUDIO_CHANNEL_AUX14, SPA_AUDIO_CHANNEL_AUX10, SPA_AUDIO_CHANNEL_AUX15, SPA_AUDIO_CHANNEL_AUX9
+        };
+        cfg.ordering        = CLAP_AMBISONIC_ORDERING_FUMA;
+        for (size_t order=0; order<4; ++order)
+        {
+            const size_t count = (order + 1) * (order + 1);
+            UTEST_ASSERT(lsp::spa::clap_ambisonic_to_positions(pos, &cfg, count) == lsp::STATUS_OK);
+            UTEST_ASSERT(memcmp(pos, fuma, count * sizeof(uint32_t)) == 0);
+
+            // FuMa channels of each order are a permutation of ACN channels
+            uint64_t arr = 0;
+            UTEST_ASSERT(lsp::spa::positions_to_vst3_arrangement(&arr, pos, count) == lsp::STATUS_OK);
+            UTEST_ASSERT(popcount(arr) == count);
+        }
+        UTEST_ASSERT(lsp::spa::clap_ambisonic_to_positions(pos, &cfg, 25) == lsp::STATUS_BAD_FORMAT);
+
+        cfg.ordering        = 2;
+        UTEST_ASSERT(lsp::spa::clap_ambisonic_to_positions(pos, &cfg, 4) == lsp::STATUS_BAD_FORMAT);
+    }
+
+    void test_permutation()
+    {
+        printf("Testing channel permutation...\n");
+
+        // VST3 5.1 -> SPA 5.1 with different channel order
+        static const uint32_t src[] =
+        {
+            SPA_AUDIO_CHANNEL_FL, SPA_AUDIO_CHANNEL_FR, SPA_AUDIO_CHANNEL_FC,
+            SPA_AUDIO_CHANNEL_LFE, SPA_AUDIO_CHANNEL_RL, SPA_AUDIO_CHANNEL_RR
+        };
+        static const uint32_t dst[] =
+        {
+            SPA_AUDIO_CHANNEL_FL, SPA_AUDIO_CHANNEL_FR, SPA_AUDIO_CHANNEL_RL,
+            SPA_AUDIO_CHANNEL_RR, SPA_AUDIO_CHANNEL_FC, SPA_AUDIO_CHANNEL_LFE,
+            SPA_AUDIO_CHANNEL_SL
+        };
+        static const uint32_t expected[] = { 0, 1, 4, 5, 2, 3, lsp::spa::CHANNEL_MAP_NONE };
+
+        uint32_t perm[MAX_CHANNELS];
+        UTEST_ASSERT(lsp::spa::channel_permutation(perm, dst, 6, src, 6) == lsp::STATUS_OK);
+        UTEST_ASSERT(memcmp(perm, expected, 6 * sizeof(uint32_t)) == 0);
+        UTEST_ASSERT(lsp::spa::channel_permutation(perm, dst, 7, src, 6) == lsp::STATUS_NOT_FOUND);
+        UTEST_ASSERT(memcmp(perm, expected, 7 * sizeof(uint32_t)) == 0);
+
+        // Permute buffer pointers
+        float buf[6], silence = 0.0f;
+        const float *vsrc[6], *vdst[7];
+        for (size_t i=0; i<6; ++i)
+            vsrc[i]         = &buf[i];
+        lsp::spa::channel_permute(vdst, vsrc, perm, 7, const_cast<const float *>(&silence));
+        for (size_t i=0; i<6; ++i)
+            UTEST_ASSERT(vdst[i] == &buf[expected[i]]);
+        UTEST_ASSERT(vdst[6] == &silence);
+
+        // Duplicated positions are matched in order
+        static const uint32_t usrc[] = { SPA_AUDIO_CHANNEL_UNKNOWN, SPA_AUDIO_CHANNEL_FL, SPA_AUDIO_CHANNEL_UNKNOWN };
+        static const uint32_t udst[] = { SPA_AUDIO_CHANNEL_FL, SPA_AUDIO_CHANNEL_UNKNOWN, SPA_AUDIO_CHANNEL_UNKNOWN, SPA_AUDIO_CHANNEL_UNKNOWN };
+        UTEST_ASSERT(lsp::spa::channel_permutation(perm, udst, 4, usrc, 3) == lsp::STATUS_NOT_FOUND);
+        UTEST_ASSERT(perm[0] == 1);
+        UTEST_ASSERT(perm[1] == 0);
+        UTEST_ASSERT(perm[2] == 2);
+        UTEST_ASSERT(perm[3] == lsp::spa::CHANNEL_MAP_NONE);
+
+        // Random permutations of VST3 arrangement to CLAP channel map
+        for (size_t i=0; i<0x400; ++i)
+        {
+            uint32_t vpos[MAX_CHANNELS], cpos[MAX_CHANNELS];
+            size_t count = 0;
+            const uint64_t arr = uint64_t(rand()) & ((1 << 18) - 1);
+            UTEST_ASSERT(lsp::spa::vst3_arrangement_to_positions(vpos, &count, MAX_CHANNELS, arr) == lsp::STATUS_OK);
+
+            // Shuffle positions
+            memcpy(cpos, vpos, count * sizeof(uint32_t));
+            for (size_t j=count; j > 1; --j)
+            {
+                const size_t k  = rand() % j;
+                const uint32_t t= cpos[j-1];
+                cpos[j-1]       = cpos[k];
+                cpos[k]         = t;
+            }
+
+            UTEST_ASSERT(lsp::spa::channel_permutation(perm, cpos, count, vpos, count) == lsp::STATUS_OK);
+            for (size_t j=0; j<count; ++j)
+                UTEST_ASSERT(vpos[perm[j]] == cpos[j]);
+        }
+    }
+
+    UTEST_MAIN
+    {
+        srand(0x38);
+
+        test_vst3_speakers();
+        test_clap_speakers();
+        test_positions();
+        test_arrangements();
+        test_clap_maps();
+        test_ambisonic();
+        test_permutation();
+    }
+
+UTEST_END
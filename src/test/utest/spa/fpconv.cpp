@@ -0,0 +1,475 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define LSP_3RD_PARTY_SPA_FAST_FLOAT
+
+#include <lsp-plug.in/3rdparty/spa/fpconv.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <pw-headers/spa/utils/json.h>
+#include <pw-headers/spa/utils/json-builder.h>
+
+#include <errno.h>
+#include <float.h>
+
+/*
+ * Define LSP_3RD_PARTY_SPA_FPCONV_EXHAUSTIVE to round-trip every single-precision value
+ * instead of the selected edge cases and random bit patterns. It takes several minutes.
+ */
+
+UTEST_BEGIN("3rdparty.spa", fpconv)
+#ifdef LSP_3RD_PARTY_SPA_FPCONV_EXHAUSTIVE
+    UTEST_TIMELIMIT(900)
+#endif
+
+    typedef struct format_f32_t
+    {
+        float           value;
+        const char     *text;
+    } format_f32_t;
+
+    typedef struct format_f64_t
+    {
+        double          value;
+        const char     *text;
+    } format_f64_t;
+
+    typedef struct parse_t
+    {
+        const char     *text;
+        size_t          count;
+        int             error;
+    } parse_t;
+
+    void test_format()
+    {
+        static const format_f32_t f32[] =
+        {
+            { 0.0f,             "0.0"                       },
+            { -0.0f,            "-0.0"                      },
+            { 1.0f,             "1.0"                       },
+            { -2.0f,            "-2.0"                      },
+            { 0.5f,             "0.5"                       },
+            { 0.1f,             "0.1"                       },
+            { 0.3f,             "0.3"                       },
+            { 123.456f,         "123.456"                   },
+            { 16777216.0f,      "16777216.0"                },
+            { 1e20f,            "100000000000000000000.0"   },
+            { 1e21f,            "1e+21"                     },
+            { 1.5e22f,          "1.5e+22"                   },
+            { 0.000001f,        "0.000001"                  },
+            { 1e-7f,            "1e-7"                      },
+            { -2.5e-10f,        "-2.5e-10"                  },
+            { FLT_MAX,          "3.4028235e+38"             },
+            { FLT_MIN,          "1.1754944e-38"             },
+            { 1.4e-45f,         "1e-45"                     },
+            { INFINITY,         "inf"                       },
+            { -INFINITY,        "-inf"                      },
+            { NAN,              "nan"                       },
+        };
+
+        static const format_f64_t f64[] =
+        {
+            { 0.0,                      "0.0"                       },
+            { 1.0,                      "1.0"                       },
+            { 0.1,                      "0.1"                       },
+            { 0.3,                      "0.3"                       },
+            { 0.1 + 0.2,                "0.30000000000000004"       },
+            { 1.0 / 3.0,                "0.3333333333333333"        },
+            { 9007199254740993.0,       "9007199254740992.0"        },
+            { 1e100,                    "1e+100"                    },
+            { -1.25e-300,               "-1.25e-300"                },
+            { DBL_MAX,                  "1.7976931348623157e+308"   },
+            { DBL_MIN,                  "2.2250738585072014e-308"   },
+            { 5e-324,                   "5e-324"                    },
+        };
+
+        char buf[lsp::spa::FPCONV_BUF_SIZE];
+
+        for (size_t i=0; i<sizeof(f32)/sizeof(f32[0]); ++i)
+        {
+            const size_t n = lsp::spa::format_float(buf, sizeof(buf), f32[i].value);
+            UTEST_ASSERT_MSG(strcmp(buf, f32[i].text) == 0, "Expected '%s', got '%s'", f32[i].text, buf);
+            UTEST_ASSERT(n == strlen(buf));
+        }
+
+        for (size_t i=0; i<sizeof(f64)/sizeof(f64[0]); ++i)
+        {
+            const size_t n = lsp::spa::format_double(buf, sizeof(buf), f64[i].value);
+            UTEST_ASSERT_MSG(strcmp(buf, f64[i].text) == 0, "Expected '%s', got '%s'", f64[i].text, buf);
+            UTEST_ASSERT(n == strlen(buf));
+        }
+
+        // Truncation
+        UTEST_ASSERT(lsp::spa::format_double(buf, 4, 0.125) == 5);
+        UTEST_ASSERT(strcmp(buf, "0.1") == 0);
+        UTEST_ASSERT(lsp::spa::format_double(NULL, 0, 0.125) == 5);
+    }
+
+    void test_parse()
+    {
+        static const parse_t list[] =
+        {
+            { "1",              1,  0       },
+            { "-1.5",           4,  0       },
+            { "+.5",            3,  0       },
+            { "5.",             2,  0       },
+            { "1e10",           4,  0       },
+            { "1E-5x",          4,  0       },
+            { "1e",             1,  0       },
+            { "1e+",            1,  0       },
+            { "2.5e-",          3,  0       },
+            { "0001.2500",      9,  0       },
+            { "1,5",            1,  0       },
+            { "1e39",           4,  ERANGE  },
+            { "1e-50",          5,  ERANGE  },
+            { "1e-40",          5,  ERANGE  },
+            { "0e-999",         6,  0       },
+            { "",               0,  0       },
+            { "-",              0,  0       },
+            { ".",              0,  0       },
+            { "-.e1",           0,  0       },
+            { " 1",             0,  0       },
+            { "inf",            0,  0       },
+            { "nan",            0,  0       },
+        };
+
+        for (size_t i=0; i<sizeof(list)/sizeof(list[0]); ++i)
+        {
+            const parse_t *p    = &list[i];
+            float v             = 0.0f;
+            char *end           = NULL;
+
+            errno               = 0;
+            const size_t n      = lsp::spa::parse_float(p->text, strlen(p->text), &v);
+            const int error     = errno;
+            UTEST_ASSERT_MSG(n == p->count, "'%s': expected %d parsed characters, got %d", p->text, int(p->count), int(n));
+            UTEST_ASSERT_MSG(error == p->error, "'%s': expected errno=%d, got %d", p->text, p->error, error);
+            if (n == 0)
+                continue;
+
+            const float expected = strtof(p->text, &end);
+            UTEST_ASSERT(size_t(end - p->text) == n);
+            UTEST_ASSERT_MSG(memcmp(&v, &expected, sizeof(v)) == 0, "'%s': expected %.9g, got %.9g", p->text, expected, v);
+        }
+
+        // The input does not need to be zero-terminated
+        double d = 0.0;
+        UTEST_ASSERT(lsp::spa::parse_double("12345", 3, &d) == 3);
+        UTEST_ASSERT(d == 123.0);
+
+        // Numbers with many significant digits
+        static const char *long_numbers[] =
+        {
+            "3.14159265358979323846264338327950288419716939937510",
+            "2.47032822920623272088284396434110886215446112122e-324",
+            "9007199254740993.00000000000000000000001",
+            "0.1000000000000000055511151231257827021181583404541015625",
+            "179769313486231580793728971405301e275",
+            "7.038531e-26",
+        };
+        for (size_t i=0; i<sizeof(long_numbers)/sizeof(long_numbers[0]); ++i)
+        {
+            const char *s       = long_numbers[i];
+            const double dv     = strtod(s, NULL);
+            const float fv      = strtof(s, NULL);
+            double d;
+            float f;
+
+            UTEST_ASSERT(lsp::spa::parse_double(s, strlen(s), &d) == strlen(s));
+            UTEST_ASSERT(lsp::spa::parse_float(s, strlen(s), &f) == strlen(s));
+            UTEST_ASSERT_MSG(memcmp(&d, &dv, sizeof(d)) == 0, "'%s': expected %.17g, got %.17g", s, dv, d);
+            UTEST_ASSERT_MSG(memcmp(&f, &fv, sizeof(f)) == 0, "'%s': expected %.9g, got %.9g", s, fv, f);
+        }
+    }
+
+    void test_random_strings()
+    {
+        char buf[0x80];
+        srand(0x1234);
+
+        for (size_t i=0; i<1000000; ++i)
+        {
+            // Generate random decimal number
+            size_t len          = 0;
+            const size_t digits = 1 + rand() % 24;
+            const size_t point  = rand() % (digits + 1);
+            if (rand() & 1)
+                buf[len++]          = '-';
+            for (size_t j=0; j<digits; ++j)
+            {
+                if (j == point)
+                    buf[len++]          = '.';
+                buf[len++]          = char('0' + rand() % 10);
+            }
+            if (rand() % 3)
+                len                += snprintf(&buf[len], sizeof(buf) - len, "e%d", rand() % 700 - 350);
+            buf[len]            = '\0';
+
+            char *end;
+            double d;
+            float f;
+
+            errno               = 0;
+            const double dv     = strtod(buf, &end);
+            const int derr      = errno;
+            errno               = 0;
+            size_t n            = lsp::spa::parse_double(buf, len, &d);
+            UTEST_ASSERT_MSG(n == size_t(end - buf), "'%s': invalid number of parsed characters", buf);
+            UTEST_ASSERT_MSG(memcmp(&d, &dv, sizeof(d)) == 0, "'%s': expected %.17g, got %.17g", buf, dv, d);
+            UTEST_ASSERT_MSG(errno == derr, "'%s': expected errno=%d, got %d", buf, derr, errno);
+
+            errno               = 0;
+            const float fv      = strtof(buf, &end);
+            const int ferr      = errno;
+            errno               = 0;
+            n                   = lsp::spa::parse_float(buf, len, &f);
+            UTEST_ASSERT_MSG(n == size_t(end - buf), "'%s': invalid number of parsed characters", buf);
+            UTEST_ASSERT_MSG(memcmp(&f, &fv, sizeof(f)) == 0, "'%s': expected %.9g, got %.9g", buf, fv, f);
+            UTEST_ASSERT_MSG(errno == ferr, "'%s': expected errno=%d, got %d", buf, ferr, errno);
+        }
+    }
+
+    // Number of digits of the shortest correctly rounded representation, the shortest
+    // round-trip representation may be even shorter near the powers of two
+    size_t shortest_digits(float v)
+    {
+        char buf[0x40];
+        for (int prec = 1; prec < 9; ++prec)
+        {
+            snprintf(buf, sizeof(buf), "%.*e", prec - 1, double(v));
+            if (strtof(buf, NULL) == v)
+                return prec;
+        }
+        return 9;
+    }
+
+    size_t significant_digits(const char *s)
+    {
+        const char *first = NULL, *last = NULL;
+        for ( ; (*s != '\0') && (*s != 'e'); ++s)
+        {
+            if ((*s < '0') || (*s > '9'))
+                continue;
+            if ((first == NULL) && (*s != '0'))
+                first   = s;
+            if (*s != '0')
+                last    = s;
+        }
+        if (first == NULL)
+            return 0;
+
+        size_t n = 0;
+        for (s = first; s <= last; ++s)
+            n      += (*s >= '0') && (*s <= '9');
+        return n;
+    }
+
+    void check_float_round_trip(uint32_t bits, bool full)
+    {
+        char buf[lsp::spa::FPCONV_BUF_SIZE];
+        float v, p;
+        memcpy(&v, &bits, sizeof(v));
+        if ((isnan(v)) || (isinf(v)))
+            return;
+
+        const size_t n = lsp::spa::format_float(buf, sizeof(buf), v);
+        UTEST_ASSERT_MSG(lsp::spa::parse_float(buf, n, &p) == n, "0x%08x: failed to parse '%s'", bits, buf);
+        UTEST_ASSERT_MSG(memcmp(&v, &p, sizeof(v)) == 0, "0x%08x: '%s' parsed as %.9g", bits, buf, p);
+        if (!full)
+            return;
+
+        // Cross-check with the standard library and check that output is the shortest one
+        p = strtof(buf, NULL);
+        UTEST_ASSERT_MSG(memcmp(&v, &p, sizeof(v)) == 0, "0x%08x: '%s' parsed by strtof as %.9g", bits, buf, p);
+        if (v != 0.0f)
+            UTEST_ASSERT_MSG(significant_digits(buf) <= shortest_digits(v),
+                "0x%08x: '%s' is not the shortest representation", bits, buf);
+    }
+
+    void check_float_neighbours(uint32_t bits)
+    {
+        static const uint32_t signs[] = { 0, 0x80000000U };
+        for (size_t i=0; i<2; ++i)
+        {
+            check_float_round_trip(signs[i] | (bits - 1), true);
+            check_float_round_trip(signs[i] | bits, true);
+            check_float_round_trip(signs[i] | (bits + 1), true);
+        }
+    }
+
+    void test_float_round_trip()
+    {
+#ifdef LSP_3RD_PARTY_SPA_FPCONV_EXHAUSTIVE
+        // Check all possible single-precision values
+        for (uint64_t i=0; i <= 0xffffffffULL; ++i)
+            check_float_round_trip(uint32_t(i), (i & 0xff) == 0x5a);
+#else
+        // Zeros and denormals
+        check_float_neighbours(0x00000001U);
+        check_float_neighbours(0x007ffffeU);
+        for (uint32_t bits = 1; bits < 0x00800000U; bits = bits * 3 + 1)
+            check_float_neighbours(bits);
+
+        // Powers of two for all exponents including FLT_MIN and values next to FLT_MAX
+        for (uint32_t exp = 1; exp < 0xff; ++exp)
+            check_float_neighbours(exp << 23);
+
+        // Powers of ten and values that lie near the halfway point between two decimals
+        for (int i = -45; i <= 38; ++i)
+        {
+            char buf[0x20];
+            uint32_t bits;
+            float v;
+
+            snprintf(buf, sizeof(buf), "1e%d", i);
+            v = strtof(buf, NULL);
+            memcpy(&bits, &v, sizeof(bits));
+            if (bits > 1)
+                check_float_neighbours(bits);
+
+            snprintf(buf, sizeof(buf), "5.0000001e%d", i);
+            v = strtof(buf, NULL);
+            memcpy(&bits, &v, sizeof(bits));
+            if ((bits > 1) && (bits < 0x7f800000U))
+                check_float_neighbours(bits);
+        }
+
+        // Random bit patterns
+        uint32_t seed = 0x2545f491U;
+        for (size_t i=0; i<1000000; ++i)
+        {
+            // xorshift32 generator
+            seed       ^= seed << 13;
+            seed       ^= seed >> 17;
+            seed       ^= seed << 5;
+            check_float_round_trip(seed, (i & 0x0f) == 0);
+        }
+#endif /* LSP_3RD_PARTY_SPA_FPCONV_EXHAUSTIVE */
+    }
+
+    void test_double_round_trip()
+    {
+        char buf[lsp::spa::FPCONV_BUF_SIZE];
+        uint64_t seed = 0x0123456789abcdefULL;
+
+        for (size_t i=0; i<4000000; ++i)
+        {
+            // xorshift64 generator
+            seed       ^= seed << 13;
+            seed       ^= seed >> 7;
+            seed       ^= seed << 17;
+
+            double v, p;
+            memcpy(&v, &seed, sizeof(v));
+            if ((isnan(v)) || (isinf(v)))
+                continue;
+
+            const size_t n = lsp::spa::format_double(buf, sizeof(buf), v);
+            UTEST_ASSERT_MSG(lsp::spa::parse_double(buf, n, &p) == n, "failed to parse '%s'", buf);
+            UTEST_ASSERT_MSG(memcmp(&v, &p, sizeof(v)) == 0, "'%s' parsed as %.17g", buf, p);
+            p = strtod(buf, NULL);
+            UTEST_ASSERT_MSG(memcmp(&v, &p, sizeof(v)) == 0, "'%s' parsed by strtod as %.17g", buf, p);
+        }
+    }
+
+    void test_spa_json()
+    {
+        char buf[64];
+        float f;
+        double d;
+
+        // Formatting
+        UTEST_ASSERT(strcmp(spa_json_format_float(buf, sizeof(buf), 0.5f), "0.5") == 0);
+        UTEST_ASSERT(strcmp(spa_json_format_float(buf, sizeof(buf), 1e-7f), "1e-7") == 0);
+        UTEST_ASSERT(strcmp(spa_json_format_float(buf, sizeof(buf), NAN), "0.0") == 0);
+        UTEST_ASSERT(strcmp(spa_json_format_float(buf, sizeof(buf), INFINITY), "3.4028235e+38") == 0);
+        UTEST_ASSERT(strcmp(spa_dtoa(buf, sizeof(buf), 0.1), "0.1") == 0);
+        UTEST_ASSERT(strcmp(spa_json_format_double(buf, sizeof(buf), 0.1), "0.1") == 0);
+        UTEST_ASSERT(strcmp(spa_json_format_double(buf, sizeof(buf), 1.0 / 3.0), "0.3333333333333333") == 0);
+        UTEST_ASSERT(strcmp(spa_json_format_double(buf, sizeof(buf), 1e300), "1e+300") == 0);
+        UTEST_ASSERT(strcmp(spa_json_format_double(buf, sizeof(buf), NAN), "0.0") == 0);
+        UTEST_ASSERT(strcmp(spa_json_format_double(buf, sizeof(buf), -INFINITY), "-1.7976931348623157e+308") == 0);
+
+        // Builder keeps double precision
+        struct spa_json_builder b;
+        char *text = NULL;
+        size_t text_len = 0;
+        UTEST_ASSERT(spa_json_builder_buffer(&b, &text, &text_len, 0) == 0);
+        spa_json_builder_object_double(&b, NULL, 0.1 + 0.2);
+        spa_json_builder_close(&b);
+        UTEST_ASSERT(text != NULL);
+        UTEST_ASSERT_MSG(strcmp(text, "0.30000000000000004") == 0, "Got '%s'", text);
+        free(text);
+
+        // Parsing
+        UTEST_ASSERT(spa_json_parse_float("0.25", 4, &f) == 1);
+        UTEST_ASSERT(f == 0.25f);
+        UTEST_ASSERT(spa_json_parse_float("1e3,", 3, &f) == 1);
+        UTEST_ASSERT(f == 1000.0f);
+        UTEST_ASSERT(spa_json_parse_float("0x10", 4, &f) == 1);
+        UTEST_ASSERT(f == 16.0f);
+        UTEST_ASSERT(spa_json_parse_float("1.5x", 4, &f) == 0);
+        UTEST_ASSERT(spa_json_is_float("true", 4) == false);
+        UTEST_ASSERT(spa_atof("-2.5", &f));
+        UTEST_ASSERT(f == -2.5f);
+        UTEST_ASSERT(!spa_atof("1e99", &f));
+        UTEST_ASSERT(spa_atof(" 3", &f));
+        UTEST_ASSERT(f == 3.0f);
+        UTEST_ASSERT(spa_atod("0x1p-2", &d));
+        UTEST_ASSERT(d == 0.25);
+        UTEST_ASSERT(spa_atod("1.7976931348623157e+308", &d));
+        UTEST_ASSERT(d == DBL_MAX);
+
+        // Conversion through JSON text
+        struct spa_json it;
+        const char *json = "[ 0.1, 1e-7, 3.4028235e+38 ]";
+        const float expected[] = { 0.1f, 1e-7f, 3.4028235e+38f };
+        struct spa_json arr;
+        spa_json_init(&it, json, strlen(json));
+        UTEST_ASSERT(spa_json_enter_array(&it, &arr) > 0);
+        for (size_t i=0; i<3; ++i)
+        {
+            UTEST_ASSERT(spa_json_get_float(&arr, &f) > 0);
+            UTEST_ASSERT(f == expected[i]);
+        }
+    }
+
+    UTEST_MAIN
+    {
+        printf("Testing formatting...\n");
+        test_format();
+        printf("Testing parsing...\n");
+        test_parse();
+        printf("Testing parsing of random strings...\n");
+        test_random_strings();
+        printf("Testing double-precision round trip...\n");
+        test_double_round_trip();
+        printf("Testing JSON conversions...\n");
+        test_spa_json();
+        printf("Testing single-precision round trip...\n");
+        test_float_round_trip();
+    }
+
+UTEST_END
@@ -0,0 +1,305 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/HookList.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#define MAX_LISTENERS       64
+
+namespace
+{
+    typedef struct events_t
+    {
+        uint32_t    version;
+        void      (*info)(void *data, uint32_t id);
+        void      (*global)(void *data, uint32_t id, const char *type);
+    } events_t;
+
+    typedef struct context_t context_t;
+
+    typedef struct listener_t
+    {
+        context_t          *ctx;
+        struct spa_hook     hook;
+        size_t              index;
+        size_t              calls;
+        uint32_t            last;
+        bool                attached;
+    } listener_t;
+
+    struct context_t
+    {
+        lsp::spa::HookList  list;
+        listener_t          items[MAX_LISTENERS];
+        size_t              order[MAX_LISTENERS * 4];
+        size_t              nOrder;
+        ssize_t             remove;         // Index of listener to remove on call
+        ssize_t             add;            // Index of listener to add on call
+        bool                nested;         // Perform nested emission
+    };
+
+    static void on_info(void *data, uint32_t id);
+    static void on_global(void *data, uint32_t id, const char *type);
+
+    static const events_t events_v0 = { 0, on_info, NULL };
+    static const events_t events_v1 = { 1, on_info, on_global };
+
+    static void on_info(void *data, uint32_t id)
+    {
+        listener_t *l       = static_cast<listener_t *>(data);
+        context_t *ctx      = l->ctx;
+
+        ++l->calls;
+        l->last             = id;
+        ctx->order[ctx->nOrder++] = l->index;
+
+        if (ctx->remove >= 0)
+        {
+            listener_t *r       = &ctx->items[ctx->remove];
+            ctx->remove         = -1;
+            spa_hook_remove(&r->hook);
+            r->attached         = false;
+        }
+        if (ctx->add >= 0)
+        {
+            listener_t *a       = &ctx->items[ctx->add];
+            ctx->add            = -1;
+            ctx->list.append(&a->hook, &events_v0, a);
+            a->attached         = true;
+        }
+        if (ctx->nested)
+        {
+            ctx->nested         = false;
+            ctx->list.call(&events_t::info, 0, id + 1);
+        }
+    }
+
+    static void on_global(void *data, uint32_t id, const char *type)
+    {
+        listener_t *l       = static_cast<listener_t *>(data);
+        ++l->calls;
+        l->last             = id;
+    }
+
+    static void init_context(context_t *ctx)
+    {
+        for (size_t i=0; i<MAX_LISTENERS; ++i)
+        {
+            listener_t *l       = &ctx->items[i];
+            l->ctx              = ctx;
+            l->index            = i;
+            l->calls            = 0;
+            l->last             = 0;
+            l->attached         = false;
+        }
+        ctx->nOrder         = 0;
+        ctx->remove         = -1;
+        ctx->add            = -1;
+        ctx->nested         = false;
+    }
+
+    static void reset_context(context_t *ctx)
+    {
+        for (size_t i=0; i<MAX_LISTENERS; ++i)
+            ctx->items[i].calls = 0;
+        ctx->nOrder         = 0;
+    }
+} /* namespace */
+
+UTEST_BEGIN("3rdparty.spa", hook_list)
+
+    void test_order()
+    {
+        printf("Testing listener order...\n");
+
+        context_t ctx;
+        init_context(&ctx);
+
+        UTEST_ASSERT(ctx.list.is_empty());
+        UTEST_ASSERT(ctx.list.call(&events_t::info, 0, 1u) == 0);
+
+        UTEST_ASSERT(ctx.list.append(&ctx.items[1].hook, &events_v0, &ctx.items[1]) == lsp::STATUS_OK);
+        UTEST_ASSERT(ctx.list.append(&ctx.items[2].hook, &events_v1, &ctx.items[2]) == lsp::STATUS_OK);
+        UTEST_ASSERT(ctx.list.prepend(&ctx.items[0].hook, &events_v1, &ctx.items[0]) == lsp::STATUS_OK);
+        UTEST_ASSERT(ctx.list.size() == 3);
+
+        UTEST_ASSERT(ctx.list.call(&events_t::info, 0, 10u) == 3);
+        UTEST_ASSERT(ctx.nOrder == 3);
+        for (size_t i=0; i<3; ++i)
+        {
+            UTEST_ASSERT(ctx.order[i] == i);
+            UTEST_ASSERT(ctx.items[i].last == 10);
+        }
+
+        // Version and NULL method checks
+        reset_context(&ctx);
+        UTEST_ASSERT(ctx.list.call(&events_t::global, 0, 20u, "type") == 2);
+        UTEST_ASSERT(ctx.items[0].calls == 1);
+        UTEST_ASSERT(ctx.items[1].calls == 0);
+        UTEST_ASSERT(ctx.items[2].calls == 1);
+        UTEST_ASSERT(ctx.list.call(&events_t::info, 1, 30u) == 2);
+        UTEST_ASSERT(ctx.items[1].last == 10);
+        UTEST_ASSERT(ctx.list.call(&events_t::info, 2, 40u) == 0);
+
+        // Call once
+        reset_context(&ctx);
+        UTEST_ASSERT(ctx.list.call_once(&events_t::info, 0, 50u) == 1);
+        UTEST_ASSERT(ctx.items[0].calls == 1);
+        UTEST_ASSERT(ctx.items[1].calls == 0);
+
+        // Compatibility with spa_hook_list_call()
+        reset_context(&ctx);
+        spa_hook_list_call_simple(ctx.list.list(), events_t, info, 0, 60u);
+        for (size_t i=0; i<3; ++i)
+            UTEST_ASSERT(ctx.items[i].last == 60);
+
+        // Remove and clean
+        spa_hook_remove(&ctx.items[1].hook);
+        UTEST_ASSERT(ctx.list.size() == 2);
+        reset_context(&ctx);
+        UTEST_ASSERT(ctx.list.call(&events_t::info, 0, 70u) == 2);
+        UTEST_ASSERT(ctx.items[1].calls == 0);
+
+        ctx.list.clean();
+        UTEST_ASSERT(ctx.list.is_empty());
+        UTEST_ASSERT(spa_list_is_empty(&ctx.list.list()->list));
+        UTEST_ASSERT(ctx.list.call(&events_t::info, 0, 80u) == 0);
+        UTEST_ASSERT(ctx.items[0].hook.removed == NULL);
+    }
+
+    void test_emission_changes()
+    {
+        printf("Testing changes during emission...\n");
+
+        context_t ctx;
+        init_context(&ctx);
+        for (size_t i=0; i<4; ++i)
+            UTEST_ASSERT(ctx.list.append(&ctx.items[i].hook, &events_v0, &ctx.items[i]) == lsp::STATUS_OK);
+
+        // Remove self
+        ctx.remove          = 0;
+        UTEST_ASSERT(ctx.list.call(&events_t::info, 0, 1u) == 4);
+        UTEST_ASSERT(ctx.list.size() == 3);
+        reset_context(&ctx);
+        UTEST_ASSERT(ctx.list.call(&events_t::info, 0, 2u) == 3);
+        UTEST_ASSERT(ctx.items[0].calls == 0);
+
+        // Remove next listener
+        reset_context(&ctx);
+        ctx.remove          = 2;
+        UTEST_ASSERT(ctx.list.call(&events_t::info, 0, 3u) == 2);
+        UTEST_ASSERT(ctx.items[1].calls == 1);
+        UTEST_ASSERT(ctx.items[2].calls == 0);
+        UTEST_ASSERT(ctx.items[3].calls == 1);
+
+        // Add listener, it is called starting with the next emission
+        reset_context(&ctx);
+        ctx.add             = 10;
+        UTEST_ASSERT(ctx.list.call(&events_t::info, 0, 4u) == 2);
+        UTEST_ASSERT(ctx.items[10].calls == 0);
+        UTEST_ASSERT(ctx.list.call(&events_t::info, 0, 5u) == 3);
+        UTEST_ASSERT(ctx.items[10].calls == 1);
+
+        // Nested emission which removes listener
+        reset_context(&ctx);
+        ctx.nested          = true;
+        ctx.remove          = 3;
+        UTEST_ASSERT(ctx.list.call(&events_t::info, 0, 6u) == 2);
+        UTEST_ASSERT(ctx.items[1].calls == 2);
+        UTEST_ASSERT(ctx.items[3].calls == 0);
+        UTEST_ASSERT(ctx.items[10].calls == 2);
+        UTEST_ASSERT(ctx.list.size() == 2);
+    }
+
+    void test_random()
+    {
+        printf("Testing random changes...\n");
+
+        context_t ctx;
+        init_context(&ctx);
+
+        for (size_t iter=0; iter<0x2000; ++iter)
+        {
+            // Randomly attach or detach listener
+            listener_t *l       = &ctx.items[rand() % MAX_LISTENERS];
+            if (l->attached)
+            {
+                spa_hook_remove(&l->hook);
+                l->attached         = false;
+            }
+            else
+            {
+                const events_t *ev  = (rand() & 1) ? &events_v0 : &events_v1;
+                const lsp::status_t res = (rand() & 1) ?
+                    ctx.list.append(&l->hook, ev, l) :
+                    ctx.list.prepend(&l->hook, ev, l);
+                UTEST_ASSERT(res == lsp::STATUS_OK);
+                l->attached         = true;
+            }
+
+            // Check that snapshot emits listeners in the same order as spa_hook_list_call()
+            reset_context(&ctx);
+            ctx.remove          = ((rand() & 7) == 0) ? rand() % MAX_LISTENERS : -1;
+            if ((ctx.remove >= 0) && (!ctx.items[ctx.remove].attached))
+                ctx.remove          = -1;
+            const ssize_t removed = ctx.remove;
+
+            size_t expected[MAX_LISTENERS];
+            size_t count = 0;
+            struct spa_hook *h;
+            spa_list_for_each(h, &ctx.list.list()->list, link)
+            {
+                const listener_t *x = static_cast<const listener_t *>(h->cb.data);
+                expected[count++]   = x->index;
+            }
+            UTEST_ASSERT(count == ctx.list.size());
+
+            const size_t called = ctx.list.call(&events_t::info, 0, uint32_t(iter));
+            UTEST_ASSERT(called == ctx.nOrder);
+
+            // Listener removed by the first listener is skipped
+            size_t j = 0;
+            for (size_t i=0; i<count; ++i)
+            {
+                if ((i > 0) && (ssize_t(expected[i]) == removed))
+                    continue;
+                UTEST_ASSERT_MSG(j < ctx.nOrder, "iteration %d: missing listener %d", int(iter), int(expected[i]));
+                UTEST_ASSERT(ctx.order[j++] == expected[i]);
+            }
+            UTEST_ASSERT(j == ctx.nOrder);
+        }
+
+        ctx.list.clean();
+        UTEST_ASSERT(ctx.list.is_empty());
+    }
+
+    UTEST_MAIN
+    {
+        srand(0x39);
+
+        test_order();
+        test_emission_changes();
+        test_random();
+    }
+
+UTEST_END
@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/io_snapshot.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#define STRESS_READS        200000
+
+namespace
+{
+    static const uint32_t rates[] = { 44100, 48000, 96000, 192000 };
+
+    /**
+     * Driver that switches the sample rate each cycle and yields the CPU in the
+     * middle of the update to provoke torn reads
+     */
+    class Driver: public lsp::ipc::Thread
+    {
+        public:
+            struct spa_io_position *pPos;
+            volatile bool           bStop;
+            uint64_t                nCycles;
+
+        public:
+            explicit Driver(struct spa_io_position *pos)
+            {
+                pPos        = pos;
+                bStop       = false;
+                nCycles     = 0;
+            }
+
+            static void update(struct spa_io_position *pos, uint64_t k, bool yield)
+            {
+                struct spa_io_clock *c  = &pos->clock;
+                const uint32_t rate     = rates[k & 3];
+
+                lsp::spa::clock_write_begin(c);
+                c->cycle                = uint32_t(k);
+                c->rate                 = SPA_FRACTION(1, rate);
+                c->nsec                 = k * 7;
+                if (yield)
+                    lsp::ipc::Thread::yield();
+                c->position             = k * 1000;
+                c->duration             = rate / 50;
+                c->rate_diff            = 1.0 + double(k % 100) * 1e-6;
+                c->next_nsec            = c->nsec + c->duration;
+                pos->offset             = int64_t(k);
+                pos->segments[0].bar.beat   = double(k) * 0.5;
+                lsp::spa::clock_write_end(c);
+            }
+
+            virtual lsp::status_t run() override
+            {
+                for (uint64_t k=1; !bStop; ++k)
+                {
+                    update(pPos, k, (k % 3) == 0);
+                    nCycles     = k;
+                    lsp::ipc::Thread::yield();  // Wait for the next cycle
+                }
+                return lsp::STATUS_OK;
+            }
+    };
+}
+
+UTEST_BEGIN("3rdparty.spa", io_snapshot)
+
+    static void init_position(struct spa_io_position *pos)
+    {
+        memset(pos, 0, sizeof(*pos));
+        pos->state                      = SPA_IO_POSITION_STATE_RUNNING;
+        pos->n_segments                 = 1;
+        pos->segments[0].rate           = 1.0;
+        pos->segments[0].bar.flags      = SPA_IO_SEGMENT_BAR_FLAG_VALID;
+        pos->segments[0].bar.signature_num      = 4.0f;
+        pos->segments[0].bar.signature_denom    = 4.0f;
+        pos->segments[0].bar.bpm                = 120.0;
+        pos->segments[0].bar.ticks_per_beat     = 1920.0;
+    }
+
+    static bool is_consistent(const struct spa_io_position *pos)
+    {
+        const struct spa_io_clock *c = &pos->clock;
+        const uint64_t k        = c->cycle;
+        const uint32_t rate     = rates[k & 3];
+        return (c->rate.num == 1) &&
+            (c->rate.denom == rate) &&
+            (c->nsec == k * 7) &&
+            (c->position == k * 1000) &&
+            (c->duration == rate / 50) &&
+            (c->rate_diff == 1.0 + double(k % 100) * 1e-6) &&
+            (c->next_nsec == c->nsec + c->duration) &&
+            (pos->offset == int64_t(k)) &&
+            (pos->segments[0].bar.beat == double(k) * 0.5);
+    }
+
+    void test_derived()
+    {
+        struct spa_io_position pos;
+        lsp::spa::position_snapshot_t s;
+
+        printf("Testing derived values...\n");
+        init_position(&pos);
+
+        pos.clock.nsec          = 1000000000;
+        pos.clock.rate          = SPA_FRACTION(1, 48000);
+        pos.clock.duration      = 1024;
+        pos.clock.position      = 48000 * 10;
+        pos.clock.rate_diff     = 1.0;
+        pos.offset              = 48000 * 2;
+        pos.n_segments          = 2;
+
+        // Segment with bar info that is active from the start
+        pos.segments[0].start           = 0;
+        pos.segments[0].duration        = 48000 * 4;
+        pos.segments[0].position        = 100;
+        pos.segments[0].bar.beat        = 9.5;
+        pos.segments[0].bar.bar_start_tick  = 8 * 1920.0;
+
+        // Looping segment with half rate, active after 6 seconds of running time
+        pos.segments[1].start           = 48000 * 6;
+        pos.segments[1].duration        = 48000;
+        pos.segments[1].rate            = 0.5;
+        pos.segments[1].position        = 1000;
+        pos.segments[1].flags           = SPA_IO_SEGMENT_FLAG_LOOPING;
+
+        // Running time is 8 seconds: the first segment has expired, the second loops
+        UTEST_ASSERT(lsp::spa::read_position(&s, &pos) == lsp::STATUS_OK);
+        UTEST_ASSERT(s.clock.sample_rate == 48000.0);
+        UTEST_ASSERT(s.clock.actual_rate == 48000.0);
+        UTEST_ASSERT(s.clock.cycle_ns == 21333333);
+        UTEST_ASSERT(lsp::spa::clock_sample_time(&s.clock, 48) == 1001000000);
+        UTEST_ASSERT(s.running == 48000 * 8);
+        UTEST_ASSERT(s.has_segment);
+        UTEST_ASSERT(s.has_position);
+        UTEST_ASSERT(!s.has_bbt);
+        UTEST_ASSERT(s.stream_position == 1000.0);
+
+        // Running time is 3 seconds: the first segment is active
+        pos.offset              = 48000 * 7;
+        UTEST_ASSERT(lsp::spa::read_position(&s, &pos) == lsp::STATUS_OK);
+        UTEST_ASSERT(s.running == 48000 * 3);
+        UTEST_ASSERT(s.has_segment);
+        UTEST_ASSERT(s.stream_position == 48000 * 3 + 100);
+        UTEST_ASSERT(s.has_bbt);
+        UTEST_ASSERT(s.bpm == 120.0);
+        UTEST_ASSERT(s.bar == 3);
+        UTEST_ASSERT(s.bar_beat == 2);
+        UTEST_ASSERT(s.tick == 960.0);
+        UTEST_ASSERT(s.bar_start_tick == 8 * 1920.0);
+
+        // The beat is located 0.25 seconds after the cycle start, the bar start tick is used as is
+        pos.segments[0].bar.offset          = 12000;
+        pos.segments[0].bar.bar_start_tick  = 12345.0;
+        UTEST_ASSERT(lsp::spa::read_position(&s, &pos) == lsp::STATUS_OK);
+        UTEST_ASSERT(s.has_bbt);
+        UTEST_ASSERT(s.beat == 9.0);
+        UTEST_ASSERT(s.bar == 3);
+        UTEST_ASSERT(s.bar_beat == 2);
+        UTEST_ASSERT(s.tick == 0.0);
+        UTEST_ASSERT(s.bar_start_tick == 12345.0);
+
+        pos.segments[0].bar.offset          = 30000;
+        UTEST_ASSERT(lsp::spa::read_position(&s, &pos) == lsp::STATUS_OK);
+        UTEST_ASSERT(s.beat == 8.25);
+        UTEST_ASSERT(s.bar == 3);
+        UTEST_ASSERT(s.bar_beat == 1);
+        UTEST_ASSERT(s.tick == 480.0);
+
+        // Position is not known
+        pos.segments[0].flags  |= SPA_IO_SEGMENT_FLAG_NO_POSITION;
+        UTEST_ASSERT(lsp::spa::read_position(&s, &pos) == lsp::STATUS_OK);
+        UTEST_ASSERT(s.has_segment);
+        UTEST_ASSERT(!s.has_position);
+        UTEST_ASSERT(s.has_bbt);
+
+        // Running time is 5 seconds: no active segments
+        pos.offset              = 48000 * 5;
+        UTEST_ASSERT(lsp::spa::read_position(&s, &pos) == lsp::STATUS_OK);
+        UTEST_ASSERT(!s.has_segment);
+        UTEST_ASSERT(!s.has_bbt);
+
+        // Rate correction: the clock is faster than the monotonic clock
+        lsp::spa::clock_snapshot_t c;
+        pos.clock.rate_diff     = 1.001;
+        UTEST_ASSERT(lsp::spa::read_clock(&c, &pos.clock) == lsp::STATUS_OK);
+        UTEST_ASSERT(fabs(c.actual_rate - 48048.0) < 1e-6);
+        UTEST_ASSERT(c.cycle_ns == int64_t(1024 * 1e+9 / 48048.0 + 0.5));
+
+        // Write in progress
+        lsp::spa::clock_write_begin(&pos.clock);
+        UTEST_ASSERT(lsp::spa::read_clock(&c, &pos.clock, 4) == lsp::STATUS_RETRY);
+        UTEST_ASSERT(lsp::spa::read_position(&s, &pos, 4) == lsp::STATUS_RETRY);
+        lsp::spa::clock_write_end(&pos.clock);
+        UTEST_ASSERT(lsp::spa::read_clock(&c, &pos.clock, 4) == lsp::STATUS_OK);
+    }
+
+    void test_stress()
+    {
+        struct spa_io_position *pos = static_cast<struct spa_io_position *>(malloc(sizeof(struct spa_io_position)));
+        struct spa_io_position *raw = static_cast<struct spa_io_position *>(malloc(sizeof(struct spa_io_position)));
+        UTEST_ASSERT((pos != NULL) && (raw != NULL));
+        lsp::spa::position_snapshot_t s;
+
+        printf("Testing concurrent reads...\n");
+        init_position(pos);
+        Driver::update(pos, 0, false);
+
+        Driver driver(pos);
+        UTEST_ASSERT(driver.start() == lsp::STATUS_OK);
+
+        size_t naive_torn = 0, torn = 0, retries = 0, reads = 0;
+        for (size_t i=0; i<STRESS_READS; ++i)
+        {
+            // Give the driver the chance to run on a single CPU
+            if ((i % 3) == 0)
+                lsp::ipc::Thread::yield();
+
+            // Naive copy
+            memcpy(raw, pos, sizeof(*raw));
+            if (!is_consistent(raw))
+                ++naive_torn;
+
+            // Snapshot
+            lsp::status_t res = lsp::spa::read_position(&s, pos);
+            if (res == lsp::STATUS_RETRY)
+            {
+                ++retries;
+                continue;
+            }
+            UTEST_ASSERT(res == lsp::STATUS_OK);
+            ++reads;
+
+            const uint64_t k        = s.clock.cycle;
+            const uint32_t rate     = rates[k & 3];
+            if ((s.clock.sample_rate != rate) ||
+                (s.clock.nsec != k * 7) ||
+                (s.clock.position != k * 1000) ||
+                (s.clock.duration != rate / 50) ||
+                (s.clock.rate_diff != 1.0 + double(k % 100) * 1e-6) ||
+                (s.clock.next_nsec != s.clock.nsec + s.clock.duration) ||
+                (s.offset != int64_t(k)) ||
+                (s.running != int64_t(k * 1000 - k)) ||
+                (s.beat != double(k) * 0.5))
+                ++torn;
+        }
+
+        driver.bStop    = true;
+        UTEST_ASSERT(driver.join() == lsp::STATUS_OK);
+
+        printf("  driver cycles: %llu, snapshots: %d, retries exhausted: %d, torn snapshots: %d, torn naive copies: %d\n",
+            (unsigned long long)driver.nCycles, int(reads), int(retries), int(torn), int(naive_torn));
+        UTEST_ASSERT(torn == 0);
+        UTEST_ASSERT(reads > 0);
+
+        free(pos);
+        free(raw);
+    }
+
+    UTEST_MAIN
+    {
+        test_derived();
+        test_stress();
+    }
+
+UTEST_END
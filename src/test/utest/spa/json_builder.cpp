@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <pw-headers/spa/utils/json-builder.h>
+
+UTEST_BEGIN("3rdparty.spa", json_builder)
+
+    static void build_document(struct spa_json_builder *b)
+    {
+        spa_json_builder_array_push(b, "{");
+        spa_json_builder_object_string(b, "name", "alsa \"output\"\n\t\\ \x01\x1f \xc3\xa9 and a long tail without escapes 0123456789");
+        spa_json_builder_object_int(b, "id", -42);
+        spa_json_builder_object_uint(b, "serial", 1234567890123ULL);
+        spa_json_builder_object_double(b, "volume", 0.5);
+        spa_json_builder_object_bool(b, "mute", true);
+        spa_json_builder_object_null(b, "nothing");
+        spa_json_builder_object_push(b, "list", "[");
+        for (int i=0; i<5; ++i)
+            spa_json_builder_array_int(b, i);
+        spa_json_builder_array_string(b, "simple");
+        spa_json_builder_array_string(b, "with space");
+        spa_json_builder_pop(b, "]");
+        spa_json_builder_object_push(b, "compact", "{-");
+        spa_json_builder_object_string(b, "key", "value");
+        spa_json_builder_object_value(b, true, "nested", "{ \"x\": [1, 2, {\"y\": \"z\"}], w = 3 }");
+        spa_json_builder_pop(b, "}-");
+        spa_json_builder_object_value(b, false, "raw", "[ 1 2 3 ]");
+        spa_json_builder_object_stringf(b, "format", "%d-%s", 5, "x");
+        spa_json_builder_pop(b, "}");
+    }
+
+    void test_sinks()
+    {
+        static const uint32_t flags[] =
+        {
+            0,
+            SPA_JSON_BUILDER_FLAG_PRETTY,
+            SPA_JSON_BUILDER_FLAG_SIMPLE,
+            SPA_JSON_BUILDER_FLAG_SIMPLE | SPA_JSON_BUILDER_FLAG_PRETTY,
+            SPA_JSON_BUILDER_FLAG_COLOR | SPA_JSON_BUILDER_FLAG_PRETTY,
+            SPA_JSON_BUILDER_FLAG_RAW,
+        };
+
+        char fixed[0x1000];
+
+        for (size_t i=0; i<sizeof(flags)/sizeof(flags[0]); ++i)
+        {
+            struct spa_json_builder b;
+            char *expected = NULL, *actual = NULL;
+            size_t expected_len = 0, actual_len = 0;
+
+            printf("  testing flags 0x%x\n", int(flags[i]));
+
+            // Reference output through stdio
+            UTEST_ASSERT(spa_json_builder_memstream(&b, &expected, &expected_len, flags[i]) == 0);
+            build_document(&b);
+            spa_json_builder_close(&b);
+            UTEST_ASSERT(expected != NULL);
+
+            // Growable buffer
+            UTEST_ASSERT(spa_json_builder_buffer(&b, &actual, &actual_len, flags[i]) == 0);
+            build_document(&b);
+            UTEST_ASSERT(spa_json_builder_error(&b) == 0);
+            UTEST_ASSERT(spa_json_builder_length(&b) == expected_len);
+            spa_json_builder_close(&b);
+            UTEST_ASSERT(actual != NULL);
+            UTEST_ASSERT(actual_len == expected_len);
+            UTEST_ASSERT_MSG(strcmp(actual, expected) == 0, "Expected:\n%s\nGot:\n%s", expected, actual);
+
+            // Fixed buffer
+            UTEST_ASSERT(spa_json_builder_buffer_fixed(&b, fixed, sizeof(fixed), flags[i]) == 0);
+            build_document(&b);
+            UTEST_ASSERT(spa_json_builder_error(&b) == 0);
+            UTEST_ASSERT(spa_json_builder_length(&b) == expected_len);
+            spa_json_builder_close(&b);
+            UTEST_ASSERT_MSG(strcmp(fixed, expected) == 0, "Expected:\n%s\nGot:\n%s", expected, fixed);
+
+            // Truncated output of the fixed buffer
+            for (size_t size = 1; size < expected_len + 2; size += 7)
+            {
+                UTEST_ASSERT(spa_json_builder_buffer_fixed(&b, fixed, size, flags[i]) == 0);
+                build_document(&b);
+                const size_t len = spa_json_builder_length(&b);
+                UTEST_ASSERT(len == lsp_min(size - 1, expected_len));
+                UTEST_ASSERT(spa_json_builder_error(&b) == ((size > expected_len) ? 0 : -ENOSPC));
+                UTEST_ASSERT(fixed[len] == '\0');
+                UTEST_ASSERT(memcmp(fixed, expected, len) == 0);
+                spa_json_builder_close(&b);
+            }
+
+            free(expected);
+            free(actual);
+        }
+
+        // Empty output
+        struct spa_json_builder b;
+        char *mem = NULL;
+        size_t len = 1;
+        UTEST_ASSERT(spa_json_builder_buffer(&b, &mem, &len, 0) == 0);
+        spa_json_builder_close(&b);
+        UTEST_ASSERT(mem != NULL);
+        UTEST_ASSERT(len == 0);
+        UTEST_ASSERT(mem[0] == '\0');
+        free(mem);
+
+        UTEST_ASSERT(spa_json_builder_buffer_fixed(&b, NULL, 0, 0) == -EINVAL);
+    }
+
+    void test_reformat()
+    {
+        char *text = spa_json_builder_reformat("{ a = [ 1 2 { b: \"c\\n\" } ] d = e }", SPA_JSON_BUILDER_FLAG_PRETTY);
+        UTEST_ASSERT(text != NULL);
+        UTEST_ASSERT_MSG(strcmp(text,
+            "{\n"
+            "  \"a\": [\n"
+            "    1,\n"
+            "    2,\n"
+            "    {\n"
+            "      \"b\": \"c\\n\"\n"
+            "    }\n"
+            "  ],\n"
+            "  \"d\": \"e\"\n"
+            "}") == 0, "Got:\n%s", text);
+        free(text);
+    }
+
+    void test_escape_span()
+    {
+        static const char special[] = { '"', '\\', '\x01', '\x1f', '\0', ' ', '\x7f', '\x80', '\xff', 'a' };
+        char buf[0x80];
+
+        srand(0x5a5a);
+        for (size_t i=0; i<100000; ++i)
+        {
+            const int len = rand() % int(sizeof(buf));
+            for (int j=0; j<len; ++j)
+                buf[j]  = (rand() % 8) ? char('a' + rand() % 26) : special[rand() % sizeof(special)];
+
+            int expected = 0;
+            for ( ; expected < len; ++expected)
+            {
+                const uint8_t c = buf[expected];
+                if ((c < 0x20) || (c == '"') || (c == '\\'))
+                    break;
+            }
+
+            const int actual = spa_json_escape_span(buf, len);
+            UTEST_ASSERT_MSG(actual == expected, "Expected %d, got %d", expected, actual);
+        }
+    }
+
+    UTEST_MAIN
+    {
+        printf("Testing escape span detection...\n");
+        test_escape_span();
+        printf("Testing output to memory buffers...\n");
+        test_sinks();
+        printf("Testing reformatting...\n");
+        test_reformat();
+    }
+
+UTEST_END
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/JsonPodParser.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <pw-headers/spa/param/param-types.h>
+#include <pw-headers/spa/utils/json-pod.h>
+
+namespace
+{
+    static const char *valid_documents[] =
+    {
+        "{ \"volume\": 0.5, \"mute\": true, \"channelVolumes\": [ 0.1, 0.2, 0.3 ], "
+            "\"params\": [ \"a\", 1, \"b\", 2.5, \"c\", \"str\\n\\t\\\"\\u00e9\\ud83d\\ude00\", \"d\", null, "
+            "\"e\", [ 1, 2, { \"x\": 1 } ], \"f\", true, \"g\", -1e3 ] }",
+
+        "# Relaxed syntax\n"
+        "{\n"
+        "    volume = 1.0 mute = false\n"
+        "    params = [ key value \"key 2\" 3 0x10 \"\xd0\xbf\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82\" ] # trailing comment\n"
+        "    unknownKey = { a = [ 1, 2, { b = 3 } ] c = \"}\" }\n"
+        "    12345 = 7\n"
+        "    \"bluetoothAudioCodec\" = \"sbc\"\n"
+        "}\n"
+        "# The rest is ignored\n"
+        "{ \"volume\": 2.0 }",
+
+        "\"hello\"",
+
+        "42",
+
+        "{ \"params\": [ [ [ [ 1 ] ] ] ], \"channelVolumes\": [ ] }",
+
+        "# Separators between the key and the value\n"
+        "{ volume : : 0.5, mute = : true, params:: # comment\n = [ 1, 2 ], , \"channelVolumes\" : [ 0.1 ] } :",
+
+        "{ \"xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx"
+            "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx"
+            "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx\": [ 1 ], \"mute\": 1 }",
+
+        NULL
+    };
+
+    typedef struct invalid_document_t
+    {
+        const char     *text;
+        size_t          depth;
+        lsp::status_t   code;
+    } invalid_document_t;
+
+    static const invalid_document_t invalid_documents[] =
+    {
+        { "{ \"volume\": 1 ]", 16, lsp::STATUS_BAD_FORMAT },
+        { "{ \"volume\" }", 16, lsp::STATUS_BAD_FORMAT },
+        { "{ \"params\": [ 1 : 2 ] }", 16, lsp::STATUS_BAD_FORMAT },
+        { "{ : \"volume\" 1 }", 16, lsp::STATUS_BAD_FORMAT },
+        { "{ \"volume\" 1 : }", 16, lsp::STATUS_BAD_FORMAT },
+        { "{ \"params\" = [ ] = }", 16, lsp::STATUS_BAD_FORMAT },
+        { ": 1", 16, lsp::STATUS_BAD_FORMAT },
+        { "{ \"params\": [ \"abc ] }", 16, lsp::STATUS_CORRUPTED },
+        { "{ \"params\": [ \"\\x\" ] }", 16, lsp::STATUS_BAD_FORMAT },
+        { "{ \"params\": [ 1, 2 ", 16, lsp::STATUS_CORRUPTED },
+        { "{ \"params\": [ [ [ [ 1 ] ] ] ] }", 4, lsp::STATUS_OVERFLOW },
+        { "{ \"bluetoothAudioCodec\": \"unknown-codec\" }", 16, lsp::STATUS_INVALID_VALUE },
+        { "  # only comment", 16, lsp::STATUS_NO_DATA },
+        { NULL, 0, lsp::STATUS_OK }
+    };
+}
+
+UTEST_BEGIN("3rdparty.spa", json_pod_parser)
+
+    lsp::status_t parse_chunked(lsp::spa::JsonPodParser *p, struct spa_pod_builder *b,
+        const char *text, size_t chunk, struct spa_pod **pod)
+    {
+        const struct spa_type_info *info = &spa_type_param[SPA_PARAM_Props];
+        lsp::status_t res = p->begin(b, info);
+        if (res != lsp::STATUS_OK)
+            return res;
+
+        const size_t len = strlen(text);
+        for (size_t off = 0; off < len; off += chunk)
+        {
+            if ((res = p->parse(&text[off], lsp_min(chunk, len - off))) != lsp::STATUS_OK)
+                return res;
+        }
+
+        return p->end(pod);
+    }
+
+    void test_valid()
+    {
+        static const size_t chunks[] = { 1, 2, 3, 5, 7, 16, 64, 1024 };
+        const struct spa_type_info *info = &spa_type_param[SPA_PARAM_Props];
+
+        uint8_t expected[0x1000], actual[0x1000];
+        struct spa_pod_builder b;
+        lsp::spa::JsonPodParser p;
+
+        UTEST_ASSERT(p.init() == lsp::STATUS_OK);
+
+        for (const char * const *doc = valid_documents; *doc != NULL; ++doc)
+        {
+            printf("  testing document #%d\n", int(doc - valid_documents));
+
+            memset(expected, 0, sizeof(expected));
+            spa_pod_builder_init(&b, expected, sizeof(expected));
+            UTEST_ASSERT(spa_json_to_pod(&b, 0, info, *doc, strlen(*doc)) >= 0);
+            const size_t exp_size = b.state.offset;
+            UTEST_ASSERT(exp_size > 0);
+
+            for (size_t i=0; i<sizeof(chunks)/sizeof(chunks[0]); ++i)
+            {
+                struct spa_pod *pod = NULL;
+                memset(actual, 0, sizeof(actual));
+                spa_pod_builder_init(&b, actual, sizeof(actual));
+
+                lsp::status_t res = parse_chunked(&p, &b, *doc, chunks[i], &pod);
+                UTEST_ASSERT_MSG(res == lsp::STATUS_OK, "Error code=%d at line %d, column %d, chunk size=%d",
+                    int(res), int(p.line()), int(p.column()), int(chunks[i]));
+                UTEST_ASSERT(p.done());
+                UTEST_ASSERT(pod == reinterpret_cast<struct spa_pod *>(actual));
+                UTEST_ASSERT_MSG(b.state.offset == exp_size, "Size mismatch: %d vs %d, chunk size=%d",
+                    int(b.state.offset), int(exp_size), int(chunks[i]));
+                UTEST_ASSERT_MSG(memcmp(expected, actual, exp_size) == 0, "Data mismatch, chunk size=%d", int(chunks[i]));
+            }
+        }
+
+        p.destroy();
+    }
+
+    void test_invalid()
+    {
+        uint8_t buf[0x1000];
+        struct spa_pod_builder b;
+
+        for (const invalid_document_t *doc = invalid_documents; doc->text != NULL; ++doc)
+        {
+            printf("  testing invalid document #%d\n", int(doc - invalid_documents));
+
+            lsp::spa::JsonPodParser p;
+            UTEST_ASSERT(p.init(doc->depth) == lsp::STATUS_OK);
+
+            for (size_t chunk = 1; chunk <= 64; chunk <<= 1)
+            {
+                spa_pod_builder_init(&b, buf, sizeof(buf));
+                lsp::status_t res = parse_chunked(&p, &b, doc->text, chunk, NULL);
+                UTEST_ASSERT_MSG(res == doc->code, "Expected code=%d, got %d, chunk size=%d",
+                    int(doc->code), int(res), int(chunk));
+            }
+        }
+    }
+
+    void test_location()
+    {
+        static const char *text = "{\n  \"volume\": 1.0,\n  \"mute\" ]\n}";
+        uint8_t buf[0x100];
+        struct spa_pod_builder b;
+        lsp::spa::JsonPodParser p;
+
+        UTEST_ASSERT(p.init() == lsp::STATUS_OK);
+        spa_pod_builder_init(&b, buf, sizeof(buf));
+        UTEST_ASSERT(parse_chunked(&p, &b, text, 3, NULL) == lsp::STATUS_BAD_FORMAT);
+        UTEST_ASSERT_MSG((p.line() == 3) && (p.column() == 10), "line=%d, column=%d", int(p.line()), int(p.column()));
+    }
+
+    UTEST_MAIN
+    {
+        printf("Testing valid documents...\n");
+        test_valid();
+        printf("Testing invalid documents...\n");
+        test_invalid();
+        printf("Testing error location...\n");
+        test_location();
+    }
+
+UTEST_END
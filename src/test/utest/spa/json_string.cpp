@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <pw-headers/spa/utils/json-core.h>
+
+#define MAX_STRING_LENGTH       0x200
+
+UTEST_BEGIN("3rdparty.spa", json_string)
+
+    // Reference scalar implementation that processes characters one by one
+    static int encode_string(char *str, int size, const char *val)
+    {
+        static const char hex[] = { "0123456789abcdef" };
+        int len = 0;
+
+    #define PUT(c) { if (len < size) *str++ = c; len++; }
+        PUT('"');
+        for ( ; *val; ++val)
+        {
+            switch (*val)
+            {
+                case '\n': PUT('\\'); PUT('n'); break;
+                case '\r': PUT('\\'); PUT('r'); break;
+                case '\b': PUT('\\'); PUT('b'); break;
+                case '\t': PUT('\\'); PUT('t'); break;
+                case '\f': PUT('\\'); PUT('f'); break;
+                case '\\':
+                case '"':
+                    PUT('\\'); PUT(*val);
+                    break;
+                default:
+                    if ((*val > 0) && (*val < 0x20))
+                    {
+                        PUT('\\'); PUT('u'); PUT('0'); PUT('0');
+                        PUT(hex[((*val) >> 4) & 0xf]); PUT(hex[(*val) & 0xf]);
+                    }
+                    else
+                        PUT(*val);
+                    break;
+            }
+        }
+        PUT('"');
+        PUT('\0');
+    #undef PUT
+
+        return len - 1;
+    }
+
+    // Reference scalar implementation that processes characters one by one
+    static int parse_stringn(const char *val, int len, char *result, int maxlen)
+    {
+        if (maxlen <= len)
+            return -ENOSPC;
+        if (!spa_json_is_string(val, len))
+        {
+            if (result != val)
+                memmove(result, val, len);
+            result += len;
+            *result = '\0';
+            return 1;
+        }
+
+        for (const char *p = val + 1; p < val + len; ++p)
+        {
+            if (*p == '\\')
+            {
+                ++p;
+                if (*p == 'n')
+                    *result++ = '\n';
+                else if (*p == 'r')
+                    *result++ = '\r';
+                else if (*p == 'b')
+                    *result++ = '\b';
+                else if (*p == 't')
+                    *result++ = '\t';
+                else if (*p == 'f')
+                    *result++ = '\f';
+                else if (*p == 'u')
+                {
+                    static const uint8_t prefix[] = { 0, 0xc0, 0xe0, 0xf0 };
+                    static const uint32_t enc[] = { 0x80, 0x800, 0x10000 };
+                    uint32_t idx, n, v, cp;
+                    if ((val + len - p < 5) || (spa_json_parse_hex(p + 1, 4, &cp) < 0))
+                    {
+                        *result++ = *p;
+                        continue;
+                    }
+                    p += 4;
+
+                    if ((cp >= 0xd800) && (cp <= 0xdbff))
+                    {
+                        if ((val + len - p < 7) ||
+                            (p[1] != '\\') || (p[2] != 'u') ||
+                            (spa_json_parse_hex(p + 3, 4, &v) < 0) ||
+                            (v < 0xdc00) || (v > 0xdfff))
+                            continue;
+                        p += 6;
+                        cp = 0x010000 + (((cp & 0x3ff) << 10) | (v & 0x3ff));
+                    }
+                    else if ((cp >= 0xdc00) && (cp <= 0xdfff))
+                        continue;
+
+                    for (idx = 0; idx < 3; ++idx)
+                        if (cp < enc[idx])
+                            break;
+                    for (n = idx; n > 0; --n, cp >>= 6)
+                        result[n] = (cp | 0x80) & 0xbf;
+                    *result++ = (cp | prefix[idx]) & 0xff;
+                    result += idx;
+                }
+                else
+                    *result++ = *p;
+            }
+            else if (*p == '\"')
+                break;
+            else
+                *result++ = *p;
+        }
+        *result = '\0';
+        return 1;
+    }
+
+    static char random_char()
+    {
+        static const char special[] =
+        {
+            '"', '\\', '\n', '\r', '\b', '\t', '\f', '\x01', '\x1f', '\x7f', '\x80', '\xc3', '\xff', '/', 'u'
+        };
+        switch (rand() % 16)
+        {
+            case 0: return special[rand() % sizeof(special)];
+            case 1: return char(1 + rand() % 255);
+            default: break;
+        }
+        return char('a' + rand() % 26);
+    }
+
+    static size_t random_string(char *dst, size_t max)
+    {
+        // Mostly clean strings with occasional special characters
+        const size_t len = rand() % max;
+        for (size_t i=0; i<len; ++i)
+            dst[i] = random_char();
+        dst[len] = '\0';
+        return len;
+    }
+
+    static size_t random_json_string(char *dst, size_t max)
+    {
+        static const char *escapes[] =
+        {
+            "\\n", "\\r", "\\b", "\\t", "\\f", "\\\\", "\\\"", "\\/", "\\u0041", "\\u00e9", "\\u20ac",
+            "\\ud83d\\ude00", "\\ud83d", "\\ude00", "\\ud83dx", "\\u12", "\\uzzzz", "\\x", "\\"
+        };
+
+        size_t len = 0;
+        dst[len++] = '"';
+        const size_t count = rand() % (max - 16);
+        while (len < count)
+        {
+            if ((rand() % 12) == 0)
+            {
+                const char *e = escapes[rand() % (sizeof(escapes)/sizeof(escapes[0]))];
+                const size_t n = strlen(e);
+                if (len + n >= max - 2)
+                    break;
+                memcpy(&dst[len], e, n);
+                len += n;
+            }
+            else
+            {
+                const char c = random_char();
+                if ((c != '"') && (c != '\\'))
+                    dst[len++] = c;
+            }
+        }
+        if (rand() % 8)
+            dst[len++] = '"';
+        dst[len] = '\0';
+        return len;
+    }
+
+    void test_encode()
+    {
+        char src[MAX_STRING_LENGTH];
+        char expected[MAX_STRING_LENGTH * 6 + 8];
+        char actual[MAX_STRING_LENGTH * 6 + 8];
+
+        for (size_t i=0; i<200000; ++i)
+        {
+            random_string(src, sizeof(src));
+            const int size = (rand() % 4) ? int(sizeof(actual)) : rand() % (MAX_STRING_LENGTH * 2);
+
+            memset(expected, 0x55, sizeof(expected));
+            memset(actual, 0x55, sizeof(actual));
+            const int n1 = encode_string(expected, size, src);
+            const int n2 = spa_json_encode_string(actual, size, src);
+
+            UTEST_ASSERT_MSG(n1 == n2, "Length mismatch: expected %d, got %d", n1, n2);
+            UTEST_ASSERT_MSG(memcmp(expected, actual, sizeof(actual)) == 0,
+                "Output mismatch for size=%d:\nexpected: %s\nactual: %s", size, expected, actual);
+        }
+    }
+
+    void test_parse()
+    {
+        char src[MAX_STRING_LENGTH];
+        char expected[MAX_STRING_LENGTH * 2];
+        char actual[MAX_STRING_LENGTH * 2];
+
+        for (size_t i=0; i<200000; ++i)
+        {
+            const size_t len = ((rand() % 8) == 0) ?
+                random_string(src, sizeof(src)) :
+                random_json_string(src, sizeof(src));
+            const int maxlen = (rand() % 16) ? int(sizeof(actual)) : int(len);
+
+            memset(expected, 0x55, sizeof(expected));
+            memset(actual, 0x55, sizeof(actual));
+            const int r1 = parse_stringn(src, len, expected, maxlen);
+            const int r2 = spa_json_parse_stringn(src, len, actual, maxlen);
+
+            UTEST_ASSERT_MSG(r1 == r2, "Result mismatch: expected %d, got %d", r1, r2);
+            UTEST_ASSERT_MSG(memcmp(expected, actual, sizeof(actual)) == 0,
+                "Output mismatch for %s:\nexpected: %s\nactual: %s", src, expected, actual);
+        }
+    }
+
+    void test_in_place()
+    {
+        char src[MAX_STRING_LENGTH];
+        char buf[MAX_STRING_LENGTH];
+        char expected[MAX_STRING_LENGTH * 2];
+
+        for (size_t i=0; i<100000; ++i)
+        {
+            const size_t len = random_json_string(src, sizeof(src));
+            memcpy(buf, src, len + 1);
+
+            UTEST_ASSERT(parse_stringn(src, len, expected, sizeof(expected)) == 1);
+            UTEST_ASSERT(spa_json_parse_stringn(buf, len, buf, len + 1) == 1);
+            UTEST_ASSERT_MSG(strcmp(expected, buf) == 0,
+                "In-place output mismatch for %s:\nexpected: %s\nactual: %s", src, expected, buf);
+        }
+    }
+
+    void test_round_trip()
+    {
+        char src[MAX_STRING_LENGTH];
+        char encoded[MAX_STRING_LENGTH * 6 + 8];
+        char decoded[MAX_STRING_LENGTH * 6 + 8];
+
+        for (size_t i=0; i<100000; ++i)
+        {
+            random_string(src, sizeof(src));
+            const int len = spa_json_encode_string(encoded, sizeof(encoded), src);
+            UTEST_ASSERT(len < int(sizeof(encoded)));
+            UTEST_ASSERT(spa_json_parse_stringn(encoded, len, decoded, sizeof(decoded)) == 1);
+            UTEST_ASSERT_MSG(strcmp(src, decoded) == 0, "Round trip failed for %s", encoded);
+        }
+    }
+
+    UTEST_MAIN
+    {
+        srand(0x3ec0de);
+
+        printf("Testing encoding...\n");
+        test_encode();
+        printf("Testing parsing...\n");
+        test_parse();
+        printf("Testing in-place parsing...\n");
+        test_in_place();
+        printf("Testing round trip...\n");
+        test_round_trip();
+    }
+
+UTEST_END
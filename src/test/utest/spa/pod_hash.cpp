@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/pod_hash.h>
+#include <lsp-plug.in/3rdparty/spa/PodSet.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <pw-headers/spa/param/format.h>
+#include <pw-headers/spa/param/audio/raw.h>
+#include <pw-headers/spa/pod/builder.h>
+#include <pw-headers/spa/pod/compare.h>
+
+UTEST_BEGIN("3rdparty.spa", pod_hash)
+
+    static const struct spa_pod *make_format(
+        struct spa_pod_builder *b, uint32_t rate, uint32_t channels,
+        const uint32_t *formats, size_t n_formats, bool reverse)
+    {
+        struct spa_pod_frame of, cf;
+
+        spa_pod_builder_push_object(b, &of, SPA_TYPE_OBJECT_Format, SPA_PARAM_EnumFormat);
+
+        if (!reverse)
+        {
+            spa_pod_builder_prop(b, SPA_FORMAT_mediaType, 0);
+            spa_pod_builder_id(b, SPA_MEDIA_TYPE_audio);
+            spa_pod_builder_prop(b, SPA_FORMAT_mediaSubtype, 0);
+            spa_pod_builder_id(b, SPA_MEDIA_SUBTYPE_raw);
+        }
+
+        spa_pod_builder_prop(b, SPA_FORMAT_AUDIO_format, 0);
+        spa_pod_builder_push_choice(b, &cf, SPA_CHOICE_Enum, 0);
+        spa_pod_builder_id(b, formats[0]);
+        for (size_t i=0; i<n_formats; ++i)
+            spa_pod_builder_id(b, formats[(reverse) ? n_formats - i - 1 : i]);
+        spa_pod_builder_pop(b, &cf);
+
+        spa_pod_builder_prop(b, SPA_FORMAT_AUDIO_rate, 0);
+        spa_pod_builder_int(b, rate);
+        spa_pod_builder_prop(b, SPA_FORMAT_AUDIO_channels, 0);
+        spa_pod_builder_int(b, channels);
+
+        if (reverse)
+        {
+            spa_pod_builder_prop(b, SPA_FORMAT_mediaSubtype, 0);
+            spa_pod_builder_id(b, SPA_MEDIA_SUBTYPE_raw);
+            spa_pod_builder_prop(b, SPA_FORMAT_mediaType, 0);
+            spa_pod_builder_id(b, SPA_MEDIA_TYPE_audio);
+        }
+
+        return static_cast<const struct spa_pod *>(spa_pod_builder_pop(b, &of));
+    }
+
+    void check_equal(const char *label, const struct spa_pod *a, const struct spa_pod *b)
+    {
+        printf("  checking equality: %s\n", label);
+        UTEST_ASSERT_MSG(lsp::spa::pod_equals(a, b), "Values expected to be equal: %s", label);
+        UTEST_ASSERT_MSG(lsp::spa::pod_equals(b, a), "Values expected to be equal: %s", label);
+        UTEST_ASSERT_MSG(lsp::spa::pod_hash(a) == lsp::spa::pod_hash(b), "Hashes expected to be equal: %s", label);
+    }
+
+    void check_differ(const char *label, const struct spa_pod *a, const struct spa_pod *b)
+    {
+        printf("  checking difference: %s\n", label);
+        UTEST_ASSERT_MSG(!lsp::spa::pod_equals(a, b), "Values expected to differ: %s", label);
+        UTEST_ASSERT_MSG(!lsp::spa::pod_equals(b, a), "Values expected to differ: %s", label);
+        UTEST_ASSERT_MSG(lsp::spa::pod_hash(a) != lsp::spa::pod_hash(b), "Hashes expected to differ: %s", label);
+    }
+
+    void test_values()
+    {
+        uint8_t buf[0x1000];
+        struct spa_pod_builder b;
+        struct spa_pod_frame f;
+        spa_pod_builder_init(&b, buf, sizeof(buf));
+
+        // Plain values
+        spa_pod_builder_float(&b, 0.0f);
+        const struct spa_pod *pz = static_cast<const struct spa_pod *>(spa_pod_builder_deref(&b, 0));
+        uint32_t off = b.state.offset;
+        spa_pod_builder_float(&b, -0.0f);
+        const struct spa_pod *nz = static_cast<const struct spa_pod *>(spa_pod_builder_deref(&b, off));
+        check_equal("+0.0f vs -0.0f", pz, nz);
+
+        off = b.state.offset;
+        spa_pod_builder_fraction(&b, 1, 2);
+        const struct spa_pod *f1 = static_cast<const struct spa_pod *>(spa_pod_builder_deref(&b, off));
+        off = b.state.offset;
+        spa_pod_builder_fraction(&b, 24, 48);
+        const struct spa_pod *f2 = static_cast<const struct spa_pod *>(spa_pod_builder_deref(&b, off));
+        off = b.state.offset;
+        spa_pod_builder_fraction(&b, 2, 3);
+        const struct spa_pod *f3 = static_cast<const struct spa_pod *>(spa_pod_builder_deref(&b, off));
+        check_equal("1/2 vs 24/48", f1, f2);
+        check_differ("1/2 vs 2/3", f1, f3);
+        UTEST_ASSERT(spa_pod_compare(f1, f2) == 0);
+
+        off = b.state.offset;
+        spa_pod_builder_bool(&b, 1);
+        const struct spa_pod *b1 = static_cast<const struct spa_pod *>(spa_pod_builder_deref(&b, off));
+        off = b.state.offset;
+        spa_pod_builder_int(&b, 1);
+        const struct spa_pod *i1 = static_cast<const struct spa_pod *>(spa_pod_builder_deref(&b, off));
+        check_differ("bool vs int", b1, i1);
+
+        // Single-value choice is the same as plain value
+        off = b.state.offset;
+        spa_pod_builder_push_choice(&b, &f, SPA_CHOICE_None, 0);
+        spa_pod_builder_int(&b, 1);
+        const struct spa_pod *c1 = static_cast<const struct spa_pod *>(spa_pod_builder_pop(&b, &f));
+        check_equal("int vs choice of int", i1, c1);
+
+        // Range choices are positional
+        spa_pod_builder_push_choice(&b, &f, SPA_CHOICE_Range, 0);
+        spa_pod_builder_int(&b, 48000);
+        spa_pod_builder_int(&b, 44100);
+        spa_pod_builder_int(&b, 96000);
+        const struct spa_pod *r1 = static_cast<const struct spa_pod *>(spa_pod_builder_pop(&b, &f));
+        spa_pod_builder_push_choice(&b, &f, SPA_CHOICE_Range, 0);
+        spa_pod_builder_int(&b, 48000);
+        spa_pod_builder_int(&b, 96000);
+        spa_pod_builder_int(&b, 44100);
+        const struct spa_pod *r2 = static_cast<const struct spa_pod *>(spa_pod_builder_pop(&b, &f));
+        check_differ("range order", r1, r2);
+        UTEST_ASSERT(spa_pod_compare(r1, r2) == 0);
+
+        // Strings do not depend on padding
+        off = b.state.offset;
+        spa_pod_builder_string(&b, "abc");
+        const struct spa_pod *s1 = static_cast<const struct spa_pod *>(spa_pod_builder_deref(&b, off));
+        memset(&buf[off + sizeof(struct spa_pod) + 4], 0x55, 4);
+        off = b.state.offset;
+        spa_pod_builder_string(&b, "abc");
+        const struct spa_pod *s2 = static_cast<const struct spa_pod *>(spa_pod_builder_deref(&b, off));
+        check_equal("strings", s1, s2);
+
+        // Structures are compared element-wise
+        spa_pod_builder_push_struct(&b, &f);
+        spa_pod_builder_int(&b, 1);
+        spa_pod_builder_string(&b, "abc");
+        const struct spa_pod *st1 = static_cast<const struct spa_pod *>(spa_pod_builder_pop(&b, &f));
+        spa_pod_builder_push_struct(&b, &f);
+        spa_pod_builder_int(&b, 1);
+        spa_pod_builder_string(&b, "abc");
+        const struct spa_pod *st2 = static_cast<const struct spa_pod *>(spa_pod_builder_pop(&b, &f));
+        spa_pod_builder_push_struct(&b, &f);
+        spa_pod_builder_int(&b, 1);
+        const struct spa_pod *st3 = static_cast<const struct spa_pod *>(spa_pod_builder_pop(&b, &f));
+        check_equal("structs", st1, st2);
+        check_differ("struct length", st1, st3);
+    }
+
+    void test_objects()
+    {
+        static const uint32_t fmt1[] = { SPA_AUDIO_FORMAT_F32, SPA_AUDIO_FORMAT_S16, SPA_AUDIO_FORMAT_S32 };
+        static const uint32_t fmt2[] = { SPA_AUDIO_FORMAT_F32, SPA_AUDIO_FORMAT_S32, SPA_AUDIO_FORMAT_S16 };
+        static const uint32_t fmt3[] = { SPA_AUDIO_FORMAT_F32, SPA_AUDIO_FORMAT_S24, SPA_AUDIO_FORMAT_S16 };
+
+        uint8_t buf[0x1000];
+        struct spa_pod_builder b;
+        spa_pod_builder_init(&b, buf, sizeof(buf));
+
+        const struct spa_pod *p1 = make_format(&b, 48000, 2, fmt1, 3, false);
+        const struct spa_pod *p2 = make_format(&b, 48000, 2, fmt1, 3, true);
+        const struct spa_pod *p3 = make_format(&b, 48000, 2, fmt2, 3, false);
+        const struct spa_pod *p4 = make_format(&b, 44100, 2, fmt1, 3, false);
+        const struct spa_pod *p5 = make_format(&b, 48000, 2, fmt3, 3, false);
+
+        UTEST_ASSERT((p1 != NULL) && (p2 != NULL) && (p3 != NULL) && (p4 != NULL) && (p5 != NULL));
+
+        check_equal("property order", p1, p2);
+        check_equal("enum order", p1, p3);
+        check_differ("rate", p1, p4);
+        check_differ("enum contents", p1, p5);
+
+        UTEST_ASSERT(spa_pod_compare(p1, p2) == 0);
+        UTEST_ASSERT(spa_pod_compare(p1, p3) == 0);
+    }
+
+    void test_set()
+    {
+        static const uint32_t fmts[] = { SPA_AUDIO_FORMAT_F32, SPA_AUDIO_FORMAT_S16, SPA_AUDIO_FORMAT_S32 };
+        static const uint32_t rates[] = { 44100, 48000, 88200, 96000, 192000 };
+
+        uint8_t buf[0x400];
+        struct spa_pod_builder b;
+        lsp::spa::PodSet set;
+        const struct spa_pod *stored = NULL;
+
+        for (size_t i=0; i<1000; ++i)
+        {
+            spa_pod_builder_init(&b, buf, sizeof(buf));
+            const uint32_t rate     = rates[i % 5];
+            const uint32_t channels = 1 + (i / 5) % 8;
+            const struct spa_pod *pod = make_format(&b, rate, channels, fmts, 3, i & 1);
+            UTEST_ASSERT(pod != NULL);
+
+            lsp::status_t res = set.insert(pod, &stored);
+            UTEST_ASSERT(stored != NULL);
+            UTEST_ASSERT(lsp::spa::pod_equals(pod, stored));
+            UTEST_ASSERT(res == ((i < 40) ? lsp::STATUS_OK : lsp::STATUS_ALREADY_EXISTS));
+            UTEST_ASSERT(set.find(pod) == stored);
+        }
+
+        UTEST_ASSERT(set.size() == 40);
+        for (size_t i=0; i<set.size(); ++i)
+        {
+            spa_pod_builder_init(&b, buf, sizeof(buf));
+            const struct spa_pod *pod = make_format(&b, rates[i % 5], 1 + (i / 5) % 8, fmts, 3, false);
+            UTEST_ASSERT(lsp::spa::pod_equals(set.get(i), pod));
+        }
+        UTEST_ASSERT(set.get(set.size()) == NULL);
+
+        set.clear();
+        UTEST_ASSERT(set.size() == 0);
+        UTEST_ASSERT(set.find(make_format(&b, 48000, 2, fmts, 3, false)) == NULL);
+        set.flush();
+    }
+
+    UTEST_MAIN
+    {
+        printf("Testing plain values...\n");
+        test_values();
+        printf("Testing objects...\n");
+        test_objects();
+        printf("Testing set of values...\n");
+        test_set();
+    }
+
+UTEST_END
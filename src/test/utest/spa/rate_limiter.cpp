@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/RateLimiter.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <pw-headers/spa/utils/ratelimit.h>
+
+#define MAX_SOURCES         32
+#define NUM_THREADS         4
+#define THREAD_EVENTS       100000
+
+namespace
+{
+    class Emitter: public lsp::ipc::Thread
+    {
+        public:
+            lsp::spa::RateLimiter  *pLimiter;
+            uint64_t                nKey;
+            size_t                  nPassed;
+            size_t                  nReported;
+            size_t                 *pBarrier;
+
+        public:
+            explicit Emitter(lsp::spa::RateLimiter *limiter, uint64_t key, size_t *barrier)
+            {
+                pLimiter    = limiter;
+                nKey        = key;
+                nPassed     = 0;
+                nReported   = 0;
+                pBarrier    = barrier;
+            }
+
+            virtual lsp::status_t run() override
+            {
+                for (size_t i=0; i<THREAD_EVENTS; ++i)
+                {
+                    // All events fall into two intervals, threads enter the second interval together,
+                    // so the result does not depend on the number of CPUs and the scheduling
+                    if (i == THREAD_EVENTS / 2)
+                    {
+                        lsp::atomic_add(pBarrier, size_t(1));
+                        while (lsp::atomic_load(pBarrier) < NUM_THREADS)
+                            lsp::ipc::Thread::yield();
+                    }
+
+                    const int res = pLimiter->test(nKey, (i < THREAD_EVENTS / 2) ? 100 : 2000);
+                    if (res >= 0)
+                    {
+                        ++nPassed;
+                        nReported  += res;
+                    }
+                }
+                return lsp::STATUS_OK;
+            }
+    };
+} /* namespace */
+
+UTEST_BEGIN("3rdparty.spa", rate_limiter)
+
+    void test_basic()
+    {
+        printf("Testing basic functions...\n");
+
+        lsp::spa::RateLimiter rl;
+        UTEST_ASSERT(rl.test(1, 0) == 0);
+        UTEST_ASSERT(rl.init(0, 1000, 3) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(rl.init(16, 0, 3) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(rl.init(16, 1000, 0) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(rl.init(16, 1000, 0x10000) == lsp::STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(rl.init(16, 1000, 3) == lsp::STATUS_OK);
+
+        // Burst of 3 events per source
+        for (size_t i=0; i<3; ++i)
+        {
+            UTEST_ASSERT(rl.test(1, 10 + i) == 0);
+            UTEST_ASSERT(rl.test(2, 10 + i) == 0);
+        }
+        UTEST_ASSERT(rl.test(1, 20) < 0);
+        UTEST_ASSERT(rl.test(1, 30) < 0);
+        UTEST_ASSERT(rl.test(2, 30) < 0);
+        UTEST_ASSERT(rl.test(3, 30) == 0);
+        UTEST_ASSERT(rl.suppressed() == 3);
+        UTEST_ASSERT(rl.sources() == 3);
+
+        // Window is reopened after interval
+        UTEST_ASSERT(rl.test(1, 1010) < 0);
+        UTEST_ASSERT(rl.test(1, 1011) == 3);
+        UTEST_ASSERT(rl.test(1, 1012) == 0);
+        UTEST_ASSERT(rl.test(2, 1020) == 1);
+
+        rl.reset();
+        UTEST_ASSERT(rl.suppressed() == 0);
+        UTEST_ASSERT(rl.sources() == 0);
+        rl.destroy();
+        UTEST_ASSERT(rl.test(1, 0) == 0);
+    }
+
+    void test_reference()
+    {
+        printf("Testing equivalence with spa_ratelimit_test()...\n");
+
+        static const uint64_t intervals[] = { 1, 100, 1000, 1024, 2047 };
+
+        for (size_t n=0; n<sizeof(intervals)/sizeof(intervals[0]); ++n)
+        {
+            const uint64_t interval = intervals[n];
+            const uint32_t burst    = 1 + rand() % 8;
+
+            lsp::spa::RateLimiter rl;
+            struct spa_ratelimit ref[MAX_SOURCES];
+            UTEST_ASSERT(rl.init(MAX_SOURCES * 4, interval, burst) == lsp::STATUS_OK);
+            for (size_t i=0; i<MAX_SOURCES; ++i)
+            {
+                memset(&ref[i], 0, sizeof(ref[i]));
+                ref[i].interval     = interval;
+                ref[i].burst        = burst;
+                ref[i].begin        = 0;
+            }
+
+            uint64_t now = 1000000;
+            for (size_t i=0; i<0x10000; ++i)
+            {
+                now                += rand() % (interval * 2 / burst + 1);
+                const size_t src    = rand() % MAX_SOURCES;
+                const uint64_t key  = src * 0x10001;
+
+                const int expected  = spa_ratelimit_test(&ref[src], now);
+                const int actual    = rl.test(key, now);
+                UTEST_ASSERT_MSG((expected < 0) ? (actual < 0) : (actual == expected),
+                    "interval=%d burst=%d event=%d source=%d: expected=%d actual=%d",
+                    int(interval), int(burst), int(i), int(src), expected, actual);
+            }
+        }
+    }
+
+    void test_overflow()
+    {
+        printf("Testing table overflow...\n");
+
+        lsp::spa::RateLimiter rl;
+        UTEST_ASSERT(rl.init(4, 1000, 2) == lsp::STATUS_OK);
+
+        // Sources which do not fit into the table share the overflow bucket
+        size_t passed = 0;
+        for (size_t i=0; i<64; ++i)
+            if (rl.test(i, 100) >= 0)
+                ++passed;
+        UTEST_ASSERT(rl.sources() == 4);
+        UTEST_ASSERT(passed == 4 + 2);
+
+        // Idle buckets are reused by other sources
+        for (size_t i=0; i<4; ++i)
+            UTEST_ASSERT(rl.test(1000 + i, 100 + 1000 * lsp::spa::RateLimiter::IDLE_WINDOWS + 1) == 0);
+        UTEST_ASSERT(rl.sources() == 4);
+        UTEST_ASSERT(rl.test(1000, 100 + 1000 * lsp::spa::RateLimiter::IDLE_WINDOWS + 2) == 0);
+        UTEST_ASSERT(rl.test(1000, 100 + 1000 * lsp::spa::RateLimiter::IDLE_WINDOWS + 3) < 0);
+    }
+
+    void test_threads()
+    {
+        printf("Testing concurrent access...\n");
+
+        lsp::spa::RateLimiter rl;
+        UTEST_ASSERT(rl.init(64, 1000, 10) == lsp::STATUS_OK);
+
+        // Threads share the same key by pairs
+        Emitter *threads[NUM_THREADS];
+        size_t barrier = 0;
+        for (size_t i=0; i<NUM_THREADS; ++i)
+        {
+            threads[i] = new Emitter(&rl, i / 2, &barrier);
+            UTEST_ASSERT(threads[i] != NULL);
+        }
+        for (size_t i=0; i<NUM_THREADS; ++i)
+            UTEST_ASSERT(threads[i]->start() == lsp::STATUS_OK);
+        for (size_t i=0; i<NUM_THREADS; ++i)
+            threads[i]->join();
+
+        // Each key passes exactly burst events per interval
+        for (size_t i=0; i<NUM_THREADS; i += 2)
+        {
+            const size_t passed     = threads[i]->nPassed + threads[i+1]->nPassed;
+            const size_t reported   = threads[i]->nReported + threads[i+1]->nReported;
+            printf("  key %d: passed=%d reported=%d\n", int(i / 2), int(passed), int(reported));
+            UTEST_ASSERT(passed == 20);
+            UTEST_ASSERT(reported <= lsp::spa::RateLimiter::MAX_COUNT);
+        }
+        UTEST_ASSERT(rl.suppressed() == (THREAD_EVENTS * 2 - 20) * (NUM_THREADS / 2));
+
+        for (size_t i=0; i<NUM_THREADS; ++i)
+            delete threads[i];
+    }
+
+    UTEST_MAIN
+    {
+        srand(0x40);
+
+        test_basic();
+        test_reference();
+        test_overflow();
+        test_threads();
+    }
+
+UTEST_END
@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-3rd-party
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-3rd-party is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-3rd-party is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-3rd-party. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/3rdparty/spa/Remixer.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#define K3DB                0.70710678f
+#define MAX_CHANNELS        16
+#define MAX_SAMPLES         3000
+
+namespace
+{
+    static const uint32_t pos_mono[]    = { SPA_AUDIO_CHANNEL_MONO };
+    static const uint32_t pos_stereo[]  = { SPA_AUDIO_CHANNEL_FL, SPA_AUDIO_CHANNEL_FR };
+    static const uint32_t pos_5_1[]     =
+    {
+        SPA_AUDIO_CHANNEL_FL, SPA_AUDIO_CHANNEL_FR, SPA_AUDIO_CHANNEL_FC,
+        SPA_AUDIO_CHANNEL_LFE, SPA_AUDIO_CHANNEL_SL, SPA_AUDIO_CHANNEL_SR
+    };
+    static const uint32_t pos_5_1r[]    =
+    {
+        SPA_AUDIO_CHANNEL_FL, SPA_AUDIO_CHANNEL_FR, SPA_AUDIO_CHANNEL_FC,
+        SPA_AUDIO_CHANNEL_LFE, SPA_AUDIO_CHANNEL_RL, SPA_AUDIO_CHANNEL_RR
+    };
+    static const uint32_t pos_7_1_4[]   =
+    {
+        SPA_AUDIO_CHANNEL_FL, SPA_AUDIO_CHANNEL_FR, SPA_AUDIO_CHANNEL_FC, SPA_AUDIO_CHANNEL_LFE,
+        SPA_AUDIO_CHANNEL_SL, SPA_AUDIO_CHANNEL_SR, SPA_AUDIO_CHANNEL_RL, SPA_AUDIO_CHANNEL_RR,
+        SPA_AUDIO_CHANNEL_TFL, SPA_AUDIO_CHANNEL_TFR, SPA_AUDIO_CHANNEL_TRL, SPA_AUDIO_CHANNEL_TRR
+    };
+
+    #define POS(x)      x, sizeof(x)/sizeof(x[0])
+} /* namespace */
+
+UTEST_BEGIN("3rdparty.spa", remixer)
+
+    void check_matrix(const lsp::spa::Remixer *r, const float *expected, const char *label)
+    {
+        for (size_t i=0; i<r->dst_channels(); ++i)
+            for (size_t j=0; j<r->src_channels(); ++j)
+            {
+                const float e = expected[i * r->src_channels() + j];
+                const float a = r->get(i, j);
+                UTEST_ASSERT_MSG(fabsf(a - e) < 1e-6f, "%s: dst=%d src=%d expected=%f actual=%f",
+                    label, int(i), int(j), e, a);
+            }
+    }
+
+    void test_rules()
+    {
+        printf("Testing remix rules...\n");
+        lsp::spa::Remixer r;
+
+        static const float dummy[] = { 1.0f };
+        UTEST_ASSERT(r.set_matrix(dummy) == lsp::STATUS_BAD_STATE);
+        UTEST_ASSERT(r.init(POS(pos_stereo), pos_stereo, 0) == lsp::STATUS_BAD_ARGUMENTS);
+
+        // Identity
+        static const float m_2_2[] = { 1, 0, 0, 1 };
+        UTEST_ASSERT(r.init(POS(pos_stereo), POS(pos_stereo)) == lsp::STATUS_OK);
+        check_matrix(&r, m_2_2, "2.0 -> 2.0");
+        UTEST_ASSERT(r.terms() == 2);
+
+        // Mono and stereo
+        static const float m_1_2[] = { 0.5f, 0.5f };
+        UTEST_ASSERT(r.init(POS(pos_mono), POS(pos_stereo)) == lsp::STATUS_OK);
+        check_matrix(&r, m_1_2, "2.0 -> 1.0");
+        static const float m_2_1[] = { 1.0f, 1.0f };
+        static const uint32_t pos_3_0[] = { SPA_AUDIO_CHANNEL_FL, SPA_AUDIO_CHANNEL_FR, SPA_AUDIO_CHANNEL_FC };
+        static const float m_3_1[] = { 0.0f, 0.0f, 1.0f };
+        UTEST_ASSERT(r.init(POS(pos_3_0), POS(pos_mono)) == lsp::STATUS_OK);
+        check_matrix(&r, m_3_1, "1.0 -> 3.0");
+        UTEST_ASSERT(r.init(POS(pos_stereo), POS(pos_mono)) == lsp::STATUS_OK);
+        check_matrix(&r, m_2_1, "1.0 -> 2.0");
+
+        // ITU downmix, LFE is dropped by default
+        static const float m_2_51[] =
+        {
+            1, 0, K3DB, 0, K3DB, 0,
+            0, 1, K3DB, 0, 0, K3DB
+        };
+        UTEST_ASSERT(r.init(POS(pos_stereo), POS(pos_5_1)) == lsp::STATUS_OK);
+        check_matrix(&r, m_2_51, "5.1 -> 2.0");
+        UTEST_ASSERT(r.terms() == 6);
+
+        static const float m_2_51_lfe[] =
+        {
+            1, 0, K3DB, 0.5f, K3DB, 0,
+            0, 1, K3DB, 0.5f, 0, K3DB
+        };
+        UTEST_ASSERT(r.init(POS(pos_stereo), POS(pos_5_1), lsp::spa::Remixer::F_MIX_LFE) == lsp::STATUS_OK);
+        check_matrix(&r, m_2_51_lfe, "5.1 -> 2.0 with LFE");
+
+        // Mono downmix: the center goes to the mono as is
+        static const float m_1_51[] = { 0.5f, 0.5f, 1.0f, 0, 0.5f * K3DB, 0.5f * K3DB };
+        UTEST_ASSERT(r.init(POS(pos_mono), POS(pos_5_1)) == lsp::STATUS_OK);
+        check_matrix(&r, m_1_51, "5.1 -> 1.0");
+
+        // Side and rear channels substitute each other
+        static const float m_51r_51[] =
+        {
+            1, 0, 0, 0, 0, 0,
+            0, 1, 0, 0, 0, 0,
+            0, 0, 1, 0, 0, 0,
+            0, 0, 0, 1, 0, 0,
+            0, 0, 0, 0, 1, 0,
+            0, 0, 0, 0, 0, 1,
+        };
+        UTEST_ASSERT(r.init(POS(pos_5_1r), POS(pos_5_1)) == lsp::STATUS_OK);
+        check_matrix(&r, m_51r_51, "5.1 -> 5.1R");
+        UTEST_ASSERT(r.terms() == 6);
+
+        // 7.1.4 to 5.1: rear channels fold into side channels at -3 dB, heights into ear level at -3 dB
+        static const float m_51_714[] =
+        {
+            1, 0, 0, 0, 0,    0,    0,    0,    K3DB, 0,    0,    0,
+            0, 1, 0, 0, 0,    0,    0,    0,    0,    K3DB, 0,    0,
+            0, 0, 1, 0, 0,    0,    0,    0,    0,    0,    0,    0,
+            0, 0, 0, 1, 0,    0,    0,    0,    0,    0,    0,    0,
+            0, 0, 0, 0, 1,    0,    1,    0,    0,    0,    K3DB, 0,
+            0, 0, 0, 0, 0,    1,    0,    1,    0,    0,    0,    K3DB,
+        };
+        UTEST_ASSERT(r.init(POS(pos_5_1), POS(pos_7_1_4)) == lsp::STATUS_OK);
+        check_matrix(&r, m_51_714, "7.1.4 -> 5.1");
+
+        // 7.1.4 to stereo: rear and rear heights pass two -3 dB folds
+        static const float m_2_714[] =
+        {
+            1, 0, K3DB, 0, K3DB, 0,    K3DB, 0,    K3DB, 0,    0.5f, 0,
+            0, 1, K3DB, 0, 0,    K3DB, 0,    K3DB, 0,    K3DB, 0,    0.5f,
+        };
+        UTEST_ASSERT(r.init(POS(pos_stereo), POS(pos_7_1_4)) == lsp::STATUS_OK);
+        check_matrix(&r, m_2_714, "7.1.4 -> 2.0");
+        UTEST_ASSERT(r.terms() == 12);
+
+        // No upmix by default
+        static const float m_51_2[] = { 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0 };
+        UTEST_ASSERT(r.init(POS(pos_5_1), POS(pos_stereo)) == lsp::STATUS_OK);
+        check_matrix(&r, m_51_2, "2.0 -> 5.1");
+        UTEST_ASSERT(r.terms() == 2);
+
+        static const float m_51_2_up[] = { 1, 0, 0, 1, K3DB, K3DB, 0, 0, K3DB, 0, 0, K3DB };
+        UTEST_ASSERT(r.init(POS(pos_5_1), POS(pos_stereo), lsp::spa::Remixer::F_UPMIX) == lsp::STATUS_OK);
+        check_matrix(&r, m_51_2_up, "2.0 -> 5.1 upmix");
+
+        static const float m_51_2_lfe[] = { 1, 0, 0, 1, K3DB, K3DB, 0.5f, 0.5f, K3DB, 0, 0, K3DB };
+        UTEST_ASSERT(r.init(POS(pos_5_1), POS(pos_stereo), lsp::spa::Remixer::F_UPMIX | lsp::spa::Remixer::F_MIX_LFE) == lsp::STATUS_OK);
+        check_matrix(&r, m_51_2_lfe, "2.0 -> 5.1 upmix with LFE");
+
+        // Normalization
+        UTEST_ASSERT(r.init(POS(pos_stereo), POS(pos_5_1), lsp::spa::Remixer::F_NORMALIZE) == lsp::STATUS_OK);
+        const float norm = 1.0f / (1.0f + 2.0f * K3DB);
+        UTEST_ASSERT(fabsf(r.get(0, 0) - norm) < 1e-6f);
+        UTEST_ASSERT(fabsf(r.get(0, 2) - K3DB * norm) < 1e-6f);
+        UTEST_ASSERT(fabsf(r.get(1, 5) - K3DB * norm) < 1e-6f);
+
+        // AUX passthrough and indexed channels
+        static const uint32_t aux_src[] = { SPA_AUDIO_CHANNEL_AUX0, SPA_AUDIO_CHANNEL_AUX1, SPA_AUDIO_CHANNEL_FL, SPA_AUDIO_CHANNEL_UNKNOWN };
+        static const uint32_t aux_dst[] = { SPA_AUDIO_CHANNEL_AUX1, SPA_AUDIO_CHANNEL_FL, SPA_AUDIO_CHANNEL_NA, SPA_AUDIO_CHANNEL_UNKNOWN, SPA_AUDIO_CHANNEL_UNKNOWN };
+        static const float m_aux[] =
+        {
+            0, 1, 0, 0,
+            0, 0, 1, 0,
+            0, 0, 0, 0,
+            0, 0, 0, 1,
+            0, 0, 0, 0,
+        };
+        UTEST_ASSERT(r.init(POS(aux_dst), POS(aux_src), lsp::spa::Remixer::F_UPMIX) == lsp::STATUS_OK);
+        check_matrix(&r, m_aux, "aux");
+
+        // Layout structures
+        struct spa_audio_layout_info dl = { SPA_AUDIO_LAYOUT_Stereo };
+        struct spa_audio_layout_info sl = { SPA_AUDIO_LAYOUT_5_1 };
+        UTEST_ASSERT(r.init(&dl, &sl) == lsp::STATUS_OK);
+        check_matrix(&r, m_2_51, "layout 5.1 -> 2.0");
+    }
+
+    void check_process(lsp::spa::Remixer *r, const char *label)
+    {
+        const size_t nd = r->dst_channels(), ns = r->src_channels();
+        float *src[MAX_CHANNELS], *dst[MAX_CHANNELS];
+        for (size_t i=0; i<ns; ++i)
+        {
+            src[i]          = static_cast<float *>(malloc(MAX_SAMPLES * sizeof(float)));
+            UTEST_ASSERT(src[i] != NULL);
+            for (size_t j=0; j<MAX_SAMPLES; ++j)
+                src[i][j]       = float(rand()) / float(RAND_MAX) - 0.5f;
+        }
+        for (size_t i=0; i<nd; ++i)
+        {
+            dst[i]          = static_cast<float *>(malloc((MAX_SAMPLES + 1) * sizeof(float)));
+            UTEST_ASSERT(dst[i] != NULL);
+        }
+
+        static const size_t counts[] = { 0, 1, 7, 8, 15, 1024, 1031, MAX_SAMPLES };
+        for (size_t c=0; c<sizeof(counts)/sizeof(counts[0]); ++c)
+        {
+            const size_t n = counts[c];
+            for (size_t i=0; i<nd; ++i)
+            {
+                for (size_t j=0; j<=MAX_SAMPLES; ++j)
+                    dst[i][j]       = 1e+6f;
+            }
+
+            r->process(dst, src, n);
+
+            for (size_t i=0; i<nd; ++i)
+            {
+                UTEST_ASSERT(dst[i][n] == 1e+6f);
+                for (size_t k=0; k<n; ++k)
+                {
+                    float ref = 0.0f;
+                    for (size_t j=0; j<ns; ++j)
+                        ref        += src[j][k] * r->get(i, j);
+                    UTEST_ASSERT_MSG(fabsf(dst[i][k] - ref) <= 1e-6f * (1.0f + fabsf(ref)),
+                        "%s: samples=%d dst=%d index=%d expected=%f actual=%f",
+                        label, int(n), int(i), int(k), ref, dst[i][k]);
+                }
+            }
+        }
+
+        for (size_t i=0; i<ns; ++i)
+            free(src[i]);
+        for (size_t i=0; i<nd; ++i)
+            free(dst[i]);
+    }
+
+    void test_process()
+    {
+        printf("Testing remix processing...\n");
+        lsp::spa::Remixer r;
+
+        UTEST_ASSERT(r.init(POS(pos_stereo), POS(pos_7_1_4), lsp::spa::Remixer::F_MIX_LFE) == lsp::STATUS_OK);
+        check_process(&r, "7.1.4 -> 2.0");
+        UTEST_ASSERT(r.init(POS(pos_5_1), POS(pos_stereo), lsp::spa::Remixer::F_UPMIX) == lsp::STATUS_OK);
+        check_process(&r, "2.0 -> 5.1");
+        UTEST_ASSERT(r.init(POS(pos_5_1r), POS(pos_5_1)) == lsp::STATUS_OK);
+        check_process(&r, "5.1 -> 5.1R");
+
+        // Custom sparse matrix with rows of different density
+        uint32_t pos[MAX_CHANNELS];
+        for (size_t i=0; i<MAX_CHANNELS; ++i)
+            pos[i]          = SPA_AUDIO_CHANNEL_AUX0 + i;
+        UTEST_ASSERT(r.init(pos, 7, pos, 11) == lsp::STATUS_OK);
+        float m[7 * 11];
+        for (size_t i=0; i<7; ++i)
+            for (size_t j=0; j<11; ++j)
+                m[i * 11 + j]   = (((i * 11 + j) % (i + 1)) == 0) ? float(rand()) / float(RAND_MAX) : 0.0f;
+        UTEST_ASSERT(r.set_matrix(m) == lsp::STATUS_OK);
+        for (size_t i=0; i<7 * 11; ++i)
+            UTEST_ASSERT(r.matrix()[i] == m[i]);
+        check_process(&r, "custom");
+    }
+
+    UTEST_MAIN
+    {
+        srand(0x37);
+        test_rules();
+        test_process();
+    }
+
+UTEST_END